@@ -0,0 +1,202 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Benchmark of the blowing snow integration methods (BLOWING_INTEGRATION).
+ *
+ * Runs CalcBlowingSnow on a fixed set of snow and atmospheric conditions
+ * with BLOWING_ROMBERG, BLOWING_GAUSS_LEGENDRE and BLOWING_TABLE and reports
+ * the speedup and the maximum deviation of the sublimation and transport
+ * fluxes against the BLOWING_ROMBERG (qromb) results.
+ *
+ * usage: blowing_snow_benchmark
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_all.h>
+
+#define NSAMPLES 2000
+#define NMETHODS 3
+
+size_t               NF;
+size_t               NR;
+global_param_struct  global_param;
+option_struct        options;
+parameters_struct    param;
+blowing_table_struct blowing_table;
+instrument_struct    instrument;
+
+char                *method_names[NMETHODS] = {
+    "BLOWING_ROMBERG", "BLOWING_GAUSS_LEGENDRE", "BLOWING_TABLE"
+};
+unsigned short int   methods[NMETHODS] = {
+    BLOWING_ROMBERG, BLOWING_GAUSS_LEGENDRE, BLOWING_TABLE
+};
+
+double               Tair[NSAMPLES];
+double               RH[NSAMPLES];
+double               Wind[NSAMPLES];
+double               ZO[NSAMPLES];
+double               SnowDepth[NSAMPLES];
+double               LagOne[NSAMPLES];
+double               SigmaSlope[NSAMPLES];
+double               Fetch[NSAMPLES];
+unsigned             LastSnow[NSAMPLES];
+double               SubFlux[NMETHODS][NSAMPLES];
+double               Transport[NMETHODS][NSAMPLES];
+
+/******************************************************************************
+ * @brief    Uniform pseudo-random number in [lower, upper), reproducible
+ *****************************************************************************/
+double
+bench_uniform(unsigned long *seed,
+              double         lower,
+              double         upper)
+{
+    *seed = *seed * 6364136223846793005UL + 1442695040888963407UL;
+    return lower + (upper - lower) * ((*seed >> 11) / 9007199254740992.0);
+}
+
+/******************************************************************************
+ * @brief    Wall time in ns
+ *****************************************************************************/
+double
+bench_time(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/******************************************************************************
+ * @brief    Run CalcBlowingSnow for all samples with one integration method
+ *****************************************************************************/
+void
+bench_run(size_t  m,
+          double *timing)
+{
+    double start;
+    double es;
+
+    size_t i;
+
+    options.BLOWING_INTEGRATION = methods[m];
+
+    start = bench_time();
+    if (methods[m] == BLOWING_TABLE) {
+        initialize_blowing_table();
+    }
+    timing[1] = bench_time() - start;
+
+    start = bench_time();
+    for (i = 0; i < NSAMPLES; i++) {
+        es = svp(Tair[i]);
+        SubFlux[m][i] = CalcBlowingSnow(SEC_PER_HOUR, Tair[i], LastSnow[i],
+                                        0., Wind[i], 2.838e6, 1.3,
+                                        RH[i] * es, ZO[i], 2., SnowDepth[i],
+                                        LagOne[i], SigmaSlope[i], Tair[i], 0,
+                                        1, Fetch[i], 1., 0.1,
+                                        &(Transport[m][i]));
+    }
+    timing[0] = (bench_time() - start) / NSAMPLES;
+}
+
+/******************************************************************************
+ * @brief    Maximum absolute and relative deviation from the first method
+ *****************************************************************************/
+void
+bench_deviation(double  flux[][NSAMPLES],
+                size_t  m,
+                double *abs_dev,
+                double *rel_dev)
+{
+    double diff;
+    double scale;
+
+    size_t i;
+
+    // relative to the largest flux, since single fluxes can be ~0
+    scale = 0.;
+    for (i = 0; i < NSAMPLES; i++) {
+        scale = max(scale, fabs(flux[0][i]));
+    }
+
+    *abs_dev = 0.;
+    for (i = 0; i < NSAMPLES; i++) {
+        diff = fabs(flux[m][i] - flux[0][i]);
+        *abs_dev = max(*abs_dev, diff);
+    }
+    *rel_dev = scale > 0. ? *abs_dev / scale : 0.;
+}
+
+/******************************************************************************
+ * @brief    Blowing snow integration benchmark
+ *****************************************************************************/
+int
+main(void)
+{
+    double        timing[NMETHODS][2];
+    double        sub_abs;
+    double        sub_rel;
+    double        transport_abs;
+    double        transport_rel;
+    unsigned long seed = 1;
+
+    size_t        i;
+    size_t        m;
+
+    LOG_DEST = stderr;
+
+    initialize_options();
+    initialize_parameters();
+    options.BLOWING = true;
+
+    for (i = 0; i < NSAMPLES; i++) {
+        Tair[i] = bench_uniform(&seed, -30., 0.);
+        RH[i] = bench_uniform(&seed, 0.3, 1.);
+        Wind[i] = bench_uniform(&seed, 1., 20.);
+        ZO[i] = exp(bench_uniform(&seed, log(1e-4), log(1e-2)));
+        SnowDepth[i] = bench_uniform(&seed, 0.1, 2.);
+        LagOne[i] = bench_uniform(&seed, 0.2, 0.9);
+        SigmaSlope[i] = bench_uniform(&seed, 0.001, 0.05);
+        Fetch[i] = bench_uniform(&seed, 100., 3000.);
+        LastSnow[i] = (unsigned) bench_uniform(&seed, 1., 100.);
+    }
+
+    for (m = 0; m < NMETHODS; m++) {
+        bench_run(m, timing[m]);
+    }
+
+    printf("%-24s %12s %8s %12s %12s %12s %12s\n", "method", "us/call",
+           "speedup", "max sub dev", "rel", "max trn dev", "rel");
+    for (m = 0; m < NMETHODS; m++) {
+        bench_deviation(SubFlux, m, &sub_abs, &sub_rel);
+        bench_deviation(Transport, m, &transport_abs, &transport_rel);
+        printf("%-24s %12.3f %8.2f %12.4e %12.4e %12.4e %12.4e\n",
+               method_names[m], timing[m][0] / 1e3,
+               timing[0][0] / timing[m][0], sub_abs, sub_rel, transport_abs,
+               transport_rel);
+    }
+    printf("\nBLOWING_TABLE setup: %.3f ms\n", timing[2][1] / 1e6);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,300 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Benchmark of the fast-math physics mode (VIC_FAST_MATH).
+ *
+ * Built twice by run_fast_math_benchmark.bash, with and without
+ * VIC_FAST_MATH. "run" times svp, svp_array, svp_slope, StabilityCorrection
+ * and penman on a fixed set of atmospheric conditions and writes the timings
+ * and the resulting fluxes to a file. "compare" reads the files of both
+ * builds and reports the speedup and the maximum deviation of the fluxes.
+ *
+ * usage: fast_math_benchmark run <file>
+ *        fast_math_benchmark compare <exact file> <fast file>
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_all.h>
+
+#define NSAMPLES 100000
+#define NREPEAT  50
+#define NTIMERS  5
+#define NFLUXES  6
+
+size_t               NF;
+size_t               NR;
+global_param_struct  global_param;
+option_struct        options;
+parameters_struct    param;
+blowing_table_struct blowing_table;
+instrument_struct    instrument;
+
+char               *timer_names[NTIMERS] = {
+    "svp", "svp_array", "svp_slope", "StabilityCorrection", "penman"
+};
+char               *flux_names[NFLUXES] = {
+    "svp (Pa)", "svp_slope (Pa/K)", "vpd (Pa)", "sensible heat (W/m2)",
+    "latent heat (W/m2)", "penman (mm/day)"
+};
+
+double              Tair[NSAMPLES];
+double              TSurf[NSAMPLES];
+double              Wind[NSAMPLES];
+double              Z0[NSAMPLES];
+double              RH[NSAMPLES];
+double              Elevation[NSAMPLES];
+double              Rad[NSAMPLES];
+double              Rc[NSAMPLES];
+double              Result[NSAMPLES];
+double              Flux[NSAMPLES][NFLUXES];
+
+/******************************************************************************
+ * @brief    Uniform pseudo-random number in [lower, upper), reproducible
+ *****************************************************************************/
+double
+bench_uniform(unsigned long *seed,
+              double         lower,
+              double         upper)
+{
+    *seed = *seed * 6364136223846793005UL + 1442695040888963407UL;
+    return lower + (upper - lower) * ((*seed >> 11) / 9007199254740992.0);
+}
+
+/******************************************************************************
+ * @brief    Wall time in ns
+ *****************************************************************************/
+double
+bench_time(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/******************************************************************************
+ * @brief    Time the functions and write timings and fluxes to a file
+ *****************************************************************************/
+void
+bench_run(char *filename)
+{
+    double        timing[NTIMERS];
+    double        sink;
+    double        start;
+    double        ra;
+    double        es;
+    double        vp;
+    double        lv;
+    unsigned long seed = 1;
+    FILE         *f;
+
+    size_t        i;
+    size_t        j;
+    size_t        k;
+
+    for (i = 0; i < NSAMPLES; i++) {
+        Tair[i] = bench_uniform(&seed, -40., 45.);
+        TSurf[i] = Tair[i] + bench_uniform(&seed, -15., 15.);
+        Wind[i] = bench_uniform(&seed, 0.2, 20.);
+        Z0[i] = exp(bench_uniform(&seed, log(0.0005), log(2.)));
+        RH[i] = bench_uniform(&seed, 0.05, 1.);
+        Elevation[i] = bench_uniform(&seed, 0., 4000.);
+        Rad[i] = bench_uniform(&seed, 0., 900.);
+        Rc[i] = bench_uniform(&seed, 0., 500.);
+    }
+
+    // timings
+    sink = 0.;
+    for (k = 0; k < NTIMERS; k++) {
+        start = bench_time();
+        for (j = 0; j < NREPEAT; j++) {
+            if (k == 1) {
+                svp_array(Tair, NSAMPLES, Result);
+                sink += Result[j];
+                continue;
+            }
+            for (i = 0; i < NSAMPLES; i++) {
+                if (k == 0) {
+                    sink += svp(Tair[i]);
+                }
+                else if (k == 2) {
+                    sink += svp_slope(Tair[i]);
+                }
+                else if (k == 3) {
+                    sink += StabilityCorrection(10. + 10. * Z0[i], 0., TSurf[i],
+                                                Tair[i], Wind[i], Z0[i]);
+                }
+                else {
+                    sink += penman(Tair[i], Elevation[i], Rad[i], 500., 50.,
+                                   Rc[i], 0.);
+                }
+            }
+        }
+        timing[k] = (bench_time() - start) / (NREPEAT * NSAMPLES);
+    }
+
+    // fluxes
+    for (i = 0; i < NSAMPLES; i++) {
+        ra = log((10. + 10. * Z0[i]) / Z0[i]) *
+             log((10. + 10. * Z0[i]) / Z0[i]) /
+             (CONST_KARMAN * CONST_KARMAN * Wind[i]);
+        ra /= StabilityCorrection(10. + 10. * Z0[i], 0., TSurf[i], Tair[i],
+                                  Wind[i], Z0[i]);
+        es = svp(Tair[i]);
+        vp = RH[i] * es;
+        lv = calc_latent_heat_of_vaporization(TSurf[i]);
+
+        Flux[i][0] = es;
+        Flux[i][1] = svp_slope(Tair[i]);
+        Flux[i][2] = es - vp;
+        Flux[i][3] = 1.2 * CONST_CPMAIR * (TSurf[i] - Tair[i]) / ra;
+        Flux[i][4] = lv * 1.2 * CONST_EPS * (svp(TSurf[i]) - vp) /
+                     (CONST_PSTD * ra);
+        Flux[i][5] = penman(Tair[i], Elevation[i], Rad[i], es - vp, ra,
+                            Rc[i], 0.);
+    }
+
+    f = fopen(filename, "w");
+    if (f == NULL) {
+        log_err("Cannot open %s", filename);
+    }
+    for (k = 0; k < NTIMERS; k++) {
+        fprintf(f, "# %s %.6f\n", timer_names[k], timing[k]);
+        printf("%-20s %8.2f ns/call\n", timer_names[k], timing[k]);
+    }
+    for (i = 0; i < NSAMPLES; i++) {
+        for (k = 0; k < NFLUXES; k++) {
+            fprintf(f, "%.17g%s", Flux[i][k], k + 1 < NFLUXES ? " " : "\n");
+        }
+    }
+    fclose(f);
+
+    // keep the timed calls
+    if (sink == 12345.6789) {
+        printf("%f\n", sink);
+    }
+}
+
+/******************************************************************************
+ * @brief    Read timings and fluxes written by bench_run
+ *****************************************************************************/
+void
+bench_read(char   *filename,
+           double *timing,
+           double  flux[][NFLUXES])
+{
+    char  name[MAXSTRING];
+    FILE *f;
+
+    size_t i;
+    size_t k;
+
+    f = fopen(filename, "r");
+    if (f == NULL) {
+        log_err("Cannot open %s", filename);
+    }
+    for (k = 0; k < NTIMERS; k++) {
+        if (fscanf(f, "# %s %lf\n", name, &timing[k]) != 2) {
+            log_err("Error reading timing %zu from %s", k, filename);
+        }
+    }
+    for (i = 0; i < NSAMPLES; i++) {
+        for (k = 0; k < NFLUXES; k++) {
+            if (fscanf(f, "%lf", &flux[i][k]) != 1) {
+                log_err("Error reading flux %zu of sample %zu from %s", k, i,
+                        filename);
+            }
+        }
+    }
+    fclose(f);
+}
+
+/******************************************************************************
+ * @brief    Report speedup and maximum flux deviation of two runs
+ *****************************************************************************/
+void
+bench_compare(char *exact_file,
+              char *fast_file)
+{
+    static double exact[NSAMPLES][NFLUXES];
+    static double fast[NSAMPLES][NFLUXES];
+    double        exact_timing[NTIMERS];
+    double        fast_timing[NTIMERS];
+    double        abs_dev;
+    double        rel_dev;
+    double        diff;
+
+    size_t        i;
+    size_t        k;
+
+    bench_read(exact_file, exact_timing, exact);
+    bench_read(fast_file, fast_timing, fast);
+
+    printf("%-20s %10s %10s %8s\n", "function", "exact ns", "fast ns",
+           "speedup");
+    for (k = 0; k < NTIMERS; k++) {
+        printf("%-20s %10.2f %10.2f %8.2f\n", timer_names[k],
+               exact_timing[k], fast_timing[k],
+               exact_timing[k] / fast_timing[k]);
+    }
+
+    printf("\n%-22s %14s %14s\n", "flux", "max abs dev", "max rel dev");
+    for (k = 0; k < NFLUXES; k++) {
+        abs_dev = 0.;
+        rel_dev = 0.;
+        for (i = 0; i < NSAMPLES; i++) {
+            diff = fabs(fast[i][k] - exact[i][k]);
+            abs_dev = max(abs_dev, diff);
+            if (fabs(exact[i][k]) > DBL_EPSILON) {
+                rel_dev = max(rel_dev, diff / fabs(exact[i][k]));
+            }
+        }
+        printf("%-22s %14.6e %14.6e\n", flux_names[k], abs_dev, rel_dev);
+    }
+}
+
+/******************************************************************************
+ * @brief    Fast-math benchmark
+ *****************************************************************************/
+int
+main(int   argc,
+     char *argv[])
+{
+    LOG_DEST = stderr;
+
+    initialize_parameters();
+
+    if (argc == 3 && !strcmp(argv[1], "run")) {
+        bench_run(argv[2]);
+    }
+    else if (argc == 4 && !strcmp(argv[1], "compare")) {
+        bench_compare(argv[2], argv[3]);
+    }
+    else {
+        fprintf(stderr, "usage: %s run <file>\n"
+                "       %s compare <exact file> <fast file>\n", argv[0],
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+set -e
+# set -x
+
+# Build and run the blowing snow benchmark, which reports the speedup and the
+# maximum flux deviation of the BLOWING_INTEGRATION methods against qromb.
+
+# A POSIX variable
+OPTIND=1         # Reset in case getopts has been used previously in the shell.
+
+# Initialize our own variables:
+cc="gcc"
+work_dir=""
+
+function usage {
+  echo "Usage: `basename $0` [-c compiler] [-d work_dir] -h for help";
+}
+
+while getopts "h?c::d::" opt; do
+    case "$opt" in
+    h|\?)
+        usage
+        exit 0
+        ;;
+    c)  cc=$OPTARG ;;
+    d)  work_dir=$OPTARG ;;
+    esac
+done
+
+shift $((OPTIND-1))
+
+[ "$1" = "--" ] && shift
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+vic_dir=$(cd "$script_dir/../../vic" && pwd)
+
+if [ -z "$work_dir" ]; then
+    work_dir=$(mktemp -d)
+fi
+mkdir -p $work_dir
+
+src="$script_dir/blowing_snow_benchmark.c \
+     $vic_dir/vic_run/src/*.c \
+     $vic_dir/drivers/shared_all/src/vic_log.c \
+     $vic_dir/drivers/shared_all/src/initialize_options.c \
+     $vic_dir/drivers/shared_all/src/initialize_parameters.c \
+     $vic_dir/drivers/shared_all/src/open_file.c"
+cflags="-O3 -std=c99 -fcommon -fopenmp \
+        -I $vic_dir/vic_run/include -I $vic_dir/drivers/shared_all/include"
+
+echo "Building in $work_dir"
+$cc $cflags -o $work_dir/blowing_snow_benchmark $src -lm
+
+$work_dir/blowing_snow_benchmark
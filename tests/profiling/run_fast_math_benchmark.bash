@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+set -e
+# set -x
+
+# Build the fast-math benchmark with and without VIC_FAST_MATH, run both and
+# report the speedup and the maximum deviation of the fluxes.
+
+# A POSIX variable
+OPTIND=1         # Reset in case getopts has been used previously in the shell.
+
+# Initialize our own variables:
+cc="gcc"
+work_dir=""
+
+function usage {
+  echo "Usage: `basename $0` [-c compiler] [-d work_dir] -h for help";
+}
+
+while getopts "h?c::d::" opt; do
+    case "$opt" in
+    h|\?)
+        usage
+        exit 0
+        ;;
+    c)  cc=$OPTARG ;;
+    d)  work_dir=$OPTARG ;;
+    esac
+done
+
+shift $((OPTIND-1))
+
+[ "$1" = "--" ] && shift
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+vic_dir=$(cd "$script_dir/../../vic" && pwd)
+
+if [ -z "$work_dir" ]; then
+    work_dir=$(mktemp -d)
+fi
+mkdir -p $work_dir
+
+src="$script_dir/fast_math_benchmark.c \
+     $vic_dir/vic_run/src/*.c \
+     $vic_dir/drivers/shared_all/src/vic_log.c \
+     $vic_dir/drivers/shared_all/src/initialize_parameters.c \
+     $vic_dir/drivers/shared_all/src/open_file.c"
+cflags="-O3 -std=c99 -fcommon -fopenmp \
+        -I $vic_dir/vic_run/include -I $vic_dir/drivers/shared_all/include"
+
+echo "Building in $work_dir"
+$cc $cflags -o $work_dir/benchmark_exact $src -lm
+$cc $cflags -DVIC_FAST_MATH -fno-trapping-math -o $work_dir/benchmark_fast $src -lm
+
+echo "Exact math"
+$work_dir/benchmark_exact run $work_dir/exact.txt
+echo "Fast math"
+$work_dir/benchmark_fast run $work_dir/fast.txt
+
+echo ""
+$work_dir/benchmark_exact compare $work_dir/exact.txt $work_dir/fast.txt
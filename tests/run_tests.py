@@ -30,6 +30,9 @@ from test_utils import (
 from test_image_driver import (test_image_driver_no_output_file_nans,
                                setup_subdirs_and_fill_in_global_param_mpi_test,
                                check_mpi_fluxes, check_mpi_states)
+from test_image_driver import (
+    setup_subdirs_and_fill_in_global_param_param_cache_test,
+    check_param_cache)
 from test_restart import (prepare_restart_run_periods,
                           setup_subdirs_and_fill_in_global_param_restart_test,
                           check_exact_restart_fluxes,
@@ -404,6 +407,16 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                                  'mpi test!')
             list_n_proc = test_dict['mpi']['n_proc']
 
+        # If parameter cache test, prepare the number of runs
+        elif 'param_cache' in test_dict['check']:
+            if len(dict_drivers) > 1:
+                raise ValueError('Only support single driver for parameter '
+                                 'cache tests!')
+            n_runs = int(test_dict['param_cache']['n_runs'])
+            if n_runs < 2:
+                raise ValueError('Need at least two runs to run parameter '
+                                 'cache test!')
+
         # create template string
         dict_s = {}
         for dr, global_param in dict_global_param.items():
@@ -428,6 +441,14 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                 setup_subdirs_and_fill_in_global_param_mpi_test(
                     s, list_n_proc, dirs['results'], dirs['state'],
                     test_data_dir)
+        # --- if parameter cache test, multiple runs --- #
+        elif 'param_cache' in test_dict['check']:
+            s = dict_s[driver]
+            # Set up subdirectories and output directories in global file for
+            # parameter cache testing
+            list_global_param = \
+                setup_subdirs_and_fill_in_global_param_param_cache_test(
+                    s, n_runs, dirs['results'], dirs['state'], test_data_dir)
         # --- if driver-match test, one run for each driver --- #
         elif 'driver_match' in test_dict['check']:
             # Set up subdirectories and output directories in global file for
@@ -459,7 +480,8 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
             if 'STATE_FORMAT' in replacements:
                 state_format = replacements['STATE_FORMAT']
         if 'exact_restart' in test_dict['check'] or\
-           'mpi' in test_dict['check']:  # if multiple runs
+           'mpi' in test_dict['check'] or\
+           'param_cache' in test_dict['check']:  # if multiple runs
             for j, gp in enumerate(list_global_param):
                 # save a copy of replacements for the next global file
                 replacements_cp = replacements.copy()
@@ -502,6 +524,16 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                 with open(test_global_file, mode='w') as f:
                     for line in gp:
                         f.write(line)
+        elif 'param_cache' in test_dict['check']:
+            list_test_global_file = []
+            for j, gp in enumerate(list_global_param):
+                test_global_file = os.path.join(
+                    dirs['test'],
+                    '{}_globalparam_run_{}.txt'.format(testname, j))
+                list_test_global_file.append(test_global_file)
+                with open(test_global_file, mode='w') as f:
+                    for line in gp:
+                        f.write(line)
         elif 'driver_match' in test_dict['check']:
             dict_test_global_file = {}
             for dr, gp in dict_global_param.items():
@@ -531,7 +563,8 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
         error_message = ''
 
         try:
-            if 'exact_restart' in test_dict['check']:
+            if 'exact_restart' in test_dict['check'] or\
+               'param_cache' in test_dict['check']:
                 for j, test_global_file in enumerate(list_test_global_file):
                     returncode = vic_exe.run(test_global_file,
                                              logdir=dirs['logs'],
@@ -646,6 +679,10 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                     check_mpi_fluxes(dirs['results'], list_n_proc)
                     check_mpi_states(dirs['state'], list_n_proc)
 
+                # check that runs reading the parameter cache match
+                if 'param_cache' in test_dict['check']:
+                    check_param_cache(dirs['results'], dirs['state'], n_runs)
+
                 # check that results from different drivers match
                 if 'driver_match' in test_dict['check']:
                     check_drivers_match_fluxes(list(dict_drivers.keys()),
@@ -293,3 +293,105 @@ def check_mpi_states(state_basedir, list_n_proc):
                                    ds_first_run[var].values,
                                    err_msg='States are not an exact match '
                                    'for variable: {}'.format(var))
+
+
+def setup_subdirs_and_fill_in_global_param_param_cache_test(
+        s, n_runs, result_basedir, state_basedir, test_data_dir):
+    ''' Fill in global parameter output directories for repeated runs that
+        share a parameter cache, image driver
+
+    Parameters
+    ----------
+    s: <string.Template>
+        Template of the global param file to be filled in
+    n_runs: <int>
+        Number of runs; the first run writes the parameter cache and the
+        following runs read it
+    result_basedir: <str>
+        Base directory of output fluxes results; each run is output to a
+        subdirectory under the base directory
+    state_basedir: <str>
+        Base directory of output state results; each run is output to a
+        subdirectory under the base directory. The parameter cache is written
+        to the base directory.
+    test_data_dir: <str>
+        Base directory of test data
+
+    Returns
+    ----------
+    list_global_param: <list>
+        A list of global parameter strings to be run with parameters filled in
+
+    Require
+    ----------
+    os
+    '''
+
+    param_cache = os.path.join(state_basedir, 'param_cache')
+    list_global_param = []
+    for j in range(n_runs):
+        # Set up subdirectories for results and states
+        result_dir = os.path.join(result_basedir, 'run_{}'.format(j))
+        state_dir = os.path.join(state_basedir, 'run_{}'.format(j))
+        os.makedirs(result_dir, exist_ok=True)
+        os.makedirs(state_dir, exist_ok=True)
+
+        # Fill in global parameter options
+        list_global_param.append(s.safe_substitute(test_data_dir=test_data_dir,
+                                                   result_dir=result_dir,
+                                                   state_dir=state_dir,
+                                                   param_cache=param_cache))
+
+    return(list_global_param)
+
+
+def check_param_cache(result_basedir, state_basedir, n_runs):
+    ''' Check that the runs after the first one read the parameter cache and
+        that their fluxes and states exactly match the first run, image
+        driver
+
+    Parameters
+    ----------
+    result_basedir: <str>
+        Base directory of output fluxes results; each run is output to a
+        subdirectory under the base directory
+    state_basedir: <str>
+        Base directory of output states and of the parameter cache; each run
+        is output to a subdirectory under the base directory
+    n_runs: <int>
+        Number of runs to compare
+
+    Require
+    ----------
+    os
+    glob
+    numpy
+    '''
+
+    def open_run(basedir, j):
+        fname = glob.glob(os.path.join(basedir, 'run_{}'.format(j),
+                                       '*.nc'))[0]
+        return fname, xr.open_dataset(fname)
+
+    # The cache is written while the first run is set up; it must not have
+    # been rewritten by a later run
+    cache_files = glob.glob(os.path.join(state_basedir, 'param_cache.*'))
+    if not cache_files:
+        raise AssertionError('No parameter cache files were written')
+    fname_first_run, ds_first_run = open_run(result_basedir, 0)
+    for cache_file in cache_files:
+        if os.path.getmtime(cache_file) > os.path.getmtime(fname_first_run):
+            raise AssertionError('Parameter cache {} was rewritten after the '
+                                 'first run'.format(cache_file))
+
+    # Compare fluxes and states of all runs with the first run
+    for basedir, kind in ((result_basedir, 'Fluxes'), (state_basedir,
+                                                       'States')):
+        ds_first_run = open_run(basedir, 0)[1]
+        for j in range(1, n_runs):
+            ds_current_run = open_run(basedir, j)[1]
+            for var in ds_first_run.data_vars:
+                npt.assert_array_equal(ds_current_run[var].values,
+                                       ds_first_run[var].values,
+                                       err_msg='{} are not an exact match '
+                                       'for variable: {}'.format(kind, var))
@@ -0,0 +1,119 @@
+import numpy as np
+import pytest
+
+from vic.vic import ffi
+from vic import lib as vic_lib
+
+MAX_NODES = 50
+
+
+def make_heat_eqn(nodes, noflux, exp_trans, keep):
+    '''Set up a partially frozen soil column for fda_heat_eqn'''
+    n = nodes - 1 if noflux else nodes - 2
+
+    zsum = 0.4 * np.arange(nodes)
+    t0 = -3.0 + 0.7 * np.arange(nodes)
+    t0[2] -= 1.5  # cold nose
+    moist = np.full(nodes, 0.3)
+    max_moist = np.full(nodes, 0.42)
+    bubble = np.full(nodes, 20.)
+    expt = np.full(nodes, 10.)
+
+    layer = {'bulk_dens_min': [1500., 1500., 1500.],
+             'soil_dens_min': [2685., 2685., 2685.],
+             'quartz': [0.3, 0.3, 0.5],
+             'bulk_density': [1500., 1500., 1450.],
+             'soil_density': [2685., 2685., 2685.],
+             'organic': [0., 0.1, 0.],
+             'depth': [0.3, 0.7, 1.5]}
+
+    ice = np.zeros(nodes)
+    kappa = np.zeros(nodes)
+    cs = np.zeros(nodes)
+    for i in range(nodes):
+        if t0[i] < 0:
+            ice[i] = max(moist[i] - vic_lib.maximum_unfrozen_water(
+                t0[i], max_moist[i], bubble[i], expt[i]), 0.)
+        kappa[i] = vic_lib.soil_conductivity(moist[i], moist[i] - ice[i],
+                                             2685., 1500., 0.3, 2685., 1500.,
+                                             0.)
+        cs[i] = vic_lib.volumetric_heat_capacity(1500. / 2685.,
+                                                 moist[i] - ice[i], ice[i],
+                                                 0.)
+
+    def darray(values):
+        arr = ffi.new('double[]', MAX_NODES)
+        arr[0:len(values)] = list(values)
+        keep.append(arr)
+        return arr
+
+    heat_eqn = ffi.new('fda_heat_eqn_struct *')
+    heat_eqn.deltat = 3600.
+    heat_eqn.NOFLUX = noflux
+    heat_eqn.EXP_TRANS = exp_trans
+    heat_eqn.T0 = darray(t0)
+    heat_eqn.moist = darray(moist)
+    heat_eqn.ice = darray(ice)
+    heat_eqn.kappa = darray(kappa)
+    heat_eqn.Cs = darray(cs)
+    heat_eqn.max_moist = darray(max_moist)
+    heat_eqn.bubble = darray(bubble)
+    heat_eqn.expt = darray(expt)
+    heat_eqn.alpha = darray(np.full(nodes - 1, 0.8))
+    heat_eqn.beta = darray(np.full(nodes - 1, 0.4))
+    heat_eqn.gamma = darray(np.full(nodes - 1, 0.4))
+    heat_eqn.Zsum = darray(zsum)
+    heat_eqn.Dp = 4.
+    for name, values in layer.items():
+        setattr(heat_eqn, name, darray(values))
+    heat_eqn.Nlayers = 3
+
+    return heat_eqn, n
+
+
+@pytest.mark.parametrize('noflux', [False, True])
+@pytest.mark.parametrize('exp_trans', [False, True])
+def test_fda_heat_eqn_jacobian(noflux, exp_trans):
+    vic_lib.initialize_parameters()
+    keep = []
+    heat_eqn, n = make_heat_eqn(8, noflux, exp_trans, keep)
+
+    x = ffi.new('double[]', MAX_NODES)
+    fvec = ffi.new('double[]', MAX_NODES)
+    vic_lib.fda_heat_eqn_init(x, n, heat_eqn)
+    for i in range(n):
+        x[i] += 0.3 * np.sin(i + 1.)
+
+    vic_lib.fda_heat_eqn(x, fvec, n, -1, heat_eqn)
+
+    a = [ffi.new('double[]', MAX_NODES) for _ in range(3)]
+    b = [ffi.new('double[]', MAX_NODES) for _ in range(3)]
+    vic_lib.fda_heat_eqn_jacobian(x, a[0], a[1], a[2], n, heat_eqn)
+    vic_lib.fdjac3(x, fvec, b[0], b[1], b[2],
+                   ffi.addressof(vic_lib, 'fda_heat_eqn'), heat_eqn, n)
+
+    # sub, main and super diagonals
+    np.testing.assert_allclose(list(a[0][1:n]), list(b[0][1:n]), rtol=1e-3)
+    np.testing.assert_allclose(list(a[1][0:n]), list(b[1][0:n]), rtol=1e-3)
+    np.testing.assert_allclose(list(a[2][0:n - 1]), list(b[2][0:n - 1]),
+                               rtol=1e-3)
+
+
+@pytest.mark.parametrize('exp_trans', [False, True])
+def test_newt_raph_jacobian_modes(exp_trans):
+    vic_lib.initialize_parameters()
+    keep = []
+    heat_eqn, n = make_heat_eqn(8, False, exp_trans, keep)
+    vecfunc = ffi.addressof(vic_lib, 'fda_heat_eqn')
+
+    x_fd = ffi.new('double[]', MAX_NODES)
+    vic_lib.fda_heat_eqn_init(x_fd, n, heat_eqn)
+    assert vic_lib.newt_raph(vecfunc, ffi.NULL, heat_eqn, x_fd, n) == 0
+
+    x_an = ffi.new('double[]', MAX_NODES)
+    vic_lib.fda_heat_eqn_init(x_an, n, heat_eqn)
+    assert vic_lib.newt_raph(vecfunc,
+                             ffi.addressof(vic_lib, 'fda_heat_eqn_jacobian'),
+                             heat_eqn, x_an, n) == 0
+
+    np.testing.assert_allclose(list(x_an[0:n]), list(x_fd[0:n]), atol=1e-4)
@@ -0,0 +1,46 @@
+import pytest
+
+from vic.vic import ffi
+from vic import lib as vic_lib
+
+
+def make_atmos_energy_bal(keep):
+    '''Set up a linear canopy air energy balance for the root finders'''
+    sensible_heat = ffi.new('double *')
+    keep.append(sensible_heat)
+
+    bal = ffi.new('atmos_energy_bal_struct *')
+    bal.Ra = 500.
+    bal.Tair = 2.
+    bal.atmos_density = 1.225
+    bal.InSensible = 20.
+    bal.SensibleHeat = sensible_heat
+
+    return bal
+
+
+@pytest.mark.parametrize('guess', [-6.1, -5., -7.9, 0., 11.9, -99.])
+def test_root_brent_guess(guess):
+    vic_lib.initialize_parameters()
+    keep = []
+    bal = make_atmos_energy_bal(keep)
+    func = ffi.addressof(vic_lib, 'func_atmos_energy_bal')
+
+    t_cold = vic_lib.root_brent(-8., 12., func, bal)
+    t_warm = vic_lib.root_brent_guess(-8., 12., guess, func, bal)
+
+    assert t_cold > -998
+    assert t_warm == pytest.approx(t_cold, abs=1e-4)
+    assert vic_lib.func_atmos_energy_bal(t_warm, bal) == pytest.approx(
+        0., abs=1e-4)
+
+
+def test_root_brent_guess_disabled():
+    vic_lib.initialize_parameters()
+    vic_lib.param.ROOT_BRENT_WARM_DT = 0.
+    keep = []
+    bal = make_atmos_energy_bal(keep)
+    func = ffi.addressof(vic_lib, 'func_atmos_energy_bal')
+
+    assert vic_lib.root_brent_guess(-8., 12., -6.1, func, bal) == \
+        vic_lib.root_brent(-8., 12., func, bal)
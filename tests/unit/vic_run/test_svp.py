@@ -1,4 +1,5 @@
 from vic import lib as vic_lib
+from vic import ffi
 
 
 def test_svp():
@@ -9,3 +10,11 @@ def test_svp():
 def test_svp_slope():
     assert vic_lib.svp_slope(0.) > 0.
     assert vic_lib.svp_slope(0.) > vic_lib.svp_slope(-1.)
+
+
+def test_svp_array():
+    temp = [-20., -1., 0., 1., 20.]
+    svp = ffi.new('double[]', len(temp))
+    vic_lib.svp_array(ffi.new('double[]', temp), len(temp), svp)
+    for i, t in enumerate(temp):
+        assert svp[i] == vic_lib.svp(t)
@@ -31,10 +31,53 @@
 
 #define VIC_DRIVER "Image"
 
+/******************************************************************************
+ * @brief   Ring buffer of forcing windows read ahead in a background thread.
+ *****************************************************************************/
+typedef struct {
+    size_t nsteps;                    /**< number of model steps per window */
+    size_t nslots;                    /**< number of windows in the ring */
+    size_t ntypes;                    /**< number of prefetched forcing types */
+    size_t types[N_FORCING_TYPES];    /**< prefetched forcing types */
+    bool prefetch[N_FORCING_TYPES];   /**< true if forcing type is prefetched */
+    size_t next_step[N_FORCING_TYPES];  /**< next model step to read */
+    size_t next_index[N_FORCING_TYPES]; /**< time index of next_step in the
+                                           forcing file */
+    size_t *slot_window;              /**< window stored in each slot
+                                         [nslots] */
+    bool *loaded;                     /**< window loaded [nslots * ntypes] */
+    double **data;                    /**< forcing windows in scatter order
+                                         [nslots * ntypes][nsteps * NF *
+                                         ncells_active] */
+    double *buffer;                   /**< read buffer [nsteps * NF *
+                                         ncells_total] */
+    size_t *cell_idx;                 /**< grid index of the active cells in
+                                         scatter order [ncells_active] */
+    int *scatter_sizes;               /**< scatter counts per node [mpi_size] */
+    int *scatter_offsets;             /**< scatter offsets per node
+                                         [mpi_size] */
+    pthread_t thread;                 /**< background reader */
+    pthread_mutex_t lock;             /**< lock for stop */
+    bool running;                     /**< true if the reader is running */
+    bool stop;                        /**< request for the reader to stop */
+} force_prefetch_struct;
+
 bool check_save_state_flag(size_t, dmy_struct *dmy_offset);
+bool check_snapshot_flag(size_t, dmy_struct *dmy_offset);
+void close_forcing_file(size_t file_num);
 void display_current_settings(int);
+void force_prefetch_finalize(void);
+void force_prefetch_get(size_t file_num, double *dvar);
+void force_prefetch_init(void);
+void force_prefetch_read(size_t window, size_t t);
+void force_prefetch_start(void);
+void force_prefetch_stop(void);
+void *force_prefetch_thread(void *arg);
+void get_forcing_field_double(size_t file_num, size_t ndims, size_t *start,
+                              size_t *count, double *dvar);
 void get_forcing_file_info(param_set_struct *param_set, size_t file_num);
 void get_global_param(FILE *);
+void open_forcing_file(size_t file_num, unsigned short int year);
 void vic_force(void);
 void vic_image_init(void);
 void vic_image_finalize();
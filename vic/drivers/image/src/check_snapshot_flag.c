@@ -0,0 +1,64 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Function to check whether a model state snapshot should be taken for the
+ * current time step
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_image.h>
+
+/******************************************************************************
+ * @brief   Function to check whether a model state snapshot should be taken
+ *          for the current time step
+ * @details Advances the snapshot alarm, so it must be called once every time
+ *          step. dmy_offset is set to the end of the current time step.
+ *****************************************************************************/
+bool
+check_snapshot_flag(size_t      current,
+                    dmy_struct *dmy_offset)
+{
+    extern global_param_struct    global_param;
+    extern dmy_struct            *dmy;
+    extern snapshot_writer_struct snapshot_writer;
+
+    double                        time_num;
+
+    if (global_param.snapshot_freq == FREQ_NEVER) {
+        return false;
+    }
+
+    snapshot_writer.alarm.count++;
+    if (!raise_alarm(&(snapshot_writer.alarm), &dmy[current])) {
+        return false;
+    }
+    reset_alarm(&(snapshot_writer.alarm), &dmy[current]);
+
+    // the state is valid at the end of the current time step
+    time_num = date2num(global_param.time_origin_num, &dmy[current], 0,
+                        global_param.calendar, TIME_UNITS_DAYS);
+    time_num += global_param.dt / (double) SEC_PER_DAY;
+    num2date(global_param.time_origin_num, time_num, 0,
+             global_param.calendar, TIME_UNITS_DAYS, dmy_offset);
+
+    return true;
+}
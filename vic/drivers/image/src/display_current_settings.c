@@ -128,6 +128,15 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "BLOWING\t\t\tFALSE\n");
     }
+    if (options.BLOWING_INTEGRATION == BLOWING_ROMBERG) {
+        fprintf(LOG_DEST, "BLOWING_INTEGRATION\tBLOWING_ROMBERG\n");
+    }
+    else if (options.BLOWING_INTEGRATION == BLOWING_GAUSS_LEGENDRE) {
+        fprintf(LOG_DEST, "BLOWING_INTEGRATION\tBLOWING_GAUSS_LEGENDRE\n");
+    }
+    else if (options.BLOWING_INTEGRATION == BLOWING_TABLE) {
+        fprintf(LOG_DEST, "BLOWING_INTEGRATION\tBLOWING_TABLE\n");
+    }
     if (options.CLOSE_ENERGY) {
         fprintf(LOG_DEST, "CLOSE_ENERGY\t\t\tTRUE\n");
     }
@@ -182,6 +191,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "IMPLICIT\t\tFALSE\n");
     }
+    if (options.IMPLICIT_JACOBIAN == JACOBIAN_ANALYTIC) {
+        fprintf(LOG_DEST, "IMPLICIT_JACOBIAN\tANALYTIC\n");
+    }
+    else {
+        fprintf(LOG_DEST, "IMPLICIT_JACOBIAN\tFINITE_DIFF\n");
+    }
     if (options.NOFLUX) {
         fprintf(LOG_DEST, "NOFLUX\t\t\tTRUE\n");
     }
@@ -409,6 +424,9 @@ display_current_settings(int mode)
         else if (options.STATE_FORMAT == NETCDF4) {
             fprintf(LOG_DEST, "STATE_FORMAT\t\tNETCDF4\n");
         }
+        else if (options.STATE_FORMAT == BINARY) {
+            fprintf(LOG_DEST, "STATE_FORMAT\t\tBINARY\n");
+        }
     }
     else {
         fprintf(LOG_DEST, "INIT_STATE\t\tFALSE\n");
@@ -435,6 +453,15 @@ display_current_settings(int mode)
         else if (options.STATE_FORMAT == NETCDF4) {
             fprintf(LOG_DEST, "STATE_FORMAT\t\tNETCDF4\n");
         }
+        else if (options.STATE_FORMAT == BINARY) {
+            fprintf(LOG_DEST, "STATE_FORMAT\t\tBINARY\n");
+        }
+        if (global_param.snapshot_freq != FREQ_NEVER) {
+            fprintf(LOG_DEST, "SNAPSHOT_FREQ\t\t%hu\t%d\n",
+                    global_param.snapshot_freq, global_param.snapshot_n);
+            fprintf(LOG_DEST, "SNAPSHOT_KEEP\t\t%zu\n",
+                    global_param.snapshot_keep);
+        }
     }
     else {
         fprintf(LOG_DEST, "SAVE_STATE\t\tFALSE\n");
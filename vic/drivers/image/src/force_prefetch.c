@@ -0,0 +1,455 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Read ahead the meteorological forcings in a background thread.
+ *
+ * Windows of options.FORCE_PREFETCH model steps are read on the master node,
+ * one netCDF read per forcing type and window (split only at a year
+ * boundary), and staged in a ring buffer of windows. The reads are done by an
+ * I/O thread that runs while vic_image_run() computes the current step, so
+ * that the forcing reads are hidden behind the computation. The thread only
+ * runs between force_prefetch_start() and force_prefetch_stop(), the only
+ * other netCDF calls in that period come from the history writer thread and
+ * both threads hold nc_io_lock while reading or writing.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_image.h>
+
+/******************************************************************************
+ * @brief    Initialize the forcing prefetch ring buffer
+ * @details  The set of prefetched forcing types is determined on all nodes,
+ *           the buffers are only allocated on the master node.
+ *****************************************************************************/
+void
+force_prefetch_init(void)
+{
+    extern size_t                NF;
+    extern filenames_struct      filenames;
+    extern force_prefetch_struct force_prefetch;
+    extern domain_struct         global_domain;
+    extern global_param_struct   global_param;
+    extern int                   mpi_rank;
+    extern int                   mpi_size;
+    extern int                  *mpi_map_global_array_offsets;
+    extern int                  *mpi_map_local_array_sizes;
+    extern size_t               *filter_active_cells;
+    extern size_t               *mpi_map_mapping_array;
+    extern option_struct         options;
+
+    size_t                       f;
+    size_t                       i;
+    size_t                       t;
+    int                          status;
+
+    force_prefetch.nsteps = options.FORCE_PREFETCH;
+    force_prefetch.ntypes = 0;
+    for (f = 0; f < N_FORCING_TYPES; f++) {
+        force_prefetch.prefetch[f] = false;
+    }
+    if (options.FORCE_PREFETCH == 0) {
+        return;
+    }
+
+    // the 3-D forcings that are read every step in vic_force
+    for (f = 0; f < N_FORCING_TYPES; f++) {
+        if (strcmp(filenames.f_path_pfx[f], "MISSING") == 0) {
+            continue;
+        }
+        if (f == AIR_TEMP || f == PREC || f == SWDOWN || f == LWDOWN ||
+            f == WIND || f == VP || f == PRESSURE ||
+            (options.LAKES && f == CHANNEL_IN) ||
+            (options.CARBON && (f == CATM || f == FDIR || f == PAR))) {
+            force_prefetch.prefetch[f] = true;
+            force_prefetch.types[force_prefetch.ntypes++] = f;
+        }
+    }
+
+    if (mpi_rank != VIC_MPI_ROOT) {
+        return;
+    }
+
+    // one window is consumed while the next one is read
+    force_prefetch.nslots = 2;
+
+    force_prefetch.slot_window = malloc(force_prefetch.nslots *
+                                        sizeof(*force_prefetch.slot_window));
+    check_alloc_status(force_prefetch.slot_window, "Memory allocation error.");
+    force_prefetch.loaded = malloc(force_prefetch.nslots *
+                                   force_prefetch.ntypes *
+                                   sizeof(*force_prefetch.loaded));
+    check_alloc_status(force_prefetch.loaded, "Memory allocation error.");
+    force_prefetch.data = malloc(force_prefetch.nslots *
+                                 force_prefetch.ntypes *
+                                 sizeof(*force_prefetch.data));
+    check_alloc_status(force_prefetch.data, "Memory allocation error.");
+    for (i = 0; i < force_prefetch.nslots; i++) {
+        // no window stored yet
+        force_prefetch.slot_window[i] = global_param.nrecs;
+        for (t = 0; t < force_prefetch.ntypes; t++) {
+            force_prefetch.loaded[i * force_prefetch.ntypes + t] = false;
+            force_prefetch.data[i * force_prefetch.ntypes + t] =
+                malloc(force_prefetch.nsteps * NF *
+                       global_domain.ncells_active *
+                       sizeof(*(force_prefetch.data[0])));
+            check_alloc_status(force_prefetch.data[i * force_prefetch.ntypes +
+                                                   t],
+                               "Memory allocation error.");
+        }
+    }
+    force_prefetch.buffer = malloc(force_prefetch.nsteps * NF *
+                                   global_domain.ncells_total *
+                                   sizeof(*force_prefetch.buffer));
+    check_alloc_status(force_prefetch.buffer, "Memory allocation error.");
+
+    // index in the full grid of each active cell in scatter order
+    force_prefetch.cell_idx = malloc(global_domain.ncells_active *
+                                     sizeof(*force_prefetch.cell_idx));
+    check_alloc_status(force_prefetch.cell_idx, "Memory allocation error.");
+    for (i = 0; i < global_domain.ncells_active; i++) {
+        force_prefetch.cell_idx[i] =
+            filter_active_cells[mpi_map_mapping_array[i]];
+    }
+
+    // all NF sub-steps of a node are sent as one block
+    force_prefetch.scatter_sizes = malloc(mpi_size *
+                                          sizeof(*force_prefetch.scatter_sizes));
+    check_alloc_status(force_prefetch.scatter_sizes,
+                       "Memory allocation error.");
+    force_prefetch.scatter_offsets = malloc(mpi_size *
+                                            sizeof(*force_prefetch.
+                                                   scatter_offsets));
+    check_alloc_status(force_prefetch.scatter_offsets,
+                       "Memory allocation error.");
+    for (i = 0; i < (size_t) mpi_size; i++) {
+        force_prefetch.scatter_sizes[i] = NF * mpi_map_local_array_sizes[i];
+        force_prefetch.scatter_offsets[i] = NF *
+                                            mpi_map_global_array_offsets[i];
+    }
+
+    // file cursors start at the first-year forcing files opened in
+    // get_global_param
+    for (f = 0; f < N_FORCING_TYPES; f++) {
+        force_prefetch.next_step[f] = 0;
+        force_prefetch.next_index[f] = global_param.forceskip[f];
+    }
+
+    force_prefetch.running = false;
+    force_prefetch.stop = false;
+    status = pthread_mutex_init(&(force_prefetch.lock), NULL);
+    if (status != 0) {
+        log_err("Error initializing forcing prefetch lock: %d", status);
+    }
+}
+
+/******************************************************************************
+ * @brief    Read one window of a prefetched forcing type into the ring buffer
+ * @details  The window is read with a single nc_get_vara_double call per
+ *           forcing file (a window that crosses a year boundary is read from
+ *           both yearly files). The active cells are stored per model step as
+ *           [node][NF][local cells], ready for one MPI_Scatterv per step.
+ *****************************************************************************/
+void
+force_prefetch_read(size_t window,
+                    size_t t)
+{
+    extern size_t                NF;
+    extern dmy_struct           *dmy;
+    extern filenames_struct      filenames;
+    extern force_prefetch_struct force_prefetch;
+    extern domain_struct         global_domain;
+    extern global_param_struct   global_param;
+    extern int                   mpi_size;
+    extern int                  *mpi_map_global_array_offsets;
+    extern int                  *mpi_map_local_array_sizes;
+    extern param_set_struct      param_set;
+
+    size_t                       f;
+    size_t                       slot;
+    size_t                       first;
+    size_t                       last;
+    size_t                       s;
+    size_t                       e;
+    size_t                       i;
+    size_t                       j;
+    size_t                       k;
+    size_t                       r;
+    size_t                       nactive;
+    size_t                       ntotal;
+    size_t                       d3start[3];
+    size_t                       d3count[3];
+    double                      *src;
+    double                      *dst;
+
+    f = force_prefetch.types[t];
+    slot = window % force_prefetch.nslots;
+    nactive = global_domain.ncells_active;
+    ntotal = global_domain.ncells_total;
+
+    // claim the slot for this window
+    if (force_prefetch.slot_window[slot] != window) {
+        force_prefetch.slot_window[slot] = window;
+        for (i = 0; i < force_prefetch.ntypes; i++) {
+            force_prefetch.loaded[slot * force_prefetch.ntypes + i] = false;
+        }
+    }
+
+    first = window * force_prefetch.nsteps;
+    last = first + force_prefetch.nsteps;
+    if (last > global_param.nrecs) {
+        last = global_param.nrecs;
+    }
+    if (force_prefetch.next_step[f] != first) {
+        log_err("Forcing prefetch for %s is out of order: expected step "
+                "%zu, got %zu", param_set.TYPE[f].varname,
+                force_prefetch.next_step[f], first);
+    }
+
+    d3start[1] = 0;
+    d3start[2] = 0;
+    d3count[1] = global_domain.n_ny;
+    d3count[2] = global_domain.n_nx;
+
+    for (s = first; s < last; s = e) {
+        // forcing files are yearly
+        if (s > 0 && dmy[s].year != dmy[s - 1].year) {
+            close_forcing_file(f);
+            open_forcing_file(f, dmy[s].year);
+            force_prefetch.next_index[f] = 0;
+        }
+        for (e = s + 1; e < last && dmy[e].year == dmy[e - 1].year; e++) {
+            ;
+        }
+
+        d3start[0] = force_prefetch.next_index[f];
+        d3count[0] = (e - s) * NF;
+        get_nc_field_double(&(filenames.forcing[f]),
+                            param_set.TYPE[f].varname,
+                            d3start, d3count, force_prefetch.buffer);
+
+        for (k = s; k < e; k++) {
+            dst = force_prefetch.data[slot * force_prefetch.ntypes + t] +
+                  (k - first) * NF * nactive;
+            for (j = 0; j < NF; j++) {
+                src = force_prefetch.buffer + ((k - s) * NF + j) * ntotal;
+                for (r = 0; r < (size_t) mpi_size; r++) {
+                    for (i = 0; i < (size_t) mpi_map_local_array_sizes[r];
+                         i++) {
+                        dst[NF * mpi_map_global_array_offsets[r] +
+                            j * mpi_map_local_array_sizes[r] + i] =
+                            src[force_prefetch.cell_idx[
+                                    mpi_map_global_array_offsets[r] + i]];
+                    }
+                }
+            }
+        }
+        force_prefetch.next_index[f] += (e - s) * NF;
+    }
+
+    force_prefetch.next_step[f] = last;
+    force_prefetch.loaded[slot * force_prefetch.ntypes + t] = true;
+
+    // Close forcing file after the last time step
+    if (last == global_param.nrecs) {
+        close_forcing_file(f);
+    }
+}
+
+/******************************************************************************
+ * @brief    Background reader: fill the ring buffer ahead of the current step
+ *****************************************************************************/
+void *
+force_prefetch_thread(void *arg)
+{
+    extern size_t                current;
+    extern force_prefetch_struct force_prefetch;
+    extern global_param_struct   global_param;
+    extern pthread_mutex_t       nc_io_lock;
+
+    size_t                       window;
+    size_t                       slot;
+    size_t                       t;
+    bool                         stop;
+
+    UNUSED(arg);
+
+    instrument_set_thread(INSTR_THREAD_FORCE_PREFETCH);
+
+    for (window = current / force_prefetch.nsteps;
+         window < current / force_prefetch.nsteps + force_prefetch.nslots &&
+         window * force_prefetch.nsteps < global_param.nrecs;
+         window++) {
+        slot = window % force_prefetch.nslots;
+        for (t = 0; t < force_prefetch.ntypes; t++) {
+            pthread_mutex_lock(&(force_prefetch.lock));
+            stop = force_prefetch.stop;
+            pthread_mutex_unlock(&(force_prefetch.lock));
+            if (stop) {
+                return NULL;
+            }
+            if (force_prefetch.slot_window[slot] == window &&
+                force_prefetch.loaded[slot * force_prefetch.ntypes + t]) {
+                continue;
+            }
+            pthread_mutex_lock(&nc_io_lock);
+            INSTRUMENT_BEGIN(INSTR_FORCE);
+            force_prefetch_read(window, t);
+            INSTRUMENT_END(INSTR_FORCE);
+            pthread_mutex_unlock(&nc_io_lock);
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief    Start the background reader on the master node
+ *****************************************************************************/
+void
+force_prefetch_start(void)
+{
+    extern force_prefetch_struct force_prefetch;
+    extern int                   mpi_rank;
+
+    int                          status;
+
+    if (force_prefetch.nsteps == 0 || mpi_rank != VIC_MPI_ROOT) {
+        return;
+    }
+
+    force_prefetch.stop = false;
+    status = pthread_create(&(force_prefetch.thread), NULL,
+                            force_prefetch_thread, NULL);
+    if (status != 0) {
+        log_err("Error creating forcing prefetch thread: %d", status);
+    }
+    force_prefetch.running = true;
+}
+
+/******************************************************************************
+ * @brief    Stop the background reader
+ * @details  The read in progress is completed, the remaining reads are picked
+ *           up again by the next force_prefetch_start() or, if the data is
+ *           needed earlier, read synchronously in force_prefetch_get().
+ *****************************************************************************/
+void
+force_prefetch_stop(void)
+{
+    extern force_prefetch_struct force_prefetch;
+
+    int                          status;
+
+    if (!force_prefetch.running) {
+        return;
+    }
+
+    pthread_mutex_lock(&(force_prefetch.lock));
+    force_prefetch.stop = true;
+    pthread_mutex_unlock(&(force_prefetch.lock));
+
+    status = pthread_join(force_prefetch.thread, NULL);
+    if (status != 0) {
+        log_err("Error joining forcing prefetch thread: %d", status);
+    }
+    force_prefetch.running = false;
+}
+
+/******************************************************************************
+ * @brief    Get all NF sub-steps of a prefetched forcing for the current step
+ * @details  dvar is filled as [NF][local active cells].
+ *****************************************************************************/
+void
+force_prefetch_get(size_t  file_num,
+                   double *dvar)
+{
+    extern size_t                NF;
+    extern size_t                current;
+    extern force_prefetch_struct force_prefetch;
+    extern domain_struct         global_domain;
+    extern domain_struct         local_domain;
+    extern int                   mpi_rank;
+    extern MPI_Comm              MPI_COMM_VIC;
+
+    size_t                       window;
+    size_t                       slot;
+    size_t                       t;
+    int                          status;
+    double                      *sendbuf = NULL;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        for (t = 0; t < force_prefetch.ntypes; t++) {
+            if (force_prefetch.types[t] == file_num) {
+                break;
+            }
+        }
+        if (t == force_prefetch.ntypes) {
+            log_err("Forcing type %zu is not prefetched", file_num);
+        }
+
+        window = current / force_prefetch.nsteps;
+        slot = window % force_prefetch.nslots;
+        if (force_prefetch.slot_window[slot] != window ||
+            !force_prefetch.loaded[slot * force_prefetch.ntypes + t]) {
+            // the background reader did not get to this window yet
+            force_prefetch_read(window, t);
+        }
+        sendbuf = force_prefetch.data[slot * force_prefetch.ntypes + t] +
+                  (current - window * force_prefetch.nsteps) * NF *
+                  global_domain.ncells_active;
+    }
+
+    status = MPI_Scatterv(sendbuf, force_prefetch.scatter_sizes,
+                          force_prefetch.scatter_offsets, MPI_DOUBLE,
+                          dvar, NF * local_domain.ncells_active, MPI_DOUBLE,
+                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+}
+
+/******************************************************************************
+ * @brief    Free the forcing prefetch ring buffer
+ *****************************************************************************/
+void
+force_prefetch_finalize(void)
+{
+    extern force_prefetch_struct force_prefetch;
+    extern int                   mpi_rank;
+
+    size_t                       i;
+
+    if (force_prefetch.nsteps == 0 || mpi_rank != VIC_MPI_ROOT) {
+        return;
+    }
+
+    force_prefetch_stop();
+    pthread_mutex_destroy(&(force_prefetch.lock));
+
+    for (i = 0; i < force_prefetch.nslots * force_prefetch.ntypes; i++) {
+        free(force_prefetch.data[i]);
+    }
+    free(force_prefetch.data);
+    free(force_prefetch.loaded);
+    free(force_prefetch.slot_window);
+    free(force_prefetch.buffer);
+    free(force_prefetch.cell_idx);
+    free(force_prefetch.scatter_sizes);
+    free(force_prefetch.scatter_offsets);
+}
@@ -153,6 +153,18 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.IMPLICIT = str_to_bool(flgstr);
             }
+            else if (strcasecmp("IMPLICIT_JACOBIAN", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                if (strcasecmp("FINITE_DIFF", flgstr) == 0) {
+                    options.IMPLICIT_JACOBIAN = JACOBIAN_FINITE_DIFF;
+                }
+                else if (strcasecmp("ANALYTIC", flgstr) == 0) {
+                    options.IMPLICIT_JACOBIAN = JACOBIAN_ANALYTIC;
+                }
+                else {
+                    log_err("Unknown IMPLICIT_JACOBIAN option: %s", flgstr);
+                }
+            }
             else if (strcasecmp("EXP_TRANS", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.EXP_TRANS = str_to_bool(flgstr);
@@ -193,6 +205,21 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.BLOWING_SPATIAL_WIND = str_to_bool(flgstr);
             }
+            else if (strcasecmp("BLOWING_INTEGRATION", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                if (strcasecmp("BLOWING_ROMBERG", flgstr) == 0) {
+                    options.BLOWING_INTEGRATION = BLOWING_ROMBERG;
+                }
+                else if (strcasecmp("BLOWING_GAUSS_LEGENDRE", flgstr) == 0) {
+                    options.BLOWING_INTEGRATION = BLOWING_GAUSS_LEGENDRE;
+                }
+                else if (strcasecmp("BLOWING_TABLE", flgstr) == 0) {
+                    options.BLOWING_INTEGRATION = BLOWING_TABLE;
+                }
+                else {
+                    log_err("Unknown BLOWING_INTEGRATION option: %s", flgstr);
+                }
+            }
             else if (strcasecmp("CORRPREC", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.CORRPREC = str_to_bool(flgstr);
@@ -289,6 +316,19 @@ get_global_param(FILE *gp)
             else if (strcasecmp("LOG_DIR", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", filenames.log_path);
             }
+            else if (strcasecmp("TIMING_REPORT", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.timing_report);
+            }
+
+            /*************************************
+               Define decomposition cost files
+            *************************************/
+            else if (strcasecmp("DECOMPOSITION_COST", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.decomp_cost.nc_filename);
+            }
+            else if (strcasecmp("DECOMPOSITION_OUT", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.decomp_out);
+            }
 
             /*************************************
                Define state files
@@ -320,6 +360,16 @@ get_global_param(FILE *gp)
             else if (strcasecmp("STATESEC", optstr) == 0) {
                 sscanf(cmdstr, "%*s %u", &global_param.statesec);
             }
+            else if (strcasecmp("SNAPSHOT_FREQ", optstr) == 0) {
+                status = sscanf(cmdstr, "%*s %s %s", flgstr, flgstr2);
+                global_param.snapshot_freq = str_to_freq_flag(flgstr);
+                if (status == 2) {
+                    global_param.snapshot_n = atoi(flgstr2);
+                }
+            }
+            else if (strcasecmp("SNAPSHOT_KEEP", optstr) == 0) {
+                sscanf(cmdstr, "%*s %zu", &global_param.snapshot_keep);
+            }
             else if (strcasecmp("STATE_FORMAT", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 if (strcasecmp("NETCDF3_CLASSIC", flgstr) == 0) {
@@ -334,9 +384,13 @@ get_global_param(FILE *gp)
                 else if (strcasecmp("NETCDF4", flgstr) == 0) {
                     options.STATE_FORMAT = NETCDF4;
                 }
+                else if (strcasecmp("BINARY", flgstr) == 0) {
+                    options.STATE_FORMAT = BINARY;
+                }
                 else {
                     log_err("STATE_FORMAT must be either NETCDF3_CLASSIC, "
-                            "NETCDF3_64BIT_OFFSET, NETCDF4_CLASSIC, or NETCDF4.");
+                            "NETCDF3_64BIT_OFFSET, NETCDF4_CLASSIC, NETCDF4, "
+                            "or BINARY.");
                 }
             }
 
@@ -349,6 +403,21 @@ get_global_param(FILE *gp)
             else if (strcasecmp("WIND_H", optstr) == 0) {
                 sscanf(cmdstr, "%*s %lf", &global_param.wind_h);
             }
+            else if (strcasecmp("FORCE_READER", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                if (strcasecmp("ROOT", flgstr) == 0) {
+                    options.FORCE_READER = FORCE_READ_ROOT;
+                }
+                else if (strcasecmp("PARALLEL", flgstr) == 0) {
+                    options.FORCE_READER = FORCE_READ_PARALLEL;
+                }
+                else {
+                    log_err("FORCE_READER must be either ROOT or PARALLEL.");
+                }
+            }
+            else if (strcasecmp("FORCE_PREFETCH", optstr) == 0) {
+                sscanf(cmdstr, "%*s %zu", &options.FORCE_PREFETCH);
+            }
 
             /*************************************
                Define parameter files
@@ -365,6 +434,9 @@ get_global_param(FILE *gp)
             else if (strcasecmp("PARAMETERS", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", filenames.params.nc_filename);
             }
+            else if (strcasecmp("PARAMETER_CACHE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.param_cache);
+            }
             else if (strcasecmp("ROUT_PARAM", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", filenames.rout_params.nc_filename);
             }
@@ -519,6 +591,14 @@ get_global_param(FILE *gp)
             else if (strcasecmp("RESULT_DIR", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", filenames.result_dir);
             }
+            else if (strcasecmp("OUTPUT_ASYNC", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.OUTPUT_ASYNC = str_to_bool(flgstr);
+            }
+            else if (strcasecmp("OUTPUT_ON_DEMAND", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.OUTPUT_ON_DEMAND = str_to_bool(flgstr);
+            }
 
             /*************************************
                Define output file contents
@@ -823,6 +903,18 @@ get_global_param(FILE *gp)
             file_num];
     }
 
+    // Validate forcing reader
+#if !NC_HAS_PARALLEL
+    if (options.FORCE_READER == FORCE_READ_PARALLEL) {
+        log_err("FORCE_READER PARALLEL was specified, but VIC was built "
+                "against a netCDF library without parallel I/O support.");
+    }
+#endif
+    if (options.FORCE_PREFETCH > 0 &&
+        options.FORCE_READER != FORCE_READ_ROOT) {
+        log_err("FORCE_PREFETCH can only be used with FORCE_READER ROOT.");
+    }
+
     // Validate result directory
     if (strcmp(filenames.result_dir, "MISSING") == 0) {
         log_err("No results directory has been defined.  Make sure that the "
@@ -913,12 +1005,33 @@ get_global_param(FILE *gp)
                     global_param.stateday, global_param.statesec);
         }
     }
+    // Validate the state snapshot information
+    if (global_param.snapshot_freq != FREQ_NEVER) {
+        if (!options.SAVE_STATE) {
+            log_err("\"SNAPSHOT_FREQ\" was specified, but no output state "
+                    "file has been defined.  Snapshots are written to "
+                    "STATENAME.");
+        }
+        if (global_param.snapshot_freq == FREQ_DATE ||
+            global_param.snapshot_freq == FREQ_END) {
+            log_err("SNAPSHOT_FREQ must be NSTEPS, NSECONDS, NMINUTES, "
+                    "NHOURS, NDAYS, NMONTHS or NYEARS.");
+        }
+        if (global_param.snapshot_n <= 0) {
+            log_err("The SNAPSHOT_FREQ interval must be larger than 0.");
+        }
+        if (global_param.snapshot_keep == 0) {
+            log_err("SNAPSHOT_KEEP must be larger than 0.");
+        }
+    }
+
     // Set the statename here temporarily to compare with INIT_STATE name
     if (options.SAVE_STATE) {
-        status = snprintf(flgstr2, sizeof(flgstr2), "%s.%04i%02i%02i_%05u.nc",
+        status = snprintf(flgstr2, sizeof(flgstr2), "%s.%04i%02i%02i_%05u.%s",
                           filenames.statefile, global_param.stateyear,
                           global_param.statemonth, global_param.stateday,
-                          global_param.statesec);
+                          global_param.statesec,
+                          options.STATE_FORMAT == BINARY ? "ckpt" : "nc");
         if (status >= MAXSTRING) {
             log_warn("State file name %s was too large [%d] "
                      "and is truncated to size [%d]",
@@ -967,8 +1080,9 @@ get_global_param(FILE *gp)
     }
     if (options.Nnode > MAX_NODES) {
         log_err("Global file wants more soil thermal nodes (%zu) than "
-                "are defined by MAX_NODES (%d).  Edit vic_driver_shared.h and "
-                "recompile.", options.Nnode, MAX_NODES);
+                "are defined by MAX_NODES (%d).  Recompile with a larger "
+                "MAX_NODES (e.g. make MAX_NODES=%zu).", options.Nnode,
+                MAX_NODES, options.Nnode);
     }
     if (!options.FULL_ENERGY && options.CLOSE_ENERGY) {
         log_err("CLOSE_ENERGY is TRUE but FULL_ENERGY is FALSE. Set "
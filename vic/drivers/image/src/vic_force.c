@@ -33,47 +33,49 @@
 void
 vic_force(void)
 {
-    extern size_t              NF;
-    extern size_t              NR;
-    extern size_t              current;
-    extern int                 mpi_rank;
-    extern force_data_struct  *force;
-    extern dmy_struct         *dmy;
-    extern domain_struct       global_domain;
-    extern domain_struct       local_domain;
-    extern filenames_struct    filenames;
-    extern global_param_struct global_param;
-    extern option_struct       options;
-    extern soil_con_struct    *soil_con;
-    extern veg_con_map_struct *veg_con_map;
-    extern veg_con_struct    **veg_con;
-    extern veg_hist_struct   **veg_hist;
-    extern parameters_struct   param;
-    extern param_set_struct    param_set;
-
-    double                    *t_offset = NULL;
-    double                    *dvar = NULL;
-    size_t                     i;
-    size_t                     j;
-    size_t                     v;
-    size_t                     f;
-    size_t                     band;
-    int                        vidx;
-    int                        status;
-    size_t                     d3count[3];
-    size_t                     d3start[3];
-    size_t                     d4count[4];
-    size_t                     d4start[4];
-    double                    *Tfactor;
-
-    // allocate memory for variables to be read
-    dvar = malloc(local_domain.ncells_active * sizeof(*dvar));
+    extern size_t                NF;
+    extern size_t                NR;
+    extern size_t                current;
+    extern force_data_struct    *force;
+    extern force_prefetch_struct force_prefetch;
+    extern dmy_struct           *dmy;
+    extern domain_struct         global_domain;
+    extern domain_struct         local_domain;
+    extern filenames_struct      filenames;
+    extern global_param_struct   global_param;
+    extern option_struct         options;
+    extern soil_con_struct      *soil_con;
+    extern veg_con_map_struct   *veg_con_map;
+    extern veg_con_struct      **veg_con;
+    extern veg_hist_struct     **veg_hist;
+    extern parameters_struct     param;
+
+    double                      *t_offset = NULL;
+    double                      *dvar = NULL;
+    size_t                       i;
+    size_t                       j;
+    size_t                       v;
+    size_t                       f;
+    size_t                       band;
+    int                          vidx;
+    size_t                       d3count[3];
+    size_t                       d3start[3];
+    size_t                       d4count[4];
+    size_t                       d4start[4];
+    double                      *Tfactor;
+
+    // allocate memory for variables to be read (all sub-steps)
+    dvar = malloc(NF * local_domain.ncells_active * sizeof(*dvar));
     check_alloc_status(dvar, "Memory allocation error.");
 
     for (f = 0; f < N_FORCING_TYPES; f++) {
         if (strcmp(filenames.f_path_pfx[f], "MISSING") == 0) {
             continue;
         }
+        // files of prefetched forcings are handled by the read ahead
+        if (force_prefetch.prefetch[f]) {
+            continue;
+        }
 
         // global_param.forceoffset resets every year since the met file restarts
         // every year
@@ -85,20 +87,8 @@ vic_force(void)
             // file for the current new year
             // (forcing file for the first year should already be open in
             // get_global_param)
-            if (mpi_rank == VIC_MPI_ROOT) {
-                // close previous forcing file
-                status = nc_close(filenames.forcing[f].nc_id);
-                check_nc_status(status, "Error closing %s",
-                                filenames.forcing[f].nc_filename);
-                // open new forcing file
-                snprintf(filenames.forcing[f].nc_filename, MAXSTRING,
-                         "%s%4d.nc",
-                         filenames.f_path_pfx[f], dmy[current].year);
-                status = nc_open(filenames.forcing[f].nc_filename, NC_NOWRITE,
-                                 &(filenames.forcing[f].nc_id));
-                check_nc_status(status, "Error opening %s",
-                                filenames.forcing[f].nc_filename);
-            }
+            close_forcing_file(f);
+            open_forcing_file(f, dmy[current].year);
         }
     }
 
@@ -110,119 +100,77 @@ vic_force(void)
     d3count[2] = global_domain.n_nx;
 
     // Air temperature: tas
+    get_forcing_field_double(AIR_TEMP, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[AIR_TEMP] +
-                     global_param.forceoffset[AIR_TEMP] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[AIR_TEMP]),
-                                    param_set.TYPE[AIR_TEMP].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].air_temp[j] = (double) dvar[i];
+            force[i].air_temp[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // Precipitation: prcp
+    get_forcing_field_double(PREC, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[PREC] +
-                     global_param.forceoffset[PREC] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[PREC]),
-                                    param_set.TYPE[PREC].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].prec[j] = (double) dvar[i];
+            force[i].prec[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // Downward solar radiation: dswrf
+    get_forcing_field_double(SWDOWN, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[SWDOWN] +
-                     global_param.forceoffset[SWDOWN] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[SWDOWN]),
-                                    param_set.TYPE[SWDOWN].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].shortwave[j] = (double) dvar[i];
+            force[i].shortwave[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // Downward longwave radiation: dlwrf
+    get_forcing_field_double(LWDOWN, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[LWDOWN] +
-                     global_param.forceoffset[LWDOWN] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[LWDOWN]),
-                                    param_set.TYPE[LWDOWN].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].longwave[j] = (double) dvar[i];
+            force[i].longwave[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // Wind speed: wind
+    get_forcing_field_double(WIND, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[WIND] +
-                     global_param.forceoffset[WIND] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[WIND]),
-                                    param_set.TYPE[WIND].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].wind[j] = (double) dvar[i];
+            force[i].wind[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // vapor pressure: vp
+    get_forcing_field_double(VP, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[VP] + global_param.forceoffset[VP] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[VP]),
-                                    param_set.TYPE[VP].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].vp[j] = (double) dvar[i];
+            force[i].vp[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
 
     // Pressure: pressure
+    get_forcing_field_double(PRESSURE, 3, d3start, d3count, dvar);
     for (j = 0; j < NF; j++) {
-        d3start[0] = global_param.forceskip[PRESSURE] +
-                     global_param.forceoffset[PRESSURE] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[PRESSURE]),
-                                    param_set.TYPE[PRESSURE].varname,
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            force[i].pressure[j] = (double) dvar[i];
+            force[i].pressure[j] = dvar[j * local_domain.ncells_active + i];
         }
     }
     // Optional inputs
     if (options.LAKES) {
         // Channel inflow to lake
-        d3start[0] = global_param.forceskip[CHANNEL_IN] +
-                     global_param.forceoffset[CHANNEL_IN] +
-                     j;
-        get_scatter_nc_field_double(&(filenames.forcing[CHANNEL_IN]),
-                                    param_set.TYPE[CHANNEL_IN].varname,
-                                    d3start, d3count, dvar);
+        get_forcing_field_double(CHANNEL_IN, 3, d3start, d3count, dvar);
         for (j = 0; j < NF; j++) {
             for (i = 0; i < local_domain.ncells_active; i++) {
-                force[i].channel_in[j] = (double) dvar[i];
+                force[i].channel_in[j] =
+                    dvar[j * local_domain.ncells_active + i];
             }
         }
     }
     if (options.CARBON) {
         // Atmospheric CO2 mixing ratio
+        get_forcing_field_double(CATM, 3, d3start, d3count, dvar);
         for (j = 0; j < NF; j++) {
-            d3start[0] = global_param.forceskip[CATM] +
-                         global_param.forceoffset[CATM] + j;
-            get_scatter_nc_field_double(&(filenames.forcing[CATM]),
-                                        param_set.TYPE[CATM].varname,
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                force[i].Catm[j] = (double) dvar[i];
+                force[i].Catm[j] = dvar[j * local_domain.ncells_active + i];
             }
         }
         // Cosine of solar zenith angle
@@ -236,25 +184,17 @@ vic_force(void)
             }
         }
         // Fraction of shortwave that is direct
+        get_forcing_field_double(FDIR, 3, d3start, d3count, dvar);
         for (j = 0; j < NF; j++) {
-            d3start[0] = global_param.forceskip[FDIR] +
-                         global_param.forceoffset[FDIR] + j;
-            get_scatter_nc_field_double(&(filenames.forcing[FDIR]),
-                                        param_set.TYPE[FDIR].varname,
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                force[i].fdir[j] = (double) dvar[i];
+                force[i].fdir[j] = dvar[j * local_domain.ncells_active + i];
             }
         }
         // Photosynthetically active radiation
+        get_forcing_field_double(PAR, 3, d3start, d3count, dvar);
         for (j = 0; j < NF; j++) {
-            d3start[0] = global_param.forceskip[PAR] +
-                         global_param.forceoffset[PAR] + j;
-            get_scatter_nc_field_double(&(filenames.forcing[PAR]),
-                                        param_set.TYPE[PAR].varname,
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                force[i].par[j] = (double) dvar[i];
+                force[i].par[j] = dvar[j * local_domain.ncells_active + i];
             }
         }
     }
@@ -305,18 +245,15 @@ vic_force(void)
 
         // Leaf Area Index: LAI
         if (options.LAI_SRC == FROM_VEGHIST) {
-            for (j = 0; j < NF; j++) {
-                d4start[0] = global_param.forceskip[LAI] +
-                             global_param.forceoffset[LAI] + j;
-                for (v = 0; v < options.NVEGTYPES; v++) {
-                    d4start[1] = v;
-                    get_scatter_nc_field_double(&(filenames.forcing[LAI]),
-                                                param_set.TYPE[LAI].varname,
-                                                d4start, d4count, dvar);
+            for (v = 0; v < options.NVEGTYPES; v++) {
+                d4start[1] = v;
+                get_forcing_field_double(LAI, 4, d4start, d4count, dvar);
+                for (j = 0; j < NF; j++) {
                     for (i = 0; i < local_domain.ncells_active; i++) {
                         vidx = veg_con_map[i].vidx[v];
                         if (vidx != NODATA_VEG) {
-                            veg_hist[i][vidx].LAI[j] = (double) dvar[i];
+                            veg_hist[i][vidx].LAI[j] =
+                                dvar[j * local_domain.ncells_active + i];
                         }
                     }
                 }
@@ -325,19 +262,15 @@ vic_force(void)
 
         // Partial veg cover fraction: fcanopy
         if (options.FCAN_SRC == FROM_VEGHIST) {
-            for (j = 0; j < NF; j++) {
-                d4start[0] = global_param.forceskip[FCANOPY] +
-                             global_param.forceoffset[FCANOPY] + j;
-                for (v = 0; v < options.NVEGTYPES; v++) {
-                    d4start[1] = v;
-                    get_scatter_nc_field_double(&(filenames.forcing[FCANOPY]),
-                                                param_set.TYPE[FCANOPY].varname,
-                                                d4start, d4count,
-                                                dvar);
+            for (v = 0; v < options.NVEGTYPES; v++) {
+                d4start[1] = v;
+                get_forcing_field_double(FCANOPY, 4, d4start, d4count, dvar);
+                for (j = 0; j < NF; j++) {
                     for (i = 0; i < local_domain.ncells_active; i++) {
                         vidx = veg_con_map[i].vidx[v];
                         if (vidx != NODATA_VEG) {
-                            veg_hist[i][vidx].fcanopy[j] = (double) dvar[i];
+                            veg_hist[i][vidx].fcanopy[j] =
+                                dvar[j * local_domain.ncells_active + i];
                         }
                     }
                 }
@@ -346,19 +279,15 @@ vic_force(void)
 
         // Albedo: albedo
         if (options.ALB_SRC == FROM_VEGHIST) {
-            for (j = 0; j < NF; j++) {
-                d4start[0] = global_param.forceskip[ALBEDO] +
-                             global_param.forceoffset[ALBEDO] + j;
-                for (v = 0; v < options.NVEGTYPES; v++) {
-                    d4start[1] = v;
-                    get_scatter_nc_field_double(&(filenames.forcing[ALBEDO]),
-                                                param_set.TYPE[ALBEDO].varname,
-                                                d4start, d4count,
-                                                dvar);
+            for (v = 0; v < options.NVEGTYPES; v++) {
+                d4start[1] = v;
+                get_forcing_field_double(ALBEDO, 4, d4start, d4count, dvar);
+                for (j = 0; j < NF; j++) {
                     for (i = 0; i < local_domain.ncells_active; i++) {
                         vidx = veg_con_map[i].vidx[v];
                         if (vidx != NODATA_VEG) {
-                            veg_hist[i][vidx].albedo[j] = (double) dvar[i];
+                            veg_hist[i][vidx].albedo[j] =
+                                dvar[j * local_domain.ncells_active + i];
                         }
                     }
                 }
@@ -371,13 +300,9 @@ vic_force(void)
             continue;
         }
 
-        if (mpi_rank == VIC_MPI_ROOT) {
-            // Close forcing file if it is the last time step
-            if (current == global_param.nrecs - 1) {
-                status = nc_close(filenames.forcing[f].nc_id);
-                check_nc_status(status, "Error closing %s",
-                                filenames.forcing[f].nc_filename);
-            }
+        // Close forcing file if it is the last time step
+        if (current == global_param.nrecs - 1 && !force_prefetch.prefetch[f]) {
+            close_forcing_file(f);
         }
 
         // Update the offset counter
@@ -405,17 +330,18 @@ vic_force(void)
     }
     // Convert forcings into what we need and calculate missing ones
     for (i = 0; i < local_domain.ncells_active; i++) {
+        // saturated vapor pressure in Pa, all sub-steps at once
+        svp_array(force[i].air_temp, NF, force[i].vpd);
         for (j = 0; j < NF; j++) {
             // pressure in Pa
             force[i].pressure[j] *= PA_PER_KPA;
             // vapor pressure in Pa
             force[i].vp[j] *= PA_PER_KPA;
             // vapor pressure deficit in Pa
-            force[i].vpd[j] = svp(force[i].air_temp[j]) - force[i].vp[j];
-            if (force[i].vpd[j] < 0) {
-                force[i].vpd[j] = 0;
-                force[i].vp[j] = svp(force[i].air_temp[j]);
+            if (force[i].vpd[j] < force[i].vp[j]) {
+                force[i].vp[j] = force[i].vpd[j];
             }
+            force[i].vpd[j] -= force[i].vp[j];
             // air density in kg/m3
             force[i].density[j] = air_density(force[i].air_temp[j],
                                               force[i].pressure[j]);
@@ -508,6 +434,113 @@ vic_force(void)
     plugin_force();
 }
 
+/******************************************************************************
+ * @brief    Read all NF sub-steps of a forcing variable for the current step
+ * @details  start and count describe a single sub-step on the full grid, the
+ *           time index (first dimension) is set here from the forcing skip
+ *           and offset. dvar is filled as [NF][local active cells].
+ *           Prefetched forcings are taken from the read-ahead ring buffer.
+ *           With FORCE_READ_ROOT each sub-step is read on the master node and
+ *           scattered. With FORCE_READ_PARALLEL all sub-steps are read in a
+ *           single collective call in which every node only reads the
+ *           hyperslab that covers its own active cells.
+ *****************************************************************************/
+void
+get_forcing_field_double(size_t  file_num,
+                         size_t  ndims,
+                         size_t *start,
+                         size_t *count,
+                         double *dvar)
+{
+    extern size_t                NF;
+    extern domain_struct         local_domain;
+    extern filenames_struct      filenames;
+    extern force_prefetch_struct force_prefetch;
+    extern global_param_struct   global_param;
+    extern option_struct         options;
+    extern param_set_struct      param_set;
+
+    size_t                       j;
+
+    if (force_prefetch.prefetch[file_num]) {
+        force_prefetch_get(file_num, dvar);
+    }
+    else if (options.FORCE_READER == FORCE_READ_PARALLEL) {
+        start[0] = global_param.forceskip[file_num] +
+                   global_param.forceoffset[file_num];
+        count[0] = NF;
+        get_par_nc_field_double(&(filenames.forcing[file_num]),
+                                param_set.TYPE[file_num].varname,
+                                ndims, start, count, dvar);
+        count[0] = 1;
+    }
+    else {
+        for (j = 0; j < NF; j++) {
+            start[0] = global_param.forceskip[file_num] +
+                       global_param.forceoffset[file_num] + j;
+            get_scatter_nc_field_double(&(filenames.forcing[file_num]),
+                                        param_set.TYPE[file_num].varname,
+                                        start, count,
+                                        &(dvar[j * local_domain.ncells_active]));
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Open the forcing file of a forcing type for the given year
+ * @details  With FORCE_READ_ROOT the file is opened on the master node only,
+ *           with FORCE_READ_PARALLEL it is opened collectively on all nodes.
+ *****************************************************************************/
+void
+open_forcing_file(size_t             file_num,
+                  unsigned short int year)
+{
+    extern filenames_struct filenames;
+    extern int              mpi_rank;
+    extern option_struct    options;
+
+    char                    filename[MAXSTRING];
+    int                     status;
+
+    status = snprintf(filename, MAXSTRING, "%s%4d.nc",
+                      filenames.f_path_pfx[file_num], year);
+    if (status >= MAXSTRING) {
+        log_err("Forcing file name %s%4d.nc is too large [%d]",
+                filenames.f_path_pfx[file_num], year, status);
+    }
+    strcpy(filenames.forcing[file_num].nc_filename, filename);
+
+    if (options.FORCE_READER == FORCE_READ_PARALLEL) {
+        open_par_nc_file(&(filenames.forcing[file_num]));
+    }
+    else if (mpi_rank == VIC_MPI_ROOT) {
+        status = nc_open(filenames.forcing[file_num].nc_filename, NC_NOWRITE,
+                         &(filenames.forcing[file_num].nc_id));
+        check_nc_status(status, "Error opening %s",
+                        filenames.forcing[file_num].nc_filename);
+    }
+}
+
+/******************************************************************************
+ * @brief    Close the forcing file of a forcing type
+ *****************************************************************************/
+void
+close_forcing_file(size_t file_num)
+{
+    extern filenames_struct filenames;
+    extern int              mpi_rank;
+    extern option_struct    options;
+
+    int                     status;
+
+    if (options.FORCE_READER == FORCE_READ_PARALLEL ||
+        mpi_rank == VIC_MPI_ROOT) {
+        status = nc_close(filenames.forcing[file_num].nc_id);
+        check_nc_status(status, "Error closing %s",
+                        filenames.forcing[file_num].nc_filename);
+    }
+}
+
 /******************************************************************************
  * @brief    Determine timestep and start year, month, day, and seconds of forcing files
  *****************************************************************************/
@@ -30,15 +30,21 @@
 size_t              NF, NR;
 size_t              current;
 size_t             *filter_active_cells = NULL;
+double             *cell_cost = NULL;  // [ncells]
+double             *decomp_cost = NULL;  // [global active cells]
 size_t             *mpi_map_mapping_array = NULL;
 all_vars_struct    *all_vars = NULL;
+blowing_table_struct blowing_table;
 force_data_struct  *force = NULL;
 dmy_struct         *dmy = NULL;
 dmy_struct          dmy_state;
 filenames_struct    filenames;
 filep_struct        filep;
+force_prefetch_struct force_prefetch;
 domain_struct       global_domain;
 global_param_struct global_param;
+hist_writer_struct  hist_writer;
+instrument_struct   instrument;
 lake_con_struct    *lake_con = NULL;
 domain_struct       local_domain;
 MPI_Comm            MPI_COMM_VIC = MPI_COMM_WORLD;
@@ -50,6 +56,7 @@ MPI_Datatype        mpi_option_struct_type;
 MPI_Datatype        mpi_param_struct_type;
 int                *mpi_map_local_array_sizes = NULL;
 int                *mpi_map_global_array_offsets = NULL;
+mpi_slab_struct     mpi_local_slab;
 int                 mpi_rank;
 int                 mpi_size;
 option_struct       options;
@@ -62,10 +69,13 @@ veg_hist_struct   **veg_hist = NULL;
 veg_lib_struct    **veg_lib = NULL;
 metadata_struct     state_metadata[N_STATE_VARS + PLUGIN_N_STATE_VARS];
 metadata_struct     out_metadata[N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES];
+bool                out_requested[N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES];
 save_data_struct   *save_data;  // [ncells]
+snapshot_writer_struct snapshot_writer;
 double           ***out_data = NULL;  // [ncells, nvars, nelem]
 stream_struct      *output_streams = NULL;  // [nstreams]
 nc_file_struct     *nc_hist_files = NULL;  // [nstreams]
+pthread_mutex_t     nc_io_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /******************************************************************************
  * @brief   Stand-alone image mode driver of the VIC model
@@ -102,6 +112,9 @@ main(int    argc,
     initialize_mpi();
     plugin_initialize_mpi();
 
+    // counters of the instrumented regions, before any thread is started
+    instrument_init();
+
     // process command line arguments
     if (mpi_rank == VIC_MPI_ROOT) {
         cmd_proc(argc, argv, filenames.global);
@@ -150,21 +163,61 @@ main(int    argc,
     for (current = 0; current < global_param.nrecs; current++) {
         // read forcing data
         timer_continue(&(global_timers[TIMER_VIC_FORCE]));
+        INSTRUMENT_BEGIN(INSTR_FORCE);
         vic_force();
+        INSTRUMENT_END(INSTR_FORCE);
         timer_stop(&(global_timers[TIMER_VIC_FORCE]));
 
-        // run vic over the domain
+        // run vic over the domain, while reading ahead forcing data and
+        // writing history data in the background
+        timer_continue(&(global_timers[TIMER_VIC_WRITE]));
+        INSTRUMENT_BEGIN(INSTR_WRITE);
+        hist_writer_start();
+        INSTRUMENT_END(INSTR_WRITE);
+        timer_stop(&(global_timers[TIMER_VIC_WRITE]));
+        force_prefetch_start();
         vic_image_run(&(dmy[current]));
+        timer_continue(&(global_timers[TIMER_VIC_FORCE]));
+        INSTRUMENT_BEGIN(INSTR_FORCE);
+        force_prefetch_stop();
+        INSTRUMENT_END(INSTR_FORCE);
+        timer_stop(&(global_timers[TIMER_VIC_FORCE]));
+        timer_continue(&(global_timers[TIMER_VIC_WRITE]));
+        INSTRUMENT_BEGIN(INSTR_WRITE);
+        hist_writer_stop();
+        INSTRUMENT_END(INSTR_WRITE);
+        timer_stop(&(global_timers[TIMER_VIC_WRITE]));
 
         // Write history files
         timer_continue(&(global_timers[TIMER_VIC_WRITE]));
+        INSTRUMENT_BEGIN(INSTR_WRITE);
         vic_write_output(&(dmy[current]));
+        INSTRUMENT_END(INSTR_WRITE);
+        timer_stop(&(global_timers[TIMER_VIC_WRITE]));
+
+        // Take a state snapshot, it is written in the background. No
+        // snapshot is needed if the state file is written at this time step.
+        timer_continue(&(global_timers[TIMER_VIC_WRITE]));
+        INSTRUMENT_BEGIN(INSTR_STATE);
+        if (check_snapshot_flag(current, &dmy_state) &&
+            !check_save_state_flag(current, &dmy_state)) {
+            vic_snapshot(&dmy_state);
+        }
+        snapshot_writer_poll();
+        INSTRUMENT_END(INSTR_STATE);
         timer_stop(&(global_timers[TIMER_VIC_WRITE]));
 
         // Write state file
         if (check_save_state_flag(current, &dmy_state)) {
             debug("writing state file for timestep %zu", current);
-            vic_store(&dmy_state, state_filename);
+            INSTRUMENT_BEGIN(INSTR_STATE);
+            if (options.STATE_FORMAT == BINARY) {
+                vic_store_checkpoint(&dmy_state, state_filename);
+            }
+            else {
+                vic_store(&dmy_state, state_filename);
+            }
+            INSTRUMENT_END(INSTR_STATE);
             debug("finished storing state file: %s", state_filename)
         }
     }
@@ -192,6 +245,7 @@ main(int    argc,
         // write timing info
         write_vic_timing_table(global_timers, VIC_DRIVER);
     }
+    instrument_finalize();
 
     return EXIT_SUCCESS;
 }
@@ -36,6 +36,7 @@ vic_image_finalize(void)
     extern dmy_struct *dmy;
 
     // free data structures specific to to image driver
+    force_prefetch_finalize();
     free(dmy);
 
     plugin_finalize();
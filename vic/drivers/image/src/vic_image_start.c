@@ -33,9 +33,16 @@
 void
 vic_image_start(void)
 {
-    extern filep_struct     filep;
-    extern filenames_struct filenames;
-    extern int              mpi_rank;
+    extern filep_struct        filep;
+    extern filenames_struct    filenames;
+    extern global_param_struct global_param;
+    extern int                 mpi_rank;
+    extern MPI_Comm            MPI_COMM_VIC;
+    extern option_struct       options;
+    extern param_set_struct    param_set;
+
+    size_t                     f;
+    int                        status;
 
     // Initialize structures
     initialize_global_structures();
@@ -49,4 +56,27 @@ vic_image_start(void)
 
     // initialize image mode structures and settings
     vic_start();
+
+    // with the parallel forcing reader, the first-year forcing files that
+    // were opened on the master node in get_global_param are reopened
+    // collectively on all nodes
+    if (options.FORCE_READER == FORCE_READ_PARALLEL) {
+        for (f = 0; f < N_FORCING_TYPES; f++) {
+            status = MPI_Bcast(param_set.TYPE[f].varname, MAXSTRING, MPI_CHAR,
+                               VIC_MPI_ROOT, MPI_COMM_VIC);
+            check_mpi_status(status, "MPI error.");
+            if (strcmp(filenames.f_path_pfx[f], "MISSING") == 0) {
+                continue;
+            }
+            if (mpi_rank == VIC_MPI_ROOT) {
+                status = nc_close(filenames.forcing[f].nc_id);
+                check_nc_status(status, "Error closing %s",
+                                filenames.forcing[f].nc_filename);
+            }
+            open_forcing_file(f, global_param.startyear);
+        }
+    }
+
+    // set up the forcing read ahead
+    force_prefetch_init();
 }
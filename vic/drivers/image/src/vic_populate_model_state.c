@@ -42,15 +42,21 @@ vic_populate_model_state(dmy_struct *dmy_current)
     extern all_vars_struct *all_vars;
     extern lake_con_struct *lake_con;
     extern domain_struct    local_domain;
+    extern filenames_struct filenames;
     extern option_struct    options;
     extern soil_con_struct *soil_con;
     extern veg_con_struct **veg_con;
 
     size_t                  i;
 
-    // read the model state from the netcdf file if there is one
+    // read the model state from the checkpoint or netcdf file if there is one
     if (options.INIT_STATE) {
-        vic_restore();
+        if (is_checkpoint_file(filenames.init_state.nc_filename)) {
+            vic_restore_checkpoint();
+        }
+        else {
+            vic_restore();
+        }
     }
     else {
         // else generate a default state
@@ -61,6 +61,15 @@ enum
     NETCDF4
 };
 
+/******************************************************************************
+ * @brief   forcing reader types
+ *****************************************************************************/
+enum
+{
+    FORCE_READ_ROOT,      /**< read on the master node and scatter */
+    FORCE_READ_PARALLEL   /**< collective parallel read on all nodes */
+};
+
 /******************************************************************************
  * @brief   endian flags
  *****************************************************************************/
@@ -526,7 +535,9 @@ typedef struct {
                                           The order of the id numbers in the varid array
                                           is the order in which the variables will be written. */
     unsigned short int *aggtype;     /**< type of aggregation to use [shape=(nvars, )] */
-    double ****aggdata;              /**< array of aggregated data values [shape=(ngridcells, nvars, nelem, nbins)] */
+    size_t nvalues;                  /**< number of aggregated values per grid cell (sum of nelem over all variables) */
+    size_t *aggoffset;               /**< index of the first aggregated value of each variable [shape=(nvars, )] */
+    double *aggdata;                 /**< array of aggregated data values, one contiguous slice of grid cells per value [shape=(nvalues, ngridcells)] */
     alarm_struct agg_alarm;          /**< alaram for stream aggregation */
     alarm_struct write_alarm;        /**< alaram for controlling stream write */
 } stream_struct;
@@ -587,6 +598,11 @@ typedef struct {
 double air_density(double t, double p);
 void agg_stream_data(stream_struct *stream, dmy_struct *dmy_current,
                      double ***out_data);
+void agg_stream_div(size_t n, double count, double *agg);
+void agg_stream_max(size_t n, size_t stride, double *src, double *agg);
+void agg_stream_min(size_t n, size_t stride, double *src, double *agg);
+void agg_stream_set(size_t n, size_t stride, double *src, double *agg);
+void agg_stream_sum(size_t n, size_t stride, double *src, double *agg);
 double all_30_day_from_dmy(dmy_struct *dmy);
 double all_leap_from_dmy(dmy_struct *dmy);
 void alloc_aggdata(stream_struct *stream);
@@ -615,6 +631,7 @@ void compress_files(char string[], short int level);
 stream_struct create_outstream(stream_struct *output_streams);
 double get_cpu_time();
 void get_current_datetime(char *cdt);
+double get_thread_cpu_time();
 double get_wall_time();
 double date2num(double origin, dmy_struct *date, double tzoffset,
                 unsigned short int calendar, unsigned short int time_units);
@@ -638,6 +655,7 @@ void generate_default_state(all_vars_struct *, soil_con_struct *,
 void generate_default_lake_state(all_vars_struct *, soil_con_struct *,
                                  lake_con_struct);
 void get_default_nstreams_nvars(size_t *nstreams, size_t nvars[]);
+size_t get_out_data_nelem(size_t *nscratch);
 void get_parameters(FILE *paramfile);
 void init_output_list(double **out_data, int write, char *format, int type,
                       double mult);
@@ -717,6 +735,7 @@ void set_output_defaults(stream_struct **output_streams,
                          dmy_struct     *dmy_current,
                          unsigned short  default_file_format);
 void set_output_met_data_info();
+void set_output_requested(stream_struct *streams, size_t nstreams);
 void setup_stream(stream_struct *stream, size_t nvars, size_t ngridcells);
 void soil_moisture_from_water_table(soil_con_struct *soil_con, size_t nlayers);
 void sprint_dmy(char *str, dmy_struct *dmy);
@@ -735,7 +754,9 @@ double time_delta(dmy_struct *dmy_current, unsigned short int freq, int n);
 void timer_continue(timer_struct *t);
 void timer_init(timer_struct *t);
 void timer_start(timer_struct *t);
+void timer_start_thread(timer_struct *t);
 void timer_stop(timer_struct *t);
+void timer_stop_thread(timer_struct *t);
 int update_step_vars(all_vars_struct *, veg_con_struct *, veg_hist_struct *);
 int invalid_date(unsigned short int calendar, dmy_struct *dmy);
 void validate_parameters(void);
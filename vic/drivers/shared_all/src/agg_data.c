@@ -25,9 +25,13 @@
  *****************************************************************************/
 
 #include <vic_driver_shared_all.h>
+#include <plugin.h>
 
 /******************************************************************************
  * @brief    Perform temporal aggregation on stream data
+ * @details  The aggregation type is resolved once per output value, after
+ *           which one of the agg_stream_* kernels below processes the
+ *           contiguous slice of grid cells of that value.
  *****************************************************************************/
 void
 agg_stream_data(stream_struct *stream,
@@ -37,10 +41,12 @@ agg_stream_data(stream_struct *stream,
     extern metadata_struct out_metadata[];
 
     alarm_struct          *alarm;
-    size_t                 i;
     size_t                 j;
     size_t                 k;
-    size_t                 nelem;
+    size_t                 n;
+    size_t                 stride;
+    double                *agg;
+    double                *src;
     unsigned int           varid;
     bool                   alarm_now;
 
@@ -56,51 +62,127 @@ agg_stream_data(stream_struct *stream,
         stream->time_bounds[1] = *dmy_current;
     }
 
-    for (i = 0; i < stream->ngridcells; i++) {
-        for (j = 0; j < stream->nvars; j++) {
-            varid = stream->varid[j];
-            nelem = out_metadata[varid].nelem;
+    n = stream->ngridcells;
+    if (n == 0) {
+        return;
+    }
 
-            // Instantaneous at the beginning of the period
+    // The output values of each grid cell are stored in one block (see
+    // alloc_out_data()), so a value of consecutive grid cells is a constant
+    // stride apart
+    stride = get_out_data_nelem(NULL);
+
+    for (j = 0; j < stream->nvars; j++) {
+        varid = stream->varid[j];
+        for (k = 0; k < out_metadata[varid].nelem; k++) {
+            agg = &(stream->aggdata[(stream->aggoffset[j] + k) * n]);
+            src = &(out_data[0][varid][k]);
+
+            // Instantaneous at the end of the period
             if ((stream->aggtype[j] == AGG_TYPE_END) && (alarm_now)) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] = out_data[i][varid][k];
-                }
+                agg_stream_set(n, stride, src, agg);
             }
-            // Instantaneous at the end of the period
+            // Instantaneous at the beginning of the period
             else if ((stream->aggtype[j] == AGG_TYPE_BEG) &&
                      (alarm->count == 1)) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] = out_data[i][varid][k];
-                }
+                agg_stream_set(n, stride, src, agg);
             }
             // Sum over the period
             else if ((stream->aggtype[j] == AGG_TYPE_SUM) ||
                      (stream->aggtype[j] == AGG_TYPE_AVG)) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] += out_data[i][varid][k];
-                }
+                agg_stream_sum(n, stride, src, agg);
             }
             // Maximum over the period
             else if (stream->aggtype[j] == AGG_TYPE_MAX) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] =
-                        max(stream->aggdata[i][j][k][0], out_data[i][varid][k]);
-                }
+                agg_stream_max(n, stride, src, agg);
             }
             // Minimum over the period
             else if (stream->aggtype[j] == AGG_TYPE_MIN) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] =
-                        min(stream->aggdata[i][j][k][0], out_data[i][varid][k]);
-                }
+                agg_stream_min(n, stride, src, agg);
             }
             // Average over the period if counter is full
             if ((stream->aggtype[j] == AGG_TYPE_AVG) && (alarm_now)) {
-                for (k = 0; k < nelem; k++) {
-                    stream->aggdata[i][j][k][0] /= (double) alarm->count;
-                }
+                agg_stream_div(n, (double) alarm->count, agg);
             }
         }
     }
 }
+
+/******************************************************************************
+ * @brief    Set aggregated values: agg[i] = src[i * stride]
+ *****************************************************************************/
+void
+agg_stream_set(size_t  n,
+               size_t  stride,
+               double *src,
+               double *agg)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        agg[i] = src[i * stride];
+    }
+}
+
+/******************************************************************************
+ * @brief    Accumulate aggregated values: agg[i] += src[i * stride]
+ *****************************************************************************/
+void
+agg_stream_sum(size_t  n,
+               size_t  stride,
+               double *src,
+               double *agg)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        agg[i] += src[i * stride];
+    }
+}
+
+/******************************************************************************
+ * @brief    Running maximum of aggregated values
+ *****************************************************************************/
+void
+agg_stream_max(size_t  n,
+               size_t  stride,
+               double *src,
+               double *agg)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        agg[i] = max(agg[i], src[i * stride]);
+    }
+}
+
+/******************************************************************************
+ * @brief    Running minimum of aggregated values
+ *****************************************************************************/
+void
+agg_stream_min(size_t  n,
+               size_t  stride,
+               double *src,
+               double *agg)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        agg[i] = min(agg[i], src[i * stride]);
+    }
+}
+
+/******************************************************************************
+ * @brief    Turn accumulated values into averages: agg[i] /= count
+ *****************************************************************************/
+void
+agg_stream_div(size_t  n,
+               double  count,
+               double *agg)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        agg[i] /= count;
+    }
+}
@@ -536,6 +536,9 @@ get_parameters(FILE *paramfile)
             else if (strcasecmp("ROOT_BRENT_T", optstr) == 0) {
                 sscanf(cmdstr, "%*s %lf", &param.ROOT_BRENT_T);
             }
+            else if (strcasecmp("ROOT_BRENT_WARM_DT", optstr) == 0) {
+                sscanf(cmdstr, "%*s %lf", &param.ROOT_BRENT_WARM_DT);
+            }
 
             /*************************************
                Get Plugin Parameters
@@ -957,6 +960,9 @@ validate_parameters()
     if (!(param.ROOT_BRENT_T >= 0.)) {
         log_err("ROOT_BRENT_T must be defined on the interval [0, inf)");
     }
+    if (!(param.ROOT_BRENT_WARM_DT >= 0.)) {
+        log_err("ROOT_BRENT_WARM_DT must be defined on the interval [0, inf)");
+    }
 
     // Validate plugin parameters
     plugin_validate_parameters();
@@ -68,6 +68,9 @@ initialize_global()
     global_param.statemonth = 0;
     global_param.stateday = 0;
     global_param.statesec = 0;
+    global_param.snapshot_freq = FREQ_NEVER;
+    global_param.snapshot_n = 1;
+    global_param.snapshot_keep = 1;
     global_param.calendar = CALENDAR_STANDARD;
     global_param.time_units = TIME_UNITS_DAYS;
     global_param.time_origin_num = MISSING;
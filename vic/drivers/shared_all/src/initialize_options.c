@@ -36,6 +36,9 @@ initialize_options()
 {
     extern option_struct options;
 
+    // clear the padding as well, the image driver hashes the raw structure
+    memset(&options, 0, sizeof(options));
+
     /** Initialize model option flags **/
 
     // simulation modes
@@ -47,6 +50,7 @@ initialize_options()
     options.BLOWING_SIMPLE = false;
     options.BLOWING_FETCH = true;
     options.BLOWING_SPATIAL_WIND = true;
+    options.BLOWING_INTEGRATION = BLOWING_ROMBERG;
     options.CARBON = false;
     options.CLOSE_ENERGY = false;
     options.COMPUTE_TREELINE = false;
@@ -58,6 +62,7 @@ initialize_options()
     options.FULL_ENERGY = false;
     options.GRND_FLUX_TYPE = GF_410;
     options.IMPLICIT = true;
+    options.IMPLICIT_JACOBIAN = JACOBIAN_FINITE_DIFF;
     options.LAKES = false;
     options.LAKE_PROFILE = false;
     options.NOFLUX = false;
@@ -87,6 +92,8 @@ initialize_options()
     options.BCO2_SRC = FROM_DEFAULT;
     options.WFC_SRC = FROM_DEFAULT;
     options.ORGANIC_FRACT = false;
+    options.FORCE_READER = FORCE_READ_ROOT;
+    options.FORCE_PREFETCH = 0;
     options.VEGLIB_FCAN = false;
     options.VEGLIB_PHOTO = false;
     options.VEGPARAM_ALB = false;
@@ -98,4 +105,6 @@ initialize_options()
     options.SAVE_STATE = false;
     // output options
     options.Noutstreams = 2;
+    options.OUTPUT_ASYNC = false;
+    options.OUTPUT_ON_DEMAND = false;
 }
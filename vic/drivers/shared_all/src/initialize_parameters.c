@@ -33,6 +33,10 @@ void
 initialize_parameters()
 {
     extern parameters_struct param;
+
+    // clear the padding as well, the image driver hashes the raw structure
+    memset(&param, 0, sizeof(param));
+
     // Initialize temporary parameters
 
     // Lapse Rate
@@ -238,4 +242,5 @@ initialize_parameters()
     param.ROOT_BRENT_MAXITER = 1000;
     param.ROOT_BRENT_TSTEP = 10;
     param.ROOT_BRENT_T = 1.0e-7;
+    param.ROOT_BRENT_WARM_DT = 0.;
 }
@@ -42,10 +42,13 @@ make_energy_bal(size_t nveg)
     temp = calloc(nveg, sizeof(*temp));
     check_alloc_status(temp, "Memory allocation error.");
 
+    // the snow bands of all tiles share one contiguous block
+    temp[0] = calloc(nveg * options.SNOW_BAND, sizeof(*(temp[0])));
+    check_alloc_status(temp[0], "Memory allocation error.");
+
     /** Initialize all records to unfrozen conditions */
     for (i = 0; i < nveg; i++) {
-        temp[i] = calloc(options.SNOW_BAND, sizeof(*(temp[i])));
-        check_alloc_status(temp[i], "Memory allocation error.");
+        temp[i] = temp[0] + i * options.SNOW_BAND;
 
         for (j = 0; j < options.SNOW_BAND; j++) {
             temp[i][j].frozen = false;
@@ -43,9 +43,11 @@ make_snow_data(size_t nveg)
 
     check_alloc_status(temp, "Memory allocation error.");
 
-    for (i = 0; i < nveg; i++) {
-        temp[i] = calloc(options.SNOW_BAND, sizeof(*(temp[i])));
-        check_alloc_status(temp[i], "Memory allocation error.");
+    // the snow bands of all tiles share one contiguous block
+    temp[0] = calloc(nveg * options.SNOW_BAND, sizeof(*(temp[0])));
+    check_alloc_status(temp[0], "Memory allocation error.");
+    for (i = 1; i < nveg; i++) {
+        temp[i] = temp[0] + i * options.SNOW_BAND;
     }
 
     return temp;
@@ -35,34 +35,35 @@ make_veg_var(size_t veg_type_num)
     extern option_struct options;
 
     size_t               i, j;
+    size_t               nitems;
+    double              *canopy;
     veg_var_struct     **temp = NULL;
 
     temp = calloc(veg_type_num, sizeof(*temp));
     check_alloc_status(temp, "Memory allocation error.");
 
+    // the snow bands of all tiles share one contiguous block
+    nitems = veg_type_num * options.SNOW_BAND;
+    temp[0] = calloc(nitems, sizeof(*(temp[0])));
+    check_alloc_status(temp[0], "Memory allocation error.");
+
+    // as do the four canopy layer profiles of each band
+    canopy = NULL;
+    if (options.CARBON) {
+        canopy = calloc(4 * nitems * options.Ncanopy, sizeof(*canopy));
+        check_alloc_status(canopy, "Memory allocation error.");
+    }
+
     for (i = 0; i < veg_type_num; i++) {
-        temp[i] = calloc(options.SNOW_BAND, sizeof(*(temp[i])));
-        check_alloc_status(temp[i], "Memory allocation error.");
+        temp[i] = temp[0] + i * options.SNOW_BAND;
 
         if (options.CARBON) {
             for (j = 0; j < options.SNOW_BAND; j++) {
-                temp[i][j].NscaleFactor = calloc(options.Ncanopy,
-                                                 sizeof(*(temp[i][j].
-                                                          NscaleFactor)));
-                check_alloc_status(temp[i][j].NscaleFactor,
-                                   "Memory allocation error.");
-                temp[i][j].aPARLayer = calloc(options.Ncanopy,
-                                              sizeof(*(temp[i][j].aPARLayer)));
-                check_alloc_status(temp[i][j].aPARLayer,
-                                   "Memory allocation error.");
-                temp[i][j].CiLayer = calloc(options.Ncanopy,
-                                            sizeof(*(temp[i][j].CiLayer)));
-                check_alloc_status(temp[i][j].CiLayer,
-                                   "Memory allocation error.");
-                temp[i][j].rsLayer = calloc(options.Ncanopy,
-                                            sizeof(*(temp[i][j].rsLayer)));
-                check_alloc_status(temp[i][j].rsLayer,
-                                   "Memory allocation error.");
+                temp[i][j].NscaleFactor = canopy;
+                temp[i][j].aPARLayer = canopy + options.Ncanopy;
+                temp[i][j].CiLayer = canopy + 2 * options.Ncanopy;
+                temp[i][j].rsLayer = canopy + 3 * options.Ncanopy;
+                canopy += 4 * options.Ncanopy;
             }
         }
     }
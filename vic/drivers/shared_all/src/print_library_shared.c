@@ -282,6 +282,9 @@ print_global_param(global_param_struct *gp)
     fprintf(LOG_DEST, "\tstatemonth          : %hu\n", gp->statemonth);
     fprintf(LOG_DEST, "\tstateyear           : %hu\n", gp->stateyear);
     fprintf(LOG_DEST, "\tstatesec            : %u\n", gp->statesec);
+    fprintf(LOG_DEST, "\tsnapshot_freq       : %hu\n", gp->snapshot_freq);
+    fprintf(LOG_DEST, "\tsnapshot_n          : %d\n", gp->snapshot_n);
+    fprintf(LOG_DEST, "\tsnapshot_keep       : %zu\n", gp->snapshot_keep);
 }
 
 /******************************************************************************
@@ -448,6 +451,8 @@ print_option(option_struct *option)
             option->BLOWING_FETCH ? "true" : "false");
     fprintf(LOG_DEST, "\tBLOWING_SPATIAL_WIND : %s\n",
             option->BLOWING_SPATIAL_WIND ? "true" : "false");
+    fprintf(LOG_DEST, "\tBLOWING_INTEGRATION  : %d\n",
+            option->BLOWING_INTEGRATION);
     fprintf(LOG_DEST, "\tCARBON               : %s\n",
             option->CARBON ? "true" : "false");
     fprintf(LOG_DEST, "\tCLOSE_ENERGY         : %s\n",
@@ -469,6 +474,8 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "\tGRND_FLUX_TYPE       : %d\n", option->GRND_FLUX_TYPE);
     fprintf(LOG_DEST, "\tIMPLICIT             : %s\n",
             option->IMPLICIT ? "true" : "false");
+    fprintf(LOG_DEST, "\tIMPLICIT_JACOBIAN    : %d\n",
+            option->IMPLICIT_JACOBIAN);
     fprintf(LOG_DEST, "\tJULY_TAVG_SUPPLIED   : %s\n",
             option->JULY_TAVG_SUPPLIED ? "true" : "false");
     fprintf(LOG_DEST, "\tLAKES                : %s\n",
@@ -519,12 +526,19 @@ print_option(option_struct *option)
             option->LAKE_PROFILE ? "true" : "false");
     fprintf(LOG_DEST, "\tORGANIC_FRACT        : %s\n",
             option->ORGANIC_FRACT ? "true" : "false");
+    fprintf(LOG_DEST, "\tFORCE_READER         : %d\n", option->FORCE_READER);
+    fprintf(LOG_DEST, "\tFORCE_PREFETCH       : %zu\n",
+            option->FORCE_PREFETCH);
     fprintf(LOG_DEST, "\tSTATE_FORMAT         : %d\n", option->STATE_FORMAT);
     fprintf(LOG_DEST, "\tINIT_STATE           : %s\n",
             option->INIT_STATE ? "true" : "false");
     fprintf(LOG_DEST, "\tSAVE_STATE           : %s\n",
             option->SAVE_STATE ? "true" : "false");
     fprintf(LOG_DEST, "\tNoutstreams          : %zu\n", option->Noutstreams);
+    fprintf(LOG_DEST, "\tOUTPUT_ASYNC         : %s\n",
+            option->OUTPUT_ASYNC ? "true" : "false");
+    fprintf(LOG_DEST, "\tOUTPUT_ON_DEMAND     : %s\n",
+            option->OUTPUT_ON_DEMAND ? "true" : "false");
 }
 
 /******************************************************************************
@@ -581,8 +595,8 @@ print_stream(stream_struct   *stream,
                 stream->type[i], stream->mult[i], stream->format[i],
                 stream->aggtype[i]);
     }
-    fprintf(LOG_DEST, "\taggdata shape: (%zu, %zu, nelem, 1)\n",
-            stream->ngridcells, stream->nvars);
+    fprintf(LOG_DEST, "\taggdata shape: (%zu, %zu)\n",
+            stream->nvalues, stream->ngridcells);
 
     fprintf(LOG_DEST, "\n");
 }
@@ -815,6 +829,8 @@ print_parameters(parameters_struct *param)
     fprintf(LOG_DEST, "\tROOT_BRENT_MAXITER: %d\n", param->ROOT_BRENT_MAXITER);
     fprintf(LOG_DEST, "\tROOT_BRENT_TSTEP: %.4f\n", param->ROOT_BRENT_TSTEP);
     fprintf(LOG_DEST, "\tROOT_BRENT_T: %.4f\n", param->ROOT_BRENT_T);
+    fprintf(LOG_DEST, "\tROOT_BRENT_WARM_DT: %.4f\n",
+            param->ROOT_BRENT_WARM_DT);
     fprintf(LOG_DEST, "\tFROZEN_MAXITER: %d\n", param->FROZEN_MAXITER);
 }
 
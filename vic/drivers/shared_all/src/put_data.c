@@ -45,6 +45,7 @@ put_data(all_vars_struct   *all_vars,
     extern global_param_struct global_param;
     extern option_struct       options;
     extern parameters_struct   param;
+    extern bool                out_requested[];
 
     size_t                     veg;
     size_t                     index;
@@ -67,7 +68,8 @@ put_data(all_vars_struct   *all_vars,
     double                     inflow;
     double                     outflow;
     double                     storage;
-    double                    *TreeAdjustFactor;
+    double                     Cv_tree;
+    double                     Cv_tree_first;
     double                     ThisAreaFract;
     double                     ThisTreeAdjust;
     size_t                     i;
@@ -92,34 +94,30 @@ put_data(all_vars_struct   *all_vars,
     frost_slope = soil_con->frost_slope;
     dt_sec = global_param.dt;
 
-    // Compute treeline adjustment factors
-    TreeAdjustFactor = calloc(options.SNOW_BAND, sizeof(*TreeAdjustFactor));
-    check_alloc_status(TreeAdjustFactor, "Memory allocation error.");
+    // Compute the overstory fractions for the treeline adjustment factors;
+    // the lake tile only counts in the first band
+    Cv_tree = 0;
+    Cv_tree_first = 0;
+    for (veg = 0; veg < veg_con[0].vegetat_type_num; veg++) {
+        if (veg_lib[veg_con[veg].veg_class].overstory) {
+            if (options.LAKES && veg_con[veg].LAKE) {
+                // Fraction of tile that is flooded
+                Clake = lake_var.sarea / lake_con->basin[0];
+                Cv_tree_first += veg_con[veg].Cv * (1 - Clake);
+            }
+            else {
+                Cv_tree += veg_con[veg].Cv;
+                Cv_tree_first += veg_con[veg].Cv;
+            }
+        }
+    }
     for (band = 0; band < options.SNOW_BAND; band++) {
         if (AboveTreeLine[band]) {
-            Cv = 0;
-            for (veg = 0; veg < veg_con[0].vegetat_type_num; veg++) {
-                if (veg_lib[veg_con[veg].veg_class].overstory) {
-                    if (options.LAKES && veg_con[veg].LAKE) {
-                        if (band == 0) {
-                            // Fraction of tile that is flooded
-                            Clake = lake_var.sarea / lake_con->basin[0];
-                            Cv += veg_con[veg].Cv * (1 - Clake);
-                        }
-                    }
-                    else {
-                        Cv += veg_con[veg].Cv;
-                    }
-                }
+            ThisTreeAdjust = 1. / (1. - (band == 0 ? Cv_tree_first : Cv_tree));
+            if (ThisTreeAdjust != 1) {
+                log_warn("Tree adjust factor for band %zu is equal to %f.",
+                         band, ThisTreeAdjust);
             }
-            TreeAdjustFactor[band] = 1. / (1. - Cv);
-        }
-        else {
-            TreeAdjustFactor[band] = 1.;
-        }
-        if (TreeAdjustFactor[band] != 1) {
-            log_warn("Tree adjust factor for band %zu is equal to %f.",
-                     band, TreeAdjustFactor[band]);
         }
     }
 
@@ -195,7 +193,11 @@ put_data(all_vars_struct   *all_vars,
             *********************************/
             for (band = 0; band < Nbands; band++) {
                 ThisAreaFract = AreaFract[band];
-                ThisTreeAdjust = TreeAdjustFactor[band];
+                ThisTreeAdjust = 1.;
+                if (AboveTreeLine[band]) {
+                    ThisTreeAdjust =
+                        1. / (1. - (band == 0 ? Cv_tree_first : Cv_tree));
+                }
                 if (IsWet) {
                     ThisAreaFract = 1;
                     ThisTreeAdjust = 1;
@@ -457,26 +459,34 @@ put_data(all_vars_struct   *all_vars,
     }
 
     // Radiative temperature
-    out_data[OUT_RAD_TEMP][0] = pow(out_data[OUT_RAD_TEMP][0], 0.25);
+    if (out_requested[OUT_RAD_TEMP]) {
+        out_data[OUT_RAD_TEMP][0] = pow(out_data[OUT_RAD_TEMP][0], 0.25);
+    }
 
     // Aerodynamic conductance and resistance
-    if (out_data[OUT_AERO_COND1][0] > DBL_EPSILON) {
-        out_data[OUT_AERO_RESIST1][0] = 1 / out_data[OUT_AERO_COND1][0];
-    }
-    else {
-        out_data[OUT_AERO_RESIST1][0] = param.HUGE_RESIST;
-    }
-    if (out_data[OUT_AERO_COND2][0] > DBL_EPSILON) {
-        out_data[OUT_AERO_RESIST2][0] = 1 / out_data[OUT_AERO_COND2][0];
-    }
-    else {
-        out_data[OUT_AERO_RESIST2][0] = param.HUGE_RESIST;
+    if (out_requested[OUT_AERO_RESIST1]) {
+        if (out_data[OUT_AERO_COND1][0] > DBL_EPSILON) {
+            out_data[OUT_AERO_RESIST1][0] = 1 / out_data[OUT_AERO_COND1][0];
+        }
+        else {
+            out_data[OUT_AERO_RESIST1][0] = param.HUGE_RESIST;
+        }
     }
-    if (out_data[OUT_AERO_COND][0] > DBL_EPSILON) {
-        out_data[OUT_AERO_RESIST][0] = 1 / out_data[OUT_AERO_COND][0];
+    if (out_requested[OUT_AERO_RESIST2]) {
+        if (out_data[OUT_AERO_COND2][0] > DBL_EPSILON) {
+            out_data[OUT_AERO_RESIST2][0] = 1 / out_data[OUT_AERO_COND2][0];
+        }
+        else {
+            out_data[OUT_AERO_RESIST2][0] = param.HUGE_RESIST;
+        }
     }
-    else {
-        out_data[OUT_AERO_RESIST][0] = param.HUGE_RESIST;
+    if (out_requested[OUT_AERO_RESIST]) {
+        if (out_data[OUT_AERO_COND][0] > DBL_EPSILON) {
+            out_data[OUT_AERO_RESIST][0] = 1 / out_data[OUT_AERO_COND][0];
+        }
+        else {
+            out_data[OUT_AERO_RESIST][0] = param.HUGE_RESIST;
+        }
     }
 
     /*****************************************
@@ -491,15 +501,20 @@ put_data(all_vars_struct   *all_vars,
         out_data[OUT_DELSOILMOIST][0] +=
             out_data[OUT_SOIL_MOIST][index];
 
-        out_data[OUT_SMLIQFRAC][index] = out_data[OUT_SOIL_LIQ][index] /
-                                         out_data[OUT_SOIL_MOIST][index];
-        out_data[OUT_SMFROZFRAC][index] = 1 - out_data[OUT_SMLIQFRAC][index];
-        out_data[OUT_SOIL_LIQ_FRAC][index] = out_data[OUT_SOIL_LIQ][index] /
-                                             (depth[index] *
-                                              MM_PER_M);
-        out_data[OUT_SOIL_ICE_FRAC][index] = out_data[OUT_SOIL_ICE][index] /
-                                             (depth[index] *
-                                              MM_PER_M);
+        if (out_requested[OUT_SMLIQFRAC]) {
+            out_data[OUT_SMLIQFRAC][index] = out_data[OUT_SOIL_LIQ][index] /
+                                             out_data[OUT_SOIL_MOIST][index];
+            out_data[OUT_SMFROZFRAC][index] = 1 -
+                                              out_data[OUT_SMLIQFRAC][index];
+        }
+        if (out_requested[OUT_SOIL_LIQ_FRAC]) {
+            out_data[OUT_SOIL_LIQ_FRAC][index] =
+                out_data[OUT_SOIL_LIQ][index] / (depth[index] * MM_PER_M);
+        }
+        if (out_requested[OUT_SOIL_ICE_FRAC]) {
+            out_data[OUT_SOIL_ICE_FRAC][index] =
+                out_data[OUT_SOIL_ICE][index] / (depth[index] * MM_PER_M);
+        }
     }
     out_data[OUT_DELSOILMOIST][0] -= save_data->total_soil_moist;
     out_data[OUT_DELSWE][0] = out_data[OUT_SWE][0] +
@@ -556,27 +571,27 @@ put_data(all_vars_struct   *all_vars,
        Check Energy Balance
     ********************/
     if (options.FULL_ENERGY) {
-        out_data[OUT_ENERGY_ERROR][0] = \
-            calc_energy_balance_error(out_data[OUT_SWNET][0] +
-                                      out_data[OUT_LWNET][0],
-                                      out_data[OUT_LATENT][0] +
-                                      out_data[OUT_LATENT_SUB][0],
-                                      out_data[OUT_SENSIBLE][0] +
-                                      out_data[OUT_ADV_SENS][0],
-                                      out_data[OUT_GRND_FLUX][0] +
-                                      out_data[OUT_DELTAH][0] +
-                                      out_data[OUT_FUSION][0],
-                                      out_data[OUT_ADVECTION][0] -
-                                      out_data[OUT_DELTACC][0] +
-                                      out_data[OUT_SNOW_FLUX][0] +
-                                      out_data[OUT_RFRZ_ENERGY][0]);
+        if (out_requested[OUT_ENERGY_ERROR]) {
+            out_data[OUT_ENERGY_ERROR][0] = \
+                calc_energy_balance_error(out_data[OUT_SWNET][0] +
+                                          out_data[OUT_LWNET][0],
+                                          out_data[OUT_LATENT][0] +
+                                          out_data[OUT_LATENT_SUB][0],
+                                          out_data[OUT_SENSIBLE][0] +
+                                          out_data[OUT_ADV_SENS][0],
+                                          out_data[OUT_GRND_FLUX][0] +
+                                          out_data[OUT_DELTAH][0] +
+                                          out_data[OUT_FUSION][0],
+                                          out_data[OUT_ADVECTION][0] -
+                                          out_data[OUT_DELTACC][0] +
+                                          out_data[OUT_SNOW_FLUX][0] +
+                                          out_data[OUT_RFRZ_ENERGY][0]);
+        }
     }
     else {
         out_data[OUT_ENERGY_ERROR][0] = MISSING;
     }
 
-    free((char *) (TreeAdjustFactor));
-
     // vic_run run time
     out_data[OUT_TIME_VICRUN_WALL][0] = timer->delta_wall;
     out_data[OUT_TIME_VICRUN_CPU][0] = timer->delta_cpu;
@@ -600,6 +615,7 @@ collect_wb_terms(cell_data_struct cell,
 {
     extern option_struct     options;
     extern parameters_struct param;
+    extern bool              out_requested[];
 
     double                   AreaFactor;
     double                   tmp_evap;
@@ -715,8 +731,11 @@ collect_wb_terms(cell_data_struct cell,
     out_data[OUT_ZWT_LUMPED][0] += cell.zwt_lumped * AreaFactor;
 
     /** record layer temperatures **/
-    for (index = 0; index < options.Nlayer; index++) {
-        out_data[OUT_SOIL_TEMP][index] += cell.layer[index].T * AreaFactor;
+    if (out_requested[OUT_SOIL_TEMP]) {
+        for (index = 0; index < options.Nlayer; index++) {
+            out_data[OUT_SOIL_TEMP][index] += cell.layer[index].T *
+                                              AreaFactor;
+        }
     }
 
     /*****************************
@@ -790,6 +809,8 @@ collect_eb_terms(energy_bal_struct energy,
                  double          **out_data)
 {
     extern option_struct options;
+    extern bool          out_requested[];
+
     double               AreaFactor;
     double               tmp_fract;
     double               rad_temp;
@@ -804,7 +825,8 @@ collect_eb_terms(energy_bal_struct energy,
     **********************************/
 
     /** record freezing and thawing front depths **/
-    if (options.FROZEN_SOIL) {
+    if (options.FROZEN_SOIL &&
+        (out_requested[OUT_FDEPTH] || out_requested[OUT_TDEPTH])) {
         for (index = 0; index < MAX_FRONTS; index++) {
             if (energy.fdepth[index] != MISSING) {
                 out_data[OUT_FDEPTH][index] += energy.fdepth[index] *
@@ -817,13 +839,15 @@ collect_eb_terms(energy_bal_struct energy,
         }
     }
 
-    tmp_fract = 0;
-    for (frost_area = 0; frost_area < options.Nfrost; frost_area++) {
-        if (cell_wet.layer[0].ice[frost_area]) {
-            tmp_fract += frost_fract[frost_area];
+    if (out_requested[OUT_SURF_FROST_FRAC]) {
+        tmp_fract = 0;
+        for (frost_area = 0; frost_area < options.Nfrost; frost_area++) {
+            if (cell_wet.layer[0].ice[frost_area]) {
+                tmp_fract += frost_fract[frost_area];
+            }
         }
+        out_data[OUT_SURF_FROST_FRAC][0] += tmp_fract * AreaFactor;
     }
-    out_data[OUT_SURF_FROST_FRAC][0] += tmp_fract * AreaFactor;
 
     tmp_fract = 0;
     if ((energy.T[0] + frost_slope / 2.) > 0) {
@@ -874,10 +898,12 @@ collect_eb_terms(energy_bal_struct energy,
     out_data[OUT_SURF_TEMP][0] += surf_temp * AreaFactor;
 
     /** record thermal node temperatures **/
-    for (index = 0; index < options.Nnode; index++) {
-        out_data[OUT_SOIL_TNODE][index] += energy.T[index] * AreaFactor;
+    if (out_requested[OUT_SOIL_TNODE]) {
+        for (index = 0; index < options.Nnode; index++) {
+            out_data[OUT_SOIL_TNODE][index] += energy.T[index] * AreaFactor;
+        }
     }
-    if (IsWet) {
+    if (IsWet && out_requested[OUT_SOIL_TNODE_WL]) {
         for (index = 0; index < options.Nnode; index++) {
             out_data[OUT_SOIL_TNODE_WL][index] = energy.T[index];
         }
@@ -885,9 +911,11 @@ collect_eb_terms(energy_bal_struct energy,
 
     /** record temperature flags  **/
     out_data[OUT_SURFT_FBFLAG][0] += energy.Tsurf_fbflag * AreaFactor;
-    for (index = 0; index < options.Nnode; index++) {
-        out_data[OUT_SOILT_FBFLAG][index] += energy.T_fbflag[index] *
-                                             AreaFactor;
+    if (out_requested[OUT_SOILT_FBFLAG]) {
+        for (index = 0; index < options.Nnode; index++) {
+            out_data[OUT_SOILT_FBFLAG][index] += energy.T_fbflag[index] *
+                                                 AreaFactor;
+        }
     }
     out_data[OUT_SNOWT_FBFLAG][0] += snow.surf_temp_fbflag * AreaFactor;
     out_data[OUT_TFOL_FBFLAG][0] += energy.Tfoliage_fbflag * AreaFactor;
@@ -935,8 +963,10 @@ collect_eb_terms(energy_bal_struct energy,
 
     /** record radiative effective temperature [K],
         emissivities set = 1.0  **/
-    out_data[OUT_RAD_TEMP][0] +=
-        ((rad_temp) * (rad_temp) * (rad_temp) * (rad_temp)) * AreaFactor;
+    if (out_requested[OUT_RAD_TEMP]) {
+        out_data[OUT_RAD_TEMP][0] +=
+            ((rad_temp) * (rad_temp) * (rad_temp) * (rad_temp)) * AreaFactor;
+    }
 
     /** record snowpack cold content **/
     out_data[OUT_DELTACC][0] += energy.deltaCC * AreaFactor;
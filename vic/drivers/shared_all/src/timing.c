@@ -28,19 +28,22 @@
 
 /******************************************************************************
  * @brief    Get wall time
+ * @details  From the monotonic clock, which is not affected by changes of the
+ *           system time. Only differences of wall times are meaningful.
  *****************************************************************************/
 double
 get_wall_time()
 {
-    struct timeval time;
-    if (gettimeofday(&time, NULL)) {
-        log_err("Unable to get time of day")
+    struct timespec time;
+    if (clock_gettime(CLOCK_MONOTONIC, &time)) {
+        log_err("Unable to get monotonic time")
     }
-    return (double) time.tv_sec + (double) time.tv_usec * 0.000001;
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
 }
 
 /******************************************************************************
  * @brief    Get CPU time
+ * @details  CPU time of the whole process, i.e. summed over all threads
  *****************************************************************************/
 double
 get_cpu_time()
@@ -48,6 +51,19 @@ get_cpu_time()
     return (double) clock() / CLOCKS_PER_SEC;
 }
 
+/******************************************************************************
+ * @brief    Get CPU time of the calling thread
+ *****************************************************************************/
+double
+get_thread_cpu_time()
+{
+    struct timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time)) {
+        log_err("Unable to get thread CPU time")
+    }
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
 /******************************************************************************
  * @brief    Initialize timer values
  *****************************************************************************/
@@ -95,3 +111,31 @@ timer_continue(timer_struct *t)
     t->start_wall = get_wall_time();
     t->start_cpu = get_cpu_time();
 }
+
+/******************************************************************************
+ * @brief    Start timer for the calling thread
+ * @details  Same as timer_start, but the CPU time is that of the calling
+ *           thread. To be used inside parallel regions, where the process CPU
+ *           time includes the other threads.
+ *****************************************************************************/
+void
+timer_start_thread(timer_struct *t)
+{
+    timer_init(t);
+
+    t->start_wall = get_wall_time();
+    t->start_cpu = get_thread_cpu_time();
+}
+
+/******************************************************************************
+ * @brief    Stop timer started with timer_start_thread
+ *****************************************************************************/
+void
+timer_stop_thread(timer_struct *t)
+{
+    t->stop_wall = get_wall_time();
+    t->stop_cpu = get_thread_cpu_time();
+
+    t->delta_wall += t->stop_wall - t->start_wall;
+    t->delta_cpu += t->stop_cpu - t->start_cpu;
+}
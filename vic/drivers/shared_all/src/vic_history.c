@@ -35,22 +35,171 @@ alloc_out_data(size_t    ngridcells,
                double ***out_data)
 {
     extern metadata_struct out_metadata[];
+    extern bool            out_requested[];
 
     size_t                 i;
     size_t                 j;
+    size_t                 nvars;
+    size_t                 nelem;
+    size_t                 nscratch;
+    double               **vars;
+    double                *data;
+    double                *scratch;
+
+    if (ngridcells == 0) {
+        return;
+    }
+
+    nvars = N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES;
+    nelem = get_out_data_nelem(&nscratch);
+
+    // The variable lists and the data of all grid cells are each a single
+    // block, with the variables of a cell stored next to each other;
+    // agg_stream_data() relies on this layout. Variables that are not
+    // requested all point to one scratch block of the cell, which is placed
+    // where the first of them would be, so out_data[i][0] is always the start
+    // of the block of cell i (see zero_output_list()).
+    vars = calloc(ngridcells * nvars, sizeof(*vars));
+    check_alloc_status(vars, "Memory allocation error.");
+    data = calloc(ngridcells * nelem, sizeof(*data));
+    check_alloc_status(data, "Memory allocation error.");
 
     for (i = 0; i < ngridcells; i++) {
-        out_data[i] =
-            calloc(N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES,
-                   sizeof(*(out_data[i])));
-        check_alloc_status(out_data[i], "Memory allocation error.");
-        // Allocate space for data
-        for (j = 0; j < N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES; j++) {
-            out_data[i][j] =
-                calloc(out_metadata[j].nelem, sizeof(*(out_data[i][j])));
-            check_alloc_status(out_data[i][j], "Memory allocation error.");
+        out_data[i] = &(vars[i * nvars]);
+        scratch = NULL;
+        for (j = 0; j < nvars; j++) {
+            if (out_requested[j]) {
+                out_data[i][j] = data;
+                data += out_metadata[j].nelem;
+            }
+            else {
+                if (scratch == NULL) {
+                    scratch = data;
+                    data += nscratch;
+                }
+                out_data[i][j] = scratch;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    This routine returns the number of values of a grid cell in
+ *           out_data, and the size of the scratch block shared by the
+ *           variables that are not requested.
+ *****************************************************************************/
+size_t
+get_out_data_nelem(size_t *nscratch)
+{
+    extern metadata_struct out_metadata[];
+    extern bool            out_requested[];
+
+    size_t                 varid;
+    size_t                 nelem;
+    size_t                 nmax;
+
+    nelem = 0;
+    nmax = 0;
+    for (varid = 0; varid < N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES; varid++) {
+        if (out_requested[varid]) {
+            nelem += out_metadata[varid].nelem;
+        }
+        else if (out_metadata[varid].nelem > nmax) {
+            nmax = out_metadata[varid].nelem;
+        }
+    }
+
+    if (nscratch != NULL) {
+        *nscratch = nmax;
+    }
+
+    return nelem + nmax;
+}
+
+/******************************************************************************
+ * @brief    This routine sets the output variables that put_data() computes.
+ * @details  Without OUTPUT_ON_DEMAND all variables are computed. Otherwise
+ *           only the variables of the output streams, the variables they are
+ *           derived from and the terms of the water balance are computed.
+ *****************************************************************************/
+void
+set_output_requested(stream_struct *streams,
+                     size_t         nstreams)
+{
+    extern option_struct options;
+    extern bool          out_requested[];
+
+    size_t               i;
+    size_t               j;
+
+    for (i = 0; i < N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES; i++) {
+        out_requested[i] = !options.OUTPUT_ON_DEMAND;
+    }
+    if (!options.OUTPUT_ON_DEMAND) {
+        return;
+    }
+
+    for (i = 0; i < nstreams; i++) {
+        for (j = 0; j < streams[i].nvars; j++) {
+            out_requested[streams[i].varid[j]] = true;
         }
     }
+
+    // The water balance and the save data need these in every time step
+    out_requested[OUT_PREC] = true;
+    out_requested[OUT_LAKE_CHAN_IN] = true;
+    out_requested[OUT_EVAP] = true;
+    out_requested[OUT_RUNOFF] = true;
+    out_requested[OUT_BASEFLOW] = true;
+    out_requested[OUT_SOIL_LIQ] = true;
+    out_requested[OUT_SOIL_ICE] = true;
+    out_requested[OUT_SOIL_MOIST] = true;
+    out_requested[OUT_SWE] = true;
+    out_requested[OUT_SNOW_CANOPY] = true;
+    out_requested[OUT_WDEW] = true;
+    out_requested[OUT_SURFSTOR] = true;
+    out_requested[OUT_LAKE_SURF_AREA] = true;
+    out_requested[OUT_WATER_ERROR] = true;
+
+    // Variables derived from other output variables in put_data()
+    if (out_requested[OUT_SMFROZFRAC]) {
+        out_requested[OUT_SMLIQFRAC] = true;
+    }
+    if (out_requested[OUT_REFREEZE]) {
+        out_requested[OUT_RFRZ_ENERGY] = true;
+    }
+    if (out_requested[OUT_R_NET]) {
+        out_requested[OUT_SWNET] = true;
+        out_requested[OUT_LWNET] = true;
+    }
+    if (out_requested[OUT_NEE]) {
+        out_requested[OUT_NPP] = true;
+        out_requested[OUT_RHET] = true;
+    }
+    if (out_requested[OUT_AERO_RESIST]) {
+        out_requested[OUT_AERO_COND] = true;
+    }
+    if (out_requested[OUT_AERO_RESIST1]) {
+        out_requested[OUT_AERO_COND1] = true;
+    }
+    if (out_requested[OUT_AERO_RESIST2]) {
+        out_requested[OUT_AERO_COND2] = true;
+    }
+    if (out_requested[OUT_ENERGY_ERROR]) {
+        out_requested[OUT_SWNET] = true;
+        out_requested[OUT_LWNET] = true;
+        out_requested[OUT_LATENT] = true;
+        out_requested[OUT_LATENT_SUB] = true;
+        out_requested[OUT_SENSIBLE] = true;
+        out_requested[OUT_ADV_SENS] = true;
+        out_requested[OUT_GRND_FLUX] = true;
+        out_requested[OUT_DELTAH] = true;
+        out_requested[OUT_FUSION] = true;
+        out_requested[OUT_ADVECTION] = true;
+        out_requested[OUT_DELTACC] = true;
+        out_requested[OUT_SNOW_FLUX] = true;
+        out_requested[OUT_RFRZ_ENERGY] = true;
+    }
 }
 
 /******************************************************************************
@@ -152,6 +301,9 @@ validate_streams(stream_struct **streams)
         if ((*streams)[streamnum].aggtype == NULL) {
             log_err("Stream aggtype array not allocated");
         }
+        if ((*streams)[streamnum].aggoffset == NULL) {
+            log_err("Stream aggoffset array not allocated");
+        }
         if ((*streams)[streamnum].aggdata == NULL) {
             log_err("Stream agg_data array not allocated");
         }
@@ -160,41 +312,30 @@ validate_streams(stream_struct **streams)
 
 /******************************************************************************
  * @brief   This routine allocates memory for the stream aggdata array.  The
-            shape of this array is [ngridcells, nvars, nelems, nbins].
+            array is variable-major with shape [nvalues, ngridcells], where
+            the nelem values of variable j start at aggoffset[j], so that each
+            value is a contiguous slice over the grid cells.
  *****************************************************************************/
 void
 alloc_aggdata(stream_struct *stream)
 {
     extern metadata_struct out_metadata[];
 
-    size_t                 i;
     size_t                 j;
-    size_t                 k;
-    size_t                 nelem;
 
-    stream->aggdata = calloc(stream->ngridcells, sizeof(*(stream->aggdata)));
-    check_alloc_status(stream->aggdata, "Memory allocation error.");
+    stream->aggoffset = calloc(stream->nvars, sizeof(*(stream->aggoffset)));
+    check_alloc_status(stream->aggoffset, "Memory allocation error.");
 
-    for (i = 0; i < stream->ngridcells; i++) {
-        stream->aggdata[i] =
-            calloc(stream->nvars, sizeof(*(stream->aggdata[i])));
-        check_alloc_status(stream->aggdata[i], "Memory allocation error.");
-        for (j = 0; j < stream->nvars; j++) {
-            nelem = out_metadata[stream->varid[j]].nelem;
-            stream->aggdata[i][j] =
-                calloc(nelem, sizeof(*(stream->aggdata[i][j])));
-            check_alloc_status(stream->aggdata[i][j],
-                               "Memory allocation error.");
-
-            for (k = 0; k < nelem; k++) {
-                // TODO: Also allocate for nbins, for now just setting to size 1
-                stream->aggdata[i][j][k] =
-                    calloc(1, sizeof(*(stream->aggdata[i][j][k])));
-                check_alloc_status(stream->aggdata[i][j][k],
-                                   "Memory allocation error.");
-            }
-        }
+    stream->nvalues = 0;
+    for (j = 0; j < stream->nvars; j++) {
+        stream->aggoffset[j] = stream->nvalues;
+        // TODO: Also allocate for nbins, for now just setting to size 1
+        stream->nvalues += out_metadata[stream->varid[j]].nelem;
     }
+
+    stream->aggdata = calloc(stream->nvalues * stream->ngridcells,
+                             sizeof(*(stream->aggdata)));
+    check_alloc_status(stream->aggdata, "Memory allocation error.");
 }
 
 /******************************************************************************
@@ -204,24 +345,14 @@ void
 reset_stream(stream_struct *stream,
              dmy_struct    *dmy_current)
 {
-    extern metadata_struct out_metadata[];
-
-    size_t                 i;
-    size_t                 j;
-    size_t                 k;
-    size_t                 varid;
+    size_t i;
 
     // Reset alarm to next agg period
     reset_alarm(&(stream->agg_alarm), dmy_current);
 
     // Set aggdata to zero
-    for (i = 0; i < stream->ngridcells; i++) {
-        for (j = 0; j < stream->nvars; j++) {
-            varid = stream->varid[j];
-            for (k = 0; k < out_metadata[varid].nelem; k++) {
-                stream->aggdata[i][j][k][0] = 0.;
-            }
-        }
+    for (i = 0; i < stream->nvalues * stream->ngridcells; i++) {
+        stream->aggdata[i] = 0.;
     }
 }
 
@@ -407,32 +538,19 @@ set_output_var(stream_struct     *stream,
 void
 free_streams(stream_struct **streams)
 {
-    extern option_struct   options;
-    extern metadata_struct out_metadata[];
+    extern option_struct options;
 
-    size_t                 streamnum;
-    size_t                 i;
-    size_t                 j;
-    size_t                 k;
-    size_t                 varid;
+    size_t               streamnum;
+    size_t               j;
 
     // free output streams
     for (streamnum = 0; streamnum < options.Noutstreams; streamnum++) {
         // Free aggdata first
-        for (i = 0; i < (*streams)[streamnum].ngridcells; i++) {
-            for (j = 0; j < (*streams)[streamnum].nvars; j++) {
-                varid = (*streams)[streamnum].varid[j];
-                for (k = 0; k < out_metadata[varid].nelem; k++) {
-                    free((*streams)[streamnum].aggdata[i][j][k]);
-                }
-                free((*streams)[streamnum].aggdata[i][j]);
-            }
-            free((*streams)[streamnum].aggdata[i]);
-        }
+        free((*streams)[streamnum].aggdata);
+        free((*streams)[streamnum].aggoffset);
         for (j = 0; j < (*streams)[streamnum].nvars; j++) {
             free((*streams)[streamnum].format[j]);
         }
-        free((*streams)[streamnum].aggdata);
         // free remaining arrays
         free((*streams)[streamnum].type);
         free((*streams)[streamnum].mult);
@@ -450,19 +568,14 @@ void
 free_out_data(size_t    ngridcells,
               double ***out_data)
 {
-    size_t i;
-    size_t j;
-
-
     if (out_data == NULL) {
         return;
     }
 
-    for (i = 0; i < ngridcells; i++) {
-        for (j = 0; j < N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES; j++) {
-            free(out_data[i][j]);
-        }
-        free(out_data[i]);
+    // see alloc_out_data()
+    if (ngridcells > 0) {
+        free(out_data[0][0]);
+        free(out_data[0]);
     }
 
     free(out_data);
@@ -29,17 +29,12 @@
 
 /******************************************************************************
  * @brief    This routine resets the values of all output variables to 0.
+ * @note     The variables of a grid cell are one block that starts at
+ *           out_data[0] (see alloc_out_data()), including the scratch block
+ *           of the variables that are not requested.
  *****************************************************************************/
 void
 zero_output_list(double **out_data)
 {
-    extern metadata_struct out_metadata[];
-
-    size_t                 varid, i;
-
-    for (varid = 0; varid < N_OUTVAR_TYPES + PLUGIN_N_OUTVAR_TYPES; varid++) {
-        for (i = 0; i < out_metadata[varid].nelem; i++) {
-            out_data[varid][i] = 0.;
-        }
-    }
+    memset(out_data[0], 0, get_out_data_nelem(NULL) * sizeof(*out_data[0]));
 }
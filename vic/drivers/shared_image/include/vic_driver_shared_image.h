@@ -32,9 +32,27 @@
 #include <vic_mpi.h>
 
 #include <netcdf.h>
+#include <netcdf_meta.h>
+#if NC_HAS_PARALLEL
+    #include <netcdf_par.h>
+#endif
+#include <pthread.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define MAXDIMS 10
+#define HIST_WRITE_NBUF 2
 #define AREA_SUM_ERROR_THRESH 1e-5
+#define CHECKPOINT_MAGIC "VICCKPT"
+#define CHECKPOINT_MAGIC_LEN 8
+#define CHECKPOINT_VERSION 1
+#define PARAM_CACHE_MAGIC "VICPRMC"
+#define PARAM_CACHE_MAGIC_LEN 8
+#define PARAM_CACHE_VERSION 2
+#define PARAM_CACHE_FNV_BASIS 14695981039346656037ULL
+#define PARAM_CACHE_FNV_PRIME 1099511628211ULL
 
 /******************************************************************************
  * @brief   NetCDF file types
@@ -43,6 +61,7 @@ enum
 {
     NC_HISTORY_FILE,
     NC_STATE_FILE,
+    NC_DECOMP_FILE,
 };
 
 /******************************************************************************
@@ -197,18 +216,152 @@ typedef struct {
     char result_dir[MAXSTRING]; /**< result directory */
     char statefile[MAXSTRING];  /**< name of model state file */
     char log_path[MAXSTRING];   /**< Location to write log file to */
+    nameid_struct decomp_cost;  /**< measured cell cost file name and nc_id */
+    char decomp_out[MAXSTRING]; /**< name of cell cost file to write */
+    char param_cache[MAXSTRING]; /**< parameter cache file prefix */
+    char timing_report[MAXSTRING]; /**< name of timing report file */
 } filenames_struct;
 
+/******************************************************************************
+ * @brief   History write of one output stream that is (being) gathered to the
+ *          master node and written in the background.
+ *****************************************************************************/
+typedef struct {
+    size_t time_idx;       /**< position in the time dimension */
+    double time;           /**< time value */
+    double time_bounds[2]; /**< time bounds values */
+    int nc_id;             /**< netcdf id of the history file */
+    bool close;            /**< close the history file after the write */
+    bool pending;          /**< posted, but not yet written */
+    bool gathered;         /**< gather completed */
+    double *sendbuf;       /**< local values [nvalues][local cells] */
+    double *recvbuf;       /**< gathered values on the master node
+                              [nodes][nvalues][local cells of node] */
+    MPI_Request request;   /**< request of the non-blocking gather */
+} hist_write_struct;
+
+/******************************************************************************
+ * @brief   Asynchronous history writer, every stream is double buffered.
+ *****************************************************************************/
+typedef struct {
+    size_t nstreams;            /**< number of output streams */
+    size_t *nvalues;            /**< values per cell for each stream */
+    size_t *next;               /**< buffer to use next (the oldest) for each
+                                   stream */
+    hist_write_struct **writes; /**< writes [nstreams][HIST_WRITE_NBUF] */
+    int **recv_sizes;           /**< gather counts [nstreams][nodes] */
+    int **recv_offsets;         /**< gather offsets [nstreams][nodes] */
+    size_t *cell_idx;           /**< grid index of the active cells in gather
+                                   order [ncells_active] */
+    pthread_t thread;           /**< background writer */
+    bool running;               /**< true if the writer is running */
+} hist_writer_struct;
+
+/******************************************************************************
+ * @brief   Header of the checkpoint manifest and node files.
+ *****************************************************************************/
+typedef struct {
+    char magic[CHECKPOINT_MAGIC_LEN]; /**< CHECKPOINT_MAGIC */
+    unsigned int version;             /**< CHECKPOINT_VERSION */
+    size_t nfiles;                    /**< number of node files (manifest) */
+    size_t ncells;                    /**< number of cells */
+    dmy_struct dmy;                   /**< state date */
+    size_t NVEGTYPES;                 /**< model setup, checked on restore */
+    size_t SNOW_BAND;
+    size_t Nlayer;
+    size_t Nnode;
+    size_t Nfrost;
+    size_t NLAKENODES;
+    bool LAKES;
+    bool CARBON;
+} checkpoint_header_struct;
+
+/******************************************************************************
+ * @brief   Cell index entry of a checkpoint node file.
+ *****************************************************************************/
+typedef struct {
+    size_t io_idx;  /**< grid index of the cell (node file number once
+                       scattered on restore) */
+    size_t offset;  /**< byte offset of the cell state in the node file */
+    size_t nvalues; /**< number of state values of the cell */
+} checkpoint_index_struct;
+
+/******************************************************************************
+ * @brief   Header of a parameter cache node file; a cache file is only used
+ *          if all fields match the current run.
+ *****************************************************************************/
+typedef struct {
+    char magic[PARAM_CACHE_MAGIC_LEN]; /**< PARAM_CACHE_MAGIC */
+    unsigned int version;              /**< PARAM_CACHE_VERSION */
+    size_t mpi_size;                   /**< number of nodes */
+    size_t mpi_rank;                   /**< node of the file */
+    size_t ncells;                     /**< number of local cells */
+    size_t ntiles;                     /**< number of vegetation tiles */
+    size_t nbytes;                     /**< file size */
+    uint64_t key;                      /**< hash of the model setup,
+                                          parameter file and local cells */
+} param_cache_header_struct;
+
+/******************************************************************************
+ * @brief   Checkpoint buffer of a cell; the same function copies the state
+ *          to the buffer on store and from the buffer on restore.
+ *****************************************************************************/
+typedef struct {
+    double *values; /**< state values of a cell (NULL: count only) */
+    size_t nvalues; /**< number of values copied */
+    bool restore;   /**< true: buffer to state, false: state to buffer */
+} checkpoint_struct;
+
+/******************************************************************************
+ * @brief   State snapshots: an in-memory copy of the model state that is
+ *          written as a checkpoint in the background.
+ *****************************************************************************/
+typedef struct {
+    alarm_struct alarm;             /**< snapshot alarm */
+    dmy_struct dmy;                 /**< state date of the snapshot */
+    char filename[MAXSTRING];       /**< checkpoint manifest of the snapshot */
+    checkpoint_index_struct *index; /**< cell index [local cells] */
+    double *values;                 /**< state values of the local cells */
+    size_t nvalues;                 /**< number of state values */
+    char **kept;                    /**< complete snapshots on disk, oldest
+                                       first [snapshot_keep] */
+    size_t nkept;                   /**< number of complete snapshots */
+    bool pending;                   /**< copied, but not yet complete */
+    bool written;                   /**< node file written (set by the
+                                       writer, protected by lock) */
+    pthread_mutex_t lock;           /**< lock on written */
+    pthread_t thread;               /**< background writer */
+    bool running;                   /**< true if the writer is running */
+} snapshot_writer_struct;
+
 void add_nveg_to_global_domain(nameid_struct *nc_nameid,
                                domain_struct *global_domain);
-void alloc_force(force_data_struct *force);
+void alloc_force(force_data_struct *force, size_t ncells);
 void alloc_veg_hist(veg_hist_struct *veg_hist);
 double air_density(double t, double p);
 double average(double *ar, size_t n);
 void check_init_state_file(void);
+void checkpoint_bool(checkpoint_struct *ckpt, bool *value);
+void checkpoint_cell(checkpoint_struct *ckpt, size_t iCell);
+void checkpoint_double(checkpoint_struct *ckpt, double *value);
+void checkpoint_int(checkpoint_struct *ckpt, int *value);
+void checkpoint_pack(double *values);
+void checkpoint_size_t(checkpoint_struct *ckpt, size_t *value);
+void checkpoint_snow(checkpoint_struct *ckpt, snow_data_struct *snow);
+void checkpoint_soil(checkpoint_struct *ckpt, cell_data_struct *cell);
+void checkpoint_uint(checkpoint_struct *ckpt, unsigned int *value);
+void checkpoint_ushort(checkpoint_struct *ckpt, unsigned short int *value);
 void compare_ncdomain_with_global_domain(nameid_struct *nc_nameid);
-void free_force(force_data_struct *force);
+void define_nc_coord_vars(int nc_id, char *filename, int ni_dimid,
+                          int nj_dimid, int *lon_var_id, int *lat_var_id);
+void define_nc_grid_dims(int nc_id, char *filename, int *ni_dimid,
+                         int *nj_dimid);
+void free_force(force_data_struct *force, size_t ncells);
 void free_veg_hist(veg_hist_struct *veg_hist);
+void gather_instrument_records(void);
+void get_checkpoint_header(FILE *fp, char *filename,
+                           checkpoint_header_struct *header);
+void get_decomp_cost(void);
 void get_domain_type(char *cmdstr);
 size_t get_global_domain(nameid_struct *domain_nc_nameid,
                          nameid_struct *param_nc_nameid,
@@ -228,6 +381,14 @@ int get_nc_field_int(nameid_struct *nc_nameid, char *var_name, size_t *start,
                      size_t *count, int *var);
 int get_nc_dtype(unsigned short int dtype);
 int get_nc_mode(unsigned short int format);
+bool get_param_cache(void);
+void hist_writer_finalize(void);
+void hist_writer_flush(void);
+void hist_writer_init(void);
+void hist_writer_put(size_t stream_idx, hist_write_struct *hist_write);
+void hist_writer_start(void);
+void hist_writer_stop(void);
+void *hist_writer_thread(void *arg);
 void initialize_domain(domain_struct *domain);
 void initialize_domain_info(domain_info_struct *info);
 void initialize_filenames(void);
@@ -244,15 +405,33 @@ void initialize_nc_file(nc_file_struct *nc_file, size_t nvars,
                         unsigned int *varids, unsigned short int *dtypes);
 void initialize_soil_con(soil_con_struct *soil_con);
 void initialize_veg_con(veg_con_struct *veg_con);
+bool is_checkpoint_file(char *filename);
 void parse_output_info(FILE *gp, stream_struct **output_streams,
                        dmy_struct *dmy_current);
+uint64_t param_cache_hash(uint64_t hash, void *data, size_t size);
+void param_cache_unpack(char *data);
 void print_force_data(force_data_struct *force);
 void print_domain(domain_struct *domain, bool print_loc);
 void print_location(location_struct *location);
 void print_nc_file(nc_file_struct *nc);
 void print_nc_var(nc_var_struct *nc_var);
 void print_veg_con_map(veg_con_map_struct *veg_con_map);
+void put_checkpoint_file(char *rank_filename, checkpoint_header_struct *header,
+                         checkpoint_index_struct *index, double *values,
+                         size_t nvalues);
+void put_checkpoint_manifest(char *filename, dmy_struct *dmy_state);
+void put_decomp_cost(void);
 void put_nc_attr(int nc_id, int var_id, const char *name, const char *value);
+void put_nc_coord_vars(int nc_id, char *filename, int lon_var_id,
+                       int lat_var_id);
+void put_param_cache(void);
+void remove_checkpoint(char *filename);
+void set_checkpoint_header(checkpoint_header_struct *header,
+                           dmy_struct *dmy_state, size_t ncells);
+void set_checkpoint_filename(dmy_struct *dmy_state, char *filename);
+size_t set_checkpoint_index(checkpoint_index_struct *index);
+void set_checkpoint_rank_filename(char *filename, size_t rank,
+                                  char *rank_filename);
 void set_force_type(char *cmdstr);
 void set_global_nc_attributes(int ncid, unsigned short int file_type);
 void set_state_meta_data_info();
@@ -262,17 +441,31 @@ void set_nc_var_info(unsigned int varid, unsigned short int dtype,
                      nc_file_struct *nc_hist_file, nc_var_struct *nc_var);
 void set_nc_state_file_info(nc_file_struct *nc_state_file);
 void set_nc_state_var_info(nc_file_struct *nc_state_file);
+void set_param_cache_header(param_cache_header_struct *header);
+void set_param_cache_rank_filename(char *rank_filename);
+void snapshot_writer_complete(void);
+void snapshot_writer_finalize(void);
+void snapshot_writer_init(dmy_struct *dmy_current);
+void snapshot_writer_poll(void);
+void *snapshot_writer_thread(void *arg);
 void sprint_location(char *str, location_struct *loc);
 void vic_alloc(void);
 void vic_finalize(void);
 void vic_image_run(dmy_struct *dmy_current);
 void vic_init(void);
+void vic_init_params(void);
 void vic_init_output(dmy_struct *dmy_current);
 void vic_restore(void);
+void vic_restore_checkpoint(void);
+void vic_snapshot(dmy_struct *dmy_state);
 void vic_start(void);
 void vic_store(dmy_struct *dmy_state, char *state_filename);
+void vic_store_checkpoint(dmy_struct *dmy_state, char *filename);
 void vic_write(stream_struct *stream, nc_file_struct *nc_hist_file,
                dmy_struct *dmy_current);
+void vic_write_async(size_t stream_idx, dmy_struct *dmy_current);
 void vic_write_output(dmy_struct *dmy);
+void write_instrument_report(void);
+void write_instrument_table(void);
 void write_vic_timing_table(timer_struct *timers, char *driver);
 #endif
@@ -33,6 +33,7 @@
     #include <omp.h>
 #else
     #define omp_get_max_threads() 1
+    #define omp_get_thread_num() 0
 #endif
 
 #define VIC_MPI_ROOT 0
@@ -45,12 +46,37 @@ typedef struct {
     int nc_id;
 } nameid_struct;
 
+/******************************************************************************
+ * @brief   This structure stores the hyperslab of the global grid that covers
+ *          the active cells of the local node. It is used for collective
+ *          (parallel netCDF) reads in which each node only reads the part of
+ *          the domain that it owns.
+ *****************************************************************************/
+typedef struct {
+    size_t y_start;    /**< first row of the hyperslab */
+    size_t y_count;    /**< number of rows in the hyperslab */
+    size_t x_start;    /**< first column of the hyperslab */
+    size_t x_count;    /**< number of columns in the hyperslab */
+    size_t *slab_idx;  /**< index of each local active cell in the hyperslab */
+} mpi_slab_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the cost of a group of cells that is
+ *          assigned to a node as a whole (e.g. a single cell or a basin).
+ *****************************************************************************/
+typedef struct {
+    double cost;       /**< cost of the group (e.g. wall time) */
+    size_t id;         /**< group id */
+} decomp_cost_struct;
+
 void create_MPI_filenames_struct_type(MPI_Datatype *mpi_type);
 void create_MPI_global_struct_type(MPI_Datatype *mpi_type);
+void create_MPI_instrument_record_type(MPI_Datatype *mpi_type);
 void create_MPI_location_struct_type(MPI_Datatype *mpi_type);
 void create_MPI_alarm_struct_type(MPI_Datatype *mpi_type);
 void create_MPI_option_struct_type(MPI_Datatype *mpi_type);
 void create_MPI_param_struct_type(MPI_Datatype *mpi_type);
+int decomp_cost_compare(const void *a, const void *b);
 void gather_field_double(double fillval, double *dvar, double *var);
 void gather_put_nc_field_double(int nc_id, int var_id, double fillval,
                                 size_t *start, size_t *count, double *var);
@@ -63,19 +89,39 @@ void gather_put_nc_field_short(int nc_id, int var_id, short int fillval,
 void gather_put_nc_field_schar(int nc_id, int var_id, char fillval,
                                size_t *start, size_t *count, char *var);
 void scatter_field_double(double *dvar, double *var);
+void scatter_field_slab(size_t nlead, size_t size, MPI_Datatype type,
+                        void *gvar, void *var);
 void get_scatter_nc_field_double(nameid_struct *nc_nameid, char *var_name,
                                  size_t *start, size_t *count, double *var);
 void get_scatter_nc_field_float(nameid_struct *nc_nameid, char *var_name,
                                 size_t *start, size_t *count, float *var);
 void get_scatter_nc_field_int(nameid_struct *nc_nameid, char *var_name,
                               size_t *start, size_t *count, int *var);
+void get_scatter_nc_slab_double(nameid_struct *nc_nameid, char *var_name,
+                                size_t ndims, size_t *start, size_t *count,
+                                double *var);
+void get_scatter_nc_slab_int(nameid_struct *nc_nameid, char *var_name,
+                             size_t ndims, size_t *start, size_t *count,
+                             int *var);
+size_t get_nc_slab_nlead(char *var_name, size_t ndims, size_t *count);
+void get_par_nc_field_double(nameid_struct *nc_nameid, char *var_name,
+                             size_t ndims, size_t *start, size_t *count,
+                             double *var);
 void initialize_mpi(void);
 void map(size_t size, size_t n, size_t *from_map, size_t *to_map, void *from,
          void *to);
+void mpi_map_local_slab(mpi_slab_struct *slab);
 void mpi_map_decomp_domain(size_t ncells, size_t mpi_size,
                            int **mpi_map_local_array_sizes,
                            int **mpi_map_global_array_offsets,
                            size_t **mpi_map_mapping_array);
+void mpi_map_decomp_domain_cost(size_t ncells, size_t mpi_size,
+                                int *mpi_map_local_array_sizes,
+                                int *mpi_map_global_array_offsets,
+                                size_t *mpi_map_mapping_array, size_t ngroups,
+                                size_t *group_start, size_t *group_cells,
+                                double *group_cost);
+void open_par_nc_file(nameid_struct *nc_nameid);
 void print_mpi_error_str(int error_code);
 
 #endif
@@ -27,98 +27,134 @@
 #include <vic_driver_shared_image.h>
 
 /******************************************************************************
- * @brief    Allocate memory for the force data structure.
+ * @brief    Allocate memory for the force data structures of all cells. Each
+ *           forcing field is a single block of NR + 1 steps per cell.
  *****************************************************************************/
 void
-alloc_force(force_data_struct *force)
+alloc_force(force_data_struct *force,
+            size_t             ncells)
 {
     extern option_struct options;
 
-    force->air_temp = calloc(NR + 1, sizeof(*(force->air_temp)));
-    check_alloc_status(force->air_temp, "Memory allocation error.");
+    size_t               i;
 
-    force->density = calloc(NR + 1, sizeof(*(force->density)));
-    check_alloc_status(force->density, "Memory allocation error.");
+    if (ncells == 0) {
+        return;
+    }
+
+    force[0].air_temp = calloc(ncells * (NR + 1), sizeof(*(force[0].air_temp)));
+    check_alloc_status(force[0].air_temp, "Memory allocation error.");
 
-    force->longwave = calloc(NR + 1, sizeof(*(force->longwave)));
-    check_alloc_status(force->longwave, "Memory allocation error.");
+    force[0].density = calloc(ncells * (NR + 1), sizeof(*(force[0].density)));
+    check_alloc_status(force[0].density, "Memory allocation error.");
 
-    force->prec = calloc(NR + 1, sizeof(*(force->prec)));
-    check_alloc_status(force->prec, "Memory allocation error.");
+    force[0].longwave = calloc(ncells * (NR + 1), sizeof(*(force[0].longwave)));
+    check_alloc_status(force[0].longwave, "Memory allocation error.");
 
-    force->pressure = calloc(NR + 1, sizeof(*(force->pressure)));
-    check_alloc_status(force->pressure, "Memory allocation error.");
+    force[0].prec = calloc(ncells * (NR + 1), sizeof(*(force[0].prec)));
+    check_alloc_status(force[0].prec, "Memory allocation error.");
 
-    force->shortwave = calloc(NR + 1, sizeof(*(force->shortwave)));
-    check_alloc_status(force->shortwave, "Memory allocation error.");
+    force[0].pressure = calloc(ncells * (NR + 1), sizeof(*(force[0].pressure)));
+    check_alloc_status(force[0].pressure, "Memory allocation error.");
 
-    force->snowflag = calloc(NR + 1, sizeof(*(force->snowflag)));
-    check_alloc_status(force->snowflag, "Memory allocation error.");
+    force[0].shortwave = calloc(ncells * (NR + 1),
+                                sizeof(*(force[0].shortwave)));
+    check_alloc_status(force[0].shortwave, "Memory allocation error.");
 
-    force->vp = calloc(NR + 1, sizeof(*(force->vp)));
-    check_alloc_status(force->vp, "Memory allocation error.");
+    force[0].snowflag = calloc(ncells * (NR + 1), sizeof(*(force[0].snowflag)));
+    check_alloc_status(force[0].snowflag, "Memory allocation error.");
 
-    force->vpd = calloc(NR + 1, sizeof(*(force->vpd)));
-    check_alloc_status(force->vpd, "Memory allocation error.");
+    force[0].vp = calloc(ncells * (NR + 1), sizeof(*(force[0].vp)));
+    check_alloc_status(force[0].vp, "Memory allocation error.");
 
-    force->wind = calloc(NR + 1, sizeof(*(force->wind)));
-    check_alloc_status(force->wind, "Memory allocation error.");
+    force[0].vpd = calloc(ncells * (NR + 1), sizeof(*(force[0].vpd)));
+    check_alloc_status(force[0].vpd, "Memory allocation error.");
+
+    force[0].wind = calloc(ncells * (NR + 1), sizeof(*(force[0].wind)));
+    check_alloc_status(force[0].wind, "Memory allocation error.");
 
     if (options.LAKES) {
-        force->channel_in = calloc(NR + 1, sizeof(*(force->channel_in)));
-        check_alloc_status(force->channel_in, "Memory allocation error.");
+        force[0].channel_in = calloc(ncells * (NR + 1),
+                                     sizeof(*(force[0].channel_in)));
+        check_alloc_status(force[0].channel_in, "Memory allocation error.");
     }
     if (options.CARBON) {
-        force->Catm = calloc(NR + 1, sizeof(*(force->Catm)));
-        check_alloc_status(force->Catm, "Memory allocation error.");
+        force[0].Catm = calloc(ncells * (NR + 1), sizeof(*(force[0].Catm)));
+        check_alloc_status(force[0].Catm, "Memory allocation error.");
 
-        force->coszen = calloc(NR + 1, sizeof(*(force->coszen)));
-        check_alloc_status(force->coszen, "Memory allocation error.");
+        force[0].coszen = calloc(ncells * (NR + 1), sizeof(*(force[0].coszen)));
+        check_alloc_status(force[0].coszen, "Memory allocation error.");
 
-        force->fdir = calloc(NR + 1, sizeof(*(force->fdir)));
-        check_alloc_status(force->fdir, "Memory allocation error.");
+        force[0].fdir = calloc(ncells * (NR + 1), sizeof(*(force[0].fdir)));
+        check_alloc_status(force[0].fdir, "Memory allocation error.");
 
-        force->par = calloc(NR + 1, sizeof(*(force->par)));
-        check_alloc_status(force->par, "Memory allocation error.");
+        force[0].par = calloc(ncells * (NR + 1), sizeof(*(force[0].par)));
+        check_alloc_status(force[0].par, "Memory allocation error.");
     }
     else {
-        force->Catm = calloc(NR + 1, sizeof(*(force->Catm)));
-        check_alloc_status(force->Catm, "Memory allocation error.");
+        force[0].Catm = calloc(ncells * (NR + 1), sizeof(*(force[0].Catm)));
+        check_alloc_status(force[0].Catm, "Memory allocation error.");
+    }
+
+    for (i = 1; i < ncells; i++) {
+        force[i].air_temp = force[0].air_temp + i * (NR + 1);
+        force[i].density = force[0].density + i * (NR + 1);
+        force[i].longwave = force[0].longwave + i * (NR + 1);
+        force[i].prec = force[0].prec + i * (NR + 1);
+        force[i].pressure = force[0].pressure + i * (NR + 1);
+        force[i].shortwave = force[0].shortwave + i * (NR + 1);
+        force[i].snowflag = force[0].snowflag + i * (NR + 1);
+        force[i].vp = force[0].vp + i * (NR + 1);
+        force[i].vpd = force[0].vpd + i * (NR + 1);
+        force[i].wind = force[0].wind + i * (NR + 1);
+        if (options.LAKES) {
+            force[i].channel_in = force[0].channel_in + i * (NR + 1);
+        }
+        if (options.CARBON) {
+            force[i].Catm = force[0].Catm + i * (NR + 1);
+            force[i].coszen = force[0].coszen + i * (NR + 1);
+            force[i].fdir = force[0].fdir + i * (NR + 1);
+            force[i].par = force[0].par + i * (NR + 1);
+        }
+        else {
+            force[i].Catm = force[0].Catm + i * (NR + 1);
+        }
     }
 }
 
 /******************************************************************************
- * @brief    Free memory for the force data structure.
+ * @brief    Free memory for the force data structures of all cells.
  *****************************************************************************/
 void
-free_force(force_data_struct *force)
+free_force(force_data_struct *force,
+           size_t             ncells)
 {
     extern option_struct options;
 
-    if (force == NULL) {
+    if (force == NULL || ncells == 0) {
         return;
     }
 
-    free(force->air_temp);
-    free(force->density);
-    free(force->longwave);
-    free(force->prec);
-    free(force->pressure);
-    free(force->shortwave);
-    free(force->snowflag);
-    free(force->vp);
-    free(force->vpd);
-    free(force->wind);
+    free(force[0].air_temp);
+    free(force[0].density);
+    free(force[0].longwave);
+    free(force[0].prec);
+    free(force[0].pressure);
+    free(force[0].shortwave);
+    free(force[0].snowflag);
+    free(force[0].vp);
+    free(force[0].vpd);
+    free(force[0].wind);
     if (options.LAKES) {
-        free(force->channel_in);
+        free(force[0].channel_in);
     }
     if (options.CARBON) {
-        free(force->Catm);
-        free(force->coszen);
-        free(force->fdir);
-        free(force->par);
+        free(force[0].Catm);
+        free(force[0].coszen);
+        free(force[0].fdir);
+        free(force[0].par);
     }
     else {
-        free(force->Catm);
+        free(force[0].Catm);
     }
 }
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Read and write the measured run time per grid cell that is used to balance
+ * the domain decomposition.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_image.h>
+
+/******************************************************************************
+ * @brief    Read the cost per active cell from the decomposition cost file
+ * @details  Only called on the master node. Cells with a missing or negative
+ *           cost get the mean cost of the other cells.
+ *****************************************************************************/
+void
+get_decomp_cost(void)
+{
+    extern domain_struct    global_domain;
+    extern filenames_struct filenames;
+    extern size_t          *filter_active_cells;
+    extern double          *decomp_cost;
+
+    double                 *dvar;
+    double                  sum;
+    size_t                  nvalid;
+    size_t                  d2start[2];
+    size_t                  d2count[2];
+    int                     status;
+
+    size_t                  i;
+
+    status = nc_open(filenames.decomp_cost.nc_filename, NC_NOWRITE,
+                     &(filenames.decomp_cost.nc_id));
+    check_nc_status(status, "Error opening %s",
+                    filenames.decomp_cost.nc_filename);
+
+    compare_ncdomain_with_global_domain(&(filenames.decomp_cost));
+
+    dvar = malloc(global_domain.ncells_total * sizeof(*dvar));
+    check_alloc_status(dvar, "Memory allocation error.");
+    decomp_cost = malloc((global_domain.ncells_active + 1) *
+                         sizeof(*decomp_cost));
+    check_alloc_status(decomp_cost, "Memory allocation error.");
+
+    d2start[0] = 0;
+    d2start[1] = 0;
+    d2count[0] = global_domain.n_ny;
+    d2count[1] = global_domain.n_nx;
+
+    status = get_nc_field_double(&(filenames.decomp_cost), "cost", d2start,
+                                 d2count, dvar);
+    check_nc_status(status, "Error getting values cost for %s",
+                    filenames.decomp_cost.nc_filename);
+
+    // filter the active cells only
+    map(sizeof(double), global_domain.ncells_active, filter_active_cells, NULL,
+        dvar, decomp_cost);
+
+    // fill in cells that were not measured (e.g. after a domain change)
+    sum = 0.;
+    nvalid = 0;
+    for (i = 0; i < global_domain.ncells_active; i++) {
+        if (decomp_cost[i] >= 0. && decomp_cost[i] != NC_FILL_DOUBLE) {
+            sum += decomp_cost[i];
+            nvalid++;
+        }
+    }
+    if (nvalid < global_domain.ncells_active) {
+        log_warn("No cost found for %zu cells in %s; "
+                 "Setting their cost to the mean cost",
+                 global_domain.ncells_active - nvalid,
+                 filenames.decomp_cost.nc_filename);
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            if (!(decomp_cost[i] >= 0. && decomp_cost[i] != NC_FILL_DOUBLE)) {
+                decomp_cost[i] = nvalid > 0 ? sum / nvalid : 1.;
+            }
+        }
+    }
+
+    status = nc_close(filenames.decomp_cost.nc_id);
+    check_nc_status(status, "Error closing %s",
+                    filenames.decomp_cost.nc_filename);
+
+    free(dvar);
+}
+
+/******************************************************************************
+ * @brief    Write the measured cost per cell and the current decomposition
+ * @details  The cost is the mean vic_run wall time per time step. The node
+ *           of each cell is written as variable "basin", so the file can be
+ *           used both as DECOMPOSITION_COST and as routing DECOMPOSITION_FILE
+ *           input for a next run.
+ *****************************************************************************/
+void
+put_decomp_cost(void)
+{
+    extern double             *cell_cost;
+    extern domain_struct       global_domain;
+    extern domain_struct       local_domain;
+    extern filenames_struct    filenames;
+    extern global_param_struct global_param;
+    extern int                 mpi_rank;
+
+    double                    *dvar = NULL;
+    int                       *ivar = NULL;
+    int                        nc_id = -1;
+    int                        ni_dimid;
+    int                        nj_dimid;
+    int                        dimids[2];
+    int                        lon_var_id;
+    int                        lat_var_id;
+    int                        cost_var_id = -1;
+    int                        node_var_id = -1;
+    int                        old_fill_mode;
+    int                        i_fillvalue = NC_FILL_INT;
+    double                     d_fillvalue = NC_FILL_DOUBLE;
+    size_t                     dstart[2];
+    size_t                     dcount[2];
+    int                        status;
+
+    size_t                     i;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        status = nc_create(filenames.decomp_out,
+                           get_nc_mode(NETCDF4_CLASSIC), &nc_id);
+        check_nc_status(status, "Error creating %s", filenames.decomp_out);
+
+        set_global_nc_attributes(nc_id, NC_DECOMP_FILE);
+
+        status = nc_set_fill(nc_id, NC_FILL, &old_fill_mode);
+        check_nc_status(status, "Error setting fill value in %s",
+                        filenames.decomp_out);
+
+        define_nc_grid_dims(nc_id, filenames.decomp_out, &ni_dimid,
+                            &nj_dimid);
+        define_nc_coord_vars(nc_id, filenames.decomp_out, ni_dimid, nj_dimid,
+                             &lon_var_id, &lat_var_id);
+
+        // cost and node variables
+        dimids[0] = nj_dimid;
+        dimids[1] = ni_dimid;
+        status = nc_def_var(nc_id, "cost", NC_DOUBLE, 2, dimids,
+                            &cost_var_id);
+        check_nc_status(status, "Error defining cost variable in %s",
+                        filenames.decomp_out);
+        put_nc_attr(nc_id, cost_var_id, "long_name",
+                    "mean vic_run wall time per time step");
+        put_nc_attr(nc_id, cost_var_id, "units", "s");
+        status = nc_put_att_double(nc_id, cost_var_id, "_FillValue",
+                                   NC_DOUBLE, 1, &d_fillvalue);
+        check_nc_status(status, "Error adding attribute in %s",
+                        filenames.decomp_out);
+
+        status = nc_def_var(nc_id, "basin", NC_INT, 2, dimids, &node_var_id);
+        check_nc_status(status, "Error defining basin variable in %s",
+                        filenames.decomp_out);
+        put_nc_attr(nc_id, node_var_id, "long_name",
+                    "decomposition node of the cell");
+        status = nc_put_att_int(nc_id, node_var_id, "_FillValue", NC_INT, 1,
+                                &i_fillvalue);
+        check_nc_status(status, "Error adding attribute in %s",
+                        filenames.decomp_out);
+
+        status = nc_enddef(nc_id);
+        check_nc_status(status, "Error leaving define mode for %s",
+                        filenames.decomp_out);
+
+        put_nc_coord_vars(nc_id, filenames.decomp_out, lon_var_id,
+                          lat_var_id);
+    }
+
+    // mean cost per time step and node per cell
+    dvar = malloc((local_domain.ncells_active + 1) * sizeof(*dvar));
+    check_alloc_status(dvar, "Memory allocation error.");
+    ivar = malloc((local_domain.ncells_active + 1) * sizeof(*ivar));
+    check_alloc_status(ivar, "Memory allocation error.");
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        dvar[i] = cell_cost[i] / max(global_param.nrecs, 1);
+        ivar[i] = mpi_rank;
+    }
+
+    dstart[0] = 0;
+    dstart[1] = 0;
+    dcount[0] = global_domain.n_ny;
+    dcount[1] = global_domain.n_nx;
+    gather_put_nc_field_double(nc_id, cost_var_id, d_fillvalue, dstart, dcount,
+                               dvar);
+    gather_put_nc_field_int(nc_id, node_var_id, i_fillvalue, dstart, dcount,
+                            ivar);
+
+    free(dvar);
+    free(ivar);
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        status = nc_close(nc_id);
+        check_nc_status(status, "Error closing %s", filenames.decomp_out);
+    }
+}
@@ -44,7 +44,9 @@ get_nc_field_double(nameid_struct *nc_nameid,
     check_nc_status(status, "Error getting variable id for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
+    INSTRUMENT_BEGIN(INSTR_NC_READ);
     status = nc_get_vara_double(nc_nameid->nc_id, var_id, start, count, var);
+    INSTRUMENT_END(INSTR_NC_READ);
     check_nc_status(status, "Error getting values for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
@@ -69,7 +71,9 @@ get_nc_field_float(nameid_struct *nc_nameid,
     check_nc_status(status, "Error getting variable id for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
+    INSTRUMENT_BEGIN(INSTR_NC_READ);
     status = nc_get_vara_float(nc_nameid->nc_id, var_id, start, count, var);
+    INSTRUMENT_END(INSTR_NC_READ);
     check_nc_status(status, "Error getting values for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
@@ -94,7 +98,9 @@ get_nc_field_int(nameid_struct *nc_nameid,
     check_nc_status(status, "Error getting variable id for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
+    INSTRUMENT_BEGIN(INSTR_NC_READ);
     status = nc_get_vara_int(nc_nameid->nc_id, var_id, start, count, var);
+    INSTRUMENT_END(INSTR_NC_READ);
     check_nc_status(status, "Error getting values for %s in %s", var_name,
                     nc_nameid->nc_filename);
 
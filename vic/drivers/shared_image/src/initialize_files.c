@@ -46,6 +46,10 @@ initialize_filenames()
     snprintf(filenames.domain.nc_filename, MAXSTRING, "%s", "MISSING");
     snprintf(filenames.result_dir, MAXSTRING, "%s", "MISSING");
     snprintf(filenames.log_path, MAXSTRING, "%s", "MISSING");
+    snprintf(filenames.decomp_cost.nc_filename, MAXSTRING, "%s", "MISSING");
+    snprintf(filenames.decomp_out, MAXSTRING, "%s", "MISSING");
+    snprintf(filenames.param_cache, MAXSTRING, "%s", "MISSING");
+    snprintf(filenames.timing_report, MAXSTRING, "%s", "MISSING");
     for (i = 0; i < MAX_FORCE_FILES; i++) {
         snprintf(filenames.f_path_pfx[i], MAXSTRING, "%s", "MISSING");
     }
@@ -33,6 +33,7 @@ void
 vic_alloc(void)
 {
     extern all_vars_struct    *all_vars;
+    extern double             *cell_cost;
     extern force_data_struct  *force;
     extern domain_struct       local_domain;
     extern option_struct       options;
@@ -46,10 +47,15 @@ vic_alloc(void)
     extern lake_con_struct    *lake_con;
     size_t                     i;
     size_t                     j;
+    size_t                     ntiles;
+    size_t                     offset;
+    all_vars_struct            arena;
 
-    // allocate memory for force structure
+    // allocate memory for force structure - allocate enough memory for NR+1
+    // steps
     force = malloc(local_domain.ncells_active * sizeof(*force));
     check_alloc_status(force, "Memory allocation error.");
+    alloc_force(force, local_domain.ncells_active);
 
     // allocate memory for veg_hist structure
     veg_hist = malloc(local_domain.ncells_active * sizeof(*veg_hist));
@@ -78,7 +84,7 @@ vic_alloc(void)
     }
 
     // all_vars allocation
-    all_vars = malloc(local_domain.ncells_active * sizeof(*all_vars));
+    all_vars = calloc(local_domain.ncells_active, sizeof(*all_vars));
     check_alloc_status(all_vars, "Memory allocation error.");
 
     // out_data allocation
@@ -89,11 +95,12 @@ vic_alloc(void)
     save_data = calloc(local_domain.ncells_active, sizeof(*save_data));
     check_alloc_status(save_data, "Memory allocation error.");
 
+    // vic_run wall time per cell (for the decomposition cost)
+    cell_cost = calloc(local_domain.ncells_active + 1, sizeof(*cell_cost));
+    check_alloc_status(cell_cost, "Memory allocation error.");
+
     // allocate memory for individual grid cells
     for (i = 0; i < local_domain.ncells_active; i++) {
-        // force allocation - allocate enough memory for NR+1 steps
-        alloc_force(&(force[i]));
-
         // snow band allocation
         soil_con[i].AreaFract = calloc(options.SNOW_BAND,
                                        sizeof(*(soil_con[i].AreaFract)));
@@ -159,12 +166,28 @@ vic_alloc(void)
         veg_lib[i] = calloc(options.NVEGTYPES, sizeof(*(veg_lib[i])));
         check_alloc_status(veg_lib[i], "Memory allocation error.");
 
-        all_vars[i] = make_all_vars(veg_con_map[i].nv_active - options.Nbare);
-
         // allocate memory for veg_hist
         veg_hist[i] = calloc(veg_con_map[i].nv_active, sizeof(*(veg_hist[i])));
         for (j = 0; j < veg_con_map[i].nv_active; j++) {
             alloc_veg_hist(&(veg_hist[i][j]));
         }
     }
+
+    // the model state of all tiles in the local domain is carved out of one
+    // arena, so that neighbouring cells are also neighbours in memory
+    ntiles = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        ntiles += veg_con_map[i].nv_active;
+    }
+    if (ntiles > 0) {
+        arena = make_all_vars(ntiles - options.Nbare);
+        offset = 0;
+        for (i = 0; i < local_domain.ncells_active; i++) {
+            all_vars[i].cell = &(arena.cell[offset]);
+            all_vars[i].energy = &(arena.energy[offset]);
+            all_vars[i].snow = &(arena.snow[offset]);
+            all_vars[i].veg_var = &(arena.veg_var[offset]);
+            offset += veg_con_map[i].nv_active;
+        }
+    }
 }
@@ -0,0 +1,811 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Store and restore model states as a binary checkpoint. Every node writes
+ * the state of its own active cells (allocated vegetation tiles only) to its
+ * own file; the master node writes a manifest that lists the node files. On
+ * restore the cells are looked up by their grid index, so the checkpoint can
+ * be restored with a different domain decomposition or number of nodes.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_image.h>
+#include <plugin.h>
+
+/******************************************************************************
+ * @brief    Copy a double precision state value to or from the checkpoint
+ *           buffer (or only count it if there is no buffer)
+ *****************************************************************************/
+void
+checkpoint_double(checkpoint_struct *ckpt,
+                  double            *value)
+{
+    if (ckpt->values != NULL) {
+        if (ckpt->restore) {
+            (*value) = ckpt->values[ckpt->nvalues];
+        }
+        else {
+            ckpt->values[ckpt->nvalues] = (*value);
+        }
+    }
+    ckpt->nvalues++;
+}
+
+/******************************************************************************
+ * @brief    Copy an unsigned integer state value to or from the checkpoint
+ *           buffer
+ *****************************************************************************/
+void
+checkpoint_uint(checkpoint_struct *ckpt,
+                unsigned int      *value)
+{
+    double dvalue;
+
+    dvalue = (double) (*value);
+    checkpoint_double(ckpt, &dvalue);
+    (*value) = (unsigned int) dvalue;
+}
+
+/******************************************************************************
+ * @brief    Copy a short unsigned integer state value to or from the
+ *           checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_ushort(checkpoint_struct  *ckpt,
+                  unsigned short int *value)
+{
+    double dvalue;
+
+    dvalue = (double) (*value);
+    checkpoint_double(ckpt, &dvalue);
+    (*value) = (unsigned short int) dvalue;
+}
+
+/******************************************************************************
+ * @brief    Copy a boolean state value to or from the checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_bool(checkpoint_struct *ckpt,
+                bool              *value)
+{
+    double dvalue;
+
+    dvalue = (*value) ? 1. : 0.;
+    checkpoint_double(ckpt, &dvalue);
+    (*value) = (dvalue != 0.);
+}
+
+/******************************************************************************
+ * @brief    Copy an integer state value to or from the checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_int(checkpoint_struct *ckpt,
+               int               *value)
+{
+    double dvalue;
+
+    dvalue = (double) (*value);
+    checkpoint_double(ckpt, &dvalue);
+    (*value) = (int) dvalue;
+}
+
+/******************************************************************************
+ * @brief    Copy a size_t state value to or from the checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_size_t(checkpoint_struct *ckpt,
+                  size_t            *value)
+{
+    double dvalue;
+
+    dvalue = (double) (*value);
+    checkpoint_double(ckpt, &dvalue);
+    (*value) = (size_t) dvalue;
+}
+
+/******************************************************************************
+ * @brief    Copy the snow state to or from the checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_snow(checkpoint_struct *ckpt,
+                snow_data_struct  *snow)
+{
+    checkpoint_uint(ckpt, &(snow->last_snow));
+    checkpoint_bool(ckpt, &(snow->MELTING));
+    checkpoint_double(ckpt, &(snow->coverage));
+    checkpoint_double(ckpt, &(snow->swq));
+    checkpoint_double(ckpt, &(snow->surf_temp));
+    checkpoint_double(ckpt, &(snow->surf_water));
+    checkpoint_double(ckpt, &(snow->pack_temp));
+    checkpoint_double(ckpt, &(snow->pack_water));
+    checkpoint_double(ckpt, &(snow->density));
+    checkpoint_double(ckpt, &(snow->coldcontent));
+    checkpoint_double(ckpt, &(snow->snow_canopy));
+}
+
+/******************************************************************************
+ * @brief    Copy the soil state to or from the checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_soil(checkpoint_struct *ckpt,
+                cell_data_struct  *cell)
+{
+    extern option_struct options;
+
+    size_t               j;
+    size_t               p;
+
+    for (j = 0; j < options.Nlayer; j++) {
+        checkpoint_double(ckpt, &(cell->layer[j].moist));
+        for (p = 0; p < options.Nfrost; p++) {
+            checkpoint_double(ckpt, &(cell->layer[j].ice[p]));
+        }
+    }
+    if (options.CARBON) {
+        checkpoint_double(ckpt, &(cell->CLitter));
+        checkpoint_double(ckpt, &(cell->CInter));
+        checkpoint_double(ckpt, &(cell->CSlow));
+    }
+}
+
+/******************************************************************************
+ * @brief    Copy the state of a cell to or from the checkpoint buffer
+ * @details  Holds the same state variables as the netCDF state file, but only
+ *           for the allocated vegetation tiles.
+ *****************************************************************************/
+void
+checkpoint_cell(checkpoint_struct *ckpt,
+                size_t             iCell)
+{
+    extern all_vars_struct    *all_vars;
+    extern domain_struct       local_domain;
+    extern option_struct       options;
+    extern veg_con_map_struct *veg_con_map;
+
+    all_vars_struct           *vars;
+    double                     veg_class;
+    int                        v;
+    size_t                     j;
+    size_t                     k;
+    size_t                     m;
+
+    vars = &(all_vars[iCell]);
+
+    for (m = 0; m < options.NVEGTYPES; m++) {
+        v = veg_con_map[iCell].vidx[m];
+        if (v < 0) {
+            continue;
+        }
+
+        // the vegetation class identifies the tile
+        veg_class = (double) m;
+        checkpoint_double(ckpt, &veg_class);
+        if (veg_class != (double) m) {
+            log_err("Vegetation class %zu of cell %zu does not match "
+                    "vegetation class %.0f in the checkpoint",
+                    m, local_domain.locations[iCell].io_idx, veg_class);
+        }
+
+        for (k = 0; k < options.SNOW_BAND; k++) {
+            checkpoint_soil(ckpt, &(vars->cell[v][k]));
+            checkpoint_double(ckpt, &(vars->veg_var[v][k].Wdew));
+            if (options.CARBON) {
+                checkpoint_double(ckpt, &(vars->veg_var[v][k].AnnualNPP));
+                checkpoint_double(ckpt, &(vars->veg_var[v][k].AnnualNPPPrev));
+            }
+            checkpoint_snow(ckpt, &(vars->snow[v][k]));
+            for (j = 0; j < options.Nnode; j++) {
+                checkpoint_double(ckpt, &(vars->energy[v][k].T[j]));
+            }
+            checkpoint_double(ckpt, &(vars->energy[v][k].Tfoliage));
+            checkpoint_double(ckpt, &(vars->energy[v][k].LongUnderOut));
+            checkpoint_double(ckpt, &(vars->energy[v][k].snow_flux));
+        }
+    }
+
+    checkpoint_double(ckpt, &(vars->gridcell_avg.avg_albedo));
+
+    if (options.LAKES) {
+        checkpoint_soil(ckpt, &(vars->lake_var.soil));
+        checkpoint_snow(ckpt, &(vars->lake_var.snow));
+        for (j = 0; j < options.Nnode; j++) {
+            checkpoint_double(ckpt, &(vars->lake_var.energy.T[j]));
+        }
+        checkpoint_ushort(ckpt, &(vars->lake_var.activenod));
+        checkpoint_double(ckpt, &(vars->lake_var.dz));
+        checkpoint_double(ckpt, &(vars->lake_var.surfdz));
+        checkpoint_double(ckpt, &(vars->lake_var.ldepth));
+        for (j = 0; j < options.NLAKENODES; j++) {
+            checkpoint_double(ckpt, &(vars->lake_var.surface[j]));
+        }
+        checkpoint_double(ckpt, &(vars->lake_var.sarea));
+        checkpoint_double(ckpt, &(vars->lake_var.volume));
+        for (j = 0; j < options.NLAKENODES; j++) {
+            checkpoint_double(ckpt, &(vars->lake_var.temp[j]));
+        }
+        checkpoint_double(ckpt, &(vars->lake_var.tempavg));
+        checkpoint_double(ckpt, &(vars->lake_var.areai));
+        checkpoint_double(ckpt, &(vars->lake_var.new_ice_area));
+        checkpoint_double(ckpt, &(vars->lake_var.ice_water_eq));
+        checkpoint_double(ckpt, &(vars->lake_var.hice));
+        checkpoint_double(ckpt, &(vars->lake_var.tempi));
+        checkpoint_double(ckpt, &(vars->lake_var.swe));
+        checkpoint_double(ckpt, &(vars->lake_var.surf_temp));
+        checkpoint_double(ckpt, &(vars->lake_var.pack_temp));
+        checkpoint_double(ckpt, &(vars->lake_var.coldcontent));
+        checkpoint_double(ckpt, &(vars->lake_var.surf_water));
+        checkpoint_double(ckpt, &(vars->lake_var.pack_water));
+        checkpoint_double(ckpt, &(vars->lake_var.SAlbedo));
+        checkpoint_double(ckpt, &(vars->lake_var.sdepth));
+    }
+
+    plugin_checkpoint_cell(ckpt, iCell);
+}
+
+/******************************************************************************
+ * @brief    Set the checkpoint header for the current model setup
+ *****************************************************************************/
+void
+set_checkpoint_header(checkpoint_header_struct *header,
+                      dmy_struct               *dmy_state,
+                      size_t                    ncells)
+{
+    extern option_struct options;
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic));
+    header->version = CHECKPOINT_VERSION;
+    header->ncells = ncells;
+    header->NVEGTYPES = options.NVEGTYPES;
+    header->SNOW_BAND = options.SNOW_BAND;
+    header->Nlayer = options.Nlayer;
+    header->Nnode = options.Nnode;
+    header->Nfrost = options.Nfrost;
+    header->NLAKENODES = options.NLAKENODES;
+    header->LAKES = options.LAKES;
+    header->CARBON = options.CARBON;
+    if (dmy_state != NULL) {
+        header->dmy = (*dmy_state);
+    }
+}
+
+/******************************************************************************
+ * @brief    Read and validate a checkpoint header
+ *****************************************************************************/
+void
+get_checkpoint_header(FILE                     *fp,
+                      char                     *filename,
+                      checkpoint_header_struct *header)
+{
+    checkpoint_header_struct expected;
+
+    if (fread(header, sizeof(*header), 1, fp) != 1) {
+        log_err("Error reading checkpoint header from %s", filename);
+    }
+
+    set_checkpoint_header(&expected, NULL, 0);
+    if (memcmp(header->magic, expected.magic, sizeof(header->magic)) != 0 ||
+        header->version != expected.version) {
+        log_err("%s is not a checkpoint file of this VIC version", filename);
+    }
+    if (header->NVEGTYPES != expected.NVEGTYPES ||
+        header->SNOW_BAND != expected.SNOW_BAND ||
+        header->Nlayer != expected.Nlayer ||
+        header->Nnode != expected.Nnode ||
+        header->Nfrost != expected.Nfrost ||
+        header->LAKES != expected.LAKES ||
+        (header->LAKES && header->NLAKENODES != expected.NLAKENODES) ||
+        header->CARBON != expected.CARBON) {
+        log_err("The model setup of checkpoint %s (vegetation types, snow "
+                "bands, layers, nodes, frost areas, lakes or carbon) does not "
+                "match the current model setup", filename);
+    }
+}
+
+/******************************************************************************
+ * @brief    Set the file name of the checkpoint file of a node
+ *****************************************************************************/
+void
+set_checkpoint_rank_filename(char  *filename,
+                             size_t rank,
+                             char  *rank_filename)
+{
+    int status;
+
+    status = snprintf(rank_filename, MAXSTRING, "%s.%zu", filename, rank);
+    if (status >= MAXSTRING) {
+        log_err("Checkpoint file name %s.%zu is too large [%d]",
+                filename, rank, status);
+    }
+}
+
+/******************************************************************************
+ * @brief    Check if a state file is a checkpoint (collective)
+ *****************************************************************************/
+bool
+is_checkpoint_file(char *filename)
+{
+    extern MPI_Comm MPI_COMM_VIC;
+    extern int      mpi_rank;
+
+    char            magic[CHECKPOINT_MAGIC_LEN];
+    FILE           *fp;
+    int             is_checkpoint = 0;
+    int             status;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        fp = fopen(filename, "rb");
+        if (fp != NULL) {
+            if (fread(magic, sizeof(magic), 1, fp) == 1 &&
+                memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0) {
+                is_checkpoint = 1;
+            }
+            fclose(fp);
+        }
+    }
+
+    status = MPI_Bcast(&is_checkpoint, 1, MPI_INT, VIC_MPI_ROOT,
+                       MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    return is_checkpoint == 1;
+}
+
+/******************************************************************************
+ * @brief    Set the checkpoint (manifest) file name for a state date
+ *****************************************************************************/
+void
+set_checkpoint_filename(dmy_struct *dmy_state,
+                        char       *filename)
+{
+    extern filenames_struct filenames;
+
+    int                     status;
+
+    status = snprintf(filename, MAXSTRING, "%s.%04i%02i%02i_%05u.ckpt",
+                      filenames.statefile, dmy_state->year,
+                      dmy_state->month, dmy_state->day,
+                      dmy_state->dayseconds);
+    if (status >= MAXSTRING) {
+        log_warn("State file name %s was too large [%d] "
+                 "and is truncated to size [%d]",
+                 filename, status, MAXSTRING);
+    }
+}
+
+/******************************************************************************
+ * @brief    Set the checkpoint cell index of the local cells
+ * @details  Returns the total number of state values of the local cells.
+ *****************************************************************************/
+size_t
+set_checkpoint_index(checkpoint_index_struct *index)
+{
+    extern domain_struct local_domain;
+
+    checkpoint_struct    ckpt;
+    size_t               offset;
+    size_t               nvalues;
+
+    size_t               i;
+
+    ckpt.values = NULL;
+    ckpt.restore = false;
+    offset = sizeof(checkpoint_header_struct) +
+             local_domain.ncells_active * sizeof(*index);
+    nvalues = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        ckpt.nvalues = 0;
+        checkpoint_cell(&ckpt, i);
+        index[i].io_idx = local_domain.locations[i].io_idx;
+        index[i].offset = offset;
+        index[i].nvalues = ckpt.nvalues;
+        offset += ckpt.nvalues * sizeof(*ckpt.values);
+        nvalues += ckpt.nvalues;
+    }
+
+    return nvalues;
+}
+
+/******************************************************************************
+ * @brief    Copy the state of the local cells to a checkpoint buffer
+ *****************************************************************************/
+void
+checkpoint_pack(double *values)
+{
+    extern domain_struct local_domain;
+
+    checkpoint_struct    ckpt;
+
+    size_t               i;
+
+    ckpt.values = values;
+    ckpt.restore = false;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        ckpt.nvalues = 0;
+        checkpoint_cell(&ckpt, i);
+        ckpt.values += ckpt.nvalues;
+    }
+}
+
+/******************************************************************************
+ * @brief    Write the checkpoint file of a node
+ * @details  Holds a header, the cell index (grid index, byte offset and number
+ *           of values per cell) and the state values. Does not use MPI, so it
+ *           can run in a background thread.
+ *****************************************************************************/
+void
+put_checkpoint_file(char                     *rank_filename,
+                    checkpoint_header_struct *header,
+                    checkpoint_index_struct  *index,
+                    double                   *values,
+                    size_t                    nvalues)
+{
+    FILE *fp;
+
+    fp = open_file(rank_filename, "wb");
+
+    if (fwrite(header, sizeof(*header), 1, fp) != 1 ||
+        fwrite(index, sizeof(*index), header->ncells, fp) != header->ncells ||
+        fwrite(values, sizeof(*values), nvalues, fp) != nvalues) {
+        log_err("Error writing checkpoint %s", rank_filename);
+    }
+
+    if (fclose(fp) != 0) {
+        log_err("Error closing checkpoint %s", rank_filename);
+    }
+}
+
+/******************************************************************************
+ * @brief    Write the checkpoint manifest (collective)
+ * @details  Must be called once the checkpoint files of all nodes are
+ *           complete; a checkpoint without manifest is never restored.
+ *****************************************************************************/
+void
+put_checkpoint_manifest(char       *filename,
+                        dmy_struct *dmy_state)
+{
+    extern domain_struct local_domain;
+    extern MPI_Comm      MPI_COMM_VIC;
+    extern int           mpi_rank;
+    extern int           mpi_size;
+
+    checkpoint_header_struct header;
+    FILE                    *fp;
+    size_t                   ncells;
+    size_t                  *rank_ncells = NULL;
+    int                      status;
+
+    size_t                   i;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        rank_ncells = malloc(mpi_size * sizeof(*rank_ncells));
+        check_alloc_status(rank_ncells, "Memory allocation error");
+    }
+    ncells = local_domain.ncells_active;
+    status = MPI_Gather(&ncells, 1, MPI_AINT, rank_ncells, 1, MPI_AINT,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        ncells = 0;
+        for (i = 0; i < (size_t) mpi_size; i++) {
+            ncells += rank_ncells[i];
+        }
+        set_checkpoint_header(&header, dmy_state, ncells);
+        header.nfiles = (size_t) mpi_size;
+
+        fp = open_file(filename, "wb");
+        if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+            fwrite(rank_ncells, sizeof(*rank_ncells), mpi_size, fp) !=
+            (size_t) mpi_size) {
+            log_err("Error writing checkpoint %s", filename);
+        }
+        if (fclose(fp) != 0) {
+            log_err("Error closing checkpoint %s", filename);
+        }
+
+        free(rank_ncells);
+    }
+}
+
+/******************************************************************************
+ * @brief    Remove a checkpoint (collective)
+ * @details  The manifest is removed first, so a partly removed checkpoint is
+ *           never restored.
+ *****************************************************************************/
+void
+remove_checkpoint(char *filename)
+{
+    extern MPI_Comm MPI_COMM_VIC;
+    extern int      mpi_rank;
+
+    char            rank_filename[MAXSTRING];
+    int             status;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        if (remove(filename) != 0) {
+            log_warn("Could not remove checkpoint %s", filename);
+        }
+    }
+    status = MPI_Barrier(MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    set_checkpoint_rank_filename(filename, (size_t) mpi_rank, rank_filename);
+    if (remove(rank_filename) != 0) {
+        log_warn("Could not remove checkpoint %s", rank_filename);
+    }
+}
+
+/******************************************************************************
+ * @brief    Write the model state as a checkpoint
+ * @details  Every node writes its own checkpoint file <filename>.<node>; the
+ *           master node writes the manifest <filename> once all node files
+ *           are complete.
+ *****************************************************************************/
+void
+vic_store_checkpoint(dmy_struct *dmy_state,
+                     char       *filename)
+{
+    extern domain_struct     local_domain;
+    extern int               mpi_rank;
+
+    checkpoint_header_struct header;
+    checkpoint_index_struct *index;
+    char                     rank_filename[MAXSTRING];
+    double                  *values;
+    size_t                   nvalues;
+
+    set_checkpoint_filename(dmy_state, filename);
+    set_checkpoint_rank_filename(filename, (size_t) mpi_rank, rank_filename);
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        debug("writing checkpoint: %s", filename);
+    }
+
+    index = malloc((local_domain.ncells_active + 1) * sizeof(*index));
+    check_alloc_status(index, "Memory allocation error");
+    nvalues = set_checkpoint_index(index);
+
+    values = malloc((nvalues + 1) * sizeof(*values));
+    check_alloc_status(values, "Memory allocation error");
+    checkpoint_pack(values);
+
+    set_checkpoint_header(&header, dmy_state, local_domain.ncells_active);
+    put_checkpoint_file(rank_filename, &header, index, values, nvalues);
+
+    put_checkpoint_manifest(filename, dmy_state);
+
+    free(values);
+    free(index);
+}
+
+/******************************************************************************
+ * @brief    Restore the model state from a checkpoint
+ * @details  The master node reads the cell index of all node files and
+ *           scatters the location of every cell to the node that runs it.
+ *           Every node then reads its cells, in file and offset order.
+ *****************************************************************************/
+void
+vic_restore_checkpoint(void)
+{
+    extern filenames_struct filenames;
+    extern domain_struct    global_domain;
+    extern domain_struct    local_domain;
+    extern size_t          *filter_active_cells;
+    extern size_t          *mpi_map_mapping_array;
+    extern int             *mpi_map_local_array_sizes;
+    extern int             *mpi_map_global_array_offsets;
+    extern MPI_Comm         MPI_COMM_VIC;
+    extern int              mpi_rank;
+
+    checkpoint_struct        ckpt;
+    checkpoint_header_struct header;
+    checkpoint_index_struct  entry;
+    checkpoint_index_struct *cells = NULL;
+    checkpoint_index_struct *cells_mapped = NULL;
+    checkpoint_index_struct *local_cells;
+    char                     rank_filename[MAXSTRING];
+    FILE                    *fp = NULL;
+    size_t                  *active_idx = NULL;
+    size_t                  *rank_ncells = NULL;
+    size_t                  *order;
+    size_t                  *key;
+    size_t                   nfiles = 0;
+    size_t                   nfound;
+    size_t                   nskipped;
+    size_t                   max_nvalues;
+    size_t                   iFile;
+    size_t                   iCell;
+    MPI_Datatype             mpi_index_type;
+    int                      status;
+
+    size_t                   i;
+    size_t                   j;
+
+    status = MPI_Type_contiguous(3, MPI_AINT, &mpi_index_type);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Type_commit(&mpi_index_type);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        debug("reading checkpoint: %s", filenames.init_state.nc_filename);
+
+        // manifest
+        fp = open_file(filenames.init_state.nc_filename, "rb");
+        get_checkpoint_header(fp, filenames.init_state.nc_filename, &header);
+        nfiles = header.nfiles;
+        rank_ncells = malloc((nfiles + 1) * sizeof(*rank_ncells));
+        check_alloc_status(rank_ncells, "Memory allocation error");
+        if (fread(rank_ncells, sizeof(*rank_ncells), nfiles, fp) != nfiles) {
+            log_err("Error reading checkpoint %s",
+                    filenames.init_state.nc_filename);
+        }
+        fclose(fp);
+
+        // active cell of each grid cell
+        active_idx = malloc(global_domain.ncells_total * sizeof(*active_idx));
+        check_alloc_status(active_idx, "Memory allocation error");
+        for (i = 0; i < global_domain.ncells_total; i++) {
+            active_idx[i] = global_domain.ncells_active;
+        }
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            active_idx[filter_active_cells[i]] = i;
+        }
+
+        // location of every active cell, the file is stored as offset
+        // of the cell index entry
+        cells = malloc((global_domain.ncells_active + 1) * sizeof(*cells));
+        check_alloc_status(cells, "Memory allocation error");
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            cells[i].io_idx = nfiles;
+        }
+
+        nfound = 0;
+        nskipped = 0;
+        for (iFile = 0; iFile < nfiles; iFile++) {
+            set_checkpoint_rank_filename(filenames.init_state.nc_filename,
+                                         iFile, rank_filename);
+            fp = open_file(rank_filename, "rb");
+            get_checkpoint_header(fp, rank_filename, &header);
+            if (header.ncells != rank_ncells[iFile]) {
+                log_err("Number of cells in %s does not match the manifest",
+                        rank_filename);
+            }
+            for (j = 0; j < header.ncells; j++) {
+                if (fread(&entry, sizeof(entry), 1, fp) != 1) {
+                    log_err("Error reading checkpoint %s", rank_filename);
+                }
+                if (entry.io_idx >= global_domain.ncells_total ||
+                    active_idx[entry.io_idx] == global_domain.ncells_active) {
+                    nskipped++;
+                    continue;
+                }
+                iCell = active_idx[entry.io_idx];
+                if (cells[iCell].io_idx == nfiles) {
+                    nfound++;
+                }
+                cells[iCell].io_idx = iFile;
+                cells[iCell].offset = entry.offset;
+                cells[iCell].nvalues = entry.nvalues;
+            }
+            fclose(fp);
+        }
+        fp = NULL;
+
+        if (nskipped > 0) {
+            log_warn("%zu cells in checkpoint %s are not active in the "
+                     "domain; their state is ignored", nskipped,
+                     filenames.init_state.nc_filename);
+        }
+        if (nfound != global_domain.ncells_active) {
+            log_err("No state found in checkpoint %s for %zu active cells",
+                    filenames.init_state.nc_filename,
+                    global_domain.ncells_active - nfound);
+        }
+
+        // map to prepare for MPI_Scatterv
+        cells_mapped =
+            malloc((global_domain.ncells_active + 1) * sizeof(*cells_mapped));
+        check_alloc_status(cells_mapped, "Memory allocation error");
+        map(sizeof(*cells), global_domain.ncells_active, mpi_map_mapping_array,
+            NULL, cells, cells_mapped);
+
+        free(active_idx);
+        free(rank_ncells);
+        free(cells);
+    }
+
+    status = MPI_Bcast(&nfiles, 1, MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    local_cells = malloc((local_domain.ncells_active + 1) *
+                         sizeof(*local_cells));
+    check_alloc_status(local_cells, "Memory allocation error");
+    status = MPI_Scatterv(cells_mapped, mpi_map_local_array_sizes,
+                          mpi_map_global_array_offsets, mpi_index_type,
+                          local_cells, local_domain.ncells_active,
+                          mpi_index_type, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        free(cells_mapped);
+    }
+    MPI_Type_free(&mpi_index_type);
+
+    // read the cells by file (stable, so in offset order for each file if
+    // the decomposition did not change)
+    order = malloc((local_domain.ncells_active + 1) * sizeof(*order));
+    check_alloc_status(order, "Memory allocation error");
+    key = malloc((local_domain.ncells_active + 1) * sizeof(*key));
+    check_alloc_status(key, "Memory allocation error");
+    max_nvalues = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        order[i] = i;
+        key[i] = local_cells[i].io_idx;
+        max_nvalues = max(max_nvalues, local_cells[i].nvalues);
+    }
+    if (local_domain.ncells_active > 0) {
+        size_t_counting_sort(order, key, nfiles, local_domain.ncells_active);
+    }
+
+    ckpt.values = malloc((max_nvalues + 1) * sizeof(*ckpt.values));
+    check_alloc_status(ckpt.values, "Memory allocation error");
+    ckpt.restore = true;
+
+    iFile = nfiles;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        iCell = order[i];
+        if (local_cells[iCell].io_idx != iFile) {
+            if (fp != NULL) {
+                fclose(fp);
+            }
+            iFile = local_cells[iCell].io_idx;
+            set_checkpoint_rank_filename(filenames.init_state.nc_filename,
+                                         iFile, rank_filename);
+            fp = open_file(rank_filename, "rb");
+        }
+
+        if (fseek(fp, (long) local_cells[iCell].offset, SEEK_SET) != 0 ||
+            fread(ckpt.values, sizeof(*ckpt.values),
+                  local_cells[iCell].nvalues, fp) !=
+            local_cells[iCell].nvalues) {
+            log_err("Error reading cell %zu from checkpoint %s",
+                    local_domain.locations[iCell].io_idx, rank_filename);
+        }
+
+        ckpt.nvalues = 0;
+        checkpoint_cell(&ckpt, iCell);
+        if (ckpt.nvalues != local_cells[iCell].nvalues) {
+            log_err("Cell %zu in checkpoint %s has %zu state values, "
+                    "expected %zu", local_domain.locations[iCell].io_idx,
+                    rank_filename, local_cells[iCell].nvalues, ckpt.nvalues);
+        }
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+
+    free(ckpt.values);
+    free(order);
+    free(key);
+    free(local_cells);
+}
@@ -35,13 +35,16 @@ vic_finalize(void)
     extern size_t             *filter_active_cells;
     extern size_t             *mpi_map_mapping_array;
     extern all_vars_struct    *all_vars;
+    extern double             *cell_cost;
     extern force_data_struct  *force;
     extern domain_struct       global_domain;
     extern domain_struct       local_domain;
+    extern filenames_struct    filenames;
     extern filep_struct        filep;
     extern int                *mpi_map_local_array_sizes;
     extern int                *mpi_map_global_array_offsets;
     extern int                 mpi_rank;
+    extern mpi_slab_struct     mpi_local_slab;
     extern nc_file_struct     *nc_hist_files;
     extern option_struct       options;
     extern double           ***out_data;
@@ -61,8 +64,24 @@ vic_finalize(void)
 
     size_t                     i;
     size_t                     j;
+    size_t                     ntiles;
     int                        status;
 
+    // write out the history data that is still in flight
+    hist_writer_flush();
+    hist_writer_finalize();
+
+    // complete the state snapshot that is still in flight
+    snapshot_writer_finalize();
+
+    // collect the counters of the instrumented regions for the timing table,
+    // all background threads have finished
+    gather_instrument_records();
+
+    // write the measured cost for the decomposition of a next run
+    if (strcasecmp(filenames.decomp_out, "MISSING") != 0) {
+        put_decomp_cost();
+    }
 
     if (mpi_rank == VIC_MPI_ROOT) {
         // close the global parameter file
@@ -79,8 +98,9 @@ vic_finalize(void)
         free(nc_hist_files);
     }
 
+    ntiles = 0;
     for (i = 0; i < local_domain.ncells_active; i++) {
-        free_force(&(force[i]));
+        ntiles += veg_con_map[i].nv_active;
         free(soil_con[i].AreaFract);
         free(soil_con[i].BandElev);
         free(soil_con[i].Tfactor);
@@ -94,7 +114,6 @@ vic_finalize(void)
             }
             free_veg_hist(&(veg_hist[i][j]));
         }
-        free_all_vars(&(all_vars[i]), veg_con_map[i].nv_active - options.Nbare);
         free(veg_con_map[i].vidx);
         free(veg_con_map[i].Cv);
         free(veg_con[i]);
@@ -102,6 +121,12 @@ vic_finalize(void)
         free(veg_lib[i]);
     }
 
+    // all_vars share one arena, see vic_alloc()
+    if (ntiles > 0) {
+        free_all_vars(&(all_vars[0]), (int) (ntiles - options.Nbare));
+    }
+    free_force(force, local_domain.ncells_active);
+
     free_streams(&output_streams);
     free_out_data(local_domain.ncells_active, out_data);
     free(force);
@@ -112,7 +137,9 @@ vic_finalize(void)
     free(veg_lib);
     free(all_vars);
     free(save_data);
+    free(cell_cost);
     free(local_domain.locations);
+    free(mpi_local_slab.slab_idx);
     if (mpi_rank == VIC_MPI_ROOT) {
         free(filter_active_cells);
         free(global_domain.locations);
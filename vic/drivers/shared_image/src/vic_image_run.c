@@ -35,6 +35,7 @@ vic_image_run(dmy_struct *dmy_current)
 {
     extern size_t              current;
     extern all_vars_struct    *all_vars;
+    extern double             *cell_cost;
     extern force_data_struct  *force;
     extern domain_struct       local_domain;
     extern option_struct       options;
@@ -68,18 +69,27 @@ vic_image_run(dmy_struct *dmy_current)
 
         update_step_vars(&(all_vars[i]), veg_con[i], veg_hist[i]);
 
-        timer_start(&timer);
+        // CPU time of this thread only, the process CPU time would include
+        // the cells run by the other threads
+        timer_start_thread(&timer);
+        INSTRUMENT_BEGIN(INSTR_VIC_RUN);
         vic_run(&(force[i]), &(all_vars[i]), dmy_current, &global_param,
                 &lake_con, &(soil_con[i]), veg_con[i], veg_lib[i]);
-        timer_stop(&timer);
+        INSTRUMENT_END(INSTR_VIC_RUN);
+        timer_stop_thread(&timer);
+        cell_cost[i] += timer.delta_wall;
 
+        INSTRUMENT_BEGIN(INSTR_PUT_DATA);
         put_data(&(all_vars[i]), &(force[i]), &(soil_con[i]), veg_con[i],
                  veg_lib[i], &lake_con, out_data[i], &(save_data[i]),
                  &timer);
+        INSTRUMENT_END(INSTR_PUT_DATA);
     }
 
+    INSTRUMENT_BEGIN(INSTR_PLUGIN);
     plugin_run();
     plugin_put_data_all();
+    INSTRUMENT_END(INSTR_PLUGIN);
 
     for (i = 0; i < options.Noutstreams; i++) {
         agg_stream_data(&(output_streams[i]), dmy_current, out_data);
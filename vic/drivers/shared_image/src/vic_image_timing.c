@@ -169,8 +169,244 @@ write_vic_timing_table(timer_struct *timers,
             "|------------|----------------------|----------------------|----------------------|----------------------|\n");
     fprintf(LOG_DEST, "\n");
 
+    write_instrument_table();
+    write_instrument_report();
+
     fprintf(LOG_DEST,
             "\n------------------------------"
             " END VIC TIMING PROFILE "
             "------------------------------\n\n");
 }
+
+/******************************************************************************
+ * @brief    Gather the counters of the instrumented regions of all threads
+ *           and nodes to the master node
+ * @details  Collective. Only counters of regions that were entered are sent,
+ *           one record per node, thread, parent region and region.
+ *****************************************************************************/
+void
+gather_instrument_records(void)
+{
+    extern instrument_struct  instrument;
+    extern MPI_Comm           MPI_COMM_VIC;
+    extern int                mpi_rank;
+    extern int                mpi_size;
+
+    instrument_record_struct *records = NULL;
+    instrument_stat_struct   *stat;
+    MPI_Datatype              mpi_record_type;
+    int                       nrecords;
+    int                      *recv_sizes = NULL;
+    int                      *recv_offsets = NULL;
+    int                       status;
+    int                       i;
+    size_t                    t;
+    size_t                    p;
+    size_t                    r;
+
+    nrecords = 0;
+    for (t = 0; t < instrument_nthreads(); t++) {
+        for (p = 0; p <= N_INSTR_REGIONS; p++) {
+            for (r = 0; r < N_INSTR_REGIONS; r++) {
+                if (instrument.threads[t].stat[p][r].count > 0) {
+                    nrecords++;
+                }
+            }
+        }
+    }
+
+    // allocate at least one element, nodes without records still have to
+    // pass a valid buffer
+    records = malloc((nrecords + 1) * sizeof(*records));
+    check_alloc_status(records, "Memory allocation error.");
+
+    i = 0;
+    for (t = 0; t < instrument_nthreads(); t++) {
+        for (p = 0; p <= N_INSTR_REGIONS; p++) {
+            for (r = 0; r < N_INSTR_REGIONS; r++) {
+                stat = &(instrument.threads[t].stat[p][r]);
+                if (stat->count > 0) {
+                    records[i].rank = mpi_rank;
+                    records[i].thread = (int) t;
+                    records[i].parent = (int) p;
+                    records[i].region = (int) r;
+                    records[i].count = stat->count;
+                    records[i].total = stat->total;
+                    records[i].self = stat->self;
+                    records[i].min = stat->min;
+                    records[i].max = stat->max;
+                    i++;
+                }
+            }
+        }
+    }
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        recv_sizes = malloc(mpi_size * sizeof(*recv_sizes));
+        check_alloc_status(recv_sizes, "Memory allocation error.");
+        recv_offsets = malloc(mpi_size * sizeof(*recv_offsets));
+        check_alloc_status(recv_offsets, "Memory allocation error.");
+    }
+
+    status = MPI_Gather(&nrecords, 1, MPI_INT, recv_sizes, 1, MPI_INT,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        instrument.nrecords = 0;
+        for (i = 0; i < mpi_size; i++) {
+            recv_offsets[i] = (int) instrument.nrecords;
+            instrument.nrecords += recv_sizes[i];
+        }
+        instrument.records = malloc((instrument.nrecords + 1) *
+                                    sizeof(*(instrument.records)));
+        check_alloc_status(instrument.records, "Memory allocation error.");
+    }
+
+    create_MPI_instrument_record_type(&mpi_record_type);
+    status = MPI_Gatherv(records, nrecords, mpi_record_type,
+                         instrument.records, recv_sizes, recv_offsets,
+                         mpi_record_type, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    MPI_Type_free(&mpi_record_type);
+
+    free(records);
+    free(recv_sizes);
+    free(recv_offsets);
+}
+
+/******************************************************************************
+ * @brief    Write the instrumented regions to the timing table
+ * @details  Per region: number of calls and inclusive and exclusive time
+ *           summed over all threads and nodes, and the minimum, mean and
+ *           maximum over the threads that entered the region of the inclusive
+ *           time per thread. Calls of a region nested in itself are not added
+ *           to the inclusive time again.
+ *****************************************************************************/
+void
+write_instrument_table(void)
+{
+    extern FILE              *LOG_DEST;
+    extern instrument_struct  instrument;
+
+    instrument_record_struct *rec;
+    char                      region_str[MAXSTRING];
+    size_t                    count;
+    size_t                    nthreads;
+    size_t                    i;
+    int                       r;
+    bool                      found;
+    double                    total;
+    double                    self;
+    double                    thread_total;
+    double                    thread_min;
+    double                    thread_max;
+
+    if (instrument.nrecords == 0) {
+        return;
+    }
+
+    fprintf(LOG_DEST, "  Instrumented Regions:\n");
+    fprintf(LOG_DEST,
+            "|-----------------|--------------|--------------|--------------|--------------|--------------|--------------|\n");
+    fprintf(LOG_DEST,
+            "| Region          | Calls        | Total (secs) | Self (secs)  | Thread Min   | Thread Mean  | Thread Max   |\n");
+    fprintf(LOG_DEST,
+            "|-----------------|--------------|--------------|--------------|--------------|--------------|--------------|\n");
+
+    for (r = 0; r < N_INSTR_REGIONS; r++) {
+        count = 0;
+        total = 0.;
+        self = 0.;
+        nthreads = 0;
+        thread_min = 0.;
+        thread_max = 0.;
+        thread_total = 0.;
+        found = false;
+
+        // the records of a thread are contiguous
+        for (i = 0; i < instrument.nrecords; i++) {
+            rec = &(instrument.records[i]);
+            if (rec->region == r) {
+                found = true;
+                count += rec->count;
+                self += rec->self;
+                if (rec->parent != r) {
+                    total += rec->total;
+                    thread_total += rec->total;
+                }
+            }
+            if (i + 1 == instrument.nrecords ||
+                instrument.records[i + 1].rank != rec->rank ||
+                instrument.records[i + 1].thread != rec->thread) {
+                if (found) {
+                    if (nthreads == 0 || thread_total < thread_min) {
+                        thread_min = thread_total;
+                    }
+                    if (thread_total > thread_max) {
+                        thread_max = thread_total;
+                    }
+                    nthreads++;
+                }
+                thread_total = 0.;
+                found = false;
+            }
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        str_from_instrument_region(r, region_str);
+        fprintf(LOG_DEST,
+                "| %-15s | %12zu | %12g | %12g | %12g | %12g | %12g |\n",
+                region_str, count, total, self, thread_min,
+                total / nthreads, thread_max);
+    }
+
+    fprintf(LOG_DEST,
+            "|-----------------|--------------|--------------|--------------|--------------|--------------|--------------|\n");
+    fprintf(LOG_DEST, "\n");
+}
+
+/******************************************************************************
+ * @brief    Write the counters of the instrumented regions of all threads and
+ *           nodes to the TIMING_REPORT file
+ * @details  CSV with one line per node, thread, parent region and region.
+ *****************************************************************************/
+void
+write_instrument_report(void)
+{
+    extern filenames_struct   filenames;
+    extern instrument_struct  instrument;
+
+    instrument_record_struct *rec;
+    FILE                     *fp;
+    char                      parent_str[MAXSTRING];
+    char                      region_str[MAXSTRING];
+    size_t                    i;
+
+    if (strcasecmp(filenames.timing_report, "MISSING") == 0) {
+        return;
+    }
+
+    fp = fopen(filenames.timing_report, "w");
+    if (fp == NULL) {
+        log_warn("Unable to open the timing report %s",
+                 filenames.timing_report);
+        return;
+    }
+
+    fprintf(fp, "rank,thread,parent,region,count,total,self,mean,min,max\n");
+    for (i = 0; i < instrument.nrecords; i++) {
+        rec = &(instrument.records[i]);
+        str_from_instrument_region(rec->parent, parent_str);
+        str_from_instrument_region(rec->region, region_str);
+        fprintf(fp, "%d,%d,%s,%s,%zu,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+                rec->rank, rec->thread, parent_str, region_str, rec->count,
+                rec->total, rec->self, rec->total / rec->count, rec->min,
+                rec->max);
+    }
+
+    fclose(fp);
+}
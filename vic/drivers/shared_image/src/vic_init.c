@@ -27,13 +27,16 @@
 #include <vic_driver_shared_image.h>
 
 /******************************************************************************
- * @brief    Initialize model parameters
+ * @brief    Read the soil and vegetation parameters
+ * @details  Fills soil_con, veg_lib, veg_con and veg_con_map from the
+ *           parameter file and computes the derived parameters. Variables
+ *           with leading dimensions (vegetation type, month, root zone, soil
+ *           layer or snow band) are read as one hyperslab and scattered at
+ *           once, instead of one 2D slice at a time.
  *****************************************************************************/
 void
-vic_init(void)
+vic_init_params(void)
 {
-    extern all_vars_struct    *all_vars;
-    extern size_t              current;
     extern domain_struct       global_domain;
     extern domain_struct       local_domain;
     extern option_struct       options;
@@ -42,9 +45,7 @@ vic_init(void)
     extern veg_con_map_struct *veg_con_map;
     extern veg_con_struct    **veg_con;
     extern veg_lib_struct    **veg_lib;
-    extern lake_con_struct    *lake_con;
     extern parameters_struct   param;
-    extern int                 mpi_rank;
 
     bool                       found;
     char                       locstr[MAXSTRING];
@@ -53,14 +54,15 @@ vic_init(void)
     double                    *Cv_sum = NULL;
     double                    *dvar = NULL;
     int                       *ivar = NULL;
-    int                        status;
     size_t                     i;
     size_t                     j;
     size_t                     k;
     size_t                     m;
     size_t                     nveg;
-    size_t                     max_numnod;
     size_t                     Nnodes;
+    size_t                     ncells;
+    size_t                     nlead;
+    size_t                     idx;
     int                        vidx;
     size_t                     d2count[2];
     size_t                     d2start[2];
@@ -68,23 +70,35 @@ vic_init(void)
     size_t                     d3start[3];
     size_t                     d4count[4];
     size_t                     d4start[4];
-    int                        tmp_lake_idx;
     double                     Zsum, dp;
     double                     tmpdp, tmpadj, Bexp;
 
+    ncells = local_domain.ncells_active;
+
     // allocate memory for Cv_sum
-    Cv_sum = malloc(local_domain.ncells_active * sizeof(*Cv_sum));
+    Cv_sum = malloc(ncells * sizeof(*Cv_sum));
     check_alloc_status(Cv_sum, "Memory allocation error.");
 
-    // allocate memory for variables to be read
-    dvar = malloc(local_domain.ncells_active * sizeof(*dvar));
+    // allocate memory for variables to be read, large enough for all
+    // leading dimensions of a variable
+    nlead = options.NVEGTYPES * MONTHS_PER_YEAR;
+    if (options.NVEGTYPES * options.ROOT_ZONES > nlead) {
+        nlead = options.NVEGTYPES * options.ROOT_ZONES;
+    }
+    if (options.Nlayer > nlead) {
+        nlead = options.Nlayer;
+    }
+    if (options.SNOW_BAND > nlead) {
+        nlead = options.SNOW_BAND;
+    }
+    dvar = malloc(nlead * ncells * sizeof(*dvar));
     check_alloc_status(dvar, "Memory allocation error.");
-    ivar = malloc(local_domain.ncells_active * sizeof(*ivar));
+    ivar = malloc(nlead * ncells * sizeof(*ivar));
     check_alloc_status(ivar, "Memory allocation error.");
 
-    // The method used to convert the NetCDF fields to VIC structures for
-    // individual grid cells is to read a 2D slice and then loop over the
-    // domain cells to assign the values to the VIC structures
+    // The NetCDF fields are read as a hyperslab that holds all leading
+    // dimensions, the count of the leading dimensions is set for each
+    // variable. The result is stored as [leading dimensions][local cells].
 
     d2start[0] = 0;
     d2start[1] = 0;
@@ -107,9 +121,6 @@ vic_init(void)
     d4count[2] = global_domain.n_ny;
     d4count[3] = global_domain.n_nx;
 
-    // start the clock
-    current = 0;
-
     // read_veglib()
 
     // Assign veg class ids
@@ -123,62 +134,62 @@ vic_init(void)
     }
 
     // overstory
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_int(&(filenames.params), "overstory", 3,
+                            d3start, d3count, ivar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_int(&(filenames.params), "overstory",
-                                 d3start, d3count, ivar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].overstory = ivar[i];
+            veg_lib[i][j].overstory = ivar[j * ncells + i];
         }
     }
 
     // rarc
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "rarc", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "rarc",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].rarc = (double) dvar[i];
+            veg_lib[i][j].rarc = (double) dvar[j * ncells + i];
         }
     }
 
     // rmin
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "rmin", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "rmin",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].rmin = (double) dvar[i];
+            veg_lib[i][j].rmin = (double) dvar[j * ncells + i];
         }
     }
 
     // wind height
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "wind_h", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "wind_h",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].wind_h = (double) dvar[i];
+            veg_lib[i][j].wind_h = (double) dvar[j * ncells + i];
         }
     }
 
     // RGL
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "RGL", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "RGL",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].RGL = (double)dvar[i];
+            veg_lib[i][j].RGL = (double)dvar[j * ncells + i];
         }
     }
 
     // rad_atten
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "rad_atten", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "rad_atten",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].rad_atten = (double) dvar[i];
+            veg_lib[i][j].rad_atten = (double) dvar[j * ncells + i];
         }
     }
 
@@ -189,46 +200,47 @@ vic_init(void)
         }
     }
     if (options.BCO2_SRC == FROM_VEGLIB || options.BCO2_SRC == FROM_VEGPARAM) {
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "b_co2", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "b_co2",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].b_co2 = (double) dvar[i];
+                veg_lib[i][j].b_co2 = (double) dvar[j * ncells + i];
             }
         }
     }
 
     // wind_atten
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "wind_atten", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "wind_atten",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].wind_atten = (double) dvar[i];
+            veg_lib[i][j].wind_atten = (double) dvar[j * ncells + i];
         }
     }
 
     // trunk_ratio
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "trunk_ratio", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "trunk_ratio",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_lib[i][j].trunk_ratio = (double) dvar[i];
+            veg_lib[i][j].trunk_ratio = (double) dvar[j * ncells + i];
         }
     }
 
     // LAI and Wdmax
     if (options.LAI_SRC == FROM_VEGLIB || options.LAI_SRC == FROM_VEGPARAM) {
+        d4count[0] = options.NVEGTYPES;
+        d4count[1] = MONTHS_PER_YEAR;
+        get_scatter_nc_slab_double(&(filenames.params), "LAI", 4,
+                                   d4start, d4count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d4start[0] = j;
             for (k = 0; k < MONTHS_PER_YEAR; k++) {
-                d4start[1] = k;
-                get_scatter_nc_field_double(&(filenames.params), "LAI",
-                                            d4start, d4count, dvar);
+                idx = (j * MONTHS_PER_YEAR + k) * ncells;
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    veg_lib[i][j].LAI[k] = (double) dvar[i];
+                    veg_lib[i][j].LAI[k] = (double) dvar[idx + i];
                     veg_lib[i][j].Wdmax[k] = param.VEG_LAI_WATER_FACTOR *
                                              veg_lib[i][j].LAI[k];
                 }
@@ -238,46 +250,55 @@ vic_init(void)
 
     // albedo
     if (options.ALB_SRC == FROM_VEGLIB || options.ALB_SRC == FROM_VEGPARAM) {
+        d4count[0] = options.NVEGTYPES;
+        d4count[1] = MONTHS_PER_YEAR;
+        get_scatter_nc_slab_double(&(filenames.params), "albedo", 4,
+                                   d4start, d4count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d4start[0] = j;
             for (k = 0; k < MONTHS_PER_YEAR; k++) {
-                d4start[1] = k;
-                get_scatter_nc_field_double(&(filenames.params), "albedo",
-                                            d4start, d4count, dvar);
+                idx = (j * MONTHS_PER_YEAR + k) * ncells;
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    veg_lib[i][j].albedo[k] = (double) dvar[i];
+                    veg_lib[i][j].albedo[k] = (double) dvar[idx + i];
                 }
             }
         }
     }
 
     // veg_rough
+    d4count[0] = options.NVEGTYPES;
+    d4count[1] = MONTHS_PER_YEAR;
+    get_scatter_nc_slab_double(&(filenames.params), "veg_rough", 4,
+                               d4start, d4count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d4start[0] = j;
         for (k = 0; k < MONTHS_PER_YEAR; k++) {
-            d4start[1] = k;
-            get_scatter_nc_field_double(&(filenames.params), "veg_rough",
-                                        d4start, d4count, dvar);
+            idx = (j * MONTHS_PER_YEAR + k) * ncells;
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].roughness[k] = (double) dvar[i];
+                veg_lib[i][j].roughness[k] = (double) dvar[idx + i];
             }
         }
     }
 
     // displacement
+    d4count[0] = options.NVEGTYPES;
+    d4count[1] = MONTHS_PER_YEAR;
+    get_scatter_nc_slab_double(&(filenames.params), "displacement", 4,
+                               d4start, d4count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d4start[0] = j;
         for (k = 0; k < MONTHS_PER_YEAR; k++) {
-            d4start[1] = k;
-            get_scatter_nc_field_double(&(filenames.params), "displacement",
-                                        d4start, d4count, dvar);
+            idx = (j * MONTHS_PER_YEAR + k) * ncells;
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].displacement[k] = (double) dvar[i];
+                veg_lib[i][j].displacement[k] = (double) dvar[idx + i];
             }
         }
     }
 
     // default value for fcanopy
+    if (options.FCAN_SRC == FROM_VEGLIB || options.FCAN_SRC == FROM_VEGPARAM) {
+        d4count[0] = options.NVEGTYPES;
+        d4count[1] = MONTHS_PER_YEAR;
+        get_scatter_nc_slab_double(&(filenames.params), "fcanopy", 4,
+                                   d4start, d4count, dvar);
+    }
     for (j = 0; j < options.NVEGTYPES; j++) {
         if (options.FCAN_SRC == FROM_DEFAULT) {
             for (k = 0; k < MONTHS_PER_YEAR; k++) {
@@ -294,13 +315,10 @@ vic_init(void)
         }
         else if (options.FCAN_SRC == FROM_VEGLIB ||
                  options.FCAN_SRC == FROM_VEGPARAM) {
-            d4start[0] = j;
             for (k = 0; k < MONTHS_PER_YEAR; k++) {
-                d4start[1] = k;
-                get_scatter_nc_field_double(&(filenames.params), "fcanopy",
-                                            d4start, d4count, dvar);
+                idx = (j * MONTHS_PER_YEAR + k) * ncells;
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    veg_lib[i][j].fcanopy[k] = (double) dvar[i];
+                    veg_lib[i][j].fcanopy[k] = (double) dvar[idx + i];
                 }
             }
         }
@@ -309,12 +327,12 @@ vic_init(void)
     // read carbon cycle parameters
     if (options.CARBON) {
         // Ctype
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_int(&(filenames.params), "Ctype", 3,
+                                d3start, d3count, ivar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_int(&(filenames.params), "Ctype",
-                                     d3start, d3count, ivar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].Ctype = ivar[i];
+                veg_lib[i][j].Ctype = ivar[j * ncells + i];
                 if (veg_lib[i][j].Ctype != PHOTO_C3 &&
                     veg_lib[i][j].Ctype != PHOTO_C4) {
                     log_err("cell %zu veg %zu: Ctype is %d but "
@@ -325,12 +343,12 @@ vic_init(void)
             }
         }
         // MaxCarboxRate
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "MaxCarboxRate", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "MaxCarboxRate",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].MaxCarboxRate = (double) dvar[i];
+                veg_lib[i][j].MaxCarboxRate = (double) dvar[j * ncells + i];
                 if (veg_lib[i][j].MaxCarboxRate < 0) {
                     log_err("cell %zu veg %zu: MaxCarboxRate is %f "
                             "but must be >= 0.",
@@ -339,32 +357,33 @@ vic_init(void)
             }
         }
         // MaxETransport or CO2Specificity
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "MaxiE_or_CO2Spec", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "MaxiE_or_CO2Spec",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                if (dvar[i] < 0) {
+                if (dvar[j * ncells + i] < 0) {
                     log_err("cell %zu veg %zu: MaxE_of_CO2Spec is %f "
-                            "but must be >= 0.", i, j, dvar[i]);
+                            "but must be >= 0.", i, j, dvar[j * ncells + i]);
                 }
                 if (veg_lib[i][j].Ctype == PHOTO_C3) {
-                    veg_lib[i][j].MaxCarboxRate = (double) dvar[i];
+                    veg_lib[i][j].MaxCarboxRate = (double) dvar[j * ncells + i];
                     veg_lib[i][j].CO2Specificity = 0;
                 }
                 else if (veg_lib[i][j].Ctype == PHOTO_C4) {
                     veg_lib[i][j].MaxCarboxRate = 0;
-                    veg_lib[i][j].CO2Specificity = (double) dvar[i];
+                    veg_lib[i][j].CO2Specificity =
+                        (double) dvar[j * ncells + i];
                 }
             }
         }
         // LightUseEff
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "LUE", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "LUE",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].LightUseEff = (double) dvar[i];
+                veg_lib[i][j].LightUseEff = (double) dvar[j * ncells + i];
                 if (veg_lib[i][j].LightUseEff < 0 ||
                     veg_lib[i][j].LightUseEff > 1) {
                     log_err("cell %zu veg %zu: LightUseEff is %f "
@@ -374,12 +393,12 @@ vic_init(void)
             }
         }
         // Nscale flag
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_int(&(filenames.params), "Nscale", 3,
+                                d3start, d3count, ivar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_int(&(filenames.params), "Nscale",
-                                     d3start, d3count, ivar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].NscaleFlag = ivar[i];
+                veg_lib[i][j].NscaleFlag = ivar[j * ncells + i];
                 if (veg_lib[i][j].NscaleFlag != 0 &&
                     veg_lib[i][j].NscaleFlag != 1) {
                     log_err("cell %zu veg %zu: NscaleFlag is %d but "
@@ -389,12 +408,12 @@ vic_init(void)
             }
         }
         // Wnpp_inhib
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "Wnpp_inhib", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "Wnpp_inhib",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].Wnpp_inhib = (double) dvar[i];
+                veg_lib[i][j].Wnpp_inhib = (double) dvar[j * ncells + i];
                 if (veg_lib[i][j].Wnpp_inhib < 0 ||
                     veg_lib[i][j].Wnpp_inhib > 1) {
                     log_err("cell %zu veg %zu: Wnpp_inhib is %f "
@@ -404,12 +423,12 @@ vic_init(void)
             }
         }
         // NPPfactor_sat
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "NPPfactor_sat", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "NPPfactor_sat",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                veg_lib[i][j].NPPfactor_sat = (double) dvar[i];
+                veg_lib[i][j].NPPfactor_sat = (double) dvar[j * ncells + i];
                 if (veg_lib[i][j].NPPfactor_sat < 0 ||
                     veg_lib[i][j].NPPfactor_sat > 1) {
                     log_err("cell %zu veg %zu: NPPfactor_sat is %f "
@@ -483,42 +502,42 @@ vic_init(void)
     }
 
     // expt: unsaturated hydraulic conductivity exponent for each layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "expt", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "expt",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].expt[j] = (double) dvar[i];
+            soil_con[i].expt[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // Ksat: saturated hydraulic conductivity for each layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "Ksat", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "Ksat",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].Ksat[j] = (double) dvar[i];
+            soil_con[i].Ksat[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // init_moist: initial soil moisture for cold start
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "init_moist", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "init_moist",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].init_moist[j] = (double) dvar[i];
+            soil_con[i].init_moist[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // phi_s
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "phi_s", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "phi_s",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].phi_s[j] = (double) dvar[i];
+            soil_con[i].phi_s[j] = (double) dvar[j * ncells + i];
         }
     }
 
@@ -530,12 +549,12 @@ vic_init(void)
     }
 
     // depth: thickness for each soil layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "depth", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "depth",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].depth[j] = (double) dvar[i];
+            soil_con[i].depth[j] = (double) dvar[j * ncells + i];
         }
     }
 
@@ -554,97 +573,97 @@ vic_init(void)
     }
 
     // bubble: bubbling pressure for each soil layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "bubble", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "bubble",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].bubble[j] = (double) dvar[i];
+            soil_con[i].bubble[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // quartz: quartz content for each soil layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "quartz", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "quartz",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].quartz[j] = (double) dvar[i];
+            soil_con[i].quartz[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // bulk_dens_min: mineral bulk density for each soil layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "bulk_density", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "bulk_density",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].bulk_dens_min[j] = (double) dvar[i];
+            soil_con[i].bulk_dens_min[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // soil_dens_min: mineral soil density for each soil layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "soil_density", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "soil_density",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].soil_dens_min[j] = (double) dvar[i];
+            soil_con[i].soil_dens_min[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // organic soils
     if (options.ORGANIC_FRACT) {
         // organic
+        d3count[0] = options.Nlayer;
+        get_scatter_nc_slab_double(&(filenames.params), "organic", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.Nlayer; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "organic",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].organic[j] = (double) dvar[i];
+                soil_con[i].organic[j] = (double) dvar[j * ncells + i];
             }
         }
 
         // bulk_dens_org: organic bulk density for each soil layer
+        d3count[0] = options.Nlayer;
+        get_scatter_nc_slab_double(&(filenames.params), "bulk_density_org", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.Nlayer; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "bulk_density_org",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].bulk_dens_org[j] = (double) dvar[i];
+                soil_con[i].bulk_dens_org[j] = (double) dvar[j * ncells + i];
             }
         }
 
         // soil_dens_org: organic soil density for each soil layer
+        d3count[0] = options.Nlayer;
+        get_scatter_nc_slab_double(&(filenames.params), "soil_density_org", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.Nlayer; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "soil_density_org",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].soil_dens_org[j] = (double) dvar[i];
+                soil_con[i].soil_dens_org[j] = (double) dvar[j * ncells + i];
             }
         }
     }
 
     // Wcr: critical point for each layer
     // Note this value is  multiplied with the maximum moisture in each layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "Wcr_FRACT", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "Wcr_FRACT",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].Wcr[j] = (double) dvar[i];
+            soil_con[i].Wcr[j] = (double) dvar[j * ncells + i];
         }
     }
 
     // Wpwp: wilting point for each layer
     // Note this value is  multiplied with the maximum moisture in each layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "Wpwp_FRACT", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "Wpwp_FRACT",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].Wpwp[j] = (double) dvar[i];
+            soil_con[i].Wpwp[j] = (double) dvar[j * ncells + i];
         }
     }
 
@@ -658,12 +677,12 @@ vic_init(void)
         }
     }
     if (options.WFC_SRC == FROM_VEGLIB || options.WFC_SRC == FROM_VEGPARAM) {
+        d3count[0] = options.Nlayer;
+        get_scatter_nc_slab_double(&(filenames.params), "Wfc_FRACT", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.Nlayer; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "Wfc_FRACT",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].Wfc[j] = (double) dvar[i];
+                soil_con[i].Wfc[j] = (double) dvar[j * ncells + i];
             }
         }
     }
@@ -690,12 +709,12 @@ vic_init(void)
     }
 
     // resid_moist: residual moisture content for each layer
+    d3count[0] = options.Nlayer;
+    get_scatter_nc_slab_double(&(filenames.params), "resid_moist", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.Nlayer; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "resid_moist",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            soil_con[i].resid_moist[j] = (double) dvar[i];
+            soil_con[i].resid_moist[j] = (double) dvar[j * ncells + i];
         }
     }
 
@@ -995,30 +1014,30 @@ vic_init(void)
     }
     else {
         // AreaFract: fraction of grid cell in each snow band
+        d3count[0] = options.SNOW_BAND;
+        get_scatter_nc_slab_double(&(filenames.params), "AreaFract", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.SNOW_BAND; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "AreaFract",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].AreaFract[j] = (double) dvar[i];
+                soil_con[i].AreaFract[j] = (double) dvar[j * ncells + i];
             }
         }
         // elevation: elevation of each snow band
+        d3count[0] = options.SNOW_BAND;
+        get_scatter_nc_slab_double(&(filenames.params), "elevation", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.SNOW_BAND; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "elevation",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].BandElev[j] = (double) dvar[i];
+                soil_con[i].BandElev[j] = (double) dvar[j * ncells + i];
             }
         }
         // Pfactor: precipitation multiplier for each snow band
+        d3count[0] = options.SNOW_BAND;
+        get_scatter_nc_slab_double(&(filenames.params), "Pfactor", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.SNOW_BAND; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "Pfactor",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
-                soil_con[i].Pfactor[j] = (double) dvar[i];
+                soil_con[i].Pfactor[j] = (double) dvar[j * ncells + i];
             }
         }
         // Run some checks and corrections for soil
@@ -1137,12 +1156,12 @@ vic_init(void)
     // structure. Then assign only the ones with a fraction greater than 0 to
     // the veg_con structure
 
+    d3count[0] = options.NVEGTYPES;
+    get_scatter_nc_slab_double(&(filenames.params), "Cv", 3,
+                               d3start, d3count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d3start[0] = j;
-        get_scatter_nc_field_double(&(filenames.params), "Cv",
-                                    d3start, d3count, dvar);
         for (i = 0; i < local_domain.ncells_active; i++) {
-            veg_con_map[i].Cv[j] = (double) dvar[i];
+            veg_con_map[i].Cv[j] = (double) dvar[j * ncells + i];
         }
     }
 
@@ -1199,32 +1218,34 @@ vic_init(void)
     }
 
     // zone_depth: root zone depths
+    d4count[0] = options.NVEGTYPES;
+    d4count[1] = options.ROOT_ZONES;
+    get_scatter_nc_slab_double(&(filenames.params), "root_depth", 4,
+                               d4start, d4count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d4start[0] = j;
         for (k = 0; k < options.ROOT_ZONES; k++) {
-            d4start[1] = k;
-            get_scatter_nc_field_double(&(filenames.params), "root_depth",
-                                        d4start, d4count, dvar);
+            idx = (j * options.ROOT_ZONES + k) * ncells;
             for (i = 0; i < local_domain.ncells_active; i++) {
                 vidx = veg_con_map[i].vidx[j];
                 if (vidx != NODATA_VEG) {
-                    veg_con[i][vidx].zone_depth[k] = (double) dvar[i];
+                    veg_con[i][vidx].zone_depth[k] = (double) dvar[idx + i];
                 }
             }
         }
     }
 
     // zone_fract: root fractions
+    d4count[0] = options.NVEGTYPES;
+    d4count[1] = options.ROOT_ZONES;
+    get_scatter_nc_slab_double(&(filenames.params), "root_fract", 4,
+                               d4start, d4count, dvar);
     for (j = 0; j < options.NVEGTYPES; j++) {
-        d4start[0] = j;
         for (k = 0; k < options.ROOT_ZONES; k++) {
-            d4start[1] = k;
-            get_scatter_nc_field_double(&(filenames.params), "root_fract",
-                                        d4start, d4count, dvar);
+            idx = (j * options.ROOT_ZONES + k) * ncells;
             for (i = 0; i < local_domain.ncells_active; i++) {
                 vidx = veg_con_map[i].vidx[j];
                 if (vidx != NODATA_VEG) {
-                    veg_con[i][vidx].zone_fract[k] = (double) dvar[i];
+                    veg_con[i][vidx].zone_fract[k] = (double) dvar[idx + i];
                 }
             }
         }
@@ -1316,14 +1337,15 @@ vic_init(void)
     // read blowing snow parameters
     if (options.BLOWING) {
         // sigma_slope
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "sigma_slope", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "sigma_slope",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
                 vidx = veg_con_map[i].vidx[j];
                 if (vidx != NODATA_VEG) {
-                    veg_con[i][vidx].sigma_slope = (double) dvar[i];
+                    veg_con[i][vidx].sigma_slope =
+                        (double) dvar[j * ncells + i];
                     if (veg_con[i][vidx].sigma_slope <= 0) {
                         log_err("cell %zu veg %d: deviation of terrain slope "
                                 "(sigma_slope) is %f but must be > 0.",
@@ -1333,14 +1355,14 @@ vic_init(void)
             }
         }
         // lag_one
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "lag_one", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "lag_one",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
                 vidx = veg_con_map[i].vidx[j];
                 if (vidx != NODATA_VEG) {
-                    veg_con[i][vidx].lag_one = (double) dvar[i];
+                    veg_con[i][vidx].lag_one = (double) dvar[j * ncells + i];
                     if (veg_con[i][vidx].lag_one <= 0) {
                         log_err("cell %zu veg %d: lag_one is %f but "
                                 "must be > 0.",
@@ -1350,14 +1372,14 @@ vic_init(void)
             }
         }
         // fetch
+        d3count[0] = options.NVEGTYPES;
+        get_scatter_nc_slab_double(&(filenames.params), "fetch", 3,
+                                   d3start, d3count, dvar);
         for (j = 0; j < options.NVEGTYPES; j++) {
-            d3start[0] = j;
-            get_scatter_nc_field_double(&(filenames.params), "fetch",
-                                        d3start, d3count, dvar);
             for (i = 0; i < local_domain.ncells_active; i++) {
                 vidx = veg_con_map[i].vidx[j];
                 if (vidx != NODATA_VEG) {
-                    veg_con[i][vidx].fetch = (double) dvar[i];
+                    veg_con[i][vidx].fetch = (double) dvar[j * ncells + i];
                     if (veg_con[i][vidx].fetch <= 1) {
                         log_err("cell %zu veg %d: fetch is %f but "
                                 "must be > 1.",
@@ -1368,6 +1390,82 @@ vic_init(void)
         }
     }
 
+    // cleanup
+    free(dvar);
+    free(ivar);
+    free(Cv_sum);
+}
+
+/******************************************************************************
+ * @brief    Initialize model parameters
+ *****************************************************************************/
+void
+vic_init(void)
+{
+    extern all_vars_struct    *all_vars;
+    extern size_t              current;
+    extern domain_struct       global_domain;
+    extern domain_struct       local_domain;
+    extern option_struct       options;
+    extern filenames_struct    filenames;
+    extern soil_con_struct    *soil_con;
+    extern veg_con_struct    **veg_con;
+    extern lake_con_struct    *lake_con;
+    extern parameters_struct   param;
+    extern int                 mpi_rank;
+
+    double                    *dvar = NULL;
+    int                       *ivar = NULL;
+    int                        status;
+    size_t                     i;
+    size_t                     j;
+    size_t                     k;
+    size_t                     m;
+    size_t                     nveg;
+    size_t                     max_numnod;
+    size_t                     d2count[2];
+    size_t                     d2start[2];
+    size_t                     d3count[3];
+    size_t                     d3start[3];
+    int                        tmp_lake_idx;
+
+    // allocate memory for variables to be read
+    dvar = malloc(local_domain.ncells_active * sizeof(*dvar));
+    check_alloc_status(dvar, "Memory allocation error.");
+    ivar = malloc(local_domain.ncells_active * sizeof(*ivar));
+    check_alloc_status(ivar, "Memory allocation error.");
+
+    // The method used to convert the NetCDF fields to VIC structures for
+    // individual grid cells is to read a 2D slice and then loop over the
+    // domain cells to assign the values to the VIC structures
+
+    d2start[0] = 0;
+    d2start[1] = 0;
+    d2count[0] = global_domain.n_ny;
+    d2count[1] = global_domain.n_nx;
+
+    d3start[0] = 0;
+    d3start[1] = 0;
+    d3start[2] = 0;
+    d3count[0] = 1;
+    d3count[1] = global_domain.n_ny;
+    d3count[2] = global_domain.n_nx;
+
+    // start the clock
+    current = 0;
+
+    // blowing snow suspension layer integrals
+    if (options.BLOWING && options.BLOWING_INTEGRATION == BLOWING_TABLE) {
+        initialize_blowing_table();
+    }
+
+    // soil and vegetation parameters, from the parameter cache if it matches
+    // the current setup and domain decomposition
+    if (!get_param_cache()) {
+        vic_init_params();
+        put_param_cache();
+    }
+
     // read_lake parameters
     if (options.LAKES) {
         // lake_idx
@@ -1404,8 +1502,9 @@ vic_init(void)
             else if (!(lake_con[i].numnod > 0 &&
                        lake_con[i].numnod < MAX_LAKE_NODES)) {
                 log_err("cell %zu numnod is %zu but we must have 1 "
-                        "<= numnod < %d.", i, lake_con[i].numnod,
-                        MAX_LAKE_NODES);
+                        "<= numnod < %d (MAX_LAKE_NODES); for more lake "
+                        "nodes recompile with a larger MAX_LAKE_NODES.",
+                        i, lake_con[i].numnod, MAX_LAKE_NODES);
             }
             else if (!(lake_con[i].numnod <= options.NLAKENODES)) {
                 log_err("cell %zu numnod is %zu but this exceeds "
@@ -1661,5 +1760,4 @@ vic_init(void)
     // cleanup
     free(dvar);
     free(ivar);
-    free(Cv_sum);
 }
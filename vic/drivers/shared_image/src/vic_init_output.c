@@ -62,17 +62,6 @@ vic_init_output(dmy_struct *dmy_current)
     set_output_met_data_info();
     plugin_set_output_met_data_info();
 
-    // allocate out_data
-    alloc_out_data(local_domain.ncells_active, out_data);
-
-    // initialize the save data structures
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        plugin_put_data(i);
-        initialize_save_data(&(all_vars[i]), &(force[i]), &(soil_con[i]),
-                             veg_con[i], veg_lib[i], &lake_con, out_data[i],
-                             &(save_data[i]), &timer);
-    }
-
     if (mpi_rank == VIC_MPI_ROOT) {
         // count the number of streams and variables in the global parameter file
         count_nstreams_nvars(filep.globalparam, &(options.Noutstreams),
@@ -189,8 +178,28 @@ vic_init_output(dmy_struct *dmy_current)
                            output_streams[streamnum].varid,
                            output_streams[streamnum].type);
     }
+
+    // set the output variables to compute, then allocate out_data
+    set_output_requested(output_streams, options.Noutstreams);
+    plugin_set_output_requested();
+    alloc_out_data(local_domain.ncells_active, out_data);
+
+    // initialize the save data structures
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        plugin_put_data(i);
+        initialize_save_data(&(all_vars[i]), &(force[i]), &(soil_con[i]),
+                             veg_con[i], veg_lib[i], &lake_con, out_data[i],
+                             &(save_data[i]), &timer);
+    }
+
     // validate streams
     validate_streams(&output_streams);
+
+    // set up the asynchronous history writer
+    hist_writer_init();
+
+    // set up the state snapshot writer
+    snapshot_writer_init(dmy_current);
 }
 
 /******************************************************************************
@@ -647,6 +656,9 @@ set_global_nc_attributes(int ncid,
     else if (file_type == NC_STATE_FILE) {
         put_nc_attr(ncid, NC_GLOBAL, "title", "VIC State File");
     }
+    else if (file_type == NC_DECOMP_FILE) {
+        put_nc_attr(ncid, NC_GLOBAL, "title", "VIC Decomposition File");
+    }
     else {
         put_nc_attr(ncid, NC_GLOBAL, "title", "Unknown");
     }
@@ -100,7 +100,7 @@ create_MPI_global_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in global_param_struct
-    nitems = 32;
+    nitems = 35;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -237,6 +237,18 @@ create_MPI_global_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(global_param_struct, stateyear);
     mpi_types[i++] = MPI_UNSIGNED_SHORT;
 
+    // unsigned short int snapshot_freq;
+    offsets[i] = offsetof(global_param_struct, snapshot_freq);
+    mpi_types[i++] = MPI_UNSIGNED_SHORT;
+
+    // int snapshot_n;
+    offsets[i] = offsetof(global_param_struct, snapshot_n);
+    mpi_types[i++] = MPI_INT;
+
+    // size_t snapshot_keep;
+    offsets[i] = offsetof(global_param_struct, snapshot_keep);
+    mpi_types[i++] = MPI_AINT;
+
     // unsigned short int calendar;
     offsets[i] = offsetof(global_param_struct, calendar);
     mpi_types[i++] = MPI_UNSIGNED_SHORT;
@@ -293,7 +305,7 @@ create_MPI_filenames_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in filenames_struct
-    nitems = 10;
+    nitems = 14;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -354,6 +366,21 @@ create_MPI_filenames_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(filenames_struct, log_path);
     mpi_types[i++] = MPI_CHAR;
 
+    // char decomp_cost[MAXSTRING];
+    offsets[i] = offsetof(filenames_struct, decomp_cost);
+    mpi_types[i++] = MPI_CHAR;
+
+    // char decomp_out[MAXSTRING];
+    offsets[i] = offsetof(filenames_struct, decomp_out);
+    mpi_types[i++] = MPI_CHAR;
+
+    // char param_cache[MAXSTRING];
+    offsets[i] = offsetof(filenames_struct, param_cache);
+    mpi_types[i++] = MPI_CHAR;
+
+    // char timing_report[MAXSTRING];
+    offsets[i] = offsetof(filenames_struct, timing_report);
+    mpi_types[i++] = MPI_CHAR;
 
     // make sure that the we have the right number of elements
     if (i != (size_t) nitems) {
@@ -471,6 +498,101 @@ create_MPI_location_struct_type(MPI_Datatype *mpi_type)
     free(mpi_types);
 }
 
+/******************************************************************************
+ * @brief   Create an MPI_Datatype that represents the
+ *          instrument_record_struct
+ * @details This allows MPI operations in which the entire
+ *          instrument_record_struct can be treated as an MPI_Datatype. NOTE:
+ *          This function needs to be kept in-sync with the
+ *          instrument_record_struct data type in vic_instrument.h.
+ *
+ * @param mpi_type MPI_Datatype that can be used in MPI operations
+ *****************************************************************************/
+void
+create_MPI_instrument_record_type(MPI_Datatype *mpi_type)
+{
+    extern MPI_Comm MPI_COMM_VIC;
+
+    int             nitems; // number of elements in struct
+    int             status;
+    int            *blocklengths;
+    size_t          i;
+    MPI_Aint       *offsets;
+    MPI_Datatype   *mpi_types;
+
+    // nitems has to equal the number of elements in instrument_record_struct
+    nitems = 9;
+    blocklengths = malloc(nitems * sizeof(*blocklengths));
+    check_alloc_status(blocklengths, "Memory allocation error.");
+
+    offsets = malloc(nitems * sizeof(*offsets));
+    check_alloc_status(offsets, "Memory allocation error.");
+
+    mpi_types = malloc(nitems * sizeof(*mpi_types));
+    check_alloc_status(mpi_types, "Memory allocation error.");
+
+    // none of the elements in instrument_record_struct are arrays.
+    for (i = 0; i < (size_t) nitems; i++) {
+        blocklengths[i] = 1;
+    }
+
+    // reset i
+    i = 0;
+
+    // int rank;
+    offsets[i] = offsetof(instrument_record_struct, rank);
+    mpi_types[i++] = MPI_INT;
+
+    // int thread;
+    offsets[i] = offsetof(instrument_record_struct, thread);
+    mpi_types[i++] = MPI_INT;
+
+    // int parent;
+    offsets[i] = offsetof(instrument_record_struct, parent);
+    mpi_types[i++] = MPI_INT;
+
+    // int region;
+    offsets[i] = offsetof(instrument_record_struct, region);
+    mpi_types[i++] = MPI_INT;
+
+    // size_t count;
+    offsets[i] = offsetof(instrument_record_struct, count);
+    mpi_types[i++] = MPI_AINT;
+
+    // double total;
+    offsets[i] = offsetof(instrument_record_struct, total);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // double self;
+    offsets[i] = offsetof(instrument_record_struct, self);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // double min;
+    offsets[i] = offsetof(instrument_record_struct, min);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // double max;
+    offsets[i] = offsetof(instrument_record_struct, max);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // make sure that the we have the right number of elements
+    if (i != (size_t) nitems) {
+        log_err("Miscount: %zd not equal to %d.", i, nitems);
+    }
+
+    status = MPI_Type_create_struct(nitems, blocklengths, offsets, mpi_types,
+                                    mpi_type);
+    check_mpi_status(status, "MPI error.");
+
+    status = MPI_Type_commit(mpi_type);
+    check_mpi_status(status, "MPI error.");
+
+    // cleanup
+    free(blocklengths);
+    free(offsets);
+    free(mpi_types);
+}
+
 /******************************************************************************
  * @brief   Create an MPI_Datatype that represents the option_struct
  * @details This allows MPI operations in which the entire option_struct can
@@ -492,7 +614,7 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in option_struct
-    nitems = 56;
+    nitems = 62;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -542,6 +664,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, BLOWING_SPATIAL_WIND);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // unsigned short BLOWING_INTEGRATION;
+    offsets[i] = offsetof(option_struct, BLOWING_INTEGRATION);
+    mpi_types[i++] = MPI_UNSIGNED_SHORT;
+
     // bool CARBON;
     offsets[i] = offsetof(option_struct, CARBON);
     mpi_types[i++] = MPI_C_BOOL;
@@ -586,6 +712,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, IMPLICIT);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // unsigned short IMPLICIT_JACOBIAN;
+    offsets[i] = offsetof(option_struct, IMPLICIT_JACOBIAN);
+    mpi_types[i++] = MPI_UNSIGNED_SHORT;
+
     // bool JULY_TAVG_SUPPLIED;
     offsets[i] = offsetof(option_struct, JULY_TAVG_SUPPLIED);
     mpi_types[i++] = MPI_C_BOOL;
@@ -722,6 +852,14 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, ORGANIC_FRACT);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // unsigned short FORCE_READER;
+    offsets[i] = offsetof(option_struct, FORCE_READER);
+    mpi_types[i++] = MPI_UNSIGNED_SHORT;
+
+    // size_t FORCE_PREFETCH;
+    offsets[i] = offsetof(option_struct, FORCE_PREFETCH);
+    mpi_types[i++] = MPI_AINT; // note there is no MPI_SIZE_T equivalent
+
     // unsigned short STATE_FORMAT;
     offsets[i] = offsetof(option_struct, STATE_FORMAT);
     mpi_types[i++] = MPI_UNSIGNED_SHORT;
@@ -734,6 +872,14 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, SAVE_STATE);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool OUTPUT_ASYNC;
+    offsets[i] = offsetof(option_struct, OUTPUT_ASYNC);
+    mpi_types[i++] = MPI_C_BOOL;
+
+    // bool OUTPUT_ON_DEMAND;
+    offsets[i] = offsetof(option_struct, OUTPUT_ON_DEMAND);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // make sure that the we have the right number of elements
     if (i != (size_t) nitems) {
         log_err("Miscount: %zd not equal to %d.", i, nitems);
@@ -771,7 +917,7 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in parameters_struct
-    nitems = 157;
+    nitems = 158;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -1417,6 +1563,10 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(parameters_struct, ROOT_BRENT_T);
     mpi_types[i++] = MPI_DOUBLE;
 
+    // double ROOT_BRENT_WARM_DT
+    offsets[i] = offsetof(parameters_struct, ROOT_BRENT_WARM_DT);
+    mpi_types[i++] = MPI_DOUBLE;
+
     // make sure that the we have the right number of elements
     if (i != (size_t) nitems) {
         log_err("Miscount: %zd not equal to %d.", i, nitems);
@@ -1675,10 +1825,13 @@ mpi_map_decomp_domain(size_t   ncells,
                       int    **mpi_map_global_array_offsets,
                       size_t **mpi_map_mapping_array)
 {
-    size_t i;
-    size_t j;
-    size_t k;
-    size_t n;
+    extern double *decomp_cost;
+
+    size_t         i;
+    size_t         j;
+    size_t         k;
+    size_t         n;
+    size_t        *cells;
 
     *mpi_map_local_array_sizes = calloc(mpi_size,
                                         sizeof(*(*mpi_map_local_array_sizes)));
@@ -1687,6 +1840,24 @@ mpi_map_decomp_domain(size_t   ncells,
                                                     mpi_map_global_array_offsets)));
     *mpi_map_mapping_array = calloc(ncells, sizeof(*(*mpi_map_mapping_array)));
 
+    // balance the measured cell cost if available, every cell is a group
+    if (decomp_cost != NULL) {
+        cells = malloc((ncells + 1) * sizeof(*cells));
+        check_alloc_status(cells, "Memory allocation error.");
+        for (i = 0; i <= ncells; i++) {
+            cells[i] = i;
+        }
+
+        mpi_map_decomp_domain_cost(ncells, mpi_size,
+                                   *mpi_map_local_array_sizes,
+                                   *mpi_map_global_array_offsets,
+                                   *mpi_map_mapping_array, ncells, cells,
+                                   cells, decomp_cost);
+
+        free(cells);
+        return;
+    }
+
     // determine number of cells per node
     for (n = ncells, i = 0; n > 0; n--, i++) {
         if (i >= mpi_size) {
@@ -1711,6 +1882,231 @@ mpi_map_decomp_domain(size_t   ncells,
     }
 }
 
+/******************************************************************************
+ * @brief   Compare two decomposition groups (on decreasing cost, then on
+ *          increasing id)
+ *****************************************************************************/
+int
+decomp_cost_compare(const void *a,
+                    const void *b)
+{
+    const decomp_cost_struct *group_a = a;
+    const decomp_cost_struct *group_b = b;
+
+    if (group_a->cost != group_b->cost) {
+        return (group_a->cost > group_b->cost) ? -1 : 1;
+    }
+    if (group_a->id != group_b->id) {
+        return (group_a->id < group_b->id) ? -1 : 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * @brief   Decompose the domain into groups of cells, balancing their cost
+ * @details Groups (e.g. single cells or routing basins) are kept intact.
+ *          They are assigned from the most to the least costly group to the
+ *          node with the lowest total cost so far (greedy bin-packing); the
+ *          lowest node id wins ties. On each node the cells keep the order of
+ *          their groups.
+ *
+ * @param ncells number of active cells
+ * @param mpi_size number of mpi processes
+ * @param mpi_map_local_array_sizes number of cells per node [mpi_size]
+ * @param mpi_map_global_array_offsets offsets per node [mpi_size]
+ * @param mpi_map_mapping_array cell indices ordered by node [ncells]
+ * @param ngroups number of groups
+ * @param group_start first element of each group in group_cells
+ *        [ngroups + 1]
+ * @param group_cells cell indices of all groups [ncells]
+ * @param group_cost cost of each group [ngroups]
+ *****************************************************************************/
+void
+mpi_map_decomp_domain_cost(size_t  ncells,
+                           size_t  mpi_size,
+                           int    *mpi_map_local_array_sizes,
+                           int    *mpi_map_global_array_offsets,
+                           size_t *mpi_map_mapping_array,
+                           size_t  ngroups,
+                           size_t *group_start,
+                           size_t *group_cells,
+                           double *group_cost)
+{
+    decomp_cost_struct *groups;
+    double             *node_cost;
+    size_t             *heap;
+    size_t             *group_node;
+    size_t             *node_pos;
+    size_t              node;
+    size_t              hold;
+    size_t              parent;
+    size_t              child;
+
+    size_t              i;
+    size_t              j;
+
+    groups = malloc((ngroups + 1) * sizeof(*groups));
+    check_alloc_status(groups, "Memory allocation error.");
+    node_cost = malloc(mpi_size * sizeof(*node_cost));
+    check_alloc_status(node_cost, "Memory allocation error.");
+    heap = malloc(mpi_size * sizeof(*heap));
+    check_alloc_status(heap, "Memory allocation error.");
+    group_node = malloc((ngroups + 1) * sizeof(*group_node));
+    check_alloc_status(group_node, "Memory allocation error.");
+    node_pos = malloc(mpi_size * sizeof(*node_pos));
+    check_alloc_status(node_pos, "Memory allocation error.");
+
+    // sort groups by decreasing cost
+    for (i = 0; i < ngroups; i++) {
+        groups[i].cost = group_cost[i];
+        groups[i].id = i;
+    }
+    qsort(groups, ngroups, sizeof(*groups), decomp_cost_compare);
+
+    // nodes in a binary min-heap on (cost, node id)
+    for (i = 0; i < mpi_size; i++) {
+        node_cost[i] = 0.;
+        heap[i] = i;
+        mpi_map_local_array_sizes[i] = 0;
+    }
+
+    for (i = 0; i < ngroups; i++) {
+        // add the group to the node with the lowest cost
+        node = heap[0];
+        group_node[groups[i].id] = node;
+        node_cost[node] += groups[i].cost;
+        mpi_map_local_array_sizes[node] +=
+            (int) (group_start[groups[i].id + 1] - group_start[groups[i].id]);
+
+        // restore the heap (only the root increased)
+        parent = 0;
+        while (true) {
+            child = 2 * parent + 1;
+            if (child >= mpi_size) {
+                break;
+            }
+            if (child + 1 < mpi_size &&
+                (node_cost[heap[child + 1]] < node_cost[heap[child]] ||
+                 (node_cost[heap[child + 1]] == node_cost[heap[child]] &&
+                  heap[child + 1] < heap[child]))) {
+                child++;
+            }
+            if (node_cost[heap[child]] < node_cost[heap[parent]] ||
+                (node_cost[heap[child]] == node_cost[heap[parent]] &&
+                 heap[child] < heap[parent])) {
+                hold = heap[parent];
+                heap[parent] = heap[child];
+                heap[child] = hold;
+                parent = child;
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+    // determine offsets to use for MPI_Scatterv and MPI_Gatherv
+    mpi_map_global_array_offsets[0] = 0;
+    node_pos[0] = 0;
+    for (i = 1; i < mpi_size; i++) {
+        mpi_map_global_array_offsets[i] = mpi_map_global_array_offsets[i - 1] +
+                                          mpi_map_local_array_sizes[i - 1];
+        node_pos[i] = mpi_map_global_array_offsets[i];
+    }
+
+    // set mapping array
+    for (i = 0; i < ngroups; i++) {
+        node = group_node[i];
+        for (j = group_start[i]; j < group_start[i + 1]; j++) {
+            mpi_map_mapping_array[node_pos[node]++] = group_cells[j];
+        }
+    }
+
+    if (node_pos[mpi_size - 1] != ncells) {
+        log_err("Decomposition groups cover %zu of %zu cells",
+                node_pos[mpi_size - 1], ncells);
+    }
+
+    free(groups);
+    free(node_cost);
+    free(heap);
+    free(group_node);
+    free(node_pos);
+}
+
+/******************************************************************************
+ * @brief   Determine the hyperslab that covers the local active cells
+ * @details The hyperslab is the bounding box (in grid rows and columns) of
+ *          the active cells assigned to this node. It is used by the
+ *          collective readers so that each node only reads the part of the
+ *          global grid that it needs. Note that for a random decomposition the
+ *          bounding box generally spans most of the domain, while basin and
+ *          file based decompositions result in compact hyperslabs.
+ *
+ * @param slab hyperslab of the local node (changed)
+ *****************************************************************************/
+void
+mpi_map_local_slab(mpi_slab_struct *slab)
+{
+    extern domain_struct global_domain;
+    extern domain_struct local_domain;
+
+    size_t               i;
+    size_t               x;
+    size_t               y;
+    size_t               x_min;
+    size_t               x_max;
+    size_t               y_min;
+    size_t               y_max;
+
+    slab->y_start = 0;
+    slab->y_count = 0;
+    slab->x_start = 0;
+    slab->x_count = 0;
+    slab->slab_idx = NULL;
+
+    if (local_domain.ncells_active == 0) {
+        return;
+    }
+
+    x_min = global_domain.n_nx;
+    x_max = 0;
+    y_min = global_domain.n_ny;
+    y_max = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        y = local_domain.locations[i].io_idx / global_domain.n_nx;
+        x = local_domain.locations[i].io_idx % global_domain.n_nx;
+        if (x < x_min) {
+            x_min = x;
+        }
+        if (x > x_max) {
+            x_max = x;
+        }
+        if (y < y_min) {
+            y_min = y;
+        }
+        if (y > y_max) {
+            y_max = y;
+        }
+    }
+
+    slab->y_start = y_min;
+    slab->y_count = y_max - y_min + 1;
+    slab->x_start = x_min;
+    slab->x_count = x_max - x_min + 1;
+
+    slab->slab_idx = malloc(local_domain.ncells_active *
+                            sizeof(*(slab->slab_idx)));
+    check_alloc_status(slab->slab_idx, "Memory allocation error.");
+
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        y = local_domain.locations[i].io_idx / global_domain.n_nx;
+        x = local_domain.locations[i].io_idx % global_domain.n_nx;
+        slab->slab_idx[i] = (y - slab->y_start) * slab->x_count +
+                            (x - slab->x_start);
+    }
+}
+
 /******************************************************************************
  * @brief   Gather double precision variable
  * @details Values are gathered to the master node
@@ -1749,10 +2145,12 @@ gather_field_double(double  fillval,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_DOUBLE,
                          dvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_DOUBLE,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
@@ -1798,7 +2196,9 @@ gather_put_nc_field_double(int     nc_id,
 
     // Write to netcdf
     if (mpi_rank == VIC_MPI_ROOT) {
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_double(nc_id, var_id, start, count, dvar);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing values.");
         // cleanup
         free(dvar);
@@ -1850,10 +2250,12 @@ gather_put_nc_field_float(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_FLOAT,
                          fvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_FLOAT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "Error with gather of floats");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -1865,7 +2267,9 @@ gather_put_nc_field_float(int     nc_id,
             filter_active_cells, fvar_remapped, fvar);
 
         // write to file
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_float(nc_id, var_id, start, count, fvar);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing values");
 
         // cleanup
@@ -1923,10 +2327,12 @@ gather_put_nc_field_int(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_INT,
                          ivar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_INT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -1938,7 +2344,9 @@ gather_put_nc_field_int(int     nc_id,
         map(sizeof(int), global_domain.ncells_active, NULL, filter_active_cells,
             ivar_remapped, ivar);
         // write to file
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_int(nc_id, var_id, start, count, ivar);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing values");
 
         // cleanup
@@ -1996,10 +2404,12 @@ gather_put_nc_field_short(int        nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_SHORT,
                          svar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_SHORT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -2011,7 +2421,9 @@ gather_put_nc_field_short(int        nc_id,
         map(sizeof(short int), global_domain.ncells_active, NULL,
             filter_active_cells, svar_remapped, svar);
         // write to file
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_short(nc_id, var_id, start, count, svar);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing values");
 
         // cleanup
@@ -2069,10 +2481,12 @@ gather_put_nc_field_schar(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_CHAR,
                          cvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_CHAR,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -2084,7 +2498,9 @@ gather_put_nc_field_schar(int     nc_id,
         map(sizeof(char), global_domain.ncells_active, NULL,
             filter_active_cells, cvar_remapped, cvar);
         // write to file
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_schar(nc_id, var_id, start, count, cvar);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing values");
 
         // cleanup
@@ -2135,10 +2551,12 @@ scatter_field_double(double *dvar,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(dvar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_DOUBLE,
                           var, local_domain.ncells_active, MPI_DOUBLE,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -2174,6 +2592,111 @@ get_scatter_nc_field_double(nameid_struct *nc_nameid,
     scatter_field_double(dvar, var);
 }
 
+/******************************************************************************
+ * @brief   Open a NetCDF file for collective access on all nodes
+ *****************************************************************************/
+void
+open_par_nc_file(nameid_struct *nc_nameid)
+{
+#if NC_HAS_PARALLEL
+    extern MPI_Comm MPI_COMM_VIC;
+    int             status;
+
+    status = nc_open_par(nc_nameid->nc_filename, NC_NOWRITE, MPI_COMM_VIC,
+                         MPI_INFO_NULL, &(nc_nameid->nc_id));
+    check_nc_status(status, "Error opening %s", nc_nameid->nc_filename);
+#else
+    log_err("Cannot open %s for parallel access: the netCDF library does "
+            "not support parallel I/O", nc_nameid->nc_filename);
+#endif
+}
+
+/******************************************************************************
+ * @brief   Read double precision NetCDF field collectively
+ * @details All nodes take part in the read. The last two dimensions (y, x)
+ *          of start and count are replaced by the hyperslab of the local
+ *          node, so that each node only reads the part of the grid that
+ *          covers its own active cells. The leading dimensions are read as
+ *          given and var is filled as [leading dimensions][local cells].
+ *          The file has to be opened with open_par_nc_file().
+ *****************************************************************************/
+void
+get_par_nc_field_double(nameid_struct *nc_nameid,
+                        char          *var_name,
+                        size_t         ndims,
+                        size_t        *start,
+                        size_t        *count,
+                        double        *var)
+{
+#if NC_HAS_PARALLEL
+    extern domain_struct   local_domain;
+    extern mpi_slab_struct mpi_local_slab;
+    int                    status;
+    int                    var_id;
+    size_t                 slab_start[MAXDIMS];
+    size_t                 slab_count[MAXDIMS];
+    size_t                 slab_size;
+    size_t                 nlead;
+    size_t                 i;
+    size_t                 j;
+    double                *dvar = NULL;
+
+    if (ndims < 2 || ndims > MAXDIMS) {
+        log_err("Invalid number of dimensions (%zu) for %s in %s", ndims,
+                var_name, nc_nameid->nc_filename);
+    }
+
+    nlead = 1;
+    for (i = 0; i < ndims - 2; i++) {
+        slab_start[i] = start[i];
+        slab_count[i] = count[i];
+        nlead *= count[i];
+    }
+    slab_start[ndims - 2] = mpi_local_slab.y_start;
+    slab_count[ndims - 2] = mpi_local_slab.y_count;
+    slab_start[ndims - 1] = mpi_local_slab.x_start;
+    slab_count[ndims - 1] = mpi_local_slab.x_count;
+    slab_size = mpi_local_slab.y_count * mpi_local_slab.x_count;
+
+    // allocate at least one element, nodes without active cells still have
+    // to pass a valid buffer to the collective read
+    dvar = malloc((nlead * slab_size + 1) * sizeof(*dvar));
+    check_alloc_status(dvar, "Memory allocation error.");
+
+    status = nc_inq_varid(nc_nameid->nc_id, var_name, &var_id);
+    check_nc_status(status, "Error getting variable id for %s in %s", var_name,
+                    nc_nameid->nc_filename);
+
+    status = nc_var_par_access(nc_nameid->nc_id, var_id, NC_COLLECTIVE);
+    check_nc_status(status, "Error setting collective access for %s in %s",
+                    var_name, nc_nameid->nc_filename);
+
+    INSTRUMENT_BEGIN(INSTR_NC_READ);
+    status = nc_get_vara_double(nc_nameid->nc_id, var_id, slab_start,
+                                slab_count, dvar);
+    INSTRUMENT_END(INSTR_NC_READ);
+    check_nc_status(status, "Error getting values for %s in %s", var_name,
+                    nc_nameid->nc_filename);
+
+    // extract the active cells from the hyperslab
+    for (j = 0; j < nlead; j++) {
+        for (i = 0; i < local_domain.ncells_active; i++) {
+            var[j * local_domain.ncells_active + i] =
+                dvar[j * slab_size + mpi_local_slab.slab_idx[i]];
+        }
+    }
+
+    free(dvar);
+#else
+    UNUSED(ndims);
+    UNUSED(start);
+    UNUSED(count);
+    UNUSED(var);
+    log_err("Cannot read %s from %s collectively: the netCDF library does "
+            "not support parallel I/O", var_name, nc_nameid->nc_filename);
+#endif
+}
+
 /******************************************************************************
  * @brief   Read single precision NetCDF field from file and scatter
  * @details Read happens on the master node and is then scattered to the local
@@ -2226,10 +2749,12 @@ get_scatter_nc_field_float(nameid_struct *nc_nameid,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(fvar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_FLOAT,
                           var, local_domain.ncells_active, MPI_FLOAT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -2287,10 +2812,12 @@ get_scatter_nc_field_int(nameid_struct *nc_nameid,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(ivar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_INT,
                           var, local_domain.ncells_active, MPI_INT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -2298,6 +2825,199 @@ get_scatter_nc_field_int(nameid_struct *nc_nameid,
     }
 }
 
+/******************************************************************************
+ * @brief   Scatter a variable with leading dimensions in a single operation
+ * @details On the master node gvar holds nlead global fields of
+ *          global_domain.ncells_total values each ([leading dimensions][y][x])
+ *          and is freed. The active cells of every field are mapped to the
+ *          scatter order and all fields are sent with one MPI_Scatterv: the
+ *          send and receive datatypes pick the value of a cell from each
+ *          field, so that a node receives all fields of its own cells at
+ *          once. var is filled as [leading dimensions][local cells].
+ *****************************************************************************/
+void
+scatter_field_slab(size_t       nlead,
+                   size_t       size,
+                   MPI_Datatype type,
+                   void        *gvar,
+                   void        *var)
+{
+    extern MPI_Comm      MPI_COMM_VIC;
+    extern domain_struct global_domain;
+    extern domain_struct local_domain;
+    extern int           mpi_rank;
+    extern int          *mpi_map_global_array_offsets;
+    extern int          *mpi_map_local_array_sizes;
+    extern size_t       *filter_active_cells;
+    extern size_t       *mpi_map_mapping_array;
+    int                  status;
+    char                *gvar_filtered = NULL;
+    char                *gvar_mapped = NULL;
+    MPI_Aint             lb;
+    MPI_Aint             extent;
+    MPI_Datatype         field_type;
+    MPI_Datatype         send_type;
+    MPI_Datatype         recv_type;
+    size_t               j;
+
+    status = MPI_Type_get_extent(type, &lb, &extent);
+    check_mpi_status(status, "MPI error.");
+
+    // the send type is only significant on the master node
+    send_type = type;
+    if (mpi_rank == VIC_MPI_ROOT) {
+        gvar_filtered = malloc(global_domain.ncells_active * size);
+        check_alloc_status(gvar_filtered, "Memory allocation error.");
+
+        gvar_mapped = malloc(nlead * global_domain.ncells_active * size);
+        check_alloc_status(gvar_mapped, "Memory allocation error.");
+
+        for (j = 0; j < nlead; j++) {
+            // filter the active cells only
+            map(size, global_domain.ncells_active, filter_active_cells, NULL,
+                (char *) gvar + j * global_domain.ncells_total * size,
+                gvar_filtered);
+            // map to prepare for MPI_Scatterv
+            map(size, global_domain.ncells_active, mpi_map_mapping_array,
+                NULL, gvar_filtered,
+                gvar_mapped + j * global_domain.ncells_active * size);
+        }
+        free(gvar);
+        free(gvar_filtered);
+
+        // one cell of every field of the mapped global array
+        status = MPI_Type_vector((int) nlead, 1,
+                                 (int) global_domain.ncells_active, type,
+                                 &field_type);
+        check_mpi_status(status, "MPI error.");
+        status = MPI_Type_create_resized(field_type, 0, extent, &send_type);
+        check_mpi_status(status, "MPI error.");
+        status = MPI_Type_commit(&send_type);
+        check_mpi_status(status, "MPI error.");
+        status = MPI_Type_free(&field_type);
+        check_mpi_status(status, "MPI error.");
+    }
+
+    // one cell of every field of the local array
+    status = MPI_Type_vector((int) nlead, 1, (int) local_domain.ncells_active,
+                             type, &field_type);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Type_create_resized(field_type, 0, extent, &recv_type);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Type_commit(&recv_type);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Type_free(&field_type);
+    check_mpi_status(status, "MPI error.");
+
+    // Scatter the results to the nodes, result for the local node is in the
+    // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
+    status = MPI_Scatterv(gvar_mapped, mpi_map_local_array_sizes,
+                          mpi_map_global_array_offsets, send_type,
+                          var, (int) local_domain.ncells_active, recv_type,
+                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
+    check_mpi_status(status, "MPI error.");
+
+    status = MPI_Type_free(&recv_type);
+    check_mpi_status(status, "MPI error.");
+    if (mpi_rank == VIC_MPI_ROOT) {
+        status = MPI_Type_free(&send_type);
+        check_mpi_status(status, "MPI error.");
+        free(gvar_mapped);
+    }
+}
+
+/******************************************************************************
+ * @brief   Number of fields in a NetCDF hyperslab
+ * @details Product of the counts of all but the last two (y, x) dimensions.
+ *****************************************************************************/
+size_t
+get_nc_slab_nlead(char   *var_name,
+                  size_t  ndims,
+                  size_t *count)
+{
+    size_t nlead;
+    size_t i;
+
+    if (ndims < 2 || ndims > MAXDIMS) {
+        log_err("Invalid number of dimensions (%zu) for %s", ndims, var_name);
+    }
+
+    nlead = 1;
+    for (i = 0; i < ndims - 2; i++) {
+        nlead *= count[i];
+    }
+
+    return nlead;
+}
+
+/******************************************************************************
+ * @brief   Read double precision NetCDF hyperslab from file and scatter
+ * @details The master node reads all leading dimensions of the hyperslab in
+ *          one read, which is then scattered to the local nodes with a single
+ *          MPI_Scatterv. The last two dimensions (y, x) of start and count
+ *          have to cover the global domain. var is filled as
+ *          [leading dimensions][local cells].
+ *****************************************************************************/
+void
+get_scatter_nc_slab_double(nameid_struct *nc_nameid,
+                           char          *var_name,
+                           size_t         ndims,
+                           size_t        *start,
+                           size_t        *count,
+                           double        *var)
+{
+    extern domain_struct global_domain;
+    extern int           mpi_rank;
+    double              *dvar = NULL;
+    size_t               nlead;
+
+    nlead = get_nc_slab_nlead(var_name, ndims, count);
+
+    // Read variable from netcdf
+    if (mpi_rank == VIC_MPI_ROOT) {
+        dvar = malloc(nlead * global_domain.ncells_total * sizeof(*dvar));
+        check_alloc_status(dvar, "Memory allocation error.");
+
+        get_nc_field_double(nc_nameid, var_name, start, count, dvar);
+    }
+
+    // Scatter results to nodes
+    scatter_field_slab(nlead, sizeof(*dvar), MPI_DOUBLE, dvar, var);
+}
+
+/******************************************************************************
+ * @brief   Read integer NetCDF hyperslab from file and scatter
+ * @details See get_scatter_nc_slab_double.
+ *****************************************************************************/
+void
+get_scatter_nc_slab_int(nameid_struct *nc_nameid,
+                        char          *var_name,
+                        size_t         ndims,
+                        size_t        *start,
+                        size_t        *count,
+                        int           *var)
+{
+    extern domain_struct global_domain;
+    extern int           mpi_rank;
+    int                 *ivar = NULL;
+    size_t               nlead;
+
+    nlead = get_nc_slab_nlead(var_name, ndims, count);
+
+    // Read variable from netcdf
+    if (mpi_rank == VIC_MPI_ROOT) {
+        ivar = malloc(nlead * global_domain.ncells_total * sizeof(*ivar));
+        check_alloc_status(ivar, "Memory allocation error.");
+
+        get_nc_field_int(nc_nameid, var_name, start, count, ivar);
+    }
+
+    // Scatter results to nodes
+    scatter_field_slab(nlead, sizeof(*ivar), MPI_INT, ivar, var);
+}
+
 #ifdef VIC_MPI_SUPPORT_TEST
 
 #include <vic_driver_shared.h>
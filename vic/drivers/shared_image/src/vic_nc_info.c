@@ -249,3 +249,145 @@ get_nc_dtype(unsigned short int dtype)
     }
     return type;
 }
+
+/******************************************************************************
+ * @brief    Define the x and y dimensions of the global domain in a netCDF
+ *           file in define mode
+ *****************************************************************************/
+void
+define_nc_grid_dims(int   nc_id,
+                    char *filename,
+                    int  *ni_dimid,
+                    int  *nj_dimid)
+{
+    extern domain_struct global_domain;
+
+    int                  status;
+
+    status = nc_def_dim(nc_id, global_domain.info.x_dim, global_domain.n_nx,
+                        ni_dimid);
+    check_nc_status(status, "Error defining \"%s\" in %s",
+                    global_domain.info.x_dim, filename);
+
+    status = nc_def_dim(nc_id, global_domain.info.y_dim, global_domain.n_ny,
+                        nj_dimid);
+    check_nc_status(status, "Error defining \"%s\" in %s",
+                    global_domain.info.y_dim, filename);
+}
+
+/******************************************************************************
+ * @brief    Define the longitude and latitude variables of the global domain
+ *           in a netCDF file in define mode
+ * @details  With 1 coordinate dimension longitude is defined along x and
+ *           latitude along y, with 2 both are defined on (y, x).
+ *****************************************************************************/
+void
+define_nc_coord_vars(int   nc_id,
+                     char *filename,
+                     int   ni_dimid,
+                     int   nj_dimid,
+                     int  *lon_var_id,
+                     int  *lat_var_id)
+{
+    extern domain_struct global_domain;
+
+    int                  dimids[2];
+    int                  ndims;
+    int                  status;
+
+    ndims = global_domain.info.n_coord_dims;
+    if (ndims == 1) {
+        dimids[0] = ni_dimid;
+    }
+    else if (ndims == 2) {
+        dimids[0] = nj_dimid;
+        dimids[1] = ni_dimid;
+    }
+    else {
+        log_err("COORD_DIMS_OUT should be 1 or 2");
+    }
+
+    // define the netcdf variable longitude
+    status = nc_def_var(nc_id, global_domain.info.lon_var, NC_DOUBLE, ndims,
+                        dimids, lon_var_id);
+    check_nc_status(status, "Error defining lon variable (%s) in %s",
+                    global_domain.info.lon_var, filename);
+    put_nc_attr(nc_id, *lon_var_id, "long_name", "longitude");
+    put_nc_attr(nc_id, *lon_var_id, "units", "degrees_east");
+    put_nc_attr(nc_id, *lon_var_id, "standard_name", "longitude");
+
+    if (ndims == 1) {
+        dimids[0] = nj_dimid;
+    }
+
+    // define the netcdf variable latitude
+    status = nc_def_var(nc_id, global_domain.info.lat_var, NC_DOUBLE, ndims,
+                        dimids, lat_var_id);
+    check_nc_status(status, "Error defining lat variable (%s) in %s",
+                    global_domain.info.lat_var, filename);
+    put_nc_attr(nc_id, *lat_var_id, "long_name", "latitude");
+    put_nc_attr(nc_id, *lat_var_id, "units", "degrees_north");
+    put_nc_attr(nc_id, *lat_var_id, "standard_name", "latitude");
+}
+
+/******************************************************************************
+ * @brief    Write the longitude and latitude of the global domain to the
+ *           variables defined by define_nc_coord_vars
+ *****************************************************************************/
+void
+put_nc_coord_vars(int   nc_id,
+                  char *filename,
+                  int   lon_var_id,
+                  int   lat_var_id)
+{
+    extern domain_struct global_domain;
+
+    double              *dvar = NULL;
+    size_t               dstart[2] = {0, 0};
+    size_t               dcount[2];
+    int                  status;
+
+    size_t               i;
+
+    dvar = malloc(global_domain.ncells_total * sizeof(*dvar));
+    check_alloc_status(dvar, "Memory allocation error");
+
+    if (global_domain.info.n_coord_dims == 1) {
+        // implicitly nested loop over ni and nj with j set to 0
+        dcount[0] = global_domain.n_nx;
+        for (i = 0; i < global_domain.n_nx; i++) {
+            dvar[i] = global_domain.locations[i].longitude;
+        }
+        status = nc_put_vara_double(nc_id, lon_var_id, dstart, dcount, dvar);
+        check_nc_status(status, "Error adding data to lon in %s", filename);
+
+        // implicitly nested loop over ni and nj with i set to 0;
+        // j stride = n_nx
+        dcount[0] = global_domain.n_ny;
+        for (i = 0; i < global_domain.n_ny; i++) {
+            dvar[i] = global_domain.locations[i * global_domain.n_nx].latitude;
+        }
+        status = nc_put_vara_double(nc_id, lat_var_id, dstart, dcount, dvar);
+        check_nc_status(status, "Error adding data to lat in %s", filename);
+    }
+    else if (global_domain.info.n_coord_dims == 2) {
+        dcount[0] = global_domain.n_ny;
+        dcount[1] = global_domain.n_nx;
+        for (i = 0; i < global_domain.ncells_total; i++) {
+            dvar[i] = global_domain.locations[i].longitude;
+        }
+        status = nc_put_vara_double(nc_id, lon_var_id, dstart, dcount, dvar);
+        check_nc_status(status, "Error adding data to lon in %s", filename);
+
+        for (i = 0; i < global_domain.ncells_total; i++) {
+            dvar[i] = global_domain.locations[i].latitude;
+        }
+        status = nc_put_vara_double(nc_id, lat_var_id, dstart, dcount, dvar);
+        check_nc_status(status, "Error adding data to lat in %s", filename);
+    }
+    else {
+        log_err("COORD_DIMS_OUT should be 1 or 2");
+    }
+
+    free(dvar);
+}
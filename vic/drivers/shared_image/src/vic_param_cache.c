@@ -0,0 +1,378 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Parameter cache: a binary copy of the derived soil_con, veg_lib, veg_con
+ * and veg_con_map structures of the local cells. Every node writes its own
+ * file after the parameters have been read from the parameter file. A later
+ * run with the same model setup, parameter file and domain decomposition maps
+ * the files and copies the structures instead of reading, scattering and
+ * deriving the parameters again.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_image.h>
+
+/******************************************************************************
+ * @brief    Add a block of memory to a 64-bit FNV-1a hash
+ *****************************************************************************/
+uint64_t
+param_cache_hash(uint64_t hash,
+                 void    *data,
+                 size_t   size)
+{
+    unsigned char *bytes = data;
+    size_t         i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= PARAM_CACHE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * @brief    Set the parameter cache header of the local node (collective)
+ * @details  The key covers the model options and parameters, the name, size
+ *           and modification time of the parameter file (as seen by the
+ *           master node) and the grid cells of the local node. The option
+ *           and parameter structures are hashed as raw bytes, which relies
+ *           on initialize_options and initialize_parameters clearing them.
+ *****************************************************************************/
+void
+set_param_cache_header(param_cache_header_struct *header)
+{
+    extern MPI_Comm            MPI_COMM_VIC;
+    extern domain_struct       global_domain;
+    extern domain_struct       local_domain;
+    extern filenames_struct    filenames;
+    extern option_struct       options;
+    extern parameters_struct   param;
+    extern veg_con_map_struct *veg_con_map;
+    extern int                 mpi_rank;
+    extern int                 mpi_size;
+
+    struct stat                file_stat;
+    uint64_t                   file_key;
+    long long                  file_info[2];
+    int                        status;
+
+    size_t                     i;
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, PARAM_CACHE_MAGIC, sizeof(header->magic));
+    header->version = PARAM_CACHE_VERSION;
+    header->mpi_size = (size_t) mpi_size;
+    header->mpi_rank = (size_t) mpi_rank;
+    header->ncells = local_domain.ncells_active;
+    header->ntiles = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        header->ntiles += veg_con_map[i].nv_active;
+    }
+
+    // parameter file
+    file_key = PARAM_CACHE_FNV_BASIS;
+    if (mpi_rank == VIC_MPI_ROOT) {
+        if (stat(filenames.params.nc_filename, &file_stat) != 0) {
+            log_err("Cannot stat %s", filenames.params.nc_filename);
+        }
+        file_info[0] = (long long) file_stat.st_size;
+        file_info[1] = (long long) file_stat.st_mtime;
+        file_key = param_cache_hash(file_key, filenames.params.nc_filename,
+                                    strlen(filenames.params.nc_filename));
+        file_key = param_cache_hash(file_key, file_info, sizeof(file_info));
+    }
+    status = MPI_Bcast(&file_key, 1, MPI_UINT64_T, VIC_MPI_ROOT,
+                       MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // model setup and local cells
+    header->key = param_cache_hash(file_key, &options, sizeof(options));
+    header->key = param_cache_hash(header->key, &param, sizeof(param));
+    header->key = param_cache_hash(header->key, &(global_domain.n_nx),
+                                   sizeof(global_domain.n_nx));
+    header->key = param_cache_hash(header->key, &(global_domain.n_ny),
+                                   sizeof(global_domain.n_ny));
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        header->key = param_cache_hash(header->key,
+                                       &(local_domain.locations[i].io_idx),
+                                       sizeof(size_t));
+        header->key = param_cache_hash(header->key,
+                                       &(local_domain.locations[i].nveg),
+                                       sizeof(size_t));
+    }
+
+    header->nbytes = sizeof(*header) +
+                     header->ncells * sizeof(soil_con_struct) +
+                     header->ncells * options.SNOW_BAND *
+                     (4 * sizeof(double) + sizeof(bool)) +
+                     header->ncells * options.NVEGTYPES *
+                     (sizeof(veg_lib_struct) + sizeof(double) + sizeof(int)) +
+                     header->ntiles * sizeof(veg_con_struct) +
+                     header->ntiles * 2 * options.ROOT_ZONES * sizeof(double);
+    if (options.CARBON) {
+        header->nbytes += header->ntiles * options.Ncanopy * sizeof(double);
+    }
+}
+
+/******************************************************************************
+ * @brief    Copy the parameters of a local node from a parameter cache
+ * @details  soil_con and veg_con keep their own pointers to the snow band,
+ *           root zone and canopy layer arrays, the values of these arrays
+ *           follow the structures.
+ *****************************************************************************/
+void
+param_cache_unpack(char *data)
+{
+    extern domain_struct       local_domain;
+    extern option_struct       options;
+    extern soil_con_struct    *soil_con;
+    extern veg_con_map_struct *veg_con_map;
+    extern veg_con_struct    **veg_con;
+    extern veg_lib_struct    **veg_lib;
+
+    soil_con_struct            cell;
+    veg_con_struct             tile;
+    size_t                     nbands;
+    size_t                     nzones;
+
+    size_t                     i;
+    size_t                     j;
+
+    nbands = options.SNOW_BAND * sizeof(double);
+    nzones = options.ROOT_ZONES * sizeof(double);
+
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        cell = soil_con[i];
+        memcpy(&(soil_con[i]), data, sizeof(soil_con_struct));
+        data += sizeof(soil_con_struct);
+        soil_con[i].AboveTreeLine = cell.AboveTreeLine;
+        soil_con[i].AreaFract = cell.AreaFract;
+        soil_con[i].BandElev = cell.BandElev;
+        soil_con[i].Pfactor = cell.Pfactor;
+        soil_con[i].Tfactor = cell.Tfactor;
+        memcpy(soil_con[i].AreaFract, data, nbands);
+        data += nbands;
+        memcpy(soil_con[i].BandElev, data, nbands);
+        data += nbands;
+        memcpy(soil_con[i].Pfactor, data, nbands);
+        data += nbands;
+        memcpy(soil_con[i].Tfactor, data, nbands);
+        data += nbands;
+        memcpy(soil_con[i].AboveTreeLine, data,
+               options.SNOW_BAND * sizeof(bool));
+        data += options.SNOW_BAND * sizeof(bool);
+        memcpy(veg_lib[i], data, options.NVEGTYPES * sizeof(*(veg_lib[i])));
+        data += options.NVEGTYPES * sizeof(*(veg_lib[i]));
+        memcpy(veg_con_map[i].Cv, data, options.NVEGTYPES * sizeof(double));
+        data += options.NVEGTYPES * sizeof(double);
+        memcpy(veg_con_map[i].vidx, data, options.NVEGTYPES * sizeof(int));
+        data += options.NVEGTYPES * sizeof(int);
+        for (j = 0; j < veg_con_map[i].nv_active; j++) {
+            tile = veg_con[i][j];
+            memcpy(&(veg_con[i][j]), data, sizeof(veg_con_struct));
+            data += sizeof(veg_con_struct);
+            veg_con[i][j].CanopLayerBnd = tile.CanopLayerBnd;
+            veg_con[i][j].zone_depth = tile.zone_depth;
+            veg_con[i][j].zone_fract = tile.zone_fract;
+            memcpy(veg_con[i][j].zone_depth, data, nzones);
+            data += nzones;
+            memcpy(veg_con[i][j].zone_fract, data, nzones);
+            data += nzones;
+            if (options.CARBON) {
+                memcpy(veg_con[i][j].CanopLayerBnd, data,
+                       options.Ncanopy * sizeof(double));
+                data += options.Ncanopy * sizeof(double);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Read the parameters from the parameter cache (collective)
+ * @details  Returns true if the cache files of all nodes match the current
+ *           model setup and domain decomposition and the parameters have been
+ *           copied; otherwise nothing is changed and the parameters have to
+ *           be read from the parameter file.
+ *****************************************************************************/
+bool
+get_param_cache(void)
+{
+    extern MPI_Comm           MPI_COMM_VIC;
+    extern filenames_struct   filenames;
+    extern int                mpi_rank;
+
+    param_cache_header_struct expected;
+    param_cache_header_struct header;
+    char                      rank_filename[MAXSTRING];
+    char                     *data = NULL;
+    struct stat               file_stat;
+    int                       fd;
+    int                       valid = 0;
+    int                       all_valid;
+    int                       status;
+
+    if (strcasecmp(filenames.param_cache, "MISSING") == 0) {
+        return false;
+    }
+
+    set_param_cache_header(&expected);
+    set_param_cache_rank_filename(rank_filename);
+
+    fd = open(rank_filename, O_RDONLY);
+    if (fd >= 0) {
+        if (fstat(fd, &file_stat) == 0 &&
+            (size_t) file_stat.st_size == expected.nbytes) {
+            data = mmap(NULL, expected.nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                data = NULL;
+            }
+        }
+        if (data != NULL) {
+            memcpy(&header, data, sizeof(header));
+            valid = memcmp(&header, &expected, sizeof(header)) == 0;
+        }
+    }
+
+    status = MPI_Allreduce(&valid, &all_valid, 1, MPI_INT, MPI_MIN,
+                           MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (all_valid) {
+        param_cache_unpack(data + sizeof(header));
+        if (mpi_rank == VIC_MPI_ROOT) {
+            log_info("Read soil and vegetation parameters from parameter "
+                     "cache %s", filenames.param_cache);
+        }
+    }
+    else if (mpi_rank == VIC_MPI_ROOT) {
+        log_info("Parameter cache %s is missing or does not match the "
+                 "current setup and will be rewritten", filenames.param_cache);
+    }
+
+    if (data != NULL) {
+        munmap(data, expected.nbytes);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    return all_valid != 0;
+}
+
+/******************************************************************************
+ * @brief    Write the parameters of the local node to the parameter cache
+ *           (collective)
+ *****************************************************************************/
+void
+put_param_cache(void)
+{
+    extern domain_struct       local_domain;
+    extern filenames_struct    filenames;
+    extern option_struct       options;
+    extern soil_con_struct    *soil_con;
+    extern veg_con_map_struct *veg_con_map;
+    extern veg_con_struct    **veg_con;
+    extern veg_lib_struct    **veg_lib;
+
+    param_cache_header_struct  header;
+    char                       rank_filename[MAXSTRING];
+    FILE                      *fp;
+    size_t                     nwritten;
+    size_t                     nexpected;
+
+    size_t                     i;
+    size_t                     j;
+
+    if (strcasecmp(filenames.param_cache, "MISSING") == 0) {
+        return;
+    }
+
+    set_param_cache_header(&header);
+    set_param_cache_rank_filename(rank_filename);
+
+    fp = open_file(rank_filename, "wb");
+
+    nwritten = fwrite(&header, sizeof(header), 1, fp);
+    nexpected = 1;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        nwritten += fwrite(&(soil_con[i]), sizeof(soil_con_struct), 1, fp);
+        nwritten += fwrite(soil_con[i].AreaFract, sizeof(double),
+                           options.SNOW_BAND, fp);
+        nwritten += fwrite(soil_con[i].BandElev, sizeof(double),
+                           options.SNOW_BAND, fp);
+        nwritten += fwrite(soil_con[i].Pfactor, sizeof(double),
+                           options.SNOW_BAND, fp);
+        nwritten += fwrite(soil_con[i].Tfactor, sizeof(double),
+                           options.SNOW_BAND, fp);
+        nwritten += fwrite(soil_con[i].AboveTreeLine, sizeof(bool),
+                           options.SNOW_BAND, fp);
+        nexpected += 1 + 5 * options.SNOW_BAND;
+        nwritten += fwrite(veg_lib[i], sizeof(*(veg_lib[i])),
+                           options.NVEGTYPES, fp);
+        nwritten += fwrite(veg_con_map[i].Cv, sizeof(double),
+                           options.NVEGTYPES, fp);
+        nwritten += fwrite(veg_con_map[i].vidx, sizeof(int),
+                           options.NVEGTYPES, fp);
+        nexpected += 3 * options.NVEGTYPES;
+        for (j = 0; j < veg_con_map[i].nv_active; j++) {
+            nwritten += fwrite(&(veg_con[i][j]), sizeof(veg_con_struct), 1,
+                               fp);
+            nwritten += fwrite(veg_con[i][j].zone_depth, sizeof(double),
+                               options.ROOT_ZONES, fp);
+            nwritten += fwrite(veg_con[i][j].zone_fract, sizeof(double),
+                               options.ROOT_ZONES, fp);
+            nexpected += 1 + 2 * options.ROOT_ZONES;
+            if (options.CARBON) {
+                nwritten += fwrite(veg_con[i][j].CanopLayerBnd,
+                                   sizeof(double), options.Ncanopy, fp);
+                nexpected += options.Ncanopy;
+            }
+        }
+    }
+    if (nwritten != nexpected) {
+        log_err("Error writing parameter cache %s", rank_filename);
+    }
+
+    if (fclose(fp) != 0) {
+        log_err("Error closing parameter cache %s", rank_filename);
+    }
+}
+
+/******************************************************************************
+ * @brief    Set the file name of the parameter cache file of the local node
+ *****************************************************************************/
+void
+set_param_cache_rank_filename(char *rank_filename)
+{
+    extern filenames_struct filenames;
+    extern int              mpi_rank;
+
+    int                     status;
+
+    status = snprintf(rank_filename, MAXSTRING, "%s.%d",
+                      filenames.param_cache, mpi_rank);
+    if (status >= MAXSTRING) {
+        log_err("Parameter cache file name %s.%d is too large [%d]",
+                filenames.param_cache, mpi_rank, status);
+    }
+}
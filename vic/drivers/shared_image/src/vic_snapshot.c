@@ -0,0 +1,249 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Model state snapshots. A snapshot is an in-memory copy of the model state
+ * that is written as a checkpoint in a background thread while the
+ * simulation continues. Only the most recent snapshots are kept on disk.
+ *
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_image.h>
+
+/******************************************************************************
+ * @brief    Set up the snapshot writer
+ *****************************************************************************/
+void
+snapshot_writer_init(dmy_struct *dmy_current)
+{
+    extern global_param_struct    global_param;
+    extern domain_struct          local_domain;
+    extern snapshot_writer_struct snapshot_writer;
+
+    size_t                        i;
+
+    snapshot_writer.pending = false;
+    snapshot_writer.running = false;
+    snapshot_writer.nkept = 0;
+    snapshot_writer.index = NULL;
+    snapshot_writer.values = NULL;
+    snapshot_writer.kept = NULL;
+
+    if (global_param.snapshot_freq == FREQ_NEVER) {
+        return;
+    }
+
+    set_alarm(dmy_current, global_param.snapshot_freq,
+              &(global_param.snapshot_n), &(snapshot_writer.alarm));
+
+    // the number of state values per cell does not change during the run
+    snapshot_writer.index = malloc((local_domain.ncells_active + 1) *
+                                   sizeof(*snapshot_writer.index));
+    check_alloc_status(snapshot_writer.index, "Memory allocation error");
+    snapshot_writer.nvalues = set_checkpoint_index(snapshot_writer.index);
+    snapshot_writer.values = malloc((snapshot_writer.nvalues + 1) *
+                                    sizeof(*snapshot_writer.values));
+    check_alloc_status(snapshot_writer.values, "Memory allocation error");
+
+    snapshot_writer.kept = malloc(global_param.snapshot_keep *
+                                  sizeof(*snapshot_writer.kept));
+    check_alloc_status(snapshot_writer.kept, "Memory allocation error");
+    for (i = 0; i < global_param.snapshot_keep; i++) {
+        snapshot_writer.kept[i] = malloc(MAXSTRING *
+                                         sizeof(*snapshot_writer.kept[i]));
+        check_alloc_status(snapshot_writer.kept[i], "Memory allocation error");
+    }
+
+    pthread_mutex_init(&(snapshot_writer.lock), NULL);
+}
+
+/******************************************************************************
+ * @brief    Take a snapshot of the model state
+ * @details  The state is copied to memory, after which the checkpoint file of
+ *           this node is written in the background. The previous snapshot is
+ *           completed first.
+ *****************************************************************************/
+void
+vic_snapshot(dmy_struct *dmy_state)
+{
+    extern snapshot_writer_struct snapshot_writer;
+    extern int                    mpi_rank;
+
+    int                           status;
+
+    snapshot_writer_complete();
+
+    snapshot_writer.dmy = (*dmy_state);
+    set_checkpoint_filename(dmy_state, snapshot_writer.filename);
+    if (mpi_rank == VIC_MPI_ROOT) {
+        debug("taking snapshot: %s", snapshot_writer.filename);
+    }
+
+    checkpoint_pack(snapshot_writer.values);
+
+    snapshot_writer.written = false;
+    snapshot_writer.pending = true;
+    status = pthread_create(&(snapshot_writer.thread), NULL,
+                            snapshot_writer_thread, NULL);
+    if (status != 0) {
+        log_err("Error creating snapshot writer thread: %d", status);
+    }
+    snapshot_writer.running = true;
+}
+
+/******************************************************************************
+ * @brief    Background writer: write the checkpoint file of this node
+ *****************************************************************************/
+void *
+snapshot_writer_thread(void *arg)
+{
+    extern domain_struct          local_domain;
+    extern snapshot_writer_struct snapshot_writer;
+    extern int                    mpi_rank;
+
+    checkpoint_header_struct      header;
+    char                          rank_filename[MAXSTRING];
+
+    UNUSED(arg);
+
+    instrument_set_thread(INSTR_THREAD_SNAPSHOT_WRITER);
+
+    set_checkpoint_rank_filename(snapshot_writer.filename, (size_t) mpi_rank,
+                                 rank_filename);
+    set_checkpoint_header(&header, &(snapshot_writer.dmy),
+                          local_domain.ncells_active);
+    INSTRUMENT_BEGIN(INSTR_STATE);
+    put_checkpoint_file(rank_filename, &header, snapshot_writer.index,
+                        snapshot_writer.values, snapshot_writer.nvalues);
+    INSTRUMENT_END(INSTR_STATE);
+
+    pthread_mutex_lock(&(snapshot_writer.lock));
+    snapshot_writer.written = true;
+    pthread_mutex_unlock(&(snapshot_writer.lock));
+
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief    Complete the pending snapshot once all nodes have written it
+ * @details  Collective, called every time step. Does not wait for the
+ *           background writers.
+ *****************************************************************************/
+void
+snapshot_writer_poll(void)
+{
+    extern snapshot_writer_struct snapshot_writer;
+    extern MPI_Comm               MPI_COMM_VIC;
+
+    int                           written;
+    int                           all_written;
+    int                           status;
+
+    if (!snapshot_writer.pending) {
+        return;
+    }
+
+    pthread_mutex_lock(&(snapshot_writer.lock));
+    written = snapshot_writer.written ? 1 : 0;
+    pthread_mutex_unlock(&(snapshot_writer.lock));
+
+    status = MPI_Allreduce(&written, &all_written, 1, MPI_INT, MPI_MIN,
+                           MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (all_written == 1) {
+        snapshot_writer_complete();
+    }
+}
+
+/******************************************************************************
+ * @brief    Complete the pending snapshot (collective)
+ * @details  Waits for the background writer, writes the manifest and removes
+ *           the oldest snapshot if more than SNAPSHOT_KEEP snapshots are on
+ *           disk.
+ *****************************************************************************/
+void
+snapshot_writer_complete(void)
+{
+    extern global_param_struct    global_param;
+    extern snapshot_writer_struct snapshot_writer;
+
+    char                         *oldest;
+    int                           status;
+
+    size_t                        i;
+
+    if (!snapshot_writer.pending) {
+        return;
+    }
+
+    if (snapshot_writer.running) {
+        status = pthread_join(snapshot_writer.thread, NULL);
+        if (status != 0) {
+            log_err("Error joining snapshot writer thread: %d", status);
+        }
+        snapshot_writer.running = false;
+    }
+
+    put_checkpoint_manifest(snapshot_writer.filename, &(snapshot_writer.dmy));
+    snapshot_writer.pending = false;
+
+    // keep the most recent snapshots, the oldest one is replaced
+    if (snapshot_writer.nkept == global_param.snapshot_keep) {
+        oldest = snapshot_writer.kept[0];
+        remove_checkpoint(oldest);
+        for (i = 1; i < snapshot_writer.nkept; i++) {
+            snapshot_writer.kept[i - 1] = snapshot_writer.kept[i];
+        }
+        snapshot_writer.kept[snapshot_writer.nkept - 1] = oldest;
+        snapshot_writer.nkept--;
+    }
+    strcpy(snapshot_writer.kept[snapshot_writer.nkept],
+           snapshot_writer.filename);
+    snapshot_writer.nkept++;
+}
+
+/******************************************************************************
+ * @brief    Complete the pending snapshot and free the snapshot writer
+ *****************************************************************************/
+void
+snapshot_writer_finalize(void)
+{
+    extern global_param_struct    global_param;
+    extern snapshot_writer_struct snapshot_writer;
+
+    size_t                        i;
+
+    if (global_param.snapshot_freq == FREQ_NEVER) {
+        return;
+    }
+
+    snapshot_writer_complete();
+
+    for (i = 0; i < global_param.snapshot_keep; i++) {
+        free(snapshot_writer.kept[i]);
+    }
+    free(snapshot_writer.kept);
+    free(snapshot_writer.index);
+    free(snapshot_writer.values);
+    pthread_mutex_destroy(&(snapshot_writer.lock));
+}
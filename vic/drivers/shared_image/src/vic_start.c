@@ -39,7 +39,9 @@ vic_start(void)
     location_struct           *active_locations = NULL;
     size_t                     i;
     extern size_t             *filter_active_cells;
+    extern double             *decomp_cost;
     extern size_t             *mpi_map_mapping_array;
+    extern mpi_slab_struct     mpi_local_slab;
     extern filenames_struct    filenames;
     extern filep_struct        filep;
     extern domain_struct       global_domain;
@@ -118,6 +120,11 @@ vic_start(void)
             }
         }
 
+        // read the measured cost per cell to balance the decomposition
+        if (strcasecmp(filenames.decomp_cost.nc_filename, "MISSING") != 0) {
+            get_decomp_cost();
+        }
+
         // decompose the mask
         mpi_map_decomp_domain(global_domain.ncells_active, mpi_size,
                               &mpi_map_local_array_sizes,
@@ -130,6 +137,9 @@ vic_start(void)
                                      &mpi_map_global_array_offsets,
                                      &mpi_map_mapping_array);
 
+        free(decomp_cost);
+        decomp_cost = NULL;
+
         // get dimensions (number of vegetation types, soil zones, etc)
         options.ROOT_ZONES = get_nc_dimension(&(filenames.params), "root_zone");
         options.Nlayer = get_nc_dimension(&(filenames.params), "nlayer");
@@ -146,6 +156,13 @@ vic_start(void)
         if (options.LAKES) {
             options.NLAKENODES = get_nc_dimension(&(filenames.params),
                                                   "lake_node");
+            if (options.NLAKENODES >= MAX_LAKE_NODES) {
+                log_err("The lake_node dimension (%zu) must be smaller "
+                        "than MAX_LAKE_NODES (%d). Recompile with a larger "
+                        "MAX_LAKE_NODES (e.g. make MAX_LAKE_NODES=%zu).",
+                        options.NLAKENODES, MAX_LAKE_NODES,
+                        options.NLAKENODES + 1);
+            }
         }
 
         // plugin start
@@ -179,6 +196,16 @@ vic_start(void)
     plugin_broadcast_options();
     plugin_broadcast_params();
 
+    // broadcast the grid dimensions, these are needed by the nodes to locate
+    // their cells in the global grid
+    status = MPI_Bcast(&(global_domain.n_nx), 1, MPI_UNSIGNED_LONG,
+                       VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    status = MPI_Bcast(&(global_domain.n_ny), 1, MPI_UNSIGNED_LONG,
+                       VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
     // setup the local domain_structs
 
     // First scatter the array sizes
@@ -243,6 +270,9 @@ vic_start(void)
         local_domain.locations[i].local_idx = i;
     }
 
+    // determine the hyperslab of the global grid covering the local cells
+    mpi_map_local_slab(&mpi_local_slab);
+
     // cleanup
     if (mpi_rank == VIC_MPI_ROOT) {
         free(mapped_locations);
@@ -1648,17 +1648,9 @@ initialize_state_file(char           *filename,
                         filename);
 
         // define netcdf dimensions
-        status = nc_def_dim(nc_state_file->nc_id, global_domain.info.x_dim,
-                            nc_state_file->ni_size, &(nc_state_file->ni_dimid));
-        check_nc_status(status, "Error defining \"%s\" in %s",
-                        global_domain.info.x_dim,
-                        filename);
-
-        status = nc_def_dim(nc_state_file->nc_id, global_domain.info.y_dim,
-                            nc_state_file->nj_size, &(nc_state_file->nj_dimid));
-        check_nc_status(status, "Error defining \"%s\" in %s",
-                        global_domain.info.y_dim,
-                        filename);
+        define_nc_grid_dims(nc_state_file->nc_id, filename,
+                            &(nc_state_file->ni_dimid),
+                            &(nc_state_file->nj_dimid));
 
         status = nc_def_dim(nc_state_file->nc_id, "veg_class",
                             nc_state_file->veg_size,
@@ -1708,67 +1700,9 @@ initialize_state_file(char           *filename,
 
     // Coordinate variables
     if (mpi_rank == VIC_MPI_ROOT) {
-        ndims = global_domain.info.n_coord_dims;
-        dstart[0] = 0;
-        dstart[1] = 0;
-
-        if (global_domain.info.n_coord_dims == 1) {
-            dimids[0] = nc_state_file->ni_dimid;
-            dcount[0] = nc_state_file->ni_size;
-        }
-        else if (global_domain.info.n_coord_dims == 2) {
-            dimids[0] = nc_state_file->nj_dimid;
-            dcount[0] = nc_state_file->nj_size;
-
-            dimids[1] = nc_state_file->ni_dimid;
-            dcount[1] = nc_state_file->ni_size;
-        }
-        else {
-            log_err("COORD_DIMS_OUT should be 1 or 2");
-        }
-    }
-
-    // define the netcdf variable longitude
-    if (mpi_rank == VIC_MPI_ROOT) {
-        status = nc_def_var(nc_state_file->nc_id, global_domain.info.lon_var,
-                            NC_DOUBLE, ndims, dimids, &(lon_var_id));
-        check_nc_status(status, "Error defining lon variable in %s", filename);
-
-        status = nc_put_att_text(nc_state_file->nc_id, lon_var_id, "long_name", strlen(
-                                     "longitude"), "longitude");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-        status = nc_put_att_text(nc_state_file->nc_id, lon_var_id, "units", strlen(
-                                     "degrees_east"), "degrees_east");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-        status = nc_put_att_text(nc_state_file->nc_id, lon_var_id,
-                                 "standard_name", strlen(
-                                     "longitude"), "longitude");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-
-        if (global_domain.info.n_coord_dims == 1) {
-            dimids[0] = nc_state_file->nj_dimid;
-            dcount[0] = nc_state_file->nj_size;
-        }
-
-        // define the netcdf variable latitude
-        status = nc_def_var(nc_state_file->nc_id, global_domain.info.lat_var,
-                            NC_DOUBLE, ndims, dimids, &(lat_var_id));
-        check_nc_status(status, "Error defining lat variable (%s) in %s",
-                        global_domain.info.lat_var, filename);
-        status = nc_put_att_text(nc_state_file->nc_id, lat_var_id, "long_name", strlen(
-                                     "latitude"), "latitude");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-        status = nc_put_att_text(nc_state_file->nc_id, lat_var_id, "units", strlen(
-                                     "degrees_north"), "degrees_north");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-        status = nc_put_att_text(nc_state_file->nc_id, lat_var_id,
-                                 "standard_name", strlen("latitude"),
-                                 "latitude");
-        check_nc_status(status, "Error adding attribute in %s", filename);
-        for (i = 0; i < MAXDIMS; i++) {
-            dimids[i] = -1;
-            dcount[i] = 0;
-        }
+        define_nc_coord_vars(nc_state_file->nc_id, filename,
+                             nc_state_file->ni_dimid, nc_state_file->nj_dimid,
+                             &lon_var_id, &lat_var_id);
 
         // veg_class
         dimids[0] = nc_state_file->veg_dimid;
@@ -1977,67 +1911,8 @@ initialize_state_file(char           *filename,
 
     // populate lat/lon
     if (mpi_rank == VIC_MPI_ROOT) {
-        if (global_domain.info.n_coord_dims == 1) {
-            dvar = calloc(nc_state_file->ni_size, sizeof(*dvar));
-            check_alloc_status(dvar, "Memory allocation error");
-
-            dcount[0] = nc_state_file->ni_size;
-            // implicitly nested loop over ni and nj with j set to 0
-            for (i = 0; i < nc_state_file->ni_size; i++) {
-                dvar[i] = (double) global_domain.locations[i].longitude;
-            }
-            status = nc_put_vara_double(nc_state_file->nc_id, lon_var_id,
-                                        dstart,
-                                        dcount, dvar);
-            check_nc_status(status, "Error adding data to lon in %s", filename);
-            free(dvar);
-
-            dvar = calloc(nc_state_file->nj_size, sizeof(*dvar));
-            check_alloc_status(dvar, "Memory allocation error");
-            dcount[0] = nc_state_file->nj_size;
-            // implicitly nested loop over ni and nj with i set to 0;
-            // j stride = ni_size
-            for (j = 0; j < nc_state_file->nj_size; j++) {
-                dvar[j] =
-                    (double) global_domain.locations[j *
-                                                     nc_state_file->ni_size].
-                    latitude;
-            }
-
-            status = nc_put_vara_double(nc_state_file->nc_id, lat_var_id,
-                                        dstart,
-                                        dcount, dvar);
-            check_nc_status(status, "Error adding data to lon in %s", filename);
-            free(dvar);
-        }
-        else if (global_domain.info.n_coord_dims == 2) {
-            dvar = calloc(global_domain.ncells_total, sizeof(*dvar));
-            check_alloc_status(dvar, "Memory allocation error");
-            dcount[0] = nc_state_file->nj_size;
-            dcount[1] = nc_state_file->ni_size;
-
-            for (i = 0; i < global_domain.ncells_total; i++) {
-                dvar[i] = (double) global_domain.locations[i].longitude;
-            }
-            status = nc_put_vara_double(nc_state_file->nc_id, lon_var_id,
-                                        dstart,
-                                        dcount, dvar);
-            check_nc_status(status, "Error adding data to lon in %s", filename);
-
-            for (i = 0; i < global_domain.ncells_total;
-                 i++) {
-                dvar[i] = (double) global_domain.locations[i].latitude;
-            }
-            status = nc_put_vara_double(nc_state_file->nc_id, lat_var_id,
-                                        dstart,
-                                        dcount, dvar);
-            check_nc_status(status, "Error adding data to lat in %s", filename);
-
-            free(dvar);
-        }
-        else {
-            log_err("COORD_DIMS_OUT should be 1 or 2");
-        }
+        put_nc_coord_vars(nc_state_file->nc_id, filename, lon_var_id,
+                          lat_var_id);
     }
 
     // Variables for other dimensions (all 1-dimensional)
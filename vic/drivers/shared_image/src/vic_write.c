@@ -42,8 +42,13 @@ vic_write_output(dmy_struct *dmy)
     for (stream_idx = 0; stream_idx < options.Noutstreams; stream_idx++) {
         if (raise_alarm(&(output_streams[stream_idx].agg_alarm), dmy)) {
             debug("raised alarm for stream %zu", stream_idx);
-            vic_write(&(output_streams[stream_idx]),
-                      &(nc_hist_files[stream_idx]), dmy);
+            if (options.OUTPUT_ASYNC) {
+                vic_write_async(stream_idx, dmy);
+            }
+            else {
+                vic_write(&(output_streams[stream_idx]),
+                          &(nc_hist_files[stream_idx]), dmy);
+            }
             reset_stream(&(output_streams[stream_idx]), dmy);
         }
     }
@@ -68,7 +73,7 @@ vic_write(stream_struct  *stream,
     size_t                     k;
     size_t                     ndims;
     double                     dtime;
-    double                    *dvar = NULL;
+    double                    *agg;
     float                     *fvar = NULL;
     int                       *ivar = NULL;
     short int                 *svar = NULL;
@@ -97,14 +102,9 @@ vic_write(stream_struct  *stream,
     for (k = 0; k < stream->nvars; k++) {
         varid = stream->varid[k];
 
-        if (nc_hist_file->nc_vars[k].nc_type == NC_DOUBLE) {
-            if (dvar == NULL) {
-                // allocate memory for variables to be stored
-                dvar = malloc(local_domain.ncells_active * sizeof(*dvar));
-                check_alloc_status(dvar, "Memory allocation error");
-            }
-        }
-        else if (nc_hist_file->nc_vars[k].nc_type == NC_FLOAT) {
+        // NC_DOUBLE values are written straight from the stream, the other
+        // types need a conversion buffer
+        if (nc_hist_file->nc_vars[k].nc_type == NC_FLOAT) {
             if (fvar == NULL) {
                 // allocate memory for variables to be stored
                 fvar = malloc(local_domain.ncells_active * sizeof(*fvar));
@@ -132,7 +132,7 @@ vic_write(stream_struct  *stream,
                 check_alloc_status(cvar, "Memory allocation error");
             }
         }
-        else {
+        else if (nc_hist_file->nc_vars[k].nc_type != NC_DOUBLE) {
             log_err("Unsupported nc_type encountered");
         }
 
@@ -152,18 +152,18 @@ vic_write(stream_struct  *stream,
         for (j = 0; j < out_metadata[varid].nelem; j++) {
             // if there is more than one layer, then dstart needs to advance
             dstart[1] = j;
+            // the grid cells of one value are a contiguous slice of aggdata
+            agg = &(stream->aggdata[(stream->aggoffset[k] + j) *
+                                    local_domain.ncells_active]);
             if (nc_hist_file->nc_vars[k].nc_type == NC_DOUBLE) {
-                for (i = 0; i < local_domain.ncells_active; i++) {
-                    dvar[i] = (double) stream->aggdata[i][k][j][0];
-                }
                 gather_put_nc_field_double(nc_hist_file->nc_id,
                                            nc_hist_file->nc_vars[k].nc_varid,
                                            nc_hist_file->d_fillvalue,
-                                           dstart, dcount, dvar);
+                                           dstart, dcount, agg);
             }
             else if (nc_hist_file->nc_vars[k].nc_type == NC_FLOAT) {
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    fvar[i] = (float) stream->aggdata[i][k][j][0];
+                    fvar[i] = (float) agg[i];
                 }
                 gather_put_nc_field_float(nc_hist_file->nc_id,
                                           nc_hist_file->nc_vars[k].nc_varid,
@@ -172,7 +172,7 @@ vic_write(stream_struct  *stream,
             }
             else if (nc_hist_file->nc_vars[k].nc_type == NC_INT) {
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    ivar[i] = (int) stream->aggdata[i][k][j][0];
+                    ivar[i] = (int) agg[i];
                 }
                 gather_put_nc_field_int(nc_hist_file->nc_id,
                                         nc_hist_file->nc_vars[k].nc_varid,
@@ -181,7 +181,7 @@ vic_write(stream_struct  *stream,
             }
             else if (nc_hist_file->nc_vars[k].nc_type == NC_SHORT) {
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    svar[i] = (short int) stream->aggdata[i][k][j][0];
+                    svar[i] = (short int) agg[i];
                 }
                 gather_put_nc_field_short(nc_hist_file->nc_id,
                                           nc_hist_file->nc_vars[k].nc_varid,
@@ -190,7 +190,7 @@ vic_write(stream_struct  *stream,
             }
             else if (nc_hist_file->nc_vars[k].nc_type == NC_CHAR) {
                 for (i = 0; i < local_domain.ncells_active; i++) {
-                    cvar[i] = (char) stream->aggdata[i][k][j][0];
+                    cvar[i] = (char) agg[i];
                 }
                 gather_put_nc_field_schar(nc_hist_file->nc_id,
                                           nc_hist_file->nc_vars[k].nc_varid,
@@ -236,9 +236,11 @@ vic_write(stream_struct  *stream,
                                       global_param.calendar,
                                       global_param.time_units);
 
+        INSTRUMENT_BEGIN(INSTR_NC_WRITE);
         status = nc_put_vara_double(nc_hist_file->nc_id,
                                     nc_hist_file->time_bounds_varid,
                                     dstart, dcount, bounds);
+        INSTRUMENT_END(INSTR_NC_WRITE);
         check_nc_status(status, "Error writing time bounds variable");
     }
 
@@ -263,9 +265,6 @@ vic_write(stream_struct  *stream,
     }
 
     // free memory
-    if (dvar != NULL) {
-        free(dvar);
-    }
     if (fvar != NULL) {
         free(fvar);
     }
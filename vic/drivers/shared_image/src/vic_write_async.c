@@ -0,0 +1,611 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Asynchronous history writer.
+ *
+ * When options.OUTPUT_ASYNC is set, the aggregated data of an output stream
+ * is packed into a send buffer and gathered to the master node with a single
+ * non-blocking MPI_Igatherv. The gather is completed before the next time
+ * step is computed and the master node then writes the gathered data to the
+ * history file in a background thread while the model computes. Every stream
+ * has HIST_WRITE_NBUF buffers, so that the stream can be reset and the next
+ * write posted while a previous write is still in flight.
+ *
+ * The writer thread only makes netCDF calls and holds nc_io_lock while doing
+ * so, all MPI calls are made from the main thread.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_image.h>
+
+/******************************************************************************
+ * @brief    Allocate the buffers of the asynchronous history writer
+ *****************************************************************************/
+void
+hist_writer_init(void)
+{
+    extern domain_struct      global_domain;
+    extern hist_writer_struct hist_writer;
+    extern domain_struct      local_domain;
+    extern int                mpi_rank;
+    extern int                mpi_size;
+    extern int               *mpi_map_global_array_offsets;
+    extern int               *mpi_map_local_array_sizes;
+    extern size_t            *filter_active_cells;
+    extern size_t            *mpi_map_mapping_array;
+    extern option_struct      options;
+    extern metadata_struct    out_metadata[];
+    extern stream_struct     *output_streams;
+
+    size_t                    i;
+    size_t                    k;
+    size_t                    s;
+    hist_write_struct        *hist_write;
+
+    hist_writer.nstreams = 0;
+    hist_writer.running = false;
+    if (!options.OUTPUT_ASYNC) {
+        return;
+    }
+
+    hist_writer.nstreams = options.Noutstreams;
+    hist_writer.nvalues = malloc(hist_writer.nstreams *
+                                 sizeof(*hist_writer.nvalues));
+    check_alloc_status(hist_writer.nvalues, "Memory allocation error.");
+    hist_writer.next = malloc(hist_writer.nstreams *
+                              sizeof(*hist_writer.next));
+    check_alloc_status(hist_writer.next, "Memory allocation error.");
+    hist_writer.writes = malloc(hist_writer.nstreams *
+                                sizeof(*hist_writer.writes));
+    check_alloc_status(hist_writer.writes, "Memory allocation error.");
+    if (mpi_rank == VIC_MPI_ROOT) {
+        hist_writer.recv_sizes = malloc(hist_writer.nstreams *
+                                        sizeof(*hist_writer.recv_sizes));
+        check_alloc_status(hist_writer.recv_sizes, "Memory allocation error.");
+        hist_writer.recv_offsets = malloc(hist_writer.nstreams *
+                                          sizeof(*hist_writer.recv_offsets));
+        check_alloc_status(hist_writer.recv_offsets,
+                           "Memory allocation error.");
+    }
+
+    for (s = 0; s < hist_writer.nstreams; s++) {
+        hist_writer.nvalues[s] = 0;
+        for (k = 0; k < output_streams[s].nvars; k++) {
+            hist_writer.nvalues[s] +=
+                out_metadata[output_streams[s].varid[k]].nelem;
+        }
+        hist_writer.next[s] = 0;
+
+        hist_writer.writes[s] = malloc(HIST_WRITE_NBUF *
+                                       sizeof(*(hist_writer.writes[s])));
+        check_alloc_status(hist_writer.writes[s], "Memory allocation error.");
+        for (i = 0; i < HIST_WRITE_NBUF; i++) {
+            hist_write = &(hist_writer.writes[s][i]);
+            hist_write->pending = false;
+            hist_write->gathered = false;
+            hist_write->request = MPI_REQUEST_NULL;
+            // allocate at least one element for nodes without active cells
+            hist_write->sendbuf = malloc((hist_writer.nvalues[s] *
+                                          local_domain.ncells_active + 1) *
+                                         sizeof(*(hist_write->sendbuf)));
+            check_alloc_status(hist_write->sendbuf, "Memory allocation error.");
+            hist_write->recvbuf = NULL;
+            if (mpi_rank == VIC_MPI_ROOT) {
+                hist_write->recvbuf = malloc(hist_writer.nvalues[s] *
+                                             global_domain.ncells_active *
+                                             sizeof(*(hist_write->recvbuf)));
+                check_alloc_status(hist_write->recvbuf,
+                                   "Memory allocation error.");
+            }
+        }
+
+        if (mpi_rank == VIC_MPI_ROOT) {
+            // all values of a node are gathered as one block
+            hist_writer.recv_sizes[s] = malloc(mpi_size *
+                                               sizeof(*(hist_writer.
+                                                        recv_sizes[s])));
+            check_alloc_status(hist_writer.recv_sizes[s],
+                               "Memory allocation error.");
+            hist_writer.recv_offsets[s] = malloc(mpi_size *
+                                                 sizeof(*(hist_writer.
+                                                          recv_offsets[s])));
+            check_alloc_status(hist_writer.recv_offsets[s],
+                               "Memory allocation error.");
+            for (i = 0; i < (size_t) mpi_size; i++) {
+                hist_writer.recv_sizes[s][i] = hist_writer.nvalues[s] *
+                                               mpi_map_local_array_sizes[i];
+                hist_writer.recv_offsets[s][i] = hist_writer.nvalues[s] *
+                                                 mpi_map_global_array_offsets[
+                    i];
+            }
+        }
+    }
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        // index in the full grid of each active cell in gather order
+        hist_writer.cell_idx = malloc(global_domain.ncells_active *
+                                      sizeof(*hist_writer.cell_idx));
+        check_alloc_status(hist_writer.cell_idx, "Memory allocation error.");
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            hist_writer.cell_idx[i] =
+                filter_active_cells[mpi_map_mapping_array[i]];
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Post the history write of an output stream
+ * @details  Counterpart of vic_write(). The aggregated data is copied into a
+ *           write buffer and a non-blocking gather is posted, after which the
+ *           stream can be reset. The history file is opened here if needed,
+ *           the write itself happens in the background.
+ *****************************************************************************/
+void
+vic_write_async(size_t      stream_idx,
+                dmy_struct *dmy_current)
+{
+    extern global_param_struct global_param;
+    extern hist_writer_struct  hist_writer;
+    extern domain_struct       local_domain;
+    extern MPI_Comm            MPI_COMM_VIC;
+    extern int                 mpi_rank;
+    extern nc_file_struct     *nc_hist_files;
+    extern stream_struct      *output_streams;
+
+    int                        status;
+    double                     offset;
+    stream_struct             *stream;
+    nc_file_struct            *nc_hist_file;
+    hist_write_struct         *hist_write;
+
+    stream = &(output_streams[stream_idx]);
+    nc_hist_file = &(nc_hist_files[stream_idx]);
+    hist_write = &(hist_writer.writes[stream_idx][hist_writer.next[stream_idx]]);
+
+    // a buffer that is still in flight is written out first
+    if (hist_write->pending) {
+        if (!hist_write->gathered) {
+            INSTRUMENT_BEGIN(INSTR_GATHER);
+            status = MPI_Wait(&(hist_write->request), MPI_STATUS_IGNORE);
+            INSTRUMENT_END(INSTR_GATHER);
+            check_mpi_status(status, "MPI error.");
+            hist_write->gathered = true;
+        }
+        if (mpi_rank == VIC_MPI_ROOT) {
+            INSTRUMENT_BEGIN(INSTR_NC_WRITE);
+            hist_writer_put(stream_idx, hist_write);
+            INSTRUMENT_END(INSTR_NC_WRITE);
+        }
+        hist_write->pending = false;
+    }
+
+    // the aggregated data is already stored as [value][cell]
+    memcpy(hist_write->sendbuf, stream->aggdata,
+           stream->nvalues * local_domain.ncells_active *
+           sizeof(*(stream->aggdata)));
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        // If the output file is not open, initialize the history file now.
+        if (nc_hist_file->open == false) {
+            // open the netcdf history file
+            initialize_history_file(nc_hist_file, stream);
+        }
+        hist_write->nc_id = nc_hist_file->nc_id;
+        hist_write->time_idx = stream->write_alarm.count;
+
+        // timestamp is the beginning of the aggregation window
+        hist_write->time = date2num(global_param.time_origin_num,
+                                    &(stream->time_bounds[0]), 0.,
+                                    global_param.calendar,
+                                    global_param.time_units);
+        hist_write->time_bounds[0] = hist_write->time;
+        dt_seconds_to_time_units(global_param.time_units, global_param.dt,
+                                 &offset);
+        hist_write->time_bounds[1] = offset +
+                                     date2num(global_param.time_origin_num,
+                                              &(stream->time_bounds[1]), 0.,
+                                              global_param.calendar,
+                                              global_param.time_units);
+    }
+
+    INSTRUMENT_BEGIN(INSTR_GATHER);
+    status = MPI_Igatherv(hist_write->sendbuf,
+                          hist_writer.nvalues[stream_idx] *
+                          local_domain.ncells_active, MPI_DOUBLE,
+                          hist_write->recvbuf,
+                          mpi_rank == VIC_MPI_ROOT ?
+                          hist_writer.recv_sizes[stream_idx] : NULL,
+                          mpi_rank == VIC_MPI_ROOT ?
+                          hist_writer.recv_offsets[stream_idx] : NULL,
+                          MPI_DOUBLE, VIC_MPI_ROOT, MPI_COMM_VIC,
+                          &(hist_write->request));
+    INSTRUMENT_END(INSTR_GATHER);
+    check_mpi_status(status, "MPI error.");
+    hist_write->pending = true;
+    hist_write->gathered = false;
+    hist_writer.next[stream_idx] = (hist_writer.next[stream_idx] + 1) %
+                                   HIST_WRITE_NBUF;
+
+    // Advance the position in the history file
+    stream->write_alarm.count++;
+    hist_write->close = false;
+    if (raise_alarm(&(stream->write_alarm), dmy_current)) {
+        // the history file is closed after this write
+        hist_write->close = true;
+        if (mpi_rank == VIC_MPI_ROOT) {
+            nc_hist_file->open = false;
+        }
+        reset_alarm(&(stream->write_alarm), dmy_current);
+    }
+}
+
+/******************************************************************************
+ * @brief    Write gathered history data of an output stream to file
+ * @details  Only called on the master node.
+ *****************************************************************************/
+void
+hist_writer_put(size_t             stream_idx,
+                hist_write_struct *hist_write)
+{
+    extern domain_struct      global_domain;
+    extern hist_writer_struct hist_writer;
+    extern int                mpi_size;
+    extern int               *mpi_map_global_array_offsets;
+    extern int               *mpi_map_local_array_sizes;
+    extern nc_file_struct    *nc_hist_files;
+    extern pthread_mutex_t    nc_io_lock;
+    extern metadata_struct    out_metadata[];
+    extern stream_struct     *output_streams;
+
+    size_t                    grid_size;
+    size_t                    nvalues;
+    size_t                    i;
+    size_t                    j;
+    size_t                    k;
+    size_t                    r;
+    size_t                    v;
+    size_t                    ndims;
+    size_t                    dcount[MAXDIMS];
+    size_t                    dstart[MAXDIMS];
+    int                       status;
+    double                   *src;
+    double                   *dvar = NULL;
+    float                    *fvar = NULL;
+    int                      *ivar = NULL;
+    short int                *svar = NULL;
+    char                     *cvar = NULL;
+    stream_struct            *stream;
+    nc_file_struct           *nc_hist_file;
+    nc_var_struct            *nc_var;
+
+    stream = &(output_streams[stream_idx]);
+    nc_hist_file = &(nc_hist_files[stream_idx]);
+    nvalues = hist_writer.nvalues[stream_idx];
+    grid_size = global_domain.n_nx * global_domain.n_ny;
+
+    pthread_mutex_lock(&nc_io_lock);
+
+    v = 0;
+    for (k = 0; k < stream->nvars; k++) {
+        nc_var = &(nc_hist_file->nc_vars[k]);
+
+        // the grid is filled once, only the active cells change
+        if (nc_var->nc_type == NC_DOUBLE && dvar == NULL) {
+            dvar = malloc(grid_size * sizeof(*dvar));
+            check_alloc_status(dvar, "Memory allocation error");
+            for (i = 0; i < grid_size; i++) {
+                dvar[i] = nc_hist_file->d_fillvalue;
+            }
+        }
+        else if (nc_var->nc_type == NC_FLOAT && fvar == NULL) {
+            fvar = malloc(grid_size * sizeof(*fvar));
+            check_alloc_status(fvar, "Memory allocation error");
+            for (i = 0; i < grid_size; i++) {
+                fvar[i] = nc_hist_file->f_fillvalue;
+            }
+        }
+        else if (nc_var->nc_type == NC_INT && ivar == NULL) {
+            ivar = malloc(grid_size * sizeof(*ivar));
+            check_alloc_status(ivar, "Memory allocation error");
+            for (i = 0; i < grid_size; i++) {
+                ivar[i] = nc_hist_file->i_fillvalue;
+            }
+        }
+        else if (nc_var->nc_type == NC_SHORT && svar == NULL) {
+            svar = malloc(grid_size * sizeof(*svar));
+            check_alloc_status(svar, "Memory allocation error");
+            for (i = 0; i < grid_size; i++) {
+                svar[i] = nc_hist_file->s_fillvalue;
+            }
+        }
+        else if (nc_var->nc_type == NC_CHAR && cvar == NULL) {
+            cvar = malloc(grid_size * sizeof(*cvar));
+            check_alloc_status(cvar, "Memory allocation error");
+            for (i = 0; i < grid_size; i++) {
+                cvar[i] = nc_hist_file->c_fillvalue;
+            }
+        }
+
+        ndims = nc_var->nc_dims;
+        for (j = 0; j < ndims; j++) {
+            dstart[j] = 0;
+            dcount[j] = 1;
+        }
+        for (j = ndims - 2; j < ndims; j++) {
+            dcount[j] = nc_var->nc_counts[j];
+        }
+        dstart[0] = hist_write->time_idx;
+
+        for (j = 0; j < out_metadata[stream->varid[k]].nelem; j++) {
+            // if there is more than one layer, then dstart needs to advance
+            dstart[1] = j;
+            for (r = 0; r < (size_t) mpi_size; r++) {
+                src = hist_write->recvbuf +
+                      nvalues * mpi_map_global_array_offsets[r] +
+                      v * mpi_map_local_array_sizes[r];
+                for (i = 0; i < (size_t) mpi_map_local_array_sizes[r]; i++) {
+                    switch (nc_var->nc_type) {
+                    case NC_DOUBLE:
+                        dvar[hist_writer.cell_idx[
+                                 mpi_map_global_array_offsets[r] + i]] =
+                            src[i];
+                        break;
+                    case NC_FLOAT:
+                        fvar[hist_writer.cell_idx[
+                                 mpi_map_global_array_offsets[r] + i]] =
+                            (float) src[i];
+                        break;
+                    case NC_INT:
+                        ivar[hist_writer.cell_idx[
+                                 mpi_map_global_array_offsets[r] + i]] =
+                            (int) src[i];
+                        break;
+                    case NC_SHORT:
+                        svar[hist_writer.cell_idx[
+                                 mpi_map_global_array_offsets[r] + i]] =
+                            (short int) src[i];
+                        break;
+                    case NC_CHAR:
+                        cvar[hist_writer.cell_idx[
+                                 mpi_map_global_array_offsets[r] + i]] =
+                            (char) src[i];
+                        break;
+                    default:
+                        log_err("Unsupported nc_type encountered");
+                    }
+                }
+            }
+
+            if (nc_var->nc_type == NC_DOUBLE) {
+                status = nc_put_vara_double(hist_write->nc_id,
+                                            nc_var->nc_varid, dstart,
+                                            dcount, dvar);
+            }
+            else if (nc_var->nc_type == NC_FLOAT) {
+                status = nc_put_vara_float(hist_write->nc_id,
+                                           nc_var->nc_varid, dstart,
+                                           dcount, fvar);
+            }
+            else if (nc_var->nc_type == NC_INT) {
+                status = nc_put_vara_int(hist_write->nc_id,
+                                         nc_var->nc_varid, dstart,
+                                         dcount, ivar);
+            }
+            else if (nc_var->nc_type == NC_SHORT) {
+                status = nc_put_vara_short(hist_write->nc_id,
+                                           nc_var->nc_varid, dstart,
+                                           dcount, svar);
+            }
+            else {
+                status = nc_put_vara_schar(hist_write->nc_id,
+                                           nc_var->nc_varid, dstart,
+                                           dcount, (signed char *) cvar);
+            }
+            check_nc_status(status, "Error writing values.");
+            v++;
+        }
+    }
+
+    // Add time variable
+    dstart[0] = hist_write->time_idx;
+    status = nc_put_var1_double(hist_write->nc_id, nc_hist_file->time_varid,
+                                dstart, &(hist_write->time));
+    check_nc_status(status, "Error writing time variable");
+
+    // Add time bounds variable
+    dstart[1] = 0;
+    dcount[0] = 1;
+    dcount[1] = 2;
+    status = nc_put_vara_double(hist_write->nc_id,
+                                nc_hist_file->time_bounds_varid,
+                                dstart, dcount, hist_write->time_bounds);
+    check_nc_status(status, "Error writing time bounds variable");
+
+    if (hist_write->close) {
+        // close this history file
+        status = nc_close(hist_write->nc_id);
+        check_nc_status(status, "Error closing history file");
+    }
+    else {
+        // Force sync with disk (GH:#596)
+        status = nc_sync(hist_write->nc_id);
+        check_nc_status(status, "Error syncing netCDF file %s",
+                        stream->filename);
+    }
+
+    pthread_mutex_unlock(&nc_io_lock);
+
+    free(dvar);
+    free(fvar);
+    free(ivar);
+    free(svar);
+    free(cvar);
+}
+
+/******************************************************************************
+ * @brief    Background writer: write all gathered history data
+ *****************************************************************************/
+void *
+hist_writer_thread(void *arg)
+{
+    extern hist_writer_struct hist_writer;
+
+    size_t                    b;
+    size_t                    i;
+    size_t                    s;
+    hist_write_struct        *hist_write;
+
+    UNUSED(arg);
+
+    instrument_set_thread(INSTR_THREAD_HIST_WRITER);
+
+    for (s = 0; s < hist_writer.nstreams; s++) {
+        // oldest write first
+        for (i = 0; i < HIST_WRITE_NBUF; i++) {
+            b = (hist_writer.next[s] + i) % HIST_WRITE_NBUF;
+            hist_write = &(hist_writer.writes[s][b]);
+            if (hist_write->pending && hist_write->gathered) {
+                INSTRUMENT_BEGIN(INSTR_NC_WRITE);
+                hist_writer_put(s, hist_write);
+                INSTRUMENT_END(INSTR_NC_WRITE);
+                hist_write->pending = false;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief    Complete the posted gathers and start the background writer
+ *****************************************************************************/
+void
+hist_writer_start(void)
+{
+    extern hist_writer_struct hist_writer;
+    extern MPI_Comm           MPI_COMM_VIC;
+    extern int                mpi_rank;
+
+    size_t                    i;
+    size_t                    s;
+    int                       status;
+    bool                      write;
+    hist_write_struct        *hist_write;
+
+    write = false;
+    for (s = 0; s < hist_writer.nstreams; s++) {
+        for (i = 0; i < HIST_WRITE_NBUF; i++) {
+            hist_write = &(hist_writer.writes[s][i]);
+            if (hist_write->pending && !hist_write->gathered) {
+                INSTRUMENT_BEGIN(INSTR_GATHER);
+                status = MPI_Wait(&(hist_write->request), MPI_STATUS_IGNORE);
+                INSTRUMENT_END(INSTR_GATHER);
+                check_mpi_status(status, "MPI error.");
+                hist_write->gathered = true;
+                if (mpi_rank != VIC_MPI_ROOT) {
+                    // nothing left to do on the other nodes
+                    hist_write->pending = false;
+                }
+            }
+            if (hist_write->pending) {
+                write = true;
+            }
+        }
+    }
+
+    if (write) {
+        status = pthread_create(&(hist_writer.thread), NULL,
+                                hist_writer_thread, NULL);
+        if (status != 0) {
+            log_err("Error creating history writer thread: %d", status);
+        }
+        hist_writer.running = true;
+    }
+}
+
+/******************************************************************************
+ * @brief    Wait for the background writer to finish
+ *****************************************************************************/
+void
+hist_writer_stop(void)
+{
+    extern hist_writer_struct hist_writer;
+
+    int                       status;
+
+    if (!hist_writer.running) {
+        return;
+    }
+
+    status = pthread_join(hist_writer.thread, NULL);
+    if (status != 0) {
+        log_err("Error joining history writer thread: %d", status);
+    }
+    hist_writer.running = false;
+}
+
+/******************************************************************************
+ * @brief    Write out all history data that is still in flight
+ *****************************************************************************/
+void
+hist_writer_flush(void)
+{
+    hist_writer_start();
+    hist_writer_stop();
+}
+
+/******************************************************************************
+ * @brief    Free the buffers of the asynchronous history writer
+ *****************************************************************************/
+void
+hist_writer_finalize(void)
+{
+    extern hist_writer_struct hist_writer;
+    extern int                mpi_rank;
+
+    size_t                    i;
+    size_t                    s;
+
+    if (hist_writer.nstreams == 0) {
+        return;
+    }
+
+    for (s = 0; s < hist_writer.nstreams; s++) {
+        for (i = 0; i < HIST_WRITE_NBUF; i++) {
+            free(hist_writer.writes[s][i].sendbuf);
+            free(hist_writer.writes[s][i].recvbuf);
+        }
+        free(hist_writer.writes[s]);
+        if (mpi_rank == VIC_MPI_ROOT) {
+            free(hist_writer.recv_sizes[s]);
+            free(hist_writer.recv_offsets[s]);
+        }
+    }
+    free(hist_writer.writes);
+    free(hist_writer.nvalues);
+    free(hist_writer.next);
+    if (mpi_rank == VIC_MPI_ROOT) {
+        free(hist_writer.recv_sizes);
+        free(hist_writer.recv_offsets);
+        free(hist_writer.cell_idx);
+    }
+}
@@ -53,12 +53,49 @@ typedef struct {
     double *aggrunin;                         /*2d array[ysize][xsize] - vic runoff flux*/
 } rout_param_struct;
 
+#define ROUT_RVIC_TAG 2            /**< MPI tag of outlet discharge messages */
+
+/******************************************************************************
+ * @brief   Local (per node) routing Struct
+ * @details Each node convolves the sources in its own VIC cells into partial
+ *          rings of the outlets they drain to. The discharge of an outlet is
+ *          the sum of the current row of all partial rings; only these values
+ *          are sent to the node that owns the outlet cell.
+ *****************************************************************************/
+typedef struct {
+    size_t n_sources;                         /*scalar - number of local sources*/
+    size_t *source_cell;                      /*1d array - local VIC cell of source*/
+    int *source_time_offset;                  /*1d array - source time offset*/
+    double *unit_hydrograph;                  /*2d array[sources][times] - unit hydrographs*/
+    size_t n_outlets;                         /*scalar - number of local outlets*/
+    size_t *outlet_ind;                       /*1d array - global outlet index (ascending)*/
+    int *outlet_rank;                         /*1d array - node owning the outlet cell*/
+    size_t *outlet_cell;                      /*1d array - local VIC cell of owned outlet*/
+    size_t *outlet_start;                     /*1d array - first local source per outlet*/
+    double *ring;                             /*2d array[outlets][full_time_length] - partial rings*/
+    double *discharge;                        /*1d array - summed current row per outlet*/
+
+    size_t nsend;                             /*scalar - number of send messages*/
+    int *send_rank;                           /*1d array - destination node per message*/
+    size_t *send_start;                       /*1d array - send_outlets offset per message*/
+    size_t *send_outlets;                     /*1d array - local outlets to send*/
+    double *send_buffer;                      /*1d array - packed send discharge*/
+    size_t nrecv;                             /*scalar - number of receive messages*/
+    int *recv_rank;                           /*1d array - source node per message*/
+    size_t *recv_start;                       /*1d array - recv_outlets offset per message*/
+    size_t *recv_outlets;                     /*1d array - local outlets received*/
+    double *recv_buffer;                      /*1d array - received discharge*/
+    MPI_Request *requests;                    /*1d array - send followed by receive requests*/
+} rout_local_struct;
+
 /******************************************************************************
  * @brief   main routing Struct
  *****************************************************************************/
 typedef struct {
     rout_param_struct rout_param;
-    double *ring;
+    rout_local_struct local;
+    double *ring;                             /*2d array[full_time_length][outlets] - state ring (master node)*/
+    size_t ring_head;                         /*scalar - partial ring row of the current timestep*/
     double *discharge;
 } rout_struct;
 
@@ -67,9 +104,12 @@ typedef struct {
  *****************************************************************************/
 void rout_alloc(void);                 // allocate memory
 void rout_init(void);                  // initialize model parameters from parameter files
+void rout_init_local(void);            // distribute sources and outlets over the nodes
 void rout_run(void);                   // run routing over the domain
 void rout_finalize(void);              // clean up routine for routing
-void convolution(double *, double *);  // convolution over the domain
+void convolution(double *, double *);  // convolution over the local sources
+void rout_gather_ring(void);           // sum partial rings into the state ring
+void rout_scatter_ring(void);          // set partial rings from the state ring
 
 /******************************************************************************
  * @brief   MPI Function prototypes for the rout_rvic extension
@@ -26,59 +26,123 @@
 
 #include <rout.h>
 
+/******************************************************************************
+ * @brief   Convolve the runoff of the local sources into the partial rings
+ * @details runoff and discharge are arrays over the local cells. The partial
+ *          rings are circular buffers of full_time_length timesteps per outlet;
+ *          row ring_head holds the current timestep. Outlets are convolved in
+ *          parallel; the sources of an outlet are contiguous and each source
+ *          adds its (source-major) unit hydrograph with unit stride. The
+ *          current partial discharge is then summed on the node that owns the
+ *          outlet.
+ *****************************************************************************/
 void
 convolution(double *runoff,
             double *discharge)
 {
     extern rout_struct         rout;
     extern global_param_struct global_param;
-    extern domain_struct       global_domain;
+    extern domain_struct       local_domain;
+    extern int                 mpi_rank;
+    extern MPI_Comm            MPI_COMM_VIC;
 
+    rout_local_struct         *local;
     size_t                     i_source;
     size_t                     i_outlet;
     size_t                     i_timestep;
-    size_t                     j_timestep;
-    int                        offset; /*2d indicies*/
-    size_t                     i_ring;
-    size_t                     i_uh; /*1d indicies*/
+    size_t                     n_ring;
+    size_t                     n_timesteps;
+    size_t                     n_wrap;
+    size_t                     j_ring;
+    size_t                     iCell;
+    double                     source_runoff;
+    double                    *ring;
+    double                    *uh;
+    int                        status;
+
+    size_t                     i;
+
+    local = &(rout.local);
+    n_ring = rout.rout_param.full_time_length;
+    n_timesteps = rout.rout_param.n_timesteps;
 
-    // Zero out current ring
+    // Zero out the previous timestep and advance the rings
     // in python: (from variables.py) self.ring[tracer][0, :] = 0.
-    for (i_outlet = 0; i_outlet < rout.rout_param.n_outlets; i_outlet++) {
-        rout.ring[i_outlet] = 0.0;
+    // self.ring[tracer] = np.roll(self.ring[tracer], -1, axis=0)
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        local->ring[i_outlet * n_ring + rout.ring_head] = 0.0;
     }
+    rout.ring_head = (rout.ring_head + 1) % n_ring;
 
-    // Equivalent to Fortran 90 cshift function, in python: (from variables.py)
-    // self.ring[tracer] = np.roll(self.ring[tracer], -1, axis=0)
-    cshift(rout.ring, rout.rout_param.n_timesteps, rout.rout_param.n_outlets, 0,
-           1);
+    /* Do the convolution */
+    // i_timestep is the position in the unit hydrograph, the ring row is
+    // i_timestep + offset after the ring head. The rows are split in a part
+    // before and after the end of the ring, to keep the modulo out of the
+    // inner loops
+    #pragma omp parallel for default(shared) private(i_outlet, i_source, i_timestep, j_ring, n_wrap, source_runoff, ring, uh)
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        ring = local->ring + i_outlet * n_ring;
 
-    /*Loop through all sources*/
-    for (i_source = 0; i_source < rout.rout_param.n_sources; i_source++) {
-        i_outlet = rout.rout_param.source2outlet_ind[i_source];
-        offset = rout.rout_param.source_time_offset[i_source];
+        for (i_source = local->outlet_start[i_outlet];
+             i_source < local->outlet_start[i_outlet + 1];
+             i_source++) {
+            source_runoff = runoff[local->source_cell[i_source]];
+            uh = local->unit_hydrograph + i_source * n_timesteps;
 
-        /* Do the convolution */
-        // iTimestep is the position in the unit hydrograph
-        // jTimestep is the position in the ring
-        for (i_timestep = 0; i_timestep < rout.rout_param.n_timesteps;
-             i_timestep++) {
-            j_timestep = i_timestep + offset;
+            j_ring = (rout.ring_head + local->source_time_offset[i_source]) %
+                     n_ring;
+            n_wrap = min(n_timesteps, n_ring - j_ring);
 
-            // index locations
-            i_ring = (j_timestep * rout.rout_param.n_outlets) + i_outlet;
-            i_uh = (i_timestep * rout.rout_param.n_sources) + i_source;
-            rout.ring[i_ring] += rout.rout_param.unit_hydrograph[i_uh] *
-                                 runoff[rout.rout_param.source_VIC_index[
-                                            i_source]];
+            for (i_timestep = 0; i_timestep < n_wrap; i_timestep++) {
+                ring[j_ring + i_timestep] += uh[i_timestep] * source_runoff;
+            }
+            for (i_timestep = n_wrap; i_timestep < n_timesteps;
+                 i_timestep++) {
+                ring[i_timestep - n_wrap] += uh[i_timestep] * source_runoff;
+            }
         }
+
+        local->discharge[i_outlet] = ring[rout.ring_head];
+    }
+
+    // Sum the partial discharge on the node that owns the outlet
+    for (i = 0; i < local->nrecv; i++) {
+        status = MPI_Irecv(local->recv_buffer + local->recv_start[i],
+                           (int) (local->recv_start[i + 1] -
+                                  local->recv_start[i]),
+                           MPI_DOUBLE, local->recv_rank[i], ROUT_RVIC_TAG,
+                           MPI_COMM_VIC, &(local->requests[local->nsend + i]));
+        check_mpi_status(status, "MPI error.");
+    }
+    for (i = 0; i < local->send_start[local->nsend]; i++) {
+        local->send_buffer[i] = local->discharge[local->send_outlets[i]];
+    }
+    for (i = 0; i < local->nsend; i++) {
+        status = MPI_Isend(local->send_buffer + local->send_start[i],
+                           (int) (local->send_start[i + 1] -
+                                  local->send_start[i]),
+                           MPI_DOUBLE, local->send_rank[i], ROUT_RVIC_TAG,
+                           MPI_COMM_VIC, &(local->requests[i]));
+        check_mpi_status(status, "MPI error.");
+    }
+    status = MPI_Waitall((int) (local->nsend + local->nrecv), local->requests,
+                         MPI_STATUSES_IGNORE);
+    check_mpi_status(status, "MPI error.");
+
+    for (i = 0; i < local->recv_start[local->nrecv]; i++) {
+        local->discharge[local->recv_outlets[i]] += local->recv_buffer[i];
+    }
+
+    // Write discharge of the owned outlets
+    for (iCell = 0; iCell < local_domain.ncells_active; iCell++) {
+        discharge[iCell] = 0.0;
     }
-    // Write to discharge prior to scattering over local domains...
-    for (i_outlet = 0; i_outlet < rout.rout_param.n_outlets; i_outlet++) {
-        discharge[rout.rout_param.outlet_VIC_index[i_outlet]] =
-            rout.ring[i_outlet] *
-            global_domain.locations[rout.rout_param.outlet_VIC_index[i_outlet]]
-            .area /
-            (MM_PER_M * global_param.dt);
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        if (local->outlet_rank[i_outlet] == mpi_rank) {
+            iCell = local->outlet_cell[i_outlet];
+            discharge[iCell] = local->discharge[i_outlet] *
+                               local_domain.locations[iCell].area /
+                               (MM_PER_M * global_param.dt);
+        }
     }
 }
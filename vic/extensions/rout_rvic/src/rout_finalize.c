@@ -48,4 +48,23 @@ rout_finalize(void)
     free(rout.rout_param.aggrunin);
     free(rout.discharge);
     free(rout.ring);
+
+    free(rout.local.source_cell);
+    free(rout.local.source_time_offset);
+    free(rout.local.unit_hydrograph);
+    free(rout.local.outlet_ind);
+    free(rout.local.outlet_rank);
+    free(rout.local.outlet_cell);
+    free(rout.local.outlet_start);
+    free(rout.local.ring);
+    free(rout.local.discharge);
+    free(rout.local.send_rank);
+    free(rout.local.send_start);
+    free(rout.local.send_outlets);
+    free(rout.local.send_buffer);
+    free(rout.local.recv_rank);
+    free(rout.local.recv_start);
+    free(rout.local.recv_outlets);
+    free(rout.local.recv_buffer);
+    free(rout.local.requests);
 }
@@ -68,11 +68,12 @@ rout_init(void)
         check_alloc_status(dvar, "Memory allocation error.");
 
         // The Ring
-        for (j = 0; j < rout.rout_param.n_outlets; j++) {
-            for (i = 0; i < rout.rout_param.n_timesteps; i++) {
-                rout.ring[j * rout.rout_param.n_timesteps + i] = 0.0;
+        for (i = 0; i < rout.rout_param.full_time_length; i++) {
+            for (j = 0; j < rout.rout_param.n_outlets; j++) {
+                rout.ring[i * rout.rout_param.n_outlets + j] = 0.0;
             }
         }
+        rout.ring_head = 0;
 
         // discharge
         for (j = 0; j < global_domain.ncells_active; j++) {
@@ -207,4 +208,7 @@ rout_init(void)
         free(ivar);
         free(dvar);
     }
+
+    // distribute sources and outlets over the nodes
+    rout_init_local();
 }
@@ -0,0 +1,784 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Distribution of the routing sources and outlets over the nodes, and
+ * conversion between the partial rings and the state ring.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <rout.h>
+
+#include <rout.h>
+
+/******************************************************************************
+ * @brief    Distribute the routing sources and outlets over the nodes
+ * @details  Sources are assigned to the node that owns their VIC cell, and
+ *           outlets to the node that owns the outlet cell. Each node gets the
+ *           outlets of its sources and the outlets it owns. Sources in an
+ *           inactive cell, or draining to an outlet in an inactive cell, do not
+ *           contribute to the discharge and are dropped. Unit hydrographs are
+ *           stored source-major, so a source convolves with unit stride.
+ *****************************************************************************/
+void
+rout_init_local(void)
+{
+    extern domain_struct global_domain;
+    extern int           mpi_rank;
+    extern int           mpi_size;
+    extern int          *mpi_map_local_array_sizes;
+    extern int          *mpi_map_global_array_offsets;
+    extern size_t       *mpi_map_mapping_array;
+    extern size_t       *filter_active_cells;
+    extern MPI_Comm      MPI_COMM_VIC;
+    extern rout_struct   rout;
+
+    rout_local_struct   *local;
+    size_t               dims[3];
+    size_t              *counts = NULL;
+    size_t               local_counts[2];
+    int                 *cell_rank = NULL;
+    size_t              *cell_local = NULL;
+    int                 *outlet_rank = NULL;
+    size_t              *outlet_cell = NULL;
+    int                 *outlet_mark = NULL;
+    size_t              *outlet_local = NULL;
+    int                 *source_rank = NULL;
+    size_t              *source_order = NULL;
+    size_t              *source_start = NULL;
+    size_t              *outlet_count = NULL;
+    size_t              *pack_outlet_ind = NULL;
+    int                 *pack_outlet_rank = NULL;
+    size_t              *pack_outlet_cell = NULL;
+    size_t              *pack_source_cell = NULL;
+    size_t              *pack_source_outlet = NULL;
+    int                 *pack_source_offset = NULL;
+    double              *pack_uh = NULL;
+    int                 *outlet_counts = NULL;
+    int                 *outlet_displs = NULL;
+    int                 *source_counts = NULL;
+    int                 *source_displs = NULL;
+    int                 *uh_counts = NULL;
+    int                 *uh_displs = NULL;
+    size_t              *source_outlet;
+    int                 *send_counts;
+    int                 *send_displs;
+    int                 *recv_counts;
+    int                 *recv_displs;
+    size_t              *send_ind;
+    size_t              *recv_ind;
+    size_t               n_timesteps;
+    size_t               n_pack_outlets;
+    size_t               n_pack_sources;
+    size_t               iCell;
+    size_t               i_source;
+    size_t               i_outlet;
+    size_t               i_timestep;
+    size_t               lower;
+    size_t               upper;
+    size_t               middle;
+    int                  status;
+
+    size_t               i;
+    size_t               j;
+    int                  r;
+
+    local = &(rout.local);
+
+    // dimensions
+    if (mpi_rank == VIC_MPI_ROOT) {
+        dims[0] = rout.rout_param.full_time_length;
+        dims[1] = rout.rout_param.n_timesteps;
+        dims[2] = rout.rout_param.n_outlets;
+    }
+    status = MPI_Bcast(dims, 3, MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    rout.rout_param.full_time_length = dims[0];
+    rout.rout_param.n_timesteps = dims[1];
+    rout.rout_param.n_outlets = dims[2];
+    n_timesteps = rout.rout_param.n_timesteps;
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        // node and local index of every VIC cell
+        cell_rank = malloc(global_domain.ncells_total * sizeof(*cell_rank));
+        check_alloc_status(cell_rank, "Memory allocation error.");
+        cell_local = malloc(global_domain.ncells_total * sizeof(*cell_local));
+        check_alloc_status(cell_local, "Memory allocation error.");
+
+        for (i = 0; i < global_domain.ncells_total; i++) {
+            cell_rank[i] = -1;
+        }
+        for (r = 0; r < mpi_size; r++) {
+            for (j = 0; j < (size_t) mpi_map_local_array_sizes[r]; j++) {
+                iCell = filter_active_cells[mpi_map_mapping_array[
+                                                mpi_map_global_array_offsets[r]
+                                                + j]];
+                cell_rank[iCell] = r;
+                cell_local[iCell] = j;
+            }
+        }
+
+        // node of every outlet and source
+        outlet_rank = malloc(rout.rout_param.n_outlets * sizeof(*outlet_rank));
+        check_alloc_status(outlet_rank, "Memory allocation error.");
+        outlet_cell = malloc(rout.rout_param.n_outlets * sizeof(*outlet_cell));
+        check_alloc_status(outlet_cell, "Memory allocation error.");
+        for (i_outlet = 0; i_outlet < rout.rout_param.n_outlets; i_outlet++) {
+            iCell = rout.rout_param.outlet_VIC_index[i_outlet];
+            outlet_rank[i_outlet] = cell_rank[iCell];
+            outlet_cell[i_outlet] = cell_local[iCell];
+        }
+
+        source_rank = malloc(rout.rout_param.n_sources * sizeof(*source_rank));
+        check_alloc_status(source_rank, "Memory allocation error.");
+        source_start = malloc((mpi_size + 1) * sizeof(*source_start));
+        check_alloc_status(source_start, "Memory allocation error.");
+        for (r = 0; r <= mpi_size; r++) {
+            source_start[r] = 0;
+        }
+        for (i_source = 0; i_source < rout.rout_param.n_sources; i_source++) {
+            iCell = rout.rout_param.source_VIC_index[i_source];
+            i_outlet = rout.rout_param.source2outlet_ind[i_source];
+            if (outlet_rank[i_outlet] >= 0) {
+                source_rank[i_source] = cell_rank[iCell];
+            }
+            else {
+                source_rank[i_source] = -1;
+            }
+            if (source_rank[i_source] >= 0) {
+                source_start[source_rank[i_source] + 1]++;
+            }
+        }
+        for (r = 0; r < mpi_size; r++) {
+            source_start[r + 1] += source_start[r];
+        }
+        n_pack_sources = source_start[mpi_size];
+
+        // sources ordered by node
+        source_order = malloc((n_pack_sources + 1) * sizeof(*source_order));
+        check_alloc_status(source_order, "Memory allocation error.");
+        for (i_source = 0; i_source < rout.rout_param.n_sources; i_source++) {
+            if (source_rank[i_source] >= 0) {
+                source_order[source_start[source_rank[i_source]]++] =
+                    i_source;
+            }
+        }
+        for (r = mpi_size; r > 0; r--) {
+            source_start[r] = source_start[r - 1];
+        }
+        source_start[0] = 0;
+
+        // pack outlets and sources per node, sources ordered by outlet
+        pack_outlet_ind = malloc((n_pack_sources + rout.rout_param.n_outlets) *
+                                 sizeof(*pack_outlet_ind));
+        check_alloc_status(pack_outlet_ind, "Memory allocation error.");
+        pack_outlet_rank = malloc((n_pack_sources + rout.rout_param.n_outlets) *
+                                  sizeof(*pack_outlet_rank));
+        check_alloc_status(pack_outlet_rank, "Memory allocation error.");
+        pack_outlet_cell = malloc((n_pack_sources + rout.rout_param.n_outlets) *
+                                  sizeof(*pack_outlet_cell));
+        check_alloc_status(pack_outlet_cell, "Memory allocation error.");
+        pack_source_cell = malloc((n_pack_sources + 1) *
+                                  sizeof(*pack_source_cell));
+        check_alloc_status(pack_source_cell, "Memory allocation error.");
+        pack_source_outlet = malloc((n_pack_sources + 1) *
+                                    sizeof(*pack_source_outlet));
+        check_alloc_status(pack_source_outlet, "Memory allocation error.");
+        pack_source_offset = malloc((n_pack_sources + 1) *
+                                    sizeof(*pack_source_offset));
+        check_alloc_status(pack_source_offset, "Memory allocation error.");
+        pack_uh = malloc((n_pack_sources * n_timesteps + 1) *
+                         sizeof(*pack_uh));
+        check_alloc_status(pack_uh, "Memory allocation error.");
+
+        outlet_mark = malloc(rout.rout_param.n_outlets * sizeof(*outlet_mark));
+        check_alloc_status(outlet_mark, "Memory allocation error.");
+        outlet_local = malloc(rout.rout_param.n_outlets *
+                              sizeof(*outlet_local));
+        check_alloc_status(outlet_local, "Memory allocation error.");
+        outlet_count = malloc((rout.rout_param.n_outlets + 1) *
+                              sizeof(*outlet_count));
+        check_alloc_status(outlet_count, "Memory allocation error.");
+        counts = malloc(2 * mpi_size * sizeof(*counts));
+        check_alloc_status(counts, "Memory allocation error.");
+
+        for (i_outlet = 0; i_outlet < rout.rout_param.n_outlets; i_outlet++) {
+            outlet_mark[i_outlet] = -1;
+        }
+
+        n_pack_outlets = 0;
+        for (r = 0; r < mpi_size; r++) {
+            // outlets of node r, in ascending order
+            for (i = source_start[r]; i < source_start[r + 1]; i++) {
+                outlet_mark[rout.rout_param.source2outlet_ind[
+                                source_order[i]]] = r;
+            }
+            counts[2 * r + 1] = 0;
+            for (i_outlet = 0; i_outlet < rout.rout_param.n_outlets;
+                 i_outlet++) {
+                if (outlet_mark[i_outlet] == r || outlet_rank[i_outlet] == r) {
+                    outlet_local[i_outlet] = counts[2 * r + 1];
+                    pack_outlet_ind[n_pack_outlets] = i_outlet;
+                    pack_outlet_rank[n_pack_outlets] = outlet_rank[i_outlet];
+                    pack_outlet_cell[n_pack_outlets] = outlet_cell[i_outlet];
+                    n_pack_outlets++;
+                    counts[2 * r + 1]++;
+                }
+            }
+
+            // sources of node r, ordered by local outlet
+            counts[2 * r] = source_start[r + 1] - source_start[r];
+            for (i = 0; i <= counts[2 * r + 1]; i++) {
+                outlet_count[i] = 0;
+            }
+            for (i = source_start[r]; i < source_start[r + 1]; i++) {
+                outlet_count[outlet_local[rout.rout_param.source2outlet_ind[
+                                              source_order[i]]] + 1]++;
+            }
+            for (i = 0; i < counts[2 * r + 1]; i++) {
+                outlet_count[i + 1] += outlet_count[i];
+            }
+            for (i = source_start[r]; i < source_start[r + 1]; i++) {
+                i_source = source_order[i];
+                i_outlet = outlet_local[rout.rout_param.source2outlet_ind[
+                                            i_source]];
+                j = source_start[r] + outlet_count[i_outlet]++;
+
+                iCell = rout.rout_param.source_VIC_index[i_source];
+                pack_source_cell[j] = cell_local[iCell];
+                pack_source_outlet[j] = i_outlet;
+                pack_source_offset[j] =
+                    rout.rout_param.source_time_offset[i_source];
+                for (i_timestep = 0; i_timestep < n_timesteps;
+                     i_timestep++) {
+                    pack_uh[j * n_timesteps + i_timestep] =
+                        rout.rout_param.unit_hydrograph[
+                            i_timestep * rout.rout_param.n_sources + i_source];
+                }
+            }
+        }
+
+        // scatter counts and displacements
+        outlet_counts = malloc(mpi_size * sizeof(*outlet_counts));
+        check_alloc_status(outlet_counts, "Memory allocation error.");
+        outlet_displs = malloc(mpi_size * sizeof(*outlet_displs));
+        check_alloc_status(outlet_displs, "Memory allocation error.");
+        source_counts = malloc(mpi_size * sizeof(*source_counts));
+        check_alloc_status(source_counts, "Memory allocation error.");
+        source_displs = malloc(mpi_size * sizeof(*source_displs));
+        check_alloc_status(source_displs, "Memory allocation error.");
+        uh_counts = malloc(mpi_size * sizeof(*uh_counts));
+        check_alloc_status(uh_counts, "Memory allocation error.");
+        uh_displs = malloc(mpi_size * sizeof(*uh_displs));
+        check_alloc_status(uh_displs, "Memory allocation error.");
+
+        j = 0;
+        for (r = 0; r < mpi_size; r++) {
+            outlet_counts[r] = (int) counts[2 * r + 1];
+            outlet_displs[r] = (int) j;
+            j += counts[2 * r + 1];
+            source_counts[r] = (int) counts[2 * r];
+            source_displs[r] = (int) source_start[r];
+            uh_counts[r] = (int) (counts[2 * r] * n_timesteps);
+            uh_displs[r] = (int) (source_start[r] * n_timesteps);
+        }
+    }
+
+    status = MPI_Scatter(counts, 2, MPI_AINT, local_counts, 2, MPI_AINT,
+                         VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    local->n_sources = local_counts[0];
+    local->n_outlets = local_counts[1];
+
+    // local sources
+    local->source_cell = malloc((local->n_sources + 1) *
+                                sizeof(*local->source_cell));
+    check_alloc_status(local->source_cell, "Memory allocation error.");
+    local->source_time_offset = malloc((local->n_sources + 1) *
+                                       sizeof(*local->source_time_offset));
+    check_alloc_status(local->source_time_offset, "Memory allocation error.");
+    local->unit_hydrograph = malloc((local->n_sources * n_timesteps + 1) *
+                                    sizeof(*local->unit_hydrograph));
+    check_alloc_status(local->unit_hydrograph, "Memory allocation error.");
+    source_outlet = malloc((local->n_sources + 1) * sizeof(*source_outlet));
+    check_alloc_status(source_outlet, "Memory allocation error.");
+
+    status = MPI_Scatterv(pack_source_cell, source_counts, source_displs,
+                          MPI_AINT, local->source_cell, (int) local->n_sources,
+                          MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Scatterv(pack_source_outlet, source_counts, source_displs,
+                          MPI_AINT, source_outlet, (int) local->n_sources,
+                          MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Scatterv(pack_source_offset, source_counts, source_displs,
+                          MPI_INT, local->source_time_offset,
+                          (int) local->n_sources, MPI_INT, VIC_MPI_ROOT,
+                          MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Scatterv(pack_uh, uh_counts, uh_displs, MPI_DOUBLE,
+                          local->unit_hydrograph,
+                          (int) (local->n_sources * n_timesteps), MPI_DOUBLE,
+                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // local outlets
+    local->outlet_ind = malloc((local->n_outlets + 1) *
+                               sizeof(*local->outlet_ind));
+    check_alloc_status(local->outlet_ind, "Memory allocation error.");
+    local->outlet_rank = malloc((local->n_outlets + 1) *
+                                sizeof(*local->outlet_rank));
+    check_alloc_status(local->outlet_rank, "Memory allocation error.");
+    local->outlet_cell = malloc((local->n_outlets + 1) *
+                                sizeof(*local->outlet_cell));
+    check_alloc_status(local->outlet_cell, "Memory allocation error.");
+
+    status = MPI_Scatterv(pack_outlet_ind, outlet_counts, outlet_displs,
+                          MPI_AINT, local->outlet_ind, (int) local->n_outlets,
+                          MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Scatterv(pack_outlet_rank, outlet_counts, outlet_displs,
+                          MPI_INT, local->outlet_rank, (int) local->n_outlets,
+                          MPI_INT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Scatterv(pack_outlet_cell, outlet_counts, outlet_displs,
+                          MPI_AINT, local->outlet_cell, (int) local->n_outlets,
+                          MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // first source per outlet (sources are ordered by outlet)
+    local->outlet_start = malloc((local->n_outlets + 1) *
+                                 sizeof(*local->outlet_start));
+    check_alloc_status(local->outlet_start, "Memory allocation error.");
+    for (i_outlet = 0; i_outlet <= local->n_outlets; i_outlet++) {
+        local->outlet_start[i_outlet] = 0;
+    }
+    for (i_source = 0; i_source < local->n_sources; i_source++) {
+        local->outlet_start[source_outlet[i_source] + 1]++;
+    }
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        local->outlet_start[i_outlet + 1] += local->outlet_start[i_outlet];
+    }
+
+    // partial rings
+    local->ring = malloc((local->n_outlets * rout.rout_param.full_time_length +
+                          1) * sizeof(*local->ring));
+    check_alloc_status(local->ring, "Memory allocation error.");
+    for (i = 0; i < local->n_outlets * rout.rout_param.full_time_length; i++) {
+        local->ring[i] = 0.0;
+    }
+    local->discharge = malloc((local->n_outlets + 1) *
+                              sizeof(*local->discharge));
+    check_alloc_status(local->discharge, "Memory allocation error.");
+    rout.ring_head = 0;
+
+    // send the partial discharge of outlets owned by another node, ordered
+    // by node and outlet
+    send_counts = malloc(mpi_size * sizeof(*send_counts));
+    check_alloc_status(send_counts, "Memory allocation error.");
+    send_displs = malloc(mpi_size * sizeof(*send_displs));
+    check_alloc_status(send_displs, "Memory allocation error.");
+    recv_counts = malloc(mpi_size * sizeof(*recv_counts));
+    check_alloc_status(recv_counts, "Memory allocation error.");
+    recv_displs = malloc(mpi_size * sizeof(*recv_displs));
+    check_alloc_status(recv_displs, "Memory allocation error.");
+
+    for (r = 0; r < mpi_size; r++) {
+        send_counts[r] = 0;
+    }
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        if (local->outlet_rank[i_outlet] != mpi_rank) {
+            send_counts[local->outlet_rank[i_outlet]]++;
+        }
+    }
+    j = 0;
+    for (r = 0; r < mpi_size; r++) {
+        send_displs[r] = (int) j;
+        j += send_counts[r];
+    }
+
+    local->send_outlets = malloc((j + 1) * sizeof(*local->send_outlets));
+    check_alloc_status(local->send_outlets, "Memory allocation error.");
+    local->send_buffer = malloc((j + 1) * sizeof(*local->send_buffer));
+    check_alloc_status(local->send_buffer, "Memory allocation error.");
+    send_ind = malloc((j + 1) * sizeof(*send_ind));
+    check_alloc_status(send_ind, "Memory allocation error.");
+
+    for (i_outlet = 0; i_outlet < local->n_outlets; i_outlet++) {
+        r = local->outlet_rank[i_outlet];
+        if (r != mpi_rank) {
+            local->send_outlets[send_displs[r]] = i_outlet;
+            send_ind[send_displs[r]] = local->outlet_ind[i_outlet];
+            send_displs[r]++;
+        }
+    }
+    for (r = 0; r < mpi_size; r++) {
+        send_displs[r] -= send_counts[r];
+    }
+
+    // the owning nodes find out which outlets they receive from whom
+    status = MPI_Alltoall(send_counts, 1, MPI_INT, recv_counts, 1, MPI_INT,
+                          MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    j = 0;
+    for (r = 0; r < mpi_size; r++) {
+        recv_displs[r] = (int) j;
+        j += recv_counts[r];
+    }
+
+    local->recv_outlets = malloc((j + 1) * sizeof(*local->recv_outlets));
+    check_alloc_status(local->recv_outlets, "Memory allocation error.");
+    local->recv_buffer = malloc((j + 1) * sizeof(*local->recv_buffer));
+    check_alloc_status(local->recv_buffer, "Memory allocation error.");
+    recv_ind = malloc((j + 1) * sizeof(*recv_ind));
+    check_alloc_status(recv_ind, "Memory allocation error.");
+
+    status = MPI_Alltoallv(send_ind, send_counts, send_displs, MPI_AINT,
+                           recv_ind, recv_counts, recv_displs, MPI_AINT,
+                           MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    for (i = 0; i < j; i++) {
+        // binary search in the (ascending) local outlets
+        lower = 0;
+        upper = local->n_outlets;
+        while (lower < upper) {
+            middle = lower + (upper - lower) / 2;
+            if (local->outlet_ind[middle] < recv_ind[i]) {
+                lower = middle + 1;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        if (lower == local->n_outlets ||
+            local->outlet_ind[lower] != recv_ind[i] ||
+            local->outlet_rank[lower] != mpi_rank) {
+            log_err("Outlet %zu is not owned by node %d", recv_ind[i],
+                    mpi_rank);
+        }
+        local->recv_outlets[i] = lower;
+    }
+
+    // messages
+    local->send_rank = malloc((mpi_size + 1) * sizeof(*local->send_rank));
+    check_alloc_status(local->send_rank, "Memory allocation error.");
+    local->send_start = malloc((mpi_size + 1) * sizeof(*local->send_start));
+    check_alloc_status(local->send_start, "Memory allocation error.");
+    local->recv_rank = malloc((mpi_size + 1) * sizeof(*local->recv_rank));
+    check_alloc_status(local->recv_rank, "Memory allocation error.");
+    local->recv_start = malloc((mpi_size + 1) * sizeof(*local->recv_start));
+    check_alloc_status(local->recv_start, "Memory allocation error.");
+
+    local->nsend = 0;
+    local->nrecv = 0;
+    local->send_start[0] = 0;
+    local->recv_start[0] = 0;
+    for (r = 0; r < mpi_size; r++) {
+        if (send_counts[r] > 0) {
+            local->send_rank[local->nsend] = r;
+            local->send_start[local->nsend + 1] =
+                local->send_start[local->nsend] + send_counts[r];
+            local->nsend++;
+        }
+        if (recv_counts[r] > 0) {
+            local->recv_rank[local->nrecv] = r;
+            local->recv_start[local->nrecv + 1] =
+                local->recv_start[local->nrecv] + recv_counts[r];
+            local->nrecv++;
+        }
+    }
+
+    local->requests = malloc((local->nsend + local->nrecv + 1) *
+                             sizeof(*local->requests));
+    check_alloc_status(local->requests, "Memory allocation error.");
+
+    // cleanup
+    free(source_outlet);
+    free(send_counts);
+    free(send_displs);
+    free(recv_counts);
+    free(recv_displs);
+    free(send_ind);
+    free(recv_ind);
+    if (mpi_rank == VIC_MPI_ROOT) {
+        free(cell_rank);
+        free(cell_local);
+        free(outlet_rank);
+        free(outlet_cell);
+        free(outlet_mark);
+        free(outlet_local);
+        free(outlet_count);
+        free(source_rank);
+        free(source_order);
+        free(source_start);
+        free(counts);
+        free(pack_outlet_ind);
+        free(pack_outlet_rank);
+        free(pack_outlet_cell);
+        free(pack_source_cell);
+        free(pack_source_outlet);
+        free(pack_source_offset);
+        free(pack_uh);
+        free(outlet_counts);
+        free(outlet_displs);
+        free(source_counts);
+        free(source_displs);
+        free(uh_counts);
+        free(uh_displs);
+    }
+}
+
+/******************************************************************************
+ * @brief    Sum the partial rings of all nodes into the state ring
+ * @details  The state ring on the master node starts at the current
+ *           timestep.
+ *****************************************************************************/
+void
+rout_gather_ring(void)
+{
+    extern int         mpi_rank;
+    extern int         mpi_size;
+    extern MPI_Comm    MPI_COMM_VIC;
+    extern rout_struct rout;
+
+    rout_local_struct *local;
+    size_t             n_ring;
+    size_t             n_outlets;
+    size_t            *counts = NULL;
+    int               *outlet_counts = NULL;
+    int               *outlet_displs = NULL;
+    int               *ring_counts = NULL;
+    int               *ring_displs = NULL;
+    size_t            *outlet_ind = NULL;
+    double            *ring = NULL;
+    double            *local_ring;
+    int                status;
+
+    size_t             i;
+    size_t             j;
+    int                r;
+
+    local = &(rout.local);
+    n_ring = rout.rout_param.full_time_length;
+
+    // partial rings, starting at the current timestep
+    local_ring = malloc((local->n_outlets * n_ring + 1) *
+                        sizeof(*local_ring));
+    check_alloc_status(local_ring, "Memory allocation error.");
+    for (i = 0; i < local->n_outlets; i++) {
+        for (j = 0; j < n_ring; j++) {
+            local_ring[i * n_ring + j] =
+                local->ring[i * n_ring + (rout.ring_head + j) % n_ring];
+        }
+    }
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        counts = malloc(mpi_size * sizeof(*counts));
+        check_alloc_status(counts, "Memory allocation error.");
+        outlet_counts = malloc(mpi_size * sizeof(*outlet_counts));
+        check_alloc_status(outlet_counts, "Memory allocation error.");
+        outlet_displs = malloc(mpi_size * sizeof(*outlet_displs));
+        check_alloc_status(outlet_displs, "Memory allocation error.");
+        ring_counts = malloc(mpi_size * sizeof(*ring_counts));
+        check_alloc_status(ring_counts, "Memory allocation error.");
+        ring_displs = malloc(mpi_size * sizeof(*ring_displs));
+        check_alloc_status(ring_displs, "Memory allocation error.");
+    }
+
+    status = MPI_Gather(&(local->n_outlets), 1, MPI_AINT, counts, 1, MPI_AINT,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        n_outlets = 0;
+        for (r = 0; r < mpi_size; r++) {
+            outlet_counts[r] = (int) counts[r];
+            outlet_displs[r] = (int) n_outlets;
+            ring_counts[r] = (int) (counts[r] * n_ring);
+            ring_displs[r] = (int) (n_outlets * n_ring);
+            n_outlets += counts[r];
+        }
+        outlet_ind = malloc((n_outlets + 1) * sizeof(*outlet_ind));
+        check_alloc_status(outlet_ind, "Memory allocation error.");
+        ring = malloc((n_outlets * n_ring + 1) * sizeof(*ring));
+        check_alloc_status(ring, "Memory allocation error.");
+    }
+
+    status = MPI_Gatherv(local->outlet_ind, (int) local->n_outlets, MPI_AINT,
+                         outlet_ind, outlet_counts, outlet_displs, MPI_AINT,
+                         VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Gatherv(local_ring, (int) (local->n_outlets * n_ring),
+                         MPI_DOUBLE, ring, ring_counts, ring_displs,
+                         MPI_DOUBLE, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        for (i = 0; i < n_ring * rout.rout_param.n_outlets; i++) {
+            rout.ring[i] = 0.0;
+        }
+        for (i = 0; i < n_outlets; i++) {
+            for (j = 0; j < n_ring; j++) {
+                rout.ring[j * rout.rout_param.n_outlets + outlet_ind[i]] +=
+                    ring[i * n_ring + j];
+            }
+        }
+
+        free(counts);
+        free(outlet_counts);
+        free(outlet_displs);
+        free(ring_counts);
+        free(ring_displs);
+        free(outlet_ind);
+        free(ring);
+    }
+    free(local_ring);
+}
+
+/******************************************************************************
+ * @brief    Set the partial rings from the state ring
+ * @details  The ring of an outlet is given to the node that owns the outlet,
+ *           the partial rings of the other nodes are cleared.
+ *****************************************************************************/
+void
+rout_scatter_ring(void)
+{
+    extern int         mpi_rank;
+    extern int         mpi_size;
+    extern MPI_Comm    MPI_COMM_VIC;
+    extern rout_struct rout;
+
+    rout_local_struct *local;
+    size_t             n_ring;
+    size_t             n_outlets;
+    size_t             n_owned;
+    size_t            *counts = NULL;
+    int               *outlet_counts = NULL;
+    int               *outlet_displs = NULL;
+    int               *ring_counts = NULL;
+    int               *ring_displs = NULL;
+    size_t            *outlet_ind = NULL;
+    double            *ring = NULL;
+    size_t            *local_ind;
+    double            *local_ring;
+    int                status;
+
+    size_t             i;
+    size_t             j;
+    int                r;
+
+    local = &(rout.local);
+    n_ring = rout.rout_param.full_time_length;
+
+    // outlets owned by this node
+    local_ind = malloc((local->n_outlets + 1) * sizeof(*local_ind));
+    check_alloc_status(local_ind, "Memory allocation error.");
+    n_owned = 0;
+    for (i = 0; i < local->n_outlets; i++) {
+        if (local->outlet_rank[i] == mpi_rank) {
+            local_ind[n_owned] = local->outlet_ind[i];
+            n_owned++;
+        }
+    }
+    local_ring = malloc((n_owned * n_ring + 1) * sizeof(*local_ring));
+    check_alloc_status(local_ring, "Memory allocation error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        counts = malloc(mpi_size * sizeof(*counts));
+        check_alloc_status(counts, "Memory allocation error.");
+        outlet_counts = malloc(mpi_size * sizeof(*outlet_counts));
+        check_alloc_status(outlet_counts, "Memory allocation error.");
+        outlet_displs = malloc(mpi_size * sizeof(*outlet_displs));
+        check_alloc_status(outlet_displs, "Memory allocation error.");
+        ring_counts = malloc(mpi_size * sizeof(*ring_counts));
+        check_alloc_status(ring_counts, "Memory allocation error.");
+        ring_displs = malloc(mpi_size * sizeof(*ring_displs));
+        check_alloc_status(ring_displs, "Memory allocation error.");
+    }
+
+    status = MPI_Gather(&n_owned, 1, MPI_AINT, counts, 1, MPI_AINT,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        n_outlets = 0;
+        for (r = 0; r < mpi_size; r++) {
+            outlet_counts[r] = (int) counts[r];
+            outlet_displs[r] = (int) n_outlets;
+            ring_counts[r] = (int) (counts[r] * n_ring);
+            ring_displs[r] = (int) (n_outlets * n_ring);
+            n_outlets += counts[r];
+        }
+        outlet_ind = malloc((n_outlets + 1) * sizeof(*outlet_ind));
+        check_alloc_status(outlet_ind, "Memory allocation error.");
+        ring = malloc((n_outlets * n_ring + 1) * sizeof(*ring));
+        check_alloc_status(ring, "Memory allocation error.");
+    }
+
+    status = MPI_Gatherv(local_ind, (int) n_owned, MPI_AINT, outlet_ind,
+                         outlet_counts, outlet_displs, MPI_AINT,
+                         VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        for (i = 0; i < n_outlets; i++) {
+            for (j = 0; j < n_ring; j++) {
+                ring[i * n_ring + j] =
+                    rout.ring[j * rout.rout_param.n_outlets + outlet_ind[i]];
+            }
+        }
+    }
+
+    status = MPI_Scatterv(ring, ring_counts, ring_displs, MPI_DOUBLE,
+                          local_ring, (int) (n_owned * n_ring), MPI_DOUBLE,
+                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // partial rings, starting at the current timestep
+    rout.ring_head = 0;
+    n_owned = 0;
+    for (i = 0; i < local->n_outlets; i++) {
+        for (j = 0; j < n_ring; j++) {
+            if (local->outlet_rank[i] == mpi_rank) {
+                local->ring[i * n_ring + j] = local_ring[n_owned * n_ring + j];
+            }
+            else {
+                local->ring[i * n_ring + j] = 0.0;
+            }
+        }
+        if (local->outlet_rank[i] == mpi_rank) {
+            n_owned++;
+        }
+    }
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        free(counts);
+        free(outlet_counts);
+        free(outlet_displs);
+        free(ring_counts);
+        free(ring_displs);
+        free(outlet_ind);
+        free(ring);
+    }
+    free(local_ind);
+    free(local_ring);
+}
@@ -54,4 +54,7 @@ vic_restore_rout_extension(nameid_struct   *init_state_file,
             state_metadata[N_STATE_VARS + STATE_ROUT_RING].varname,
             d2start, d2count, rout.ring);
     }
+
+    // distribute the ring over the nodes
+    rout_scatter_ring();
 }
@@ -42,7 +42,9 @@ vic_store_rout_extension(nc_file_struct *nc_state_file)
 
     // write state variables
 
-    // routing ring
+    // routing ring, summed over the nodes
+    rout_gather_ring();
+
     if (mpi_rank == VIC_MPI_ROOT) {
         d2start[0] = 0;
         d2start[1] = 0;
@@ -33,6 +33,7 @@ typedef struct {
 crop_con_map_struct *crop_con_map;
 crop_con_struct    **crop_con;
 crop_force_struct   *crop_force;
+SimUnit            **wofost_library;
 
 bool crop_get_global_param(char *);
 void crop_validate_global_param(void);
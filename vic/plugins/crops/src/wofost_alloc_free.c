@@ -56,12 +56,14 @@ wofost_alloc(void)
 void
 wofost_finalize(void)
 {
-    extern option_struct options;
-    extern domain_struct local_domain;
-    extern SimUnit    ***Grid;
+    extern option_struct        options;
+    extern plugin_option_struct plugin_options;
+    extern domain_struct        local_domain;
+    extern SimUnit           ***Grid;
+    extern SimUnit            **wofost_library;
 
-    size_t               i;
-    size_t               j;
+    size_t                      i;
+    size_t                      j;
 
     for (i = 0; i < local_domain.ncells_active; i++) {
         for (j = 0; j < options.SNOW_BAND; j++) {
@@ -70,4 +72,10 @@ wofost_finalize(void)
         free(Grid[i]);
     }
     free(Grid);
+
+    for (i = 0; i < plugin_options.NCROPTYPES; i++) {
+        CleanTables(wofost_library[i]);
+        Clean(wofost_library[i]);
+    }
+    free(wofost_library);
 }
@@ -1,81 +1,6 @@
 #include <vic_driver_image.h>
 #include <plugin.h>
 
-void
-copy_wofost_table(TABLE *from,
-                  TABLE *to)
-{
-    to->x = from->x;
-    to->y = from->y;
-    to->next = NULL;
-}
-
-void
-copy_wofost_table_list(TABLE **from,
-                       TABLE **to)
-{
-    TABLE *from_start, *to_start;
-
-    to_start = NULL;
-    from_start = (*from);
-
-    while ((*from)) {
-        if (to_start == NULL) {
-            (*to) = to_start = malloc(sizeof(TABLE));
-            check_alloc_status(to, "Memory allocation error");
-        }
-        else {
-            (*to)->next = malloc(sizeof(TABLE));
-            check_alloc_status((*to)->next, "Memory allocation error");
-            (*to) = (*to)->next;
-        }
-
-        copy_wofost_table((*from), (*to));
-        (*from) = (*from)->next;
-    }
-
-    (*from) = from_start;
-    (*to) = to_start;
-}
-
-void
-copy_wofost_table_d(TABLE_D *from,
-                    TABLE_D *to)
-{
-    to->amount = from->amount;
-    to->day = from->day;
-    to->month = from->month;
-    to->next = NULL;
-}
-
-void
-copy_wofost_table_d_list(TABLE_D **from,
-                         TABLE_D **to)
-{
-    TABLE_D *from_start, *to_start;
-
-    to_start = NULL;
-    from_start = (*from);
-
-    while ((*from)) {
-        if (to_start == NULL) {
-            (*to) = to_start = malloc(sizeof(TABLE_D));
-            check_alloc_status((*to), "Memory allocation error");
-        }
-        else {
-            (*to)->next = malloc(sizeof(TABLE_D));
-            check_alloc_status((*to), "Memory allocation error");
-            (*to) = (*to)->next;
-        }
-
-        copy_wofost_table_d((*from), (*to));
-        (*from) = (*from)->next;
-    }
-
-    (*from) = from_start;
-    (*to) = to_start;
-}
-
 void
 copy_wofost_rates(Rates *from,
                   Rates *to)
@@ -136,35 +61,32 @@ copy_wofost_geen(Green *from,
     to->age = from->age;
     to->area = from->area;
     to->weight = from->weight;
-    to->next = NULL;
 }
 
 void
-copy_wofost_green_list(Green **from,
-                       Green **to)
+copy_wofost_green_list(Plant *from,
+                       Plant *to)
 {
-    Green *from_start, *to_start;
-
-    to_start = NULL;
-    from_start = (*from);
+    size_t i;
 
-    while ((*from)) {
-        if (to_start == NULL) {
-            (*to) = to_start = malloc(sizeof(Green));
-            check_alloc_status((*to), "Memory allocation error");
+    free(to->LeaveProperties);
+    to->LeaveProperties = NULL;
+    to->LeaveSize = 0;
+    to->LeaveStart = 0;
+    to->LeaveCount = 0;
+
+    if (from->LeaveSize > 0) {
+        to->LeaveProperties = malloc(from->LeaveSize *
+                                     sizeof(*to->LeaveProperties));
+        check_alloc_status(to->LeaveProperties, "Memory allocation error");
+        to->LeaveSize = from->LeaveSize;
+
+        for (i = 0; i < from->LeaveCount; i++) {
+            copy_wofost_geen(LeaveClass(from, i),
+                             &(to->LeaveProperties[i]));
         }
-        else {
-            (*to)->next = malloc(sizeof(Green));
-            check_alloc_status((*to), "Memory allocation error");
-            (*to) = (*to)->next;
-        }
-
-        copy_wofost_geen((*from), (*to));
-        (*from) = (*from)->next;
+        to->LeaveCount = from->LeaveCount;
     }
-
-    (*from) = from_start;
-    (*to) = to_start;
 }
 
 void
@@ -278,30 +200,29 @@ void
 copy_wofost_parameters(Parameters *from,
                        Parameters *to)
 {
-    copy_wofost_table_list(&from->Roots, &to->Roots);
-    copy_wofost_table_list(&from->Stems, &to->Stems);
-    copy_wofost_table_list(&from->Leaves, &to->Leaves);
-    copy_wofost_table_list(&from->Storage, &to->Storage);
-    copy_wofost_table_list(&from->VernalizationRate, &to->VernalizationRate);
-    copy_wofost_table_list(&from->DeltaTempSum, &to->DeltaTempSum);
-    copy_wofost_table_list(&from->SpecificLeaveArea, &to->SpecificLeaveArea);
-    copy_wofost_table_list(&from->SpecificStemArea, &to->SpecificStemArea);
-    copy_wofost_table_list(&from->KDiffuseTb, &to->KDiffuseTb);
-    copy_wofost_table_list(&from->EFFTb, &to->EFFTb);
-    copy_wofost_table_list(&from->MaxAssimRate, &to->MaxAssimRate);
-    copy_wofost_table_list(&from->FactorAssimRateTemp,
-                           &to->FactorAssimRateTemp);
-    copy_wofost_table_list(&from->FactorGrossAssimTemp,
-                           &to->FactorGrossAssimTemp);
-    copy_wofost_table_list(&from->FactorSenescence, &to->FactorSenescence);
-    copy_wofost_table_list(&from->DeathRateStems, &to->DeathRateStems);
-    copy_wofost_table_list(&from->DeathRateRoots, &to->DeathRateRoots);
-    copy_wofost_table_list(&from->CO2AMAXTB, &to->CO2AMAXTB);
-    copy_wofost_table_list(&from->CO2EFFTB, &to->CO2EFFTB);
-    copy_wofost_table_list(&from->CO2TRATB, &to->CO2TRATB);
-    copy_wofost_table_list(&from->N_MaxLeaves, &to->N_MaxLeaves);
-    copy_wofost_table_list(&from->P_MaxLeaves, &to->P_MaxLeaves);
-    copy_wofost_table_list(&from->K_MaxLeaves, &to->K_MaxLeaves);
+    /* Tables are read-only and shared with the crop library */
+    to->Roots = from->Roots;
+    to->Stems = from->Stems;
+    to->Leaves = from->Leaves;
+    to->Storage = from->Storage;
+    to->VernalizationRate = from->VernalizationRate;
+    to->DeltaTempSum = from->DeltaTempSum;
+    to->SpecificLeaveArea = from->SpecificLeaveArea;
+    to->SpecificStemArea = from->SpecificStemArea;
+    to->KDiffuseTb = from->KDiffuseTb;
+    to->EFFTb = from->EFFTb;
+    to->MaxAssimRate = from->MaxAssimRate;
+    to->FactorAssimRateTemp = from->FactorAssimRateTemp;
+    to->FactorGrossAssimTemp = from->FactorGrossAssimTemp;
+    to->FactorSenescence = from->FactorSenescence;
+    to->DeathRateStems = from->DeathRateStems;
+    to->DeathRateRoots = from->DeathRateRoots;
+    to->CO2AMAXTB = from->CO2AMAXTB;
+    to->CO2EFFTB = from->CO2EFFTB;
+    to->CO2TRATB = from->CO2TRATB;
+    to->N_MaxLeaves = from->N_MaxLeaves;
+    to->P_MaxLeaves = from->P_MaxLeaves;
+    to->K_MaxLeaves = from->K_MaxLeaves;
 
     to->TempBaseEmergence = from->TempBaseEmergence;
     to->TempEffMax = from->TempEffMax;
@@ -412,7 +333,7 @@ copy_wofost_plant(Plant *from,
     copy_wofost_nutrient_rates(&from->P_rt, &to->P_rt);
     copy_wofost_nutrient_states(&from->P_st, &to->P_st);
 
-    copy_wofost_green_list(&from->LeaveProperties, &to->LeaveProperties);
+    copy_wofost_green_list(from, to);
 }
 
 void
@@ -443,7 +364,7 @@ copy_wofost_field(Field *from,
     to->rt_P_mins = from->rt_P_mins;
     to->rt_K_mins = from->rt_K_mins;
 
-    copy_wofost_table_list(&from->NotInfTB, &to->NotInfTB);
+    to->NotInfTB = from->NotInfTB;
 }
 
 void
@@ -459,10 +380,8 @@ copy_wofost_soil(Soil *from,
     copy_wofost_rates(&from->rt, &to->rt);
     copy_wofost_constants(&from->ct, &to->ct);
 
-    copy_wofost_table_list(&from->HydraulicConductivity,
-                           &to->HydraulicConductivity);
-    copy_wofost_table_list(&from->VolumetricSoilMoisture,
-                           &to->VolumetricSoilMoisture);
+    to->HydraulicConductivity = from->HydraulicConductivity;
+    to->VolumetricSoilMoisture = from->VolumetricSoilMoisture;
 }
 
 void
@@ -512,10 +431,10 @@ copy_wofost_management(Management *from,
     to->P_Uptake_frac = from->P_Uptake_frac;
     to->K_Uptake_frac = from->K_Uptake_frac;
 
-    copy_wofost_table_d_list(&from->N_Fert_table, &to->N_Fert_table);
-    copy_wofost_table_d_list(&from->P_Fert_table, &to->P_Fert_table);
-    copy_wofost_table_d_list(&from->K_Fert_table, &to->K_Fert_table);
-    copy_wofost_table_d_list(&from->Irrigation, &to->Irrigation);
+    to->N_Fert_table = from->N_Fert_table;
+    to->P_Fert_table = from->P_Fert_table;
+    to->K_Fert_table = from->K_Fert_table;
+    to->Irrigation = from->Irrigation;
 }
 
 void
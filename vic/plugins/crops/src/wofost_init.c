@@ -9,6 +9,7 @@ wofost_set_data_text(char *list)
     extern plugin_option_struct plugin_options;
     extern crop_con_map_struct *crop_con_map;
     extern SimUnit           ***Grid;
+    extern SimUnit            **wofost_library;
 
     FILE                       *ifp;
     int                         Emergence;
@@ -28,6 +29,14 @@ wofost_set_data_text(char *list)
         log_err("Can't open wofost text file, %s\n", list);
     }
 
+    // the crop library owns the tables that are shared by all cells
+    wofost_library = malloc(plugin_options.NCROPTYPES *
+                            sizeof(*wofost_library));
+    check_alloc_status(wofost_library, "Memory allocation error");
+    for (k = 0; k < plugin_options.NCROPTYPES; k++) {
+        wofost_library[k] = NULL;
+    }
+
     k = 0;
     while (fgets(line, MAXSTRING, ifp)) {
         if (line[0] == '*' || line[0] == ' ' || line[0] == '\n' ||
@@ -80,7 +89,7 @@ wofost_set_data_text(char *list)
             }
         }
 
-        Clean(tmpGrid);
+        wofost_library[k] = tmpGrid;
         k++;
     }
 
@@ -4,18 +4,19 @@
 void
 initialize_wofost_table(TABLE *tbl)
 {
-    tbl->x = 0.;
-    tbl->y = 0.;
-    tbl->next = NULL;
+    tbl->n = 0;
+    tbl->x = NULL;
+    tbl->y = NULL;
 }
 
 void
 initialize_wofost_table_d(TABLE_D *tbld)
 {
-    tbld->amount = 0.;
-    tbld->day = 0;
-    tbld->month = 0;
-    tbld->next = NULL;
+    size_t i;
+
+    for (i = 0; i < NR_DAYS_LIST; i++) {
+        tbld->amount[i] = 0.;
+    }
 }
 
 void
@@ -74,7 +75,6 @@ initialize_wofost_geen(Green *gr)
     gr->age = 0.;
     gr->area = 0.;
     gr->weight = 0.;
-    gr->next = NULL;
 }
 
 void
@@ -307,6 +307,9 @@ initialize_wofost_plant(Plant *crp)
     initialize_wofost_nutrient_states(&crp->P_st);
 
     crp->LeaveProperties = NULL;
+    crp->LeaveSize = 0;
+    crp->LeaveStart = 0;
+    crp->LeaveCount = 0;
 }
 
 void
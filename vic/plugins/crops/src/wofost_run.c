@@ -55,7 +55,7 @@ wofost_run(SimUnit *Grid)
             Grid->mng->K_external = 0.;
         }
         else {
-            Harvest(&(Grid->crp->LeaveProperties));
+            Harvest(Grid->crp);
             Emergence = 0;
             Grid->cultivating = 0;
             Grid->growing = 0;
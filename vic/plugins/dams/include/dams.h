@@ -120,6 +120,7 @@ void dam_initialize_nc_file(nc_file_struct *);
 void dam_add_hist_dim(nc_file_struct *, stream_struct *);
 void dam_history(unsigned int, unsigned int *);
 void dam_put_data(size_t);
+void dam_checkpoint_cell(checkpoint_struct *, size_t);
 
 void local_dam_register(dam_con_struct *, dam_var_struct *, size_t);
 void global_dam_register(dam_con_struct *, dam_var_struct *, size_t);
@@ -68,15 +68,19 @@ dam_set_service(void)
     extern dam_con_struct        **dam_con;
 
     int                           *id_map;
+    rout_id_struct                *index;
     int                           *ivar;
     double                        *dvar;
     size_t                        *nservicing_tmp;
 
     size_t                         error_count;
+    size_t                         first;
+    size_t                         n;
 
     size_t                         i;
     size_t                         j;
     size_t                         k;
+    size_t                         l;
     int                            dam_index;
 
     size_t                         d2count[2];
@@ -97,6 +101,8 @@ dam_set_service(void)
 
     id_map = malloc(local_domain.ncells_active * sizeof(*id_map));
     check_alloc_status(id_map, "Memory allocation error.");
+    index = malloc((local_domain.ncells_active + 1) * sizeof(*index));
+    check_alloc_status(index, "Memory allocation error.");
     ivar = malloc(local_domain.ncells_active * sizeof(*ivar));
     check_alloc_status(ivar, "Memory allocation error.");
     dvar = malloc(local_domain.ncells_active * sizeof(*dvar));
@@ -107,6 +113,8 @@ dam_set_service(void)
     get_scatter_nc_field_int(&(plugin_filenames.dams),
                              "id_map", d2start, d2count, id_map);
 
+    rout_id_index(id_map, local_domain.ncells_active, index);
+
     error_count = 0;
     for (j = 0; j < plugin_options.NDAMTYPES; j++) {
         nservicing_tmp[j] = 0;
@@ -122,10 +130,12 @@ dam_set_service(void)
 
         for (i = 0; i < local_domain.ncells_active; i++) {
             if (ivar[i] > 0) {
-                for (k = 0; k < local_domain.ncells_active; k++) {
-                    if (ivar[i] != id_map[k]) {
-                        continue;
-                    }
+                n = rout_id_find(index, local_domain.ncells_active, ivar[i],
+                                 &first);
+
+                // all cells with the id
+                for (l = first; l < first + n; l++) {
+                    k = index[l].cell;
 
                     dam_index = dam_con_map[k].didx[j];
                     if (dam_index == NODATA_DAM) {
@@ -173,6 +183,7 @@ dam_set_service(void)
     }
 
     free(id_map);
+    free(index);
     free(ivar);
     free(dvar);
     free(nservicing_tmp);
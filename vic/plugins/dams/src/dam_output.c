@@ -306,6 +306,7 @@ dam_put_data(size_t iCell)
     extern dam_con_map_struct *dam_con_map;
     extern dam_var_struct    **dam_var;
     extern dam_con_struct    **dam_con;
+    extern bool                out_requested[];
 
     size_t                     iDam;
     size_t                     years_running;
@@ -321,15 +322,28 @@ dam_put_data(size_t iCell)
             years_running = DAM_HIST_YEARS;
         }
 
-        inflow = array_average(dam_var[iCell][iDam].history_inflow,
-                               years_running, 1, MONTHS_PER_YEAR - 1,
-                               MONTHS_PER_YEAR - 1);
-        demand = array_average(dam_var[iCell][iDam].history_demand,
-                               years_running, 1, MONTHS_PER_YEAR - 1,
-                               MONTHS_PER_YEAR - 1);
-        efr = array_average(dam_var[iCell][iDam].history_efr,
-                            years_running, 1, MONTHS_PER_YEAR - 1,
-                            MONTHS_PER_YEAR - 1);
+        // the history averages are only computed for requested output
+        inflow = 0.;
+        demand = 0.;
+        efr = 0.;
+        if (out_requested[N_OUTVAR_TYPES + OUT_LDAM_HIST_INFLOW] ||
+            out_requested[N_OUTVAR_TYPES + OUT_GDAM_HIST_INFLOW]) {
+            inflow = array_average(dam_var[iCell][iDam].history_inflow,
+                                   years_running, 1, MONTHS_PER_YEAR - 1,
+                                   MONTHS_PER_YEAR - 1);
+        }
+        if (out_requested[N_OUTVAR_TYPES + OUT_LDAM_HIST_DEMAND] ||
+            out_requested[N_OUTVAR_TYPES + OUT_GDAM_HIST_DEMAND]) {
+            demand = array_average(dam_var[iCell][iDam].history_demand,
+                                   years_running, 1, MONTHS_PER_YEAR - 1,
+                                   MONTHS_PER_YEAR - 1);
+        }
+        if (out_requested[N_OUTVAR_TYPES + OUT_LDAM_HIST_EFR] ||
+            out_requested[N_OUTVAR_TYPES + OUT_GDAM_HIST_EFR]) {
+            efr = array_average(dam_var[iCell][iDam].history_efr,
+                                years_running, 1, MONTHS_PER_YEAR - 1,
+                                MONTHS_PER_YEAR - 1);
+        }
 
         if (dam_con[iCell][iDam].type == DAM_LOCAL) {
             out_data[iCell][N_OUTVAR_TYPES +
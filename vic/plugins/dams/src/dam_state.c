@@ -0,0 +1,69 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Dam state functions
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_image.h>
+#include <plugin.h>
+
+/******************************************
+* @brief   Copy the dam state of a cell to or from a checkpoint
+******************************************/
+void
+dam_checkpoint_cell(checkpoint_struct *ckpt,
+                    size_t             iCell)
+{
+    extern dam_con_map_struct *dam_con_map;
+    extern dam_var_struct    **dam_var;
+
+    dam_var_struct            *var;
+    size_t                     i;
+    size_t                     j;
+
+    for (j = 0; j < dam_con_map[iCell].nd_active; j++) {
+        var = &(dam_var[iCell][j]);
+
+        checkpoint_bool(ckpt, &(var->active));
+        checkpoint_double(ckpt, &(var->inflow));
+        checkpoint_double(ckpt, &(var->demand));
+        checkpoint_double(ckpt, &(var->efr));
+        checkpoint_double(ckpt, &(var->release));
+        checkpoint_double(ckpt, &(var->storage));
+        for (i = 0; i < MONTHS_PER_YEAR * DAM_HIST_YEARS; i++) {
+            checkpoint_double(ckpt, &(var->history_inflow[i]));
+            checkpoint_double(ckpt, &(var->history_demand[i]));
+            checkpoint_double(ckpt, &(var->history_efr[i]));
+        }
+        for (i = 0; i < MONTHS_PER_YEAR; i++) {
+            checkpoint_double(ckpt, &(var->op_release[i]));
+            checkpoint_double(ckpt, &(var->op_storage[i]));
+        }
+        checkpoint_double(ckpt, &(var->total_inflow));
+        checkpoint_double(ckpt, &(var->total_demand));
+        checkpoint_double(ckpt, &(var->total_efr));
+        checkpoint_size_t(ckpt, &(var->register_steps));
+        checkpoint_int(ckpt, &(var->op_month));
+        checkpoint_size_t(ckpt, &(var->months_running));
+    }
+}
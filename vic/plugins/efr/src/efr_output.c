@@ -103,6 +103,7 @@ efr_put_data(size_t iCell)
     extern veg_con_struct    **veg_con;
     extern veg_con_map_struct *veg_con_map;
     extern double           ***out_data;
+    extern bool                out_requested[];
 
     double                     veg_fract;
     double                     area_fract;
@@ -115,6 +116,10 @@ efr_put_data(size_t iCell)
     out_data[iCell][N_OUTVAR_TYPES +
                     OUT_EFR_BASEFLOW][0] = efr_force[iCell].baseflow;
 
+    if (!out_requested[N_OUTVAR_TYPES + OUT_EFR_MOIST]) {
+        return;
+    }
+
     for (i = 0; i < veg_con_map[iCell].nv_active; i++) {
         veg_fract = veg_con[iCell][i].Cv;
         for (j = 0; j < options.SNOW_BAND; j++) {
@@ -330,6 +330,7 @@ void plugin_mpi_map_decomp_domain(size_t, size_t, int **, int **, size_t **);
 void plugin_start(void);
 void plugin_alloc(void);
 void plugin_init(void);
+void plugin_set_routing_stages(void);
 void plugin_finalize(void);
 
 void plugin_generate_default_state(void);
@@ -66,6 +66,7 @@ plugin_save_data_struct *plugin_save_data;
  *****************************************************************************/
 // output
 void plugin_set_output_met_data_info(void);
+void plugin_set_output_requested(void);
 void plugin_initialize_nc_file(nc_file_struct *nc_file);
 void plugin_add_hist_dim(nc_file_struct *nc, stream_struct  *stream);
 void plugin_set_nc_var_info(unsigned int varid, unsigned short int dtype,
@@ -87,5 +88,6 @@ void plugin_add_state_dim_var_data(char           *filename,
                                    nc_file_struct *nc_state_file);
 void plugin_set_nc_state_var_info(nc_file_struct *nc);
 void plugin_store(nc_file_struct *);
+void plugin_checkpoint_cell(checkpoint_struct *, size_t);
 
 #endif /* PLUGIN_DRIVER_SHARED_IMAGE_H */
@@ -35,6 +35,7 @@ void convolve(const double[], size_t, const double[], size_t, double[]);
 void cshift(double *, int, int, int, int);
 void size_t_sort(size_t *, size_t *, size_t, bool);
 void size_t_sort2(size_t *, int *, size_t, bool);
+void size_t_counting_sort(size_t *, size_t *, size_t, size_t);
 void double_flip(double *, size_t);
 void size_t_swap(size_t, size_t, size_t *);
 void int_swap(size_t, size_t, int *);
@@ -45,6 +45,9 @@ convolute(double  quantity,
 
 /******************************************************************************
  * @brief   Function to convolute two arrays
+ * @details The kernel is added to the result once per signal value, so the
+ *          inner loop has unit stride and no branches. Each Result[n] still
+ *          sums Signal[k] * Kernel[n - k] in order of k.
  *****************************************************************************/
 void
 convolve(const double Signal[] /* SignalLen */,
@@ -53,16 +56,15 @@ convolve(const double Signal[] /* SignalLen */,
          size_t       KernelLen,
          double       Result[] /* SignalLen + KernelLen - 1 */)
 {
-    size_t n, kmin, kmax, k;
+    size_t n, k;
 
     for (n = 0; n < SignalLen + KernelLen - 1; n++) {
         Result[n] = 0;
+    }
 
-        kmin = (n >= KernelLen - 1) ? n - (KernelLen - 1) : 0;
-        kmax = (n < SignalLen - 1) ? n : SignalLen - 1;
-
-        for (k = kmin; k <= kmax; k++) {
-            Result[n] += Signal[k] * Kernel[n - k];
+    for (k = 0; k < SignalLen; k++) {
+        for (n = 0; n < KernelLen; n++) {
+            Result[k + n] += Signal[k] * Kernel[n];
         }
     }
 }
@@ -53,10 +53,12 @@ gather_double(double *dvar,
 
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(var_local, local_domain.ncells_active, MPI_DOUBLE,
                          dvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_DOUBLE,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -142,10 +144,12 @@ gather_int(int *ivar,
 
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(ivar_local, local_domain.ncells_active, MPI_INT,
                          ivar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_INT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -231,10 +235,12 @@ gather_size_t(size_t *svar,
 
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_GATHER);
     status = MPI_Gatherv(svar_local, local_domain.ncells_active, MPI_AINT,
                          svar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_AINT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_GATHER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -324,10 +330,12 @@ scatter_double(double *dvar,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(dvar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_DOUBLE,
                           var_local, local_domain.ncells_active, MPI_DOUBLE,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -411,10 +419,12 @@ scatter_int(int *ivar,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(ivar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_INT,
                           var_local, local_domain.ncells_active, MPI_INT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
@@ -498,10 +508,12 @@ scatter_size_t(size_t *svar,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    INSTRUMENT_BEGIN(INSTR_SCATTER);
     status = MPI_Scatterv(svar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_AINT,
                           var_local, local_domain.ncells_active, MPI_AINT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
+    INSTRUMENT_END(INSTR_SCATTER);
     check_mpi_status(status, "MPI error.");
 
     if (mpi_rank == VIC_MPI_ROOT) {
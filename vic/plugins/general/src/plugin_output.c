@@ -86,6 +86,48 @@ plugin_set_output_met_data_info(void)
     }
 }
 
+/******************************************
+* @brief   Set the plugin output variables that are always computed
+******************************************/
+void
+plugin_set_output_requested(void)
+{
+    extern option_struct options;
+    extern bool          out_requested[];
+
+    if (!options.OUTPUT_ON_DEMAND) {
+        return;
+    }
+
+    // plugin_store_error() uses these for the plugin water balance and to
+    // adapt the save data
+    out_requested[N_OUTVAR_TYPES + OUT_STREAM_RUNOFF] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_STREAM_INFLOW] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_STREAM_MOIST] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_NONREN_DEFICIT] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_DISCHARGE] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_LDAM_INFLOW] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_LDAM_RELEASE] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_LDAM_STORAGE] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_GDAM_STORAGE] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_RECEIVED] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_APPLIED] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_LEFTOVER] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_RETURNED] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_WI_GW_SECT] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_WI_SURF_SECT] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_WI_DAM_SECT] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_WI_REM_SECT] = true;
+    out_requested[N_OUTVAR_TYPES + OUT_WI_NREN_SECT] = true;
+
+    // crop_put_rate_data() sums the crop evaporation from its components
+    if (out_requested[N_OUTVAR_TYPES + OUT_CROP_EVAP]) {
+        out_requested[N_OUTVAR_TYPES + OUT_CROP_EVAP_BARE] = true;
+        out_requested[N_OUTVAR_TYPES + OUT_CROP_TRANSP_VEG] = true;
+        out_requested[N_OUTVAR_TYPES + OUT_CROP_EVAP_CANOP] = true;
+    }
+}
+
 /******************************************
 * @brief   Initialize output file dimension size & id
 ******************************************/
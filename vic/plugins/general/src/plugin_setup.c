@@ -215,10 +215,137 @@ plugin_init(void)
     if (plugin_options.WOFOST) {
         crop_init();
     }
+    if (plugin_options.ROUTING &&
+        (plugin_options.DECOMPOSITION == BASIN_DECOMPOSITION ||
+         plugin_options.DECOMPOSITION == FILE_DECOMPOSITION)) {
+        plugin_set_routing_stages();
+    }
 
     plugin_set_state_meta_data_info();
 }
 
+/******************************************
+* @brief    Group the routing order into parallel stages
+* @details  Every cell touches a set of cells during plugin_run: itself,
+*           its upstream cells, its remote water-use receiving cells and
+*           the service cells of its global dams. A cell is placed one
+*           stage after the last stage that touched any of these cells,
+*           so cells that share data keep their serial order while
+*           independent cells (e.g. of different basins) share a stage.
+*           The routing order is stably sorted by stage.
+******************************************/
+void
+plugin_set_routing_stages(void)
+{
+    extern domain_struct        local_domain;
+    extern plugin_option_struct plugin_options;
+    extern rout_con_struct     *rout_con;
+    extern wu_con_struct       *wu_con;
+    extern dam_con_map_struct  *dam_con_map;
+    extern dam_con_struct     **dam_con;
+    extern size_t              *routing_order;
+    extern size_t              *routing_stage_start;
+    extern size_t               routing_nstages;
+
+    size_t                     *touched;
+    size_t                     *stage;
+    size_t                     *order_tmp;
+    size_t                      iCell;
+    size_t                      iStage;
+
+    size_t                      i;
+    size_t                      j;
+    size_t                      k;
+
+    touched = calloc(local_domain.ncells_active, sizeof(*touched));
+    check_alloc_status(touched, "Memory allocation error.");
+    stage = malloc(local_domain.ncells_active * sizeof(*stage));
+    check_alloc_status(stage, "Memory allocation error.");
+    order_tmp = malloc(local_domain.ncells_active * sizeof(*order_tmp));
+    check_alloc_status(order_tmp, "Memory allocation error.");
+
+    // Stage numbers start at 1 so that 0 means untouched
+    routing_nstages = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        iCell = routing_order[i];
+
+        iStage = touched[iCell];
+        for (j = 0; j < rout_con[iCell].Nupstream; j++) {
+            iStage = max(iStage, touched[rout_con[iCell].upstream[j]]);
+        }
+        if (plugin_options.WATERUSE && plugin_options.REMOTE_WITH) {
+            for (j = 0; j < wu_con[iCell].nreceiving; j++) {
+                iStage = max(iStage, touched[wu_con[iCell].receiving[j]]);
+            }
+        }
+        if (plugin_options.DAMS) {
+            for (j = 0; j < dam_con_map[iCell].nd_active; j++) {
+                if (dam_con[iCell][j].type != DAM_GLOBAL) {
+                    continue;
+                }
+                for (k = 0; k < dam_con[iCell][j].nservice; k++) {
+                    iStage = max(iStage,
+                                 touched[dam_con[iCell][j].service[k]]);
+                }
+            }
+        }
+        iStage++;
+
+        touched[iCell] = iStage;
+        for (j = 0; j < rout_con[iCell].Nupstream; j++) {
+            touched[rout_con[iCell].upstream[j]] = iStage;
+        }
+        if (plugin_options.WATERUSE && plugin_options.REMOTE_WITH) {
+            for (j = 0; j < wu_con[iCell].nreceiving; j++) {
+                touched[wu_con[iCell].receiving[j]] = iStage;
+            }
+        }
+        if (plugin_options.DAMS) {
+            for (j = 0; j < dam_con_map[iCell].nd_active; j++) {
+                if (dam_con[iCell][j].type != DAM_GLOBAL) {
+                    continue;
+                }
+                for (k = 0; k < dam_con[iCell][j].nservice; k++) {
+                    touched[dam_con[iCell][j].service[k]] = iStage;
+                }
+            }
+        }
+
+        stage[i] = iStage - 1;
+        routing_nstages = max(routing_nstages, iStage);
+    }
+
+    // Counting sort by stage (stable)
+    routing_stage_start = calloc(routing_nstages + 1,
+                                 sizeof(*routing_stage_start));
+    check_alloc_status(routing_stage_start, "Memory allocation error.");
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        routing_stage_start[stage[i] + 1]++;
+    }
+    for (iStage = 0; iStage < routing_nstages; iStage++) {
+        routing_stage_start[iStage + 1] += routing_stage_start[iStage];
+    }
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        touched[stage[i]] = 0;
+    }
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        iStage = stage[i];
+        order_tmp[routing_stage_start[iStage] + touched[iStage]] =
+            routing_order[i];
+        touched[iStage]++;
+    }
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        routing_order[i] = order_tmp[i];
+    }
+
+    log_info("Routing order grouped into %zu parallel stages for %zu cells",
+             routing_nstages, local_domain.ncells_active);
+
+    free(touched);
+    free(stage);
+    free(order_tmp);
+}
+
 /******************************************
 * @brief    Populate plugins by default
 ******************************************/
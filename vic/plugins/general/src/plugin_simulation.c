@@ -90,54 +90,89 @@ plugin_run(void)
     extern domain_struct        local_domain;
     extern plugin_option_struct plugin_options;
     extern size_t              *routing_order;
+    extern size_t              *routing_stage_start;
+    extern size_t               routing_nstages;
 
     size_t                      i;
     size_t                      iCell;
+    size_t                      iStage;
 
     // If running with OpenMP, run this for loop using multiple threads
     #pragma omp parallel for default(shared) private(i)
     for (i = 0; i < local_domain.ncells_active; i++) {
         if (plugin_options.IRRIGATION) {
+            INSTRUMENT_BEGIN(INSTR_IRRIGATION);
             irr_run_requirement(i);
+            INSTRUMENT_END(INSTR_IRRIGATION);
             if (plugin_options.WOFOST) {
+                INSTRUMENT_BEGIN(INSTR_CROPS);
                 crop_adjust_requirement(i);
+                INSTRUMENT_END(INSTR_CROPS);
             }
             if (plugin_options.WATERUSE) {
+                INSTRUMENT_BEGIN(INSTR_IRRIGATION);
                 irr_set_demand(i);
+                INSTRUMENT_END(INSTR_IRRIGATION);
             }
         }
         if (plugin_options.WATERUSE) {
+            INSTRUMENT_BEGIN(INSTR_WATERUSE);
             wu_run(i);
+            INSTRUMENT_END(INSTR_WATERUSE);
         }
         if (plugin_options.ROUTING ||
             (plugin_options.WATERUSE && plugin_options.NONRENEW_WITH)) {
+            INSTRUMENT_BEGIN(INSTR_ROUTING);
             rout_run(i);
+            INSTRUMENT_END(INSTR_ROUTING);
         }
     }
 
     if (plugin_options.ROUTING) {
         if (plugin_options.DECOMPOSITION == BASIN_DECOMPOSITION ||
             plugin_options.DECOMPOSITION == FILE_DECOMPOSITION) {
-            for (i = 0; i < local_domain.ncells_active; i++) {
-                iCell = routing_order[i];
+            // Cells within a stage are independent (see
+            // plugin_set_routing_stages), stages run in order
+            for (iStage = 0; iStage < routing_nstages; iStage++) {
+                // If running with OpenMP, run each stage with multiple threads
+                #pragma omp parallel for default(shared) private(i, iCell)
+                for (i = routing_stage_start[iStage];
+                     i < routing_stage_start[iStage + 1];
+                     i++) {
+                    iCell = routing_order[i];
 
-                if (plugin_options.DAMS) {
-                    local_dam_run(iCell);
-                }
-                rout_basin_run(iCell);
-                if (plugin_options.WATERUSE && plugin_options.LOCAL_WITH) {
-                    wu_run_local(iCell);
-                }
-                if (plugin_options.DAMS) {
-                    global_dam_run(iCell);
-                }
-                if (plugin_options.WATERUSE && plugin_options.REMOTE_WITH) {
-                    wu_remote(iCell);
+                    if (plugin_options.DAMS) {
+                        INSTRUMENT_BEGIN(INSTR_DAMS);
+                        local_dam_run(iCell);
+                        INSTRUMENT_END(INSTR_DAMS);
+                    }
+                    INSTRUMENT_BEGIN(INSTR_ROUTING);
+                    rout_basin_run(iCell);
+                    INSTRUMENT_END(INSTR_ROUTING);
+                    if (plugin_options.WATERUSE &&
+                        plugin_options.LOCAL_WITH) {
+                        INSTRUMENT_BEGIN(INSTR_WATERUSE);
+                        wu_run_local(iCell);
+                        INSTRUMENT_END(INSTR_WATERUSE);
+                    }
+                    if (plugin_options.DAMS) {
+                        INSTRUMENT_BEGIN(INSTR_DAMS);
+                        global_dam_run(iCell);
+                        INSTRUMENT_END(INSTR_DAMS);
+                    }
+                    if (plugin_options.WATERUSE &&
+                        plugin_options.REMOTE_WITH) {
+                        INSTRUMENT_BEGIN(INSTR_WATERUSE);
+                        wu_remote(iCell);
+                        INSTRUMENT_END(INSTR_WATERUSE);
+                    }
                 }
             }
         }
         else if (plugin_options.DECOMPOSITION == RANDOM_DECOMPOSITION) {
+            INSTRUMENT_BEGIN(INSTR_ROUTING);
             rout_random_run();
+            INSTRUMENT_END(INSTR_ROUTING);
         }
     }
 
@@ -145,19 +180,25 @@ plugin_run(void)
     #pragma omp parallel for default(shared) private(i)
     for (i = 0; i < local_domain.ncells_active; i++) {
         if (plugin_options.WATERUSE && plugin_options.NONRENEW_WITH) {
+            INSTRUMENT_BEGIN(INSTR_WATERUSE);
             wu_nonrenew(i);
+            INSTRUMENT_END(INSTR_WATERUSE);
         }
         if (plugin_options.IRRIGATION) {
+            INSTRUMENT_BEGIN(INSTR_IRRIGATION);
             if (plugin_options.POTENTIAL_IRRIGATION ||
                 plugin_options.WATERUSE ||
                 plugin_options.WOFOST) {
                 irr_get_withdrawn(i);
             }
             irr_run_shortage(i);
+            INSTRUMENT_END(INSTR_IRRIGATION);
         }
 
         if (plugin_options.WOFOST) {
+            INSTRUMENT_BEGIN(INSTR_CROPS);
             crop_run(i);
+            INSTRUMENT_END(INSTR_CROPS);
         }
     }
 }
@@ -229,3 +270,20 @@ plugin_store(nc_file_struct *state_file)
         log_warn("DAM state restore not implemented yet...");
     }
 }
+
+/******************************************
+* @brief    Copy the plugin state of a cell to or from a checkpoint
+******************************************/
+void
+plugin_checkpoint_cell(checkpoint_struct *ckpt,
+                       size_t             iCell)
+{
+    extern plugin_option_struct plugin_options;
+
+    if (plugin_options.ROUTING) {
+        rout_checkpoint_cell(ckpt, iCell);
+    }
+    if (plugin_options.DAMS) {
+        dam_checkpoint_cell(ckpt, iCell);
+    }
+}
@@ -26,6 +26,8 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <vic_log.h>
 
 /******************************************************************************
  * @brief   Swap size_t in array
@@ -148,6 +150,46 @@ size_t_sort2(size_t *array,
     }
 }
 
+/******************************************************************************
+ * @brief   Stable counting sort of an index array
+ * @details Sorts array (indices into key) ascending on key[array[i]], where
+ *          all keys are smaller than Nkeys. Equal keys keep their order.
+ *****************************************************************************/
+void
+size_t_counting_sort(size_t *array,
+                     size_t *key,
+                     size_t  Nkeys,
+                     size_t  Nelements)
+{
+    size_t  i;
+    size_t *count;
+    size_t *tmp_array;
+
+    count = malloc((Nkeys + 1) * sizeof(*count));
+    check_alloc_status(count, "Memory allocation error.");
+    tmp_array = malloc((Nelements + 1) * sizeof(*tmp_array));
+    check_alloc_status(tmp_array, "Memory allocation error.");
+
+    for (i = 0; i <= Nkeys; i++) {
+        count[i] = 0;
+    }
+    for (i = 0; i < Nelements; i++) {
+        count[key[array[i]] + 1]++;
+    }
+    for (i = 0; i < Nkeys; i++) {
+        count[i + 1] += count[i];
+    }
+    for (i = 0; i < Nelements; i++) {
+        tmp_array[count[key[array[i]]]++] = array[i];
+    }
+    for (i = 0; i < Nelements; i++) {
+        array[i] = tmp_array[i];
+    }
+
+    free(count);
+    free(tmp_array);
+}
+
 /******************************************************************************
  * @brief   Flip double array
  *****************************************************************************/
@@ -38,10 +38,29 @@ typedef struct {
     double *veg_class; /**< vegetation class */
 } lu_force_struct;
 
+/******************************************************************************
+ * @brief   Land-use workspace (per thread)
+ *****************************************************************************/
+typedef struct {
+    double *Cv_old; /**< vegetation coverage before the change [-] */
+    double *Cv_new; /**< vegetation coverage after the change [-] */
+    double *Cv_change; /**< vegetation coverage change [-] */
+    double *snow_surf_capacity; /**< snow surface heat capacity [J m-2 K-1] */
+    double *snow_pack_capacity; /**< snow pack heat capacity [J m-2 K-1] */
+    double **node_capacity; /**< soil node heat capacity [J m-3 K-1] */
+    double *orig_surf_tempEnergy; /**< snow surface energy before [J m-2] */
+    double *orig_pack_tempEnergy; /**< snow pack energy before [J m-2] */
+    double **orig_TEnergy; /**< soil node energy before [J m-3] */
+    double *new_surf_tempEnergy; /**< snow surface energy after [J m-2] */
+    double *new_pack_tempEnergy; /**< snow pack energy after [J m-2] */
+    double **new_TEnergy; /**< soil node energy after [J m-3] */
+} lu_scratch_struct;
+
 /******************************************************************************
  * @brief   Public structures
  *****************************************************************************/
-lu_force_struct *lu_force;
+lu_force_struct   *lu_force;
+lu_scratch_struct *lu_scratch;
 
 /******************************************************************************
  * @brief   Functions
@@ -53,6 +72,8 @@ void lu_alloc(void);
 void lu_initialize_local_structures(void);
 void lu_forcing(void);
 void lu_apply(void);
+bool lu_cell_changed(size_t);
+void lu_apply_cell(size_t, lu_scratch_struct *);
 
 void get_heat_capacities(size_t, size_t, double *, double *, double **,
                          double *);
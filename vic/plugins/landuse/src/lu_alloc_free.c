@@ -36,9 +36,13 @@ lu_alloc(void)
     extern domain_struct       local_domain;
     extern veg_con_map_struct *veg_con_map;
 
+    extern option_struct       options;
     extern lu_force_struct    *lu_force;
+    extern lu_scratch_struct  *lu_scratch;
 
+    size_t                     nthreads;
     size_t                     i;
+    size_t                     j;
 
     lu_force = malloc(local_domain.ncells_active * sizeof(*lu_force));
     check_alloc_status(lu_force, "Memory allocation error");
@@ -54,6 +58,82 @@ lu_alloc(void)
                            "Memory allocation error");
     }
 
+    // Workspace per thread, so cells can be adjusted in parallel
+    nthreads = omp_get_max_threads();
+    lu_scratch = malloc(nthreads * sizeof(*lu_scratch));
+    check_alloc_status(lu_scratch, "Memory allocation error");
+
+    for (i = 0; i < nthreads; i++) {
+        lu_scratch[i].Cv_old =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].Cv_old));
+        check_alloc_status(lu_scratch[i].Cv_old, "Memory allocation error");
+        lu_scratch[i].Cv_new =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].Cv_new));
+        check_alloc_status(lu_scratch[i].Cv_new, "Memory allocation error");
+        lu_scratch[i].Cv_change =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].Cv_change));
+        check_alloc_status(lu_scratch[i].Cv_change,
+                           "Memory allocation error");
+
+        lu_scratch[i].snow_surf_capacity =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].snow_surf_capacity));
+        check_alloc_status(lu_scratch[i].snow_surf_capacity,
+                           "Memory allocation error");
+        lu_scratch[i].snow_pack_capacity =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].snow_pack_capacity));
+        check_alloc_status(lu_scratch[i].snow_pack_capacity,
+                           "Memory allocation error");
+        lu_scratch[i].node_capacity =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].node_capacity));
+        check_alloc_status(lu_scratch[i].node_capacity,
+                           "Memory allocation error");
+        lu_scratch[i].orig_surf_tempEnergy =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].orig_surf_tempEnergy));
+        check_alloc_status(lu_scratch[i].orig_surf_tempEnergy,
+                           "Memory allocation error");
+        lu_scratch[i].orig_pack_tempEnergy =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].orig_pack_tempEnergy));
+        check_alloc_status(lu_scratch[i].orig_pack_tempEnergy,
+                           "Memory allocation error");
+        lu_scratch[i].orig_TEnergy =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].orig_TEnergy));
+        check_alloc_status(lu_scratch[i].orig_TEnergy,
+                           "Memory allocation error");
+        lu_scratch[i].new_surf_tempEnergy =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].new_surf_tempEnergy));
+        check_alloc_status(lu_scratch[i].new_surf_tempEnergy,
+                           "Memory allocation error");
+        lu_scratch[i].new_pack_tempEnergy =
+            malloc(options.NVEGTYPES *
+                   sizeof(*lu_scratch[i].new_pack_tempEnergy));
+        check_alloc_status(lu_scratch[i].new_pack_tempEnergy,
+                           "Memory allocation error");
+        lu_scratch[i].new_TEnergy =
+            malloc(options.NVEGTYPES * sizeof(*lu_scratch[i].new_TEnergy));
+        check_alloc_status(lu_scratch[i].new_TEnergy,
+                           "Memory allocation error");
+
+        for (j = 0; j < options.NVEGTYPES; j++) {
+            lu_scratch[i].node_capacity[j] =
+                malloc(options.Nnode * sizeof(*lu_scratch[i].node_capacity[j]));
+            check_alloc_status(lu_scratch[i].node_capacity[j],
+                               "Memory allocation error");
+            lu_scratch[i].orig_TEnergy[j] =
+                malloc(options.Nnode * sizeof(*lu_scratch[i].orig_TEnergy[j]));
+            check_alloc_status(lu_scratch[i].orig_TEnergy[j],
+                               "Memory allocation error");
+            lu_scratch[i].new_TEnergy[j] =
+                malloc(options.Nnode * sizeof(*lu_scratch[i].new_TEnergy[j]));
+            check_alloc_status(lu_scratch[i].new_TEnergy[j],
+                               "Memory allocation error");
+        }
+    }
+
     lu_initialize_local_structures();
 }
 
@@ -63,10 +143,14 @@ lu_alloc(void)
 void
 lu_finalize(void)
 {
-    extern domain_struct    local_domain;
-    extern lu_force_struct *lu_force;
+    extern domain_struct      local_domain;
+    extern option_struct      options;
+    extern lu_force_struct   *lu_force;
+    extern lu_scratch_struct *lu_scratch;
 
-    size_t                  i;
+    size_t                    nthreads;
+    size_t                    i;
+    size_t                    j;
 
     for (i = 0; i < local_domain.ncells_active; i++) {
         free(lu_force[i].Cv);
@@ -74,4 +158,26 @@ lu_finalize(void)
     }
 
     free(lu_force);
+
+    nthreads = omp_get_max_threads();
+    for (i = 0; i < nthreads; i++) {
+        for (j = 0; j < options.NVEGTYPES; j++) {
+            free(lu_scratch[i].node_capacity[j]);
+            free(lu_scratch[i].orig_TEnergy[j]);
+            free(lu_scratch[i].new_TEnergy[j]);
+        }
+        free(lu_scratch[i].Cv_old);
+        free(lu_scratch[i].Cv_new);
+        free(lu_scratch[i].Cv_change);
+        free(lu_scratch[i].snow_surf_capacity);
+        free(lu_scratch[i].snow_pack_capacity);
+        free(lu_scratch[i].node_capacity);
+        free(lu_scratch[i].orig_surf_tempEnergy);
+        free(lu_scratch[i].orig_pack_tempEnergy);
+        free(lu_scratch[i].orig_TEnergy);
+        free(lu_scratch[i].new_surf_tempEnergy);
+        free(lu_scratch[i].new_pack_tempEnergy);
+        free(lu_scratch[i].new_TEnergy);
+    }
+    free(lu_scratch);
 }
@@ -899,12 +899,65 @@ distribute_irrigation_balance_terms(size_t  iCell,
 }
 
 /******************************************
-* @brief   Apply land-use vegetation fractions
+* @brief   Check whether the land-use vegetation fractions of a cell changed
+* @details A cell changed if any (normalized) forcing fraction differs from
+*          the current fraction by more than MINCOVERAGECHANGE.
+******************************************/
+bool
+lu_cell_changed(size_t iCell)
+{
+    extern domain_struct       local_domain;
+    extern veg_con_map_struct *veg_con_map;
+    extern veg_con_struct    **veg_con;
+    extern lu_force_struct    *lu_force;
+
+    char                       locstr[MAXSTRING];
+    double                     Cv_sum;
+    bool                       changed;
+
+    size_t                     iVeg;
+
+    Cv_sum = 0.0;
+    for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
+        Cv_sum += lu_force[iCell].Cv[iVeg];
+    }
+
+    // Check
+    if (Cv_sum <= 0.0) {
+        sprint_location(locstr, &(local_domain.locations[iCell]));
+        log_err("Sum of veg tile area fractions !=  1.0 (%.16f) at grid "
+                "cell %zd. Cannot adjust fractions ...\n%s", Cv_sum, iCell,
+                locstr);
+    }
+    if (!assert_close_double(Cv_sum, 1., 0., AREA_SUM_ERROR_THRESH)) {
+        sprint_location(locstr, &(local_domain.locations[iCell]));
+        log_warn("Sum of veg tile area fractions !=  1.0 (%.16f) at grid "
+                 "cell %zd. Adjusting fractions ...\n%s", Cv_sum, iCell,
+                 locstr);
+    }
+
+    changed = false;
+    for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
+        if (fabs(lu_force[iCell].Cv[iVeg] / Cv_sum -
+                 veg_con[iCell][iVeg].Cv) > MINCOVERAGECHANGE) {
+            changed = true;
+            break;
+        }
+    }
+
+    return changed;
+}
+
+/******************************************
+* @brief   Apply land-use vegetation fractions to a single cell
+* @details Water, carbon, energy and irrigation terms are redistributed over
+*          the vegetation tiles. scratch is the workspace of the calling
+*          thread.
 ******************************************/
 void
-lu_apply(void)
+lu_apply_cell(size_t             iCell,
+              lu_scratch_struct *scratch)
 {
-    extern domain_struct        local_domain;
     extern option_struct        options;
     extern plugin_option_struct plugin_options;
     extern veg_con_map_struct  *veg_con_map;
@@ -912,7 +965,6 @@ lu_apply(void)
     extern lu_force_struct     *lu_force;
     extern soil_con_struct     *soil_con;
 
-    char                        locstr[MAXSTRING];
     double                      Cv_sum;
     double                     *Cv_old;
     double                     *Cv_new;
@@ -938,218 +990,176 @@ lu_apply(void)
     double                      max_carbon;
     double                      max_energy;
 
-    size_t                      iCell;
     size_t                      iVeg;
     size_t                      iBand;
     size_t                      veg_class;
 
-    Cv_old = malloc(options.NVEGTYPES * sizeof(*Cv_old));
-    check_alloc_status(Cv_old, "Memory allocation error");
-    Cv_new = malloc(options.NVEGTYPES * sizeof(*Cv_new));
-    check_alloc_status(Cv_new, "Memory allocation error");
-    Cv_change = malloc(options.NVEGTYPES * sizeof(*Cv_change));
-    check_alloc_status(Cv_change, "Memory allocation error");
-
-    snow_surf_capacity =
-        malloc(options.NVEGTYPES * sizeof(*snow_surf_capacity));
-    check_alloc_status(snow_surf_capacity, "Memory allocation error");
-    snow_pack_capacity =
-        malloc(options.NVEGTYPES * sizeof(*snow_pack_capacity));
-    check_alloc_status(snow_pack_capacity, "Memory allocation error");
-    node_capacity = malloc(options.NVEGTYPES * sizeof(*node_capacity));
-    check_alloc_status(node_capacity, "Memory allocation error");
-    orig_surf_tempEnergy =
-        malloc(options.NVEGTYPES * sizeof(*orig_surf_tempEnergy));
-    check_alloc_status(orig_surf_tempEnergy, "Memory allocation error");
-    orig_pack_tempEnergy =
-        malloc(options.NVEGTYPES * sizeof(*orig_pack_tempEnergy));
-    check_alloc_status(orig_pack_tempEnergy, "Memory allocation error");
-    orig_TEnergy = malloc(options.NVEGTYPES * sizeof(*orig_TEnergy));
-    check_alloc_status(orig_TEnergy, "Memory allocation error");
-    new_surf_tempEnergy = malloc(
-        options.NVEGTYPES * sizeof(*new_surf_tempEnergy));
-    check_alloc_status(new_surf_tempEnergy, "Memory allocation error");
-    new_pack_tempEnergy = malloc(
-        options.NVEGTYPES * sizeof(*new_pack_tempEnergy));
-    check_alloc_status(new_pack_tempEnergy, "Memory allocation error");
-    new_TEnergy = malloc(options.NVEGTYPES * sizeof(*new_TEnergy));
-    check_alloc_status(new_TEnergy, "Memory allocation error");
-    for (iVeg = 0; iVeg < options.NVEGTYPES; iVeg++) {
-        node_capacity[iVeg] = malloc(
-            options.Nnode * sizeof(*node_capacity[iVeg]));
-        check_alloc_status(node_capacity[iVeg], "Memory allocation error");
-        orig_TEnergy[iVeg] =
-            malloc(options.Nnode * sizeof(*orig_TEnergy[iVeg]));
-        check_alloc_status(orig_TEnergy[iVeg], "Memory allocation error");
-        new_TEnergy[iVeg] = malloc(options.Nnode * sizeof(*new_TEnergy[iVeg]));
-        check_alloc_status(new_TEnergy[iVeg], "Memory allocation error");
+    Cv_old = scratch->Cv_old;
+    Cv_new = scratch->Cv_new;
+    Cv_change = scratch->Cv_change;
+    snow_surf_capacity = scratch->snow_surf_capacity;
+    snow_pack_capacity = scratch->snow_pack_capacity;
+    node_capacity = scratch->node_capacity;
+    orig_surf_tempEnergy = scratch->orig_surf_tempEnergy;
+    orig_pack_tempEnergy = scratch->orig_pack_tempEnergy;
+    orig_TEnergy = scratch->orig_TEnergy;
+    new_surf_tempEnergy = scratch->new_surf_tempEnergy;
+    new_pack_tempEnergy = scratch->new_pack_tempEnergy;
+    new_TEnergy = scratch->new_TEnergy;
+
+    // Initialize
+    Cv_sum = 0.0;
+
+    // Calculate
+    for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
+        Cv_sum += lu_force[iCell].Cv[iVeg];
+        Cv_old[iVeg] = veg_con[iCell][iVeg].Cv;
     }
 
-    for (iCell = 0; iCell < local_domain.ncells_active; iCell++) {
-        // Initialize
-        Cv_sum = 0.0;
-
-        // Calculate
-        for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
-            Cv_sum += lu_force[iCell].Cv[iVeg];
-            Cv_old[iVeg] = veg_con[iCell][iVeg].Cv;
-        }
-
-        // Set
-        for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
-            veg_class = lu_force[iCell].veg_class[iVeg];
-
-            veg_con_map[iCell].Cv[veg_class] = lu_force[iCell].Cv[iVeg] /
-                                               Cv_sum;
-            veg_con[iCell][iVeg].Cv = lu_force[iCell].Cv[iVeg] / Cv_sum;
-        }
+    // Set
+    for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
+        veg_class = lu_force[iCell].veg_class[iVeg];
 
-        // Check
-        if (Cv_sum <= 0.0) {
-            sprint_location(locstr, &(local_domain.locations[iCell]));
-            log_err("Sum of veg tile area fractions !=  1.0 (%.16f) at grid "
-                    "cell %zd. Cannot adjust fractions ...\n%s", Cv_sum, iCell,
-                    locstr);
-        }
-        if (!assert_close_double(Cv_sum, 1., 0., AREA_SUM_ERROR_THRESH)) {
-            sprint_location(locstr, &(local_domain.locations[iCell]));
-            log_warn("Sum of veg tile area fractions !=  1.0 (%.16f) at grid "
-                     "cell %zd. Adjusting fractions ...\n%s", Cv_sum, iCell,
-                     locstr);
-        }
+        veg_con_map[iCell].Cv[veg_class] = lu_force[iCell].Cv[iVeg] /
+                                           Cv_sum;
+        veg_con[iCell][iVeg].Cv = lu_force[iCell].Cv[iVeg] / Cv_sum;
+    }
 
-        for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
-            Cv_new[iVeg] = veg_con[iCell][iVeg].Cv;
-            Cv_change[iVeg] = Cv_new[iVeg] - Cv_old[iVeg];
-        }
+    for (iVeg = 0; iVeg < veg_con_map[iCell].nv_active; iVeg++) {
+        Cv_new[iVeg] = veg_con[iCell][iVeg].Cv;
+        Cv_change[iVeg] = Cv_new[iVeg] - Cv_old[iVeg];
+    }
 
-        // Adjust
-        for (iBand = 0; iBand < options.SNOW_BAND; iBand++) {
-            if (soil_con[iCell].AreaFract[iBand] > 0) {
-                // Initialize energy
-                calculate_derived_water_states(iCell, iBand);
-                get_heat_capacities(iCell, iBand,
-                                    snow_surf_capacity, snow_pack_capacity,
-                                    node_capacity,
-                                    Cv_old);
-                get_energy_terms(iCell, iBand,
-                                 snow_surf_capacity, snow_pack_capacity,
-                                 node_capacity,
-                                 orig_surf_tempEnergy, orig_pack_tempEnergy,
-                                 orig_TEnergy);
-
-                // Gather initial states
-                before_water = calculate_total_water(iCell, iBand, Cv_old,
-                                                     Cv_change);
-                before_carbon = calculate_total_carbon(iCell, iBand, Cv_old,
-                                                       Cv_change);
-                before_energy = calculate_total_energy(iCell,
-                                                       orig_surf_tempEnergy,
-                                                       orig_pack_tempEnergy,
-                                                       orig_TEnergy, Cv_old,
-                                                       Cv_change);
-
-                // Water
-                distribute_water_balance_terms(iCell, iBand,
-                                               Cv_change, Cv_old, Cv_new);
-                calculate_derived_water_states(iCell, iBand);
-
-                // Carbon
-                distribute_carbon_balance_terms(iCell, iBand,
-                                                Cv_change, Cv_old, Cv_new);
-
-                // Energy
-                get_heat_capacities(iCell, iBand,
-                                    snow_surf_capacity, snow_pack_capacity,
-                                    node_capacity,
-                                    Cv_new);
-                distribute_energy_balance_terms(iCell, iBand,
-                                                Cv_change, Cv_old, Cv_new,
-                                                snow_surf_capacity,
-                                                snow_pack_capacity,
-                                                node_capacity,
-                                                orig_surf_tempEnergy,
-                                                orig_pack_tempEnergy,
-                                                orig_TEnergy,
-                                                new_surf_tempEnergy,
-                                                new_pack_tempEnergy,
-                                                new_TEnergy);
-                get_energy_terms(iCell, iBand,
-                                 snow_surf_capacity, snow_pack_capacity,
-                                 node_capacity,
-                                 new_surf_tempEnergy, new_pack_tempEnergy,
-                                 new_TEnergy);
-                calculate_derived_energy_states(iCell, iBand,
-                                                snow_surf_capacity);
-
-                // Gather final states
-                after_water = calculate_total_water(iCell, iBand, Cv_new,
-                                                    Cv_change);
-                after_carbon = calculate_total_carbon(iCell, iBand, Cv_new,
-                                                      Cv_change);
-                after_energy = calculate_total_energy(iCell,
-                                                      new_surf_tempEnergy,
-                                                      new_pack_tempEnergy,
-                                                      new_TEnergy, Cv_new,
-                                                      Cv_change);
-
-                max_water = max(fabs(before_water), fabs(after_water));
-                max_carbon = max(fabs(before_carbon), fabs(after_carbon));
-                max_energy = max(fabs(before_energy), fabs(after_energy));
-                max_water = max(max_water, DBL_EPSILON);
-                max_carbon = max(max_carbon, DBL_EPSILON);
-                max_energy = max(max_energy, DBL_EPSILON);
-                if (fabs(before_water - after_water) >
-                    max_water * veg_con_map[iCell].nv_active *
-                    MINCOVERAGECHANGE) {
-                    log_warn(
-                        "Water balance error [%.4f out of %.4f mm] for cell [%zu]",
-                        fabs(before_water - max_water), after_water,
-                        iCell);
-                }
-                if (fabs(before_carbon - after_carbon) >
-                    max_carbon * veg_con_map[iCell].nv_active *
-                    MINCOVERAGECHANGE) {
-                    log_warn(
-                        "Carbon balance error [%.4f out of %.4f g m-2] for cell [%zu]",
-                        fabs(
-                            before_carbon - after_carbon), max_carbon, iCell);
-                }
-                if (fabs(before_energy - after_energy) >
-                    max_energy * veg_con_map[iCell].nv_active *
-                    MINCOVERAGECHANGE) {
-                    log_warn(
-                        "Energy balance error [%.4f out of %.4f J m-3] for cell [%zu]",
-                        fabs(
-                            before_energy - after_energy), max_energy, iCell);
-                }
+    // Adjust
+    for (iBand = 0; iBand < options.SNOW_BAND; iBand++) {
+        if (soil_con[iCell].AreaFract[iBand] > 0) {
+            // Initialize energy
+            calculate_derived_water_states(iCell, iBand);
+            get_heat_capacities(iCell, iBand,
+                                snow_surf_capacity, snow_pack_capacity,
+                                node_capacity,
+                                Cv_old);
+            get_energy_terms(iCell, iBand,
+                             snow_surf_capacity, snow_pack_capacity,
+                             node_capacity,
+                             orig_surf_tempEnergy, orig_pack_tempEnergy,
+                             orig_TEnergy);
+
+            // Gather initial states
+            before_water = calculate_total_water(iCell, iBand, Cv_old,
+                                                 Cv_change);
+            before_carbon = calculate_total_carbon(iCell, iBand, Cv_old,
+                                                   Cv_change);
+            before_energy = calculate_total_energy(iCell,
+                                                   orig_surf_tempEnergy,
+                                                   orig_pack_tempEnergy,
+                                                   orig_TEnergy, Cv_old,
+                                                   Cv_change);
+
+            // Water
+            distribute_water_balance_terms(iCell, iBand,
+                                           Cv_change, Cv_old, Cv_new);
+            calculate_derived_water_states(iCell, iBand);
+
+            // Carbon
+            distribute_carbon_balance_terms(iCell, iBand,
+                                            Cv_change, Cv_old, Cv_new);
+
+            // Energy
+            get_heat_capacities(iCell, iBand,
+                                snow_surf_capacity, snow_pack_capacity,
+                                node_capacity,
+                                Cv_new);
+            distribute_energy_balance_terms(iCell, iBand,
+                                            Cv_change, Cv_old, Cv_new,
+                                            snow_surf_capacity,
+                                            snow_pack_capacity,
+                                            node_capacity,
+                                            orig_surf_tempEnergy,
+                                            orig_pack_tempEnergy,
+                                            orig_TEnergy,
+                                            new_surf_tempEnergy,
+                                            new_pack_tempEnergy,
+                                            new_TEnergy);
+            get_energy_terms(iCell, iBand,
+                             snow_surf_capacity, snow_pack_capacity,
+                             node_capacity,
+                             new_surf_tempEnergy, new_pack_tempEnergy,
+                             new_TEnergy);
+            calculate_derived_energy_states(iCell, iBand,
+                                            snow_surf_capacity);
+
+            // Gather final states
+            after_water = calculate_total_water(iCell, iBand, Cv_new,
+                                                Cv_change);
+            after_carbon = calculate_total_carbon(iCell, iBand, Cv_new,
+                                                  Cv_change);
+            after_energy = calculate_total_energy(iCell,
+                                                  new_surf_tempEnergy,
+                                                  new_pack_tempEnergy,
+                                                  new_TEnergy, Cv_new,
+                                                  Cv_change);
+
+            max_water = max(fabs(before_water), fabs(after_water));
+            max_carbon = max(fabs(before_carbon), fabs(after_carbon));
+            max_energy = max(fabs(before_energy), fabs(after_energy));
+            max_water = max(max_water, DBL_EPSILON);
+            max_carbon = max(max_carbon, DBL_EPSILON);
+            max_energy = max(max_energy, DBL_EPSILON);
+            if (fabs(before_water - after_water) >
+                max_water * veg_con_map[iCell].nv_active *
+                MINCOVERAGECHANGE) {
+                log_warn(
+                    "Water balance error [%.4f out of %.4f mm] for cell [%zu]",
+                    fabs(before_water - max_water), after_water,
+                    iCell);
+            }
+            if (fabs(before_carbon - after_carbon) >
+                max_carbon * veg_con_map[iCell].nv_active *
+                MINCOVERAGECHANGE) {
+                log_warn(
+                    "Carbon balance error [%.4f out of %.4f g m-2] for cell [%zu]",
+                    fabs(
+                        before_carbon - after_carbon), max_carbon, iCell);
+            }
+            if (fabs(before_energy - after_energy) >
+                max_energy * veg_con_map[iCell].nv_active *
+                MINCOVERAGECHANGE) {
+                log_warn(
+                    "Energy balance error [%.4f out of %.4f J m-3] for cell [%zu]",
+                    fabs(
+                        before_energy - after_energy), max_energy, iCell);
+            }
 
-                if (plugin_options.IRRIGATION && plugin_options.ROUTING) {
-                    // Irrigation
-                    distribute_irrigation_balance_terms(iCell, iBand,
-                                                        Cv_change, Cv_old,
-                                                        Cv_new);
-                }
+            if (plugin_options.IRRIGATION && plugin_options.ROUTING) {
+                // Irrigation
+                distribute_irrigation_balance_terms(iCell, iBand,
+                                                    Cv_change, Cv_old,
+                                                    Cv_new);
             }
         }
     }
+}
 
-    free(Cv_change);
-    free(Cv_old);
-    free(Cv_new);
+/******************************************
+* @brief   Apply land-use vegetation fractions
+* @details Only cells whose vegetation fractions changed are adjusted. Cells
+*          are independent, so they are adjusted in parallel, each thread
+*          with its own workspace.
+******************************************/
+void
+lu_apply(void)
+{
+    extern domain_struct      local_domain;
+    extern lu_scratch_struct *lu_scratch;
 
-    free(snow_surf_capacity);
-    free(snow_pack_capacity);
-    free(orig_surf_tempEnergy);
-    free(orig_pack_tempEnergy);
-    free(new_surf_tempEnergy);
-    free(new_pack_tempEnergy);
-    for (iVeg = 0; iVeg < options.NVEGTYPES; iVeg++) {
-        free(node_capacity[iVeg]);
-        free(orig_TEnergy[iVeg]);
-        free(new_TEnergy[iVeg]);
+    size_t                    iCell;
+
+    // If running with OpenMP, run this for loop using multiple threads
+    #pragma omp parallel for default(shared) private(iCell)
+    for (iCell = 0; iCell < local_domain.ncells_active; iCell++) {
+        if (lu_cell_changed(iCell)) {
+            lu_apply_cell(iCell, &(lu_scratch[omp_get_thread_num()]));
+        }
     }
-    free(node_capacity);
-    free(orig_TEnergy);
-    free(new_TEnergy);
 }
@@ -28,18 +28,29 @@
 #define ROUTING_H
 
 #define MAX_UPSTREAM 8          /**< maximum number of upstream cells */
+#define ROUT_HALO_TAG 1         /**< MPI tag of routing halo messages */
+#define ROUT_DT_WINDOWS 2       /**< dt_buffer length in dt_discharge lengths */
 
 /******************************************************************************
  * @brief   Basin structure
  *****************************************************************************/
 typedef struct {
     int *basin_map;             /**< basin grid-map */
-    size_t *sorted_basins;      /**< sorted basin ids */
     size_t Nbasin;              /**< number of basins */
     size_t *Ncells;             /**< number of basin cells per basin */
     size_t **catchment;         /**< basin cell ids per basin */
 } basin_struct;
 
+/******************************************************************************
+ * @brief   Cell id index entry
+ * @details A cell id index is sorted on id, then on cell index (see
+ *          rout_id_index()).
+ *****************************************************************************/
+typedef struct {
+    int id;                     /**< cell id */
+    size_t cell;                /**< cell index */
+} rout_id_struct;
+
 /******************************************************************************
  * @brief   Routing Constants
  *****************************************************************************/
@@ -60,9 +71,21 @@ typedef struct {
     double stream;              /**< river (in-cell) stream moisture [m3 s-1] */
     double nonrenew_deficit;    /**< non-renewable storage deficit [mm] */
     double discharge;           /**< river (outflow) discharge [m3 s-1] */
-    double *dt_discharge;       /**< routing sub-step discharge [m3 s-1] */
+    double *dt_discharge;       /**< routing sub-step discharge [m3 s-1],
+                                     window of dt_buffer starting at dt_head */
+    double *dt_buffer;          /**< sub-step discharge storage */
+    size_t dt_head;             /**< start of dt_discharge in dt_buffer */
 } rout_var_struct;
 
+/******************************************************************************
+ * @brief   Routing scratch (per thread)
+ *****************************************************************************/
+typedef struct {
+    double *dt_runoff;          /**< sub-step runoff [m3 s-1] */
+    double *dt_inflow;          /**< sub-step inflow [m3 s-1] */
+    double *convoluted;         /**< convoluted sub-step discharge [m3 s-1] */
+} rout_scratch_struct;
+
 /******************************************************************************
  * @brief   Routing forcing
  *****************************************************************************/
@@ -70,13 +93,46 @@ typedef struct {
     double discharge;          /**< river (inflow) discharge [m3 s-1] */
 } rout_force_struct;
 
+/******************************************************************************
+ * @brief   Routing halo (random decomposition)
+ * @details Messages carry the first sub-step discharges of boundary cells to
+ *          the nodes that own their downstream cell. Messages are sorted by
+ *          stage (routing level) and node; a message of stage s is sent
+ *          after the cells of stage s are routed.
+ *****************************************************************************/
+typedef struct {
+    size_t nsend;               /**< number of send messages */
+    int *send_rank;             /**< destination node per message */
+    size_t *send_stage;         /**< routing stage per message */
+    size_t *send_start;         /**< send_cells offset per message */
+    size_t *send_cells;         /**< local cell ids to send */
+    double *send_buffer;        /**< packed send discharge */
+
+    size_t nrecv;               /**< number of receive messages */
+    int *recv_rank;             /**< source node per message */
+    size_t *recv_stage;         /**< routing stage per message */
+    size_t *recv_start;         /**< recv_buffer cell offset per message */
+    double *recv_buffer;        /**< received (halo) discharge */
+
+    size_t *upstream_start;     /**< upstream_discharge offset per cell */
+    double **upstream_discharge; /**< upstream discharge per cell */
+    size_t *upstream_local;     /**< local cell per upstream_discharge entry,
+                                     ncells_active for halo cells */
+
+    MPI_Request *requests;      /**< send followed by receive requests */
+} rout_halo_struct;
+
 /******************************************************************************
  * @brief   Public structures
  *****************************************************************************/
-size_t            *routing_order;
-rout_var_struct   *rout_var;
-rout_con_struct   *rout_con;
-rout_force_struct *rout_force;
+size_t              *routing_order;
+size_t              *routing_stage_start;
+size_t               routing_nstages;
+rout_var_struct     *rout_var;
+rout_con_struct     *rout_con;
+rout_force_struct   *rout_force;
+rout_halo_struct     rout_halo;
+rout_scratch_struct *rout_scratch;
 
 /******************************************************************************
  * @brief   Functions
@@ -90,6 +146,7 @@ void rout_start(void);
 void rout_alloc(void);
 void rout_initialize_local_structures(void);
 void rout_init(void);
+void rout_random_set_halo(void);
 
 void rout_set_nc_state_file_info(nc_file_struct *);
 void rout_add_state_dim(char *, nc_file_struct *);
@@ -99,6 +156,7 @@ void rout_set_nc_state_var_info(nc_file_struct *, size_t);
 void rout_set_output_met_data_info(void);
 void rout_set_state_meta_data_info(void);
 void rout_store(nc_file_struct *);
+void rout_checkpoint_cell(checkpoint_struct *, size_t);
 
 void rout_check_init_state_file(void);
 void rout_restore(void);
@@ -107,12 +165,23 @@ void rout_compute_derived_state_vars(void);
 void rout_history(int, unsigned int *);
 void rout_forcing(void);
 void rout_run(size_t);
+void rout_shift_discharge(rout_var_struct *);
+void rout_cell_run(size_t, double **);
 void rout_basin_run(size_t);
 void rout_random_run(void);
 void rout_put_data(size_t);
 void rout_finalize(void);
 void rout_add_types(void);
 
+int rout_id_compare(const void *, const void *);
+void rout_id_index(int *, size_t, rout_id_struct *);
+size_t rout_id_find(rout_id_struct *, size_t, int, size_t *);
+void rout_graph_set_downstream(int *, int *, size_t, size_t *);
+void rout_graph_set_upstream(size_t *, size_t, size_t *, size_t *);
+size_t rout_graph_set_levels(size_t *, size_t *, size_t, size_t *);
+size_t rout_graph_set_basins(size_t *, size_t, int *);
+void set_basins_catchment(basin_struct *, size_t);
+
 size_t get_downstream_global(size_t, int);
 size_t get_downstream_local(size_t, int, size_t);
 
@@ -33,7 +33,6 @@
 void
 rout_alloc(void)
 {
-    extern domain_struct              global_domain;
     extern domain_struct              local_domain;
     extern global_param_struct        global_param;
     extern plugin_global_param_struct plugin_global_param;
@@ -43,8 +42,10 @@ rout_alloc(void)
     extern rout_con_struct           *rout_con;
     extern rout_force_struct         *rout_force;
     extern size_t                    *routing_order;
+    extern rout_scratch_struct       *rout_scratch;
 
     size_t                            rout_steps_per_dt;
+    size_t                            nthreads;
     size_t                            i;
 
     rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
@@ -65,10 +66,34 @@ rout_alloc(void)
             malloc(plugin_options.UH_LENGTH * sizeof(*rout_con[i].runoff_uh));
         check_alloc_status(rout_con[i].runoff_uh, "Memory allocation error");
 
-        rout_var[i].dt_discharge =
+        rout_var[i].dt_buffer =
+            malloc(ROUT_DT_WINDOWS *
+                   (plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
+                   sizeof(*rout_var[i].dt_buffer));
+        check_alloc_status(rout_var[i].dt_buffer, "Memory allocation error");
+        rout_var[i].dt_head = 0;
+        rout_var[i].dt_discharge = rout_var[i].dt_buffer;
+    }
+
+    // Scratch per thread, so cells can be routed in parallel
+    nthreads = omp_get_max_threads();
+    rout_scratch = malloc(nthreads * sizeof(*rout_scratch));
+    check_alloc_status(rout_scratch, "Memory allocation error");
+
+    for (i = 0; i < nthreads; i++) {
+        rout_scratch[i].dt_runoff =
+            malloc(rout_steps_per_dt * sizeof(*rout_scratch[i].dt_runoff));
+        check_alloc_status(rout_scratch[i].dt_runoff,
+                           "Memory allocation error");
+        rout_scratch[i].dt_inflow =
+            malloc(rout_steps_per_dt * sizeof(*rout_scratch[i].dt_inflow));
+        check_alloc_status(rout_scratch[i].dt_inflow,
+                           "Memory allocation error");
+        rout_scratch[i].convoluted =
             malloc((plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
-                   sizeof(*rout_var[i].dt_discharge));
-        check_alloc_status(rout_var[i].dt_discharge, "Memory allocation error");
+                   sizeof(*rout_scratch[i].convoluted));
+        check_alloc_status(rout_scratch[i].convoluted,
+                           "Memory allocation error");
     }
 
     if (plugin_options.FORCE_ROUTING) {
@@ -76,17 +101,9 @@ rout_alloc(void)
         check_alloc_status(rout_force, "Memory allocation error");
     }
 
-    if (plugin_options.DECOMPOSITION == BASIN_DECOMPOSITION ||
-        plugin_options.DECOMPOSITION == FILE_DECOMPOSITION) {
-        routing_order =
-            malloc(local_domain.ncells_active * sizeof(*routing_order));
-        check_alloc_status(routing_order, "Memory allocation error");
-    }
-    else if (plugin_options.DECOMPOSITION == RANDOM_DECOMPOSITION) {
-        routing_order =
-            malloc(global_domain.ncells_active * sizeof(*routing_order));
-        check_alloc_status(routing_order, "Memory allocation error");
-    }
+    routing_order =
+        malloc(local_domain.ncells_active * sizeof(*routing_order));
+    check_alloc_status(routing_order, "Memory allocation error");
 
     rout_initialize_local_structures();
 }
@@ -101,23 +118,52 @@ rout_finalize(void)
     extern rout_var_struct     *rout_var;
     extern rout_con_struct     *rout_con;
     extern size_t              *routing_order;
+    extern size_t              *routing_stage_start;
+    extern rout_halo_struct     rout_halo;
     extern rout_force_struct   *rout_force;
     extern plugin_option_struct plugin_options;
+    extern rout_scratch_struct *rout_scratch;
 
+    size_t                      nthreads;
     size_t                      i;
 
     for (i = 0; i < local_domain.ncells_active; i++) {
         free(rout_con[i].inflow_uh);
         free(rout_con[i].runoff_uh);
         free(rout_con[i].upstream);
-        free(rout_var[i].dt_discharge);
+        free(rout_var[i].dt_buffer);
     }
     free(rout_var);
     free(rout_con);
 
+    nthreads = omp_get_max_threads();
+    for (i = 0; i < nthreads; i++) {
+        free(rout_scratch[i].dt_runoff);
+        free(rout_scratch[i].dt_inflow);
+        free(rout_scratch[i].convoluted);
+    }
+    free(rout_scratch);
+
     if (plugin_options.FORCE_ROUTING) {
         free(rout_force);
     }
 
     free(routing_order);
+    free(routing_stage_start);
+
+    if (plugin_options.DECOMPOSITION == RANDOM_DECOMPOSITION) {
+        free(rout_halo.send_rank);
+        free(rout_halo.send_stage);
+        free(rout_halo.send_start);
+        free(rout_halo.send_cells);
+        free(rout_halo.send_buffer);
+        free(rout_halo.recv_rank);
+        free(rout_halo.recv_stage);
+        free(rout_halo.recv_start);
+        free(rout_halo.recv_buffer);
+        free(rout_halo.upstream_start);
+        free(rout_halo.upstream_discharge);
+        free(rout_halo.upstream_local);
+        free(rout_halo.requests);
+    }
 }
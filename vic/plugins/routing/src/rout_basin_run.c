@@ -28,10 +28,54 @@
 #include <plugin.h>
 
 /******************************************
-* @brief   Run routing on local node (basin decomposition)
+* @brief   Advance the sub-step discharge by one time step
+* @details Drops the sub-steps of the previous time step and appends zeros.
+*          dt_discharge is a window in dt_buffer that moves forward by
+*          rout_steps_per_dt; the window is only moved back to the start of
+*          dt_buffer once it reaches the end, so advancing is O(1) amortized
+*          and dt_discharge stays contiguous.
 ******************************************/
 void
-rout_basin_run(size_t iCell)
+rout_shift_discharge(rout_var_struct *rout_var)
+{
+    extern global_param_struct        global_param;
+    extern plugin_global_param_struct plugin_global_param;
+    extern plugin_option_struct       plugin_options;
+
+    size_t                            rout_steps_per_dt;
+    size_t                            length;
+
+    size_t                            i;
+
+    rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
+                        global_param.model_steps_per_day;
+    length = plugin_options.UH_LENGTH + rout_steps_per_dt - 1;
+
+    if (rout_var->dt_head + rout_steps_per_dt + length >
+        ROUT_DT_WINDOWS * length) {
+        memmove(rout_var->dt_buffer,
+                rout_var->dt_discharge + rout_steps_per_dt,
+                (length - rout_steps_per_dt) * sizeof(*rout_var->dt_buffer));
+        rout_var->dt_head = 0;
+    }
+    else {
+        rout_var->dt_head += rout_steps_per_dt;
+    }
+    rout_var->dt_discharge = rout_var->dt_buffer + rout_var->dt_head;
+
+    for (i = length - rout_steps_per_dt; i < length; i++) {
+        rout_var->dt_discharge[i] = 0.0;
+    }
+}
+
+/******************************************
+* @brief   Run routing for a single cell
+* @details upstream_discharge holds the sub-step discharge of each of the
+*          Nupstream upstream cells, in rout_con[iCell].upstream order.
+******************************************/
+void
+rout_cell_run(size_t   iCell,
+              double **upstream_discharge)
 {
     extern global_param_struct        global_param;
     extern plugin_global_param_struct plugin_global_param;
@@ -39,11 +83,14 @@ rout_basin_run(size_t iCell)
     extern rout_var_struct           *rout_var;
     extern rout_con_struct           *rout_con;
     extern rout_force_struct         *rout_force;
+    extern rout_scratch_struct       *rout_scratch;
 
     double                            inflow;
     double                           *dt_inflow;
     double                           *dt_runoff;
+    double                           *dt_discharge;
     size_t                            rout_steps_per_dt;
+    size_t                            length;
     double                            prev_stream;
     double                           *convoluted;
 
@@ -52,23 +99,15 @@ rout_basin_run(size_t iCell)
 
     rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
                         global_param.model_steps_per_day;
+    length = plugin_options.UH_LENGTH + rout_steps_per_dt - 1;
 
-    /* Allocate data */
-    dt_inflow = malloc(rout_steps_per_dt * sizeof(*dt_inflow));
-    check_alloc_status(dt_inflow, "Memory allocation error");
-    dt_runoff = malloc(rout_steps_per_dt * sizeof(*dt_runoff));
-    check_alloc_status(dt_runoff, "Memory allocation error");
-    convoluted = malloc(
-        (plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
-        sizeof(*convoluted));
-    check_alloc_status(convoluted, "Memory allocation error");
+    dt_runoff = rout_scratch[omp_get_thread_num()].dt_runoff;
+    dt_inflow = rout_scratch[omp_get_thread_num()].dt_inflow;
+    convoluted = rout_scratch[omp_get_thread_num()].convoluted;
 
     /* Shift and clear previous discharge data */
-    for (i = 0; i < rout_steps_per_dt; i++) {
-        rout_var[iCell].dt_discharge[0] = 0.0;
-        cshift(rout_var[iCell].dt_discharge,
-               plugin_options.UH_LENGTH + rout_steps_per_dt - 1, 1, 0, 1);
-    }
+    rout_shift_discharge(&(rout_var[iCell]));
+    dt_discharge = rout_var[iCell].dt_discharge;
 
     // Calculate delta-time runoff (equal contribution)
     for (i = 0; i < rout_steps_per_dt; i++) {
@@ -79,8 +118,8 @@ rout_basin_run(size_t iCell)
     convolve(dt_runoff, rout_steps_per_dt,
              rout_con[iCell].runoff_uh, plugin_options.UH_LENGTH,
              convoluted);
-    for (i = 0; i < rout_steps_per_dt + plugin_options.UH_LENGTH - 1; i++) {
-        rout_var[iCell].dt_discharge[i] += convoluted[i];
+    for (i = 0; i < length; i++) {
+        dt_discharge[i] += convoluted[i];
     }
 
     /* INFLOW*/
@@ -95,8 +134,7 @@ rout_basin_run(size_t iCell)
     for (i = 0; i < rout_steps_per_dt; i++) {
         dt_inflow[i] = inflow / rout_steps_per_dt;
         for (j = 0; j < rout_con[iCell].Nupstream; j++) {
-            dt_inflow[i] +=
-                rout_var[rout_con[iCell].upstream[j]].dt_discharge[i];
+            dt_inflow[i] += upstream_discharge[j][i];
         }
         rout_var[iCell].inflow += dt_inflow[i];
     }
@@ -105,21 +143,19 @@ rout_basin_run(size_t iCell)
     convolve(dt_inflow, rout_steps_per_dt,
              rout_con[iCell].inflow_uh, plugin_options.UH_LENGTH,
              convoluted);
-    for (i = 0; i < rout_steps_per_dt + plugin_options.UH_LENGTH - 1; i++) {
-        rout_var[iCell].dt_discharge[i] += convoluted[i];
+    for (i = 0; i < length; i++) {
+        dt_discharge[i] += convoluted[i];
     }
 
     // Aggregate current timestep discharge & stream moisture
     prev_stream = rout_var[iCell].stream;
     rout_var[iCell].discharge = 0.0;
     rout_var[iCell].stream = 0.0;
-    for (i = 0; i < plugin_options.UH_LENGTH + rout_steps_per_dt - 1; i++) {
-        if (i < rout_steps_per_dt) {
-            rout_var[iCell].discharge += rout_var[iCell].dt_discharge[i];
-        }
-        else {
-            rout_var[iCell].stream += rout_var[iCell].dt_discharge[i];
-        }
+    for (i = 0; i < rout_steps_per_dt; i++) {
+        rout_var[iCell].discharge += dt_discharge[i];
+    }
+    for (i = rout_steps_per_dt; i < length; i++) {
+        rout_var[iCell].stream += dt_discharge[i];
     }
 
     // Check water balance
@@ -135,9 +171,25 @@ rout_basin_run(size_t iCell)
                 prev_stream,
                 rout_var[iCell].stream);
     }
+}
+
+/******************************************
+* @brief   Run routing on local node (basin decomposition)
+******************************************/
+void
+rout_basin_run(size_t iCell)
+{
+    extern rout_var_struct *rout_var;
+    extern rout_con_struct *rout_con;
+
+    double                 *upstream_discharge[MAX_UPSTREAM];
+
+    size_t                  j;
+
+    for (j = 0; j < rout_con[iCell].Nupstream; j++) {
+        upstream_discharge[j] =
+            rout_var[rout_con[iCell].upstream[j]].dt_discharge;
+    }
 
-    /* Free */
-    free(dt_inflow);
-    free(dt_runoff);
-    free(convoluted);
+    rout_cell_run(iCell, upstream_discharge);
 }
@@ -38,12 +38,6 @@ set_basins_downstream(size_t *downstream_basin)
 
     int                           *id;
     int                           *downstream;
-    size_t                         error_count;
-
-    bool                           found;
-
-    size_t                         i;
-    size_t                         j;
 
     size_t                         d2count[2];
     size_t                         d2start[2];
@@ -64,37 +58,66 @@ set_basins_downstream(size_t *downstream_basin)
     get_active_nc_field_int(&(plugin_filenames.routing), "downstream",
                             d2start, d2count, downstream);
 
-    error_count = 0;
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        found = false;
+    rout_graph_set_downstream(id, downstream, global_domain.ncells_active,
+                              downstream_basin);
 
-        for (j = 0; j < global_domain.ncells_active; j++) {
-            if (downstream[i] == id[j]) {
-                downstream_basin[i] = j;
-                found = true;
-            }
-        }
+    free(downstream);
+    free(id);
+}
 
-        if (!found) {
-            error_count++;
-            downstream_basin[i] = i;
+/******************************************
+* @brief   Set basin cells
+* @details Requires basin_map (basin per cell, from 0 to Nbasin - 1) and
+*          Nbasin. The cells of all basins are stored in one block that
+*          starts at catchment[0].
+******************************************/
+void
+set_basins_catchment(basin_struct *basins,
+                     size_t        ncells)
+{
+    size_t *block;
+    size_t  offset;
+    size_t  iBasin;
+
+    size_t  i;
+
+    basins->Ncells = malloc((basins->Nbasin + 1) * sizeof(*basins->Ncells));
+    check_alloc_status(basins->Ncells, "Memory allocation error.");
+    basins->catchment =
+        malloc((basins->Nbasin + 1) * sizeof(*basins->catchment));
+    check_alloc_status(basins->catchment, "Memory allocation error.");
+    block = malloc((ncells + 1) * sizeof(*block));
+    check_alloc_status(block, "Memory allocation error.");
+
+    for (i = 0; i < basins->Nbasin; i++) {
+        basins->Ncells[i] = 0;
+    }
+
+    for (i = 0; i < ncells; i++) {
+        if (basins->basin_map[i] < 0 ||
+            (size_t) basins->basin_map[i] >= basins->Nbasin) {
+            log_err("Found active cell not in basin");
         }
+        basins->Ncells[basins->basin_map[i]]++;
     }
 
-    if (error_count > 0) {
-        log_warn("No downstream cell was found for %zu cells; "
-                 "Probably the ID was outside of the mask or "
-                 "the ID was not set; "
-                 "Setting cell as outflow point",
-                 error_count);
+    offset = 0;
+    for (i = 0; i < basins->Nbasin; i++) {
+        basins->catchment[i] = block + offset;
+        offset += basins->Ncells[i];
+        basins->Ncells[i] = 0;
     }
+    basins->catchment[basins->Nbasin] = block + offset;
 
-    free(downstream);
-    free(id);
+    for (i = 0; i < ncells; i++) {
+        iBasin = basins->basin_map[i];
+        basins->catchment[iBasin][basins->Ncells[iBasin]] = i;
+        basins->Ncells[iBasin]++;
+    }
 }
 
 /******************************************
-* @brief   Get and sort basins based on routing input
+* @brief   Get basins based on routing input
 ******************************************/
 void
 get_basins_routing(basin_struct *basins)
@@ -102,109 +125,28 @@ get_basins_routing(basin_struct *basins)
     extern domain_struct global_domain;
 
     size_t              *downstream;
-    size_t              *river;
-    size_t               Nriver;
-
-    size_t               iCell;
-    size_t               next_cell;
-
-    size_t               i;
-    size_t               j;
 
     downstream = malloc(global_domain.ncells_active * sizeof(*downstream));
     check_alloc_status(downstream, "Memory allocation error.");
-    river = malloc(global_domain.ncells_active * sizeof(*river));
-    check_alloc_status(river, "Memory allocation error.");
 
     basins->basin_map =
         malloc(global_domain.ncells_active * sizeof(*basins->basin_map));
     check_alloc_status(basins->basin_map, "Memory allocation error.");
 
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        basins->basin_map[i] = MISSING_USI;
-    }
-
     set_basins_downstream(downstream);
 
-    basins->Nbasin = 0;
-    Nriver = 0;
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        Nriver = 0;
-        iCell = next_cell = i;
-
-        while (true) {
-            river[Nriver] = iCell;
-            Nriver++;
-
-            if (basins->basin_map[iCell] != MISSING_USI) {
-                for (j = 0; j < Nriver; j++) {
-                    basins->basin_map[river[j]] = basins->basin_map[iCell];
-                }
-                break;
-            }
-
-            next_cell = downstream[iCell];
-
-            if (next_cell == iCell) {
-                for (j = 0; j < Nriver; j++) {
-                    basins->basin_map[river[j]] = basins->Nbasin;
-                }
-                basins->Nbasin++;
-                break;
-            }
-
-            iCell = next_cell;
-        }
-    }
-
-    basins->Ncells = malloc(basins->Nbasin * sizeof(*basins->Ncells));
-    check_alloc_status(basins->Ncells, "Memory allocation error.");
-    basins->sorted_basins =
-        malloc(basins->Nbasin * sizeof(*basins->sorted_basins));
-    check_alloc_status(basins->sorted_basins, "Memory allocation error.");
-    for (i = 0; i < basins->Nbasin; i++) {
-        basins->sorted_basins[i] = i;
-        basins->Ncells[i] = 0;
-    }
-
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        if (basins->basin_map[i] == MISSING_USI) {
-            log_err("Found active cell not in basin");
-        }
-        basins->Ncells[basins->basin_map[i]]++;
-    }
+    basins->Nbasin = rout_graph_set_basins(downstream,
+                                           global_domain.ncells_active,
+                                           basins->basin_map);
 
-    // Sort basins by size
-    size_t_sort(basins->sorted_basins, basins->Ncells, basins->Nbasin, false);
-
-    basins->catchment = malloc(basins->Nbasin * sizeof(*basins->catchment));
-    check_alloc_status(basins->catchment, "Memory allocation error.");
-    for (i = 0; i < basins->Nbasin; i++) {
-        basins->catchment[i] =
-            malloc(basins->Ncells[i] * sizeof(basins->catchment[i]));
-        check_alloc_status(basins->catchment[i], "Memory allocation error.");
-    }
-
-    for (i = 0; i < basins->Nbasin; i++) {
-        for (j = 0; j < basins->Ncells[i]; j++) {
-            basins->catchment[i][j] = MISSING_USI;
-        }
-        basins->Ncells[i] = 0;
-    }
-
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        basins->catchment[basins->basin_map[i]][basins->Ncells[basins->
-                                                               basin_map[i]]] =
-            i;
-        basins->Ncells[basins->basin_map[i]]++;
-    }
+    set_basins_catchment(basins, global_domain.ncells_active);
 
     free(downstream);
-    free(river);
 }
 
 /******************************************
-* @brief   Get and sort basins based on decomposition input
+* @brief   Get basins based on decomposition input
+* @details Basin ids are renumbered from 0 in the order of their first cell.
 ******************************************/
 void
 get_basins_decomposition(basin_struct *basins)
@@ -212,14 +154,14 @@ get_basins_decomposition(basin_struct *basins)
     extern domain_struct           global_domain;
     extern plugin_filenames_struct plugin_filenames;
 
-    int                           *basin_list;
-    bool                           duplicate;
+    rout_id_struct                *index;
+    size_t                        *label;
+    size_t                         first;
 
     size_t                         d2count[2];
     size_t                         d2start[2];
 
     size_t                         i;
-    size_t                         j;
 
     d2start[0] = 0;
     d2start[1] = 0;
@@ -229,80 +171,43 @@ get_basins_decomposition(basin_struct *basins)
     basins->basin_map =
         malloc(global_domain.ncells_active * sizeof(*basins->basin_map));
     check_alloc_status(basins->basin_map, "Memory allocation error.");
-    basin_list = malloc(global_domain.ncells_active * sizeof(*basin_list));
-    check_alloc_status(basin_list, "Memory allocation error.");
+    index = malloc((global_domain.ncells_active + 1) * sizeof(*index));
+    check_alloc_status(index, "Memory allocation error.");
+    label = malloc((global_domain.ncells_active + 1) * sizeof(*label));
+    check_alloc_status(label, "Memory allocation error.");
 
     get_active_nc_field_int(&plugin_filenames.decomposition, "basin", d2start,
                             d2count,
                             basins->basin_map);
 
-    basins->Nbasin = 0;
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        duplicate = false;
-
-        for (j = 0; j < basins->Nbasin; j++) {
-            if (basin_list[j] == basins->basin_map[i]) {
-                duplicate = true;
-                break;
-            }
-        }
-
-        if (duplicate) {
-            continue;
-        }
-
-        basin_list[basins->Nbasin] = basins->basin_map[i];
-        basins->Nbasin++;
-    }
-
-    basins->Ncells = malloc(basins->Nbasin * sizeof(*basins->Ncells));
-    check_alloc_status(basins->Ncells, "Memory allocation error.");
-    basins->sorted_basins =
-        malloc(basins->Nbasin * sizeof(*basins->sorted_basins));
-    check_alloc_status(basins->sorted_basins, "Memory allocation error.");
-
-    for (i = 0; i < basins->Nbasin; i++) {
-        basins->sorted_basins[i] = i;
-        basins->Ncells[i] = 0;
-    }
+    rout_id_index(basins->basin_map, global_domain.ncells_active, index);
 
     for (i = 0; i < global_domain.ncells_active; i++) {
-        for (j = 0; j < basins->Nbasin; j++) {
-            if (basin_list[j] == basins->basin_map[i]) {
-                basins->Ncells[j]++;
-            }
-        }
-    }
-
-    // Sort basins by size
-    size_t_sort(basins->sorted_basins, basins->Ncells, basins->Nbasin, false);
-
-    basins->catchment = malloc(basins->Nbasin * sizeof(*basins->catchment));
-    check_alloc_status(basins->catchment, "Memory allocation error.");
-    for (i = 0; i < basins->Nbasin; i++) {
-        basins->catchment[i] =
-            malloc(basins->Ncells[i] * sizeof(basins->catchment[i]));
-        check_alloc_status(basins->catchment[i], "Memory allocation error.");
-    }
-
-    for (i = 0; i < basins->Nbasin; i++) {
-        basins->Ncells[i] = 0;
+        label[i] = global_domain.ncells_active;
     }
 
+    basins->Nbasin = 0;
     for (i = 0; i < global_domain.ncells_active; i++) {
-        for (j = 0; j < basins->Nbasin; j++) {
-            if (basin_list[j] == basins->basin_map[i]) {
-                basins->catchment[j][basins->Ncells[j]] = i;
-                basins->Ncells[j]++;
-            }
+        rout_id_find(index, global_domain.ncells_active,
+                     basins->basin_map[i], &first);
+
+        if (label[first] == global_domain.ncells_active) {
+            label[first] = basins->Nbasin;
+            basins->Nbasin++;
         }
+        basins->basin_map[i] = (int) label[first];
     }
 
-    free(basin_list);
+    set_basins_catchment(basins, global_domain.ncells_active);
+
+    free(index);
+    free(label);
 }
 
 /******************************************
 * @brief   Decompose domains from basins
+* @details Basins are kept intact and balanced on their measured cost if
+*          available, otherwise on their number of cells.
 ******************************************/
 void
 rout_decomp_domain_from_basins(size_t        ncells,
@@ -312,70 +217,47 @@ rout_decomp_domain_from_basins(size_t        ncells,
                                size_t      **mpi_map_mapping_array,
                                basin_struct *basins)
 {
-    size_t  i;
-    size_t  j;
-    size_t  k;
-    size_t  l;
+    extern double *decomp_cost;
 
-    size_t *node_ids;
-    size_t *basin_to_node;
+    size_t        *basin_start;
+    double        *basin_cost;
 
-    node_ids = malloc(mpi_size * sizeof(*node_ids));
-    check_alloc_status(node_ids, "Memory allocation error.");
-    basin_to_node = malloc(basins->Nbasin * sizeof(*basin_to_node));
-    check_alloc_status(basin_to_node, "Memory allocation error.");
+    size_t         i;
+    size_t         j;
 
-    for (i = 0; i < mpi_size; i++) {
-        (*mpi_map_local_array_sizes)[i] = 0;
-        (*mpi_map_global_array_offsets)[i] = 0;
-    }
-    for (i = 0; i < ncells; i++) {
-        (*mpi_map_mapping_array)[i] = 0;
+    basin_start = malloc((basins->Nbasin + 1) * sizeof(*basin_start));
+    check_alloc_status(basin_start, "Memory allocation error.");
+    basin_cost = malloc((basins->Nbasin + 1) * sizeof(*basin_cost));
+    check_alloc_status(basin_cost, "Memory allocation error.");
+
+    for (i = 0; i <= basins->Nbasin; i++) {
+        basin_start[i] = basins->catchment[i] - basins->catchment[0];
     }
 
-    // determine number of cells per node
     for (i = 0; i < basins->Nbasin; i++) {
-        // sort nodes by size
-        for (j = 0; j < mpi_size; j++) {
-            node_ids[j] = j;
+        if (decomp_cost != NULL) {
+            basin_cost[i] = 0.;
+            for (j = 0; j < basins->Ncells[i]; j++) {
+                basin_cost[i] += decomp_cost[basins->catchment[i][j]];
+            }
         }
-        size_t_sort2(node_ids, (*mpi_map_local_array_sizes), mpi_size, true);
-
-        // find node with lowest amount of cells and add the biggest basin
-        (*mpi_map_local_array_sizes)[node_ids[0]] +=
-            basins->Ncells[basins->sorted_basins[i]];
-        basin_to_node[basins->sorted_basins[i]] = node_ids[0];
-    }
-
-    // determine offsets to use for MPI_Scatterv and MPI_Gatherv
-    for (i = 1; i < mpi_size; i++) {
-        for (j = 0; j < i; j++) {
-            (*mpi_map_global_array_offsets)[i] +=
-                (*mpi_map_local_array_sizes)[j];
+        else {
+            basin_cost[i] = (double) basins->Ncells[i];
         }
     }
 
-    // set mapping array
-    for (i = 0, l = 0; i < (size_t) mpi_size; i++) {
-        for (j = 0; j < basins->Nbasin; j++) {
-            if (basin_to_node[j] == i) {
-                for (k = 0; k < basins->Ncells[j]; k++) {
-                    (*mpi_map_mapping_array)[l++] = basins->catchment[j][k];
-                }
-            }
-        }
-    }
+    mpi_map_decomp_domain_cost(ncells, mpi_size, *mpi_map_local_array_sizes,
+                               *mpi_map_global_array_offsets,
+                               *mpi_map_mapping_array, basins->Nbasin,
+                               basin_start, basins->catchment[0], basin_cost);
 
-    free(node_ids);
-    free(basin_to_node);
+    free(basin_start);
+    free(basin_cost);
 
-    for (i = 0; i < basins->Nbasin; i++) {
-        free(basins->catchment[i]);
-    }
+    free(basins->catchment[0]);
     free(basins->Ncells);
     free(basins->basin_map);
     free(basins->catchment);
-    free(basins->sorted_basins);
 }
 
 /******************************************
@@ -0,0 +1,355 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Routing graph functions: cell id lookup, downstream and upstream links,
+ * routing stages and basins. All functions run in (near) linear time in the
+ * number of cells.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_image.h>
+#include <plugin.h>
+
+/******************************************
+* @brief   Compare two cell id index entries (on id, then on cell)
+******************************************/
+int
+rout_id_compare(const void *a,
+                const void *b)
+{
+    const rout_id_struct *entry_a = a;
+    const rout_id_struct *entry_b = b;
+
+    if (entry_a->id != entry_b->id) {
+        return (entry_a->id < entry_b->id) ? -1 : 1;
+    }
+    if (entry_a->cell != entry_b->cell) {
+        return (entry_a->cell < entry_b->cell) ? -1 : 1;
+    }
+    return 0;
+}
+
+/******************************************
+* @brief   Build a sorted cell id index
+* @details Cells with the same id are sorted on cell index, so the first
+*          and last entry of an id are its first and last cell.
+******************************************/
+void
+rout_id_index(int            *id,
+              size_t          ncells,
+              rout_id_struct *index)
+{
+    size_t i;
+
+    for (i = 0; i < ncells; i++) {
+        index[i].id = id[i];
+        index[i].cell = i;
+    }
+
+    qsort(index, ncells, sizeof(*index), rout_id_compare);
+}
+
+/******************************************
+* @brief   Find the cells with an id in a sorted cell id index
+* @details Returns the number of cells with the id; their index entries
+*          start at position first.
+******************************************/
+size_t
+rout_id_find(rout_id_struct *index,
+             size_t          ncells,
+             int             id,
+             size_t         *first)
+{
+    size_t lower;
+    size_t upper;
+    size_t middle;
+    size_t n;
+
+    // binary search for the first entry not smaller than id
+    lower = 0;
+    upper = ncells;
+    while (lower < upper) {
+        middle = lower + (upper - lower) / 2;
+        if (index[middle].id < id) {
+            lower = middle + 1;
+        }
+        else {
+            upper = middle;
+        }
+    }
+
+    (*first) = lower;
+    n = 0;
+    while (lower + n < ncells && index[lower + n].id == id) {
+        n++;
+    }
+
+    return n;
+}
+
+/******************************************
+* @brief   Set downstream cells from cell ids
+* @details Cells whose downstream id is not found are set as outflow point.
+*          If several cells share the downstream id, the last one is used.
+******************************************/
+void
+rout_graph_set_downstream(int    *id,
+                          int    *downstream,
+                          size_t  ncells,
+                          size_t *down)
+{
+    rout_id_struct *index;
+    size_t          error_count;
+    size_t          first;
+    size_t          n;
+
+    size_t          i;
+
+    index = malloc((ncells + 1) * sizeof(*index));
+    check_alloc_status(index, "Memory allocation error.");
+
+    rout_id_index(id, ncells, index);
+
+    error_count = 0;
+    for (i = 0; i < ncells; i++) {
+        n = rout_id_find(index, ncells, downstream[i], &first);
+
+        if (n > 0) {
+            down[i] = index[first + n - 1].cell;
+        }
+        else {
+            error_count++;
+            down[i] = i;
+        }
+    }
+
+    if (error_count > 0) {
+        log_warn("No downstream cell was found for %zu cells; "
+                 "Probably the ID was outside of the mask or "
+                 "the ID was not set; "
+                 "Setting cell as outflow point",
+                 error_count);
+    }
+
+    free(index);
+}
+
+/******************************************
+* @brief   Set upstream cells from downstream cells
+* @details The upstream cells of cell i are
+*          upstream[upstream_start[i]] ... upstream[upstream_start[i + 1] - 1]
+*          in ascending order. upstream_start has ncells + 1 elements and
+*          upstream ncells elements.
+******************************************/
+void
+rout_graph_set_upstream(size_t *down,
+                        size_t  ncells,
+                        size_t *upstream_start,
+                        size_t *upstream)
+{
+    size_t i;
+
+    for (i = 0; i <= ncells; i++) {
+        upstream_start[i] = 0;
+    }
+    for (i = 0; i < ncells; i++) {
+        if (down[i] != i) {
+            upstream_start[down[i] + 1]++;
+        }
+    }
+    for (i = 0; i < ncells; i++) {
+        upstream_start[i + 1] += upstream_start[i];
+    }
+
+    // fill, using upstream_start as insert position and shifting it back
+    for (i = 0; i < ncells; i++) {
+        if (down[i] != i) {
+            upstream[upstream_start[down[i]]++] = i;
+        }
+    }
+    for (i = ncells; i > 0; i--) {
+        upstream_start[i] = upstream_start[i - 1];
+    }
+    upstream_start[0] = 0;
+}
+
+/******************************************
+* @brief   Set routing stages (levels)
+* @details Cell i depends on cells dep[dep_start[i]] ...
+*          dep[dep_start[i + 1] - 1]. Cells without dependencies are in
+*          stage 0, other cells in the stage after their latest dependency.
+*          Returns the number of stages.
+******************************************/
+size_t
+rout_graph_set_levels(size_t *dep_start,
+                      size_t *dep,
+                      size_t  ncells,
+                      size_t *level)
+{
+    size_t *npending;
+    size_t *rev_start;
+    size_t *rev;
+    size_t *queue;
+    size_t  head;
+    size_t  tail;
+    size_t  nlevels;
+    size_t  iCell;
+    size_t  iDep;
+
+    size_t  i;
+    size_t  j;
+
+    npending = malloc((ncells + 1) * sizeof(*npending));
+    check_alloc_status(npending, "Memory allocation error.");
+    rev_start = malloc((ncells + 1) * sizeof(*rev_start));
+    check_alloc_status(rev_start, "Memory allocation error.");
+    rev = malloc((dep_start[ncells] + 1) * sizeof(*rev));
+    check_alloc_status(rev, "Memory allocation error.");
+    queue = malloc((ncells + 1) * sizeof(*queue));
+    check_alloc_status(queue, "Memory allocation error.");
+
+    // Reverse the dependencies
+    for (i = 0; i <= ncells; i++) {
+        rev_start[i] = 0;
+    }
+    for (i = 0; i < ncells; i++) {
+        for (j = dep_start[i]; j < dep_start[i + 1]; j++) {
+            rev_start[dep[j] + 1]++;
+        }
+    }
+    for (i = 0; i < ncells; i++) {
+        rev_start[i + 1] += rev_start[i];
+    }
+    for (i = 0; i < ncells; i++) {
+        npending[i] = rev_start[i];
+    }
+    for (i = 0; i < ncells; i++) {
+        for (j = dep_start[i]; j < dep_start[i + 1]; j++) {
+            rev[npending[dep[j]]++] = i;
+        }
+    }
+
+    // Process cells once all their dependencies are processed
+    head = 0;
+    tail = 0;
+    for (i = 0; i < ncells; i++) {
+        level[i] = 0;
+        npending[i] = dep_start[i + 1] - dep_start[i];
+        if (npending[i] == 0) {
+            queue[tail++] = i;
+        }
+    }
+    nlevels = 0;
+    while (head < tail) {
+        iCell = queue[head++];
+        nlevels = max(nlevels, level[iCell] + 1);
+
+        for (j = rev_start[iCell]; j < rev_start[iCell + 1]; j++) {
+            iDep = rev[j];
+            level[iDep] = max(level[iDep], level[iCell] + 1);
+            npending[iDep]--;
+            if (npending[iDep] == 0) {
+                queue[tail++] = iDep;
+            }
+        }
+    }
+
+    if (tail != ncells) {
+        log_err("Error in ordering and ranking cells; "
+                "%zu cells are part of a cycle in the routing network",
+                ncells - tail);
+    }
+
+    free(npending);
+    free(rev_start);
+    free(rev);
+    free(queue);
+
+    return nlevels;
+}
+
+/******************************************
+* @brief   Set basins from downstream cells
+* @details Every cell gets the basin of its outflow point. Basins are
+*          numbered in the order of their first cell. Returns the number
+*          of basins.
+******************************************/
+size_t
+rout_graph_set_basins(size_t *down,
+                      size_t  ncells,
+                      int    *basin)
+{
+    size_t *river;
+    size_t  Nriver;
+    size_t  Nbasin;
+    size_t  iCell;
+    int     label;
+
+    size_t  i;
+    size_t  j;
+
+    river = malloc((ncells + 1) * sizeof(*river));
+    check_alloc_status(river, "Memory allocation error.");
+
+    // -1: no basin yet, -2: on the river currently followed
+    for (i = 0; i < ncells; i++) {
+        basin[i] = -1;
+    }
+
+    Nbasin = 0;
+    for (i = 0; i < ncells; i++) {
+        Nriver = 0;
+        iCell = i;
+
+        // follow the river until a cell with a basin or the outflow point
+        while (true) {
+            if (basin[iCell] >= 0) {
+                label = basin[iCell];
+                break;
+            }
+            if (basin[iCell] == -2) {
+                log_err("Cell %zu is part of a cycle in the routing network",
+                        iCell);
+            }
+
+            basin[iCell] = -2;
+            river[Nriver] = iCell;
+            Nriver++;
+
+            if (down[iCell] == iCell) {
+                label = (int) Nbasin;
+                Nbasin++;
+                break;
+            }
+
+            iCell = down[iCell];
+        }
+
+        for (j = 0; j < Nriver; j++) {
+            basin[river[j]] = label;
+        }
+    }
+
+    free(river);
+
+    return Nbasin;
+}
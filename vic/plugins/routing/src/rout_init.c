@@ -125,16 +125,15 @@ rout_basin_set_downstream(void)
 
     int                           *id;
     int                           *downstream;
-    size_t                         error_count;
-
-    bool                           found;
+    size_t                        *down_local;
 
     size_t                         i;
-    size_t                         j;
 
     size_t                         d2count[2];
     size_t                         d2start[2];
 
+    down_local = malloc(local_domain.ncells_active * sizeof(*down_local));
+    check_alloc_status(down_local, "Memory allocation error.");
     downstream = malloc(local_domain.ncells_active * sizeof(*downstream));
     check_alloc_status(downstream, "Memory allocation error.");
     id = malloc(local_domain.ncells_active * sizeof(*id));
@@ -151,31 +150,14 @@ rout_basin_set_downstream(void)
     get_scatter_nc_field_int(&(plugin_filenames.routing), "downstream",
                              d2start, d2count, downstream);
 
-    error_count = 0;
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        found = false;
+    rout_graph_set_downstream(id, downstream, local_domain.ncells_active,
+                              down_local);
 
-        for (j = 0; j < local_domain.ncells_active; j++) {
-            if (downstream[i] == id[j]) {
-                rout_con[i].downstream = j;
-                found = true;
-            }
-        }
-
-        if (!found) {
-            error_count++;
-            rout_con[i].downstream = i;
-        }
-    }
-
-    if (error_count > 0) {
-        log_warn("No downstream cell was found for %zu cells; "
-                 "Probably the ID was outside of the mask or "
-                 "the ID was not set; "
-                 "Setting cell as outflow point",
-                 error_count);
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        rout_con[i].downstream = down_local[i];
     }
 
+    free(down_local);
     free(downstream);
     free(id);
 }
@@ -194,14 +176,10 @@ rout_random_set_downstream(void)
 
     int                           *id;
     int                           *downstream;
-    int                           *down_global;
-    int                           *down_local;
-    size_t                         error_count;
-
-    bool                           found;
+    size_t                        *down_global;
+    size_t                        *down_local;
 
     size_t                         i;
-    size_t                         j;
 
     size_t                         d2count[2];
     size_t                         d2start[2];
@@ -230,33 +208,11 @@ rout_random_set_downstream(void)
         get_active_nc_field_int(&(plugin_filenames.routing), "downstream",
                                 d2start, d2count, downstream);
 
-        error_count = 0;
-        for (i = 0; i < global_domain.ncells_active; i++) {
-            found = false;
-
-            for (j = 0; j < global_domain.ncells_active; j++) {
-                if (downstream[i] == id[j]) {
-                    down_global[i] = j;
-                    found = true;
-                }
-            }
-
-            if (!found) {
-                error_count++;
-                down_global[i] = i;
-            }
-        }
-
-        if (error_count > 0) {
-            log_warn("No downstream cell was found for %zu cells; "
-                     "Probably the ID was outside of the mask or "
-                     "the ID was not set; "
-                     "Setting cell as outflow point",
-                     error_count);
-        }
+        rout_graph_set_downstream(id, downstream, global_domain.ncells_active,
+                                  down_global);
     }
 
-    scatter_int(down_global, down_local);
+    scatter_size_t(down_global, down_local);
 
     for (i = 0; i < local_domain.ncells_active; i++) {
         rout_con[i].downstream = down_local[i];
@@ -277,25 +233,37 @@ rout_basin_set_upstream(void)
     extern domain_struct    local_domain;
     extern rout_con_struct *rout_con;
 
-    size_t                  upstream[MAX_UPSTREAM];
+    size_t                 *down_local;
+    size_t                 *upstream_start;
+    size_t                 *upstream;
 
     size_t                  i;
     size_t                  j;
 
+    down_local = malloc((local_domain.ncells_active + 1) *
+                        sizeof(*down_local));
+    check_alloc_status(down_local, "Memory allocation error.");
+    upstream_start = malloc((local_domain.ncells_active + 1) *
+                            sizeof(*upstream_start));
+    check_alloc_status(upstream_start, "Memory allocation error.");
+    upstream = malloc((local_domain.ncells_active + 1) * sizeof(*upstream));
+    check_alloc_status(upstream, "Memory allocation error.");
+
     for (i = 0; i < local_domain.ncells_active; i++) {
-        for (j = 0; j < local_domain.ncells_active; j++) {
-            if (rout_con[j].downstream == i && i != j) {
-                upstream[rout_con[i].Nupstream] = j;
-                rout_con[i].Nupstream++;
-
-                if (rout_con[i].Nupstream > MAX_UPSTREAM) {
-                    log_err(
-                        "Number of upstream cells [%zu] is bigger "
-                        "than the maximum number of upstream cells possible [%d]",
-                        rout_con[i].Nupstream,
-                        MAX_UPSTREAM);
-                }
-            }
+        down_local[i] = rout_con[i].downstream;
+    }
+
+    rout_graph_set_upstream(down_local, local_domain.ncells_active,
+                            upstream_start, upstream);
+
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        rout_con[i].Nupstream = upstream_start[i + 1] - upstream_start[i];
+
+        if (rout_con[i].Nupstream > MAX_UPSTREAM) {
+            log_err("Number of upstream cells [%zu] is bigger "
+                    "than the maximum number of upstream cells possible [%d]",
+                    rout_con[i].Nupstream,
+                    MAX_UPSTREAM);
         }
 
         rout_con[i].upstream =
@@ -303,9 +271,13 @@ rout_basin_set_upstream(void)
         check_alloc_status(rout_con[i].upstream, "Memory allocation error.");
 
         for (j = 0; j < rout_con[i].Nupstream; j++) {
-            rout_con[i].upstream[j] = upstream[j];
+            rout_con[i].upstream[j] = upstream[upstream_start[i] + j];
         }
     }
+
+    free(down_local);
+    free(upstream_start);
+    free(upstream);
 }
 
 /******************************************
@@ -328,10 +300,17 @@ rout_random_set_upstream(void)
     size_t                **up_local;
     size_t                 *nup_global;
     size_t                 *nup_local;
+    size_t                 *upstream_start;
+    size_t                 *upstream;
 
     // Alloc
     down_global = malloc(global_domain.ncells_active * sizeof(*down_global));
     check_alloc_status(down_global, "Memory allocation error");
+    upstream_start = malloc((global_domain.ncells_active + 1) *
+                            sizeof(*upstream_start));
+    check_alloc_status(upstream_start, "Memory allocation error");
+    upstream = malloc((global_domain.ncells_active + 1) * sizeof(*upstream));
+    check_alloc_status(upstream, "Memory allocation error");
     nup_global = malloc(global_domain.ncells_active * sizeof(*nup_global));
     check_alloc_status(nup_global, "Memory allocation error");
     up_global = malloc(global_domain.ncells_active * sizeof(*up_global));
@@ -361,22 +340,22 @@ rout_random_set_upstream(void)
 
     // Get upstream
     if (mpi_rank == VIC_MPI_ROOT) {
+        rout_graph_set_upstream(down_global, global_domain.ncells_active,
+                                upstream_start, upstream);
+
         for (i = 0; i < global_domain.ncells_active; i++) {
-            nup_global[i] = 0;
-
-            for (j = 0; j < global_domain.ncells_active; j++) {
-                if (down_global[j] == i && i != j) {
-                    up_global[i][nup_global[i]] = j;
-                    nup_global[i]++;
-
-                    if (nup_global[i] > MAX_UPSTREAM) {
-                        log_err(
-                            "Number of upstream cells [%zu] is bigger "
-                            "than the maximum number of upstream cells possible [%d]",
-                            nup_global[i],
-                            MAX_UPSTREAM);
-                    }
-                }
+            nup_global[i] = upstream_start[i + 1] - upstream_start[i];
+
+            if (nup_global[i] > MAX_UPSTREAM) {
+                log_err("Number of upstream cells [%zu] is bigger "
+                        "than the maximum number of upstream cells possible "
+                        "[%d]",
+                        nup_global[i],
+                        MAX_UPSTREAM);
+            }
+
+            for (j = 0; j < nup_global[i]; j++) {
+                up_global[i][j] = upstream[upstream_start[i] + j];
             }
         }
     }
@@ -405,6 +384,8 @@ rout_random_set_upstream(void)
     free(down_global);
     free(nup_global);
     free(up_global);
+    free(upstream_start);
+    free(upstream);
     for (i = 0; i < local_domain.ncells_active; i++) {
         free(up_local[i]);
     }
@@ -423,67 +404,52 @@ rout_basin_set_order()
     extern rout_con_struct *rout_con;
     extern size_t          *routing_order;
 
-    bool                   *done_tmp;
-    bool                   *done_fin;
-    size_t                  rank;
-    bool                    has_upstream;
+    size_t                 *upstream_start;
+    size_t                 *upstream;
+    size_t                 *level;
+    size_t                  nlevels;
 
     size_t                  i;
     size_t                  j;
 
-    done_tmp = malloc(local_domain.ncells_active * sizeof(*done_tmp));
-    check_alloc_status(done_tmp, "Memory allocation error.");
-    done_fin = malloc(local_domain.ncells_active * sizeof(*done_fin));
-    check_alloc_status(done_fin, "Memory allocation error.");
+    upstream_start = malloc((local_domain.ncells_active + 1) *
+                            sizeof(*upstream_start));
+    check_alloc_status(upstream_start, "Memory allocation error.");
+    upstream = malloc((local_domain.ncells_active + 1) * sizeof(*upstream));
+    check_alloc_status(upstream, "Memory allocation error.");
+    level = malloc((local_domain.ncells_active + 1) * sizeof(*level));
+    check_alloc_status(level, "Memory allocation error.");
 
+    upstream_start[0] = 0;
     for (i = 0; i < local_domain.ncells_active; i++) {
-        done_tmp[i] = false;
-        done_fin[i] = false;
+        upstream_start[i + 1] = upstream_start[i] + rout_con[i].Nupstream;
+        for (j = 0; j < rout_con[i].Nupstream; j++) {
+            upstream[upstream_start[i] + j] = rout_con[i].upstream[j];
+        }
     }
 
-    // Set cell_order_local for node
-    rank = 0;
-    while (rank < local_domain.ncells_active) {
-        for (i = 0; i < local_domain.ncells_active; i++) {
-            if (done_fin[i]) {
-                continue;
-            }
-
-            // count number of upstream cells that are not processed yet
-            has_upstream = false;
-            for (j = 0; j < rout_con[i].Nupstream; j++) {
-                if (!done_fin[rout_con[i].upstream[j]]) {
-                    has_upstream = true;
-                    break;
-                }
-            }
-
-            if (has_upstream) {
-                continue;
-            }
-
-            // if no upstream, add as next order
-            routing_order[rank] = i;
-            done_tmp[i] = true;
-            rank++;
+    // Set cell_order_local for node: by stage, then by cell
+    nlevels = rout_graph_set_levels(upstream_start, upstream,
+                                    local_domain.ncells_active, level);
 
-            if (rank > local_domain.ncells_active) {
-                log_err("Error in ordering and ranking cells");
-            }
-        }
-        for (i = 0; i < local_domain.ncells_active; i++) {
-            if (done_tmp[i] == true) {
-                done_fin[i] = true;
-            }
-        }
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        routing_order[i] = i;
+    }
+    if (local_domain.ncells_active > 0) {
+        size_t_counting_sort(routing_order, level, nlevels,
+                             local_domain.ncells_active);
     }
 
-    free(done_tmp);
-    free(done_fin);
+    free(upstream_start);
+    free(upstream);
+    free(level);
 }
 
 /******************************************
 * @brief   Setup the upstream-downstream order (master node)
+* @details The master node assigns every cell a routing stage (level) such
+*          that all upstream cells are in earlier stages. Each node orders
+*          its own cells by stage.
 ******************************************/
 void
 rout_random_set_order()
@@ -492,23 +458,29 @@ rout_random_set_order()
     extern domain_struct    global_domain;
     extern rout_con_struct *rout_con;
     extern size_t          *routing_order;
+    extern size_t          *routing_stage_start;
+    extern size_t           routing_nstages;
+    extern MPI_Comm         MPI_COMM_VIC;
     extern int              mpi_rank;
 
     size_t                **up_global;
     size_t                **up_local;
     size_t                 *nup_global;
     size_t                 *nup_local;
+    size_t                 *level_global;
+    size_t                 *level_local;
+    size_t                 *upstream_start;
+    size_t                 *upstream;
 
-    bool                    done_tmp[global_domain.ncells_active];
-    bool                    done_fin[global_domain.ncells_active];
-
-    size_t                  rank;
-    bool                    has_upstream;
+    int                     status;
 
     size_t                  i;
     size_t                  j;
 
     // Alloc
+    level_global = NULL;
+    upstream_start = NULL;
+    upstream = NULL;
     if (mpi_rank == VIC_MPI_ROOT) {
         nup_global = malloc(global_domain.ncells_active * sizeof(*nup_global));
         check_alloc_status(nup_global, "Memory allocation error");
@@ -518,6 +490,15 @@ rout_random_set_order()
             up_global[i] = malloc(MAX_UPSTREAM * sizeof(*up_global[i]));
             check_alloc_status(up_global[i], "Memory allocation error");
         }
+        level_global =
+            malloc(global_domain.ncells_active * sizeof(*level_global));
+        check_alloc_status(level_global, "Memory allocation error");
+        upstream_start = malloc((global_domain.ncells_active + 1) *
+                                sizeof(*upstream_start));
+        check_alloc_status(upstream_start, "Memory allocation error");
+        upstream = malloc((global_domain.ncells_active + 1) *
+                          sizeof(*upstream));
+        check_alloc_status(upstream, "Memory allocation error");
     }
     nup_local = malloc(local_domain.ncells_active * sizeof(*nup_local));
     check_alloc_status(nup_local, "Memory allocation error");
@@ -527,6 +508,8 @@ rout_random_set_order()
         up_local[i] = malloc(MAX_UPSTREAM * sizeof(*up_local[i]));
         check_alloc_status(up_local[i], "Memory allocation error");
     }
+    level_local = malloc(local_domain.ncells_active * sizeof(*level_local));
+    check_alloc_status(level_local, "Memory allocation error");
 
     // Set nupstream and upstream
     for (i = 0; i < local_domain.ncells_active; i++) {
@@ -541,48 +524,41 @@ rout_random_set_order()
     gather_size_t(nup_global, nup_local);
     gather_size_t_2d(up_global, up_local, MAX_UPSTREAM);
 
-    // Get order
+    // Get stages
     if (mpi_rank == VIC_MPI_ROOT) {
+        upstream_start[0] = 0;
         for (i = 0; i < global_domain.ncells_active; i++) {
-            done_tmp[i] = false;
-            done_fin[i] = false;
-        }
-
-        rank = 0;
-        while (rank < global_domain.ncells_active) {
-            for (i = 0; i < global_domain.ncells_active; i++) {
-                if (done_fin[i]) {
-                    continue;
-                }
-
-                // count number of upstream cells that are not processed yet
-                has_upstream = false;
-                for (j = 0; j < nup_global[i]; j++) {
-                    if (!done_fin[up_global[i][j]]) {
-                        has_upstream = true;
-                        break;
-                    }
-                }
-
-                if (has_upstream) {
-                    continue;
-                }
-
-                // if no upstream, add as next order
-                routing_order[rank] = i;
-                done_tmp[i] = true;
-                rank++;
-
-                if (rank > global_domain.ncells_active) {
-                    log_err("Error in ordering and ranking cells");
-                }
-            }
-            for (i = 0; i < global_domain.ncells_active; i++) {
-                if (done_tmp[i] == true) {
-                    done_fin[i] = true;
-                }
+            upstream_start[i + 1] = upstream_start[i] + nup_global[i];
+            for (j = 0; j < nup_global[i]; j++) {
+                upstream[upstream_start[i] + j] = up_global[i][j];
             }
         }
+
+        routing_nstages = rout_graph_set_levels(upstream_start, upstream,
+                                                global_domain.ncells_active,
+                                                level_global);
+    }
+
+    // Scatter stages
+    scatter_size_t(level_global, level_local);
+    status = MPI_Bcast(&routing_nstages, 1, MPI_AINT, VIC_MPI_ROOT,
+                       MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // Order local cells by stage
+    routing_stage_start = calloc(routing_nstages + 1,
+                                 sizeof(*routing_stage_start));
+    check_alloc_status(routing_stage_start, "Memory allocation error");
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        routing_order[i] = i;
+        routing_stage_start[level_local[i] + 1]++;
+    }
+    for (i = 0; i < routing_nstages; i++) {
+        routing_stage_start[i + 1] += routing_stage_start[i];
+    }
+    if (local_domain.ncells_active > 0) {
+        size_t_counting_sort(routing_order, level_local, routing_nstages,
+                             local_domain.ncells_active);
     }
 
     // Free
@@ -592,12 +568,326 @@ rout_random_set_order()
         }
         free(up_global);
         free(nup_global);
+        free(level_global);
+        free(upstream_start);
+        free(upstream);
     }
     for (i = 0; i < local_domain.ncells_active; i++) {
         free(up_local[i]);
     }
     free(up_local);
     free(nup_local);
+    free(level_local);
+}
+
+/******************************************
+* @brief   Setup the routing halo exchange (random decomposition)
+* @details Every node determines which of its cells drain into a cell of
+*          another node (send) and which upstream cells of its own cells are
+*          owned by another node (receive). Both sides order the cells by
+*          stage, node and local index so that messages match without
+*          exchanging the cell lists.
+******************************************/
+void
+rout_random_set_halo(void)
+{
+    extern domain_struct              local_domain;
+    extern domain_struct              global_domain;
+    extern global_param_struct        global_param;
+    extern plugin_global_param_struct plugin_global_param;
+    extern rout_con_struct           *rout_con;
+    extern rout_var_struct           *rout_var;
+    extern rout_halo_struct           rout_halo;
+    extern size_t                    *routing_order;
+    extern size_t                    *routing_stage_start;
+    extern size_t                     routing_nstages;
+    extern size_t                    *mpi_map_mapping_array;
+    extern MPI_Comm                   MPI_COMM_VIC;
+    extern int                        mpi_rank;
+    extern int                        mpi_size;
+
+    int                               ncells_local;
+    int                              *ncells_node;
+    size_t                           *node_start;
+    size_t                           *node;
+    size_t                           *pos;
+    size_t                           *level_pos;
+    size_t                           *down_pos;
+    size_t                           *level_local;
+    size_t                           *down_local;
+    size_t                           *level_global;
+    size_t                           *down_global;
+    size_t                           *slot;
+    size_t                            nentries;
+    size_t                           *entry_order;
+    size_t                           *entry_cell;
+    size_t                           *entry_stage;
+    size_t                           *entry_node;
+    size_t                            rout_steps_per_dt;
+    size_t                            iPos;
+    size_t                            iDown;
+    size_t                            iEntry;
+    int                               status;
+
+    size_t                            i;
+    size_t                            j;
+    size_t                            k;
+
+    rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
+                        global_param.model_steps_per_day;
+
+    // Number of cells and first (gathered) position per node
+    ncells_local = (int) local_domain.ncells_active;
+    ncells_node = malloc(mpi_size * sizeof(*ncells_node));
+    check_alloc_status(ncells_node, "Memory allocation error");
+    status = MPI_Allgather(&ncells_local, 1, MPI_INT, ncells_node, 1,
+                           MPI_INT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    node_start = malloc((mpi_size + 1) * sizeof(*node_start));
+    check_alloc_status(node_start, "Memory allocation error");
+    node = malloc(global_domain.ncells_active * sizeof(*node));
+    check_alloc_status(node, "Memory allocation error");
+    node_start[0] = 0;
+    for (i = 0; i < (size_t) mpi_size; i++) {
+        node_start[i + 1] = node_start[i] + ncells_node[i];
+        for (j = node_start[i]; j < node_start[i + 1]; j++) {
+            node[j] = i;
+        }
+    }
+
+    // Alloc
+    pos = malloc(global_domain.ncells_active * sizeof(*pos));
+    check_alloc_status(pos, "Memory allocation error");
+    level_pos = malloc(global_domain.ncells_active * sizeof(*level_pos));
+    check_alloc_status(level_pos, "Memory allocation error");
+    down_pos = malloc(global_domain.ncells_active * sizeof(*down_pos));
+    check_alloc_status(down_pos, "Memory allocation error");
+    slot = malloc(global_domain.ncells_active * sizeof(*slot));
+    check_alloc_status(slot, "Memory allocation error");
+    level_global = NULL;
+    down_global = NULL;
+    if (mpi_rank == VIC_MPI_ROOT) {
+        level_global =
+            malloc(global_domain.ncells_active * sizeof(*level_global));
+        check_alloc_status(level_global, "Memory allocation error");
+        down_global =
+            malloc(global_domain.ncells_active * sizeof(*down_global));
+        check_alloc_status(down_global, "Memory allocation error");
+    }
+    level_local = malloc(local_domain.ncells_active * sizeof(*level_local));
+    check_alloc_status(level_local, "Memory allocation error");
+    down_local = malloc(local_domain.ncells_active * sizeof(*down_local));
+    check_alloc_status(down_local, "Memory allocation error");
+
+    // Get stage and downstream
+    for (i = 0; i < routing_nstages; i++) {
+        for (j = routing_stage_start[i]; j < routing_stage_start[i + 1]; j++) {
+            level_local[routing_order[j]] = i;
+        }
+    }
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        down_local[i] = rout_con[i].downstream;
+    }
+
+    // Gather stage and downstream, and map to gathered positions
+    gather_size_t(level_global, level_local);
+    gather_size_t(down_global, down_local);
+
+    if (mpi_rank == VIC_MPI_ROOT) {
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            pos[mpi_map_mapping_array[i]] = i;
+        }
+        for (i = 0; i < global_domain.ncells_active; i++) {
+            level_pos[i] = level_global[mpi_map_mapping_array[i]];
+            down_pos[i] = pos[down_global[mpi_map_mapping_array[i]]];
+        }
+    }
+
+    status = MPI_Bcast(pos, (int) global_domain.ncells_active,
+                       MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Bcast(level_pos, (int) global_domain.ncells_active,
+                       MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Bcast(down_pos, (int) global_domain.ncells_active,
+                       MPI_AINT, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    // Alloc entries (at most one per upstream link)
+    nentries = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        nentries += rout_con[i].Nupstream;
+    }
+    nentries = max(nentries, local_domain.ncells_active);
+    entry_order = malloc((nentries + 1) * sizeof(*entry_order));
+    check_alloc_status(entry_order, "Memory allocation error");
+    entry_cell = malloc((nentries + 1) * sizeof(*entry_cell));
+    check_alloc_status(entry_cell, "Memory allocation error");
+    entry_stage = malloc((nentries + 1) * sizeof(*entry_stage));
+    check_alloc_status(entry_stage, "Memory allocation error");
+    entry_node = malloc((nentries + 1) * sizeof(*entry_node));
+    check_alloc_status(entry_node, "Memory allocation error");
+
+    // Send: local cells draining into a cell of another node
+    nentries = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        iPos = node_start[mpi_rank] + i;
+        iDown = down_pos[iPos];
+        if (iDown != iPos && node[iDown] != (size_t) mpi_rank) {
+            entry_order[nentries] = nentries;
+            entry_cell[nentries] = i;
+            entry_stage[nentries] = level_pos[iPos];
+            entry_node[nentries] = node[iDown];
+            nentries++;
+        }
+    }
+    if (nentries > 0) {
+        size_t_counting_sort(entry_order, entry_node, mpi_size, nentries);
+        size_t_counting_sort(entry_order, entry_stage, routing_nstages,
+                             nentries);
+    }
+
+    rout_halo.send_rank = malloc((nentries + 1) *
+                                 sizeof(*rout_halo.send_rank));
+    check_alloc_status(rout_halo.send_rank, "Memory allocation error");
+    rout_halo.send_stage = malloc((nentries + 1) *
+                                  sizeof(*rout_halo.send_stage));
+    check_alloc_status(rout_halo.send_stage, "Memory allocation error");
+    rout_halo.send_start = malloc((nentries + 1) *
+                                  sizeof(*rout_halo.send_start));
+    check_alloc_status(rout_halo.send_start, "Memory allocation error");
+    rout_halo.send_cells = malloc((nentries + 1) *
+                                  sizeof(*rout_halo.send_cells));
+    check_alloc_status(rout_halo.send_cells, "Memory allocation error");
+    rout_halo.send_buffer = malloc((nentries + 1) * rout_steps_per_dt *
+                                   sizeof(*rout_halo.send_buffer));
+    check_alloc_status(rout_halo.send_buffer, "Memory allocation error");
+
+    rout_halo.nsend = 0;
+    for (i = 0; i < nentries; i++) {
+        iEntry = entry_order[i];
+        if (rout_halo.nsend == 0 ||
+            rout_halo.send_stage[rout_halo.nsend - 1] !=
+            entry_stage[iEntry] ||
+            rout_halo.send_rank[rout_halo.nsend - 1] !=
+            (int) entry_node[iEntry]) {
+            rout_halo.send_rank[rout_halo.nsend] = (int) entry_node[iEntry];
+            rout_halo.send_stage[rout_halo.nsend] = entry_stage[iEntry];
+            rout_halo.send_start[rout_halo.nsend] = i;
+            rout_halo.nsend++;
+        }
+        rout_halo.send_cells[i] = entry_cell[iEntry];
+    }
+    rout_halo.send_start[rout_halo.nsend] = nentries;
+
+    // Receive: cells of another node draining into a local cell
+    nentries = 0;
+    for (i = 0; i < global_domain.ncells_active; i++) {
+        iDown = down_pos[i];
+        if (iDown != i && node[i] != (size_t) mpi_rank &&
+            node[iDown] == (size_t) mpi_rank) {
+            entry_order[nentries] = nentries;
+            entry_cell[nentries] = i;
+            entry_stage[nentries] = level_pos[i];
+            entry_node[nentries] = node[i];
+            nentries++;
+        }
+    }
+    if (nentries > 0) {
+        size_t_counting_sort(entry_order, entry_stage, routing_nstages,
+                             nentries);
+    }
+
+    rout_halo.recv_rank = malloc((nentries + 1) *
+                                 sizeof(*rout_halo.recv_rank));
+    check_alloc_status(rout_halo.recv_rank, "Memory allocation error");
+    rout_halo.recv_stage = malloc((nentries + 1) *
+                                  sizeof(*rout_halo.recv_stage));
+    check_alloc_status(rout_halo.recv_stage, "Memory allocation error");
+    rout_halo.recv_start = malloc((nentries + 1) *
+                                  sizeof(*rout_halo.recv_start));
+    check_alloc_status(rout_halo.recv_start, "Memory allocation error");
+    rout_halo.recv_buffer = malloc((nentries + 1) * rout_steps_per_dt *
+                                   sizeof(*rout_halo.recv_buffer));
+    check_alloc_status(rout_halo.recv_buffer, "Memory allocation error");
+
+    rout_halo.nrecv = 0;
+    for (i = 0; i < nentries; i++) {
+        iEntry = entry_order[i];
+        if (rout_halo.nrecv == 0 ||
+            rout_halo.recv_stage[rout_halo.nrecv - 1] !=
+            entry_stage[iEntry] ||
+            rout_halo.recv_rank[rout_halo.nrecv - 1] !=
+            (int) entry_node[iEntry]) {
+            rout_halo.recv_rank[rout_halo.nrecv] = (int) entry_node[iEntry];
+            rout_halo.recv_stage[rout_halo.nrecv] = entry_stage[iEntry];
+            rout_halo.recv_start[rout_halo.nrecv] = i;
+            rout_halo.nrecv++;
+        }
+        slot[entry_cell[iEntry]] = i;
+    }
+    rout_halo.recv_start[rout_halo.nrecv] = nentries;
+
+    rout_halo.requests = malloc((rout_halo.nsend + rout_halo.nrecv + 1) *
+                                sizeof(*rout_halo.requests));
+    check_alloc_status(rout_halo.requests, "Memory allocation error");
+
+    // Set upstream discharge (local or halo)
+    rout_halo.upstream_start =
+        malloc((local_domain.ncells_active + 1) *
+               sizeof(*rout_halo.upstream_start));
+    check_alloc_status(rout_halo.upstream_start, "Memory allocation error");
+    rout_halo.upstream_start[0] = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        rout_halo.upstream_start[i + 1] = rout_halo.upstream_start[i] +
+                                          rout_con[i].Nupstream;
+    }
+    rout_halo.upstream_discharge =
+        malloc((rout_halo.upstream_start[local_domain.ncells_active] + 1) *
+               sizeof(*rout_halo.upstream_discharge));
+    check_alloc_status(rout_halo.upstream_discharge,
+                       "Memory allocation error");
+    rout_halo.upstream_local =
+        malloc((rout_halo.upstream_start[local_domain.ncells_active] + 1) *
+               sizeof(*rout_halo.upstream_local));
+    check_alloc_status(rout_halo.upstream_local, "Memory allocation error");
+
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        for (j = 0; j < rout_con[i].Nupstream; j++) {
+            k = rout_halo.upstream_start[i] + j;
+            iPos = pos[rout_con[i].upstream[j]];
+            if (node[iPos] == (size_t) mpi_rank) {
+                rout_halo.upstream_local[k] = iPos - node_start[mpi_rank];
+                rout_halo.upstream_discharge[k] =
+                    rout_var[iPos - node_start[mpi_rank]].dt_discharge;
+            }
+            else {
+                rout_halo.upstream_local[k] = local_domain.ncells_active;
+                rout_halo.upstream_discharge[k] =
+                    rout_halo.recv_buffer + slot[iPos] * rout_steps_per_dt;
+            }
+        }
+    }
+
+    // Free
+    if (mpi_rank == VIC_MPI_ROOT) {
+        free(level_global);
+        free(down_global);
+    }
+    free(ncells_node);
+    free(node_start);
+    free(node);
+    free(pos);
+    free(level_pos);
+    free(down_pos);
+    free(slot);
+    free(level_local);
+    free(down_local);
+    free(entry_order);
+    free(entry_cell);
+    free(entry_stage);
+    free(entry_node);
 }
 
 /******************************************
@@ -632,6 +922,7 @@ rout_init(void)
         rout_random_set_downstream();
         rout_random_set_upstream();
         rout_random_set_order();
+        rout_random_set_halo();
     }
 
     // close parameter file
@@ -28,52 +28,32 @@
 #include <plugin.h>
 
 /******************************************
-* @brief   Run routing on master node (random decomposition)
+* @brief   Run routing on local node (random decomposition)
+* @details Each node routes its own cells stage by stage. After a stage the
+*          sub-step discharge of cells draining into another node is sent;
+*          before a stage the halo discharge of earlier stages is received.
 ******************************************/
 void
 rout_random_run()
 {
     extern domain_struct              local_domain;
-    extern domain_struct              global_domain;
     extern global_param_struct        global_param;
     extern plugin_global_param_struct plugin_global_param;
-    extern plugin_option_struct       plugin_options;
-    extern plugin_option_struct       plugin_options;
     extern rout_var_struct           *rout_var;
-    extern rout_con_struct           *rout_con;
-    extern rout_force_struct         *rout_force;
+    extern rout_halo_struct           rout_halo;
     extern size_t                    *routing_order;
-    extern int                        mpi_rank;
+    extern size_t                    *routing_stage_start;
+    extern size_t                     routing_nstages;
+    extern MPI_Comm                   MPI_COMM_VIC;
 
-    size_t                           *nup_global;
-    size_t                          **up_global;
-    double                          **ruh_global;
-    double                          **iuh_global;
-    double                           *run_global;
-    double                          **dt_dis_global;
-    double                           *dis_global;
-    double                           *stream_global;
-    double                           *inflow_global;
-    double                           *force_global;
-
-    size_t                           *nup_local;
-    size_t                          **up_local;
-    double                          **ruh_local;
-    double                          **iuh_local;
-    double                           *run_local;
-    double                          **dt_dis_local;
-    double                           *dis_local;
-    double                           *stream_local;
-    double                           *inflow_local;
-    double                           *force_local;
-
-    size_t                            iCell;
-    double                            inflow;
-    double                           *dt_inflow;
-    double                           *dt_runoff;
     size_t                            rout_steps_per_dt;
-    double                            prev_stream;
-    double                           *convoluted;
+    size_t                            iCell;
+    size_t                            iStage;
+    size_t                            iSend;
+    size_t                            iRecv;
+    size_t                            iRecv_start;
+    size_t                            count;
+    int                               status;
 
     size_t                            i;
     size_t                            j;
@@ -82,278 +62,85 @@ rout_random_run()
     rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
                         global_param.model_steps_per_day;
 
-    // Alloc
-    dt_inflow = malloc(rout_steps_per_dt * sizeof(*dt_inflow));
-    check_alloc_status(dt_inflow, "Memory allocation error");
-    dt_runoff = malloc(rout_steps_per_dt * sizeof(*dt_runoff));
-    check_alloc_status(dt_runoff, "Memory allocation error");
-    convoluted = malloc(
-        (plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
-        sizeof(*convoluted));
-    check_alloc_status(convoluted, "Memory allocation error");
-
-    nup_global = malloc(global_domain.ncells_active * sizeof(*nup_global));
-    check_alloc_status(nup_global, "Memory allocation error");
-    up_global = malloc(global_domain.ncells_active * sizeof(*up_global));
-    check_alloc_status(up_global, "Memory allocation error");
-    ruh_global = malloc(global_domain.ncells_active * sizeof(*ruh_global));
-    check_alloc_status(ruh_global, "Memory allocation error");
-    iuh_global = malloc(global_domain.ncells_active * sizeof(*iuh_global));
-    check_alloc_status(iuh_global, "Memory allocation error");
-    run_global = malloc(global_domain.ncells_active * sizeof(*run_global));
-    check_alloc_status(run_global, "Memory allocation error");
-    dt_dis_global =
-        malloc(global_domain.ncells_active * sizeof(*dt_dis_global));
-    check_alloc_status(dt_dis_global, "Memory allocation error");
-    dis_global = malloc(global_domain.ncells_active * sizeof(*dis_global));
-    check_alloc_status(dis_global, "Memory allocation error");
-    stream_global =
-        malloc(global_domain.ncells_active * sizeof(*stream_global));
-    check_alloc_status(stream_global, "Memory allocation error");
-    inflow_global =
-        malloc(global_domain.ncells_active * sizeof(*inflow_global));
-    check_alloc_status(inflow_global, "Memory allocation error");
-
-
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        up_global[i] = malloc(MAX_UPSTREAM * sizeof(*up_global[i]));
-        check_alloc_status(up_global[i], "Memory allocation error");
-        ruh_global[i] =
-            malloc(plugin_options.UH_LENGTH * sizeof(*ruh_global[i]));
-        check_alloc_status(ruh_global[i], "Memory allocation error");
-        iuh_global[i] =
-            malloc(plugin_options.UH_LENGTH * sizeof(*iuh_global[i]));
-        check_alloc_status(iuh_global[i], "Memory allocation error");
-        dt_dis_global[i] = malloc(
-            (plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
-            sizeof(*dt_dis_global[i]));
-        check_alloc_status(dt_dis_global[i], "Memory allocation error");
-    }
-
-    nup_local = malloc(local_domain.ncells_active * sizeof(*nup_local));
-    check_alloc_status(nup_local, "Memory allocation error");
-    up_local = malloc(local_domain.ncells_active * sizeof(*up_local));
-    check_alloc_status(up_local, "Memory allocation error");
-    ruh_local = malloc(local_domain.ncells_active * sizeof(*ruh_local));
-    check_alloc_status(ruh_local, "Memory allocation error");
-    iuh_local = malloc(local_domain.ncells_active * sizeof(*iuh_local));
-    check_alloc_status(iuh_local, "Memory allocation error");
-    run_local = malloc(local_domain.ncells_active * sizeof(*run_local));
-    check_alloc_status(run_local, "Memory allocation error");
-    dt_dis_local = malloc(local_domain.ncells_active * sizeof(*dt_dis_local));
-    check_alloc_status(dt_dis_local, "Memory allocation error");
-    dis_local = malloc(local_domain.ncells_active * sizeof(*dis_local));
-    check_alloc_status(dis_local, "Memory allocation error");
-    stream_local = malloc(local_domain.ncells_active * sizeof(*stream_local));
-    check_alloc_status(stream_local, "Memory allocation error");
-    inflow_local = malloc(local_domain.ncells_active * sizeof(*inflow_local));
-    check_alloc_status(inflow_local, "Memory allocation error");
-
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        up_local[i] = malloc(MAX_UPSTREAM * sizeof(*up_local[i]));
-        check_alloc_status(up_local[i], "Memory allocation error");
-        ruh_local[i] = malloc(plugin_options.UH_LENGTH * sizeof(*ruh_local[i]));
-        check_alloc_status(ruh_local[i], "Memory allocation error");
-        iuh_local[i] = malloc(plugin_options.UH_LENGTH * sizeof(*iuh_local[i]));
-        check_alloc_status(iuh_local[i], "Memory allocation error");
-        dt_dis_local[i] = malloc(
-            (plugin_options.UH_LENGTH + rout_steps_per_dt - 1) *
-            sizeof(*dt_dis_local[i]));
-        check_alloc_status(dt_dis_local[i], "Memory allocation error");
-    }
-
-    if (plugin_options.FORCE_ROUTING) {
-        force_global = malloc(
-            global_domain.ncells_active * sizeof(*force_global));
-        check_alloc_status(force_global, "Memory allocation error");
-        force_local = malloc(local_domain.ncells_active * sizeof(*force_local));
-        check_alloc_status(force_local, "Memory allocation error");
+    // Post halo receives
+    for (i = 0; i < rout_halo.nrecv; i++) {
+        count = (rout_halo.recv_start[i + 1] - rout_halo.recv_start[i]) *
+                rout_steps_per_dt;
+        status = MPI_Irecv(rout_halo.recv_buffer +
+                           rout_halo.recv_start[i] * rout_steps_per_dt,
+                           (int) count, MPI_DOUBLE, rout_halo.recv_rank[i],
+                           ROUT_HALO_TAG, MPI_COMM_VIC,
+                           &(rout_halo.requests[rout_halo.nsend + i]));
+        check_mpi_status(status, "MPI error.");
     }
 
-    // Get
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        nup_local[i] = rout_con[i].Nupstream;
-        for (j = 0; j < rout_con[i].Nupstream; j++) {
-            up_local[i][j] = rout_con[i].upstream[j];
-        }
-        for (j = 0; j < plugin_options.UH_LENGTH; j++) {
-            ruh_local[i][j] = rout_con[i].runoff_uh[j];
-        }
-        for (j = 0; j < plugin_options.UH_LENGTH; j++) {
-            iuh_local[i][j] = rout_con[i].inflow_uh[j];
+    iSend = 0;
+    iRecv = 0;
+    for (iStage = 0; iStage < routing_nstages; iStage++) {
+        // Wait for halo cells of earlier stages
+        iRecv_start = iRecv;
+        while (iRecv < rout_halo.nrecv &&
+               rout_halo.recv_stage[iRecv] < iStage) {
+            iRecv++;
         }
-
-        run_local[i] = rout_var[i].runoff;
-        for (j = 0; j < plugin_options.UH_LENGTH + rout_steps_per_dt - 1; j++) {
-            dt_dis_local[i][j] = rout_var[i].dt_discharge[j];
+        if (iRecv > iRecv_start) {
+            status = MPI_Waitall((int) (iRecv - iRecv_start),
+                                 &(rout_halo.requests[rout_halo.nsend +
+                                                      iRecv_start]),
+                                 MPI_STATUSES_IGNORE);
+            check_mpi_status(status, "MPI error.");
         }
 
-        dis_local[i] = rout_var[i].discharge;
-        stream_local[i] = rout_var[i].stream;
-        inflow_local[i] = rout_var[i].inflow;
-        if (plugin_options.FORCE_ROUTING) {
-            force_local[i] = rout_force[i].discharge;
-        }
-    }
-
-    // Gather
-    gather_size_t(nup_global, nup_local);
-    gather_size_t_2d(up_global, up_local, MAX_UPSTREAM);
-    gather_double_2d(ruh_global, ruh_local, plugin_options.UH_LENGTH);
-    gather_double_2d(iuh_global, iuh_local, plugin_options.UH_LENGTH);
-    gather_double(run_global, run_local);
-    gather_double_2d(dt_dis_global, dt_dis_local,
-                     plugin_options.UH_LENGTH + rout_steps_per_dt - 1);
-    gather_double(dis_global, dis_local);
-    gather_double(stream_global, stream_local);
-    gather_double(inflow_global, inflow_local);
-    if (plugin_options.FORCE_ROUTING) {
-        gather_double(force_global, force_local);
-    }
-
-    // Calculate
-    if (mpi_rank == VIC_MPI_ROOT) {
-        for (i = 0; i < global_domain.ncells_active; i++) {
+        // If running with OpenMP, run each stage with multiple threads
+        #pragma omp parallel for default(shared) private(i, j, iCell)
+        for (i = routing_stage_start[iStage];
+             i < routing_stage_start[iStage + 1];
+             i++) {
             iCell = routing_order[i];
 
-            /* Shift and clear previous discharge data */
-            for (j = 0; j < rout_steps_per_dt; j++) {
-                dt_dis_global[iCell][0] = 0.0;
-                cshift(dt_dis_global[iCell],
-                       plugin_options.UH_LENGTH + rout_steps_per_dt - 1, 1, 0,
-                       1);
-            }
-
-            // Calculate delta-time runoff (equal contribution)
-            for (j = 0; j < rout_steps_per_dt; j++) {
-                dt_runoff[j] = run_global[iCell] / rout_steps_per_dt;
-            }
-
-            // Convolute current runoff
-            convolve(dt_runoff, rout_steps_per_dt,
-                     ruh_global[iCell], plugin_options.UH_LENGTH,
-                     convoluted);
-            for (j = 0;
-                 j < rout_steps_per_dt + plugin_options.UH_LENGTH - 1;
+            // Local upstream discharge windows move every time step
+            for (j = rout_halo.upstream_start[iCell];
+                 j < rout_halo.upstream_start[iCell + 1];
                  j++) {
-                dt_dis_global[iCell][j] += convoluted[j];
-            }
-
-            /* INFLOW*/
-            // Gather inflow from VIC
-            inflow = 0.0;
-            if (plugin_options.FORCE_ROUTING) {
-                inflow += force_global[iCell];
-            }
-
-            // Calculate delta-time inflow (equal contribution)
-            inflow_global[iCell] = 0.;
-            for (j = 0; j < rout_steps_per_dt; j++) {
-                dt_inflow[j] = inflow / rout_steps_per_dt;
-                for (k = 0; k < nup_global[iCell]; k++) {
-                    dt_inflow[j] += dt_dis_global[up_global[iCell][k]][j];
+                if (rout_halo.upstream_local[j] <
+                    local_domain.ncells_active) {
+                    rout_halo.upstream_discharge[j] =
+                        rout_var[rout_halo.upstream_local[j]].dt_discharge;
                 }
-                inflow_global[iCell] += dt_inflow[j];
             }
 
-            // Convolute current inflow
-            convolve(dt_inflow, rout_steps_per_dt,
-                     iuh_global[iCell], plugin_options.UH_LENGTH,
-                     convoluted);
-            for (j = 0;
-                 j < rout_steps_per_dt + plugin_options.UH_LENGTH - 1;
-                 j++) {
-                dt_dis_global[iCell][j] += convoluted[j];
-            }
+            rout_cell_run(iCell, rout_halo.upstream_discharge +
+                          rout_halo.upstream_start[iCell]);
+        }
 
-            // Aggregate current timestep discharge & stream moisture
-            prev_stream = stream_global[iCell];
-            dis_global[iCell] = 0.0;
-            stream_global[iCell] = 0.0;
-            for (j = 0;
-                 j < plugin_options.UH_LENGTH + rout_steps_per_dt - 1;
+        // Send boundary cells of this stage
+        while (iSend < rout_halo.nsend &&
+               rout_halo.send_stage[iSend] == iStage) {
+            for (j = rout_halo.send_start[iSend];
+                 j < rout_halo.send_start[iSend + 1];
                  j++) {
-                if (j < rout_steps_per_dt) {
-                    dis_global[iCell] += dt_dis_global[iCell][j];
-                }
-                else {
-                    stream_global[iCell] += dt_dis_global[iCell][j];
+                iCell = rout_halo.send_cells[j];
+                for (k = 0; k < rout_steps_per_dt; k++) {
+                    rout_halo.send_buffer[j * rout_steps_per_dt + k] =
+                        rout_var[iCell].dt_discharge[k];
                 }
             }
 
-            // Check water balance
-            if (abs(prev_stream + (inflow_global[iCell] + run_global[iCell]) -
-                    (dis_global[iCell] + stream_global[iCell])) >
-                DBL_EPSILON) {
-                log_err(
-                    "Discharge water balance error [%.4f]. "
-                    "in: %.4f out: %.4f prev_storage: %.4f cur_storage %.4f",
-                    prev_stream + (inflow_global[iCell] + run_global[iCell]) -
-                    (dis_global[iCell] + stream_global[iCell]),
-                    (inflow_global[iCell] + run_global[iCell]),
-                    dis_global[iCell],
-                    prev_stream,
-                    stream_global[iCell]);
-            }
+            count = (rout_halo.send_start[iSend + 1] -
+                     rout_halo.send_start[iSend]) * rout_steps_per_dt;
+            status = MPI_Isend(rout_halo.send_buffer +
+                               rout_halo.send_start[iSend] *
+                               rout_steps_per_dt,
+                               (int) count, MPI_DOUBLE,
+                               rout_halo.send_rank[iSend], ROUT_HALO_TAG,
+                               MPI_COMM_VIC, &(rout_halo.requests[iSend]));
+            check_mpi_status(status, "MPI error.");
+            iSend++;
         }
     }
 
-    // Scatter discharge
-    scatter_double_2d(dt_dis_global, dt_dis_local,
-                      plugin_options.UH_LENGTH + rout_steps_per_dt - 1);
-    scatter_double(stream_global, stream_local);
-    scatter_double(inflow_global, inflow_local);
-    scatter_double(dis_global, dis_local);
-
-    // Set discharge
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        for (j = 0; j < plugin_options.UH_LENGTH + rout_steps_per_dt - 1; j++) {
-            rout_var[i].dt_discharge[j] = dt_dis_local[i][j];
-        }
-        rout_var[i].discharge = dis_local[i];
-        rout_var[i].stream = stream_local[i];
-        rout_var[i].inflow = inflow_local[i];
-    }
-
-    // Free
-    free(dt_inflow);
-    free(dt_runoff);
-    free(convoluted);
-
-    for (i = 0; i < global_domain.ncells_active; i++) {
-        free(up_global[i]);
-        free(ruh_global[i]);
-        free(iuh_global[i]);
-        free(dt_dis_global[i]);
-    }
-    free(nup_global);
-    free(up_global);
-    free(ruh_global);
-    free(iuh_global);
-    free(run_global);
-    free(dt_dis_global);
-    free(dis_global);
-    free(stream_global);
-    free(inflow_global);
-
-    for (i = 0; i < local_domain.ncells_active; i++) {
-        free(up_local[i]);
-        free(ruh_local[i]);
-        free(iuh_local[i]);
-        free(dt_dis_local[i]);
-    }
-    free(nup_local);
-    free(up_local);
-    free(ruh_local);
-    free(iuh_local);
-    free(run_local);
-    free(dt_dis_local);
-    free(dis_local);
-    free(stream_local);
-    free(inflow_local);
-
-    if (plugin_options.FORCE_ROUTING) {
-        free(force_global);
-        free(force_local);
-    }
+    // Complete all sends (and any remaining receives)
+    status = MPI_Waitall((int) (rout_halo.nsend + rout_halo.nrecv),
+                         rout_halo.requests, MPI_STATUSES_IGNORE);
+    check_mpi_status(status, "MPI error.");
 }
@@ -221,3 +221,26 @@ rout_store(nc_file_struct *state_file)
 
     free(dvar);
 }
+
+/******************************************
+* @brief   Copy the routing state of a cell to or from a checkpoint
+******************************************/
+void
+rout_checkpoint_cell(checkpoint_struct *ckpt,
+                     size_t             iCell)
+{
+    extern global_param_struct        global_param;
+    extern plugin_global_param_struct plugin_global_param;
+    extern plugin_option_struct       plugin_options;
+    extern rout_var_struct           *rout_var;
+
+    size_t                            j;
+    size_t                            rout_steps_per_dt;
+
+    rout_steps_per_dt = plugin_global_param.rout_steps_per_day /
+                        global_param.model_steps_per_day;
+
+    for (j = 0; j < plugin_options.UH_LENGTH + rout_steps_per_dt - 1; j++) {
+        checkpoint_double(ckpt, &(rout_var[iCell].dt_discharge[j]));
+    }
+}
@@ -40,8 +40,10 @@ wu_set_receiving(void)
 
     int                           *ivar;
     int                           *receiving_id;
+    rout_id_struct                *index;
     size_t                        *nreceiving_tmp;
     size_t                         error_count;
+    size_t                         first;
 
     size_t                         i;
     size_t                         j;
@@ -59,6 +61,8 @@ wu_set_receiving(void)
     nreceiving_tmp =
         malloc(local_domain.ncells_active * sizeof(*nreceiving_tmp));
     check_alloc_status(nreceiving_tmp, "Memory allocation error.");
+    index = malloc((local_domain.ncells_active + 1) * sizeof(*index));
+    check_alloc_status(index, "Memory allocation error.");
 
     d2start[0] = 0;
     d2start[1] = 0;
@@ -75,6 +79,8 @@ wu_set_receiving(void)
     get_scatter_nc_field_int(&(plugin_filenames.wateruse), "receiving_id",
                              d2start, d2count, receiving_id);
 
+    rout_id_index(receiving_id, local_domain.ncells_active, index);
+
     error_count = 0;
     for (i = 0; i < local_domain.ncells_active; i++) {
         nreceiving_tmp[i] = 0;
@@ -87,21 +93,19 @@ wu_set_receiving(void)
                                  d3start, d3count, ivar);
 
         for (i = 0; i < local_domain.ncells_active; i++) {
-            if (ivar[i] > 0) {
-                for (j = 0; j < local_domain.ncells_active; j++) {
-                    if (ivar[i] != receiving_id[j]) {
-                        continue;
-                    }
-
-                    if (nreceiving_tmp[j] >= wu_con[j].nreceiving) {
-                        log_err("number of receiving cells (%zu) is larger "
-                                "than specified in the parameter file (%zu)",
-                                nreceiving_tmp[j], wu_con[j].nreceiving);
-                    }
-                    wu_con[j].receiving[nreceiving_tmp[j]] = i;
-                    nreceiving_tmp[j]++;
-                    break;
+            if (ivar[i] > 0 &&
+                rout_id_find(index, local_domain.ncells_active, ivar[i],
+                             &first) > 0) {
+                // the first cell with the id
+                j = index[first].cell;
+
+                if (nreceiving_tmp[j] >= wu_con[j].nreceiving) {
+                    log_err("number of receiving cells (%zu) is larger "
+                            "than specified in the parameter file (%zu)",
+                            nreceiving_tmp[j], wu_con[j].nreceiving);
                 }
+                wu_con[j].receiving[nreceiving_tmp[j]] = i;
+                nreceiving_tmp[j]++;
             }
         }
     }
@@ -124,6 +128,7 @@ wu_set_receiving(void)
     free(nreceiving_tmp);
     free(ivar);
     free(receiving_id);
+    free(index);
 }
 
 /******************************************
@@ -137,76 +142,55 @@ wu_set_routing_order()
     extern wu_con_struct   *wu_con;
     extern size_t          *routing_order;
 
-    bool                   *done_tmp;
-    bool                   *done_fin;
-    size_t                  rank;
-    bool                    has_upstream;
-    bool                    has_command;
+    size_t                 *dep_start;
+    size_t                 *dep;
+    size_t                 *level;
+    size_t                  nlevels;
+    size_t                  ndep;
 
     size_t                  i;
     size_t                  j;
 
-    done_tmp = malloc(local_domain.ncells_active * sizeof(*done_tmp));
-    check_alloc_status(done_tmp, "Memory allocation error.");
-    done_fin = malloc(local_domain.ncells_active * sizeof(*done_fin));
-    check_alloc_status(done_fin, "Memory allocation error.");
+    dep_start = malloc((local_domain.ncells_active + 1) * sizeof(*dep_start));
+    check_alloc_status(dep_start, "Memory allocation error.");
+    level = malloc((local_domain.ncells_active + 1) * sizeof(*level));
+    check_alloc_status(level, "Memory allocation error.");
 
+    // cells wait for their upstream and receiving cells
+    ndep = 0;
     for (i = 0; i < local_domain.ncells_active; i++) {
-        done_tmp[i] = false;
-        done_fin[i] = false;
+        ndep += rout_con[i].Nupstream + wu_con[i].nreceiving;
     }
+    dep = malloc((ndep + 1) * sizeof(*dep));
+    check_alloc_status(dep, "Memory allocation error.");
 
-    // Set cell_order_local for node
-    rank = 0;
-    while (rank < local_domain.ncells_active) {
-        for (i = 0; i < local_domain.ncells_active; i++) {
-            if (done_fin[i]) {
-                continue;
-            }
-
-            // count number of upstream cells that are not processed yet
-            has_upstream = false;
-            for (j = 0; j < rout_con[i].Nupstream; j++) {
-                if (!done_fin[rout_con[i].upstream[j]]) {
-                    has_upstream = true;
-                    break;
-                }
-            }
-
-            if (has_upstream) {
-                continue;
-            }
-
-            has_command = false;
-            for (j = 0; j < wu_con[i].nreceiving; j++) {
-                if (!done_fin[wu_con[i].receiving[j]]) {
-                    has_command = true;
-                    break;
-                }
-            }
-
-            if (has_command) {
-                continue;
-            }
-
-            // if no upstream, add as next order
-            routing_order[rank] = i;
-            done_tmp[i] = true;
-            rank++;
-
-            if (rank > local_domain.ncells_active) {
-                log_err("Error in ordering and ranking cells");
-            }
+    dep_start[0] = 0;
+    ndep = 0;
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        for (j = 0; j < rout_con[i].Nupstream; j++) {
+            dep[ndep++] = rout_con[i].upstream[j];
         }
-        for (i = 0; i < local_domain.ncells_active; i++) {
-            if (done_tmp[i] == true) {
-                done_fin[i] = true;
-            }
+        for (j = 0; j < wu_con[i].nreceiving; j++) {
+            dep[ndep++] = wu_con[i].receiving[j];
         }
+        dep_start[i + 1] = ndep;
+    }
+
+    // Set cell_order_local for node: by stage, then by cell
+    nlevels = rout_graph_set_levels(dep_start, dep,
+                                    local_domain.ncells_active, level);
+
+    for (i = 0; i < local_domain.ncells_active; i++) {
+        routing_order[i] = i;
+    }
+    if (local_domain.ncells_active > 0) {
+        size_t_counting_sort(routing_order, level, nlevels,
+                             local_domain.ncells_active);
     }
 
-    free(done_tmp);
-    free(done_fin);
+    free(dep_start);
+    free(dep);
+    free(level);
 }
 
 /******************************************
@@ -13,18 +13,22 @@
 #define NR_VARIABLES_MANAGEMENT 9
 #define NR_TABLES_MANAGEMENT    4
 #define NUMBER_OF_TABLES        31
+#define NR_LEAVE_CLASSES_INIT   32
 
+/* Number of calendar days in a TABLE_D: 31 days for every month */
+#define NR_DAYS_LIST            (MONTHS_PER_YEAR * 31)
+
+/* Afgen table, x in ascending order. Tables are read once per crop type */
+/* and shared read-only by all cells with that crop                      */
 typedef struct TBL {
-    float x;
-    float y;
-    struct TBL *next;
+    size_t n;
+    float *x;
+    float *y;
 } TABLE;
 
+/* Management calendar, amount per calendar day (see ListIndex) */
 typedef struct TBLD {
-    int month;
-    int day;
-    float amount;
-    struct TBLD *next;
+    float amount[NR_DAYS_LIST];
 } TABLE_D;
 
 typedef struct CONSTANTS {
@@ -302,7 +306,6 @@ typedef struct GREEN {
     float weight;
     float age;
     float area;
-    struct GREEN *next;
 } Green;
 
 typedef struct PLANT {
@@ -334,7 +337,12 @@ typedef struct PLANT {
     nutrient_rates P_rt;
     nutrient_rates K_rt;
 
+    /* Leave classes, stored as a ring buffer with the oldest class first. */
+    /* The buffer only grows and is reused after harvest                   */
     Green *LeaveProperties;
+    size_t LeaveSize;
+    size_t LeaveStart;
+    size_t LeaveCount;
 } Plant;
 
 typedef struct SOIL {
@@ -477,6 +485,10 @@ void FillManageVariables();
 
 /* General help functions */
 float Afgen(TABLE *, float *);
+TABLE *NewTable(void);
+void AddTablePoint(TABLE *, float, float);
+void FreeTable(TABLE *);
+size_t ListIndex(int, int);
 float List(TABLE_D *);
 float List_cumsum(TABLE_D *, size_t);
 float limit(float a, float b, float c);
@@ -488,7 +500,11 @@ void IfSowing(SimUnit *, dmy_struct*);
 /* Additional functions */
 void Astro(SimUnit *);
 void Clean(SimUnit *);
-void Harvest(Green **);
+void CleanTables(SimUnit *);
+void Harvest(Plant *);
+Green *LeaveClass(Plant *, size_t);
+void AddLeaveClass(Plant *, float, float, float);
+void RemoveOldestLeaveClass(Plant *);
 
 /* Crop growth */
 void Partioning(SimUnit *);
@@ -527,6 +543,7 @@ void RateCalcultionNutrients(SimUnit *);
 
 void GetCropData(Plant *, char *);
 void GetManagement(Management *, char *);
+void SetListAmount(TABLE_D *, int, int, float, char *);
 
 void header(FILE *);
 void Output(SimUnit *, FILE *);
@@ -10,17 +10,85 @@ float
 Afgen(TABLE *Table,
       float *X)
 {
-    if (*X <= Table->x) {
-        return Table->y;
+    size_t lower;
+    size_t upper;
+    size_t middle;
+
+    if (*X <= Table->x[0]) {
+        return Table->y[0];
+    }
+    if (*X >= Table->x[Table->n - 1]) {
+        return Table->y[Table->n - 1];
     }
 
-    while (Table->next) {
-        if (*X >= Table->x && *X < Table->next->x) {
-            return (Table->y + (*X - Table->x) *
-                    (Table->next->y - Table->y) / (Table->next->x - Table->x));
+    /* Binary search for the last point with x <= X */
+    lower = 0;
+    upper = Table->n - 1;
+    while (upper - lower > 1) {
+        middle = lower + (upper - lower) / 2;
+        if (Table->x[middle] <= *X) {
+            lower = middle;
+        }
+        else {
+            upper = middle;
         }
-        Table = Table->next;
     }
 
-    return Table->y;
+    return (Table->y[lower] + (*X - Table->x[lower]) *
+            (Table->y[upper] - Table->y[lower]) /
+            (Table->x[upper] - Table->x[lower]));
+}
+
+/* ---------------------------------------------------------------------------*/
+/*  function NewTable()                                                       */
+/*  Purpose: Allocate an empty Afgen table                                    */
+/* ---------------------------------------------------------------------------*/
+
+TABLE *
+NewTable(void)
+{
+    TABLE *Table;
+
+    Table = malloc(sizeof(*Table));
+    check_alloc_status(Table, "Memory allocation error");
+    Table->n = 0;
+    Table->x = NULL;
+    Table->y = NULL;
+
+    return Table;
+}
+
+/* ---------------------------------------------------------------------------*/
+/*  function AddTablePoint()                                                  */
+/*  Purpose: Append a point to an Afgen table                                 */
+/* ---------------------------------------------------------------------------*/
+
+void
+AddTablePoint(TABLE *Table,
+              float  X,
+              float  Y)
+{
+    Table->x = realloc(Table->x, (Table->n + 1) * sizeof(*Table->x));
+    check_alloc_status(Table->x, "Memory allocation error");
+    Table->y = realloc(Table->y, (Table->n + 1) * sizeof(*Table->y));
+    check_alloc_status(Table->y, "Memory allocation error");
+
+    Table->x[Table->n] = X;
+    Table->y[Table->n] = Y;
+    Table->n++;
+}
+
+/* ---------------------------------------------------------------------------*/
+/*  function FreeTable()                                                      */
+/*  Purpose: Free an Afgen table                                              */
+/* ---------------------------------------------------------------------------*/
+
+void
+FreeTable(TABLE *Table)
+{
+    if (Table) {
+        free(Table->x);
+        free(Table->y);
+        free(Table);
+    }
 }
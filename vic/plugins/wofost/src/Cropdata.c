@@ -13,10 +13,11 @@ GetCropData(Plant *CROP,
     extern char *CropParam[];
     extern char *CropParam2[];
 
-    TABLE       *Table[NR_TABLES_CRP], *start, *head;
+    TABLE       *Table[NR_TABLES_CRP];
 
     char         line[MAXSTRING];
     int          i, c, count;
+    size_t       j;
     float        Variable[NR_VARIABLES_CRP], XValue, YValue;
     char         x[2], xx[2], word[100];
     FILE        *fq;
@@ -58,6 +59,10 @@ GetCropData(Plant *CROP,
 
     FillCropVariables(CROP, Variable);
 
+    for (i = 0; i < NR_TABLES_CRP; i++) {
+        Table[i] = NULL;
+    }
+
     i = 0;
     count = 0;
     while (strcmp(CropParam2[i], "NULL")) {
@@ -72,10 +77,8 @@ GetCropData(Plant *CROP,
                 c = sscanf(line, "%s %s %f %s  %f", word, x, &XValue, xx,
                            &YValue);
 
-                Table[i] = start = malloc(sizeof(TABLE));
-                Table[i]->next = NULL;
-                Table[i]->x = XValue;
-                Table[i]->y = YValue;
+                Table[i] = NewTable();
+                AddTablePoint(Table[i], XValue, YValue);
 
                 while (fgets(line, MAXSTRING, fq)) {
                     if ((c =
@@ -84,14 +87,8 @@ GetCropData(Plant *CROP,
                         break;
                     }
 
-                    Table[i]->next = malloc(sizeof(TABLE));
-                    Table[i] = Table[i]->next;
-                    Table[i]->next = NULL;
-                    Table[i]->x = XValue;
-                    Table[i]->y = YValue;
+                    AddTablePoint(Table[i], XValue, YValue);
                 }
-                /* Go back to beginning of the table */
-                Table[i] = start;
                 count++;
                 break;
             }
@@ -113,12 +110,7 @@ GetCropData(Plant *CROP,
         CROP->prm.VernalizationRate = NULL;
 
         /* Remember to remove table (since it will not be removed at cleanup) */
-        while (Table[0]) {
-            head = Table[0];
-            Table[0] = Table[0]->next;
-            free(head);
-        }
-        free(Table[0]);
+        FreeTable(Table[0]);
     }
     else {
         CROP->prm.VernalizationRate = Table[0];
@@ -146,15 +138,13 @@ GetCropData(Plant *CROP,
     CROP->prm.P_MaxLeaves = Table[20];
     CROP->prm.K_MaxLeaves = Table[21];
 
-    head = CROP->prm.FactorAssimRateTemp;
     XValue = 0;
     YValue = 0;
-    while (head) {
-        if (head->y >= YValue) {
-            XValue = head->x;
-            YValue = head->y;
+    for (j = 0; j < CROP->prm.FactorAssimRateTemp->n; j++) {
+        if (CROP->prm.FactorAssimRateTemp->y[j] >= YValue) {
+            XValue = CROP->prm.FactorAssimRateTemp->x[j];
+            YValue = CROP->prm.FactorAssimRateTemp->y[j];
         }
-        head = head->next;
     }
     CROP->prm.MaxOptimumTemp = XValue;
 
@@ -282,4 +272,7 @@ GetCropData(Plant *CROP,
 
     /* Leaf properties */
     CROP->LeaveProperties = NULL;
+    CROP->LeaveSize = 0;
+    CROP->LeaveStart = 0;
+    CROP->LeaveCount = 0;
 }
@@ -83,12 +83,10 @@ InitializeCrop(SimUnit *Grid)
                         Grid->crp->st.storage * Grid->crp->prm.SpecificPodArea;
 
     /* Initialize the leaves */
-    Grid->crp->LeaveProperties = malloc(sizeof(Green));
-    Grid->crp->LeaveProperties->age = 0.;
-    Grid->crp->LeaveProperties->weight = Grid->crp->st.leaves;
-    Grid->crp->LeaveProperties->area = Afgen(Grid->crp->prm.SpecificLeaveArea,
-                                             &(Grid->crp->st.Development));
-    Grid->crp->LeaveProperties->next = NULL;
+    Harvest(Grid->crp);
+    AddLeaveClass(Grid->crp, Grid->crp->st.leaves, 0.,
+                  Afgen(Grid->crp->prm.SpecificLeaveArea,
+                        &(Grid->crp->st.Development)));
 
     /* Emergence true */
     Grid->crp->Emergence = 1;
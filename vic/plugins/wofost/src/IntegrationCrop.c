@@ -11,7 +11,7 @@ void
 IntegrationCrop(SimUnit *Grid)
 {
     float  PhysAgeing;
-    Green *LeaveProperties;
+    size_t i;
 
     Grid->crp->st.roots += Grid->crp->rt.roots;
     Grid->crp->st.stems += Grid->crp->rt.stems;
@@ -50,15 +50,8 @@ IntegrationCrop(SimUnit *Grid)
             (Grid->met->Temp - Grid->crp->prm.TempBaseLeaves) /
             (35. - Grid->crp->prm.TempBaseLeaves));
 
-    /* Store the initial address */
-    LeaveProperties = Grid->crp->LeaveProperties;
-
-    /* Update the leave age for each age class */
-    while (Grid->crp->LeaveProperties->next) {
-        Grid->crp->LeaveProperties->age += PhysAgeing;
-        Grid->crp->LeaveProperties = Grid->crp->LeaveProperties->next;
+    /* Update the leave age for each age class except the youngest */
+    for (i = 0; i + 1 < Grid->crp->LeaveCount; i++) {
+        LeaveClass(Grid->crp, i)->age += PhysAgeing;
     }
-
-    /* Return to beginning of the linked list */
-    Grid->crp->LeaveProperties = LeaveProperties;
 }
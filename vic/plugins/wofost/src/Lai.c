@@ -9,21 +9,15 @@ float
 LeaveAreaIndex(SimUnit *Grid)
 {
     float  LAISum = 0.;
-    Green *LeaveProperties;
+    Green *Leave;
+    size_t i;
 
-    /* Store the initial address */
-    LeaveProperties = Grid->crp->LeaveProperties;
-
-    /* Loop until the last element in the list */
-    while (Grid->crp->LeaveProperties) {
-        LAISum += Grid->crp->LeaveProperties->weight *
-                  Grid->crp->LeaveProperties->area;
-        Grid->crp->LeaveProperties = Grid->crp->LeaveProperties->next;
+    /* Loop over all leave classes */
+    for (i = 0; i < Grid->crp->LeaveCount; i++) {
+        Leave = LeaveClass(Grid->crp, i);
+        LAISum += Leave->weight * Leave->area;
     }
 
-    /* Return to the initial address */
-    Grid->crp->LeaveProperties = LeaveProperties;
-
     /* Return Green Area Index which will be used as LAI */
     return (LAISum + Grid->crp->st.stems *
             Afgen(Grid->crp->prm.SpecificStemArea,
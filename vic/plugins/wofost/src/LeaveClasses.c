@@ -0,0 +1,66 @@
+#include <vic_driver_image.h>
+#include <plugin.h>
+
+/* ---------------------------------------------------------------------------*/
+/*  function LeaveClass()                                                     */
+/*  Purpose: Get leave class i, counted from the oldest class                 */
+/* ---------------------------------------------------------------------------*/
+
+Green *
+LeaveClass(Plant *CROP,
+           size_t i)
+{
+    return &(CROP->LeaveProperties[(CROP->LeaveStart + i) % CROP->LeaveSize]);
+}
+
+/* ---------------------------------------------------------------------------*/
+/*  function AddLeaveClass()                                                  */
+/*  Purpose: Add a new (youngest) leave class. The ring buffer is doubled     */
+/*           when it is full, so there is no allocation on most days          */
+/* ---------------------------------------------------------------------------*/
+
+void
+AddLeaveClass(Plant *CROP,
+              float  weight,
+              float  age,
+              float  area)
+{
+    Green *Properties;
+    size_t size;
+    size_t i;
+
+    if (CROP->LeaveCount == CROP->LeaveSize) {
+        size = CROP->LeaveSize > 0 ? 2 * CROP->LeaveSize :
+               NR_LEAVE_CLASSES_INIT;
+        Properties = malloc(size * sizeof(*Properties));
+        check_alloc_status(Properties, "Memory allocation error");
+
+        /* Unwrap the classes to the start of the new buffer */
+        for (i = 0; i < CROP->LeaveCount; i++) {
+            Properties[i] = *LeaveClass(CROP, i);
+        }
+
+        free(CROP->LeaveProperties);
+        CROP->LeaveProperties = Properties;
+        CROP->LeaveSize = size;
+        CROP->LeaveStart = 0;
+    }
+
+    i = (CROP->LeaveStart + CROP->LeaveCount) % CROP->LeaveSize;
+    CROP->LeaveProperties[i].weight = weight;
+    CROP->LeaveProperties[i].age = age;
+    CROP->LeaveProperties[i].area = area;
+    CROP->LeaveCount++;
+}
+
+/* ---------------------------------------------------------------------------*/
+/*  function RemoveOldestLeaveClass()                                         */
+/*  Purpose: Remove the oldest leave class                                    */
+/* ---------------------------------------------------------------------------*/
+
+void
+RemoveOldestLeaveClass(Plant *CROP)
+{
+    CROP->LeaveStart = (CROP->LeaveStart + 1) % CROP->LeaveSize;
+    CROP->LeaveCount--;
+}
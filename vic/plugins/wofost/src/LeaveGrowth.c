@@ -4,7 +4,7 @@
 /* ---------------------------------------------------------------------------*/
 /*  function LeaveGrowth(float LAIExp, float NewLeaves)                       */
 /*  Purpose: Calculation of the daily leaves growth rate, the results are     */
-/*           stored in the Grid->crp->properties linked list                       */
+/*           stored in the Grid->crp->LeaveProperties ring buffer             */
 /* ---------------------------------------------------------------------------*/
 
 void
@@ -17,9 +17,6 @@ LeaveGrowth(SimUnit *Grid)
     float  DTeff;
     float  tmp_min;
 
-    Green *Leave = NULL;
-    Green *LeaveProperties = NULL;
-
     /* Specific Leaf area(m2/g), as dependent on NPK stress */
     SpecLeafArea =
         Afgen(Grid->crp->prm.SpecificLeaveArea, &(Grid->crp->st.Development)) *
@@ -56,25 +53,8 @@ LeaveGrowth(SimUnit *Grid)
     }
 
 
-    Leave = malloc(sizeof(Green));
-    Leave->weight = Grid->crp->rt.leaves;
-    Leave->age = 0.;
-    Leave->area = SpecLeafArea;
-    Leave->next = NULL;
-
-    /* Store the start address */
-    LeaveProperties = Grid->crp->LeaveProperties;
-
-    /* Loop until the last element in the list */
-    while (Grid->crp->LeaveProperties->next != NULL) {
-        Grid->crp->LeaveProperties = Grid->crp->LeaveProperties->next;
-    }
-
-    /* Add new element to the list */
-    Grid->crp->LeaveProperties->next = Leave;
-
-    /* Restore the start address */
-    Grid->crp->LeaveProperties = LeaveProperties;
+    /* Add new leave class after the youngest class */
+    AddLeaveClass(Grid->crp, Grid->crp->rt.leaves, 0., SpecLeafArea);
 
     Grid->crp->rt.LAIExp = GrowthExpLAI;
 }
@@ -13,7 +13,7 @@ DyingLeaves(SimUnit *Grid)
     float  tiny = 0.001;
     float  Death, Death1, Death2, DeathStress, DeathAge;
     float  CriticalLAI;
-    Green *wipe;
+    Green *Oldest;
 
     /* Dying rate of leaves due to water stress or high LAI */
     CriticalLAI = Grid->crp->prm.CritLAIFactor /
@@ -36,28 +36,23 @@ DyingLeaves(SimUnit *Grid)
 
     DeathStress = Death;
 
-    if (Grid->crp->LeaveProperties != NULL) {
-        /* Oldest leave classes are at the beginning of the list */
-        while (Death > Grid->crp->LeaveProperties->weight) {
-            Death = Death - Grid->crp->LeaveProperties->weight;
-            wipe = Grid->crp->LeaveProperties;
-            Grid->crp->LeaveProperties = Grid->crp->LeaveProperties->next;
-            free(wipe);
-        }
+    /* Oldest leave classes are at the beginning of the ring buffer */
+    while (Grid->crp->LeaveCount > 0 &&
+           Death > LeaveClass(Grid->crp, 0)->weight) {
+        Death = Death - LeaveClass(Grid->crp, 0)->weight;
+        RemoveOldestLeaveClass(Grid->crp);
     }
 
 
     DeathAge = 0; // Amount of death leaves due to ageing
-    if (Grid->crp->LeaveProperties != NULL) {
-        Grid->crp->LeaveProperties->weight =
-            Grid->crp->LeaveProperties->weight - Death;
-
-        while (Grid->crp->LeaveProperties != NULL &&
-               Grid->crp->LeaveProperties->age > Grid->crp->prm.LifeSpan) {
-            wipe = Grid->crp->LeaveProperties;
-            DeathAge += Grid->crp->LeaveProperties->weight;
-            Grid->crp->LeaveProperties = Grid->crp->LeaveProperties->next;
-            free(wipe);
+    if (Grid->crp->LeaveCount > 0) {
+        Oldest = LeaveClass(Grid->crp, 0);
+        Oldest->weight = Oldest->weight - Death;
+
+        while (Grid->crp->LeaveCount > 0 &&
+               LeaveClass(Grid->crp, 0)->age > Grid->crp->prm.LifeSpan) {
+            DeathAge += LeaveClass(Grid->crp, 0)->weight;
+            RemoveOldestLeaveClass(Grid->crp);
         }
     }
 
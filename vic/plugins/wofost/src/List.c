@@ -1,6 +1,20 @@
 #include <vic_driver_image.h>
 #include <plugin.h>
 
+/* ---------------------------------------------------------------------------*/
+/*  function ListIndex()                                                      */
+/*  Purpose: Get the calendar day index of a date in a user provided input    */
+/*           table. Every month has 31 days, so the index does not depend on  */
+/*           the calendar or on leap years                                    */
+/* ---------------------------------------------------------------------------*/
+
+size_t
+ListIndex(int month,
+          int day)
+{
+    return (size_t)((month - 1) * 31 + day - 1);
+}
+
 /* ---------------------------------------------------------------------------*/
 /*  function List()                                                           */
 /*  Purpose: Get the value of a user provided input table                     */
@@ -12,15 +26,11 @@ List(TABLE_D *Table)
     extern dmy_struct *dmy;
     extern size_t      current;
 
-    while (Table) {
-        if (dmy[current].month == Table->month &&
-            dmy[current].day == Table->day) {
-            return Table->amount;
-        }
-        Table = Table->next;
+    if (Table == NULL) {
+        return 0.;
     }
 
-    return 0.;
+    return Table->amount[ListIndex(dmy[current].month, dmy[current].day)];
 }
 
 float
@@ -32,18 +42,15 @@ List_cumsum(TABLE_D *Table,
 
     size_t             i;
 
-    TABLE_D           *start = Table;
     float              total = 0.;
 
+    if (Table == NULL) {
+        return 0.;
+    }
+
     for (i = 0; i < n; i++) {
-        Table = start;
-        while (Table) {
-            if (dmy[current - i].month == Table->month &&
-                dmy[current - i].day == Table->day) {
-                total += Table->amount;
-            }
-            Table = Table->next;
-        }
+        total += Table->amount[ListIndex(dmy[current - i].month,
+                                         dmy[current - i].day)];
     }
 
     return total;
@@ -8,10 +8,11 @@ GetManagement(Management *MNG,
     extern char *ManageParam[];
     extern char *ManageParam2[];
 
-    TABLE_D     *Table[NR_TABLES_MANAGEMENT], *start;
+    TABLE_D     *Table[NR_TABLES_MANAGEMENT];
 
     char         line[MAXSTRING];
-    int          i, c, count;
+    int          i, c, count, month, day;
+    size_t       j;
     float        Variable[100], YValue;
     char         x[2], word[100];
     char         dateString[7];
@@ -52,6 +53,15 @@ GetManagement(Management *MNG,
     FillManageVariables(MNG, Variable);
 
 
+    /* Tables are indexed by calendar day; days without an entry get zero */
+    for (i = 0; i < NR_TABLES_MANAGEMENT; i++) {
+        Table[i] = malloc(sizeof(*Table[i]));
+        check_alloc_status(Table[i], "Memory allocation error");
+        for (j = 0; j < NR_DAYS_LIST; j++) {
+            Table[i]->amount[j] = 0.;
+        }
+    }
+
     i = 0;
     count = 0;
     while (strcmp(ManageParam2[i], "NULL")) {
@@ -68,10 +78,9 @@ GetManagement(Management *MNG,
                     exit(0);
                 }
 
-                Table[i] = start = malloc(sizeof(TABLE_D));
-                Table[i]->next = NULL;
-                sscanf(dateString, "%d-%d", &Table[i]->month, &Table[i]->day);
-                Table[i]->amount = YValue;
+                month = day = 0;
+                sscanf(dateString, "%d-%d", &month, &day);
+                SetListAmount(Table[i], month, day, YValue, management);
 
                 while (fgets(line, MAXSTRING, fq)) {
                     memset(dateString, '\0', 7);
@@ -82,15 +91,10 @@ GetManagement(Management *MNG,
                         exit(0);
                     }
 
-                    Table[i]->next = malloc(sizeof(TABLE_D));
-                    Table[i] = Table[i]->next;
-                    Table[i]->next = NULL;
-                    sscanf(dateString, "%d-%d", &Table[i]->month,
-                           &Table[i]->day);
-                    Table[i]->amount = YValue;
+                    month = day = 0;
+                    sscanf(dateString, "%d-%d", &month, &day);
+                    SetListAmount(Table[i], month, day, YValue, management);
                 }
-                /* Go back to beginning of the table */
-                Table[i] = start;
                 count++;
                 break;
             }
@@ -110,3 +114,24 @@ GetManagement(Management *MNG,
     MNG->K_Fert_table = Table[2];
     MNG->Irrigation = Table[3];
 }
+
+/* ---------------------------------------------------------------------------*/
+/*  function SetListAmount()                                                  */
+/*  Purpose: Add the amount of a date to a management table. Amounts of       */
+/*           repeated dates are summed                                        */
+/* ---------------------------------------------------------------------------*/
+
+void
+SetListAmount(TABLE_D *Table,
+              int      month,
+              int      day,
+              float    amount,
+              char    *management)
+{
+    if (month < 1 || month > MONTHS_PER_YEAR || day < 1 || day > 31) {
+        log_err("Check the management input file %s: invalid date %d-%d",
+                management, month, day);
+    }
+
+    Table->amount[ListIndex(month, day)] += amount;
+}
@@ -61,11 +61,17 @@
 #define ERROR        -999      /**< Error Flag returned by subroutines */
 
 /***** Define maximum array sizes for model source code *****/
+/* MAX_NODES and MAX_LAKE_NODES size the node arrays of every tile and can be
+   set at compile time (e.g. make MAX_NODES=10) to match the model setup */
 #define MAX_LAYERS      3      /**< maximum number of soil moisture layers */
+#ifndef MAX_NODES
 #define MAX_NODES       50     /**< maximum number of soil thermal nodes */
+#endif
 #define MAX_FRONTS      3      /**< maximum number of freezing and thawing front depths to store */
 #define MAX_FROST_AREAS 10     /**< maximum number of frost sub-areas */
+#ifndef MAX_LAKE_NODES
 #define MAX_LAKE_NODES  20     /**< maximum number of lake thermal nodes */
+#endif
 #define MAX_ZWTVMOIST   11     /**< maximum number of points in water table vs moisture curve for each soil layer; should include points at lower and upper boundaries of the layer */
 #define MAX_FORCE_FILES 15
 
@@ -106,6 +112,25 @@ enum
     DENS_SNTHRM
 };
 
+/******************************************************************************
+ * @brief   Integration methods for the blowing snow suspension layer
+ *****************************************************************************/
+enum
+{
+    BLOWING_ROMBERG,
+    BLOWING_GAUSS_LEGENDRE,
+    BLOWING_TABLE
+};
+
+/******************************************************************************
+ * @brief   Jacobian of the implicit soil temperature solution
+ *****************************************************************************/
+enum
+{
+    JACOBIAN_FINITE_DIFF,
+    JACOBIAN_ANALYTIC
+};
+
 /******************************************************************************
  * @brief   Baseflow parametrizations
  *****************************************************************************/
@@ -201,6 +226,13 @@ typedef struct {
     bool BLOWING_SIMPLE;
     bool BLOWING_FETCH;
     bool BLOWING_SPATIAL_WIND;
+    unsigned short int BLOWING_INTEGRATION; /**< BLOWING_ROMBERG: adaptive
+                                               Romberg integration;
+                                               BLOWING_GAUSS_LEGENDRE:
+                                               fixed-order Gauss-Legendre
+                                               quadrature;
+                                               BLOWING_TABLE: interpolation
+                                               in a precomputed table */
     bool CARBON;         /**< TRUE = simulate carbon cycling processes;
                             FALSE = no carbon cycling (default) */
     bool CLOSE_ENERGY;   /**< TRUE = all energy balance calculations are
@@ -225,6 +257,8 @@ typedef struct {
                                           "GF_410"  = use formulas from VIC 4.1.0 */
     bool IMPLICIT;       /**< TRUE = Use implicit solution when computing
                             soil thermal fluxes */
+    unsigned short int IMPLICIT_JACOBIAN; /**< JACOBIAN_FINITE_DIFF = forward difference Jacobian (default)
+                                             JACOBIAN_ANALYTIC = analytic tridiagonal Jacobian */
     bool JULY_TAVG_SUPPLIED; /**< If TRUE and COMPUTE_TREELINE is also true,
                                 then average July air temperature will be read
                                 from soil file and used in calculating treeline */
@@ -287,6 +321,9 @@ typedef struct {
                                           FROM_VEGPARAM = use albedo values from the veg param file */
     bool LAKE_PROFILE;   /**< TRUE = user-specified lake/area profile */
     bool ORGANIC_FRACT;  /**< TRUE = organic matter fraction of each layer is read from the soil parameter file; otherwise set to 0.0. */
+    unsigned short int FORCE_READER;   /**< FORCE_READ_ROOT = read forcings on the master node and scatter them (default)
+                                          FORCE_READ_PARALLEL = read forcings collectively on all nodes with parallel netCDF */
+    size_t FORCE_PREFETCH;   /**< Number of model steps read ahead per forcing window in a background thread (0 = no prefetching) */
 
     // state options
     unsigned short int STATE_FORMAT;  /**< TRUE = model state file is binary (default) */
@@ -295,6 +332,8 @@ typedef struct {
 
     // output options
     size_t Noutstreams;  /**< Number of output stream */
+    bool OUTPUT_ASYNC;   /**< TRUE = history files are written in a background thread */
+    bool OUTPUT_ON_DEMAND; /**< TRUE = only compute the output variables that are written */
 } option_struct;
 
 /******************************************************************************
@@ -336,6 +375,12 @@ typedef struct {
     unsigned int statesec;          /**< Seconds since midnight at which to save state */
     unsigned short int stateyear;  /**< Year of the simulation at which to save
                                       model state */
+    unsigned short int snapshot_freq;  /**< Frequency of model state
+                                          snapshots (FREQ_NEVER = none) */
+    int snapshot_n;                /**< Number of snapshot_freq units between
+                                      snapshots */
+    size_t snapshot_keep;          /**< Number of most recent snapshots to
+                                      keep */
     unsigned short int calendar;  /**< Date/time calendar */
     unsigned short int time_units;  /**< Units for numeric times */
     double time_origin_num;        /**< Numeric date origin */
@@ -544,6 +589,7 @@ typedef struct {
     int ROOT_BRENT_MAXITER;
     double ROOT_BRENT_TSTEP;
     double ROOT_BRENT_T;
+    double ROOT_BRENT_WARM_DT;
 } parameters_struct;
 
 /******************************************************************************
@@ -1125,4 +1171,364 @@ typedef struct {
     gridcell_avg_struct gridcell_avg;   /**< Stores gridcell average variables */
 } all_vars_struct;
 
+/******************************************************************************
+ * @brief   This structure stores the terms of the soil thermal equation for a
+ *          single node, solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    double TL;                    /**< temperature of the node below (C) */
+    double TU;                    /**< temperature of the node above (C) */
+    double T0;                    /**< node temperature of the previous time step (C) */
+    double moist;                 /**< node moisture content (mm/mm) */
+    double max_moist;             /**< node maximum moisture content (mm/mm) */
+    double bubble;                /**< node bubbling pressure (cm) */
+    double expt;                  /**< node exponent in Campbell's eqn */
+    double ice0;                  /**< node ice content of the previous time step (mm/mm) */
+    double A;                     /**< storage term coefficient */
+    double B;                     /**< flux term 1 coefficient */
+    double C;                     /**< flux term 2a coefficient */
+    double D;                     /**< flux term 2b coefficient */
+    double E;                     /**< phase term coefficient */
+    int EXP_TRANS;                /**< exponential node distribution flag */
+    int node;                     /**< node index */
+} soil_thermal_eqn_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the inputs and workspace of the implicit
+ *          soil heat equation residual (fda_heat_eqn), solved by newt_raph.
+ *****************************************************************************/
+typedef struct {
+    double deltat;                /**< time step (s) */
+    int NOFLUX;                   /**< no flux lower boundary flag */
+    int EXP_TRANS;                /**< exponential node distribution flag */
+    double *T0;                   /**< node temperatures of the previous time step (C) */
+    double *moist;                /**< node moisture content */
+    double *ice;                  /**< node ice content of the previous time step */
+    double *kappa;                /**< node thermal conductivity (W/m/K) */
+    double *Cs;                   /**< node heat capacity (J/m^3/K) */
+    double *max_moist;            /**< node maximum moisture content */
+    double *bubble;               /**< node bubbling pressure (cm) */
+    double *expt;                 /**< node exponent in Campbell's eqn */
+    double *alpha;                /**< thermal solution constant */
+    double *beta;                 /**< thermal solution constant */
+    double *gamma;                /**< thermal solution constant */
+    double *Zsum;                 /**< node depth (m) */
+    double Dp;                    /**< damping depth (m) */
+    double *bulk_dens_min;        /**< layer mineral bulk density (kg/m^3) */
+    double *soil_dens_min;        /**< layer mineral soil density (kg/m^3) */
+    double *quartz;               /**< layer quartz content */
+    double *bulk_density;         /**< layer bulk density (kg/m^3) */
+    double *soil_density;         /**< layer soil density (kg/m^3) */
+    double *organic;              /**< layer organic fraction */
+    double *depth;                /**< layer depth (m) */
+    size_t Nlayers;               /**< number of soil layers */
+    double Ts;                    /**< surface boundary temperature (C) */
+    double Tb;                    /**< bottom boundary temperature (C) */
+    double Bexp;                  /**< exponential grid transformation constant */
+    double ice_new[MAX_NODES];    /**< node ice content */
+    double Cs_new[MAX_NODES];     /**< node heat capacity */
+    double kappa_new[MAX_NODES];  /**< node thermal conductivity */
+    double DT[MAX_NODES];         /**< temperature difference across node */
+    double DT_down[MAX_NODES];    /**< temperature difference below node */
+    double DT_up[MAX_NODES];      /**< temperature difference above node */
+    double Dkappa[MAX_NODES];     /**< conductivity difference across node */
+} fda_heat_eqn_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the soil thermal solver state of one call to
+ *          calc_surf_energy_bal, so that the solvers keep no hidden state.
+ *****************************************************************************/
+typedef struct {
+    int FIRST_SOLN[2];            /**< recompute solver coefficients flags */
+    double A[MAX_NODES];          /**< explicit scheme storage coefficients */
+    double B[MAX_NODES];          /**< explicit scheme flux 1 coefficients */
+    double C[MAX_NODES];          /**< explicit scheme flux 2a coefficients */
+    double D[MAX_NODES];          /**< explicit scheme flux 2b coefficients */
+    double E[MAX_NODES];          /**< explicit scheme phase coefficients */
+    fda_heat_eqn_struct heat_eqn; /**< implicit scheme state */
+} soil_thermal_solver_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the parameters of the blowing snow height
+ *          profiles integrated by qromb or gauss_legendre.
+ *****************************************************************************/
+typedef struct {
+    double es;                    /**< saturated vapor pressure (Pa) */
+    double Wind;                  /**< wind speed (m/s) */
+    double AirDens;               /**< air density (kg/m^3) */
+    double ZO;                    /**< saltation roughness length (m) */
+    double EactAir;               /**< actual vapor pressure (Pa) */
+    double F;                     /**< thermodynamic term */
+    double hsalt;                 /**< saltation layer height (m) */
+    double phi_r;                 /**< saltation layer mass concentration (kg/m^3) */
+    double ushear;                /**< shear velocity (m/s) */
+    double Zrh;                   /**< humidity measurement height (m) */
+} blowing_profile_struct;
+
+#define BLOWING_GAUSS_ORDER 16      /**< nodes of the Gauss-Legendre rule */
+#define BLOWING_TABLE_NWIND 96      /**< wind speeds in the table */
+#define BLOWING_TABLE_NSHEAR 96     /**< shear velocities in the table */
+#define BLOWING_TABLE_WIND_MIN 0.4  /**< smallest tabulated 10 m wind (m/s) */
+#define BLOWING_TABLE_WIND_MAX 25.  /**< largest tabulated 10 m wind (m/s) */
+#define BLOWING_TABLE_SHEAR_MIN 0.05 /**< smallest tabulated shear (m/s) */
+#define BLOWING_TABLE_SHEAR_MAX 10. /**< largest tabulated shear (m/s) */
+
+/******************************************************************************
+ * @brief   This structure stores the blowing snow suspension layer integrals
+ *          on a grid of log(wind speed) and log(shear velocity).
+ * @details With the profile of blowing_profile_struct, the suspension layer
+ *          integrals from hsalt to ztop only depend on the wind speed and the
+ *          shear velocity once the factors phi_r, EactAir / es - 1 and F are
+ *          taken out. The log of the integrals is stored.
+ *****************************************************************************/
+typedef struct {
+    double sub[BLOWING_TABLE_NWIND][BLOWING_TABLE_NSHEAR];  /**< sublimation */
+    double conc[BLOWING_TABLE_NWIND][BLOWING_TABLE_NSHEAR]; /**< concentration */
+    double conc_log[BLOWING_TABLE_NWIND][BLOWING_TABLE_NSHEAR]; /**< idem, times
+                                                                   log(z / hsalt) */
+} blowing_table_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the arguments of the soil surface energy
+ *          balance (func_surf_energy_bal), solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    int VEG;                      /**< vegetation flag */
+    double delta_t;               /**< time step (s) */
+    double Cs1;                   /**< soil layer 1 heat capacity (J/m^3/K) */
+    double Cs2;                   /**< soil layer 2 heat capacity (J/m^3/K) */
+    double D1;                    /**< soil layer 1 thickness (m) */
+    double D2;                    /**< soil layer 2 thickness (m) */
+    double T1_old;                /**< layer 1 temperature of the previous time step (C) */
+    double T2;                    /**< temperature at the damping depth (C) */
+    double Ts_old;                /**< surface temperature of the previous time step (C) */
+    double *Told_node;            /**< node temperatures of the previous time step (C) */
+    double bubble;                /**< bubbling pressure (cm) */
+    double dp;                    /**< damping depth (m) */
+    double expt;                  /**< exponent in Campbell's eqn */
+    double ice0;                  /**< layer 1 ice content (mm/mm) */
+    double kappa1;                /**< layer 1 thermal conductivity (W/m/K) */
+    double kappa2;                /**< layer 2 thermal conductivity (W/m/K) */
+    double max_moist;             /**< layer 1 maximum moisture content (mm/mm) */
+    double moist;                 /**< layer 1 moisture content (mm/mm) */
+    double *root;                 /**< root fractions */
+    double *CanopLayerBnd;        /**< canopy layer boundaries */
+    int UnderStory;               /**< understory flag */
+    int overstory;                /**< overstory flag */
+    double NetShortBare;          /**< net SW that reaches bare ground (W/m2) */
+    double NetShortGrnd;          /**< net SW that penetrates snowpack (W/m2) */
+    double NetShortSnow;          /**< net SW that reaches snow surface (W/m2) */
+    double Tair;                  /**< temperature of canopy air or atmosphere (C) */
+    double atmos_density;         /**< air density (kg/m3) */
+    double atmos_pressure;        /**< air pressure (Pa) */
+    double emissivity;            /**< surface emissivity */
+    double LongBareIn;            /**< incoming LW to snow-free surface (W/m2) */
+    double LongSnowIn;            /**< incoming LW to snow surface - if INCLUDE_SNOW (W/m2) */
+    double surf_atten;            /**< shortwave attenuation by canopy */
+    double vp;                    /**< vapor pressure (Pa) */
+    double vpd;                   /**< vapor pressure deficit (Pa) */
+    double shortwave;             /**< incoming shortwave (W/m2) */
+    double Catm;                  /**< atmospheric CO2 mixing ratio */
+    double *dryFrac;              /**< fraction of canopy that is dry */
+    double *Wdew;                 /**< canopy interception (mm) */
+    double *displacement;         /**< displacement heights (m) */
+    double *ra;                   /**< aerodynamic resistances (s/m) */
+    double *Ra_veg;               /**< vegetation aerodynamic resistances (s/m) */
+    double *Ra_used;              /**< aerodynamic resistances after stability correction (s/m) */
+    double rainfall;              /**< rainfall (mm) */
+    double *ref_height;           /**< reference heights (m) */
+    double *roughness;            /**< roughness lengths (m) */
+    double *wind;                 /**< wind speeds (m/s) */
+    double Le;                    /**< latent heat of vaporization (J/kg) */
+    double Advection;             /**< advected energy (W/m2) */
+    double OldTSurf;              /**< snow surface temperature of the previous time step (C) */
+    double Tsnow_surf;            /**< snow surface temperature (C) */
+    double kappa_snow;            /**< snow conductance / depth */
+    double melt_energy;           /**< energy consumed in reducing the snowpack coverage (W/m2) */
+    double snow_coverage;         /**< snowpack coverage fraction */
+    double snow_density;          /**< snow density (kg/m3) */
+    double snow_swq;              /**< snow water equivalent (m) */
+    double snow_water;            /**< snow surface liquid water (m) */
+    double *deltaCC;              /**< change in snow cold content (W/m2) */
+    double *refreeze_energy;      /**< snow refreeze energy (W/m2) */
+    double *vapor_flux;           /**< snow vapor flux (m/timestep) */
+    double *blowing_flux;         /**< blowing snow vapor flux (m/timestep) */
+    double *surface_flux;         /**< snow surface vapor flux (m/timestep) */
+    int Nnodes;                   /**< number of soil thermal nodes solved */
+    double *Cs_node;              /**< node heat capacities (J/m^3/K) */
+    double *T_node;               /**< node temperatures (C) */
+    double *Tnew_node;            /**< new node temperatures (C) */
+    char *Tnew_fbflag;            /**< node temperature fallback flags */
+    unsigned *Tnew_fbcount;       /**< node temperature fallback counts */
+    double *alpha;                /**< thermal solution constants */
+    double *beta;                 /**< thermal solution constants */
+    double *bubble_node;          /**< node bubbling pressures (cm) */
+    double *Zsum_node;            /**< node depths (m) */
+    double *expt_node;            /**< node exponents in Campbell's eqn */
+    double *gamma;                /**< thermal solution constants */
+    double *ice_node;             /**< node ice contents (mm/mm) */
+    double *kappa_node;           /**< node thermal conductivities (W/m/K) */
+    double *max_moist_node;       /**< node maximum moisture contents (mm/mm) */
+    double *moist_node;           /**< node moisture contents (mm/mm) */
+    soil_con_struct *soil_con;    /**< soil parameters */
+    layer_data_struct *layer;     /**< soil layer variables */
+    veg_var_struct *veg_var;      /**< vegetation variables */
+    veg_lib_struct *veg_lib;      /**< vegetation library */
+    int INCLUDE_SNOW;             /**< snowpack included in solution flag */
+    int NOFLUX;                   /**< no flux lower boundary flag */
+    int EXP_TRANS;                /**< exponential node distribution flag */
+    int SNOWING;                  /**< snowpack present flag */
+    soil_thermal_solver_struct *soil_solver;/**< soil thermal solver state */
+    double *NetLongBare;          /**< net LW from snow-free ground (W/m2) */
+    double *NetLongSnow;          /**< net LW from snow surface - if INCLUDE_SNOW (W/m2) */
+    double *T1;                   /**< layer 1 temperature (C) */
+    double *deltaH;               /**< change in surface heat storage (W/m2) */
+    double *fusion;               /**< latent heat of soil ice phase change (W/m2) */
+    double *grnd_flux;            /**< ground heat flux (W/m2) */
+    double *latent_heat;          /**< latent heat flux (W/m2) */
+    double *latent_heat_sub;      /**< sublimation heat flux (W/m2) */
+    double *sensible_heat;        /**< sensible heat flux (W/m2) */
+    double *snow_flux;            /**< heat flux through the snowpack (W/m2) */
+    double *store_error;          /**< energy balance error (W/m2) */
+} surf_energy_bal_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the arguments of the canopy energy balance
+ *          (func_canopy_energy_bal), solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    double delta_t;               /**< time step (s) */
+    double elevation;             /**< elevation (m) */
+    double *Wmax;                 /**< layer maximum moisture contents (mm) */
+    double *Wcr;                  /**< layer critical moisture contents (mm) */
+    double *Wpwp;                 /**< layer wilting point moisture contents (mm) */
+    double *frost_fract;          /**< spatial frost fractions */
+    double AirDens;               /**< air density (kg/m3) */
+    double EactAir;               /**< actual vapor pressure of air (Pa) */
+    double Press;                 /**< air pressure (Pa) */
+    double Le;                    /**< latent heat of vaporization (J/kg) */
+    double Tcanopy;               /**< canopy air temperature (C) */
+    double Vpd;                   /**< vapor pressure deficit (Pa) */
+    double shortwave;             /**< incoming shortwave (W/m2) */
+    double Catm;                  /**< atmospheric CO2 mixing ratio */
+    double *dryFrac;              /**< fraction of canopy that is dry */
+    double *Evap;                 /**< canopy evaporation (mm) */
+    double *Ra;                   /**< aerodynamic resistances (s/m) */
+    double *Ra_used;              /**< aerodynamic resistances after stability correction (s/m) */
+    double Rainfall;              /**< rainfall (m) */
+    double *Wind;                 /**< wind speeds (m/s) */
+    double *displacement;         /**< displacement heights (m) */
+    double *ref_height;           /**< reference heights (m) */
+    double *roughness;            /**< roughness lengths (m) */
+    double *root;                 /**< root fractions */
+    double *CanopLayerBnd;        /**< canopy layer boundaries */
+    double IntRain;               /**< intercepted rain (m) */
+    double IntSnow;               /**< intercepted snow (m) */
+    double *Wdew;                 /**< canopy interception (mm) */
+    layer_data_struct *layer;     /**< soil layer variables */
+    veg_var_struct *veg_var;      /**< vegetation variables */
+    veg_lib_struct *veg_lib;      /**< vegetation library */
+    double LongOverIn;            /**< incoming LW to the overstory (W/m2) */
+    double LongUnderOut;          /**< outgoing LW from the understory (W/m2) */
+    double NetShortOver;          /**< net SW absorbed by the overstory (W/m2) */
+    double *AdvectedEnergy;       /**< energy advected by precipitation (W/m2) */
+    double *LatentHeat;           /**< latent heat flux (W/m2) */
+    double *LatentHeatSub;        /**< sublimation heat flux (W/m2) */
+    double *LongOverOut;          /**< outgoing LW from the overstory (W/m2) */
+    double *NetLongOver;          /**< net LW at the overstory (W/m2) */
+    double *NetRadiation;         /**< net radiation at the overstory (W/m2) */
+    double *RefreezeEnergy;       /**< refreeze energy (W/m2) */
+    double *SensibleHeat;         /**< sensible heat flux (W/m2) */
+    double *VaporMassFlux;        /**< intercepted snow vapor flux (kg/m2s) */
+} canopy_energy_bal_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the arguments of the canopy air energy
+ *          balance (func_atmos_energy_bal), solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    double Ra;                    /**< aerodynamic resistance (s/m) */
+    double Tair;                  /**< air temperature (C) */
+    double atmos_density;         /**< air density (kg/m3) */
+    double InSensible;            /**< incoming sensible heat (W/m2) */
+    double *SensibleHeat;         /**< sensible heat flux (W/m2) */
+} atmos_energy_bal_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the arguments of the snowpack surface
+ *          energy balance (SnowPackEnergyBalance), solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    double Dt;                    /**< model time step (sec) */
+    double Ra;                    /**< aerodynamic resistance (s/m) */
+    double *Ra_used;              /**< aerodynamic resistance (s/m) after stability correction */
+    double Z;                     /**< reference height (m) */
+    double *Z0;                   /**< surface roughness height (m) */
+    double AirDens;               /**< density of air (kg/m3) */
+    double EactAir;               /**< actual vapor pressure of air (Pa) */
+    double LongSnowIn;            /**< incoming longwave radiation (W/m2) */
+    double Lv;                    /**< latent heat of vaporization (J/kg3) */
+    double Press;                 /**< air pressure (Pa) */
+    double Rain;                  /**< rain fall (m/timestep) */
+    double NetShortUnder;         /**< net incident shortwave radiation (W/m2) */
+    double Vpd;                   /**< vapor pressure deficit (Pa) */
+    double Wind;                  /**< wind speed (m/s) */
+    double OldTSurf;              /**< surface temperature during previous time step */
+    double SnowCoverFract;        /**< fraction of area covered by snow */
+    double SnowDepth;             /**< depth of snowpack (m) */
+    double SnowDensity;           /**< density of snowpack (kg/m^3) */
+    double SurfaceLiquidWater;    /**< liquid water in the surface layer (m) */
+    double SweSurfaceLayer;       /**< snow water equivalent in surface layer (m) */
+    double Tair;                  /**< canopy air / Air temperature (C) */
+    double TGrnd;                 /**< ground surface temperature (C) */
+    double *AdvectedEnergy;       /**< energy advected by precipitation (W/m2) */
+    double *AdvectedSensibleHeat; /**< sensible heat advected from snow-free area into snow covered area (W/m^2) */
+    double *DeltaColdContent;     /**< change in cold content of surface layer (W/m2) */
+    double *GroundFlux;           /**< ground Heat Flux (W/m2) */
+    double *LatentHeat;           /**< latent heat exchange at surface (W/m2) */
+    double *LatentHeatSub;        /**< latent heat of sublimation exchange at surface (W/m2) */
+    double *NetLongUnder;         /**< net longwave radiation at snowpack surface (W/m^2) */
+    double *RefreezeEnergy;       /**< refreeze energy (W/m2) */
+    double *SensibleHeat;         /**< sensible heat exchange at surface (W/m2) */
+    double *vapor_flux;           /**< mass flux of water vapor to or from the intercepted snow (m/timestep) */
+    double *blowing_flux;         /**< mass flux of water vapor from blowing snow. (m/timestep) */
+    double *surface_flux;         /**< mass flux of water vapor from pack snow. (m/timestep) */
+} snow_pack_energy_bal_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the arguments of the lake ice surface
+ *          energy balance (IceEnergyBalance), solved by root_brent.
+ *****************************************************************************/
+typedef struct {
+    double Dt;                    /**< model time step (seconds) */
+    double Ra;                    /**< aerodynamic resistance (s/m) */
+    double *Ra_used;              /**< aerodynamic resistance (s/m) after stability correction */
+    double Z;                     /**< reference height (m) */
+    double Z0;                    /**< surface roughness height (m) */
+    double Wind;                  /**< wind speed (m/s) */
+    double ShortRad;              /**< net incident shortwave radiation (W/m2) */
+    double LongRadIn;             /**< incoming longwave radiation (W/m2) */
+    double AirDens;               /**< density of air (kg/m3) */
+    double Lv;                    /**< latent heat of vaporization (J/kg3) */
+    double Tair;                  /**< air temperature (C) */
+    double Press;                 /**< air pressure (Pa) */
+    double Vpd;                   /**< vapor pressure deficit (Pa) */
+    double EactAir;               /**< actual vapor pressure of air (Pa) */
+    double Rain;                  /**< rain fall (m/timestep) */
+    double SurfaceLiquidWater;    /**< liquid water in the surface layer (m) */
+    double *RefreezeEnergy;       /**< refreeze energy (W/m2) */
+    double *vapor_flux;           /**< total mass flux of water vapor to or from snow (m/timestep) */
+    double *blowing_flux;         /**< mass flux of water vapor to or from blowing snow (m/timestep) */
+    double *surface_flux;         /**< mass flux of water vapor to or from snow pack (m/timestep) */
+    double *AdvectedEnergy;       /**< energy advected by precipitation (W/m2) */
+    double Tfreeze;               /**< lake ice freezing temperature (C) */
+    double AvgCond;               /**< average ice conductance (W/m2/K) */
+    double SWconducted;           /**< shortwave conducted through the ice (W/m2) */
+    double *qf;                   /**< ground Heat Flux (W/m2) */
+    double *LatentHeat;           /**< latent heat exchange at surface (W/m2) */
+    double *LatentHeatSub;        /**< latent heat exchange at surface (W/m2) due to sublimation */
+    double *SensibleHeat;         /**< sensible heat exchange at surface (W/m2) */
+    double *LongRadOut;           /**< net LW at the ice surface (W/m2) */
+} ice_pack_energy_bal_struct;
+
 #endif
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Fast approximation of exp for the optional fast-math physics mode.
+ *
+ * When compiled with VIC_FAST_MATH (make FAST_MATH=TRUE), vic_exp is the
+ * polynomial approximation below instead of the C library exp, which is used
+ * in the saturated vapor pressure (svp, svp_slope and svp_array). Otherwise
+ * vic_exp is exp. fast_exp is inline and free of branches and integer
+ * conversions, so that loops over arrays can be vectorized (see svp_array).
+ *
+ * The relative error of fast_exp is below FAST_EXP_REL_ERROR for
+ * -708 < x < 709. The speedup and the deviation in the resulting fluxes are
+ * quantified by tests/profiling/run_fast_math_benchmark.bash.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VIC_FAST_MATH_H
+#define VIC_FAST_MATH_H
+
+#include <math.h>
+#include <stdint.h>
+
+#define FAST_EXP_REL_ERROR 1e-8    /**< relative error bound of fast_exp */
+
+#define FAST_MATH_LN2_HI   6.93147180369123816490e-01 /**< ln(2), high part */
+#define FAST_MATH_LN2_LO   1.90821492927058770002e-10 /**< ln(2), low part */
+#define FAST_MATH_LOG2E    1.44269504088896340736     /**< 1 / ln(2) */
+#define FAST_MATH_ROUND    6755399441055744.0         /**< 1.5 2^52 */
+
+/******************************************************************************
+ * @brief    Fast exponential
+ * @details  x = k ln(2) + r with |r| <= ln(2) / 2, exp(r) by a degree 7
+ *           Taylor polynomial and 2^k set in the exponent bits.
+ *****************************************************************************/
+inline double
+fast_exp(double x)
+{
+    union {
+        double d;
+        uint64_t i;
+    }      shifted;
+    union {
+        double d;
+        uint64_t i;
+    }      scale;
+    double k;
+    double r;
+    double p;
+
+    x = x > 709. ? 709. : x;
+    x = x < -708. ? -708. : x;
+
+    // k = round(x / ln(2)) ends up in the low bits of shifted.i; no conversion
+    // between double and integer, so that loops can be vectorized
+    shifted.d = x * FAST_MATH_LOG2E + FAST_MATH_ROUND;
+    k = shifted.d - FAST_MATH_ROUND;
+    r = (x - k * FAST_MATH_LN2_HI) - k * FAST_MATH_LN2_LO;
+
+    p = 1. + r * (1. + r * (1. / 2. + r * (1. / 6. + r * (1. / 24. + r *
+                                                         (1. / 120. + r *
+                                                          (1. / 720. + r /
+                                                           5040.))))));
+
+    scale.i = (shifted.i + 1023) << 52;
+
+    return p * scale.d;
+}
+
+#ifdef VIC_FAST_MATH
+#define vic_exp fast_exp
+#else
+#define vic_exp exp
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Hierarchical performance instrumentation.
+ *
+ * A region is timed by INSTRUMENT_BEGIN(region) ... INSTRUMENT_END(region).
+ * Regions can be nested. Every thread keeps its own stack of open regions and
+ * its own counters, which are indexed by the enclosing (parent) region and the
+ * region itself, so that no locking or atomics are needed and the call
+ * hierarchy is preserved. Both inclusive and exclusive (self) times are kept.
+ * Times are taken from the monotonic clock.
+ *
+ * The macros are empty unless VIC is compiled with VIC_INSTRUMENT
+ * (make INSTRUMENT=TRUE). The counters of all threads and all nodes are
+ * reported in the timing table at the end of the run and, optionally, in a
+ * CSV file (see TIMING_REPORT in the global parameter file).
+ *
+ * OpenMP threads use the counters of their thread number. Other threads have
+ * to call instrument_set_thread() with one of the instrument_threads codes
+ * before their first region.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VIC_INSTRUMENT_H
+#define VIC_INSTRUMENT_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define INSTRUMENT_MAX_DEPTH 16    /**< maximum nesting depth of regions */
+#define INSTRUMENT_TOP N_INSTR_REGIONS /**< parent code of top level regions */
+
+/******************************************************************************
+ * @brief   Codes for instrumented regions
+ *****************************************************************************/
+enum instrument_regions
+{
+    INSTR_FORCE,
+    INSTR_VIC_RUN,
+    INSTR_SNOW,
+    INSTR_CANOPY,
+    INSTR_SURF_EB,
+    INSTR_FROZEN_SOIL,
+    INSTR_LAKE,
+    INSTR_RUNOFF,
+    INSTR_PUT_DATA,
+    INSTR_PLUGIN,
+    INSTR_ROUTING,
+    INSTR_WATERUSE,
+    INSTR_IRRIGATION,
+    INSTR_DAMS,
+    INSTR_CROPS,
+    INSTR_GATHER,
+    INSTR_SCATTER,
+    INSTR_NC_READ,
+    INSTR_NC_WRITE,
+    INSTR_WRITE,
+    INSTR_STATE,
+    N_INSTR_REGIONS
+};
+
+/******************************************************************************
+ * @brief   Codes for instrumented threads that are not OpenMP threads
+ *****************************************************************************/
+enum instrument_threads
+{
+    INSTR_THREAD_FORCE_PREFETCH,
+    INSTR_THREAD_HIST_WRITER,
+    INSTR_THREAD_SNAPSHOT_WRITER,
+    N_INSTR_THREADS
+};
+
+/******************************************************************************
+ * @brief   Counters of a region for one thread and one parent region
+ *****************************************************************************/
+typedef struct {
+    size_t count;   /**< number of calls */
+    double total;   /**< inclusive time (s) */
+    double self;    /**< exclusive time, without nested regions (s) */
+    double min;     /**< shortest call (s) */
+    double max;     /**< longest call (s) */
+} instrument_stat_struct;
+
+/******************************************************************************
+ * @brief   Region stack and counters of one thread
+ *****************************************************************************/
+typedef struct {
+    size_t depth;                          /**< number of open regions */
+    int region[INSTRUMENT_MAX_DEPTH];      /**< open regions */
+    double start[INSTRUMENT_MAX_DEPTH];    /**< start time of open regions */
+    double child[INSTRUMENT_MAX_DEPTH];    /**< time in nested regions */
+    instrument_stat_struct stat[N_INSTR_REGIONS + 1][N_INSTR_REGIONS];
+                                           /**< counters [parent][region] */
+} instrument_thread_struct;
+
+/******************************************************************************
+ * @brief   Counters of one thread, parent and region in the timing report
+ *****************************************************************************/
+typedef struct {
+    int rank;       /**< MPI rank */
+    int thread;     /**< thread number */
+    int parent;     /**< parent region, INSTRUMENT_TOP for top level */
+    int region;     /**< region */
+    size_t count;   /**< number of calls */
+    double total;   /**< inclusive time (s) */
+    double self;    /**< exclusive time (s) */
+    double min;     /**< shortest call (s) */
+    double max;     /**< longest call (s) */
+} instrument_record_struct;
+
+/******************************************************************************
+ * @brief   Instrumentation state of a node
+ *****************************************************************************/
+typedef struct {
+    bool initialized;
+    size_t nthreads;                   /**< number of OpenMP threads */
+    pthread_key_t key;                 /**< counters of the calling thread */
+    instrument_thread_struct *threads; /**< counters of all threads */
+    size_t nrecords;                   /**< number of gathered records */
+    instrument_record_struct *records; /**< gathered records (master node) */
+} instrument_struct;
+
+#ifdef VIC_INSTRUMENT
+#define INSTRUMENT_BEGIN(region) instrument_begin(region)
+#define INSTRUMENT_END(region) instrument_end(region)
+#else
+#define INSTRUMENT_BEGIN(region) ((void) 0)
+#define INSTRUMENT_END(region) ((void) 0)
+#endif
+
+void instrument_begin(int region);
+void instrument_end(int region);
+void instrument_finalize(void);
+instrument_thread_struct *instrument_get_thread(void);
+void instrument_init(void);
+size_t instrument_nthreads(void);
+void instrument_set_thread(int thread);
+void str_from_instrument_region(int region, char *region_str);
+
+#endif
@@ -28,6 +28,8 @@
 #define VIC_RUN_H
 
 #include <vic_def.h>
+#include <vic_fast_math.h>
+#include <vic_instrument.h>
 
 void advect_carbon_storage(double, double, lake_var_struct *,
                            cell_data_struct *);
@@ -44,6 +46,11 @@ double arno_evap(layer_data_struct *, double, double, double, double, double,
                  double, double, double, double, double, double *);
 bool assert_close_double(double x, double y, double rtol, double abs_tol);
 bool assert_close_float(float x, float y, float rtol, float abs_tol);
+void blowing_layer_heights(double ushear, double U10, double *hsalt,
+                           double *ztop);
+void blowing_table_weights(double t, double *weights);
+bool blowing_table_lookup(double U10, double ushear, double *sub_integral,
+                          double *conc_integral, double *conc_log_integral);
 double calc_atmos_energy_bal(double, double, double, double, double, double,
                              double, double, double, double, double, double,
                              double, double *, double *, double *, double *,
@@ -94,8 +101,6 @@ int CalcAerodynamic(bool, double, double, double, double, double, double *,
 double CalcBlowingSnow(double, double, unsigned int, double, double, double,
                        double, double, double, double, double, double, double,
                        double, int, int, double, double, double, double *);
-double CalcIcePackEnergyBalance(double Tsurf, ...);
-double CalcSnowPackEnergyBalance(double Tsurf, ...);
 double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens,
                    double utshear, double ushear, double fe, double Tsnow,
                    double Tair, double U10, double Zo_salt, double F,
@@ -111,6 +116,7 @@ double canopy_evap(layer_data_struct *, veg_var_struct *, veg_lib_struct *,
 void colavg(double *, double *, double *, double, double *, int, double,
             double);
 double compute_coszen(double, double, double, unsigned short int, unsigned int);
+double concentration_with_height(double z, blowing_profile_struct *);
 void compute_derived_lake_dimensions(lake_var_struct *, lake_con_struct);
 void compute_pot_evap(size_t, double, double, double, double, double, double,
                       double, double, double, double, double, double *, char,
@@ -135,20 +141,20 @@ int distribute_node_moisture_properties(double *, double *, double *, double *,
 void eddy(int, double, double *, double *, double, int, double, double);
 void energycalc(double *, double *, int, double, double, double *, double *,
                 double *);
-double error_calc_atmos_energy_bal(double Tcanopy, ...);
 double error_calc_atmos_moist_bal(double, ...);
-double error_calc_canopy_energy_bal(double Tsurf, ...);
-double error_calc_surf_energy_bal(double Tsurf, ...);
-double error_print_atmos_energy_bal(double, va_list);
+double error_print_atmos_energy_bal(double, double, double,
+                                    atmos_energy_bal_struct *);
 double error_print_atmos_moist_bal(double, va_list);
-double error_print_canopy_energy_bal(double, va_list);
-double error_print_solve_T_profile(double, va_list);
-double error_print_surf_energy_bal(double, va_list);
-double error_solve_T_profile(double Tsurf, ...);
-double ErrorIcePackEnergyBalance(double Tsurf, ...);
-double ErrorPrintIcePackEnergyBalance(double, va_list);
-int ErrorPrintSnowPackEnergyBalance(double, va_list);
-int ErrorSnowPackEnergyBalance(double Tsurf, ...);
+double error_print_canopy_energy_bal(double, int, int, int, int, double *,
+                                     canopy_energy_bal_struct *);
+double error_print_surf_energy_bal(double, dmy_struct *, int, double,
+                                   surf_energy_bal_struct *);
+double error_solve_T_profile(double, double, soil_thermal_eqn_struct *);
+double ErrorPrintIcePackEnergyBalance(double, double, double, double, double,
+                                      double, double, double,
+                                      ice_pack_energy_bal_struct *);
+int ErrorPrintSnowPackEnergyBalance(double, int, int,
+                                    snow_pack_energy_bal_struct *);
 void estimate_frost_temperature_and_depth(double ***, double **, double *,
                                           double *, double *, double *, double,
                                           size_t, size_t);
@@ -165,20 +171,22 @@ int estimate_layer_ice_content_quick_flux(layer_data_struct *, double *,
 double estimate_T1(double, double, double, double, double, double, double,
                    double, double, double);
 void faparl(double *, double, double, double, double, double *, double *);
-void fda_heat_eqn(double *, double *, int, int, ...);
-void fdjac3(double *, double *, double *, double *, double *, void (*vecfunc)(
-                double *, double *, int, int, ...), int);
+void fda_heat_eqn(double *, double *, int, int, void *);
+void fda_heat_eqn_init(double *, int, fda_heat_eqn_struct *);
+void fda_heat_eqn_jacobian(double *, double *, double *, double *, int,
+                           void *);
+void fdjac3(double *, double *, double *, double *, double *,
+            void (*vecfunc)(double *, double *, int, int, void *), void *,
+            int);
 void find_0_degree_fronts(energy_bal_struct *, double *, double *, int);
 void free_2d_double(size_t *shape, double **array);
 void free_3d_double(size_t *shape, double ***array);
-double func_atmos_energy_bal(double, va_list);
+double func_atmos_energy_bal(double, void *);
 double func_atmos_moist_bal(double, va_list);
-double func_canopy_energy_bal(double, va_list);
-double func_surf_energy_bal(double, va_list);
-double (*funcd)(double z, double es, double Wind, double AirDens, double ZO,
-                double EactAir, double F, double hsalt, double phi_r,
-                double ushear,
-                double Zrh);
+double func_canopy_energy_bal(double, void *);
+double func_surf_energy_bal(double, void *);
+double gauss_legendre(double (*funcd)(double, blowing_profile_struct *),
+                      blowing_profile_struct *profile, double a, double b);
 int get_depth(lake_con_struct, double, double *);
 double get_prob(double Tair, double Age, double SurfaceLiquidWater, double U10);
 int get_sarea(lake_con_struct, double, double *);
@@ -191,10 +199,11 @@ int ice_melt(double, double, double *, double, snow_data_struct *,
              double, double, double, double, double, double, double, double,
              double, double *, double *, double *, double *, double *, double *,
              double *, double *, double *);
-double IceEnergyBalance(double, va_list);
+double IceEnergyBalance(double, void *);
 void iceform(double *, double *, double, double, double *, int, double, double,
              double, double *, double *, double *, double *, double);
 void icerad(double, double, double, double *, double *, double *);
+void initialize_blowing_table(void);
 void initialize_lake(lake_var_struct *, lake_con_struct, soil_con_struct *,
                      cell_data_struct *, bool);
 int lakeice(double, double, double, double, double, double *, double, double *,
@@ -210,9 +219,11 @@ void malloc_2d_double(size_t *shape, double ***array);
 void malloc_3d_double(size_t *shape, double ****array);
 void MassRelease(double *, double *, double *, double *);
 double maximum_unfrozen_water(double, double, double, double);
+double maximum_unfrozen_water_dT(double, double, double, double);
 double new_snow_density(double);
-int newt_raph(void (*vecfunc)(double *, double *, int, int,
-                              ...), double *, int);
+int newt_raph(void (*vecfunc)(double *, double *, int, int, void *),
+              void (*jacfunc)(double *, double *, double *, double *, int,
+                              void *), void *, double *, int);
 double penman(double, double, double, double, double, double, double);
 void photosynth(char, double, double, double, double, double, double, double,
                 double, double, char *, double *, double *, double *, double *,
@@ -220,15 +231,19 @@ void photosynth(char, double, double, double, double, double, double, double,
 void polint(double xa[], double ya[], int n, double x, double *y, double *dy);
 void prepare_full_energy(cell_data_struct *, energy_bal_struct *,
                          soil_con_struct *, double *, double *);
-double qromb(
-    double (*sub_with_height)(), double es, double Wind, double AirDens, double ZO, double EactAir, double F, double hsalt, double phi_r, double ushear, double Zrh, double a, double b);
+double qromb(double (*funcd)(double, blowing_profile_struct *),
+             blowing_profile_struct *, double, double);
 void rescale_snow_energy_fluxes(double, double, snow_data_struct *,
                                 energy_bal_struct *);
 void rescale_snow_storage(double, double, snow_data_struct *);
 void rescale_soil_veg_fluxes(double, double, cell_data_struct *,
                              veg_var_struct *);
 void rhoinit(double *, double);
-double root_brent(double, double, double (*Function)(double, va_list), ...);
+double root_brent(double, double, double (*Function)(double, void *), void *);
+double root_brent_guess(double, double, double,
+                        double (*Function)(double, void *), void *);
+double root_brent_search(double, double, double, double,
+                         double (*Function)(double, void *), void *);
 double rtnewt(double x1, double x2, double xacc, double Ur, double Zr);
 int runoff(cell_data_struct *, energy_bal_struct *, soil_con_struct *, double,
            double *, int);
@@ -254,15 +269,18 @@ int snow_melt(double, double, double, double, double *, double, double *,
               double *, double *, double *, double *, double *, double *,
               double *, double *, double *, double *, int, int, int,
               snow_data_struct *);
-double SnowPackEnergyBalance(double, va_list);
+double SnowPackEnergyBalance(double, void *);
 void soil_carbon_balance(soil_con_struct *, energy_bal_struct *,
                          cell_data_struct *, veg_var_struct *);
 double soil_conductivity(double, double, double, double, double, double, double,
                          double);
-double soil_thermal_eqn(double, va_list);
-double solve_atmos_energy_bal(double Tcanopy, ...);
+double soil_conductivity_dWu(double, double, double, double, double, double,
+                             double, double);
+double soil_thermal_eqn(double, void *);
+void soil_thermal_eqn_set(soil_thermal_eqn_struct *, double, double, double,
+                          double, double, double, double, double, double,
+                          double, double, double, double, int, int);
 double solve_atmos_moist_bal(double, ...);
-double solve_canopy_energy_bal(double Tfoliage, ...);
 int solve_lake(double, double, double, double, double, double, double, double,
                double, double, lake_var_struct *, soil_con_struct, double,
                double, dmy_struct, double);
@@ -277,22 +295,20 @@ double solve_snow(char, double, double, double, double, double, double, double,
                   force_data_struct *, energy_bal_struct *, layer_data_struct *,
                   snow_data_struct *, soil_con_struct *, veg_var_struct *,
                   veg_lib_struct *);
-double solve_surf_energy_bal(double Tsurf, ...);
 int solve_T_profile(double *, double *, char *, unsigned int *, double *,
                     double *, double *, double *, double, double *, double *,
                     double *, double *, double *, double *, double *, double,
-                    int, int *, int, int, int);
+                    int, soil_thermal_solver_struct *, int, int, int);
 int solve_T_profile_implicit(double *, double *, char *, unsigned int *,
                              double *, double *, double *, double *, double,
                              double *, double *, double *, double *, double *,
-                             double *, double *, double, int, int *, int, int,
+                             double *, double *, double, int,
+                             soil_thermal_solver_struct *, int, int,
                              double *, double *, double *, double *, double *,
                              double *, double *);
 double specheat(double);
 double StabilityCorrection(double, double, double, double, double, double);
-double sub_with_height(double z, double es, double Wind, double AirDens,
-                       double ZO, double EactAir, double F, double hsalt,
-                       double phi_r, double ushear, double Zrh);
+double sub_with_height(double z, blowing_profile_struct *);
 int surface_fluxes(bool, double, double, double, double, double *, double *,
                    double *, double *, double *, double *, double *, double *,
                    double *, double *, double *, double *, double *, size_t,
@@ -302,6 +318,7 @@ int surface_fluxes(bool, double, double, double, double, double *, double *,
                    snow_data_struct *, soil_con_struct *, veg_var_struct *,
                    veg_lib_struct *, double, double, double, double *);
 double svp(double);
+void svp_array(double *, size_t, double *);
 double svp_slope(double);
 void temp_area(double, double, double, double *, double *, double *, double *,
                double, double *, int, double, double, double *, double *,
@@ -311,17 +328,16 @@ void transpiration(layer_data_struct *, veg_var_struct *, veg_lib_struct *,
                    double, double, double, double, double, double, double,
                    double, double *, double *, double *, double *, double *,
                    double *, double, double, double *);
-double transport_with_height(double z, double es, double Wind, double AirDens,
-                             double ZO, double EactAir, double F, double hsalt,
-                             double phi_r, double ushear, double Zrh);
-double trapzd(
-    double (*funcd)(), double es, double Wind, double AirDens, double ZO, double EactAir, double F, double hsalt, double phi_r, double ushear, double Zrh, double a, double b, int n);
+double transport_with_height(double z, blowing_profile_struct *);
+double trapzd(double (*funcd)(double, blowing_profile_struct *),
+              blowing_profile_struct *, double, double, int, double *);
 void tridia(int, double *, double *, double *, double *, double *);
 void tridiag(double *, double *, double *, double *, unsigned int);
 int vic_run(force_data_struct *, all_vars_struct *, dmy_struct *,
             global_param_struct *, lake_con_struct *, soil_con_struct *,
             veg_con_struct *, veg_lib_struct *);
 double volumetric_heat_capacity(double, double, double, double);
+double volumetric_heat_capacity_dice(void);
 int water_balance(lake_var_struct *, lake_con_struct, double, all_vars_struct *,
                   int, int, double, soil_con_struct, veg_con_struct);
 int water_energy_balance(int, double *, double *, double, double, double,
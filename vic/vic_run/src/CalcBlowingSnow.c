@@ -270,31 +270,22 @@ CalcBlowingSnow(double   Dt,
  *           in C Section 4.3
  *****************************************************************************/
 double
-qromb(double (*funcd)(),
-      double es,
-      double Wind,
-      double AirDens,
-      double ZO,
-      double EactAir,
-      double F,
-      double hsalt,
-      double phi_r,
-      double ushear,
-      double Zrh,
-      double a,
-      double b)
+qromb(double (*funcd)(double, blowing_profile_struct *),
+      blowing_profile_struct *profile,
+      double                  a,
+      double                  b)
 {
     extern parameters_struct param;
 
     double                   ss, dss;
     double                   s[param.BLOWING_MAX_ITER + 1];
     double                   h[param.BLOWING_MAX_ITER + 2];
+    double                   trap = 0.;
     int                      j;
 
     h[1] = 1.0;
     for (j = 1; j <= param.BLOWING_MAX_ITER; j++) {
-        s[j] = trapzd(funcd, es, Wind, AirDens, ZO, EactAir, F, hsalt, phi_r,
-                      ushear, Zrh, a, b, j);
+        s[j] = trapzd(funcd, profile, a, b, j, &trap);
         if (j >= param.BLOWING_K) {
             polint(&h[j - param.BLOWING_K], &s[j - param.BLOWING_K],
                    param.BLOWING_K, 0.0, &ss, &dss);
@@ -360,39 +351,25 @@ polint(double  xa[],
 
 /******************************************************************************
  * @brief    Compute the nth stage of refinement of an extended trapezoidal rule.
+ * @details  s holds the previous stage on input and is updated in place, so
+ *           the caller owns the running estimate.
  *****************************************************************************/
 double
-trapzd(double (*funcd)(),
-       double es,
-       double Wind,
-       double AirDens,
-       double ZO,
-       double EactAir,
-       double F,
-       double hsalt,
-       double phi_r,
-       double ushear,
-       double Zrh,
-       double a,
-       double b,
-       int    n)
+trapzd(double (*funcd)(double, blowing_profile_struct *),
+       blowing_profile_struct *profile,
+       double                  a,
+       double                  b,
+       int                     n,
+       double                 *s)
 {
     double x, tnm, sum, del;
     int    it, j;
 
-    // TODO: remove use of static variables (see GH #735), for now:
-    // make static variables thread safe
-    static double s;
-    #pragma omp threadprivate(s)
-
     if (n == 1) {
-        return (s = 0.5 *
-                    (b -
-                     a) *
-                    ((*funcd)(a, es, Wind, AirDens, ZO, EactAir, F, hsalt,
-                              phi_r, ushear, Zrh) +
-                     (*funcd)(b, es, Wind, AirDens, ZO, EactAir, F, hsalt,
-                              phi_r, ushear, Zrh)));
+        return (*s = 0.5 *
+                     (b -
+                      a) *
+                     ((*funcd)(a, profile) + (*funcd)(b, profile)));
     }
     else {
         for (it = 1, j = 1; j < n - 1; j++) {
@@ -402,12 +379,10 @@ trapzd(double (*funcd)(),
         del = (b - a) / tnm;
         x = a + 0.5 * del;
         for (sum = 0.0, j = 1; j <= it; j++, x += del) {
-            sum +=
-                (*funcd)(x, es, Wind, AirDens, ZO, EactAir, F, hsalt, phi_r,
-                         ushear, Zrh);
+            sum += (*funcd)(x, profile);
         }
-        s = 0.5 * (s + (b - a) * sum / tnm);
-        return s;
+        *s = 0.5 * (*s + (b - a) * sum / tnm);
+        return *s;
     }
 }
 
@@ -506,31 +481,21 @@ get_shear(double  x,
  *           boundary layer.
  *****************************************************************************/
 double
-sub_with_height(double z,
-                double es,
-                double Wind,
-                double AirDens,
-                double ZO,
-                double EactAir,
-                double F,
-                double hsalt,
-                double phi_r,
-                double ushear,
-                double Zrh)
+sub_with_height(double                  z,
+                blowing_profile_struct *profile)
 {
     extern parameters_struct param;
 
-    /* Unused variables */
-    UNUSED(AirDens);
-    UNUSED(ZO);
-    UNUSED(Zrh);
+    double                   es = profile->es;
+    double                   Wind = profile->Wind;
+    double                   EactAir = profile->EactAir;
+    double                   F = profile->F;
 
     /* Local variables */
     double Rrz, ALPHAz, Mz;
     double Rmean, terminal_v, fluctuat_v;
     double Vtz, Re, Nu;
     double sigz, dMdt;
-    double temp;
     double psi_t, phi_t;
 
 
@@ -564,15 +529,7 @@ sub_with_height(double z,
 
     psi_t = dMdt / Mz;
 
-    // Concentration of turbulent suspended snow Kind (1992)
-
-    temp = (0.5 * ushear * ushear) / (Wind * param.BLOWING_SETTLING);
-    phi_t = phi_r *
-            ((temp +
-              1.) *
-             pow((z / hsalt),
-                 (-1. *
-                  param.BLOWING_SETTLING) / (CONST_KARMAN * ushear)) - temp);
+    phi_t = concentration_with_height(z, profile);
 
     return psi_t * phi_t;
 }
@@ -733,10 +690,15 @@ CalcSubFlux(double  EactAir,
     double SubFlux;
     double Qsalt, hsalt;
     double phi_s, psi_s;
-    double T, ztop;
+    double ztop;
     double particle;
     double saltation_transport;
     double suspension_transport;
+    double sub_integral;
+    double conc_integral;
+    double conc_log_integral;
+    bool   tabulated;
+    blowing_profile_struct profile;
 
     SubFlux = 0.0;
     particle = utshear * 2.8;
@@ -765,43 +727,70 @@ CalcSubFlux(double  EactAir,
             Qsalt *= (1. + (500. / (3. * fe)) * (exp(-3. * fe / 500.) - 1.));
         }
 
-        // Pomeroy and Male (1992)
-        hsalt = 0.08436 * pow(ushear, 1.27);
+        blowing_layer_heights(ushear, U10, &hsalt, &ztop);
 
         // Saltation layer mass concentration (kg/m3)
         phi_s = Qsalt / (hsalt * particle);
 
-        T = 0.5 * (ushear * ushear) / (U10 * param.BLOWING_SETTLING);
-        ztop = hsalt *
-               pow(T / (T + 1.),
-                   (CONST_KARMAN * ushear) / (-1. * param.BLOWING_SETTLING));
+        // vertical profile shared by the saltation and suspension layers
+        profile.es = es;
+        profile.Wind = U10;
+        profile.AirDens = AirDens;
+        profile.ZO = Zo_salt;
+        profile.EactAir = EactAir;
+        profile.F = F;
+        profile.hsalt = hsalt;
+        profile.phi_r = phi_s;
+        profile.ushear = ushear;
+        profile.Zrh = Zrh;
+
+        tabulated = false;
+        if (options.BLOWING_INTEGRATION == BLOWING_TABLE) {
+            tabulated = blowing_table_lookup(U10, ushear, &sub_integral,
+                                             &conc_integral,
+                                             &conc_log_integral);
+        }
 
         if (EactAir >= es) {
             SubFlux = 0.0;
         }
         else {
             // Sublimation loss-rate for the saltation layer (s-1)
-            psi_s = sub_with_height(hsalt / 2., es, U10, AirDens, Zo_salt,
-                                    EactAir, F, hsalt,
-                                    phi_s, ushear, Zrh);
+            psi_s = sub_with_height(hsalt / 2., &profile);
 
             // Sublimation from the saltation layer in kg/m2*s
             SubFlux = phi_s * psi_s * hsalt;
 
             // Suspension layer must be integrated
-            SubFlux += qromb(sub_with_height, es, U10, AirDens, Zo_salt,
-                             EactAir, F, hsalt,
-                             phi_s, ushear, Zrh, hsalt, ztop);
+            if (tabulated) {
+                SubFlux += phi_s * ((EactAir / es) - 1.) / F * sub_integral;
+            }
+            else if (options.BLOWING_INTEGRATION == BLOWING_ROMBERG) {
+                SubFlux += qromb(sub_with_height, &profile, hsalt, ztop);
+            }
+            else {
+                SubFlux += gauss_legendre(sub_with_height, &profile, hsalt,
+                                          ztop);
+            }
         }
 
         // Transport out of the domain by saltation Qs(fe) (kg/m*s), eq 10 Liston and Sturm
         saltation_transport = Qsalt * (1 - exp(-3. * fe / 500.));
 
         // Transport in the suspension layer
-        suspension_transport = qromb(transport_with_height, es, U10, AirDens,
-                                     Zo_salt,
-                                     EactAir, F, hsalt, phi_s, ushear, Zrh,
-                                     hsalt, ztop);
+        if (tabulated) {
+            suspension_transport = phi_s * ushear / CONST_KARMAN *
+                                   (conc_log_integral +
+                                    log(hsalt / Zo_salt) * conc_integral);
+        }
+        else if (options.BLOWING_INTEGRATION == BLOWING_ROMBERG) {
+            suspension_transport = qromb(transport_with_height, &profile,
+                                         hsalt, ztop);
+        }
+        else {
+            suspension_transport = gauss_legendre(transport_with_height,
+                                                  &profile, hsalt, ztop);
+        }
 
         // Transport at the downstream edge of the fetch in kg/m*s
         *Transport = (suspension_transport + saltation_transport);
@@ -818,45 +807,256 @@ CalcSubFlux(double  EactAir,
  *           layer.
  *****************************************************************************/
 double
-transport_with_height(double z,
-                      double es,
-                      double Wind,
-                      double AirDens,
-                      double ZO,
-                      double EactAir,
-                      double F,
-                      double hsalt,
-                      double phi_r,
-                      double ushear,
-                      double Zrh)
+transport_with_height(double                  z,
+                      blowing_profile_struct *profile)
 {
-    extern parameters_struct param;
-
-    /* Unused variables */
-    UNUSED(es);
-    UNUSED(AirDens);
-    UNUSED(EactAir);
-    UNUSED(F);
-    UNUSED(Zrh);
+    double ZO = profile->ZO;
+    double ushear = profile->ushear;
 
     /* Local variables */
     double u_z;
-    double temp;
     double phi_t;
 
     // Find wind speed at current height
 
     u_z = ushear * log(z / ZO) / CONST_KARMAN;
 
-    // Concentration of turbulent suspended snow Kind (1992)
+    phi_t = concentration_with_height(z, profile);
+
+    return u_z * phi_t;
+}
+
+/******************************************************************************
+ * @brief    Calculate the concentration of turbulent suspended snow for a
+ *           given height above the boundary layer, Kind (1992).
+ *****************************************************************************/
+double
+concentration_with_height(double                  z,
+                          blowing_profile_struct *profile)
+{
+    extern parameters_struct param;
+
+    double                   Wind = profile->Wind;
+    double                   hsalt = profile->hsalt;
+    double                   phi_r = profile->phi_r;
+    double                   ushear = profile->ushear;
+
+    /* Local variables */
+    double temp;
 
     temp = (0.5 * ushear * ushear) / (Wind * param.BLOWING_SETTLING);
-    phi_t = phi_r *
-            ((temp +
-              1.) *
-             pow((z / hsalt),
-                 (-1. *
-                  param.BLOWING_SETTLING) / (CONST_KARMAN * ushear)) - temp);
 
-    return u_z * phi_t;
+    return phi_r *
+           ((temp +
+             1.) *
+            pow((z / hsalt),
+                (-1. *
+                 param.BLOWING_SETTLING) / (CONST_KARMAN * ushear)) - temp);
+}
+
+/******************************************************************************
+ * @brief    Calculate the heights of the saltation layer and of the top of
+ *           the suspension layer.
+ *****************************************************************************/
+void
+blowing_layer_heights(double  ushear,
+                      double  U10,
+                      double *hsalt,
+                      double *ztop)
+{
+    extern parameters_struct param;
+
+    double                   T;
+
+    // Pomeroy and Male (1992)
+    *hsalt = 0.08436 * pow(ushear, 1.27);
+
+    T = 0.5 * (ushear * ushear) / (U10 * param.BLOWING_SETTLING);
+    *ztop = *hsalt *
+            pow(T / (T + 1.),
+                (CONST_KARMAN * ushear) / (-1. * param.BLOWING_SETTLING));
+}
+
+/******************************************************************************
+ * @brief    Integration by a fixed-order Gauss-Legendre rule in log(z).
+ * @details  The height profiles are close to power laws, which are smooth in
+ *           log(z), so BLOWING_GAUSS_ORDER nodes reproduce qromb closely at a
+ *           fixed cost. a must be positive.
+ *****************************************************************************/
+double
+gauss_legendre(double (*funcd)(double, blowing_profile_struct *),
+               blowing_profile_struct *profile,
+               double                  a,
+               double                  b)
+{
+    // positive nodes and weights of the 16-point rule on [-1, 1]
+    double nodes[BLOWING_GAUSS_ORDER / 2] = {
+        9.50125098376374405129e-02, 2.81603550779258915426e-01,
+        4.58016777657227369680e-01, 6.17876244402643770570e-01,
+        7.55404408355002998654e-01, 8.65631202387831755196e-01,
+        9.44575023073232600268e-01, 9.89400934991649938510e-01
+    };
+    double weights[BLOWING_GAUSS_ORDER / 2] = {
+        1.89450610455068502169e-01, 1.82603415044923583777e-01,
+        1.69156519395002535866e-01, 1.49595988816576735969e-01,
+        1.24628971255533876894e-01, 9.51585116824927856882e-02,
+        6.22535239386478936319e-02, 2.71524594117540964133e-02
+    };
+    double mid;
+    double half;
+    double z;
+    double sum;
+    size_t i;
+
+    mid = 0.5 * (log(b) + log(a));
+    half = 0.5 * (log(b) - log(a));
+
+    // dz = z dt with t = log(z)
+    sum = 0.;
+    for (i = 0; i < BLOWING_GAUSS_ORDER / 2; i++) {
+        z = exp(mid + half * nodes[i]);
+        sum += weights[i] * z * (*funcd)(z, profile);
+        z = exp(mid - half * nodes[i]);
+        sum += weights[i] * z * (*funcd)(z, profile);
+    }
+
+    return half * sum;
+}
+
+/******************************************************************************
+ * @brief    Fill the blowing snow table, used with BLOWING_INTEGRATION =
+ *           BLOWING_TABLE.
+ * @details  Must be called after the parameters are set, since the integrals
+ *           depend on BLOWING_SETTLING and BLOWING_KIN_VIS. The integrals are
+ *           computed with gauss_legendre. The table extends one point beyond
+ *           the minimum and maximum wind and shear for the cubic
+ *           interpolation.
+ *****************************************************************************/
+void
+initialize_blowing_table(void)
+{
+    extern blowing_table_struct blowing_table;
+
+    double                      dlnwind;
+    double                      dlnshear;
+    double                      ztop;
+    blowing_profile_struct      profile;
+    size_t                      i;
+    size_t                      j;
+
+    dlnwind = log(BLOWING_TABLE_WIND_MAX / BLOWING_TABLE_WIND_MIN) /
+              (BLOWING_TABLE_NWIND - 3);
+    dlnshear = log(BLOWING_TABLE_SHEAR_MAX / BLOWING_TABLE_SHEAR_MIN) /
+               (BLOWING_TABLE_NSHEAR - 3);
+
+    // unit factors phi_r, EactAir / es - 1 and F
+    profile.es = 1.;
+    profile.EactAir = 2.;
+    profile.F = 1.;
+    profile.phi_r = 1.;
+    profile.AirDens = 0.;
+    profile.Zrh = 0.;
+
+    for (i = 0; i < BLOWING_TABLE_NWIND; i++) {
+        profile.Wind = BLOWING_TABLE_WIND_MIN *
+                       exp(((double) i - 1.) * dlnwind);
+        for (j = 0; j < BLOWING_TABLE_NSHEAR; j++) {
+            profile.ushear = BLOWING_TABLE_SHEAR_MIN *
+                             exp(((double) j - 1.) * dlnshear);
+            blowing_layer_heights(profile.ushear, profile.Wind,
+                                  &(profile.hsalt), &ztop);
+            // log(z / ZO) = log(z / hsalt)
+            profile.ZO = profile.hsalt;
+
+            blowing_table.sub[i][j] =
+                log(gauss_legendre(sub_with_height, &profile, profile.hsalt,
+                                   ztop));
+            blowing_table.conc[i][j] =
+                log(gauss_legendre(concentration_with_height, &profile,
+                                   profile.hsalt, ztop));
+            blowing_table.conc_log[i][j] =
+                log(gauss_legendre(transport_with_height, &profile,
+                                   profile.hsalt, ztop) *
+                    CONST_KARMAN / profile.ushear);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Catmull-Rom interpolation weights of the points -1, 0, 1 and 2
+ *           for position t between points 0 and 1.
+ *****************************************************************************/
+void
+blowing_table_weights(double  t,
+                      double *weights)
+{
+    weights[0] = 0.5 * t * (-1. + t * (2. - t));
+    weights[1] = 0.5 * (2. + t * t * (-5. + 3. * t));
+    weights[2] = 0.5 * t * (1. + t * (4. - 3. * t));
+    weights[3] = 0.5 * t * t * (t - 1.);
+}
+
+/******************************************************************************
+ * @brief    Interpolate the suspension layer integrals in the blowing snow
+ *           table.
+ * @details  Bicubic (Catmull-Rom) interpolation of the log of the integrals
+ *           in log(U10) and log(ushear). Returns false if U10 or ushear is
+ *           outside of the table, in which case the integrals must be
+ *           computed directly.
+ *****************************************************************************/
+bool
+blowing_table_lookup(double  U10,
+                     double  ushear,
+                     double *sub_integral,
+                     double *conc_integral,
+                     double *conc_log_integral)
+{
+    extern blowing_table_struct blowing_table;
+
+    double                      x;
+    double                      y;
+    double                      wx[4];
+    double                      wy[4];
+    double                      sub;
+    double                      conc;
+    double                      conc_log;
+    size_t                      i;
+    size_t                      j;
+    size_t                      k;
+    size_t                      l;
+
+    x = 1. + log(U10 / BLOWING_TABLE_WIND_MIN) /
+        log(BLOWING_TABLE_WIND_MAX / BLOWING_TABLE_WIND_MIN) *
+        (BLOWING_TABLE_NWIND - 3);
+    y = 1. + log(ushear / BLOWING_TABLE_SHEAR_MIN) /
+        log(BLOWING_TABLE_SHEAR_MAX / BLOWING_TABLE_SHEAR_MIN) *
+        (BLOWING_TABLE_NSHEAR - 3);
+
+    if (!(x >= 1. && x <= BLOWING_TABLE_NWIND - 2 &&
+          y >= 1. && y <= BLOWING_TABLE_NSHEAR - 2)) {
+        return false;
+    }
+
+    i = min((size_t) x, BLOWING_TABLE_NWIND - 3);
+    j = min((size_t) y, BLOWING_TABLE_NSHEAR - 3);
+    blowing_table_weights(x - i, wx);
+    blowing_table_weights(y - j, wy);
+
+    sub = 0.;
+    conc = 0.;
+    conc_log = 0.;
+    for (k = 0; k < 4; k++) {
+        for (l = 0; l < 4; l++) {
+            sub += wx[k] * wy[l] * blowing_table.sub[i + k - 1][j + l - 1];
+            conc += wx[k] * wy[l] * blowing_table.conc[i + k - 1][j + l - 1];
+            conc_log += wx[k] * wy[l] *
+                        blowing_table.conc_log[i + k - 1][j + l - 1];
+        }
+    }
+
+    *sub_integral = exp(sub);
+    *conc_integral = exp(conc);
+    *conc_log_integral = exp(conc_log);
+
+    return true;
 }
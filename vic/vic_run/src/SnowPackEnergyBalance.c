@@ -34,13 +34,14 @@
  * @brief    Calculate the surface energy balance for the snow pack.
  *****************************************************************************/
 double
-SnowPackEnergyBalance(double  TSurf,
-                      va_list ap)
+SnowPackEnergyBalance(double TSurf,
+                      void  *params)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
+    extern option_struct         options;
+    extern parameters_struct     param;
+    snow_pack_energy_bal_struct *bal = (snow_pack_energy_bal_struct *) params;
 
-    /* Define Variable Argument List */
+    /* Define Parameters */
 
     /* General Model Parameters */
     double  Dt;                   /* Model time step (sec) */
@@ -110,63 +111,52 @@ SnowPackEnergyBalance(double  TSurf,
     double BlowingMassFlux;       /* Mass flux of water vapor from blowing snow. (kg/m2s) */
     double SurfaceMassFlux;       /* Mass flux of water vapor from pack snow. (kg/m2s) */
 
-    /* Assign the elements of the array to the appropriate variables.  The list
-       is traversed as if the elements are doubles, because:
-
-       In the variable-length part of variable-length argument lists, the old
-       ``default argument promotions'' apply: arguments of type double are
-       always promoted (widened) to type double, and types char and short int
-       are promoted to int. Therefore, it is never correct to invoke
-       va_arg(argp, double); instead you should always use va_arg(argp,
-       double).
-
-       (quoted from the comp.lang.c FAQ list)
-     */
+    /* Assign the parameters to the appropriate variables */
 
     /* General Model Parameters */
-    Dt = (double) va_arg(ap, double);
-    Ra = (double) va_arg(ap, double);
-    Ra_used = (double *) va_arg(ap, double *);
+    Dt = bal->Dt;
+    Ra = bal->Ra;
+    Ra_used = bal->Ra_used;
 
     /* Vegetation Parameters */
-    Z = (double) va_arg(ap, double);
-    Z0 = (double *) va_arg(ap, double *);
+    Z = bal->Z;
+    Z0 = bal->Z0;
 
     /* Atmospheric Forcing Variables */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    NetShortUnder = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
+    AirDens = bal->AirDens;
+    EactAir = bal->EactAir;
+    LongSnowIn = bal->LongSnowIn;
+    Lv = bal->Lv;
+    Press = bal->Press;
+    Rain = bal->Rain;
+    NetShortUnder = bal->NetShortUnder;
+    Vpd = bal->Vpd;
+    Wind = bal->Wind;
 
     /* Snowpack Variables */
-    OldTSurf = (double) va_arg(ap, double);
-    SnowCoverFract = (double) va_arg(ap, double);
-    SnowDepth = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
+    OldTSurf = bal->OldTSurf;
+    SnowCoverFract = bal->SnowCoverFract;
+    SnowDepth = bal->SnowDepth;
+    SnowDensity = bal->SnowDensity;
+    SurfaceLiquidWater = bal->SurfaceLiquidWater;
+    SweSurfaceLayer = bal->SweSurfaceLayer;
 
     /* Energy Balance Components */
-    Tair = (double) va_arg(ap, double);
-    TGrnd = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    AdvectedSensibleHeat = (double *)va_arg(ap, double *);
-    DeltaColdContent = (double *) va_arg(ap, double *);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    NetLongUnder = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
+    Tair = bal->Tair;
+    TGrnd = bal->TGrnd;
+
+    AdvectedEnergy = bal->AdvectedEnergy;
+    AdvectedSensibleHeat = bal->AdvectedSensibleHeat;
+    DeltaColdContent = bal->DeltaColdContent;
+    GroundFlux = bal->GroundFlux;
+    LatentHeat = bal->LatentHeat;
+    LatentHeatSub = bal->LatentHeatSub;
+    NetLongUnder = bal->NetLongUnder;
+    RefreezeEnergy = bal->RefreezeEnergy;
+    SensibleHeat = bal->SensibleHeat;
+    vapor_flux = bal->vapor_flux;
+    blowing_flux = bal->blowing_flux;
+    surface_flux = bal->surface_flux;
 
     /* Calculate active temp for energy balance as average of old and new  */
 
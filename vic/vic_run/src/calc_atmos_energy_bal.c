@@ -67,6 +67,7 @@ calc_atmos_energy_bal(double    InOverSensible,
     double                   T_lower;
     double                   T_upper;
     double                   Tcanopy;
+    atmos_energy_bal_struct  atmos_bal;
 
     F = 1;
 
@@ -86,6 +87,13 @@ calc_atmos_energy_bal(double    InOverSensible,
 
     (*LatentHeatSub) = (LatentHeatSubOver + LatentHeatSubUnder);
 
+    /* Pack the parameters of the atmospheric energy balance */
+    atmos_bal.Ra = Ra;
+    atmos_bal.Tair = Tair;
+    atmos_bal.atmos_density = atmos_density;
+    atmos_bal.InSensible = InSensible;
+    atmos_bal.SensibleHeat = SensibleHeat;
+
     /******************************
        Find Canopy Air Temperature
     ******************************/
@@ -99,9 +107,8 @@ calc_atmos_energy_bal(double    InOverSensible,
         T_upper = (Tair) + param.CANOPY_DT;
 
         // iterate for canopy air temperature
-        Tcanopy = root_brent(T_lower, T_upper,
-                             func_atmos_energy_bal, Ra, Tair, atmos_density,
-                             InSensible, SensibleHeat);
+        Tcanopy = root_brent(T_lower, T_upper, func_atmos_energy_bal,
+                             &atmos_bal);
 
         if (Tcanopy <= -998) {
             if (options.TFALLBACK) {
@@ -111,12 +118,11 @@ calc_atmos_energy_bal(double    InOverSensible,
             }
             else {
                 // handle error flag from root brent
-                (*Error) = error_calc_atmos_energy_bal(Tcanopy, (*LatentHeat) +
-                                                       (*LatentHeatSub),
-                                                       NetRadiation, Ra, Tair,
-                                                       atmos_density,
-                                                       InSensible,
-                                                       SensibleHeat);
+                (*Error) = error_print_atmos_energy_bal(Tcanopy,
+                                                        (*LatentHeat) +
+                                                        (*LatentHeatSub),
+                                                        NetRadiation,
+                                                        &atmos_bal);
                 return (ERROR);
             }
         }
@@ -126,57 +132,19 @@ calc_atmos_energy_bal(double    InOverSensible,
     }
 
     // compute variables based on final temperature
-    (*Error) = solve_atmos_energy_bal(Tcanopy, Ra, Tair, atmos_density,
-                                      InSensible, SensibleHeat);
+    (*Error) = func_atmos_energy_bal(Tcanopy, &atmos_bal);
     return(Tcanopy);
 }
 
-/******************************************************************************
- * @brief    Dummy function to allow calling func_atmos_energy_bal() directly.
- *****************************************************************************/
-double
-solve_atmos_energy_bal(double Tcanopy,
-                       ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tcanopy);
-    error = func_atmos_energy_bal(Tcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
-/******************************************************************************
- * @brief    Dummy function to allow calling error_calc_atmos_energy_bal()
- *           directly.
- *****************************************************************************/
-double
-error_calc_atmos_energy_bal(double Tcanopy,
-                            ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tcanopy);
-    error = error_print_atmos_energy_bal(Tcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
 /******************************************************************************
  * @brief    Print atmos energy balance terms.
  *****************************************************************************/
 double
-error_print_atmos_energy_bal(double  Tcanopy,
-                             va_list ap)
+error_print_atmos_energy_bal(double                   Tcanopy,
+                             double                   LatentHeat,
+                             double                   NetRadiation,
+                             atmos_energy_bal_struct *bal)
 {
-    double  LatentHeat;
-    double  NetRadiation;
     double  Ra;
     double  Tair;
     double  atmos_density;
@@ -184,15 +152,13 @@ error_print_atmos_energy_bal(double  Tcanopy,
 
     double *SensibleHeat;
 
-    // extract variables from va_arg
-    LatentHeat = (double)  va_arg(ap, double);
-    NetRadiation = (double)  va_arg(ap, double);
-    Ra = (double)  va_arg(ap, double);
-    Tair = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    InSensible = (double)  va_arg(ap, double);
+    // extract variables from parameters
+    Ra = bal->Ra;
+    Tair = bal->Tair;
+    atmos_density = bal->atmos_density;
+    InSensible = bal->InSensible;
 
-    SensibleHeat = (double *)va_arg(ap, double *);
+    SensibleHeat = bal->SensibleHeat;
 
     // print variable values
     log_warn("Failure to converge to a solution in root_brent.\n"
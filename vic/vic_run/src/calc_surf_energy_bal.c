@@ -88,75 +88,69 @@ calc_surf_energy_bal(double             Le,
                      veg_var_struct    *veg_var,
                      veg_lib_struct    *veg_lib)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    int                      FIRST_SOLN[2];
-    int                      VEG;
-    int                      i;
-    size_t                   nidx;
-    int                      inidx;
-    int                      tmpNnodes;
-
-    double                   Cs1;
-    double                   Cs2;
-    double                   D1;
-    double                   D2;
-    double                   LongBareIn;
-    double                   NetLongBare;
-    double                   NetShortBare;
-    double                   T1;
-    double                   T1_old;
-    double                   T2;
-    double                   Ts_old;
-    double                   Tsnow_surf;
-    double                   Tsurf;
-    char                     Tsurf_fbflag;
-    unsigned                 Tsurf_fbcount;
-    double                   atmos_density;
-    double                   atmos_pressure;
-    double                   atmos_shortwave;
-    double                   atmos_Catm;
-    double                   bubble;
-    double                   delta_t;
-    double                   emissivity;
-    double                   error;
-    double                   expt;
-    double                   kappa1;
-    double                   kappa2;
-    double                   kappa_snow;
-    double                   max_moist;
-    double                   refrozen_water;
-
-    double                   Wdew;
-    double                  *T_node;
-    double                   Tnew_node[MAX_NODES];
-    char                     Tnew_fbflag[MAX_NODES];
-    unsigned                 Tnew_fbcount[MAX_NODES];
-    double                  *Zsum_node;
-    double                  *kappa_node;
-    double                  *Cs_node;
-    double                  *moist_node;
-    double                  *bubble_node;
-    double                  *expt_node;
-    double                  *max_moist_node;
-    double                  *ice_node;
-    double                  *alpha;
-    double                  *beta;
-    double                  *gamma;
-
-    double                   T_lower, T_upper;
-    double                   LongSnowIn;
-    double                   TmpNetLongSnow;
-    double                   TmpNetShortSnow;
-    double                   old_swq, old_depth;
-
-    /* Transform variables */
-    double                   Wcr_array[MAX_LAYERS];
-    size_t                   lidex;
-    for (lidex = 0; lidex < options.Nlayer; lidex++) {
-        Wcr_array[lidex] = layer[lidex].Wcr;
-    }
+    extern option_struct       options;
+    extern parameters_struct   param;
+
+    soil_thermal_solver_struct soil_solver;
+    surf_energy_bal_struct     surf_bal;
+    int                        VEG;
+    int                        i;
+    size_t                     nidx;
+    int                        inidx;
+    int                        tmpNnodes;
+
+    double                     Cs1;
+    double                     Cs2;
+    double                     D1;
+    double                     D2;
+    double                     LongBareIn;
+    double                     NetLongBare;
+    double                     NetShortBare;
+    double                     T1;
+    double                     T1_old;
+    double                     T2;
+    double                     Ts_old;
+    double                     Tsnow_surf;
+    double                     Tsurf;
+    char                       Tsurf_fbflag;
+    unsigned                   Tsurf_fbcount;
+    double                     atmos_density;
+    double                     atmos_pressure;
+    double                     atmos_shortwave;
+    double                     atmos_Catm;
+    double                     bubble;
+    double                     delta_t;
+    double                     emissivity;
+    double                     error;
+    double                     expt;
+    double                     kappa1;
+    double                     kappa2;
+    double                     kappa_snow;
+    double                     max_moist;
+    double                     refrozen_water;
+
+    double                     Wdew;
+    double                    *T_node;
+    double                     Tnew_node[MAX_NODES];
+    char                       Tnew_fbflag[MAX_NODES];
+    unsigned                   Tnew_fbcount[MAX_NODES];
+    double                    *Zsum_node;
+    double                    *kappa_node;
+    double                    *Cs_node;
+    double                    *moist_node;
+    double                    *bubble_node;
+    double                    *expt_node;
+    double                    *max_moist_node;
+    double                    *ice_node;
+    double                    *alpha;
+    double                    *beta;
+    double                    *gamma;
+
+    double                     T_lower, T_upper;
+    double                     LongSnowIn;
+    double                     TmpNetLongSnow;
+    double                     TmpNetShortSnow;
+    double                     old_swq, old_depth;
 
     /**************************************************
        Set All Variables For Use
@@ -219,8 +213,9 @@ calc_surf_energy_bal(double             Le,
     expt = soil_con->expt[0];
     Tsnow_surf = snow->surf_temp;
     Wdew = veg_var->Wdew;
-    FIRST_SOLN[0] = true;
-    FIRST_SOLN[1] = true;
+    memset(&soil_solver, 0, sizeof(soil_solver));
+    soil_solver.FIRST_SOLN[0] = true;
+    soil_solver.FIRST_SOLN[1] = true;
     if (snow->depth > 0.) {
         kappa_snow = param.SNOW_CONDUCT * (snow->density) *
                      (snow->density) / snow_depth;
@@ -262,6 +257,105 @@ calc_surf_energy_bal(double             Le,
     Zsum_node = soil_con->Zsum_node;
     ice_node = energy->ice;
 
+    /* Pack the parameters of the surface energy balance */
+    surf_bal.VEG = VEG;
+    surf_bal.delta_t = delta_t;
+    surf_bal.Cs1 = Cs1;
+    surf_bal.Cs2 = Cs2;
+    surf_bal.D1 = D1;
+    surf_bal.D2 = D2;
+    surf_bal.T1_old = T1_old;
+    surf_bal.T2 = T2;
+    surf_bal.Ts_old = Ts_old;
+    surf_bal.Told_node = energy->T;
+    surf_bal.bubble = bubble;
+    surf_bal.dp = dp;
+    surf_bal.expt = expt;
+    surf_bal.ice0 = ice0;
+    surf_bal.kappa1 = kappa1;
+    surf_bal.kappa2 = kappa2;
+    surf_bal.max_moist = max_moist;
+    surf_bal.moist = moist;
+    surf_bal.root = root;
+    surf_bal.CanopLayerBnd = CanopLayerBnd;
+    surf_bal.UnderStory = UnderStory;
+    surf_bal.overstory = overstory;
+    surf_bal.NetShortBare = NetShortBare;
+    surf_bal.NetShortGrnd = NetShortGrnd;
+    surf_bal.NetShortSnow = TmpNetShortSnow;
+    surf_bal.Tair = Tair;
+    surf_bal.atmos_density = atmos_density;
+    surf_bal.atmos_pressure = atmos_pressure;
+    surf_bal.emissivity = emissivity;
+    surf_bal.LongBareIn = LongBareIn;
+    surf_bal.LongSnowIn = LongSnowIn;
+    surf_bal.surf_atten = surf_atten;
+    surf_bal.vp = VPcanopy;
+    surf_bal.vpd = VPDcanopy;
+    surf_bal.shortwave = atmos_shortwave;
+    surf_bal.Catm = atmos_Catm;
+    surf_bal.dryFrac = dryFrac;
+    surf_bal.Wdew = &Wdew;
+    surf_bal.displacement = displacement;
+    surf_bal.ra = aero_resist;
+    surf_bal.Ra_veg = aero_resist_veg;
+    surf_bal.Ra_used = aero_resist_used;
+    surf_bal.rainfall = rainfall;
+    surf_bal.ref_height = ref_height;
+    surf_bal.roughness = roughness;
+    surf_bal.wind = wind;
+    surf_bal.Le = Le;
+    surf_bal.Advection = energy->advection;
+    surf_bal.OldTSurf = OldTSurf;
+    surf_bal.Tsnow_surf = Tsnow_surf;
+    surf_bal.kappa_snow = kappa_snow;
+    surf_bal.melt_energy = melt_energy;
+    surf_bal.snow_coverage = snow_coverage;
+    surf_bal.snow_density = snow->density;
+    surf_bal.snow_swq = snow->swq;
+    surf_bal.snow_water = snow->surf_water;
+    surf_bal.deltaCC = &energy->deltaCC;
+    surf_bal.refreeze_energy = &energy->refreeze_energy;
+    surf_bal.vapor_flux = &snow->vapor_flux;
+    surf_bal.blowing_flux = &snow->blowing_flux;
+    surf_bal.surface_flux = &snow->surface_flux;
+    surf_bal.Nnodes = (int) Nnodes;
+    surf_bal.Cs_node = Cs_node;
+    surf_bal.T_node = T_node;
+    surf_bal.Tnew_node = Tnew_node;
+    surf_bal.Tnew_fbflag = Tnew_fbflag;
+    surf_bal.Tnew_fbcount = Tnew_fbcount;
+    surf_bal.alpha = alpha;
+    surf_bal.beta = beta;
+    surf_bal.bubble_node = bubble_node;
+    surf_bal.Zsum_node = Zsum_node;
+    surf_bal.expt_node = expt_node;
+    surf_bal.gamma = gamma;
+    surf_bal.ice_node = ice_node;
+    surf_bal.kappa_node = kappa_node;
+    surf_bal.max_moist_node = max_moist_node;
+    surf_bal.moist_node = moist_node;
+    surf_bal.soil_con = soil_con;
+    surf_bal.layer = layer;
+    surf_bal.veg_var = veg_var;
+    surf_bal.veg_lib = veg_lib;
+    surf_bal.INCLUDE_SNOW = INCLUDE_SNOW;
+    surf_bal.NOFLUX = options.NOFLUX;
+    surf_bal.EXP_TRANS = options.EXP_TRANS;
+    surf_bal.SNOWING = snow->snow;
+    surf_bal.soil_solver = &soil_solver;
+    surf_bal.NetLongBare = &NetLongBare;
+    surf_bal.NetLongSnow = &TmpNetLongSnow;
+    surf_bal.T1 = &T1;
+    surf_bal.deltaH = &energy->deltaH;
+    surf_bal.fusion = &energy->fusion;
+    surf_bal.grnd_flux = &energy->grnd_flux;
+    surf_bal.latent_heat = &energy->latent;
+    surf_bal.latent_heat_sub = &energy->latent_sub;
+    surf_bal.sensible_heat = &energy->sensible;
+    surf_bal.snow_flux = &energy->snow_flux;
+    surf_bal.store_error = &energy->error;
+
     /**************************************************
        Find Surface Temperature Using Root Brent Method
     **************************************************/
@@ -300,35 +394,9 @@ calc_surf_energy_bal(double             Le,
             tmpNnodes = Nnodes;
         }
 
-        Tsurf = root_brent(T_lower, T_upper, func_surf_energy_bal,
-                           VEG, delta_t, Cs1, Cs2, D1, D2,
-                           T1_old, T2, Ts_old, energy->T, bubble, dp, expt,
-                           ice0, kappa1, kappa2, max_moist, moist, root,
-                           CanopLayerBnd, UnderStory, overstory, NetShortBare,
-                           NetShortGrnd, TmpNetShortSnow, Tair, atmos_density,
-                           atmos_pressure, emissivity, LongBareIn, LongSnowIn,
-                           surf_atten, VPcanopy, VPDcanopy, atmos_shortwave,
-                           atmos_Catm, dryFrac, &Wdew, displacement,
-                           aero_resist, aero_resist_veg, aero_resist_used,
-                           rainfall, ref_height,
-                           roughness, wind, Le, energy->advection, OldTSurf,
-                           Tsnow_surf, kappa_snow, melt_energy, snow_coverage,
-                           snow->density, snow->swq, snow->surf_water,
-                           &energy->deltaCC, &energy->refreeze_energy,
-                           &snow->vapor_flux, &snow->blowing_flux,
-                           &snow->surface_flux, tmpNnodes, Cs_node, T_node,
-                           Tnew_node, Tnew_fbflag, Tnew_fbcount, alpha, beta,
-                           bubble_node, Zsum_node, expt_node, gamma, ice_node,
-                           kappa_node, max_moist_node, moist_node, soil_con,
-                           layer, veg_var, veg_lib, INCLUDE_SNOW,
-                           options.NOFLUX,
-                           options.EXP_TRANS,
-                           snow->snow, FIRST_SOLN, &NetLongBare,
-                           &TmpNetLongSnow, &T1, &energy->deltaH,
-                           &energy->fusion, &energy->grnd_flux,
-                           &energy->latent, &energy->latent_sub,
-                           &energy->sensible, &energy->snow_flux,
-                           &energy->error);
+        surf_bal.Nnodes = tmpNnodes;
+        Tsurf = root_brent_guess(T_lower, T_upper, Ts_old, func_surf_energy_bal,
+                                 &surf_bal);
 
         if (Tsurf <= -998) {
             if (options.TFALLBACK) {
@@ -338,77 +406,8 @@ calc_surf_energy_bal(double             Le,
             }
             else {
                 log_info("SURF_DT = %.2f", param.SURF_DT);
-                error = error_calc_surf_energy_bal(Tsurf, (int) dmy->year,
-                                                   (int) dmy->month,
-                                                   (int) dmy->day,
-                                                   (int) dmy->dayseconds,
-                                                   VEG, iveg,
-                                                   delta_t, Cs1, Cs2,
-                                                   D1, D2,
-                                                   T1_old, T2, Ts_old,
-                                                   energy->T,
-                                                   soil_con->b_infilt, bubble,
-                                                   dp,
-                                                   expt, ice0, kappa1, kappa2,
-                                                   soil_con->max_infil,
-                                                   max_moist,
-                                                   moist, &(Wcr_array[0]),
-                                                   soil_con->Wpwp,
-                                                   soil_con->depth,
-                                                   soil_con->resid_moist, root,
-                                                   CanopLayerBnd,
-                                                   UnderStory, overstory,
-                                                   NetShortBare,
-                                                   NetShortGrnd,
-                                                   TmpNetShortSnow, Tair,
-                                                   atmos_density,
-                                                   atmos_pressure,
-                                                   soil_con->elevation,
-                                                   emissivity, LongBareIn,
-                                                   LongSnowIn,
-                                                   surf_atten, VPcanopy,
-                                                   VPDcanopy,
-                                                   atmos_shortwave, atmos_Catm,
-                                                   dryFrac,
-                                                   &Wdew, displacement,
-                                                   aero_resist,
-                                                   aero_resist_veg,
-                                                   aero_resist_used,
-                                                   rainfall, ref_height,
-                                                   roughness,
-                                                   wind, Le, energy->advection,
-                                                   OldTSurf, snow->pack_temp,
-                                                   Tsnow_surf,
-                                                   kappa_snow, melt_energy,
-                                                   snow_coverage, snow->density,
-                                                   snow->swq, snow->surf_water,
-                                                   &energy->deltaCC,
-                                                   &energy->refreeze_energy,
-                                                   &snow->vapor_flux, Nnodes,
-                                                   Cs_node,
-                                                   T_node, Tnew_node, alpha,
-                                                   beta,
-                                                   bubble_node, Zsum_node,
-                                                   expt_node,
-                                                   gamma, ice_node, kappa_node,
-                                                   max_moist_node, moist_node,
-                                                   soil_con->frost_fract,
-                                                   layer, veg_var, veg_lib,
-                                                   INCLUDE_SNOW,
-                                                   soil_con->FS_ACTIVE,
-                                                   options.NOFLUX,
-                                                   options.EXP_TRANS,
-                                                   snow->snow, FIRST_SOLN,
-                                                   &NetLongBare,
-                                                   &TmpNetLongSnow, &T1,
-                                                   &energy->deltaH,
-                                                   &energy->fusion,
-                                                   &energy->grnd_flux,
-                                                   &energy->latent,
-                                                   &energy->latent_sub,
-                                                   &energy->sensible,
-                                                   &energy->snow_flux,
-                                                   &energy->error);
+                error = error_print_surf_energy_bal(Tsurf, dmy, iveg,
+                                                    snow->pack_temp, &surf_bal);
                 return (ERROR);
             }
         }
@@ -419,39 +418,11 @@ calc_surf_energy_bal(double             Le,
 
         if (Ts_old * Tsurf < 0 && options.QUICK_SOLVE) {
             tmpNnodes = Nnodes;
-            FIRST_SOLN[0] = true;
-
-            Tsurf = root_brent(T_lower, T_upper,
-                               func_surf_energy_bal, VEG,
-                               delta_t, Cs1, Cs2, D1, D2, T1_old, T2, Ts_old,
-                               energy->T, bubble, dp, expt, ice0, kappa1,
-                               kappa2, max_moist, moist, root, CanopLayerBnd,
-                               UnderStory, overstory, NetShortBare,
-                               NetShortGrnd,
-                               TmpNetShortSnow, Tair, atmos_density,
-                               atmos_pressure, emissivity, LongBareIn,
-                               LongSnowIn, surf_atten, VPcanopy, VPDcanopy,
-                               atmos_shortwave, atmos_Catm, dryFrac, &Wdew,
-                               displacement, aero_resist, aero_resist_veg,
-                               aero_resist_used,
-                               rainfall, ref_height, roughness, wind, Le,
-                               energy->advection, OldTSurf, Tsnow_surf,
-                               kappa_snow, melt_energy, snow_coverage,
-                               snow->density, snow->swq, snow->surf_water,
-                               &energy->deltaCC, &energy->refreeze_energy,
-                               &snow->vapor_flux, &snow->blowing_flux,
-                               &snow->surface_flux, tmpNnodes, Cs_node, T_node,
-                               Tnew_node, Tnew_fbflag, Tnew_fbcount, alpha,
-                               beta, bubble_node, Zsum_node, expt_node, gamma,
-                               ice_node, kappa_node, max_moist_node,
-                               moist_node, soil_con, layer, veg_var, veg_lib,
-                               INCLUDE_SNOW, options.NOFLUX, options.EXP_TRANS,
-                               snow->snow,
-                               FIRST_SOLN, &NetLongBare, &TmpNetLongSnow, &T1,
-                               &energy->deltaH, &energy->fusion,
-                               &energy->grnd_flux, &energy->latent,
-                               &energy->latent_sub, &energy->sensible,
-                               &energy->snow_flux, &energy->error);
+            surf_bal.Nnodes = tmpNnodes;
+            soil_solver.FIRST_SOLN[0] = true;
+
+            Tsurf = root_brent_guess(T_lower, T_upper, Ts_old,
+                                     func_surf_energy_bal, &surf_bal);
 
             if (Tsurf <= -998) {
                 if (options.TFALLBACK) {
@@ -460,83 +431,9 @@ calc_surf_energy_bal(double             Le,
                     Tsurf_fbcount++;
                 }
                 else {
-                    error = error_calc_surf_energy_bal(Tsurf, (int) dmy->year,
-                                                       (int) dmy->month,
-                                                       (int) dmy->day,
-                                                       (int) dmy->dayseconds,
-                                                       VEG, iveg,
-                                                       delta_t, Cs1,
-                                                       Cs2, D1,
-                                                       D2, T1_old, T2, Ts_old,
-                                                       energy->T,
-                                                       soil_con->b_infilt,
-                                                       bubble, dp,
-                                                       expt, ice0, kappa1,
-                                                       kappa2,
-                                                       soil_con->max_infil,
-                                                       max_moist,
-                                                       moist, &(Wcr_array[0]),
-                                                       soil_con->Wpwp,
-                                                       soil_con->depth,
-                                                       soil_con->resid_moist,
-                                                       root, CanopLayerBnd,
-                                                       UnderStory, overstory,
-                                                       NetShortBare,
-                                                       NetShortGrnd,
-                                                       TmpNetShortSnow, Tair,
-                                                       atmos_density,
-                                                       atmos_pressure,
-                                                       soil_con->elevation,
-                                                       emissivity, LongBareIn,
-                                                       LongSnowIn,
-                                                       surf_atten, VPcanopy,
-                                                       VPDcanopy,
-                                                       atmos_shortwave,
-                                                       atmos_Catm, dryFrac,
-                                                       &Wdew, displacement,
-                                                       aero_resist,
-                                                       aero_resist_veg,
-                                                       aero_resist_used,
-                                                       rainfall, ref_height,
-                                                       roughness, wind, Le,
-                                                       energy->advection,
-                                                       OldTSurf,
-                                                       snow->pack_temp,
-                                                       Tsnow_surf,
-                                                       kappa_snow, melt_energy,
-                                                       snow_coverage,
-                                                       snow->density,
-                                                       snow->swq,
-                                                       snow->surf_water,
-                                                       &energy->deltaCC,
-                                                       &energy->refreeze_energy,
-                                                       &snow->vapor_flux,
-                                                       Nnodes, Cs_node,
-                                                       T_node, Tnew_node, alpha,
-                                                       beta,
-                                                       bubble_node, Zsum_node,
-                                                       expt_node,
-                                                       gamma, ice_node,
-                                                       kappa_node,
-                                                       max_moist_node,
-                                                       moist_node,
-                                                       soil_con->frost_fract,
-                                                       layer, veg_var, veg_lib,
-                                                       INCLUDE_SNOW,
-                                                       soil_con->FS_ACTIVE,
-                                                       options.NOFLUX,
-                                                       options.EXP_TRANS,
-                                                       snow->snow, FIRST_SOLN,
-                                                       &NetLongBare,
-                                                       &TmpNetLongSnow, &T1,
-                                                       &energy->deltaH,
-                                                       &energy->fusion,
-                                                       &energy->grnd_flux,
-                                                       &energy->latent,
-                                                       &energy->latent_sub,
-                                                       &energy->sensible,
-                                                       &energy->snow_flux,
-                                                       &energy->error);
+                    error = error_print_surf_energy_bal(Tsurf, dmy, iveg,
+                                                        snow->pack_temp,
+                                                        &surf_bal);
                     return (ERROR);
                 }
             }
@@ -549,41 +446,11 @@ calc_surf_energy_bal(double             Le,
 
     if (options.QUICK_SOLVE && !options.QUICK_FLUX) {
         // Reset model so that it solves thermal fluxes for full soil column
-        FIRST_SOLN[0] = true;
+        soil_solver.FIRST_SOLN[0] = true;
     }
 
-    error = solve_surf_energy_bal(Tsurf, VEG, delta_t, Cs1,
-                                  Cs2, D1, D2, T1_old, T2, Ts_old, energy->T,
-                                  bubble, dp, expt, ice0, kappa1, kappa2,
-                                  max_moist, moist, root, CanopLayerBnd,
-                                  UnderStory, overstory, NetShortBare,
-                                  NetShortGrnd, TmpNetShortSnow, Tair,
-                                  atmos_density, atmos_pressure, emissivity,
-                                  LongBareIn, LongSnowIn, surf_atten, VPcanopy,
-                                  VPDcanopy, atmos_shortwave, atmos_Catm,
-                                  dryFrac, &Wdew, displacement, aero_resist,
-                                  aero_resist_veg, aero_resist_used, rainfall,
-                                  ref_height,
-                                  roughness, wind, Le, energy->advection,
-                                  OldTSurf, Tsnow_surf, kappa_snow,
-                                  melt_energy, snow_coverage, snow->density,
-                                  snow->swq, snow->surf_water,
-                                  &energy->deltaCC, &energy->refreeze_energy,
-                                  &snow->vapor_flux, &snow->blowing_flux,
-                                  &snow->surface_flux, (int) Nnodes, Cs_node,
-                                  T_node, Tnew_node, Tnew_fbflag, Tnew_fbcount,
-                                  alpha, beta, bubble_node, Zsum_node,
-                                  expt_node, gamma, ice_node, kappa_node,
-                                  max_moist_node, moist_node, soil_con, layer,
-                                  veg_var, veg_lib, INCLUDE_SNOW,
-                                  options.NOFLUX,
-                                  options.EXP_TRANS,
-                                  snow->snow, FIRST_SOLN, &NetLongBare,
-                                  &TmpNetLongSnow, &T1, &energy->deltaH,
-                                  &energy->fusion, &energy->grnd_flux,
-                                  &energy->latent, &energy->latent_sub,
-                                  &energy->sensible, &energy->snow_flux,
-                                  &energy->error);
+    surf_bal.Nnodes = (int) Nnodes;
+    error = func_surf_energy_bal(Tsurf, &surf_bal);
     if (error == ERROR) {
         return(ERROR);
     }
@@ -758,49 +625,15 @@ calc_surf_energy_bal(double             Le,
     return (Tsurf);
 }
 
-/******************************************************************************
- * @brief    Dummy function to allow calling func_surf_energy_bal() directly.
- *****************************************************************************/
-double
-solve_surf_energy_bal(double Tsurf,
-                      ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tsurf);
-    error = func_surf_energy_bal(Tsurf, ap);
-    va_end(ap);
-
-    return error;
-}
-
-/******************************************************************************
- * @brief    Dummy function to allow calling error_print_surf_energy_bal()
- *           directly.
- *****************************************************************************/
-double
-error_calc_surf_energy_bal(double Tsurf,
-                           ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tsurf);
-    error = error_print_surf_energy_bal(Tsurf, ap);
-    va_end(ap);
-
-    return error;
-}
-
 /******************************************************************************
  * @brief    Print energy balance terms.
  *****************************************************************************/
 double
-error_print_surf_energy_bal(double  Ts,
-                            va_list ap)
+error_print_surf_energy_bal(double                  Ts,
+                            dmy_struct             *dmy,
+                            int                     iveg,
+                            double                  TPack,
+                            surf_energy_bal_struct *bal)
 {
     extern option_struct options;
 
@@ -809,7 +642,6 @@ error_print_surf_energy_bal(double  Ts,
     /* general model terms */
     int                year, month, day;
     int                sec;
-    int                iveg;
     int                VEG;
 
     double             delta_t;
@@ -861,7 +693,7 @@ error_print_surf_energy_bal(double  Ts,
     double             vpd;
     double             atmos_shortwave;
     double             atmos_Catm;
-    double             dryFrac;
+    double            *dryFrac;
 
     double            *Wdew;
     double            *displacement;
@@ -879,7 +711,6 @@ error_print_surf_energy_bal(double  Ts,
     /* snowpack terms */
     double             Advection;
     double             OldTSurf;
-    double             TPack;
     double             Tsnow_surf;
     double             kappa_snow;
     double             melt_energy;
@@ -948,137 +779,135 @@ error_print_surf_energy_bal(double  Ts,
     ***************************/
 
     /* general model terms */
-    year = (int) va_arg(ap, int);
-    month = (int) va_arg(ap, int);
-    day = (int) va_arg(ap, int);
-    sec = (int) va_arg(ap, int);
-    VEG = (int) va_arg(ap, int);
-    iveg = (int) va_arg(ap, int);
+    year = (int) dmy->year;
+    month = (int) dmy->month;
+    day = (int) dmy->day;
+    sec = (int) dmy->dayseconds;
+    VEG = bal->VEG;
 
-    delta_t = (double) va_arg(ap, double);
+    delta_t = bal->delta_t;
 
     /* soil layer terms */
-    Cs1 = (double) va_arg(ap, double);
-    Cs2 = (double) va_arg(ap, double);
-    D1 = (double) va_arg(ap, double);
-    D2 = (double) va_arg(ap, double);
-    T1_old = (double) va_arg(ap, double);
-    T2 = (double) va_arg(ap, double);
-    Ts_old = (double) va_arg(ap, double);
-    Told_node = (double *) va_arg(ap, double *);
-    b_infilt = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    dp = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    kappa1 = (double) va_arg(ap, double);
-    kappa2 = (double) va_arg(ap, double);
-    max_infil = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    depth = (double *) va_arg(ap, double *);
-    resid_moist = (double *) va_arg(ap, double *);
-
-    root = (double  *) va_arg(ap, double  *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    Cs1 = bal->Cs1;
+    Cs2 = bal->Cs2;
+    D1 = bal->D1;
+    D2 = bal->D2;
+    T1_old = bal->T1_old;
+    T2 = bal->T2;
+    Ts_old = bal->Ts_old;
+    Told_node = bal->Told_node;
+    b_infilt = bal->soil_con->b_infilt;
+    bubble = bal->bubble;
+    dp = bal->dp;
+    expt = bal->expt;
+    ice0 = bal->ice0;
+    kappa1 = bal->kappa1;
+    kappa2 = bal->kappa2;
+    max_infil = bal->soil_con->max_infil;
+    max_moist = bal->max_moist;
+    moist = bal->moist;
+
+    Wcr = &(bal->layer[0].Wcr);
+    Wpwp = bal->soil_con->Wpwp;
+    depth = bal->soil_con->depth;
+    resid_moist = bal->soil_con->resid_moist;
+
+    root = bal->root;
+    CanopLayerBnd = bal->CanopLayerBnd;
 
     /* meteorological forcing terms */
-    UnderStory = (int) va_arg(ap, int);
-    overstory = (int) va_arg(ap, int);
-
-    NetShortBare = (double) va_arg(ap, double);
-    NetShortGrnd = (double) va_arg(ap, double);
-    NetShortSnow = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    atmos_density = (double) va_arg(ap, double);
-    atmos_pressure = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
-    emissivity = (double) va_arg(ap, double);
-    LongBareIn = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    surf_atten = (double) va_arg(ap, double);
-    vp = (double) va_arg(ap, double);
-    vpd = (double) va_arg(ap, double);
-    atmos_shortwave = (double) va_arg(ap, double);
-    atmos_Catm = (double) va_arg(ap, double);
-    dryFrac = (double) va_arg(ap, double);
-
-    Wdew = (double *) va_arg(ap, double *);
-    displacement = (double *) va_arg(ap, double *);
-    ra = (double *) va_arg(ap, double *);
-    ra_veg = (double *) va_arg(ap, double *);
-    ra_used = (double *) va_arg(ap, double *);
-    rainfall = (double) va_arg(ap, double);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
-    wind = (double *) va_arg(ap, double *);
+    UnderStory = bal->UnderStory;
+    overstory = bal->overstory;
+
+    NetShortBare = bal->NetShortBare;
+    NetShortGrnd = bal->NetShortGrnd;
+    NetShortSnow = bal->NetShortSnow;
+    Tair = bal->Tair;
+    atmos_density = bal->atmos_density;
+    atmos_pressure = bal->atmos_pressure;
+    elevation = bal->soil_con->elevation;
+    emissivity = bal->emissivity;
+    LongBareIn = bal->LongBareIn;
+    LongSnowIn = bal->LongSnowIn;
+    surf_atten = bal->surf_atten;
+    vp = bal->vp;
+    vpd = bal->vpd;
+    atmos_shortwave = bal->shortwave;
+    atmos_Catm = bal->Catm;
+    dryFrac = bal->dryFrac;
+
+    Wdew = bal->Wdew;
+    displacement = bal->displacement;
+    ra = bal->ra;
+    ra_veg = bal->Ra_veg;
+    ra_used = bal->Ra_used;
+    rainfall = bal->rainfall;
+    ref_height = bal->ref_height;
+    roughness = bal->roughness;
+    wind = bal->wind;
 
     /* latent heat terms */
-    Le = (double) va_arg(ap, double);
+    Le = bal->Le;
 
     /* snowpack terms */
-    Advection = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    TPack = (double) va_arg(ap, double);
-    Tsnow_surf = (double) va_arg(ap, double);
-    kappa_snow = (double) va_arg(ap, double);
-    melt_energy = (double) va_arg(ap, double);
-    snow_coverage = (double) va_arg(ap, double);
-    snow_density = (double) va_arg(ap, double);
-    snow_swq = (double) va_arg(ap, double);
-    snow_water = (double) va_arg(ap, double);
-
-    deltaCC = (double *) va_arg(ap, double *);
-    refreeze_energy = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    Advection = bal->Advection;
+    OldTSurf = bal->OldTSurf;
+    Tsnow_surf = bal->Tsnow_surf;
+    kappa_snow = bal->kappa_snow;
+    melt_energy = bal->melt_energy;
+    snow_coverage = bal->snow_coverage;
+    snow_density = bal->snow_density;
+    snow_swq = bal->snow_swq;
+    snow_water = bal->snow_water;
+
+    deltaCC = bal->deltaCC;
+    refreeze_energy = bal->refreeze_energy;
+    VaporMassFlux = bal->vapor_flux;
 
     /* soil node terms */
-    Nnodes = (int) va_arg(ap, int);
-
-    Cs_node = (double *) va_arg(ap, double *);
-    T_node = (double *) va_arg(ap, double *);
-    Tnew_node = (double *) va_arg(ap, double *);
-    alpha = (double *) va_arg(ap, double *);
-    beta = (double *) va_arg(ap, double *);
-    bubble_node = (double *) va_arg(ap, double *);
-    Zsum_node = (double *) va_arg(ap, double *);
-    expt_node = (double *) va_arg(ap, double *);
-    gamma = (double *) va_arg(ap, double *);
-    ice_node = (double *) va_arg(ap, double *);
-    kappa_node = (double *) va_arg(ap, double *);
-    max_moist_node = (double *) va_arg(ap, double *);
-    moist_node = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Nnodes = bal->Nnodes;
+
+    Cs_node = bal->Cs_node;
+    T_node = bal->T_node;
+    Tnew_node = bal->Tnew_node;
+    alpha = bal->alpha;
+    beta = bal->beta;
+    bubble_node = bal->bubble_node;
+    Zsum_node = bal->Zsum_node;
+    expt_node = bal->expt_node;
+    gamma = bal->gamma;
+    ice_node = bal->ice_node;
+    kappa_node = bal->kappa_node;
+    max_moist_node = bal->max_moist_node;
+    moist_node = bal->moist_node;
+    frost_fract = bal->soil_con->frost_fract;
 
     /* model structures */
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
-    veg_lib = (veg_lib_struct *) va_arg(ap, veg_lib_struct *);
+    layer = bal->layer;
+    veg_var = bal->veg_var;
+    veg_lib = bal->veg_lib;
 
     /* control flags */
-    INCLUDE_SNOW = (int) va_arg(ap, int);
-    FS_ACTIVE = (int) va_arg(ap, int);
-    NOFLUX = (int) va_arg(ap, int);
-    EXP_TRANS = (int) va_arg(ap, int);
-    SNOWING = (int) va_arg(ap, int);
+    INCLUDE_SNOW = bal->INCLUDE_SNOW;
+    FS_ACTIVE = bal->soil_con->FS_ACTIVE;
+    NOFLUX = bal->NOFLUX;
+    EXP_TRANS = bal->EXP_TRANS;
+    SNOWING = bal->SNOWING;
 
-    FIRST_SOLN = (int *) va_arg(ap, int *);
+    FIRST_SOLN = bal->soil_solver->FIRST_SOLN;
 
     /* returned energy balance terms */
-    NetLongBare = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    T1 = (double *) va_arg(ap, double *);
-    deltaH = (double *) va_arg(ap, double *);
-    fusion = (double *) va_arg(ap, double *);
-    grnd_flux = (double *) va_arg(ap, double *);
-    latent_heat = (double *) va_arg(ap, double *);
-    latent_heat_sub = (double *) va_arg(ap, double *);
-    sensible_heat = (double *) va_arg(ap, double *);
-    snow_flux = (double *) va_arg(ap, double *);
-    store_error = (double *) va_arg(ap, double *);
+    NetLongBare = bal->NetLongBare;
+    NetLongSnow = bal->NetLongSnow;
+    T1 = bal->T1;
+    deltaH = bal->deltaH;
+    fusion = bal->fusion;
+    grnd_flux = bal->grnd_flux;
+    latent_heat = bal->latent_heat;
+    latent_heat_sub = bal->latent_heat_sub;
+    sensible_heat = bal->sensible_heat;
+    snow_flux = bal->snow_flux;
+    store_error = bal->store_error;
 
     /***************
        Main Routine
@@ -1144,7 +973,7 @@ error_print_surf_energy_bal(double  Ts,
     fprintf(LOG_DEST, "vpd = %f\n", vpd);
     fprintf(LOG_DEST, "atmos_shortwave = %f\n", atmos_shortwave);
     fprintf(LOG_DEST, "atmos_Catm = %f\n", atmos_Catm);
-    fprintf(LOG_DEST, "dryFrac = %f\n", dryFrac);
+    fprintf(LOG_DEST, "*dryFrac = %f\n", *dryFrac);
 
     fprintf(LOG_DEST, "*Wdew = %f\n", *Wdew);
     fprintf(LOG_DEST, "*displacement = %f\n", *displacement);
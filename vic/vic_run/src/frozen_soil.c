@@ -147,48 +147,47 @@ calc_layer_average_thermal_props(energy_bal_struct *energy,
  *           space, and first order in time.
  *****************************************************************************/
 int
-solve_T_profile(double   *T,
-                double   *T0,
-                char     *Tfbflag,
-                unsigned *Tfbcount,
-                double   *Zsum,
-                double   *kappa,
-                double   *Cs,
-                double   *moist,
-                double    deltat,
-                double   *max_moist,
-                double   *bubble,
-                double   *expt,
-                double   *ice,
-                double   *alpha,
-                double   *beta,
-                double   *gamma,
-                double    Dp,
-                int       Nnodes,
-                int      *FIRST_SOLN,
-                int       FS_ACTIVE,
-                int       NOFLUX,
-                int       EXP_TRANS)
+solve_T_profile(double                     *T,
+                double                     *T0,
+                char                       *Tfbflag,
+                unsigned                   *Tfbcount,
+                double                     *Zsum,
+                double                     *kappa,
+                double                     *Cs,
+                double                     *moist,
+                double                      deltat,
+                double                     *max_moist,
+                double                     *bubble,
+                double                     *expt,
+                double                     *ice,
+                double                     *alpha,
+                double                     *beta,
+                double                     *gamma,
+                double                      Dp,
+                int                         Nnodes,
+                soil_thermal_solver_struct *solver,
+                int                         FS_ACTIVE,
+                int                         NOFLUX,
+                int                         EXP_TRANS)
 {
     double *aa, *bb, *cc, *dd, *ee, Bexp;
     int     Error;
     int     j;
 
-    // TODO: remove use of static variables (see GH #735), for now:
-    // make static variables thread safe
-    static double A[MAX_NODES];
-    static double B[MAX_NODES];
-    static double C[MAX_NODES];
-    static double D[MAX_NODES];
-    static double E[MAX_NODES];
-    #pragma omp threadprivate(A, B, C, D, E)
+    // coefficients are kept in the solver context, which lives as long as
+    // the surface energy balance iteration that owns it
+    double *A = solver->A;
+    double *B = solver->B;
+    double *C = solver->C;
+    double *D = solver->D;
+    double *E = solver->E;
 
-    if (FIRST_SOLN[0]) {
+    if (solver->FIRST_SOLN[0]) {
         if (EXP_TRANS) {
             Bexp = logf(Dp + 1.) / (double) (Nnodes - 1);
         }
 
-        FIRST_SOLN[0] = false;
+        solver->FIRST_SOLN[0] = false;
         if (!EXP_TRANS) {
             for (j = 1; j < Nnodes - 1; j++) {
                 A[j] = Cs[j] * alpha[j - 1] * alpha[j - 1];
@@ -253,43 +252,42 @@ solve_T_profile(double   *T,
  *           space, and first order in time.
  *****************************************************************************/
 int
-solve_T_profile_implicit(double   *T,                               // update
-                         double   *T0,                        // keep
-                         char     *Tfbflag,
-                         unsigned *Tfbcount,
-                         double   *Zsum,                      // soil parameter
-                         double   *kappa,                     // update if necessary
-                         double   *Cs,                        // update if necessary
-                         double   *moist,                     // keep
-                         double    deltat,                    // model parameter
-                         double   *max_moist,                 // soil parameter
-                         double   *bubble,                    // soil parameter
-                         double   *expt,                      // soil parameter
-                         double   *ice,                       // update if necessary
-                         double   *alpha,                     // soil parameter
-                         double   *beta,                      // soil parameter
-                         double   *gamma,                     // soil parameter
-                         double    Dp,                        // soil parameter
-                         int       Nnodes,                   // model parameter
-                         int      *FIRST_SOLN,               // update
-                         int       NOFLUX,
-                         int       EXP_TRANS,
-                         double   *bulk_dens_min,              // soil parameter
-                         double   *soil_dens_min,              // soil parameter
-                         double   *quartz,                    // soil parameter
-                         double   *bulk_density,              // soil parameter
-                         double   *soil_density,              // soil parameter
-                         double   *organic,                    // soil parameter
-                         double   *depth)                     // soil parameter
+solve_T_profile_implicit(double                     *T,                               // update
+                         double                     *T0,                        // keep
+                         char                       *Tfbflag,
+                         unsigned                   *Tfbcount,
+                         double                     *Zsum,                      // soil parameter
+                         double                     *kappa,                     // update if necessary
+                         double                     *Cs,                        // update if necessary
+                         double                     *moist,                     // keep
+                         double                      deltat,                    // model parameter
+                         double                     *max_moist,                 // soil parameter
+                         double                     *bubble,                    // soil parameter
+                         double                     *expt,                      // soil parameter
+                         double                     *ice,                       // update if necessary
+                         double                     *alpha,                     // soil parameter
+                         double                     *beta,                      // soil parameter
+                         double                     *gamma,                     // soil parameter
+                         double                      Dp,                        // soil parameter
+                         int                         Nnodes,                   // model parameter
+                         soil_thermal_solver_struct *solver,                   // update
+                         int                         NOFLUX,
+                         int                         EXP_TRANS,
+                         double                     *bulk_dens_min,              // soil parameter
+                         double                     *soil_dens_min,              // soil parameter
+                         double                     *quartz,                    // soil parameter
+                         double                     *bulk_density,              // soil parameter
+                         double                     *soil_density,              // soil parameter
+                         double                     *organic,                    // soil parameter
+                         double                     *depth)                     // soil parameter
 {
     extern option_struct options;
     int                  n, Error;
-    double               res[MAX_NODES];
-    void                 (*vecfunc)(double *, double *, int, int, ...);
+    fda_heat_eqn_struct *heat_eqn = &(solver->heat_eqn);
     int                  j;
 
-    if (FIRST_SOLN[0]) {
-        FIRST_SOLN[0] = false;
+    if (solver->FIRST_SOLN[0]) {
+        solver->FIRST_SOLN[0] = false;
     }
 
     // initialize fda_heat_eqn:
@@ -302,15 +300,40 @@ solve_T_profile_implicit(double   *T,                               // update
         n = Nnodes - 1;
     }
 
-    fda_heat_eqn(&T[1], res, n, 1, deltat, NOFLUX, EXP_TRANS, T0,
-                 moist, ice, kappa, Cs, max_moist, bubble, expt,
-                 alpha, beta, gamma, Zsum, Dp, bulk_dens_min, soil_dens_min,
-                 quartz, bulk_density, soil_density, organic, depth,
-                 options.Nlayer);
+    heat_eqn->deltat = deltat;
+    heat_eqn->NOFLUX = NOFLUX;
+    heat_eqn->EXP_TRANS = EXP_TRANS;
+    heat_eqn->T0 = T0;
+    heat_eqn->moist = moist;
+    heat_eqn->ice = ice;
+    heat_eqn->kappa = kappa;
+    heat_eqn->Cs = Cs;
+    heat_eqn->max_moist = max_moist;
+    heat_eqn->bubble = bubble;
+    heat_eqn->expt = expt;
+    heat_eqn->alpha = alpha;
+    heat_eqn->beta = beta;
+    heat_eqn->gamma = gamma;
+    heat_eqn->Zsum = Zsum;
+    heat_eqn->Dp = Dp;
+    heat_eqn->bulk_dens_min = bulk_dens_min;
+    heat_eqn->soil_dens_min = soil_dens_min;
+    heat_eqn->quartz = quartz;
+    heat_eqn->bulk_density = bulk_density;
+    heat_eqn->soil_density = soil_density;
+    heat_eqn->organic = organic;
+    heat_eqn->depth = depth;
+    heat_eqn->Nlayers = options.Nlayer;
+    fda_heat_eqn_init(&T[1], n, heat_eqn);
 
     // modified Newton-Raphson to solve for new T
-    vecfunc = &(fda_heat_eqn);
-    Error = newt_raph(vecfunc, &T[1], n);
+    if (options.IMPLICIT_JACOBIAN == JACOBIAN_ANALYTIC) {
+        Error = newt_raph(fda_heat_eqn, fda_heat_eqn_jacobian, heat_eqn,
+                          &T[1], n);
+    }
+    else {
+        Error = newt_raph(fda_heat_eqn, NULL, heat_eqn, &T[1], n);
+    }
 
     // update temperature boundaries
     if (Error == 0) {
@@ -377,6 +400,7 @@ calc_soil_thermal_fluxes(int       Nnodes,
     double                   diff;
     double                   oldT;
     double                   Tlast[MAX_NODES];
+    soil_thermal_eqn_struct  eqn;
 
     Error = 0;
     Done = false;
@@ -418,12 +442,13 @@ calc_soil_thermal_fluxes(int       Nnodes,
                 }
             }
             else {
+                soil_thermal_eqn_set(&eqn, T[j + 1], T[j - 1], T0[j], moist[j],
+                                     max_moist[j], bubble[j], expt[j], ice[j],
+                                     A[j], B[j], C[j], D[j], E[j], EXP_TRANS,
+                                     j);
                 T[j] =
                     root_brent(T0[j] - (param.SOIL_DT), T0[j] + (param.SOIL_DT),
-                               soil_thermal_eqn,
-                               T[j + 1], T[j - 1], T0[j], moist[j],
-                               max_moist[j], bubble[j], expt[j], ice[j],
-                               A[j], B[j], C[j], D[j], E[j], EXP_TRANS, j);
+                               soil_thermal_eqn, &eqn);
                 if (T[j] <= -998) {
                     if (options.TFALLBACK) {
                         T[j] = T0[j];
@@ -431,13 +456,7 @@ calc_soil_thermal_fluxes(int       Nnodes,
                         Tfbcount[j]++;
                     }
                     else {
-                        error_solve_T_profile(T[j], T[j + 1], T[j - 1], T0[j],
-                                              moist[j],
-                                              max_moist[j], bubble[j], expt[j],
-                                              ice[j],
-                                              gamma[j - 1], A[j], B[j], C[j],
-                                              D[j],
-                                              E[j]);
+                        error_solve_T_profile(T[j], gamma[j - 1], &eqn);
                         return (ERROR);
                     }
                 }
@@ -470,17 +489,15 @@ calc_soil_thermal_fluxes(int       Nnodes,
                 }
             }
             else {
+                soil_thermal_eqn_set(&eqn, T[Nnodes - 1], T[Nnodes - 2],
+                                     T0[Nnodes - 1], moist[Nnodes - 1],
+                                     max_moist[Nnodes - 1], bubble[j],
+                                     expt[Nnodes - 1], ice[Nnodes - 1],
+                                     A[j], B[j], C[j], D[j], E[j], EXP_TRANS,
+                                     j);
                 T[Nnodes - 1] = root_brent(T0[Nnodes - 1] - param.SOIL_DT,
                                            T0[Nnodes - 1] + param.SOIL_DT,
-                                           soil_thermal_eqn,
-                                           T[Nnodes - 1],
-                                           T[Nnodes - 2], T0[Nnodes - 1],
-                                           moist[Nnodes - 1],
-                                           max_moist[Nnodes - 1],
-                                           bubble[j], expt[Nnodes - 1],
-                                           ice[Nnodes - 1],
-                                           A[j], B[j], C[j], D[j], E[j],
-                                           EXP_TRANS, j);
+                                           soil_thermal_eqn, &eqn);
                 if (T[j] <= -998) {
                     if (options.TFALLBACK) {
                         T[j] = T0[j];
@@ -488,14 +505,8 @@ calc_soil_thermal_fluxes(int       Nnodes,
                         Tfbcount[j]++;
                     }
                     else {
-                        error_solve_T_profile(T[Nnodes - 1], T[Nnodes - 1],
-                                              T[Nnodes - 2], T0[Nnodes - 1],
-                                              moist[Nnodes - 1],
-                                              max_moist[Nnodes - 1],
-                                              bubble[Nnodes - 1],
-                                              expt[Nnodes - 1], ice[Nnodes - 1],
-                                              gamma[Nnodes - 2],
-                                              A[j], B[j], C[j], D[j], E[j]);
+                        error_solve_T_profile(T[Nnodes - 1], gamma[Nnodes - 2],
+                                              &eqn);
                         return (ERROR);
                     }
                 }
@@ -556,79 +567,70 @@ calc_soil_thermal_fluxes(int       Nnodes,
 }
 
 /******************************************************************************
- * @brief    Dummy function to allow calling of error_print_solve_T_profile()
+ * @brief    Fill the single-node soil thermal equation passed to root_brent.
  *****************************************************************************/
-double
-error_solve_T_profile(double Tj,
-                      ...)
+void
+soil_thermal_eqn_set(soil_thermal_eqn_struct *eqn,
+                     double                   TL,
+                     double                   TU,
+                     double                   T0,
+                     double                   moist,
+                     double                   max_moist,
+                     double                   bubble,
+                     double                   expt,
+                     double                   ice0,
+                     double                   A,
+                     double                   B,
+                     double                   C,
+                     double                   D,
+                     double                   E,
+                     int                      EXP_TRANS,
+                     int                      node)
 {
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tj);
-    error = error_print_solve_T_profile(Tj, ap);
-    va_end(ap);
-
-    return error;
+    eqn->TL = TL;
+    eqn->TU = TU;
+    eqn->T0 = T0;
+    eqn->moist = moist;
+    eqn->max_moist = max_moist;
+    eqn->bubble = bubble;
+    eqn->expt = expt;
+    eqn->ice0 = ice0;
+    eqn->A = A;
+    eqn->B = B;
+    eqn->C = C;
+    eqn->D = D;
+    eqn->E = E;
+    eqn->EXP_TRANS = EXP_TRANS;
+    eqn->node = node;
 }
 
 /******************************************************************************
  * @brief    Print soil temperature terms.
  *****************************************************************************/
 double
-error_print_solve_T_profile(double  T,
-                            va_list ap)
+error_solve_T_profile(double                   T,
+                      double                   gamma,
+                      soil_thermal_eqn_struct *eqn)
 {
-    double TL;
-    double TU;
-    double T0;
-    double moist;
-    double max_moist;
-    double bubble;
-    double expt;
-    double ice0;
-    double gamma;
-    double A;
-    double B;
-    double C;
-    double D;
-    double E;
-
-    TL = (double) va_arg(ap, double);
-    TU = (double) va_arg(ap, double);
-    T0 = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    gamma = (double) va_arg(ap, double);
-    A = (double) va_arg(ap, double);
-    B = (double) va_arg(ap, double);
-    C = (double) va_arg(ap, double);
-    D = (double) va_arg(ap, double);
-    E = (double) va_arg(ap, double);
-
     log_warn("solve_T_profile failed to converge to a solution "
              "in root_brent.  Variable values will be dumped to the "
              "screen, check for invalid values.");
 
     fprintf(LOG_DEST, "T\t%f\n", T);
-    fprintf(LOG_DEST, "TL\t%f\n", TL);
-    fprintf(LOG_DEST, "TU\t%f\n", TU);
-    fprintf(LOG_DEST, "T0\t%f\n", T0);
-    fprintf(LOG_DEST, "moist\t%f\n", moist);
-    fprintf(LOG_DEST, "max_moist\t%f\n", max_moist);
-    fprintf(LOG_DEST, "bubble\t%f\n", bubble);
-    fprintf(LOG_DEST, "expt\t%f\n", expt);
-    fprintf(LOG_DEST, "ice0\t%f\n", ice0);
+    fprintf(LOG_DEST, "TL\t%f\n", eqn->TL);
+    fprintf(LOG_DEST, "TU\t%f\n", eqn->TU);
+    fprintf(LOG_DEST, "T0\t%f\n", eqn->T0);
+    fprintf(LOG_DEST, "moist\t%f\n", eqn->moist);
+    fprintf(LOG_DEST, "max_moist\t%f\n", eqn->max_moist);
+    fprintf(LOG_DEST, "bubble\t%f\n", eqn->bubble);
+    fprintf(LOG_DEST, "expt\t%f\n", eqn->expt);
+    fprintf(LOG_DEST, "ice0\t%f\n", eqn->ice0);
     fprintf(LOG_DEST, "gamma\t%f\n", gamma);
-    fprintf(LOG_DEST, "A\t%f\n", A);
-    fprintf(LOG_DEST, "B\t%f\n", B);
-    fprintf(LOG_DEST, "C\t%f\n", C);
-    fprintf(LOG_DEST, "D\t%f\n", D);
-    fprintf(LOG_DEST, "E\t%f\n", E);
+    fprintf(LOG_DEST, "A\t%f\n", eqn->A);
+    fprintf(LOG_DEST, "B\t%f\n", eqn->B);
+    fprintf(LOG_DEST, "C\t%f\n", eqn->C);
+    fprintf(LOG_DEST, "D\t%f\n", eqn->D);
+    fprintf(LOG_DEST, "E\t%f\n", eqn->E);
 
     log_warn("Finished dumping values for solve_T_profile.\n"
              "Try increasing SOIL_DT to get model to complete cell.\n"
@@ -637,392 +639,512 @@ error_print_solve_T_profile(double  T,
     return(ERROR);
 }
 
+/******************************************************************************
+ * @brief    Initialize the heat equation context for the implicit scheme: set
+ *           the boundary temperatures and the initial guess for the
+ *           Newton-Raphson search.
+ *****************************************************************************/
+void
+fda_heat_eqn_init(double               T_2[],
+                  int                  n,
+                  fda_heat_eqn_struct *heat_eqn)
+{
+    int i;
+
+    if (heat_eqn->EXP_TRANS) {
+        if (!heat_eqn->NOFLUX) {
+            heat_eqn->Bexp = logf(heat_eqn->Dp + 1.) / (double)(n + 1);
+        }
+        else {
+            heat_eqn->Bexp = logf(heat_eqn->Dp + 1.) / (double)(n);
+        }
+    }
+
+    heat_eqn->Ts = heat_eqn->T0[0];
+    if (!heat_eqn->NOFLUX) {
+        heat_eqn->Tb = heat_eqn->T0[n + 1];
+    }
+    else {
+        heat_eqn->Tb = heat_eqn->T0[n];
+    }
+    for (i = 0; i < n; i++) {
+        T_2[i] = heat_eqn->T0[i + 1];
+    }
+}
+
 /******************************************************************************
  * @brief    Heat Equation for implicit scheme (used to calculate residual of
  *           the heat equation) passed from solve_T_profile_implicit
+ * @details  params is the fda_heat_eqn_struct set up by fda_heat_eqn_init().
+ *           focus == -1 evaluates all residuals, otherwise only the entries
+ *           focus-1, focus and focus+1 are updated.
  *****************************************************************************/
 void
 fda_heat_eqn(double T_2[],
              double res[],
              int    n,
-             int    init,
-             ...)
+             int    focus,
+             void  *params)
 {
-    char    PAST_BOTTOM;
-    double  storage_term, flux_term, phase_term, flux_term1, flux_term2;
-    double  Lsum;
-    int     i;
-    size_t  lidx;
-    int     focus, left, right;
-
-    // argument list handling
-    va_list arg_addr;
-
-    // TODO: remove use of static variables (see GH #735), for now:
-    // make static variables thread safe
-    static double  deltat;
-    static int     NOFLUX;
-    static int     EXP_TRANS;
-    static double *T0;
-    static double *moist;
-    static double *ice;
-    static double *kappa;
-    static double *Cs;
-    static double *max_moist;
-    static double *bubble;
-    static double *expt;
-    static double *alpha;
-    static double *beta;
-    static double *gamma;
-    static double *Zsum;
-    static double  Dp;
-    static double *bulk_dens_min;
-    static double *soil_dens_min;
-    static double *quartz;
-    static double *bulk_density;
-    static double *soil_density;
-    static double *organic;
-    static double *depth;
-    static size_t  Nlayers;
-
-    // variables used to calculate residual of the heat equation
-    // defined here
-    static double Ts;
-    static double Tb;
-
-    // locally used variables
-    static double ice_new[MAX_NODES], Cs_new[MAX_NODES], kappa_new[MAX_NODES];
-    static double DT[MAX_NODES], DT_down[MAX_NODES], DT_up[MAX_NODES];
-    static double Dkappa[MAX_NODES];
-    static double Bexp;
-
-    #pragma omp threadprivate(deltat, NOFLUX, EXP_TRANS, T0, moist, ice, \
-    kappa, Cs, max_moist, bubble, expt, alpha, beta, gamma, Zsum, Dp, \
-    bulk_dens_min, soil_dens_min, quartz, bulk_density, soil_density, organic, \
-    depth, Nlayers, Ts, Tb, ice_new, Cs_new, kappa_new, DT, DT_down, DT_up, \
-    Dkappa, Bexp)
-
-    // initialize variables if init==1
-    if (init == 1) {
-        va_start(arg_addr, init);
-        deltat = va_arg(arg_addr, double);
-        NOFLUX = va_arg(arg_addr, int);
-        EXP_TRANS = va_arg(arg_addr, int);
-        T0 = va_arg(arg_addr, double *);
-        moist = va_arg(arg_addr, double *);
-        ice = va_arg(arg_addr, double *);
-        kappa = va_arg(arg_addr, double *);
-        Cs = va_arg(arg_addr, double *);
-        max_moist = va_arg(arg_addr, double *);
-        bubble = va_arg(arg_addr, double *);
-        expt = va_arg(arg_addr, double *);
-        alpha = va_arg(arg_addr, double *);
-        beta = va_arg(arg_addr, double *);
-        gamma = va_arg(arg_addr, double *);
-        Zsum = va_arg(arg_addr, double *);
-        Dp = va_arg(arg_addr, double);
-        bulk_dens_min = va_arg(arg_addr, double *);
-        soil_dens_min = va_arg(arg_addr, double *);
-        quartz = va_arg(arg_addr, double *);
-        bulk_density = va_arg(arg_addr, double *);
-        soil_density = va_arg(arg_addr, double *);
-        organic = va_arg(arg_addr, double *);
-        depth = va_arg(arg_addr, double *);
-        Nlayers = va_arg(arg_addr, size_t);
+    fda_heat_eqn_struct *heat_eqn = (fda_heat_eqn_struct *) params;
+
+    char                 PAST_BOTTOM;
+    double               storage_term, flux_term, phase_term, flux_term1,
+                         flux_term2;
+    double               Lsum;
+    int                  i;
+    size_t               lidx;
+    int                  left, right;
+
+    double               deltat = heat_eqn->deltat;
+    int                  NOFLUX = heat_eqn->NOFLUX;
+    int                  EXP_TRANS = heat_eqn->EXP_TRANS;
+    double              *T0 = heat_eqn->T0;
+    double              *moist = heat_eqn->moist;
+    double              *ice = heat_eqn->ice;
+    double              *kappa = heat_eqn->kappa;
+    double              *Cs = heat_eqn->Cs;
+    double              *max_moist = heat_eqn->max_moist;
+    double              *bubble = heat_eqn->bubble;
+    double              *expt = heat_eqn->expt;
+    double              *alpha = heat_eqn->alpha;
+    double              *beta = heat_eqn->beta;
+    double              *gamma = heat_eqn->gamma;
+    double              *Zsum = heat_eqn->Zsum;
+    double              *bulk_dens_min = heat_eqn->bulk_dens_min;
+    double              *soil_dens_min = heat_eqn->soil_dens_min;
+    double              *quartz = heat_eqn->quartz;
+    double              *bulk_density = heat_eqn->bulk_density;
+    double              *soil_density = heat_eqn->soil_density;
+    double              *organic = heat_eqn->organic;
+    double              *depth = heat_eqn->depth;
+    size_t               Nlayers = heat_eqn->Nlayers;
+    double               Ts = heat_eqn->Ts;
+    double               Tb = heat_eqn->Tb;
+    double               Bexp = heat_eqn->Bexp;
+
+    // workspace kept in the context between full and focused evaluations
+    double              *ice_new = heat_eqn->ice_new;
+    double              *Cs_new = heat_eqn->Cs_new;
+    double              *kappa_new = heat_eqn->kappa_new;
+    double              *DT = heat_eqn->DT;
+    double              *DT_down = heat_eqn->DT_down;
+    double              *DT_up = heat_eqn->DT_up;
+    double              *Dkappa = heat_eqn->Dkappa;
+
+    // calculate all entries if focus == -1
+    if (focus == -1) {
+        lidx = 0;
+        Lsum = 0.;
+        PAST_BOTTOM = false;
+
+        for (i = 0; i < n + 1; i++) {
+            kappa_new[i] = kappa[i];
+            if (i >= 1) { // all but surface node
+                // update ice contents
+                if (T_2[i - 1] < 0) {
+                    ice_new[i] = moist[i] - maximum_unfrozen_water(
+                        T_2[i - 1],
+                        max_moist[
+                            i], bubble[i], expt[i]);
+                    if (ice_new[i] < 0) {
+                        ice_new[i] = 0;
+                    }
+                }
+                else {
+                    ice_new[i] = 0;
+                }
+                Cs_new[i] = Cs[i];
+
+                // update other states due to ice content change
+                /***********************************************/
+                if (ice_new[i] != ice[i]) {
+                    kappa_new[i] = soil_conductivity(moist[i],
+                                                     moist[i] - ice_new[i],
+                                                     soil_dens_min[lidx],
+                                                     bulk_dens_min[lidx],
+                                                     quartz[lidx],
+                                                     soil_density[lidx],
+                                                     bulk_density[lidx],
+                                                     organic[lidx]);
+                    Cs_new[i] = volumetric_heat_capacity(
+                        bulk_density[lidx] / soil_density[lidx],
+                        moist[i] - ice_new[i], ice_new[i], organic[lidx]);
+                }
+                /************************************************/
+            }
 
-        if (EXP_TRANS) {
-            if (!NOFLUX) {
-                Bexp = logf(Dp + 1.) / (double)(n + 1);
+            if (Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
+                Lsum += depth[lidx];
+                lidx++;
+                if (lidx == Nlayers) {
+                    PAST_BOTTOM = true;
+                    lidx = Nlayers - 1;
+                }
+            }
+        }
+
+        // constants used in fda equation
+        for (i = 0; i < n; i++) {
+            if (i == 0) {
+                DT[i] = T_2[i + 1] - Ts;
+                DT_up[i] = T_2[i] - Ts;
+                DT_down[i] = T_2[i + 1] - T_2[i];
+            }
+            else if (i == n - 1) {
+                DT[i] = Tb - T_2[i - 1];
+                DT_up[i] = T_2[i] - T_2[i - 1];
+                DT_down[i] = Tb - T_2[i];
+            }
+            else {
+                DT[i] = T_2[i + 1] - T_2[i - 1];
+                DT_up[i] = T_2[i] - T_2[i - 1];
+                DT_down[i] = T_2[i + 1] - T_2[i];
+            }
+            if (i < n - 1) {
+                Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
+            }
+            else if (!NOFLUX) {
+                Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
             }
             else {
-                Bexp = logf(Dp + 1.) / (double)(n);
+                Dkappa[i] = kappa_new[i + 1] - kappa_new[i];
             }
         }
 
-        Ts = T0[0];
-        if (!NOFLUX) {
-            Tb = T0[n + 1];
-        }
-        else {
-            Tb = T0[n];
-        }
         for (i = 0; i < n; i++) {
-            T_2[i] = T0[i + 1];
+            storage_term =
+                Cs_new[i +
+                       1] *
+                (T_2[i] -
+                 T0[i +
+                    1]) / deltat + T_2[i] *
+                (Cs_new[i + 1] - Cs[i + 1]) / deltat;
+            if (!EXP_TRANS) {
+                flux_term1 = Dkappa[i] / alpha[i] * DT[i] / alpha[i];
+                flux_term2 =
+                    kappa_new[i +
+                              1] *
+                    (DT_down[i] / gamma[i] - DT_up[i] /
+                     beta[i]) / (0.5 * alpha[i]);
+            }
+            else { // grid transformation
+                flux_term1 = Dkappa[i] / 2. * DT[i] / 2. /
+                             (Bexp *
+                              (Zsum[i +
+                                    1] + 1.)) / (Bexp * (Zsum[i + 1] + 1.));
+                flux_term2 =
+                    kappa_new[i +
+                              1] *
+                    ((DT_down[i] -
+                      DT_up[i]) /
+                     (Bexp *
+                      (Zsum[i +
+                            1] +
+                       1.)) /
+                     (Bexp *
+                      (Zsum[i +
+                            1] +
+                       1.)) - DT[i] / 2. /
+                     (Bexp * (Zsum[i + 1] + 1.) * (Zsum[i + 1] + 1.)));
+            }
+            // inelegant fix for "cold nose" problem - when a very cold node skates off to
+            // much colder and breaks the second law of thermodynamics (because
+            // flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
+            // that node get any colder.  This only seems to happen in the first and
+            // second near-surface nodes.
+            flux_term = flux_term1 + flux_term2;
+            phase_term = CONST_RHOICE * CONST_LATICE *
+                         (ice_new[i + 1] - ice[i + 1]) / deltat;
+            res[i] = flux_term + phase_term - storage_term;
         }
     }
-    // calculate residuals if init==0
+    // only calculate entries focus-1, focus, and focus+1 if focus has a value>=0
     else {
-        // get the range of columns to calculate
-        va_start(arg_addr, init);
-        focus = va_arg(arg_addr, int);
-
-        // calculate all entries if focus == -1
-        if (focus == -1) {
-            lidx = 0;
-            Lsum = 0.;
-            PAST_BOTTOM = false;
-
-            for (i = 0; i < n + 1; i++) {
-                kappa_new[i] = kappa[i];
-                if (i >= 1) { // all but surface node
-                    // update ice contents
-                    if (T_2[i - 1] < 0) {
-                        ice_new[i] = moist[i] - maximum_unfrozen_water(
-                            T_2[i - 1],
-                            max_moist[
-                                i], bubble[i], expt[i]);
-                        if (ice_new[i] < 0) {
-                            ice_new[i] = 0;
-                        }
-                    }
-                    else {
-                        ice_new[i] = 0;
-                    }
-                    Cs_new[i] = Cs[i];
-
-                    // update other states due to ice content change
-                    /***********************************************/
-                    if (ice_new[i] != ice[i]) {
-                        kappa_new[i] = soil_conductivity(moist[i],
-                                                         moist[i] - ice_new[i],
-                                                         soil_dens_min[lidx],
-                                                         bulk_dens_min[lidx],
-                                                         quartz[lidx],
-                                                         soil_density[lidx],
-                                                         bulk_density[lidx],
-                                                         organic[lidx]);
-                        Cs_new[i] = volumetric_heat_capacity(
-                            bulk_density[lidx] / soil_density[lidx],
-                            moist[i] - ice_new[i], ice_new[i], organic[lidx]);
-                    }
-                    /************************************************/
-                }
+        if (focus == 0) {
+            left = 0;
+        }
+        else {
+            left = focus - 1;
+        }
+        if (focus == n - 1) {
+            right = n - 1;
+        }
+        else {
+            right = focus + 1;
+        }
 
-                if (Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-                    Lsum += depth[lidx];
-                    lidx++;
-                    if (lidx == Nlayers) {
-                        PAST_BOTTOM = true;
-                        lidx = Nlayers - 1;
-                    }
+        // update ice content for node focus and its adjacents
+        for (i = left; i <= right; i++) {
+            if (T_2[i] < 0) {
+                ice_new[i + 1] = moist[i + 1] - maximum_unfrozen_water(
+                    T_2[i],
+                    max_moist[
+                        i + 1], bubble[i + 1], expt[i + 1]);
+                if (ice_new[i + 1] < 0) {
+                    ice_new[i + 1] = 0;
                 }
             }
-
-            // constants used in fda equation
-            for (i = 0; i < n; i++) {
-                if (i == 0) {
-                    DT[i] = T_2[i + 1] - Ts;
-                    DT_up[i] = T_2[i] - Ts;
-                    DT_down[i] = T_2[i + 1] - T_2[i];
-                }
-                else if (i == n - 1) {
-                    DT[i] = Tb - T_2[i - 1];
-                    DT_up[i] = T_2[i] - T_2[i - 1];
-                    DT_down[i] = Tb - T_2[i];
-                }
-                else {
-                    DT[i] = T_2[i + 1] - T_2[i - 1];
-                    DT_up[i] = T_2[i] - T_2[i - 1];
-                    DT_down[i] = T_2[i + 1] - T_2[i];
-                }
-                if (i < n - 1) {
-                    Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
-                }
-                else if (!NOFLUX) {
-                    Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
-                }
-                else {
-                    Dkappa[i] = kappa_new[i + 1] - kappa_new[i];
-                }
+            else {
+                ice_new[i + 1] = 0;
             }
+        }
 
-            for (i = 0; i < n; i++) {
-                storage_term =
-                    Cs_new[i +
-                           1] *
-                    (T_2[i] -
-                     T0[i +
-                        1]) / deltat + T_2[i] *
-                    (Cs_new[i + 1] - Cs[i + 1]) / deltat;
-                if (!EXP_TRANS) {
-                    flux_term1 = Dkappa[i] / alpha[i] * DT[i] / alpha[i];
-                    flux_term2 =
-                        kappa_new[i +
-                                  1] *
-                        (DT_down[i] / gamma[i] - DT_up[i] /
-                         beta[i]) / (0.5 * alpha[i]);
+        // update other parameters due to ice content change
+        /********************************************************/
+        lidx = 0;
+        Lsum = 0.;
+        PAST_BOTTOM = false;
+        for (i = 0; i <= right + 1; i++) {
+            if (i >= left + 1) {
+                if (ice_new[i] != ice[i]) {
+                    kappa_new[i] = soil_conductivity(moist[i],
+                                                     moist[i] - ice_new[i],
+                                                     soil_dens_min[lidx],
+                                                     bulk_dens_min[lidx],
+                                                     quartz[lidx],
+                                                     soil_density[lidx],
+                                                     bulk_density[lidx],
+                                                     organic[lidx]);
+                    Cs_new[i] = volumetric_heat_capacity(
+                        bulk_density[lidx] / soil_density[lidx],
+                        moist[i] - ice_new[i], ice_new[i], organic[lidx]);
                 }
-                else { // grid transformation
-                    flux_term1 = Dkappa[i] / 2. * DT[i] / 2. /
-                                 (Bexp *
-                                  (Zsum[i +
-                                        1] + 1.)) / (Bexp * (Zsum[i + 1] + 1.));
-                    flux_term2 =
-                        kappa_new[i +
-                                  1] *
-                        ((DT_down[i] -
-                          DT_up[i]) /
-                         (Bexp *
-                          (Zsum[i +
-                                1] +
-                           1.)) /
-                         (Bexp *
-                          (Zsum[i +
-                                1] +
-                           1.)) - DT[i] / 2. /
-                         (Bexp * (Zsum[i + 1] + 1.) * (Zsum[i + 1] + 1.)));
+            }
+            if (Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
+                Lsum += depth[lidx];
+                lidx++;
+                if (lidx == Nlayers) {
+                    PAST_BOTTOM = true;
+                    lidx = Nlayers - 1;
                 }
-                // inelegant fix for "cold nose" problem - when a very cold node skates off to
-                // much colder and breaks the second law of thermodynamics (because
-                // flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
-                // that node get any colder.  This only seems to happen in the first and
-                // second near-surface nodes.
-                flux_term = flux_term1 + flux_term2;
-                phase_term = CONST_RHOICE * CONST_LATICE *
-                             (ice_new[i + 1] - ice[i + 1]) / deltat;
-                res[i] = flux_term + phase_term - storage_term;
             }
         }
-        // only calculate entries focus-1, focus, and focus+1 if focus has a value>=0
-        else {
-            if (focus == 0) {
-                left = 0;
+        /*********************************************************/
+
+        // update other states due to ice content change
+        for (i = left; i <= right; i++) {
+            if (i == 0) {
+                DT[i] = T_2[i + 1] - Ts;
+                DT_up[i] = T_2[i] - Ts;
+                DT_down[i] = T_2[i + 1] - T_2[i];
+            }
+            else if (i == n - 1) {
+                DT[i] = Tb - T_2[i - 1];
+                DT_up[i] = T_2[i] - T_2[i - 1];
+                DT_down[i] = Tb - T_2[i];
             }
             else {
-                left = focus - 1;
+                DT[i] = T_2[i + 1] - T_2[i - 1];
+                DT_up[i] = T_2[i] - T_2[i - 1];
+                DT_down[i] = T_2[i + 1] - T_2[i];
             }
-            if (focus == n - 1) {
-                right = n - 1;
+            // update Dkappa due to ice content change
+            /*******************************************/
+            if (i < n - 1) {
+                Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
+            }
+            else if (!NOFLUX) {
+                Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
             }
             else {
-                right = focus + 1;
+                Dkappa[i] = kappa_new[i + 1] - kappa_new[i];
             }
+            /********************************************/
+        }
 
-            // update ice content for node focus and its adjacents
-            for (i = left; i <= right; i++) {
-                if (T_2[i] < 0) {
-                    ice_new[i + 1] = moist[i + 1] - maximum_unfrozen_water(
-                        T_2[i],
-                        max_moist[
-                            i + 1], bubble[i + 1], expt[i + 1]);
-                    if (ice_new[i + 1] < 0) {
-                        ice_new[i + 1] = 0;
-                    }
-                }
-                else {
-                    ice_new[i + 1] = 0;
-                }
+        for (i = left; i <= right; i++) {
+            storage_term =
+                Cs_new[i +
+                       1] *
+                (T_2[i] -
+                 T0[i +
+                    1]) / deltat + T_2[i] *
+                (Cs_new[i + 1] - Cs[i + 1]) / deltat;
+            if (!EXP_TRANS) {
+                flux_term1 = Dkappa[i] / alpha[i] * DT[i] / alpha[i];
+                flux_term2 =
+                    kappa_new[i +
+                              1] *
+                    (DT_down[i] / gamma[i] - DT_up[i] /
+                     beta[i]) / (0.5 * alpha[i]);
             }
+            else { // grid transformation
+                flux_term1 = Dkappa[i] / 2. * DT[i] / 2. /
+                             (Bexp *
+                              (Zsum[i +
+                                    1] + 1.)) / (Bexp * (Zsum[i + 1] + 1.));
+                flux_term2 =
+                    kappa_new[i +
+                              1] *
+                    ((DT_down[i] -
+                      DT_up[i]) /
+                     (Bexp *
+                      (Zsum[i +
+                            1] +
+                       1.)) /
+                     (Bexp *
+                      (Zsum[i +
+                            1] +
+                       1.)) - DT[i] / 2. /
+                     (Bexp * (Zsum[i + 1] + 1.) * (Zsum[i + 1] + 1.)));
+            }
+            // inelegant fix for "cold nose" problem - when a very cold node skates off to
+            // much colder and breaks the second law of thermodynamics (because
+            // flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
+            // that node get any colder.  This only seems to happen in the first and
+            // second near-surface nodes.
+            flux_term = flux_term1 + flux_term2;
+            phase_term = CONST_RHOICE * CONST_LATICE *
+                         (ice_new[i + 1] - ice[i + 1]) / deltat;
+            res[i] = flux_term + phase_term - storage_term;
+        }
+    } // end of calculation of focus node only
+}
 
-            // update other parameters due to ice content change
-            /********************************************************/
-            lidx = 0;
-            Lsum = 0.;
-            PAST_BOTTOM = false;
-            for (i = 0; i <= right + 1; i++) {
-                if (i >= left + 1) {
-                    if (ice_new[i] != ice[i]) {
-                        kappa_new[i] = soil_conductivity(moist[i],
-                                                         moist[i] - ice_new[i],
-                                                         soil_dens_min[lidx],
-                                                         bulk_dens_min[lidx],
-                                                         quartz[lidx],
-                                                         soil_density[lidx],
-                                                         bulk_density[lidx],
-                                                         organic[lidx]);
-                        Cs_new[i] = volumetric_heat_capacity(
-                            bulk_density[lidx] / soil_density[lidx],
-                            moist[i] - ice_new[i], ice_new[i], organic[lidx]);
-                    }
-                }
-                if (Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-                    Lsum += depth[lidx];
-                    lidx++;
-                    if (lidx == Nlayers) {
-                        PAST_BOTTOM = true;
-                        lidx = Nlayers - 1;
-                    }
-                }
+/******************************************************************************
+ * @brief    Analytic tridiagonal Jacobian of the implicit heat equation
+ *           residual (fda_heat_eqn).
+ * @details  a[i], b[i] and c[i] are the derivatives of res[i] with respect to
+ *           T_2[i-1], T_2[i] and T_2[i+1].  The node states (ice_new, Cs_new,
+ *           kappa_new, DT, DT_up, DT_down, Dkappa) are taken from the context,
+ *           so a full (focus == -1) residual evaluation at T_2 must precede
+ *           this call, as it does in newt_raph.
+ *****************************************************************************/
+void
+fda_heat_eqn_jacobian(double T_2[],
+                      double a[],
+                      double b[],
+                      double c[],
+                      int    n,
+                      void  *params)
+{
+    fda_heat_eqn_struct *heat_eqn = (fda_heat_eqn_struct *) params;
+
+    char                 PAST_BOTTOM;
+    double               Lsum;
+    int                  i, k;
+    size_t               lidx;
+    double               dice[MAX_NODES];
+    double               dCs[MAX_NODES];
+    double               dkappa[MAX_NODES];
+    double               flux1_coef;
+    double               flux2_term;
+    double               dDk_up, dDk, dDk_down;
+    double               Z2, W;
+
+    double               deltat = heat_eqn->deltat;
+    int                  NOFLUX = heat_eqn->NOFLUX;
+    int                  EXP_TRANS = heat_eqn->EXP_TRANS;
+    double              *T0 = heat_eqn->T0;
+    double              *moist = heat_eqn->moist;
+    double              *ice = heat_eqn->ice;
+    double              *Cs = heat_eqn->Cs;
+    double              *alpha = heat_eqn->alpha;
+    double              *beta = heat_eqn->beta;
+    double              *gamma = heat_eqn->gamma;
+    double              *Zsum = heat_eqn->Zsum;
+    double              *depth = heat_eqn->depth;
+    double               Bexp = heat_eqn->Bexp;
+    double              *ice_new = heat_eqn->ice_new;
+    double              *Cs_new = heat_eqn->Cs_new;
+    double              *kappa_new = heat_eqn->kappa_new;
+    double              *DT = heat_eqn->DT;
+    double              *DT_down = heat_eqn->DT_down;
+    double              *DT_up = heat_eqn->DT_up;
+    double              *Dkappa = heat_eqn->Dkappa;
+
+    // derivatives of the node states with respect to the node temperature,
+    // following the same layer walk as fda_heat_eqn
+    lidx = 0;
+    Lsum = 0.;
+    PAST_BOTTOM = false;
+    dice[0] = 0.;
+    dCs[0] = 0.;
+    dkappa[0] = 0.;
+    for (k = 0; k < n + 1; k++) {
+        if (k >= 1) {
+            dice[k] = 0.;
+            dCs[k] = 0.;
+            dkappa[k] = 0.;
+            if (ice_new[k] > 0.) {
+                dice[k] = -maximum_unfrozen_water_dT(T_2[k - 1],
+                                                     heat_eqn->max_moist[k],
+                                                     heat_eqn->bubble[k],
+                                                     heat_eqn->expt[k]);
             }
-            /*********************************************************/
-
-            // update other states due to ice content change
-            for (i = left; i <= right; i++) {
-                if (i == 0) {
-                    DT[i] = T_2[i + 1] - Ts;
-                    DT_up[i] = T_2[i] - Ts;
-                    DT_down[i] = T_2[i + 1] - T_2[i];
-                }
-                else if (i == n - 1) {
-                    DT[i] = Tb - T_2[i - 1];
-                    DT_up[i] = T_2[i] - T_2[i - 1];
-                    DT_down[i] = Tb - T_2[i];
-                }
-                else {
-                    DT[i] = T_2[i + 1] - T_2[i - 1];
-                    DT_up[i] = T_2[i] - T_2[i - 1];
-                    DT_down[i] = T_2[i + 1] - T_2[i];
-                }
-                // update Dkappa due to ice content change
-                /*******************************************/
-                if (i < n - 1) {
-                    Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
-                }
-                else if (!NOFLUX) {
-                    Dkappa[i] = kappa_new[i + 2] - kappa_new[i];
-                }
-                else {
-                    Dkappa[i] = kappa_new[i + 1] - kappa_new[i];
-                }
-                /********************************************/
+            if (ice_new[k] != ice[k]) {
+                dCs[k] = volumetric_heat_capacity_dice() * dice[k];
+                dkappa[k] = -dice[k] *
+                            soil_conductivity_dWu(moist[k],
+                                                  moist[k] - ice_new[k],
+                                                  heat_eqn->soil_dens_min[lidx],
+                                                  heat_eqn->bulk_dens_min[lidx],
+                                                  heat_eqn->quartz[lidx],
+                                                  heat_eqn->soil_density[lidx],
+                                                  heat_eqn->bulk_density[lidx],
+                                                  heat_eqn->organic[lidx]);
             }
-
-            for (i = left; i <= right; i++) {
-                storage_term =
-                    Cs_new[i +
-                           1] *
-                    (T_2[i] -
-                     T0[i +
-                        1]) / deltat + T_2[i] *
-                    (Cs_new[i + 1] - Cs[i + 1]) / deltat;
-                if (!EXP_TRANS) {
-                    flux_term1 = Dkappa[i] / alpha[i] * DT[i] / alpha[i];
-                    flux_term2 =
-                        kappa_new[i +
-                                  1] *
-                        (DT_down[i] / gamma[i] - DT_up[i] /
-                         beta[i]) / (0.5 * alpha[i]);
-                }
-                else { // grid transformation
-                    flux_term1 = Dkappa[i] / 2. * DT[i] / 2. /
-                                 (Bexp *
-                                  (Zsum[i +
-                                        1] + 1.)) / (Bexp * (Zsum[i + 1] + 1.));
-                    flux_term2 =
-                        kappa_new[i +
-                                  1] *
-                        ((DT_down[i] -
-                          DT_up[i]) /
-                         (Bexp *
-                          (Zsum[i +
-                                1] +
-                           1.)) /
-                         (Bexp *
-                          (Zsum[i +
-                                1] +
-                           1.)) - DT[i] / 2. /
-                         (Bexp * (Zsum[i + 1] + 1.) * (Zsum[i + 1] + 1.)));
-                }
-                // inelegant fix for "cold nose" problem - when a very cold node skates off to
-                // much colder and breaks the second law of thermodynamics (because
-                // flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
-                // that node get any colder.  This only seems to happen in the first and
-                // second near-surface nodes.
-                flux_term = flux_term1 + flux_term2;
-                phase_term = CONST_RHOICE * CONST_LATICE *
-                             (ice_new[i + 1] - ice[i + 1]) / deltat;
-                res[i] = flux_term + phase_term - storage_term;
+        }
+        if (Zsum[k] > Lsum + depth[lidx] && !PAST_BOTTOM) {
+            Lsum += depth[lidx];
+            lidx++;
+            if (lidx == heat_eqn->Nlayers) {
+                PAST_BOTTOM = true;
+                lidx = heat_eqn->Nlayers - 1;
             }
-        } // end of calculation of focus node only
-    } // end of non-init
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        k = i + 1;
+
+        // Dkappa[i] = kappa_new[k + 1] - kappa_new[k - 1], except for the
+        // bottom node with a no flux boundary
+        dDk_up = -dkappa[k - 1];
+        dDk = 0.;
+        dDk_down = 0.;
+        if (i < n - 1) {
+            dDk_down = dkappa[k + 1];
+        }
+        else if (NOFLUX) {
+            dDk = dkappa[k];
+        }
+
+        if (!EXP_TRANS) {
+            flux1_coef = 1. / (alpha[i] * alpha[i]);
+            flux2_term = (DT_down[i] / gamma[i] - DT_up[i] / beta[i]) /
+                         (0.5 * alpha[i]);
+            b[i] = flux1_coef * dDk * DT[i] +
+                   dkappa[k] * flux2_term -
+                   kappa_new[k] * (1. / gamma[i] + 1. / beta[i]) /
+                   (0.5 * alpha[i]);
+            a[i] = flux1_coef * (dDk_up * DT[i] - Dkappa[i]) +
+                   kappa_new[k] / beta[i] / (0.5 * alpha[i]);
+            c[i] = flux1_coef * (dDk_down * DT[i] + Dkappa[i]) +
+                   kappa_new[k] / gamma[i] / (0.5 * alpha[i]);
+        }
+        else { // grid transformation
+            Z2 = Bexp * (Zsum[k] + 1.) * Bexp * (Zsum[k] + 1.);
+            W = Bexp * (Zsum[k] + 1.) * (Zsum[k] + 1.);
+            flux1_coef = 1. / (4. * Z2);
+            flux2_term = (DT_down[i] - DT_up[i]) / Z2 - DT[i] / 2. / W;
+            b[i] = flux1_coef * dDk * DT[i] +
+                   dkappa[k] * flux2_term -
+                   kappa_new[k] * 2. / Z2;
+            a[i] = flux1_coef * (dDk_up * DT[i] - Dkappa[i]) +
+                   kappa_new[k] * (1. / Z2 + 0.5 / W);
+            c[i] = flux1_coef * (dDk_down * DT[i] + Dkappa[i]) +
+                   kappa_new[k] * (1. / Z2 - 0.5 / W);
+        }
+
+        // phase and storage terms only depend on the node itself
+        b[i] += CONST_RHOICE * CONST_LATICE * dice[k] / deltat;
+        b[i] -= (dCs[k] * (T_2[i] - T0[k]) + Cs_new[k] +
+                 (Cs_new[k] - Cs[k]) + T_2[i] * dCs[k]) / deltat;
+    }
+
+    // the first and last nodes only depend on the fixed boundaries beyond
+    a[0] = 0.;
+    c[n - 1] = 0.;
 }
@@ -30,25 +30,27 @@
  * @brief    This routine solves the atmospheric exchange energy balance.
  *****************************************************************************/
 double
-func_atmos_energy_bal(double  Tcanopy,
-                      va_list ap)
+func_atmos_energy_bal(double Tcanopy,
+                      void  *params)
 {
-    double  Ra;
-    double  Tair;
-    double  atmos_density;
-    double  InSensible;
+    atmos_energy_bal_struct *bal = (atmos_energy_bal_struct *) params;
 
-    double *SensibleHeat;
+    double                   Ra;
+    double                   Tair;
+    double                   atmos_density;
+    double                   InSensible;
+
+    double                  *SensibleHeat;
 
     // internal routine variables
-    double  Error;
-
-    // extract variables from va_arg
-    Ra = (double)  va_arg(ap, double);
-    Tair = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    InSensible = (double)  va_arg(ap, double);
-    SensibleHeat = (double *)va_arg(ap, double *);
+    double                   Error;
+
+    // extract variables from parameters
+    Ra = bal->Ra;
+    Tair = bal->Tair;
+    atmos_density = bal->atmos_density;
+    InSensible = bal->InSensible;
+    SensibleHeat = bal->SensibleHeat;
 
     // compute sensible heat flux between canopy and atmosphere
     (*SensibleHeat) = calc_sensible_heat(atmos_density, Tair, Tcanopy, Ra);
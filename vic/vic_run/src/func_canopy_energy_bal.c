@@ -32,137 +32,138 @@
  * @brief    Calculate the canopy energy balance.
  *****************************************************************************/
 double
-func_canopy_energy_bal(double  Tfoliage,
-                       va_list ap)
+func_canopy_energy_bal(double Tfoliage,
+                       void  *params)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
+    extern option_struct      options;
+    extern parameters_struct  param;
+    canopy_energy_bal_struct *bal = (canopy_energy_bal_struct *) params;
 
     /* General Model Parameters */
-    double                   delta_t;
-    double                   elevation;
+    double                    delta_t;
+    double                    elevation;
 
-    double                  *Wmax;
-    double                  *Wcr;
-    double                  *Wpwp;
-    double                  *frost_fract;
+    double                   *Wmax;
+    double                   *Wcr;
+    double                   *Wpwp;
+    double                   *frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    double                   AirDens;
-    double                   EactAir;
-    double                   Press;
-    double                   Le;
-    double                   Tcanopy;
-    double                   Vpd;
-    double                   shortwave;
-    double                   Catm;
-    double                  *dryFrac;
-
-    double                  *Evap;
-    double                  *Ra;
-    double                  *Ra_used;
-    double                   Rainfall;
-    double                  *Wind;
+    double                    AirDens;
+    double                    EactAir;
+    double                    Press;
+    double                    Le;
+    double                    Tcanopy;
+    double                    Vpd;
+    double                    shortwave;
+    double                    Catm;
+    double                   *dryFrac;
+
+    double                   *Evap;
+    double                   *Ra;
+    double                   *Ra_used;
+    double                    Rainfall;
+    double                   *Wind;
 
     /* Vegetation Terms */
-    double                  *displacement;
-    double                  *ref_height;
-    double                  *roughness;
+    double                   *displacement;
+    double                   *ref_height;
+    double                   *roughness;
 
-    double                  *root;
-    double                  *CanopLayerBnd;
+    double                   *root;
+    double                   *CanopLayerBnd;
 
     /* Water Flux Terms */
-    double                   IntRain;
-    double                   IntSnow;
+    double                    IntRain;
+    double                    IntSnow;
 
-    double                  *Wdew;
+    double                   *Wdew;
 
-    layer_data_struct       *layer;
-    veg_var_struct          *veg_var;
-    veg_lib_struct          *veg_lib;
+    layer_data_struct        *layer;
+    veg_var_struct           *veg_var;
+    veg_lib_struct           *veg_lib;
 
     /* Energy Flux Terms */
-    double                   LongOverIn;
-    double                   LongUnderOut;
-    double                   NetShortOver;
-
-    double                  *AdvectedEnergy;
-    double                  *LatentHeat;
-    double                  *LatentHeatSub;
-    double                  *LongOverOut;
-    double                  *NetLongOver;
-    double                  *NetRadiation;
-    double                  *RefreezeEnergy;
-    double                  *SensibleHeat;
-    double                  *VaporMassFlux;
+    double                    LongOverIn;
+    double                    LongUnderOut;
+    double                    NetShortOver;
+
+    double                   *AdvectedEnergy;
+    double                   *LatentHeat;
+    double                   *LatentHeatSub;
+    double                   *LongOverOut;
+    double                   *NetLongOver;
+    double                   *NetRadiation;
+    double                   *RefreezeEnergy;
+    double                   *SensibleHeat;
+    double                   *VaporMassFlux;
 
     /* Internal Variables */
-    double                   EsSnow;
-    double                   Ls;
-    double                   RestTerm;
-    double                   prec;
+    double                    EsSnow;
+    double                    Ls;
+    double                    RestTerm;
+    double                    prec;
 
-    /** Read variables from variable length argument list **/
+    /** Read variables from parameters **/
 
     /* General Model Parameters */
-    delta_t = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
+    delta_t = bal->delta_t;
+    elevation = bal->elevation;
 
-    Wmax = (double *) va_arg(ap, double *);
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Wmax = bal->Wmax;
+    Wcr = bal->Wcr;
+    Wpwp = bal->Wpwp;
+    frost_fract = bal->frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Le = (double) va_arg(ap, double);
-    Tcanopy = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Evap = (double *) va_arg(ap, double *);
-    Ra = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    Rainfall = (double) va_arg(ap, double);
-    Wind = (double *) va_arg(ap, double *);
+    AirDens = bal->AirDens;
+    EactAir = bal->EactAir;
+    Press = bal->Press;
+    Le = bal->Le;
+    Tcanopy = bal->Tcanopy;
+    Vpd = bal->Vpd;
+    shortwave = bal->shortwave;
+    Catm = bal->Catm;
+    dryFrac = bal->dryFrac;
+
+    Evap = bal->Evap;
+    Ra = bal->Ra;
+    Ra_used = bal->Ra_used;
+    Rainfall = bal->Rainfall;
+    Wind = bal->Wind;
 
     /* Vegetation Terms */
-    displacement = (double *) va_arg(ap, double *);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
+    displacement = bal->displacement;
+    ref_height = bal->ref_height;
+    roughness = bal->roughness;
 
-    root = (double *) va_arg(ap, double *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    root = bal->root;
+    CanopLayerBnd = bal->CanopLayerBnd;
 
     /* Water Flux Terms */
-    IntRain = (double) va_arg(ap, double);
-    IntSnow = (double) va_arg(ap, double);
+    IntRain = bal->IntRain;
+    IntSnow = bal->IntSnow;
 
-    Wdew = (double *) va_arg(ap, double *);
+    Wdew = bal->Wdew;
 
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
-    veg_lib = (veg_lib_struct *) va_arg(ap, veg_lib_struct *);
+    layer = bal->layer;
+    veg_var = bal->veg_var;
+    veg_lib = bal->veg_lib;
 
     /* Energy Flux Terms */
-    LongOverIn = (double) va_arg(ap, double);
-    LongUnderOut = (double) va_arg(ap, double);
-    NetShortOver = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    LongOverOut = (double *) va_arg(ap, double *);
-    NetLongOver = (double *) va_arg(ap, double *);
-    NetRadiation = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    LongOverIn = bal->LongOverIn;
+    LongUnderOut = bal->LongUnderOut;
+    NetShortOver = bal->NetShortOver;
+
+    AdvectedEnergy = bal->AdvectedEnergy;
+    LatentHeat = bal->LatentHeat;
+    LatentHeatSub = bal->LatentHeatSub;
+    LongOverOut = bal->LongOverOut;
+    NetLongOver = bal->NetLongOver;
+    NetRadiation = bal->NetRadiation;
+    RefreezeEnergy = bal->RefreezeEnergy;
+    SensibleHeat = bal->SensibleHeat;
+    VaporMassFlux = bal->VaporMassFlux;
 
     /* Calculate the net radiation at the canopy surface, using the canopy
        temperature.  The outgoing longwave is subtracted twice, because the
@@ -36,11 +36,12 @@
  * @brief    Calculate the surface energy balance.
  *****************************************************************************/
 double
-func_surf_energy_bal(double  Ts,
-                     va_list ap)
+func_surf_energy_bal(double Ts,
+                     void  *params)
 {
     extern parameters_struct param;
     extern option_struct     options;
+    surf_energy_bal_struct  *bal = (surf_energy_bal_struct *) params;
 
     /* define routine input variables */
 
@@ -171,7 +172,7 @@ func_surf_energy_bal(double  Ts,
     int                EXP_TRANS;
     int                SNOWING;
 
-    int               *FIRST_SOLN;
+    soil_thermal_solver_struct *soil_solver;
 
     /* returned energy balance terms */
     double            *NetLongBare; // net LW from snow-free ground
@@ -215,129 +216,129 @@ func_surf_energy_bal(double  Ts,
     double             ga_average;
 
     /************************************
-       Read variables from variable list
+       Read variables from parameters
     ************************************/
 
     /* general model terms */
-    VEG = (int) va_arg(ap, int);
-    delta_t = (double) va_arg(ap, double);
+    VEG = bal->VEG;
+    delta_t = bal->delta_t;
 
     /* soil layer terms */
-    Cs1 = (double) va_arg(ap, double);
-    Cs2 = (double) va_arg(ap, double);
-    D1 = (double) va_arg(ap, double);
-    D2 = (double) va_arg(ap, double);
-    T1_old = (double) va_arg(ap, double);
-    T2 = (double) va_arg(ap, double);
-    Ts_old = (double) va_arg(ap, double);
-    Told_node = (double *) va_arg(ap, double *);
-    bubble = (double) va_arg(ap, double);
-    dp = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    kappa1 = (double) va_arg(ap, double);
-    kappa2 = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-
-    root = (double  *) va_arg(ap, double  *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    Cs1 = bal->Cs1;
+    Cs2 = bal->Cs2;
+    D1 = bal->D1;
+    D2 = bal->D2;
+    T1_old = bal->T1_old;
+    T2 = bal->T2;
+    Ts_old = bal->Ts_old;
+    Told_node = bal->Told_node;
+    bubble = bal->bubble;
+    dp = bal->dp;
+    expt = bal->expt;
+    ice0 = bal->ice0;
+    kappa1 = bal->kappa1;
+    kappa2 = bal->kappa2;
+    max_moist = bal->max_moist;
+    moist = bal->moist;
+
+    root = bal->root;
+    CanopLayerBnd = bal->CanopLayerBnd;
 
     /* meteorological forcing terms */
-    UnderStory = (int) va_arg(ap, int);
-    overstory = (int) va_arg(ap, int);
-
-    NetShortBare = (double) va_arg(ap, double);
-    NetShortGrnd = (double) va_arg(ap, double);
-    NetShortSnow = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    atmos_density = (double) va_arg(ap, double);
-    atmos_pressure = (double) va_arg(ap, double);
-    emissivity = (double) va_arg(ap, double);
-    LongBareIn = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    surf_atten = (double) va_arg(ap, double);
-    vp = (double) va_arg(ap, double);
-    vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Wdew = (double *) va_arg(ap, double *);
-    displacement = (double *) va_arg(ap, double *);
-    ra = (double *) va_arg(ap, double *);
-    Ra_veg = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    rainfall = (double) va_arg(ap, double);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
-    wind = (double *) va_arg(ap, double *);
+    UnderStory = bal->UnderStory;
+    overstory = bal->overstory;
+
+    NetShortBare = bal->NetShortBare;
+    NetShortGrnd = bal->NetShortGrnd;
+    NetShortSnow = bal->NetShortSnow;
+    Tair = bal->Tair;
+    atmos_density = bal->atmos_density;
+    atmos_pressure = bal->atmos_pressure;
+    emissivity = bal->emissivity;
+    LongBareIn = bal->LongBareIn;
+    LongSnowIn = bal->LongSnowIn;
+    surf_atten = bal->surf_atten;
+    vp = bal->vp;
+    vpd = bal->vpd;
+    shortwave = bal->shortwave;
+    Catm = bal->Catm;
+    dryFrac = bal->dryFrac;
+
+    Wdew = bal->Wdew;
+    displacement = bal->displacement;
+    ra = bal->ra;
+    Ra_veg = bal->Ra_veg;
+    Ra_used = bal->Ra_used;
+    rainfall = bal->rainfall;
+    ref_height = bal->ref_height;
+    roughness = bal->roughness;
+    wind = bal->wind;
 
     /* latent heat terms */
-    Le = (double) va_arg(ap, double);
+    Le = bal->Le;
 
     /* snowpack terms */
-    Advection = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    Tsnow_surf = (double) va_arg(ap, double);
-    kappa_snow = (double) va_arg(ap, double);
-    melt_energy = (double) va_arg(ap, double);
-    snow_coverage = (double) va_arg(ap, double);
-    snow_density = (double) va_arg(ap, double);
-    snow_swq = (double) va_arg(ap, double);
-    snow_water = (double) va_arg(ap, double);
-
-    deltaCC = (double *) va_arg(ap, double *);
-    refreeze_energy = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
+    Advection = bal->Advection;
+    OldTSurf = bal->OldTSurf;
+    Tsnow_surf = bal->Tsnow_surf;
+    kappa_snow = bal->kappa_snow;
+    melt_energy = bal->melt_energy;
+    snow_coverage = bal->snow_coverage;
+    snow_density = bal->snow_density;
+    snow_swq = bal->snow_swq;
+    snow_water = bal->snow_water;
+
+    deltaCC = bal->deltaCC;
+    refreeze_energy = bal->refreeze_energy;
+    vapor_flux = bal->vapor_flux;
+    blowing_flux = bal->blowing_flux;
+    surface_flux = bal->surface_flux;
 
     /* soil node terms */
-    Nnodes = (int) va_arg(ap, int);
-
-    Cs_node = (double *) va_arg(ap, double *);
-    T_node = (double *) va_arg(ap, double *);
-    Tnew_node = (double *) va_arg(ap, double *);
-    Tnew_fbflag = (char *) va_arg(ap, char *);
-    Tnew_fbcount = (unsigned *) va_arg(ap, unsigned *);
-    alpha = (double *) va_arg(ap, double *);
-    beta = (double *) va_arg(ap, double *);
-    bubble_node = (double *) va_arg(ap, double *);
-    Zsum_node = (double *) va_arg(ap, double *);
-    expt_node = (double *) va_arg(ap, double *);
-    gamma = (double *) va_arg(ap, double *);
-    ice_node = (double *) va_arg(ap, double *);
-    kappa_node = (double *) va_arg(ap, double *);
-    max_moist_node = (double *) va_arg(ap, double *);
-    moist_node = (double *) va_arg(ap, double *);
+    Nnodes = bal->Nnodes;
+
+    Cs_node = bal->Cs_node;
+    T_node = bal->T_node;
+    Tnew_node = bal->Tnew_node;
+    Tnew_fbflag = bal->Tnew_fbflag;
+    Tnew_fbcount = bal->Tnew_fbcount;
+    alpha = bal->alpha;
+    beta = bal->beta;
+    bubble_node = bal->bubble_node;
+    Zsum_node = bal->Zsum_node;
+    expt_node = bal->expt_node;
+    gamma = bal->gamma;
+    ice_node = bal->ice_node;
+    kappa_node = bal->kappa_node;
+    max_moist_node = bal->max_moist_node;
+    moist_node = bal->moist_node;
 
     /* model structures */
-    soil_con = (soil_con_struct *) va_arg(ap, soil_con_struct *);
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
-    veg_lib = (veg_lib_struct *) va_arg(ap, veg_lib_struct *);
+    soil_con = bal->soil_con;
+    layer = bal->layer;
+    veg_var = bal->veg_var;
+    veg_lib = bal->veg_lib;
 
     /* control flags */
-    INCLUDE_SNOW = (int) va_arg(ap, int);
-    NOFLUX = (int) va_arg(ap, int);
-    EXP_TRANS = (int) va_arg(ap, int);
-    SNOWING = (int) va_arg(ap, int);
+    INCLUDE_SNOW = bal->INCLUDE_SNOW;
+    NOFLUX = bal->NOFLUX;
+    EXP_TRANS = bal->EXP_TRANS;
+    SNOWING = bal->SNOWING;
 
-    FIRST_SOLN = (int *) va_arg(ap, int *);
+    soil_solver = bal->soil_solver;
 
     /* returned energy balance terms */
-    NetLongBare = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    T1 = (double *) va_arg(ap, double *);
-    deltaH = (double *) va_arg(ap, double *);
-    fusion = (double *) va_arg(ap, double *);
-    grnd_flux = (double *) va_arg(ap, double *);
-    latent_heat = (double *) va_arg(ap, double *);
-    latent_heat_sub = (double *) va_arg(ap, double *);
-    sensible_heat = (double *) va_arg(ap, double *);
-    snow_flux = (double *) va_arg(ap, double *);
-    store_error = (double *) va_arg(ap, double *);
+    NetLongBare = bal->NetLongBare;
+    NetLongSnow = bal->NetLongSnow;
+    T1 = bal->T1;
+    deltaH = bal->deltaH;
+    fusion = bal->fusion;
+    grnd_flux = bal->grnd_flux;
+    latent_heat = bal->latent_heat;
+    latent_heat_sub = bal->latent_heat_sub;
+    sensible_heat = bal->sensible_heat;
+    snow_flux = bal->snow_flux;
+    store_error = bal->store_error;
 
     /* Transform variables */
     double Wcr_array[MAX_LAYERS];
@@ -438,34 +439,38 @@ func_surf_energy_bal(double  Ts,
 
         /* IMPLICIT Solution */
         if (options.IMPLICIT) {
+            INSTRUMENT_BEGIN(INSTR_FROZEN_SOIL);
             Error = solve_T_profile_implicit(Tnew_node, T_node, Tnew_fbflag,
                                              Tnew_fbcount, Zsum_node,
                                              kappa_node, Cs_node, moist_node,
                                              delta_t, max_moist_node,
                                              bubble_node, expt_node, ice_node,
                                              alpha, beta, gamma, dp, Nnodes,
-                                             FIRST_SOLN, NOFLUX, EXP_TRANS,
+                                             soil_solver, NOFLUX, EXP_TRANS,
                                              bulk_dens_min, soil_dens_min,
                                              quartz, bulk_density,
                                              soil_density, organic, depth);
+            INSTRUMENT_END(INSTR_FROZEN_SOIL);
 
-            if (FIRST_SOLN[1]) {
-                FIRST_SOLN[1] = false;
+            if (soil_solver->FIRST_SOLN[1]) {
+                soil_solver->FIRST_SOLN[1] = false;
             }
         }
 
         /* EXPLICIT Solution, or if IMPLICIT Solution Failed */
         if (!options.IMPLICIT || Error == 1) {
             if (options.IMPLICIT) {
-                FIRST_SOLN[0] = true;
+                soil_solver->FIRST_SOLN[0] = true;
             }
+            INSTRUMENT_BEGIN(INSTR_FROZEN_SOIL);
             Error = solve_T_profile(Tnew_node, T_node, Tnew_fbflag,
                                     Tnew_fbcount, Zsum_node, kappa_node,
                                     Cs_node, moist_node, delta_t,
                                     max_moist_node, bubble_node,
                                     expt_node, ice_node, alpha, beta, gamma, dp,
-                                    Nnodes, FIRST_SOLN, FS_ACTIVE, NOFLUX,
+                                    Nnodes, soil_solver, FS_ACTIVE, NOFLUX,
                                     EXP_TRANS);
+            INSTRUMENT_END(INSTR_FROZEN_SOIL);
         }
 
         if ((int) Error == ERROR) {
@@ -759,11 +764,13 @@ func_surf_energy_bal(double  Ts,
     if (!SNOWING) {
         // if VEG is true, then fcanopy > 0 and LAI > 0
         if (VEG) {
+            INSTRUMENT_BEGIN(INSTR_CANOPY);
             Evap = canopy_evap(layer, veg_var, veg_lib, true, Wdew,
                                delta_t, NetBareRad, vpd, NetShortBare,
                                Tair, Ra_veg[1], elevation, rainfall,
                                Wmax, Wcr, Wpwp, frost_fract, root,
                                dryFrac, shortwave, Catm, CanopLayerBnd);
+            INSTRUMENT_END(INSTR_CANOPY);
             Evap *= veg_var->fcanopy;
             for (i = 0; i < options.Nlayer; i++) {
                 layer[i].transp *= veg_var->fcanopy;
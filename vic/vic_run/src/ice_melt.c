@@ -62,47 +62,48 @@ ice_melt(double            z2,
          double           *save_refreeze_energy,
          double           *save_LWnet)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    double                   DeltaPackCC; /* Change in cold content of the pack */
-    double                   DeltaPackSwq; /* Change in snow water equivalent of the pack (m) */
-    double                   InitialSwq; /* Initial snow water equivalent (m) */
-    double                   InitialIce;
-    double                   MassBalanceError; /* Mass balance error (m) */
-    double                   MaxLiquidWater; /* Maximum liquid water content of pack (m) */
-    double                   OldTSurf; /* Old snow surface temperature (C) */
-    double                   Qnet; /* Net energy exchange at the surface (W/m2) */
-    double                   PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
-    double                   RefreezeEnergy; /* refreeze energy (W/m2) */
-    double                   RefrozenWater; /* Amount of refrozen water (m) */
-    double                   SnowFallCC; /* Cold content of new snowfall (J) */
-    double                   SurfaceCC;
-    double                   PackCC;
-    double                   SurfaceSwq;
-    double                   PackSwq;
-    double                   PackIce;
-    double                   SnowMelt; /* Amount of snow melt during time interval (m water equivalent) */
-    double                   IceMelt;
-    double                   LWnet;
-    double                   avgcond;
-    double                   SWconducted;
-    double                   SnowIce;
-    double                   LakeIce;
-    double                   Ice;
-    double                   SnowFall;
-    double                   RainFall;
-    double                   vapor_flux;
-    double                   blowing_flux;
-    double                   surface_flux;
-    double                   advection;
-    double                   deltaCC;
-    double                   SnowFlux; /* thermal flux through snowpack from ground */
-    double                   latent_heat;
-    double                   latent_heat_sub;
-    double                   sensible_heat;
-    double                   Ls;
-    double                   melt_energy = 0.;
+    extern option_struct       options;
+    extern parameters_struct   param;
+
+    double                     DeltaPackCC; /* Change in cold content of the pack */
+    double                     DeltaPackSwq; /* Change in snow water equivalent of the pack (m) */
+    double                     InitialSwq; /* Initial snow water equivalent (m) */
+    double                     InitialIce;
+    double                     MassBalanceError; /* Mass balance error (m) */
+    double                     MaxLiquidWater; /* Maximum liquid water content of pack (m) */
+    double                     OldTSurf; /* Old snow surface temperature (C) */
+    double                     Qnet; /* Net energy exchange at the surface (W/m2) */
+    double                     PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
+    double                     RefreezeEnergy; /* refreeze energy (W/m2) */
+    double                     RefrozenWater; /* Amount of refrozen water (m) */
+    double                     SnowFallCC; /* Cold content of new snowfall (J) */
+    double                     SurfaceCC;
+    double                     PackCC;
+    double                     SurfaceSwq;
+    double                     PackSwq;
+    double                     PackIce;
+    double                     SnowMelt; /* Amount of snow melt during time interval (m water equivalent) */
+    double                     IceMelt;
+    double                     LWnet;
+    double                     avgcond;
+    double                     SWconducted;
+    double                     SnowIce;
+    double                     LakeIce;
+    double                     Ice;
+    double                     SnowFall;
+    double                     RainFall;
+    double                     vapor_flux;
+    double                     blowing_flux;
+    double                     surface_flux;
+    double                     advection;
+    double                     deltaCC;
+    double                     SnowFlux; /* thermal flux through snowpack from ground */
+    double                     latent_heat;
+    double                     latent_heat_sub;
+    double                     sensible_heat;
+    double                     Ls;
+    double                     melt_energy = 0.;
+    ice_pack_energy_bal_struct ice_bal;
 
     SnowFall = snowfall / MM_PER_M; /* convert to m */
     RainFall = rainfall / MM_PER_M; /* convert to m */
@@ -221,18 +222,40 @@ ice_melt(double            z2,
     blowing_flux = snow->blowing_flux;
     surface_flux = snow->surface_flux;
 
+    /* Pack the parameters of the ice pack energy balance */
+    ice_bal.Dt = delta_t;
+    ice_bal.Ra = aero_resist;
+    ice_bal.Ra_used = aero_resist_used;
+    ice_bal.Z = z2;
+    ice_bal.Z0 = Z0;
+    ice_bal.Wind = wind;
+    ice_bal.ShortRad = net_short;
+    ice_bal.LongRadIn = longwave;
+    ice_bal.AirDens = density;
+    ice_bal.Lv = Le;
+    ice_bal.Tair = air_temp;
+    ice_bal.Press = pressure * PA_PER_KPA;
+    ice_bal.Vpd = vpd * PA_PER_KPA;
+    ice_bal.EactAir = vp * PA_PER_KPA;
+    ice_bal.Rain = RainFall;
+    ice_bal.SurfaceLiquidWater = snow->surf_water;
+    ice_bal.RefreezeEnergy = &RefreezeEnergy;
+    ice_bal.vapor_flux = &vapor_flux;
+    ice_bal.blowing_flux = &blowing_flux;
+    ice_bal.surface_flux = &surface_flux;
+    ice_bal.AdvectedEnergy = &advection;
+    ice_bal.Tfreeze = Tcutoff;
+    ice_bal.AvgCond = avgcond;
+    ice_bal.SWconducted = SWconducted;
+    ice_bal.qf = &SnowFlux;
+    ice_bal.LatentHeat = &latent_heat;
+    ice_bal.LatentHeatSub = &latent_heat_sub;
+    ice_bal.SensibleHeat = &sensible_heat;
+    ice_bal.LongRadOut = &LWnet;
+
     /* Calculate the surface energy balance for snow_temp = 0.0 */
 
-    Qnet = CalcIcePackEnergyBalance((double) 0.0, delta_t, aero_resist,
-                                    aero_resist_used, z2, Z0, wind, net_short,
-                                    longwave, density, Le, air_temp,
-                                    pressure * PA_PER_KPA, vpd * PA_PER_KPA,
-                                    vp * PA_PER_KPA,
-                                    RainFall, snow->surf_water, &RefreezeEnergy,
-                                    &vapor_flux, &blowing_flux, &surface_flux,
-                                    &advection, Tcutoff, avgcond, SWconducted,
-                                    &SnowFlux, &latent_heat, &latent_heat_sub,
-                                    &sensible_heat, &LWnet);
+    Qnet = IceEnergyBalance((double) 0.0, &ice_bal);
 
     snow->vapor_flux = vapor_flux;
     snow->surface_flux = surface_flux;
@@ -347,20 +370,9 @@ ice_melt(double            z2,
         /* Calculate surface layer temperature using "Brent method" */
         if (SurfaceSwq > param.SNOW_MIN_SWQ_EB_THRES) {
             snow->surf_temp =
-                root_brent((double) (snow->surf_temp - param.SNOW_DT),
-                           (double) (snow->surf_temp + param.SNOW_DT),
-                           IceEnergyBalance, delta_t,
-                           aero_resist, aero_resist_used, z2, Z0,
-                           wind, net_short, longwave, density,
-                           Le, air_temp, pressure * PA_PER_KPA,
-                           vpd * PA_PER_KPA, vp * PA_PER_KPA,
-                           RainFall,
-                           snow->surf_water, &RefreezeEnergy,
-                           &vapor_flux, &blowing_flux,
-                           &surface_flux, &advection, Tcutoff,
-                           avgcond, SWconducted, &SnowFlux,
-                           &latent_heat, &latent_heat_sub,
-                           &sensible_heat, &LWnet);
+                root_brent_guess(snow->surf_temp - param.SNOW_DT,
+                                 snow->surf_temp + param.SNOW_DT, OldTSurf,
+                                 IceEnergyBalance, &ice_bal);
 
             if (snow->surf_temp <= -998) {
                 if (options.TFALLBACK) {
@@ -369,26 +381,12 @@ ice_melt(double            z2,
                     snow->surf_temp_fbcount++;
                 }
                 else {
-                    ErrorIcePackEnergyBalance(snow->surf_temp, delta_t,
-                                              aero_resist,
-                                              aero_resist_used, z2,
-                                              displacement, Z0, wind, net_short,
-                                              longwave, density, Le, air_temp,
-                                              pressure * PA_PER_KPA,
-                                              vpd * PA_PER_KPA,
-                                              vp * PA_PER_KPA,
-                                              RainFall, SurfaceSwq,
-                                              snow->surf_water, OldTSurf,
-                                              &RefreezeEnergy,
-                                              &vapor_flux, &blowing_flux,
-                                              &surface_flux,
-                                              &advection, deltaCC, Tcutoff,
-                                              avgcond, SWconducted,
-                                              snow->swq * CONST_RHOFW / param.LAKE_RHOSNOW,
-                                              param.LAKE_RHOSNOW, surf_atten,
-                                              &SnowFlux, &latent_heat,
-                                              &latent_heat_sub,
-                                              &sensible_heat, &LWnet);
+                    ErrorPrintIcePackEnergyBalance(snow->surf_temp,
+                                                   displacement, SurfaceSwq,
+                                                   OldTSurf, deltaCC,
+                                                   snow->swq * CONST_RHOFW / param.LAKE_RHOSNOW,
+                                                   param.LAKE_RHOSNOW,
+                                                   surf_atten, &ice_bal);
                     return(ERROR);
                 }
             }
@@ -397,19 +395,7 @@ ice_melt(double            z2,
             snow->surf_temp = 999;
         }
         if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-            Qnet = CalcIcePackEnergyBalance(snow->surf_temp, delta_t,
-                                            aero_resist, aero_resist_used, z2,
-                                            Z0, wind, net_short, longwave,
-                                            density, Le, air_temp,
-                                            pressure * PA_PER_KPA,
-                                            vpd * PA_PER_KPA,
-                                            vp * PA_PER_KPA, RainFall,
-                                            snow->surf_water, &RefreezeEnergy,
-                                            &vapor_flux, &blowing_flux,
-                                            &surface_flux, &advection, Tcutoff,
-                                            avgcond, SWconducted, &SnowFlux,
-                                            &latent_heat, &latent_heat_sub,
-                                            &sensible_heat, &LWnet);
+            Qnet = IceEnergyBalance(snow->surf_temp, &ice_bal);
 
             snow->vapor_flux = vapor_flux;
             snow->surface_flux = surface_flux;
@@ -609,58 +595,24 @@ ice_melt(double            z2,
     return (0);
 }
 
-/******************************************************************************
- * @brief    Dummy function to make a direct call to IceEnergyBalance()
- *           possible.
- *****************************************************************************/
-double
-CalcIcePackEnergyBalance(double Tsurf,
-                         ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the IcePack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = IceEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
- * @brief    Dummy function to make a direct call to
- *           ErrorPrintIcePackEnergyBalance() possible.
- *****************************************************************************/
-double
-ErrorIcePackEnergyBalance(double Tsurf,
-                          ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the IcePack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = ErrorPrintIcePackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
 /******************************************************************************
  * @brief    Print ice pack energy balance terms
  *****************************************************************************/
 double
-ErrorPrintIcePackEnergyBalance(double  TSurf,
-                               va_list ap)
+ErrorPrintIcePackEnergyBalance(double                      TSurf,
+                               double                      Displacement,
+                               double                      SweSurfaceLayer,
+                               double                      OldTSurf,
+                               double                      DeltaColdContent,
+                               double                      SnowDepth,
+                               double                      SnowDensity,
+                               double                      SurfAttenuation,
+                               ice_pack_energy_bal_struct *bal)
 {
     double  Dt;                  /* Model time step (seconds) */
     double  Ra;                  /* Aerodynamic resistance (s/m) */
     double *Ra_used;             /* Aerodynamic resistance (s/m) after stability correction */
     double  Z;                   /* Reference height (m) */
-    double  Displacement;        /* Displacement height (m) */
     double  Z0;                  /* surface roughness height (m) */
     double  Wind;                /* Wind speed (m/s) */
     double  ShortRad;            /* Net incident shortwave radiation (W/m2) */
@@ -672,11 +624,7 @@ ErrorPrintIcePackEnergyBalance(double  TSurf,
     double  Vpd;                /* Vapor pressure deficit (Pa) */
     double  EactAir;             /* Actual vapor pressure of air (Pa) */
     double  Rain;                /* Rain fall (m/timestep) */
-    double  SweSurfaceLayer;     /* Snow water equivalent in surface layer (m)
-                                  */
     double  SurfaceLiquidWater;  /* Liquid water in the surface layer (m) */
-    double  OldTSurf;            /* Surface temperature during previous time
-                                    step */
     double *RefreezeEnergy;      /* Refreeze energy (W/m2) */
     double *vapor_flux;          /* Total mass flux of water vapor to or from
                                     snow (m/timestep) */
@@ -685,15 +633,10 @@ ErrorPrintIcePackEnergyBalance(double  TSurf,
     double *surface_flux;        /* Mass flux of water vapor to or from
                                     snow pack (m/timestep) */
     double *AdvectedEnergy;      /* Energy advected by precipitation (W/m2) */
-    double  DeltaColdContent;    /* Change in cold content (W/m2) */
     double  Tfreeze;
     double  AvgCond;
     double  SWconducted;
-    double  SnowDepth;
-    double  SnowDensity;
-    double  SurfAttenuation;
 
-    /* end of list of arguments in variable argument list */
     double *GroundFlux;
     double *LatentHeat;         /* Latent heat exchange at surface (W/m2) */
     double *LatentHeatSub;      /* Latent heat exchange at surface (W/m2) due to sublimation */
@@ -701,42 +644,35 @@ ErrorPrintIcePackEnergyBalance(double  TSurf,
     double *LWnet;
 
     /* initialize variables */
-    Dt = (double) va_arg(ap, double);
-    Ra = (double) va_arg(ap, double);
-    Ra_used = (double *) va_arg(ap, double *);
-    Z = (double) va_arg(ap, double);
-    Displacement = (double) va_arg(ap, double);
-    Z0 = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
-    ShortRad = (double) va_arg(ap, double);
-    LongRadIn = (double) va_arg(ap, double);
-    AirDens = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    DeltaColdContent = (double) va_arg(ap, double);
-    Tfreeze = (double) va_arg(ap, double);
-    AvgCond = (double) va_arg(ap, double);
-    SWconducted = (double) va_arg(ap, double);
-    SnowDepth = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfAttenuation = (double) va_arg(ap, double);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    LWnet = (double *) va_arg(ap, double *);
+    Dt = bal->Dt;
+    Ra = bal->Ra;
+    Ra_used = bal->Ra_used;
+    Z = bal->Z;
+    Z0 = bal->Z0;
+    Wind = bal->Wind;
+    ShortRad = bal->ShortRad;
+    LongRadIn = bal->LongRadIn;
+    AirDens = bal->AirDens;
+    Lv = bal->Lv;
+    Tair = bal->Tair;
+    Press = bal->Press;
+    Vpd = bal->Vpd;
+    EactAir = bal->EactAir;
+    Rain = bal->Rain;
+    SurfaceLiquidWater = bal->SurfaceLiquidWater;
+    RefreezeEnergy = bal->RefreezeEnergy;
+    vapor_flux = bal->vapor_flux;
+    blowing_flux = bal->blowing_flux;
+    surface_flux = bal->surface_flux;
+    AdvectedEnergy = bal->AdvectedEnergy;
+    Tfreeze = bal->Tfreeze;
+    AvgCond = bal->AvgCond;
+    SWconducted = bal->SWconducted;
+    GroundFlux = bal->qf;
+    LatentHeat = bal->LatentHeat;
+    LatentHeatSub = bal->LatentHeatSub;
+    SensibleHeat = bal->SensibleHeat;
+    LWnet = bal->LongRadOut;
 
     /* print variables */
     log_warn("ice_melt failed to converge to a solution in root_brent.  "
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Hierarchical performance instrumentation (see vic_instrument.h)
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+#ifdef _OPENMP
+    #include <omp.h>
+#else
+    #define omp_get_max_threads() 1
+    #define omp_get_thread_num() 0
+#endif
+
+/******************************************************************************
+ * @brief    Allocate the counters of all threads
+ * @details  Has to be called before any other thread is started.
+ *****************************************************************************/
+void
+instrument_init(void)
+{
+    extern instrument_struct instrument;
+
+    int                      status;
+
+    instrument.nthreads = (size_t) omp_get_max_threads();
+    instrument.threads = calloc(instrument_nthreads(),
+                                sizeof(*(instrument.threads)));
+    check_alloc_status(instrument.threads, "Memory allocation error.");
+
+    status = pthread_key_create(&(instrument.key), NULL);
+    if (status != 0) {
+        log_err("Unable to create the instrumentation thread key");
+    }
+
+    instrument.nrecords = 0;
+    instrument.records = NULL;
+    instrument.initialized = true;
+}
+
+/******************************************************************************
+ * @brief    Number of threads with counters: the OpenMP threads followed by
+ *           the threads in enum instrument_threads
+ *****************************************************************************/
+size_t
+instrument_nthreads(void)
+{
+    extern instrument_struct instrument;
+
+    return instrument.nthreads + N_INSTR_THREADS;
+}
+
+/******************************************************************************
+ * @brief    Use the counters of one of the instrument_threads for the calling
+ *           thread
+ *****************************************************************************/
+void
+instrument_set_thread(int thread)
+{
+    extern instrument_struct instrument;
+
+    if (!instrument.initialized) {
+        return;
+    }
+
+    pthread_setspecific(instrument.key,
+                        &(instrument.threads[instrument.nthreads + thread]));
+}
+
+/******************************************************************************
+ * @brief    Counters of the calling thread
+ * @details  Returns NULL if the instrumentation is not initialized or if the
+ *           thread has no counters.
+ *****************************************************************************/
+instrument_thread_struct *
+instrument_get_thread(void)
+{
+    extern instrument_struct  instrument;
+
+    instrument_thread_struct *thread;
+    size_t                    t;
+
+    if (!instrument.initialized) {
+        return NULL;
+    }
+
+    // the thread numbers of OpenMP threads are not cached, the same system
+    // thread may have a different number in the next parallel region
+    thread = pthread_getspecific(instrument.key);
+    if (thread == NULL) {
+        t = (size_t) omp_get_thread_num();
+        if (t < instrument.nthreads) {
+            thread = &(instrument.threads[t]);
+        }
+    }
+
+    return thread;
+}
+
+/******************************************************************************
+ * @brief    Open a region
+ *****************************************************************************/
+void
+instrument_begin(int region)
+{
+    instrument_thread_struct *thread;
+    struct timespec           now;
+
+    thread = instrument_get_thread();
+    if (thread == NULL) {
+        return;
+    }
+
+    if (thread->depth == INSTRUMENT_MAX_DEPTH) {
+        log_err("Instrumented regions are nested deeper than %d",
+                INSTRUMENT_MAX_DEPTH);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    thread->region[thread->depth] = region;
+    thread->start[thread->depth] = (double) now.tv_sec +
+                                   (double) now.tv_nsec * 1e-9;
+    thread->child[thread->depth] = 0.;
+    thread->depth++;
+}
+
+/******************************************************************************
+ * @brief    Close a region and add its time to the counters of the calling
+ *           thread
+ *****************************************************************************/
+void
+instrument_end(int region)
+{
+    instrument_thread_struct *thread;
+    instrument_stat_struct   *stat;
+    struct timespec           now;
+    double                    elapsed;
+    int                       parent;
+
+    thread = instrument_get_thread();
+    if (thread == NULL) {
+        return;
+    }
+
+    if (thread->depth == 0 || thread->region[thread->depth - 1] != region) {
+        log_err("Instrumented region %d is closed but was not opened last",
+                region);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    thread->depth--;
+    elapsed = (double) now.tv_sec + (double) now.tv_nsec * 1e-9 -
+              thread->start[thread->depth];
+
+    if (thread->depth > 0) {
+        parent = thread->region[thread->depth - 1];
+        thread->child[thread->depth - 1] += elapsed;
+    }
+    else {
+        parent = INSTRUMENT_TOP;
+    }
+
+    stat = &(thread->stat[parent][region]);
+    if (stat->count == 0 || elapsed < stat->min) {
+        stat->min = elapsed;
+    }
+    if (elapsed > stat->max) {
+        stat->max = elapsed;
+    }
+    stat->count++;
+    stat->total += elapsed;
+    stat->self += elapsed - thread->child[thread->depth];
+}
+
+/******************************************************************************
+ * @brief    Free the counters and the gathered records
+ *****************************************************************************/
+void
+instrument_finalize(void)
+{
+    extern instrument_struct instrument;
+
+    if (!instrument.initialized) {
+        return;
+    }
+
+    instrument.initialized = false;
+    pthread_key_delete(instrument.key);
+    free(instrument.threads);
+    free(instrument.records);
+    instrument.threads = NULL;
+    instrument.records = NULL;
+    instrument.nrecords = 0;
+}
+
+/******************************************************************************
+ * @brief    Get the name of an instrumented region
+ *****************************************************************************/
+void
+str_from_instrument_region(int   region,
+                           char *region_str)
+{
+    switch (region) {
+    case INSTR_FORCE:
+        snprintf(region_str, MAXSTRING, "force");
+        break;
+    case INSTR_VIC_RUN:
+        snprintf(region_str, MAXSTRING, "vic_run");
+        break;
+    case INSTR_SNOW:
+        snprintf(region_str, MAXSTRING, "snow");
+        break;
+    case INSTR_CANOPY:
+        snprintf(region_str, MAXSTRING, "canopy");
+        break;
+    case INSTR_SURF_EB:
+        snprintf(region_str, MAXSTRING, "surf_energy_bal");
+        break;
+    case INSTR_FROZEN_SOIL:
+        snprintf(region_str, MAXSTRING, "frozen_soil");
+        break;
+    case INSTR_LAKE:
+        snprintf(region_str, MAXSTRING, "lake");
+        break;
+    case INSTR_RUNOFF:
+        snprintf(region_str, MAXSTRING, "runoff");
+        break;
+    case INSTR_PUT_DATA:
+        snprintf(region_str, MAXSTRING, "put_data");
+        break;
+    case INSTR_PLUGIN:
+        snprintf(region_str, MAXSTRING, "plugin");
+        break;
+    case INSTR_ROUTING:
+        snprintf(region_str, MAXSTRING, "routing");
+        break;
+    case INSTR_WATERUSE:
+        snprintf(region_str, MAXSTRING, "wateruse");
+        break;
+    case INSTR_IRRIGATION:
+        snprintf(region_str, MAXSTRING, "irrigation");
+        break;
+    case INSTR_DAMS:
+        snprintf(region_str, MAXSTRING, "dams");
+        break;
+    case INSTR_CROPS:
+        snprintf(region_str, MAXSTRING, "crops");
+        break;
+    case INSTR_GATHER:
+        snprintf(region_str, MAXSTRING, "mpi_gather");
+        break;
+    case INSTR_SCATTER:
+        snprintf(region_str, MAXSTRING, "mpi_scatter");
+        break;
+    case INSTR_NC_READ:
+        snprintf(region_str, MAXSTRING, "nc_read");
+        break;
+    case INSTR_NC_WRITE:
+        snprintf(region_str, MAXSTRING, "nc_write");
+        break;
+    case INSTR_WRITE:
+        snprintf(region_str, MAXSTRING, "write_output");
+        break;
+    case INSTR_STATE:
+        snprintf(region_str, MAXSTRING, "state");
+        break;
+    case INSTRUMENT_TOP:
+        snprintf(region_str, MAXSTRING, "top");
+        break;
+    default:
+        log_err("Invalid instrumented region (%d).", region);
+    }
+}
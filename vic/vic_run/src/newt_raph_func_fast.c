@@ -34,11 +34,18 @@
 /******************************************************************************
  * @brief    Newton-Raphson method to solve non-linear system adapted from
  *           "Numerical Recipes"
+ * @details  The tridiagonal Jacobian is computed by jacfunc from the state of
+ *           the preceding full vecfunc evaluation, or by forward differences
+ *           (fdjac3) if jacfunc is NULL.
  *****************************************************************************/
 int
-newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
+newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int focus,
+                          void *params),
+          void (*jacfunc)(double x[], double a[], double b[], double c[],
+                          int n, void *params),
+          void  *params,
           double x[],
-          int n)
+          int    n)
 {
     extern parameters_struct param;
 
@@ -50,7 +57,7 @@ newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
 
     for (k = 0; k < param.NEWT_RAPH_MAXTRIAL; k++) {
         // calculate function value for all nodes, i.e. focus = -1
-        (*vecfunc)(x, fvec, n, 0, -1);
+        (*vecfunc)(x, fvec, n, -1, params);
 
         // stop if TOLF is satisfied
         errf = 0.0;
@@ -62,7 +69,12 @@ newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
         }
 
         // calculate the Jacobian
-        fdjac3(x, fvec, a, b, c, vecfunc, n);
+        if (jacfunc != NULL) {
+            (*jacfunc)(x, a, b, c, n, params);
+        }
+        else {
+            fdjac3(x, fvec, a, b, c, vecfunc, params, n);
+        }
 
         for (i = 0; i < n; i++) {
             p[i] = -fvec[i];
@@ -113,8 +125,10 @@ fdjac3(double x[],
        double a[],
        double b[],
        double c[],
-       void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
-       int n)
+       void (*vecfunc)(double x[], double fvec[], int n, int focus,
+                       void *params),
+       void  *params,
+       int    n)
 {
     extern parameters_struct param;
 
@@ -131,7 +145,7 @@ fdjac3(double x[],
         h = x[j] - temp;
 
         // only update column j-1, j and j+1, caused by change in x[j]
-        (*vecfunc)(x, f, n, 0, j);
+        (*vecfunc)(x, f, n, j, params);
 
         x[j] = temp;
 
@@ -59,46 +59,34 @@
 *
 * @param LowerBound Lower bound for root
 * @param UpperBound Upper bound for root
-* @param Function
-* @param ap Variable arguments
+* @param Function Target function, called as Function(Estimate, params)
+* @param params Parameters passed to Function
 * @return b
 ******************************************************************************/
 double
 root_brent(double LowerBound,
            double UpperBound,
-           double (*Function)(double Estimate, va_list ap),
-           ...)
+           double (*Function)(double Estimate, void *params),
+           void  *params)
 {
     extern parameters_struct param;
 
-    va_list                  ap; /* Used in traversing variable argument list */
     double                   a;
     double                   b;
     double                   c;
-    double                   d;
-    double                   e;
     double                   fa;
     double                   fb;
     double                   fc;
-    double                   m;
-    double                   p;
-    double                   q;
-    double                   r;
-    double                   s;
-    double                   tol;
     double                   last_bad;
     double                   last_good;
     int                      which_err;
     int                      i;
     int                      j;
 
-    /* initialize variable argument list */
     a = LowerBound;
     b = UpperBound;
-    va_start(ap, Function);
-    fa = Function(a, ap);
-    va_start(ap, Function);
-    fb = Function(b, ap);
+    fa = Function(a, params);
+    fb = Function(b, params);
 
     which_err = 0;
 
@@ -107,7 +95,6 @@ root_brent(double LowerBound,
         log_warn("lower and upper bounds %f and %f "
                  "failed to bracket the root because the given function was "
                  "not defined at either point.", a, b);
-        va_end(ap);
         return(ERROR);
     }
 
@@ -126,16 +113,14 @@ root_brent(double LowerBound,
         }
 
         c = 0.5 * (last_bad + last_good);
-        va_start(ap, Function);
-        fc = Function(c, ap);
+        fc = Function(c, params);
 
         /* search for valid point via bisection */
         j = 0;
         while (fc == ERROR && j < param.ROOT_BRENT_MAXITER) {
             last_bad = c;
             c = 0.5 * (last_bad + last_good);
-            va_start(ap, Function);
-            fc = Function(c, ap);
+            fc = Function(c, params);
             j++;
         }
 
@@ -146,7 +131,6 @@ root_brent(double LowerBound,
                      "undefined values while attempting to "
                      "bracket the root between %f and %f. Driver info: %s.",
                      LowerBound, UpperBound, vic_run_ref_str);
-            va_end(ap);
             return(ERROR);
         }
         else {
@@ -172,16 +156,13 @@ root_brent(double LowerBound,
         if (which_err == 0) { // No undefined values were encountered
             a -= param.ROOT_BRENT_TSTEP;
             b += param.ROOT_BRENT_TSTEP;
-            va_start(ap, Function);
-            fa = Function(a, ap);
-            va_start(ap, Function);
-            fb = Function(b, ap);
+            fa = Function(a, params);
+            fb = Function(b, params);
         }
         else { // Undefined values were encountered
             if (which_err == -1) { // Undefined values encountered in the lower direction
                 b += param.ROOT_BRENT_TSTEP;
-                va_start(ap, Function);
-                fb = Function(b, ap);
+                fb = Function(b, params);
                 if (fb == ERROR) {
                     /* Undefined function values in both directions - give up */
                     log_warn("the given function "
@@ -189,22 +170,19 @@ root_brent(double LowerBound,
                              "attempting to bracket the root "
                              "between %f and %f. Driver info: %s.",
                              LowerBound, UpperBound, vic_run_ref_str);
-                    va_end(ap);
                     return(ERROR);
                 }
                 last_good = a;
             }
             else { // Undefined values encountered in the upper direction
                 a -= param.ROOT_BRENT_TSTEP;
-                va_start(ap, Function);
-                fa = Function(a, ap);
+                fa = Function(a, params);
                 if (fa == ERROR) {
                     /* Undefined function values in both directions - give up */
                     log_warn("the given function produced undefined "
                              "values while attempting to bracket the root "
                              "between %f and %f. Driver info: %s.",
                              LowerBound, UpperBound, vic_run_ref_str);
-                    va_end(ap);
                     return(ERROR);
                 }
                 last_good = b;
@@ -212,14 +190,12 @@ root_brent(double LowerBound,
 
             /* search for valid point via bisection */
             c = 0.5 * (last_good + last_bad);
-            va_start(ap, Function);
-            fc = Function(c, ap);
+            fc = Function(c, params);
             i = 0;
             while (fc == ERROR && i < param.ROOT_BRENT_MAXITER) {
                 last_bad = c;
                 c = 0.5 * (last_bad + last_good);
-                va_start(ap, Function);
-                fc = Function(c, ap);
+                fc = Function(c, params);
                 i++;
             }
 
@@ -229,7 +205,6 @@ root_brent(double LowerBound,
                          "values while attempting to bracket the root between "
                          "%f and %f. Driver info: %s.",
                          LowerBound, UpperBound, vic_run_ref_str);
-                va_end(ap);
                 return(ERROR);
             }
             else {
@@ -251,15 +226,55 @@ root_brent(double LowerBound,
         log_warn("lower and upper bounds %f and %f failed to "
                  "bracket the root. Driver info: %s.",
                  a, b, vic_run_ref_str);
-        va_end(ap);
         return(ERROR);
     }
 
     // At this point, we have bracketed the root
 
     // Now search for the root
+    return root_brent_search(a, b, fa, fb, Function, params);
+}
 
-    fc = fb;
+/******************************************************************************
+* @brief Brent (1973) root search within a bracket
+*
+* @details The root must be bracketed by a and b, i.e. fa and fb must have
+*          opposite signs.
+*
+* @param a Lower bound for root
+* @param b Upper bound for root
+* @param fa Function value at a
+* @param fb Function value at b
+* @param Function Target function, called as Function(Estimate, params)
+* @param params Parameters passed to Function
+* @return b
+******************************************************************************/
+double
+root_brent_search(double a,
+                  double b,
+                  double fa,
+                  double fb,
+                  double (*Function)(double Estimate, void *params),
+                  void  *params)
+{
+    extern parameters_struct param;
+
+    double                   c;
+    double                   d;
+    double                   e;
+    double                   fc;
+    double                   m;
+    double                   p;
+    double                   q;
+    double                   r;
+    double                   s;
+    double                   tol;
+    int                      i;
+
+    c = a;
+    fc = fa;
+    d = b - a;
+    e = d;
 
     for (i = 0; i < param.ROOT_BRENT_MAXITER; i++) {
         if (fb * fc > 0) {
@@ -282,7 +297,6 @@ root_brent(double LowerBound,
         m = 0.5 * (c - b);
 
         if (fabs(m) <= tol || fb == 0) {
-            va_end(ap);
             return b;
         }
         else {
@@ -328,14 +342,12 @@ root_brent(double LowerBound,
             a = b;
             fa = fb;
             b += (fabs(d) > tol) ? d : ((m > 0) ? tol : -tol);
-            va_start(ap, Function);
-            fb = Function(b, ap);
+            fb = Function(b, params);
 
             // Catch ERROR values returned from Function
             if (fb == ERROR) {
                 log_warn("iteration %d: temperature = %.4f. Driver info: %s.",
                          i + 1, b, vic_run_ref_str);
-                va_end(ap);
                 return(ERROR);
             }
         }
@@ -343,6 +355,82 @@ root_brent(double LowerBound,
     /* If we get here, there were too many iterations */
     log_warn("too many iterations. Driver info: %s.",
              vic_run_ref_str);
-    va_end(ap);
     return(ERROR);
 }
+
+/******************************************************************************
+* @brief Brent (1973) root finding, warm started from an initial guess
+*
+* @details The root is first searched for in a bracket of half width
+*          param.ROOT_BRENT_WARM_DT around Guess, typically the solution of
+*          the previous time step.  Since the root rarely moves far between
+*          time steps, this bracket is much tighter than [LowerBound,
+*          UpperBound] and the search needs fewer evaluations of Function.
+*          If the tight bracket does not contain the root, the remainder of
+*          [LowerBound, UpperBound] on the side the root lies is tried before
+*          falling back on root_brent.  The warm start is off unless
+*          ROOT_BRENT_WARM_DT is set to a positive value in the constants
+*          file; otherwise, or if Guess is not inside the bounds, this is
+*          root_brent.
+*
+* @param LowerBound Lower bound for root
+* @param UpperBound Upper bound for root
+* @param Guess Initial estimate of the root
+* @param Function Target function, called as Function(Estimate, params)
+* @param params Parameters passed to Function
+* @return root
+******************************************************************************/
+double
+root_brent_guess(double LowerBound,
+                 double UpperBound,
+                 double Guess,
+                 double (*Function)(double Estimate, void *params),
+                 void  *params)
+{
+    extern parameters_struct param;
+
+    double                   a;
+    double                   b;
+    double                   fa;
+    double                   fb;
+    double                   fc;
+
+    if (param.ROOT_BRENT_WARM_DT <= 0 || !(Guess > LowerBound) ||
+        !(Guess < UpperBound)) {
+        return root_brent(LowerBound, UpperBound, Function, params);
+    }
+
+    a = max(LowerBound, Guess - param.ROOT_BRENT_WARM_DT);
+    b = min(UpperBound, Guess + param.ROOT_BRENT_WARM_DT);
+    fa = Function(a, params);
+    fb = Function(b, params);
+    if (fa == ERROR || fb == ERROR) {
+        return root_brent(LowerBound, UpperBound, Function, params);
+    }
+    if (fa == 0) {
+        return a;
+    }
+    if (fb == 0) {
+        return b;
+    }
+    if (fa * fb < 0) {
+        return root_brent_search(a, b, fa, fb, Function, params);
+    }
+
+    // The root lies outside of the tight bracket, on the side where the
+    // function is closer to zero
+    if (fabs(fb) < fabs(fa) && b < UpperBound) {
+        fc = Function(UpperBound, params);
+        if (fc != ERROR && fb * fc < 0) {
+            return root_brent_search(b, UpperBound, fb, fc, Function, params);
+        }
+    }
+    else if (fabs(fa) <= fabs(fb) && a > LowerBound) {
+        fc = Function(LowerBound, params);
+        if (fc != ERROR && fa * fc < 0) {
+            return root_brent_search(LowerBound, a, fc, fa, Function, params);
+        }
+    }
+
+    return root_brent(LowerBound, UpperBound, Function, params);
+}
@@ -117,6 +117,7 @@ snow_intercept(double             Dt,
     double                   Tlower;
     double                   Evap;
     double                   OldTfoliage;
+    canopy_energy_bal_struct canopy_bal;
 
     double                   AirDens;
     double                   EactAir;
@@ -294,27 +295,58 @@ snow_intercept(double             Dt,
 
     Tupper = Tlower = MISSING;
 
+    /* Pack the parameters of the canopy energy balance */
+    canopy_bal.delta_t = Dt;
+    canopy_bal.elevation = soil_con->elevation;
+    canopy_bal.Wmax = soil_con->max_moist;
+    canopy_bal.Wcr = &(Wcr_array[0]);
+    canopy_bal.Wpwp = soil_con->Wpwp;
+    canopy_bal.frost_fract = soil_con->frost_fract;
+    canopy_bal.AirDens = AirDens;
+    canopy_bal.EactAir = EactAir;
+    canopy_bal.Press = Press;
+    canopy_bal.Le = Le;
+    canopy_bal.Tcanopy = Tcanopy;
+    canopy_bal.Vpd = Vpd;
+    canopy_bal.shortwave = shortwave;
+    canopy_bal.Catm = Catm;
+    canopy_bal.dryFrac = dryFrac;
+    canopy_bal.Evap = &Evap;
+    canopy_bal.Ra = Ra;
+    canopy_bal.Ra_used = Ra_used;
+    canopy_bal.Rainfall = *RainFall;
+    canopy_bal.Wind = Wind;
+    canopy_bal.displacement = displacement;
+    canopy_bal.ref_height = ref_height;
+    canopy_bal.roughness = roughness;
+    canopy_bal.root = root;
+    canopy_bal.CanopLayerBnd = CanopLayerBnd;
+    canopy_bal.IntRain = IntRainOrg;
+    canopy_bal.IntSnow = *IntSnow;
+    canopy_bal.Wdew = IntRain;
+    canopy_bal.layer = layer;
+    canopy_bal.veg_var = veg_var;
+    canopy_bal.veg_lib = veg_lib;
+    canopy_bal.LongOverIn = LongOverIn;
+    canopy_bal.LongUnderOut = LongUnderOut;
+    canopy_bal.AdvectedEnergy = AdvectedEnergy;
+    canopy_bal.LatentHeat = LatentHeat;
+    canopy_bal.LatentHeatSub = LatentHeatSub;
+    canopy_bal.LongOverOut = LongOverOut;
+    canopy_bal.NetLongOver = NetLongOver;
+    canopy_bal.NetRadiation = &NetRadiation;
+    canopy_bal.RefreezeEnergy = &RefreezeEnergy;
+    canopy_bal.SensibleHeat = SensibleHeat;
+    canopy_bal.VaporMassFlux = VaporMassFlux;
+
     if (*IntSnow > 0 || *SnowFall > 0) {
         /* Snow present or accumulating in the canopy */
 
         *AlbedoOver = param.SNOW_NEW_SNOW_ALB; // albedo of intercepted snow in canopy
         *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+        canopy_bal.NetShortOver = *NetShortOver;
 
-        Qnet = solve_canopy_energy_bal(0., Dt, soil_con->elevation,
-                                       soil_con->max_moist, &(Wcr_array[0]),
-                                       soil_con->Wpwp, soil_con->frost_fract,
-                                       AirDens, EactAir, Press, Le, Tcanopy,
-                                       Vpd, shortwave, Catm, dryFrac, &Evap,
-                                       Ra, Ra_used, *RainFall, Wind,
-                                       displacement, ref_height, roughness,
-                                       root, CanopLayerBnd, IntRainOrg,
-                                       *IntSnow, IntRain, layer, veg_var,
-                                       veg_lib,
-                                       LongOverIn, LongUnderOut, *NetShortOver,
-                                       AdvectedEnergy, LatentHeat,
-                                       LatentHeatSub, LongOverOut, NetLongOver,
-                                       &NetRadiation, &RefreezeEnergy,
-                                       SensibleHeat, VaporMassFlux);
+        Qnet = func_canopy_energy_bal(0., &canopy_bal);
 
         if (Qnet != 0) {
             /* Intercepted snow not melting - need to find temperature */
@@ -334,31 +366,15 @@ snow_intercept(double             Dt,
         /* No snow in canopy */
         *AlbedoOver = bare_albedo;
         *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+        canopy_bal.NetShortOver = *NetShortOver;
         Qnet = -9999;
         Tupper = (*Tfoliage) + param.SNOW_DT;
         Tlower = (*Tfoliage) - param.SNOW_DT;
     }
 
     if (Tupper != MISSING && Tlower != MISSING) {
-        *Tfoliage = root_brent(Tlower, Tupper,
-                               func_canopy_energy_bal, Dt,
-                               soil_con->elevation, soil_con->max_moist,
-                               &(Wcr_array[0]), soil_con->Wpwp,
-                               soil_con->frost_fract,
-                               AirDens, EactAir, Press, Le,
-                               Tcanopy, Vpd, shortwave, Catm, dryFrac,
-                               &Evap, Ra, Ra_used, *RainFall, Wind,
-                               displacement, ref_height,
-                               roughness, root, CanopLayerBnd, IntRainOrg,
-                               *IntSnow,
-                               IntRain, layer, veg_var, veg_lib,
-                               LongOverIn, LongUnderOut,
-                               *NetShortOver,
-                               AdvectedEnergy,
-                               LatentHeat, LatentHeatSub,
-                               LongOverOut, NetLongOver, &NetRadiation,
-                               &RefreezeEnergy, SensibleHeat,
-                               VaporMassFlux);
+        *Tfoliage = root_brent_guess(Tlower, Tupper, OldTfoliage,
+                                     func_canopy_energy_bal, &canopy_bal);
 
         if (*Tfoliage <= -998) {
             if (options.TFALLBACK) {
@@ -367,54 +383,15 @@ snow_intercept(double             Dt,
                 (*Tfoliage_fbcount)++;
             }
             else {
-                Qnet = error_calc_canopy_energy_bal(*Tfoliage, band, month, Dt,
-                                                    soil_con->elevation,
-                                                    soil_con->max_moist,
-                                                    &(Wcr_array[0]),
-                                                    soil_con->Wpwp,
-                                                    soil_con->depth,
-                                                    soil_con->frost_fract,
-                                                    AirDens, EactAir, Press, Le,
-                                                    Tcanopy, Vpd, shortwave,
-                                                    Catm, dryFrac,
-                                                    &Evap, Ra, Ra_used,
-                                                    *RainFall, Wind, UnderStory,
-                                                    iveg,
-                                                    displacement,
-                                                    ref_height,
-                                                    roughness, root,
-                                                    CanopLayerBnd, IntRainOrg,
-                                                    *IntSnow,
-                                                    IntRain, layer, veg_var,
-                                                    veg_lib,
-                                                    LongOverIn, LongUnderOut,
-                                                    *NetShortOver,
-                                                    AdvectedEnergy,
-                                                    LatentHeat, LatentHeatSub,
-                                                    LongOverOut, NetLongOver,
-                                                    &NetRadiation,
-                                                    &RefreezeEnergy,
-                                                    SensibleHeat,
-                                                    VaporMassFlux);
+                Qnet = error_print_canopy_energy_bal(*Tfoliage, band, month,
+                                                     UnderStory, iveg,
+                                                     soil_con->depth,
+                                                     &canopy_bal);
                 return(ERROR);
             }
         }
 
-        Qnet = solve_canopy_energy_bal(*Tfoliage, Dt, soil_con->elevation,
-                                       soil_con->max_moist, &(Wcr_array[0]),
-                                       soil_con->Wpwp, soil_con->frost_fract,
-                                       AirDens, EactAir, Press, Le, Tcanopy,
-                                       Vpd, shortwave, Catm, dryFrac, &Evap,
-                                       Ra, Ra_used, *RainFall, Wind,
-                                       displacement, ref_height, roughness,
-                                       root, CanopLayerBnd, IntRainOrg,
-                                       *IntSnow, IntRain, layer, veg_var,
-                                       veg_lib,
-                                       LongOverIn, LongUnderOut, *NetShortOver,
-                                       AdvectedEnergy, LatentHeat,
-                                       LatentHeatSub, LongOverOut, NetLongOver,
-                                       &NetRadiation, &RefreezeEnergy,
-                                       SensibleHeat, VaporMassFlux);
+        Qnet = func_canopy_energy_bal(*Tfoliage, &canopy_bal);
     }
 
     if (*IntSnow <= 0) {
@@ -565,54 +542,21 @@ snow_intercept(double             Dt,
     return(0);
 }
 
-/******************************************************************************
-* @brief    Dummy function to make a direct call to func_canopy_energy_bal()
-*           possible.
-******************************************************************************/
-double
-solve_canopy_energy_bal(double Tfoliage,
-                        ...)
-{
-    va_list ap;
-    double  Qnet;
-
-    va_start(ap, Tfoliage);
-    Qnet = func_canopy_energy_bal(Tfoliage, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
-* @brief    Dummy function to make a direct call to
-*           error_print_canopy_energy_bal() possible.
-******************************************************************************/
-double
-error_calc_canopy_energy_bal(double Tfoliage,
-                             ...)
-{
-    va_list ap;
-    double  Qnet;
-
-    va_start(ap, Tfoliage);
-    Qnet = error_print_canopy_energy_bal(Tfoliage, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
 /******************************************************************************
 * @brief    Print snow pack energy balance terms
 ******************************************************************************/
 double
-error_print_canopy_energy_bal(double  Tfoliage,
-                              va_list ap)
+error_print_canopy_energy_bal(double                    Tfoliage,
+                              int                       band,
+                              int                       month,
+                              int                       UnderStory,
+                              int                       iveg,
+                              double                   *depth,
+                              canopy_energy_bal_struct *bal)
 {
     extern option_struct options;
 
     /* General Model Parameters */
-    int                  band;
-    int                  month;
 
     double               delta_t;
     double               elevation;
@@ -620,7 +564,6 @@ error_print_canopy_energy_bal(double  Tfoliage,
     double              *Wmax;
     double              *Wcr;
     double              *Wpwp;
-    double              *depth;
     double              *frost_fract;
 
     /* Atmopheric Condition and Forcings */
@@ -641,8 +584,6 @@ error_print_canopy_energy_bal(double  Tfoliage,
     double              *Wind;
 
     /* Vegetation Terms */
-    int                  UnderStory;
-    int                  iveg;
 
     double              *displacement;
     double              *ref_height;
@@ -678,73 +619,68 @@ error_print_canopy_energy_bal(double  Tfoliage,
 
     size_t               cidx;
 
-    /** Read variables from variable length argument list **/
+    /** Read variables from parameters **/
 
     /* General Model Parameters */
-    band = (int) va_arg(ap, int);
-    month = (int) va_arg(ap, int);
 
-    delta_t = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
+    delta_t = bal->delta_t;
+    elevation = bal->elevation;
 
-    Wmax = (double *) va_arg(ap, double *);
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    depth = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Wmax = bal->Wmax;
+    Wcr = bal->Wcr;
+    Wpwp = bal->Wpwp;
+    frost_fract = bal->frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Le = (double) va_arg(ap, double);
-    Tcanopy = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Evap = (double *) va_arg(ap, double *);
-    Ra = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    Rainfall = (double) va_arg(ap, double);
-    Wind = (double *) va_arg(ap, double *);
+    AirDens = bal->AirDens;
+    EactAir = bal->EactAir;
+    Press = bal->Press;
+    Le = bal->Le;
+    Tcanopy = bal->Tcanopy;
+    Vpd = bal->Vpd;
+    shortwave = bal->shortwave;
+    Catm = bal->Catm;
+    dryFrac = bal->dryFrac;
+
+    Evap = bal->Evap;
+    Ra = bal->Ra;
+    Ra_used = bal->Ra_used;
+    Rainfall = bal->Rainfall;
+    Wind = bal->Wind;
 
     /* Vegetation Terms */
-    UnderStory = (int) va_arg(ap, int);
-    iveg = (int) va_arg(ap, int);
 
-    displacement = (double *) va_arg(ap, double *);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
+    displacement = bal->displacement;
+    ref_height = bal->ref_height;
+    roughness = bal->roughness;
 
-    root = (double *) va_arg(ap, double *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    root = bal->root;
+    CanopLayerBnd = bal->CanopLayerBnd;
 
     /* Water Flux Terms */
-    IntRain = (double) va_arg(ap, double);
-    IntSnow = (double) va_arg(ap, double);
+    IntRain = bal->IntRain;
+    IntSnow = bal->IntSnow;
 
-    Wdew = (double *) va_arg(ap, double *);
+    Wdew = bal->Wdew;
 
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
-    veg_lib = (veg_lib_struct *) va_arg(ap, veg_lib_struct *);
+    layer = bal->layer;
+    veg_var = bal->veg_var;
+    veg_lib = bal->veg_lib;
 
     /* Energy Flux Terms */
-    LongOverIn = (double) va_arg(ap, double);
-    LongUnderOut = (double) va_arg(ap, double);
-    NetShortOver = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    LongOverOut = (double *) va_arg(ap, double *);
-    NetLongOver = (double *) va_arg(ap, double *);
-    NetRadiation = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    LongOverIn = bal->LongOverIn;
+    LongUnderOut = bal->LongUnderOut;
+    NetShortOver = bal->NetShortOver;
+
+    AdvectedEnergy = bal->AdvectedEnergy;
+    LatentHeat = bal->LatentHeat;
+    LatentHeatSub = bal->LatentHeatSub;
+    LongOverOut = bal->LongOverOut;
+    NetLongOver = bal->NetLongOver;
+    NetRadiation = bal->NetRadiation;
+    RefreezeEnergy = bal->RefreezeEnergy;
+    SensibleHeat = bal->SensibleHeat;
+    VaporMassFlux = bal->VaporMassFlux;
 
     /** Print variable info */
     log_warn("snow_intercept failed to converge to a solution "
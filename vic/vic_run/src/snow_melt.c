@@ -68,37 +68,38 @@ snow_melt(double            Le,
           int               band,
           snow_data_struct *snow)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    double                   error;
-    double                   DeltaPackCC; /* Change in cold content of the pack */
-    double                   DeltaPackSwq; /* Change in snow water equivalent of the
-                                              pack (m) */
-    double                   Ice; /* Ice content of snow pack (m)*/
-    double                   InitialSwq; /* Initial snow water equivalent (m) */
-    double                   MassBalanceError; /* Mass balance error (m) */
-    double                   MaxLiquidWater; /* Maximum liquid water content of pack (m) */
-    double                   PackCC; /* Cold content of snow pack (J) */
-    double                   PackSwq; /* Snow pack snow water equivalent (m) */
-    double                   Qnet; /* Net energy exchange at the surface (W/m2) */
-    double                   RefreezeEnergy; /* refreeze/melt energy in surface layer (W/m2) */
-    double                   PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
-    double                   RefrozenWater; /* Amount of refrozen water (m) */
-    double                   SnowFallCC; /* Cold content of new snowfall (J) */
-    double                   SnowMelt; /* Amount of snow melt during time interval
-                                          (m water equivalent) */
-    double                   SurfaceCC; /* Cold content of snow pack (J) */
-    double                   SurfaceSwq; /* Surface layer snow water equivalent (m) */
-    double                   SnowFall;
-    double                   RainFall;
-    double                   advection;
-    double                   deltaCC;
-    double                   latent_heat;
-    double                   latent_heat_sub;
-    double                   sensible_heat;
-    double                   advected_sensible_heat;
-    double                   melt_energy = 0.;
+    extern option_struct        options;
+    extern parameters_struct    param;
+
+    double                      error;
+    double                      DeltaPackCC; /* Change in cold content of the pack */
+    double                      DeltaPackSwq; /* Change in snow water equivalent of the
+                                                 pack (m) */
+    double                      Ice; /* Ice content of snow pack (m)*/
+    double                      InitialSwq; /* Initial snow water equivalent (m) */
+    double                      MassBalanceError; /* Mass balance error (m) */
+    double                      MaxLiquidWater; /* Maximum liquid water content of pack (m) */
+    double                      PackCC; /* Cold content of snow pack (J) */
+    double                      PackSwq; /* Snow pack snow water equivalent (m) */
+    double                      Qnet; /* Net energy exchange at the surface (W/m2) */
+    double                      RefreezeEnergy; /* refreeze/melt energy in surface layer (W/m2) */
+    double                      PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
+    double                      RefrozenWater; /* Amount of refrozen water (m) */
+    double                      SnowFallCC; /* Cold content of new snowfall (J) */
+    double                      SnowMelt; /* Amount of snow melt during time interval
+                                             (m water equivalent) */
+    double                      SurfaceCC; /* Cold content of snow pack (J) */
+    double                      SurfaceSwq; /* Surface layer snow water equivalent (m) */
+    double                      SnowFall;
+    double                      RainFall;
+    double                      advection;
+    double                      deltaCC;
+    double                      latent_heat;
+    double                      latent_heat_sub;
+    double                      sensible_heat;
+    double                      advected_sensible_heat;
+    double                      melt_energy = 0.;
+    snow_pack_energy_bal_struct snow_bal;
 
     SnowFall = snowfall / MM_PER_M; /* convet to m */
     RainFall = rainfall / MM_PER_M; /* convet to m */
@@ -167,23 +168,45 @@ snow_melt(double            Le,
     Ice += SnowFall;
     snow->surf_water += RainFall;
 
+    /* Pack the parameters of the snow pack energy balance */
+    snow_bal.Dt = delta_t;
+    snow_bal.Ra = aero_resist;
+    snow_bal.Ra_used = aero_resist_used;
+    snow_bal.Z = z2;
+    snow_bal.Z0 = Z0;
+    snow_bal.AirDens = density;
+    snow_bal.EactAir = vp;
+    snow_bal.LongSnowIn = LongSnowIn;
+    snow_bal.Lv = Le;
+    snow_bal.Press = pressure;
+    snow_bal.Rain = RainFall;
+    snow_bal.NetShortUnder = NetShortSnow;
+    snow_bal.Vpd = vpd;
+    snow_bal.Wind = wind;
+    snow_bal.OldTSurf = *OldTSurf;
+    snow_bal.SnowCoverFract = coverage;
+    snow_bal.SnowDepth = snow->depth;
+    snow_bal.SnowDensity = snow->density;
+    snow_bal.SurfaceLiquidWater = snow->surf_water;
+    snow_bal.SweSurfaceLayer = SurfaceSwq;
+    snow_bal.Tair = Tcanopy;
+    snow_bal.TGrnd = Tgrnd;
+    snow_bal.AdvectedEnergy = &advection;
+    snow_bal.AdvectedSensibleHeat = &advected_sensible_heat;
+    snow_bal.DeltaColdContent = &deltaCC;
+    snow_bal.GroundFlux = &grnd_flux;
+    snow_bal.LatentHeat = &latent_heat;
+    snow_bal.LatentHeatSub = &latent_heat_sub;
+    snow_bal.NetLongUnder = NetLongSnow;
+    snow_bal.RefreezeEnergy = &RefreezeEnergy;
+    snow_bal.SensibleHeat = &sensible_heat;
+    snow_bal.vapor_flux = &snow->vapor_flux;
+    snow_bal.blowing_flux = &snow->blowing_flux;
+    snow_bal.surface_flux = &snow->surface_flux;
+
     /* Calculate the surface energy balance for snow_temp = 0.0 */
 
-    Qnet = CalcSnowPackEnergyBalance((double) 0.0, delta_t, aero_resist,
-                                     aero_resist_used, z2, Z0,
-                                     density, vp, LongSnowIn, Le, pressure,
-                                     RainFall, NetShortSnow, vpd,
-                                     wind, (*OldTSurf), coverage,
-                                     snow->depth, snow->density,
-                                     snow->surf_water, SurfaceSwq,
-                                     Tcanopy, Tgrnd,
-                                     &advection, &advected_sensible_heat,
-                                     &deltaCC,
-                                     &grnd_flux, &latent_heat,
-                                     &latent_heat_sub, NetLongSnow,
-                                     &RefreezeEnergy, &sensible_heat,
-                                     &snow->vapor_flux, &snow->blowing_flux,
-                                     &snow->surface_flux);
+    Qnet = SnowPackEnergyBalance((double) 0.0, &snow_bal);
 
     /* Check that snow swq exceeds minimum value for model stability */
     if (!UNSTABLE_SNOW) {
@@ -264,24 +287,10 @@ snow_melt(double            Le,
         else {
             /* Calculate surface layer temperature using "Brent method" */
             if (SurfaceSwq > param.SNOW_MIN_SWQ_EB_THRES) {
-                snow->surf_temp = root_brent(
-                    (double) (snow->surf_temp - param.SNOW_DT),
-                    (double) (snow->surf_temp + param.SNOW_DT),
-                    SnowPackEnergyBalance,
-                    delta_t, aero_resist, aero_resist_used, z2, Z0,
-                    density, vp, LongSnowIn, Le, pressure,
-                    RainFall, NetShortSnow, vpd,
-                    wind, (*OldTSurf), coverage,
-                    snow->depth, snow->density,
-                    snow->surf_water, SurfaceSwq,
-                    Tcanopy, Tgrnd,
-                    &advection, &advected_sensible_heat,
-                    &deltaCC,
-                    &grnd_flux, &latent_heat,
-                    &latent_heat_sub, NetLongSnow,
-                    &RefreezeEnergy, &sensible_heat,
-                    &snow->vapor_flux, &snow->blowing_flux,
-                    &snow->surface_flux);
+                snow->surf_temp = root_brent_guess(
+                    snow->surf_temp - param.SNOW_DT,
+                    snow->surf_temp + param.SNOW_DT, *OldTSurf,
+                    SnowPackEnergyBalance, &snow_bal);
 
                 if (snow->surf_temp <= -998) {
                     if (options.TFALLBACK) {
@@ -290,31 +299,9 @@ snow_melt(double            Le,
                         snow->surf_temp_fbcount++;
                     }
                     else {
-                        error = ErrorSnowPackEnergyBalance(snow->surf_temp,
-                                                           iveg, band,
-                                                           delta_t, aero_resist,
-                                                           aero_resist_used,
-                                                           z2, Z0, density, vp,
-                                                           LongSnowIn, Le,
-                                                           pressure,
-                                                           RainFall,
-                                                           NetShortSnow, vpd,
-                                                           wind, (*OldTSurf),
-                                                           coverage,
-                                                           snow->depth,
-                                                           snow->density,
-                                                           snow->surf_water,
-                                                           SurfaceSwq,
-                                                           Tcanopy, Tgrnd,
-                                                           &advection,
-                                                           &advected_sensible_heat,
-                                                           &deltaCC,
-                                                           &grnd_flux, &latent_heat,
-                                                           &latent_heat_sub,
-                                                           NetLongSnow, &RefreezeEnergy,
-                                                           &sensible_heat, &snow->vapor_flux,
-                                                           &snow->blowing_flux,
-                                                           &snow->surface_flux);
+                        error = ErrorPrintSnowPackEnergyBalance(snow->surf_temp,
+                                                                iveg, band,
+                                                                &snow_bal);
                         return(error);
                     }
                 }
@@ -324,26 +311,7 @@ snow_melt(double            Le,
                 snow->surf_temp = 999;
             }
             if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-                Qnet = CalcSnowPackEnergyBalance(snow->surf_temp,
-                                                 delta_t, aero_resist,
-                                                 aero_resist_used, z2, Z0,
-                                                 density, vp, LongSnowIn, Le,
-                                                 pressure,
-                                                 RainFall, NetShortSnow, vpd,
-                                                 wind, (*OldTSurf), coverage,
-                                                 snow->depth, snow->density,
-                                                 snow->surf_water, SurfaceSwq,
-                                                 Tcanopy, Tgrnd,
-                                                 &advection,
-                                                 &advected_sensible_heat,
-                                                 &deltaCC,
-                                                 &grnd_flux, &latent_heat,
-                                                 &latent_heat_sub,
-                                                 NetLongSnow, &RefreezeEnergy,
-                                                 &sensible_heat,
-                                                 &snow->vapor_flux,
-                                                 &snow->blowing_flux,
-                                                 &snow->surface_flux);
+                Qnet = SnowPackEnergyBalance(snow->surf_temp, &snow_bal);
 
                 /* since we iterated, the surface layer is below freezing and no snowmelt */
 
@@ -510,56 +478,18 @@ snow_melt(double            Le,
     return (0);
 }
 
-/******************************************************************************
- * @brief    Dummy function to make a direct call to SnowEnergyBalance()
- *           possible.
- *****************************************************************************/
-double
-CalcSnowPackEnergyBalance(double Tsurf,
-                          ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the SnowPack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = SnowPackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
- * @brief    Pass snow pack energy balance terms to
- *           ErrorPrintSnowPackEnergyBalance
- *****************************************************************************/
-int
-ErrorSnowPackEnergyBalance(double Tsurf,
-                           ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    int     error;             /* error from ErrorPrintSnowPackEnergyBalance */
-
-    va_start(ap, Tsurf);
-    error = ErrorPrintSnowPackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return (error);
-}
-
 /******************************************************************************
  * @brief    Print snow pack energy balance terms
  *****************************************************************************/
 int
-ErrorPrintSnowPackEnergyBalance(double  TSurf,
-                                va_list ap)
+ErrorPrintSnowPackEnergyBalance(double                       TSurf,
+                                int                          iveg,
+                                int                          band,
+                                snow_pack_energy_bal_struct *bal)
 {
-    /* Define Variable Argument List */
+    /* Define Parameters */
 
     /* General Model Parameters */
-    int    iveg, band;
     double Dt;                    /* Model time step (sec) */
 
     /* Vegetation Parameters */
@@ -597,8 +527,6 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
                                      area into snow covered area (W/m^2) */
     double *DeltaColdContent;     /* Change in cold content of surface
                                      layer (W/m2) */
-    double *DeltaPackColdContent; /* Change in sold content of pack
-                                     layer (W/m^2) */
     double *GroundFlux;           /* Ground Heat Flux (W/m2) */
     double *LatentHeat;           /* Latent heat exchange at surface (W/m2) */
     double *LatentHeatSub;        /* Latent heat of sub exchange at
@@ -615,53 +543,50 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
     double *SurfaceMassFlux;        /* Mass flux of water vapor to or from the
                                          intercepted snow */
 
-    /* Read Variable Argument List */
+    /* Read Parameters */
 
     /* General Model Parameters */
-    iveg = (int) va_arg(ap, int);
-    band = (int) va_arg(ap, int);
-    Dt = (double) va_arg(ap, double);
+    Dt = bal->Dt;
 
     /* Vegetation Parameters */
-    Ra = (double) va_arg(ap, double);
-    Z = (double) va_arg(ap, double);
-    Z0 = (double) va_arg(ap, double);
+    Ra = bal->Ra;
+    Z = bal->Z;
+    Z0 = bal->Z0[0];
 
     /* Atmospheric Forcing Variables */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    ShortRad = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
+    AirDens = bal->AirDens;
+    EactAir = bal->EactAir;
+    LongSnowIn = bal->LongSnowIn;
+    Lv = bal->Lv;
+    Press = bal->Press;
+    Rain = bal->Rain;
+    ShortRad = bal->NetShortUnder;
+    Vpd = bal->Vpd;
+    Wind = bal->Wind;
 
     /* Snowpack Variables */
-    OldTSurf = (double) va_arg(ap, double);
-    SnowCoverFract = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
+    OldTSurf = bal->OldTSurf;
+    SnowCoverFract = bal->SnowCoverFract;
+    SnowDensity = bal->SnowDensity;
+    SurfaceLiquidWater = bal->SurfaceLiquidWater;
+    SweSurfaceLayer = bal->SweSurfaceLayer;
 
     /* Energy Balance Components */
-    Tair = (double) va_arg(ap, double);
-    TGrnd = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    AdvectedSensibleHeat = (double *)va_arg(ap, double *);
-    DeltaColdContent = (double *) va_arg(ap, double *);
-    DeltaPackColdContent = (double *) va_arg(ap, double *);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
-    BlowingMassFlux = (double *) va_arg(ap, double *);
-    SurfaceMassFlux = (double *) va_arg(ap, double *);
+    Tair = bal->Tair;
+    TGrnd = bal->TGrnd;
+
+    AdvectedEnergy = bal->AdvectedEnergy;
+    AdvectedSensibleHeat = bal->AdvectedSensibleHeat;
+    DeltaColdContent = bal->DeltaColdContent;
+    GroundFlux = bal->GroundFlux;
+    LatentHeat = bal->LatentHeat;
+    LatentHeatSub = bal->LatentHeatSub;
+    NetLongSnow = bal->NetLongUnder;
+    RefreezeEnergy = bal->RefreezeEnergy;
+    SensibleHeat = bal->SensibleHeat;
+    VaporMassFlux = bal->vapor_flux;
+    BlowingMassFlux = bal->blowing_flux;
+    SurfaceMassFlux = bal->surface_flux;
 
     /* print variables */
     log_warn("snow_melt failed to converge to a solution in "
@@ -701,7 +626,6 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
     fprintf(LOG_DEST, "AdvectedEnergy = %f\n", AdvectedEnergy[0]);
     fprintf(LOG_DEST, "AdvectedSensibleHeat = %f\n", AdvectedSensibleHeat[0]);
     fprintf(LOG_DEST, "DeltaColdContent = %f\n", DeltaColdContent[0]);
-    fprintf(LOG_DEST, "DeltaPackColdContent = %f\n", DeltaPackColdContent[0]);
     fprintf(LOG_DEST, "GroundFlux = %f\n", GroundFlux[0]);
     fprintf(LOG_DEST, "LatentHeat = %f\n", LatentHeat[0]);
     fprintf(LOG_DEST, "LatentHeatSub = %f\n", LatentHeatSub[0]);
@@ -30,45 +30,47 @@
 * @brief
 ******************************************************************************/
 double
-soil_thermal_eqn(double  T,
-                 va_list ap)
+soil_thermal_eqn(double T,
+                 void  *params)
 {
-    double value;
+    soil_thermal_eqn_struct *eqn = (soil_thermal_eqn_struct *) params;
 
-    double TL;
-    double TU;
-    double T0;
-    double moist;
-    double max_moist;
-    double bubble;
-    double expt;
-    double ice0;
-    double A;
-    double B;
-    double C;
-    double D;
-    double E;
-    double ice;
-    int    EXP_TRANS;
-    int    node;
-    double flux_term1;
-    double flux_term2;
+    double                   value;
 
-    TL = (double) va_arg(ap, double);
-    TU = (double) va_arg(ap, double);
-    T0 = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    A = (double) va_arg(ap, double);
-    B = (double) va_arg(ap, double);
-    C = (double) va_arg(ap, double);
-    D = (double) va_arg(ap, double);
-    E = (double) va_arg(ap, double);
-    EXP_TRANS = (int) va_arg(ap, int);
-    node = (int) va_arg(ap, int);
+    double                   TL;
+    double                   TU;
+    double                   T0;
+    double                   moist;
+    double                   max_moist;
+    double                   bubble;
+    double                   expt;
+    double                   ice0;
+    double                   A;
+    double                   B;
+    double                   C;
+    double                   D;
+    double                   E;
+    double                   ice;
+    int                      EXP_TRANS;
+    int                      node;
+    double                   flux_term1;
+    double                   flux_term2;
+
+    TL = eqn->TL;
+    TU = eqn->TU;
+    T0 = eqn->T0;
+    moist = eqn->moist;
+    max_moist = eqn->max_moist;
+    bubble = eqn->bubble;
+    expt = eqn->expt;
+    ice0 = eqn->ice0;
+    A = eqn->A;
+    B = eqn->B;
+    C = eqn->C;
+    D = eqn->D;
+    E = eqn->E;
+    EXP_TRANS = eqn->EXP_TRANS;
+    node = eqn->node;
 
     if (T < 0.) {
         ice = moist - maximum_unfrozen_water(T, max_moist, bubble, expt);
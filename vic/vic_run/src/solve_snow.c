@@ -192,6 +192,7 @@ solve_snow(char               overstory,
                 if (veg_var->fcanopy > 0) {
                     ShortOverIn /= veg_var->fcanopy;
                 }
+                INSTRUMENT_BEGIN(INSTR_CANOPY);
                 ErrorFlag = snow_intercept(dt, 1.,
                                            veg_var->LAI,
                                            (*Le), longwave, LongUnderOut,
@@ -220,6 +221,7 @@ solve_snow(char               overstory,
                                            iveg, month, hidx,
                                            CanopLayerBnd, dryFrac, force,
                                            layer, soil_con, veg_var, veg_lib);
+                INSTRUMENT_END(INSTR_CANOPY);
                 if (ErrorFlag == ERROR) {
                     return (ERROR);
                 }
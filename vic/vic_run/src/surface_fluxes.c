@@ -539,6 +539,7 @@ surface_fluxes(bool                 overstory,
                 dryFrac = -1;
 
                 /** Solve snow accumulation, ablation and interception **/
+                INSTRUMENT_BEGIN(INSTR_SNOW);
                 step_melt = solve_snow(overstory, BareAlbedo, LongUnderOut,
                                        param.SNOW_MIN_RAIN_TEMP,
                                        param.SNOW_MAX_SNOW_TEMP,
@@ -564,6 +565,7 @@ surface_fluxes(bool                 overstory,
                                        iter_layer, &(iter_snow),
                                        soil_con,
                                        &(iter_snow_veg_var), veg_lib);
+                INSTRUMENT_END(INSTR_SNOW);
 
                 if (step_melt == ERROR) {
                     return (ERROR);
@@ -592,6 +594,7 @@ surface_fluxes(bool                 overstory,
                    Solve Energy Balance Components at Soil Surface
                 **************************************************/
 
+                INSTRUMENT_BEGIN(INSTR_SURF_EB);
                 Tsurf = calc_surf_energy_bal((*Le), LongUnderIn, NetLongSnow,
                                              NetShortGrnd, NetShortSnow,
                                              OldTSurf,
@@ -618,6 +621,7 @@ surface_fluxes(bool                 overstory,
                                              iter_layer,
                                              &(iter_snow), soil_con,
                                              &iter_soil_veg_var, veg_lib);
+                INSTRUMENT_END(INSTR_SURF_EB);
 
                 if ((int) Tsurf == ERROR) {
                     // Return error flag to skip rest of grid cell
@@ -1083,8 +1087,10 @@ surface_fluxes(bool                 overstory,
 
     (*inflow) = ppt;
 
+    INSTRUMENT_BEGIN(INSTR_RUNOFF);
     ErrorFlag = runoff(cell, energy, soil_con, ppt, soil_con->frost_fract,
                        options.Nnode);
+    INSTRUMENT_END(INSTR_RUNOFF);
 
     return(ErrorFlag);
 }
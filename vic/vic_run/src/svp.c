@@ -38,7 +38,7 @@ svp(double temp)
 
     double                   SVP;
 
-    SVP = param.SVP_A * exp((param.SVP_B * temp) / (param.SVP_C + temp));
+    SVP = param.SVP_A * vic_exp((param.SVP_B * temp) / (param.SVP_C + temp));
 
     if (temp < 0) {
         SVP *= 1.0 + .00972 * temp + .000042 * temp * temp;
@@ -47,6 +47,34 @@ svp(double temp)
     return (SVP * PA_PER_KPA);
 }
 
+/******************************************************************************
+* @brief        This routine computes the saturated vapor pressure for an
+*               array of temperatures
+*
+* @note         Same as svp() for every element, written so that the loop can
+*               be vectorized.
+******************************************************************************/
+void
+svp_array(double *temp,
+          size_t  n,
+          double *SVP)
+{
+    extern parameters_struct param;
+
+    double                   correction;
+
+    size_t                   i;
+
+    #pragma omp simd private(correction)
+    for (i = 0; i < n; i++) {
+        correction = 1.0 + .00972 * temp[i] + .000042 * temp[i] * temp[i];
+        SVP[i] = param.SVP_A *
+                 vic_exp((param.SVP_B * temp[i]) / (param.SVP_C + temp[i]));
+        SVP[i] *= temp[i] < 0 ? correction : 1.0;
+        SVP[i] *= PA_PER_KPA;
+    }
+}
+
 /******************************************************************************
 * @brief        This routine computes the gradient of d(svp)/dT
 *
@@ -449,6 +449,7 @@ vic_run(force_data_struct   *force,
         force->out_rain += rainprec * Cv;
         force->out_snow += snowprec * Cv;
 
+        INSTRUMENT_BEGIN(INSTR_LAKE);
         ErrorFlag = solve_lake(snowprec, rainprec, force->air_temp[NR],
                                force->wind[NR], force->vp[NR] / PA_PER_KPA,
                                force->shortwave[NR], force->longwave[NR],
@@ -457,6 +458,7 @@ vic_run(force_data_struct   *force,
                                force->density[NR], lake_var,
                                *soil_con, gp->dt, gp->wind_h, *dmy,
                                fraci);
+        INSTRUMENT_END(INSTR_LAKE);
         if (ErrorFlag == ERROR) {
             return (ERROR);
         }